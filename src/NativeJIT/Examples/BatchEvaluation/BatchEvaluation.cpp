@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "NativeJIT/BatchCompiler.h"
+#include "NativeJIT/CodeGen/ExecutionBuffer.h"
+#include "NativeJIT/CodeGen/FunctionBuffer.h"
+#include "NativeJIT/Function.h"
+
+using NativeJIT::Allocator;
+using NativeJIT::BatchCompiler;
+using NativeJIT::BatchInstructionSet;
+using NativeJIT::ExecutionBuffer;
+using NativeJIT::Function;
+using NativeJIT::FunctionBuffer;
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// This example compiles a rate law, Vmax * S / (Km + S) * (1 - P / Keq) with
+// S and P varying, once into a scalar function and once into batch functions
+// which evaluate it for arrays of points. It then times the scalar function
+// called in a loop against one call of each batch function for the whole
+// array.
+//
+// The batch functions evaluate two points at a time with SSE2 and four with
+// AVX2, which is only measured if the CPU supports it. The results of all the
+// functions are compared to make sure they agree.
+//
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    ExecutionBuffer codeAllocator(16384);
+    Allocator allocator(64 * 1024);
+    FunctionBuffer code(codeAllocator, 4096);
+    FunctionBuffer batchCode(codeAllocator, 4096);
+
+    Function<double, double, double> expression(allocator, code);
+
+    auto & s = expression.GetP1();
+    auto & p = expression.GetP2();
+
+    auto & saturation = expression.Div(expression.Mul(expression.Immediate(2.5), s),
+                                       expression.Add(expression.Immediate(0.3), s));
+    auto & reversibility = expression.Sub(expression.Immediate(1.0),
+                                          expression.Div(p, expression.Immediate(4.0)));
+    auto & rate = expression.Mul(saturation, reversibility);
+
+    auto function = expression.Compile(rate);
+
+    const size_t c_pointCount = 4096;
+    const unsigned c_repetitions = 2000;
+
+    std::vector<double> substrate(c_pointCount);
+    std::vector<double> product(c_pointCount);
+
+    for (size_t i = 0; i < c_pointCount; ++i)
+    {
+        substrate[i] = 0.01 * static_cast<double>(i % 1000);
+        product[i] = 0.001 * static_cast<double>(i % 3000);
+    }
+
+    double const * inputs[] = { substrate.data(), product.data() };
+    std::vector<double> expected(c_pointCount);
+    std::vector<double> observed(c_pointCount);
+
+    typedef std::chrono::high_resolution_clock Clock;
+
+    auto start = Clock::now();
+    for (unsigned r = 0; r < c_repetitions; ++r)
+    {
+        for (size_t i = 0; i < c_pointCount; ++i)
+        {
+            expected[i] = function(substrate[i], product[i]);
+        }
+    }
+    const double scalarSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Scalar function: " << scalarSeconds << "s" << std::endl;
+
+    const BatchInstructionSet instructionSets[] = { BatchInstructionSet::Scalar,
+                                                    BatchInstructionSet::SSE2,
+                                                    BatchInstructionSet::AVX2 };
+    const char* const names[] = { "Scalar", "SSE2", "AVX2" };
+
+    for (unsigned k = 0; k < sizeof(instructionSets) / sizeof(instructionSets[0]); ++k)
+    {
+        if (instructionSets[k] == BatchInstructionSet::AVX2
+            && BatchCompiler::GetWidestInstructionSet() != BatchInstructionSet::AVX2)
+        {
+            std::cout << "AVX2 batch: not supported" << std::endl;
+            continue;
+        }
+
+        auto batch = expression.CompileBatch(rate, batchCode, instructionSets[k]);
+
+        start = Clock::now();
+        for (unsigned r = 0; r < c_repetitions; ++r)
+        {
+            batch(inputs, observed.data(), c_pointCount);
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        bool isSame = true;
+        for (size_t i = 0; i < c_pointCount; ++i)
+        {
+            isSame = isSame && observed[i] == expected[i];
+        }
+
+        std::cout << names[k] << " batch: " << seconds << "s"
+                  << " (" << scalarSeconds / seconds << "x)"
+                  << (isSame ? "" : ", results differ!") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,272 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>                              // size_t parameter.
+#include <cstdint>
+
+#include "NativeJIT/AllocatorVector.h"          // Embedded member.
+#include "NativeJIT/CodeGen/X64CodeGenerator.h" // OpCode embedded.
+#include "Temporary/NonCopyable.h"              // Base class.
+
+
+namespace Allocators
+{
+    class IAllocator;
+}
+
+
+namespace NativeJIT
+{
+    class FunctionBuffer;
+    class NodeBase;
+
+
+    // The instruction sets BatchCompiler can generate code for, from the
+    // narrowest to the widest. Scalar evaluates one point at a time with
+    // the scalar SSE2 instructions, SSE2 two points at a time in the XMM
+    // registers and AVX2 four points at a time in the YMM registers. AVX2
+    // also implies FMA3, which is used for MulAdd nodes. Without it, MulAdd
+    // is computed as a separate multiplication and addition.
+    enum class BatchInstructionSet { Scalar, SSE2, AVX2 };
+
+
+    // Describes the value of a node to BatchCompiler, see
+    // NodeBase::GetLaneOperation().
+    struct LaneOperation
+    {
+        enum class Kind { Parameter, Immediate, Operation };
+
+        static LaneOperation Parameter(unsigned position);
+        static LaneOperation Immediate(double value);
+        static LaneOperation Operation(OpCode opCode, NodeBase& operand);
+        static LaneOperation Operation(OpCode opCode, NodeBase& left, NodeBase& right);
+        static LaneOperation Operation(OpCode opCode,
+                                       NodeBase& left,
+                                       NodeBase& right,
+                                       NodeBase& addend);
+
+        // Returns whether the opcode can be used for an Operation with the
+        // given number of operands: Sqrt with one, Add, Div, IMul, Max, Min
+        // and Sub with two and Vfmadd231 (left * right + addend) with three.
+        static bool IsSupported(OpCode opCode, unsigned operandCount);
+
+        Kind m_kind;
+
+        // The position of the parameter for Parameter.
+        unsigned m_position;
+
+        // The value for Immediate.
+        double m_value;
+
+        // The opcode and its operands for Operation.
+        OpCode m_opCode;
+        unsigned m_operandCount;
+        NodeBase* m_operands[3];
+    };
+
+
+    // Describes a constant as an Immediate if it is a double. Used by the
+    // nodes holding constants of arbitrary types.
+    inline bool GetConstantLaneOperation(double value, LaneOperation& operation)
+    {
+        operation = LaneOperation::Immediate(value);
+        return true;
+    }
+
+
+    template <typename T>
+    bool GetConstantLaneOperation(T const & /* value */, LaneOperation& /* operation */)
+    {
+        return false;
+    }
+
+
+    // BatchCompiler compiles an expression of double parameters into a
+    // function evaluating it for many independent points per call:
+    //
+    //     void f(double const * const * inputs, double* out, size_t n);
+    //
+    // where inputs[k][i] is the value of the parameter at position k for the
+    // i-th point and the result for the i-th point is stored in out[i], i.e.
+    // the points are passed as a structure of arrays. The generated loop
+    // evaluates as many points per iteration as the instruction set has
+    // lanes and finishes the remainder one point at a time. The arrays need
+    // not be aligned.
+    //
+    // The expression is the same node tree that ExpressionTree compiles into
+    // scalar code, but only nodes which describe themselves through
+    // NodeBase::GetLaneOperation() are supported: double parameters and
+    // immediates, Add, Sub, Mul, Div, Min, Max, Sqrt, MulAdd and nodes folded
+    // to constants. Use CanCompile() to check an expression beforehand.
+    // Nodes shared by several parents are evaluated once per point.
+    class BatchCompiler : public NonCopyable
+    {
+    public:
+        typedef void (*FunctionType)(double const * const * inputs, double* out, size_t n);
+
+        // The compiled function replaces the contents of the code buffer.
+        // Temporary data used during compilation comes from the allocator.
+        BatchCompiler(Allocators::IAllocator& allocator, FunctionBuffer& code);
+
+        // Returns whether all nodes of the expression are supported and its
+        // parameter positions are below c_maxParameters.
+        bool CanCompile(NodeBase& root);
+
+        // Compiles the expression for the widest instruction set supported
+        // by the CPU or for the specified one. Throws if CanCompile() is
+        // false for the expression.
+        FunctionType Compile(NodeBase& root);
+        FunctionType Compile(NodeBase& root, BatchInstructionSet instructionSet);
+
+        // Returns the widest instruction set supported by the CPU and the
+        // operating system. Queries cpu_features if NativeJIT was built with
+        // it and returns SSE2 otherwise.
+        static BatchInstructionSet GetWidestInstructionSet();
+
+        // Returns the number of points evaluated at once by the instruction set.
+        static unsigned GetLaneCount(BatchInstructionSet instructionSet);
+
+        // The maximum number of parameter arrays, limited by the number of
+        // general purpose registers holding their addresses.
+        static const unsigned c_maxParameters = 9;
+
+    private:
+        // A node reachable from the root with its operands resolved to
+        // indexes into m_values. The values are in postorder, so operands
+        // precede the values using them and the root is the last value.
+        struct Value
+        {
+            LaneOperation m_operation;
+            unsigned m_operands[3];
+
+            // Index into m_constants for Immediate.
+            unsigned m_constant;
+
+            // Index of the last value which uses this one as an operand. For
+            // the root, the number of values, standing for the final store.
+            unsigned m_lastUse;
+
+            // Code generation state, reset for each loop body: the XMM register
+            // holding the value and the stack slot it has been spilled to,
+            // or -1. Parameters and immediates are loaded into a register
+            // only when they cannot be used as memory operands and are never
+            // spilled.
+            int m_register;
+            int m_slot;
+        };
+
+        static const unsigned c_registerCount = 16;
+        static const unsigned c_noValue = ~0u;
+
+        // Collects the values of the expression, returns whether all of its
+        // nodes are supported.
+        bool CollectValues(NodeBase& root);
+
+        // Adds the node and the nodes it depends on to m_values, returns its
+        // index or c_noValue if some node is not supported.
+        unsigned AddValue(NodeBase& node);
+
+        // Emits the constants used by the expression, aligned for packed
+        // memory operands.
+        void EmitConstants();
+
+        // Emits code evaluating one point (WIDTH 1) or WIDTH points at once
+        // and storing the results to the output array. The array pointers
+        // are not advanced.
+        template <unsigned WIDTH>
+        void CodeGenBody(Register<8, false> out, bool useFma);
+
+        template <unsigned WIDTH>
+        void CodeGenOperation(unsigned current, bool useFma);
+
+        // Returns a register loaded with the value of the operand, or the
+        // register of the operand itself if the value at the current index
+        // is its last use and reuse is allowed. The register becomes owned by
+        // the current value.
+        template <unsigned WIDTH>
+        Register<8, true> CodeGenDestination(unsigned current, unsigned operand, bool canReuse);
+
+        // Emits dest = dest OP value, using a memory operand where allowed.
+        template <OpCode OP, unsigned WIDTH>
+        void CodeGenOperand(Register<8, true> dest, unsigned current, unsigned value);
+
+        // Returns a free register for the owner value, spilling the value
+        // whose next use is the furthest from the current index if there is
+        // none. The returned register is locked until the code for the
+        // current value is generated, as are the registers of its operands.
+        template <unsigned WIDTH>
+        Register<8, true> AllocateRegister(unsigned current, unsigned owner);
+
+        template <unsigned WIDTH>
+        Register<8, true> LoadToRegister(unsigned current, unsigned value);
+
+        template <unsigned WIDTH>
+        void LoadValue(Register<8, true> dest, unsigned value);
+
+        unsigned GetNextUse(unsigned value, unsigned current) const;
+
+        // Returns whether the value is read from memory rather than computed
+        // and its address.
+        bool IsMemoryValue(unsigned value) const;
+        void GetAddress(unsigned value, Register<8, false>& base, int32_t& offset) const;
+
+        unsigned AllocateSlot();
+        static int32_t GetSlotOffset(int slot);
+
+        // Releases the registers and slots of the operands of the value at
+        // the current index that are not used afterwards, except for the
+        // register taken over by the current value.
+        void ReleaseOperands(unsigned current);
+
+        void AdvancePointers(Register<8, false> out, Register<8, false> count, unsigned pointCount);
+
+        Allocators::IAllocator& m_allocator;
+        FunctionBuffer& m_code;
+
+        AllocatorVector<Value> m_values;
+
+        // Index of the value of each node, by node ID, or c_noValue.
+        AllocatorVector<unsigned> m_valueOfNode;
+
+        // Distinct constants and their offsets in the code buffer.
+        AllocatorVector<double> m_constants;
+        AllocatorVector<int32_t> m_constantOffsets;
+
+        // Whether the expression reads the parameter at each position. The
+        // pointers to the arrays of the used parameters are kept in registers.
+        bool m_isParameterUsed[c_maxParameters];
+
+        // Register allocation state: the value owning each register or -1,
+        // and the masks of locked registers and of all registers used by the
+        // function.
+        int m_registerOwner[c_registerCount];
+        unsigned m_lockedRegisters;
+        unsigned m_usedRegisters;
+
+        // Whether each spill slot is free. The size of the vector is the
+        // number of slots the function needs.
+        AllocatorVector<bool> m_isSlotFree;
+    };
+}
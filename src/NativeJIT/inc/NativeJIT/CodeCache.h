@@ -0,0 +1,107 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace NativeJIT
+{
+    class FunctionBuffer;
+
+
+    // CodeCache persists compiled functions in a directory so that a later
+    // process can load them instead of generating the code again.
+    //
+    // An entry is identified by a key supplied by the caller, typically a
+    // serialization of the expression the function was compiled from, by
+    // the build of the code generator (see GetGeneratorId()) and by the
+    // target: the cache file format, the calling convention and the widest
+    // instruction set available (see BatchCompiler). Entries are stored in
+    // files named after a hash of these, and the full key is kept in the
+    // file and compared on load, so hash collisions result in misses. A
+    // checksum of the key, the relocations and the code detects corrupted
+    // entries.
+    //
+    // Only functions which reference absolute addresses through
+    // ExpressionNodeFactory::Relocatable() can be stored. Each relocated
+    // address must be one of the symbols given to the constructor and is
+    // stored as its index, so that the function can be loaded into a process
+    // where the symbols are at different addresses. Other absolute addresses,
+    // f. ex. from Immediate() of a pointer, make the code not relocatable.
+    //
+    // Failures to read or write files are not errors; Load() reports a miss
+    // and Store() returns false. The directory must exist.
+    //
+    // Loaded code is executed, so on POSIX systems the directory and the
+    // entries must be owned by the effective user and must not be writable
+    // by the group or by others; otherwise Load() reports a miss and Store()
+    // returns false. Entries are created with mode 0600. On Windows, the
+    // directory is expected to be protected by its ACL.
+    class CodeCache
+    {
+    public:
+        CodeCache(std::string const & directory,
+                  std::vector<void const *> const & symbols);
+
+        // Loads the function stored under the key into code and returns its
+        // entry point, or returns nullptr if there is no valid entry or it
+        // does not fit into code.
+        void const * Load(std::string const & key, FunctionBuffer& code) const;
+
+        // Stores the function compiled into code under the key. Returns false
+        // if the function is not relocatable, references an address which is
+        // not a symbol or the file cannot be written.
+        bool Store(std::string const & key, FunctionBuffer const & code) const;
+
+        // Returns the name of the file which holds the entry for the key.
+        std::string GetFileName(std::string const & key) const;
+
+        // Identifies the build of the code generator. Entries stored by a
+        // different build are never loaded. CMake sets it to a hash of the
+        // NativeJIT sources; other builds use the time CodeCache.cpp was
+        // compiled.
+        static char const * GetGeneratorId();
+
+        // Bump when the file format changes so that existing entries are no
+        // longer used.
+        static const uint32_t c_formatVersion = 2;
+
+    private:
+        // Identifies the target the code was generated for.
+        static uint32_t GetTarget();
+
+        // Returns the key the entry is stored under, the key of the caller
+        // prefixed with the generator id.
+        static std::string GetStoredKey(std::string const & key);
+
+        // Returns whether the directory can be trusted, see above.
+        bool IsDirectoryPrivate() const;
+
+        std::string m_directory;
+        std::vector<void const *> m_symbols;
+    };
+}
@@ -39,6 +39,9 @@ namespace Allocators
 
 namespace NativeJIT
 {
+    class ExecutionBuffer;
+
+
     class CodeBuffer : public NonCopyable
     {
     public:
@@ -46,6 +49,9 @@ namespace NativeJIT
         // the buffer is to be executed (and not just f. ex. transferred over the
         // network), the allocator must return memory that is executable (see
         // ExecutionBuffer class for an example).
+        //
+        // If the allocator is an ExecutionBuffer, the buffer is made writable
+        // whenever it is written to and executable by MakeExecutable().
         CodeBuffer(Allocators::IAllocator& codeAllocator, unsigned capacity);
 
         // Frees the buffer.
@@ -114,6 +120,11 @@ namespace NativeJIT
         // Patches each call site with the correct offset derived from its resolved label.
         void PatchCallSites();
 
+        // Makes the buffer executable and read only if it was allocated from
+        // an ExecutionBuffer. The next write makes it writable again and no
+        // longer executable.
+        void MakeExecutable();
+
     protected:
         void EmitCallSite(Label label, unsigned size);
 
@@ -121,6 +132,11 @@ namespace NativeJIT
         Allocators::IAllocator& m_codeAllocator;
         unsigned m_capacity;
 
+        // The code allocator if it is an ExecutionBuffer, otherwise nullptr,
+        // and whether the buffer is currently executable.
+        ExecutionBuffer* m_executionBuffer;
+        bool m_isExecutable;
+
         uint8_t* m_bufferStart;
         uint8_t* m_bufferEnd;
         uint8_t* m_current;
@@ -130,6 +146,11 @@ namespace NativeJIT
         // Verifies that the specified length can be written to the buffer.
         // Throws if buffer overflow would occur.
         void VerifyNoBufferOverflow(unsigned length);
+
+        // Makes the buffer writable if it is executable. Called before all
+        // writes to the buffer.
+        void EnsureWritable();
+        void MakeWritable();
     };
 
 
@@ -148,6 +169,15 @@ namespace NativeJIT
     }
 
 
+    inline void CodeBuffer::EnsureWritable()
+    {
+        if (m_isExecutable)
+        {
+            MakeWritable();
+        }
+    }
+
+
     template <typename T>
     void CodeBuffer::EmitBytes(T x)
     {
@@ -155,6 +185,7 @@ namespace NativeJIT
         const size_t varSize = sizeof(T);
 
         VerifyNoBufferOverflow(varSize);
+        EnsureWritable();
 
         *reinterpret_cast<T*>(m_current) = x;
         m_current += varSize;
@@ -23,6 +23,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <map>
+
 #include "NativeJIT/CodeGen/CodeBuffer.h"       // Embedded class.
 #include "Temporary/IAllocator.h"
 
@@ -33,10 +36,59 @@ namespace NativeJIT
     struct UnwindInfo;
     struct UnwindCode;
 
+    // ExecutionBuffer allocates memory for generated code. The memory is
+    // mapped from the operating system in chunks, a new chunk being mapped
+    // whenever no free block in the existing ones is large enough, until
+    // the optional limit on the total mapped size is reached. Blocks can be
+    // freed individually and are then reused by later allocations.
+    //
+    // The pages of a block are never writable and executable at the same
+    // time. A newly allocated block is writable, MakeExecutable() makes it
+    // executable and read only and MakeWritable() reverses that. CodeBuffer
+    // does this automatically for blocks it allocates from an
+    // ExecutionBuffer. Block sizes are rounded up to whole pages so that the
+    // protection of one block never affects another one.
     class ExecutionBuffer : public Allocators::IAllocator
     {
     public:
-        ExecutionBuffer(size_t bufferSize);
+        // Counters describing the use of the buffer over its lifetime. The
+        // allocated and mapped sizes are current, the remaining values are
+        // totals since construction.
+        struct Statistics
+        {
+            // Chunks currently mapped and their total size in bytes.
+            size_t m_chunkCount;
+            size_t m_mappedBytes;
+
+            // Blocks currently allocated, their total size in bytes and the
+            // largest total size so far.
+            size_t m_allocatedBlockCount;
+            size_t m_allocatedBytes;
+            size_t m_peakAllocatedBytes;
+
+            // Total number of allocations and of blocks freed (evicted) since
+            // construction, and the bytes freed.
+            size_t m_allocationCount;
+            size_t m_freedBlockCount;
+            size_t m_freedBytes;
+
+            // Total number of chunks unmapped by ReleaseUnusedChunks() and
+            // Reset(), and their size in bytes.
+            size_t m_releasedChunkCount;
+            size_t m_releasedBytes;
+
+            // Number of calls changing the protection of pages.
+            size_t m_protectionChangeCount;
+        };
+
+        // The maximum size used when no limit is specified.
+        static const size_t c_unlimitedSize = SIZE_MAX;
+
+        // Creates a buffer mapping chunks of chunkSize bytes, rounded up to
+        // whole pages, or larger for allocations which don't fit into a
+        // chunk. Allocate() throws if the total size of the chunks would
+        // exceed maxSize.
+        ExecutionBuffer(size_t chunkSize, size_t maxSize = c_unlimitedSize);
 
         virtual ~ExecutionBuffer() override;
 
@@ -45,27 +97,84 @@ namespace NativeJIT
         // IAllocator methods
         //
 
-        // Allocates a block of a specified byte size.
+        // Allocates a writable block of a specified byte size.
         virtual void* Allocate(size_t size) override;
 
-        // Frees a block.
+        // Frees a block. Its pages are made non-executable until the memory is
+        // allocated again.
         virtual void Deallocate(void* block) override;
 
-        // Returns the maximum legal allocation size in bytes.
+        // Returns the maximum legal allocation size in bytes, i.e. the limit
+        // on the total size of the chunks.
         virtual size_t MaxSize() const override;
 
-        // Returns the available size in bytes.
+        // Returns the available size in bytes: the free space in the mapped
+        // chunks and the size which may still be mapped. Note that the free
+        // space may be fragmented.
         virtual size_t Available() const override;
 
         // Frees all blocks that have been allocated since construction or the
-        // last call to Reset().
+        // last call to Reset() and unmaps all chunks except the first one.
         virtual void Reset() override;
 
+
+        //
+        // Page protection of allocated blocks.
+        //
+
+        // Makes the block readable and writable but not executable.
+        void MakeWritable(void* block);
+
+        // Makes the block readable and executable but not writable.
+        void MakeExecutable(void* block);
+
+
+        // Unmaps the chunks which have no allocated blocks, except the first
+        // chunk. Returns the number of bytes unmapped.
+        size_t ReleaseUnusedChunks();
+
+        Statistics const & GetStatistics() const;
+
     private:
-        void DebugInitialize();
+        // A block allocated from a chunk.
+        struct Block
+        {
+            size_t m_size;
+            bool m_isExecutable;
+        };
+
+        // Maps a chunk of at least the specified size and adds it as a free
+        // block. Throws if the limit on mapped bytes would be exceeded.
+        void MapChunk(size_t minSize);
+
+        // Unmaps the chunk, which must not contain allocated blocks.
+        void UnmapChunk(uint8_t* start);
+
+        // Returns the start of the chunk containing the address.
+        uint8_t* GetChunkStart(uint8_t* address) const;
+
+        // Adds the range to the free blocks, merging it with adjacent free
+        // blocks within the same chunk.
+        void AddFreeBlock(uint8_t* start, size_t size);
+
+        // Removes and returns the first free block large enough for the
+        // size, splitting it if it is larger, or nullptr.
+        uint8_t* TakeFreeBlock(size_t size);
+
+        void Protect(uint8_t* start, size_t size, bool isExecutable);
+
+        void DebugInitialize(uint8_t* start, size_t size);
+
+        size_t m_pageSize;
+        size_t m_chunkSize;
+        size_t m_maxSize;
+
+        // The size of each chunk and of each allocated and free block, by
+        // start address. Free blocks never span chunks.
+        std::map<uint8_t*, size_t> m_chunks;
+        std::map<uint8_t*, Block> m_blocks;
+        std::map<uint8_t*, size_t> m_freeBlocks;
 
-        size_t m_bufferSize;
-        size_t m_bytesAllocated;
-        unsigned char* m_buffer;
+        Statistics m_statistics;
     };
 }
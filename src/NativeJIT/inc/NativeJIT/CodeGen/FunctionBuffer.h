@@ -37,6 +37,8 @@ typedef struct
 } RUNTIME_FUNCTION;
 #endif
 
+#include <vector>
+
 #include "NativeJIT/CodeGen/X64CodeGenerator.h"     // Inherits from X64CodeGenerator.
 
 
@@ -85,6 +87,30 @@ namespace NativeJIT
         // patched with the actual values.
         void EndFunctionBodyGeneration(FunctionSpecification const & spec);
 
+        // Relocations describe the absolute addresses embedded in the code,
+        // which need to be patched when the code is moved to another process
+        // (see CodeCache). AddRelocation() records that the 8 bytes at the
+        // specified offset hold an absolute address. MarkNotRelocatable()
+        // records that the code uses absolute addresses in a way that cannot
+        // be patched, f. ex. as instruction immediates.
+        void AddRelocation(unsigned offset);
+        void MarkNotRelocatable();
+
+        std::vector<unsigned> const & GetRelocations() const;
+        bool IsRelocatable() const;
+
+        // Replaces the contents of the buffer with a function generated
+        // earlier, possibly in another process. The image is the contents of
+        // the original buffer up to GetFunctionCodeEndOffset(), with any
+        // relocations already patched, and the offsets are the values of
+        // GetFunctionCodeStartOffset() and GetUnwindInfoStartOffset() of the
+        // original buffer. The loaded function is ready to be called and is
+        // not relocatable since its relocations are not known.
+        void LoadFunction(uint8_t const * image,
+                          unsigned imageSize,
+                          unsigned codeStartOffset,
+                          unsigned unwindInfoOffset);
+
         // Resets the buffer to the same state it had after its construction.
         virtual void Reset() override;
 
@@ -102,6 +128,10 @@ namespace NativeJIT
         unsigned m_prologLength;
         bool m_isCodeGenerationCompleted;
 
+        // Offsets of the absolute addresses in the buffer, see AddRelocation().
+        std::vector<unsigned> m_relocations;
+        bool m_isRelocatable;
+
         // The callback function for RtlInstallFunctionTableCallback. Context
         // is a poiner to a FunctionBuffer.
 #ifdef NATIVEJIT_PLATFORM_WINDOWS
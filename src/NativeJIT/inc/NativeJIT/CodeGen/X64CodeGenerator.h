@@ -92,9 +92,12 @@ namespace NativeJIT
         CvtFP2SI,
         CvtSI2FP,
         Dec,
+        Div,        // Floating point only (DivSS/DivSD).
         IMul,
         Inc,
         Lea,
+        Max,        // Floating point only (MaxSS/MaxSD).
+        Min,        // Floating point only (MinSS/MinSD).
         Mov,
         MovSX,
         MovZX,
@@ -111,8 +114,11 @@ namespace NativeJIT
         Shl,        // Note: Shl and Sal are aliases, unlike Shr and Sar.
         Shld,
         Shr,
+        Sqrt,       // Floating point only (SqrtSS/SqrtSD).
         Stosq,
         Sub,
+        Vfmadd231,  // Fused multiply-add, dest = src1 * src2 + dest. Requires FMA3.
+        Vzeroupper, // Clears the upper halves of the YMM registers. Requires AVX.
         Xor,
         // The following value must be the last one.
         OpCodeCount
@@ -222,6 +228,39 @@ namespace NativeJIT
         template <OpCode OP, unsigned SIZE1, bool ISFLOAT1, unsigned SIZE2, bool ISFLOAT2>
         void Emit(Register<8, false> dest, int32_t destOffset, Register<SIZE2, ISFLOAT2> src);
 
+        // Three register operands with the same type and size (f. ex.
+        // vfmadd231sd xmm0, xmm1, xmm2).
+        template <OpCode OP, unsigned SIZE, bool ISFLOAT>
+        void Emit(Register<SIZE, ISFLOAT> dest,
+                  Register<SIZE, ISFLOAT> src1,
+                  Register<SIZE, ISFLOAT> src2);
+
+        // Double precision instructions operating on WIDTH lanes at once.
+        // WIDTH 1 uses the scalar SSE2 encodings (f. ex. AddSD), WIDTH 2 the
+        // packed SSE2 encodings on XMM registers (f. ex. AddPD) and WIDTH 4
+        // the VEX.256 AVX encodings on the YMM register with the same id
+        // (f. ex. VAddPD ymm1, ymm1, ymm2). The supported opcodes are Add,
+        // Div, IMul, Max, Min, Sqrt, Sub and Mov. Binary opcodes compute
+        // dest = dest OP src and Sqrt computes dest = sqrt(src).
+        //
+        // Mov copies all lanes between registers (MovAPD) and is unaligned
+        // when loading or storing (MovSD/MovUPD), while the memory operand of
+        // other opcodes must be 16 byte aligned with WIDTH 2.
+        template <OpCode OP, unsigned WIDTH>
+        void EmitPacked(Register<8, true> dest, Register<8, true> src);
+
+        template <OpCode OP, unsigned WIDTH>
+        void EmitPacked(Register<8, true> dest, Register<8, false> src, int32_t srcOffset);
+
+        // Store, Mov only.
+        template <OpCode OP, unsigned WIDTH>
+        void EmitPacked(Register<8, false> dest, int32_t destOffset, Register<8, true> src);
+
+        // VFMAdd231SD/VFMAdd231PD on WIDTH lanes, dest = src1 * src2 + dest.
+        // Requires FMA3, and uses the VEX.128 encoding for WIDTH 2.
+        template <OpCode OP, unsigned WIDTH>
+        void EmitPacked(Register<8, true> dest, Register<8, true> src1, Register<8, true> src2);
+
         // Two operands - register destination and immediate source.
         // Note: Method is named EmitImmediate() to avoid clashes with other
         // Emit() methods in case when T gets resolved to f. ex. Register.
@@ -288,6 +327,47 @@ namespace NativeJIT
         template <unsigned SIZE>
         void Shld(Register<SIZE, false> dest, Register<SIZE, false> src);
 
+        // Emits the three byte VEX prefix C4 [RXB.mmmmm] [W.vvvv.L.pp]. The
+        // map selects the implied opcode escape (1: 0F, 2: 0F 38), pp the
+        // implied SSE prefix (1: 66) and L the vector length (0: 128 bits or
+        // scalar, 1: 256 bits). The R, X, B and vvvv fields are passed as
+        // register ids and extension flags and get inverted here.
+        void EmitVex(uint8_t map,
+                     bool w,
+                     unsigned vvvv,
+                     bool l,
+                     uint8_t pp,
+                     bool r,
+                     bool b);
+
+        // Scalar FMA3 instructions are encoded with a three byte VEX prefix as
+        // C4 [RXB.00010] [W.vvvv.0.01] OPCODE, i.e. with the implied 66 0F 38
+        // prefix and opcode escape. VEX.W selects between the single and the
+        // double precision flavor and vvvv holds the inverted second register.
+        template <uint8_t OPCODE, unsigned SIZE>
+        void VexFma(Register<SIZE, true> dest,
+                    Register<SIZE, true> src1,
+                    Register<SIZE, true> src2);
+
+        // Opcode bytes for EmitPacked(). The primary template is left
+        // undefined so that unsupported opcodes fail to compile. c_isUnary
+        // is set for the instructions which don't read the destination.
+        template <OpCode OP>
+        struct PackedEncoding;
+
+        // Double precision instruction on WIDTH lanes, see EmitPacked(). The
+        // WIDTH 1 and 2 flavors use the F2 and 66 SSE prefixes respectively,
+        // WIDTH 4 uses VEX.256.66.0F with vvvv set to the destination for
+        // binary instructions.
+        template <uint8_t OPCODE, bool ISUNARY, unsigned WIDTH>
+        void PackedSSE(Register<8, true> dest, Register<8, true> src);
+
+        template <uint8_t OPCODE, bool ISUNARY, unsigned WIDTH>
+        void PackedSSE(Register<8, true> dest, Register<8, false> src, int32_t srcOffset);
+
+        template <uint8_t OPCODE, unsigned WIDTH>
+        void PackedSSE(Register<8, false> dest, int32_t destOffset, Register<8, true> src);
+
         // Scalar SSE instructions are encoded as XX 0F OPCODE, where XX is
         // either 0xF2 or 0xF3 depending on the register size. Used for
         // instructions operating on scalars (f. ex. MovSS/SD, AddSS/SD) rather
@@ -528,6 +608,12 @@ namespace NativeJIT
                 template <unsigned SIZE>
                 static void Emit(X64CodeGenerator& code, Register<SIZE, ISFLOAT> dest, Register<SIZE, ISFLOAT> src);
 
+                template <unsigned SIZE>
+                static void Emit(X64CodeGenerator& code,
+                                 Register<SIZE, ISFLOAT> dest,
+                                 Register<SIZE, ISFLOAT> src1,
+                                 Register<SIZE, ISFLOAT> src2);
+
                 template <unsigned SIZE>
                 static void Emit(X64CodeGenerator& code, Register<SIZE, ISFLOAT> dest, Register<8, false> src, int32_t srcOffset);
 
@@ -614,6 +700,12 @@ namespace NativeJIT
             template <unsigned SIZE1, bool ISFLOAT1, unsigned SIZE2, bool ISFLOAT2>
             void Print(OpCode op, Register<SIZE1, ISFLOAT1> dest, Register<SIZE2, ISFLOAT2> src);
 
+            template <unsigned SIZE, bool ISFLOAT>
+            void Print(OpCode op,
+                       Register<SIZE, ISFLOAT> dest,
+                       Register<SIZE, ISFLOAT> src1,
+                       Register<SIZE, ISFLOAT> src2);
+
             template <unsigned SIZE1, bool ISFLOAT1, unsigned SIZE2, bool ISFLOAT2>
             void Print(OpCode op, Register<SIZE1, ISFLOAT1> dest, Register<8, false> src, int32_t srcOffset);
 
@@ -777,6 +869,26 @@ namespace NativeJIT
     }
 
 
+    template <unsigned SIZE, bool ISFLOAT>
+    void X64CodeGenerator::CodePrinter::Print(OpCode op,
+                                              Register<SIZE, ISFLOAT> dest,
+                                              Register<SIZE, ISFLOAT> src1,
+                                              Register<SIZE, ISFLOAT> src2)
+    {
+        if (m_out != nullptr)
+        {
+            PrintBytes(m_startPosition, m_code.CurrentPosition());
+
+            *m_out
+                << OpCodeName(op)
+                << ' ' << dest.GetName()
+                << ", " << src1.GetName()
+                << ", " << src2.GetName()
+                << std::endl;
+        }
+    }
+
+
     template <unsigned SIZE1, bool ISFLOAT1, unsigned SIZE2, bool ISFLOAT2>
     void X64CodeGenerator::CodePrinter::Print(OpCode op,
                                               Register<SIZE1, ISFLOAT1> dest,
@@ -1057,6 +1169,88 @@ namespace NativeJIT
     }
 
 
+    template <OpCode OP, unsigned SIZE, bool ISFLOAT>
+    void X64CodeGenerator::Emit(Register<SIZE, ISFLOAT> dest,
+                                Register<SIZE, ISFLOAT> src1,
+                                Register<SIZE, ISFLOAT> src2)
+    {
+        CodePrinter printer(*this);
+
+        Helper<OP>::template ArgTypes1<ISFLOAT>::template Emit<SIZE>(*this, dest, src1, src2);
+
+        printer.Print(OP, dest, src1, src2);
+    }
+
+
+    template <OpCode OP, unsigned WIDTH>
+    void X64CodeGenerator::EmitPacked(Register<8, true> dest, Register<8, true> src)
+    {
+        CodePrinter printer(*this);
+
+        if (OP == OpCode::Mov)
+        {
+            // MovAPD copies the whole register for both scalars and packed
+            // values, avoiding the merge with the destination done by MovSD.
+            PackedSSE<0x28, true, WIDTH == 1 ? 2 : WIDTH>(dest, src);
+        }
+        else
+        {
+            PackedSSE<PackedEncoding<OP>::c_opcode, PackedEncoding<OP>::c_isUnary, WIDTH>(dest, src);
+        }
+
+        printer.Print(OP, dest, src);
+    }
+
+
+    template <OpCode OP, unsigned WIDTH>
+    void X64CodeGenerator::EmitPacked(Register<8, true> dest, Register<8, false> src, int32_t srcOffset)
+    {
+        CodePrinter printer(*this);
+
+        PackedSSE<PackedEncoding<OP>::c_opcode, PackedEncoding<OP>::c_isUnary, WIDTH>(dest, src, srcOffset);
+
+        printer.Print<8, true, 8, true>(OP, dest, src, srcOffset);
+    }
+
+
+    template <OpCode OP, unsigned WIDTH>
+    void X64CodeGenerator::EmitPacked(Register<8, false> dest, int32_t destOffset, Register<8, true> src)
+    {
+        static_assert(OP == OpCode::Mov, "Only Mov can store packed values.");
+
+        CodePrinter printer(*this);
+
+        PackedSSE<0x11, WIDTH>(dest, destOffset, src);
+
+        printer.Print<8, true, 8, true>(OP, dest, destOffset, src);
+    }
+
+
+    template <OpCode OP, unsigned WIDTH>
+    void X64CodeGenerator::EmitPacked(Register<8, true> dest,
+                                      Register<8, true> src1,
+                                      Register<8, true> src2)
+    {
+        static_assert(OP == OpCode::Vfmadd231, "Only Vfmadd231 has three packed operands.");
+        static_assert(WIDTH == 1 || WIDTH == 2 || WIDTH == 4, "Invalid number of lanes.");
+
+        CodePrinter printer(*this);
+
+        if (WIDTH == 1)
+        {
+            VexFma<0xb9>(dest, src1, src2);
+        }
+        else
+        {
+            EmitVex(2, true, src1.GetId(), WIDTH == 4, 1, dest.IsExtended(), src2.IsExtended());
+            Emit8(0xb8);
+            EmitModRM(dest, src2);
+        }
+
+        printer.Print(OP, dest, src1, src2);
+    }
+
+
     template <OpCode OP, unsigned SIZE1, bool ISFLOAT1, unsigned SIZE2, bool ISFLOAT2>
     void X64CodeGenerator::Emit(Register<SIZE1, ISFLOAT1> dest, Register<SIZE2, ISFLOAT2> src)
     {
@@ -1462,6 +1656,92 @@ namespace NativeJIT
     }
 
 
+    template <uint8_t OPCODE, unsigned SIZE>
+    void X64CodeGenerator::VexFma(Register<SIZE, true> dest,
+                                  Register<SIZE, true> src1,
+                                  Register<SIZE, true> src2)
+    {
+        EmitVex(2, SIZE == 8, src1.GetId(), false, 1, dest.IsExtended(), src2.IsExtended());
+        Emit8(OPCODE);
+        EmitModRM(dest, src2);
+    }
+
+
+    template <uint8_t OPCODE, bool ISUNARY, unsigned WIDTH>
+    void X64CodeGenerator::PackedSSE(Register<8, true> dest, Register<8, true> src)
+    {
+        static_assert(WIDTH == 1 || WIDTH == 2 || WIDTH == 4, "Invalid number of lanes.");
+
+        if (WIDTH == 1)
+        {
+            ScalarSSE<OPCODE>(dest, src);
+        }
+        else if (WIDTH == 2)
+        {
+            SSEx66<OPCODE>(dest, src);
+        }
+        else
+        {
+            EmitVex(1, false, ISUNARY ? 0 : dest.GetId(), true, 1, dest.IsExtended(), src.IsExtended());
+            Emit8(OPCODE);
+            EmitModRM(dest, src);
+        }
+    }
+
+
+    template <uint8_t OPCODE, bool ISUNARY, unsigned WIDTH>
+    void X64CodeGenerator::PackedSSE(Register<8, true> dest, Register<8, false> src, int32_t srcOffset)
+    {
+        static_assert(WIDTH == 1 || WIDTH == 2 || WIDTH == 4, "Invalid number of lanes.");
+
+        if (WIDTH == 1)
+        {
+            ScalarSSE<OPCODE, 8, true, 8, true>(dest, src, srcOffset);
+        }
+        else if (WIDTH == 2)
+        {
+            SSEx66<OPCODE, 8, true, 8, true>(dest, src, srcOffset);
+        }
+        else
+        {
+            // RIP is encoded through ModRM rather than with the B field.
+            EmitVex(1,
+                    false,
+                    ISUNARY ? 0 : dest.GetId(),
+                    true,
+                    1,
+                    dest.IsExtended(),
+                    src.IsExtended() && !src.IsRIP());
+            Emit8(OPCODE);
+            EmitModRMOffset(dest, src, srcOffset);
+        }
+    }
+
+
+    template <uint8_t OPCODE, unsigned WIDTH>
+    void X64CodeGenerator::PackedSSE(Register<8, false> dest, int32_t destOffset, Register<8, true> src)
+    {
+        static_assert(WIDTH == 1 || WIDTH == 2 || WIDTH == 4, "Invalid number of lanes.");
+
+        // Note: operand encoding is MR, so the order of arguments for the
+        // Emit*() methods is reversed.
+        if (WIDTH == 1)
+        {
+            ScalarSSE<OPCODE, 8, true, 8, true>(dest, destOffset, src);
+        }
+        else if (WIDTH == 2)
+        {
+            SSEx66<OPCODE, 8, true, 8, true>(dest, destOffset, src);
+        }
+        else
+        {
+            EmitVex(1, false, 0, true, 1, src.IsExtended(), dest.IsExtended() && !dest.IsRIP());
+            Emit8(OPCODE);
+            EmitModRMOffset(src, dest, destOffset);
+        }
+    }
+
+
     //
     // Scalar SSE instructions
     //
@@ -2847,9 +3127,13 @@ namespace NativeJIT
 
     DEFINE_SSE_ARGS1(Add,            ScalarSSE, 0x58);  // AddSS/AddSD.
     DEFINE_SSE_ARGS1(Cmp,            SSEx66,    0x2f);  // ComISS/ComISD.
+    DEFINE_SSE_ARGS1(Div,            ScalarSSE, 0x5e);  // DivSS/DivSD.
     DEFINE_SSE_ARGS1(IMul,           ScalarSSE, 0x59);  // MulSS/MulSD.
+    DEFINE_SSE_ARGS1(Max,            ScalarSSE, 0x5f);  // MaxSS/MaxSD.
+    DEFINE_SSE_ARGS1(Min,            ScalarSSE, 0x5d);  // MinSS/MinSD.
     DEFINE_SSE_ARGS1(Mov,            ScalarSSE, 0x10);  // MovSS/MovSD.
     DEFINE_SSE_ARGS1(MovAP,          SSEx66,    0x28);  // MovAPS/MovAPD.
+    DEFINE_SSE_ARGS1(Sqrt,           ScalarSSE, 0x51);  // SqrtSS/SqrtSD.
     DEFINE_SSE_ARGS1(Sub,            ScalarSSE, 0x5c);  // SubSS/SubSD.
 
 #undef DEFINE_SSE_ARGS1
@@ -2869,6 +3153,42 @@ namespace NativeJIT
     }
 
 
+    // VFMAdd231SS/VFMAdd231SD: dest = src1 * src2 + dest.
+    template <>
+    template <>
+    template <unsigned SIZE>
+    void X64CodeGenerator::Helper<OpCode::Vfmadd231>::ArgTypes1<true>::Emit(
+        X64CodeGenerator& code,
+        Register<SIZE, true> dest,
+        Register<SIZE, true> src1,
+        Register<SIZE, true> src2)
+    {
+        code.VexFma<0xb9>(dest, src1, src2);
+    }
+
+
+    // Opcodes for EmitPacked(). The same opcode byte encodes the scalar
+    // (F2 prefix) and the packed (66 prefix or VEX.66) double instruction.
+#define DEFINE_PACKED_ENCODING(name, opcode, isUnary)                                   \
+    template <>                                                                         \
+    struct X64CodeGenerator::PackedEncoding<OpCode::name>                               \
+    {                                                                                   \
+        static const uint8_t c_opcode = opcode;                                         \
+        static const bool c_isUnary = isUnary;                                          \
+    };
+
+    DEFINE_PACKED_ENCODING(Add,  0x58, false);  // AddSD/AddPD.
+    DEFINE_PACKED_ENCODING(Div,  0x5e, false);  // DivSD/DivPD.
+    DEFINE_PACKED_ENCODING(IMul, 0x59, false);  // MulSD/MulPD.
+    DEFINE_PACKED_ENCODING(Max,  0x5f, false);  // MaxSD/MaxPD.
+    DEFINE_PACKED_ENCODING(Min,  0x5d, false);  // MinSD/MinPD.
+    DEFINE_PACKED_ENCODING(Mov,  0x10, true);   // MovSD/MovUPD load.
+    DEFINE_PACKED_ENCODING(Sqrt, 0x51, true);   // SqrtSD/SqrtPD.
+    DEFINE_PACKED_ENCODING(Sub,  0x5c, false);  // SubSD/SubPD.
+
+#undef DEFINE_PACKED_ENCODING
+
+
 // SSE instruction, arguments of different type or size.
 #define DEFINE_SSE_ARGS2(name, emitMethod, opcode, type1, type2, validityCondition)     \
     template <>                                                                         \
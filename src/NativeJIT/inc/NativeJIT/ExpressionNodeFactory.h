@@ -31,7 +31,10 @@
 //
 // Implementation includes
 //
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #include "NativeJIT/BitOperations.h"
 #include "NativeJIT/Nodes/BinaryImmediateNode.h"
@@ -43,12 +46,14 @@
 #include "NativeJIT/Nodes/FieldPointerNode.h"
 #include "NativeJIT/Nodes/ImmediateNode.h"
 #include "NativeJIT/Nodes/IndirectNode.h"
+#include "NativeJIT/Nodes/MulAddNode.h"
 #include "NativeJIT/Nodes/Node.h"
 #include "NativeJIT/Nodes/PackedMinMaxNode.h"
 #include "NativeJIT/Nodes/ParameterNode.h"
 #include "NativeJIT/Nodes/ReturnNode.h"
 #include "NativeJIT/Nodes/ShldNode.h"
 #include "NativeJIT/Nodes/StackVariableNode.h"
+#include "NativeJIT/Nodes/UnaryNode.h"
 #include "Temporary/Allocator.h"
 
 
@@ -66,7 +71,17 @@ namespace NativeJIT
     template <typename T>
     ImmediateNode<T>& ExpressionNodeFactory::Immediate(T value)
     {
-        return PlacementConstruct<ImmediateNode<T>>(*this, value);
+        return ConstructUnique<ImmediateNode<T>>(GetValueBits(value), 0, 0, *this, value);
+    }
+
+
+    template <typename T>
+    Node<T>& ExpressionNodeFactory::Relocatable(T address)
+    {
+        static_assert(std::is_pointer<T>::value, "Only addresses can be relocated.");
+
+        return ConstructUnique<ImmediateNode<T, ImmediateCategory::RIPRelativeImmediate>>(
+            GetValueBits(address), 0, 0, *this, address, true);
     }
 
 
@@ -105,7 +120,7 @@ namespace NativeJIT
     template <typename TO, typename FROM>
     Node<TO>& ExpressionNodeFactory::Cast(Node<FROM>& source)
     {
-        return PlacementConstruct<CastNode<TO, FROM>>(*this, source);
+        return ConstructUnique<CastNode<TO, FROM>>(source.GetId(), 0, 0, *this, source);
     }
 
 
@@ -160,7 +175,12 @@ namespace NativeJIT
     template <typename T>
     Node<T>& ExpressionNodeFactory::Deref(Node<T*>& pointer, int32_t index)
     {
-        return PlacementConstruct<IndirectNode<T>>(*this, pointer, index);
+        return ConstructUnique<IndirectNode<T>>(pointer.GetId(),
+                                                GetValueBits(index),
+                                                0,
+                                                *this,
+                                                pointer,
+                                                index);
     }
 
 
@@ -288,6 +308,58 @@ namespace NativeJIT
     }
 
 
+    template <typename T>
+    Node<T>& ExpressionNodeFactory::Div(Node<T>& left, Node<T>& right)
+    {
+        static_assert(std::is_floating_point<T>::value, "Div() supports only floating point types.");
+
+        return Binary<OpCode::Div>(left, right);
+    }
+
+
+    template <typename T>
+    Node<T>& ExpressionNodeFactory::Max(Node<T>& left, Node<T>& right)
+    {
+        static_assert(std::is_floating_point<T>::value, "Max() supports only floating point types.");
+
+        return Binary<OpCode::Max>(left, right);
+    }
+
+
+    template <typename T>
+    Node<T>& ExpressionNodeFactory::Min(Node<T>& left, Node<T>& right)
+    {
+        static_assert(std::is_floating_point<T>::value, "Min() supports only floating point types.");
+
+        return Binary<OpCode::Min>(left, right);
+    }
+
+
+    template <typename T>
+    Node<T>& ExpressionNodeFactory::Sqrt(Node<T>& value)
+    {
+        return ConstructUnique<UnaryNode<OpCode::Sqrt, T>>(value.GetId(), 0, 0, *this, value);
+    }
+
+
+    template <typename T>
+    Node<T>& ExpressionNodeFactory::MulAdd(Node<T>& left, Node<T>& right, Node<T>& addend)
+    {
+        // Multiplication is commutative, so the factors are keyed in the
+        // order of their IDs.
+        const unsigned first = (std::min)(left.GetId(), right.GetId());
+        const unsigned second = (std::max)(left.GetId(), right.GetId());
+
+        return ConstructUnique<MulAddNode<T>>(first,
+                                              second,
+                                              addend.GetId(),
+                                              *this,
+                                              left,
+                                              right,
+                                              addend);
+    }
+
+
     template <typename T>
     Node<T>& ExpressionNodeFactory::Shld(Node<T>& shiftee, Node<T>& filler, uint8_t bitCount)
     {
@@ -419,6 +491,33 @@ namespace NativeJIT
     }
 
 
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    Node<R>& ExpressionNodeFactory::Call(Node<R (*)(P1, P2, P3, P4, P5)>& function,
+                                         Node<P1>& param1,
+                                         Node<P2>& param2,
+                                         Node<P3>& param3,
+                                         Node<P4>& param4,
+                                         Node<P5>& param5)
+    {
+        return PlacementConstruct<CallNode<R, P1, P2, P3, P4, P5>>(
+            *this, function, param1, param2, param3, param4, param5);
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    Node<R>& ExpressionNodeFactory::Call(Node<R (*)(P1, P2, P3, P4, P5, P6)>& function,
+                                         Node<P1>& param1,
+                                         Node<P2>& param2,
+                                         Node<P3>& param3,
+                                         Node<P4>& param4,
+                                         Node<P5>& param5,
+                                         Node<P6>& param6)
+    {
+        return PlacementConstruct<CallNode<R, P1, P2, P3, P4, P5, P6>>(
+            *this, function, param1, param2, param3, param4, param5, param6);
+    }
+
+
     //
     // PackedMinMax
     //
@@ -442,13 +541,83 @@ namespace NativeJIT
     template <OpCode OP, typename L, typename R>
     Node<L>& ExpressionNodeFactory::Binary(Node<L>& left, Node<R>& right)
     {
-        return PlacementConstruct<BinaryNode<OP, L, R>>(*this, left, right);
+        // The order of operands doesn't matter for commutative operations on
+        // operands of the same type, so they are keyed in the order of IDs.
+        // Note: And, Or and Xor are commutative for the integer types they
+        // are defined for, as are Add and IMul for both integer and floating
+        // point types.
+        const bool isCommutative = std::is_same<L, R>::value
+                                   && (OP == OpCode::Add
+                                       || OP == OpCode::And
+                                       || OP == OpCode::IMul
+                                       || OP == OpCode::Or
+                                       || OP == OpCode::Xor);
+        const bool isSwapped = isCommutative && right.GetId() < left.GetId();
+
+        return ConstructUnique<BinaryNode<OP, L, R>>(isSwapped ? right.GetId() : left.GetId(),
+                                                     isSwapped ? left.GetId() : right.GetId(),
+                                                     0,
+                                                     *this,
+                                                     left,
+                                                     right);
     }
 
 
     template <OpCode OP, typename L, typename R>
     Node<L>& ExpressionNodeFactory::BinaryImmediate(Node<L>& left, R right)
     {
-        return PlacementConstruct<BinaryImmediateNode<OP, L, R>>(*this, left, right);
+        return ConstructUnique<BinaryImmediateNode<OP, L, R>>(left.GetId(),
+                                                              GetValueBits(right),
+                                                              0,
+                                                              *this,
+                                                              left,
+                                                              right);
+    }
+
+
+    template <typename NODE, typename... ConstructorArgs>
+    NODE& ExpressionNodeFactory::ConstructUnique(uint64_t operand0,
+                                                 uint64_t operand1,
+                                                 uint64_t operand2,
+                                                 ConstructorArgs&&... constructorArgs)
+    {
+        if (!m_isCommonSubexpressionEliminationEnabled)
+        {
+            return PlacementConstruct<NODE>(std::forward<ConstructorArgs>(constructorArgs)...);
+        }
+
+        const NodeKey key = { GetNodeType<NODE>(), { operand0, operand1, operand2 } };
+        auto it = m_uniqueNodes.find(key);
+
+        if (it != m_uniqueNodes.end())
+        {
+            return static_cast<NODE&>(*it->second);
+        }
+
+        NODE& node = PlacementConstruct<NODE>(std::forward<ConstructorArgs>(constructorArgs)...);
+        m_uniqueNodes.insert(std::make_pair(key, static_cast<NodeBase*>(&node)));
+
+        return node;
+    }
+
+
+    template <typename NODE>
+    void const * ExpressionNodeFactory::GetNodeType()
+    {
+        static const char c_nodeType = 0;
+
+        return &c_nodeType;
+    }
+
+
+    template <typename T>
+    uint64_t ExpressionNodeFactory::GetValueBits(T value)
+    {
+        static_assert(sizeof(T) <= sizeof(uint64_t), "Immediate value is too large");
+
+        uint64_t bits = 0;
+        memcpy(&bits, &value, sizeof(T));
+
+        return bits;
     }
 }
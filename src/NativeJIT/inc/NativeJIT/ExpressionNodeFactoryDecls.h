@@ -23,12 +23,17 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>                           // std::equal_to for m_uniqueNodes.
+#include <unordered_map>                        // Embedded member.
+#include <utility>
 
 #include "NativeJIT/CodeGen/X64CodeGenerator.h" // JccType.
 #include "NativeJIT/ExpressionTreeDecls.h"      // Base class.
 #include "NativeJIT/Model.h"                    // Parameter.
 #include "NativeJIT/Nodes/ImmediateNodeDecls.h" // Parameter too cumbersome to forward declare.
+#include "Temporary/StlAllocator.h"             // Embedded member.
 
 
 namespace NativeJIT
@@ -51,10 +56,32 @@ namespace NativeJIT
     public:
         ExpressionNodeFactory(Allocators::IAllocator& allocator, FunctionBuffer& code);
 
+        // Enables or disables common subexpression elimination for the nodes
+        // created afterwards. While enabled, the factory methods for
+        // immediates, casts, dereferences and arithmetic operators return the
+        // node created earlier for the same operation on the same children
+        // (or immediate values) instead of creating a new one. Operands of
+        // commutative integer and floating point operations are matched in
+        // either order. The shared node is evaluated only once. Disabled by
+        // default.
+        //
+        // Note: merging dereferences assumes that the memory read by the
+        // expression is not modified while the expression is being evaluated,
+        // f. ex. by the functions it calls.
+        void EnableCommonSubexpressionElimination();
+        void DisableCommonSubexpressionElimination();
+
         //
         // Leaf nodes
         //
         template <typename T> ImmediateNode<T>& Immediate(T value);
+
+        // Returns an immediate for an absolute address, f. ex. a function
+        // pointer, which is stored next to the code and recorded as its
+        // relocation instead of being encoded in the instructions. Code which
+        // only references addresses through Relocatable() can be stored in a
+        // CodeCache and loaded into another process.
+        template <typename T> Node<T>& Relocatable(T address);
         template <typename T> ParameterNode<T>& Parameter(ParameterSlotAllocator& slotAllocator);
 
         // See StackVariableNode for important information about stack variable
@@ -123,6 +150,25 @@ namespace NativeJIT
 
         template <typename T, typename INDEX> Node<T*>& Add(Node<T*>& array, Node<INDEX>& index);
 
+        //
+        // Floating point arithmetic operators
+        //
+
+        // Note: Min() and Max() follow the semantics of MinSD/MaxSD. If either
+        // of the operands is NaN or if both are zeros, the right operand is
+        // returned.
+        template <typename T> Node<T>& Div(Node<T>& left, Node<T>& right);
+        template <typename T> Node<T>& Max(Node<T>& left, Node<T>& right);
+        template <typename T> Node<T>& Min(Node<T>& left, Node<T>& right);
+        template <typename T> Node<T>& Sqrt(Node<T>& value);
+
+        // Fused multiply-add, left * right + addend, with a single rounding.
+        // WARNING: The generated code uses FMA3 instructions and will raise
+        // an invalid opcode exception on CPUs without FMA3 support. Callers
+        // are responsible for checking the support before using MulAdd().
+        template <typename T>
+        Node<T>& MulAdd(Node<T>& left, Node<T>& right, Node<T>& addend);
+
         //
         // Ternary arithmetic operators
         template <typename T>
@@ -167,6 +213,12 @@ namespace NativeJIT
         //
         // Call node
         //
+        // The parameters are passed in registers only, so a call can have at
+        // most as many parameters as the compiled function itself (see
+        // c_maxIntegerRegisterParameters). Arguments that would go on the
+        // stack are not supported: to hand many values to a callee, pass a
+        // pointer to an array of them, which the callee or the compiled code
+        // reads with Deref(pointer, index).
         template <typename R>
         Node<R>& Call(Node<R (*)()>& function);
 
@@ -189,6 +241,23 @@ namespace NativeJIT
                       Node<P3>& param3,
                       Node<P4>& param4);
 
+        template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+        Node<R>& Call(Node<R (*)(P1, P2, P3, P4, P5)>& function,
+                      Node<P1>& param1,
+                      Node<P2>& param2,
+                      Node<P3>& param3,
+                      Node<P4>& param4,
+                      Node<P5>& param5);
+
+        template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+        Node<R>& Call(Node<R (*)(P1, P2, P3, P4, P5, P6)>& function,
+                      Node<P1>& param1,
+                      Node<P2>& param2,
+                      Node<P3>& param3,
+                      Node<P4>& param4,
+                      Node<P5>& param5,
+                      Node<P6>& param6);
+
         //
         // Packed operators
         //
@@ -202,5 +271,47 @@ namespace NativeJIT
     private:
         template <OpCode OP, typename L, typename R> Node<L>& Binary(Node<L>& left, Node<R>& right);
         template <OpCode OP, typename L, typename R> Node<L>& BinaryImmediate(Node<L>& left, R right);
+
+        // Identifies structurally identical nodes for common subexpression
+        // elimination: the node class, including its template arguments, and
+        // up to three operands which are either IDs of the child nodes or bits
+        // of immediate values.
+        struct NodeKey
+        {
+            void const * m_nodeType;
+            uint64_t m_operands[3];
+
+            bool operator==(NodeKey const & other) const;
+        };
+
+        struct NodeKeyHash
+        {
+            size_t operator()(NodeKey const & key) const;
+        };
+
+        // Constructs the node unless common subexpression elimination is
+        // enabled and a node of the same class has already been constructed
+        // with the same operands, in which case that node is returned.
+        template <typename NODE, typename... ConstructorArgs>
+        NODE& ConstructUnique(uint64_t operand0,
+                              uint64_t operand1,
+                              uint64_t operand2,
+                              ConstructorArgs&&... constructorArgs);
+
+        // Returns an address unique to the node class.
+        template <typename NODE>
+        static void const * GetNodeType();
+
+        // Returns the bits of an immediate value zero extended to 64 bits.
+        template <typename T>
+        static uint64_t GetValueBits(T value);
+
+        bool m_isCommonSubexpressionEliminationEnabled;
+
+        std::unordered_map<NodeKey,
+                           NodeBase*,
+                           NodeKeyHash,
+                           std::equal_to<NodeKey>,
+                           Allocators::StlAllocator<std::pair<const NodeKey, NodeBase*>>> m_uniqueNodes;
     };
 }
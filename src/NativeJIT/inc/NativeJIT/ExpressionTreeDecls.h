@@ -128,6 +128,10 @@ namespace NativeJIT
 
         void AddRIPRelative(RIPRelativeImmediate& node);
         void ReportFunctionCallNode(unsigned parameterCount);
+
+        // Called for immediates holding absolute addresses which are encoded
+        // in instructions and thus make the code not relocatable.
+        void ReportAbsoluteAddress();
         void Compile();
 
         //
@@ -305,6 +309,11 @@ namespace NativeJIT
         // parameter. Returns false otherwise.
         bool TemporaryOffsetToSlot(int32_t temporaryOffset, unsigned& temporarySlot);
 
+        // Evaluates the nodes whose inputs are all constants at compile time.
+        // Runs before Pass0 which emits the RIP-relative constants, including
+        // the ones created for the folded values.
+        void FoldConstants();
+
         void Pass0();
         void Pass1();
         void Pass2();
@@ -353,6 +362,10 @@ namespace NativeJIT
         // Negative value signifies no function calls made.
         int m_maxFunctionCallParameters;
 
+        // Whether any immediate holds an absolute address, see
+        // ReportAbsoluteAddress().
+        bool m_hasAbsoluteAddresses;
+
         PointerRegister m_basePointer;
 
         Label m_startOfEpilogue;
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "NativeJIT/BatchCompiler.h"
 #include "NativeJIT/ExecutionPreconditionTest.h"
 #include "NativeJIT/ExpressionNodeFactory.h"
 #include "NativeJIT/TypePredicates.h"
@@ -40,17 +41,91 @@ namespace NativeJIT
         void AddExecuteOnlyIfStatement(FlagExpressionNode<JCC>& condition,
                                        ImmediateNode<R>& otherwiseValue);
 
+        // Compiles the expression into batchCode as a function evaluating it
+        // for arrays of points, see BatchCompiler. The parameters of the
+        // function are read from inputs[0] for P1, inputs[1] for P2, etc.
+        // Execution precondition tests are not evaluated in batches. The
+        // expression may also be compiled with Compile(), in either order.
+        BatchCompiler::FunctionType CompileBatch(Node<R>& expression,
+                                                 FunctionBuffer& batchCode);
+        BatchCompiler::FunctionType CompileBatch(Node<R>& expression,
+                                                 FunctionBuffer& batchCode,
+                                                 BatchInstructionSet instructionSet);
+
     private:
         Allocators::IAllocator& m_allocator;
     };
 
 
-    template <typename R, typename P1 = void, typename P2 = void, typename P3 = void, typename P4 = void>
+    // A function taking up to six parameters, all of which are passed in
+    // registers (see c_maxIntegerRegisterParameters for the limits of each
+    // ABI; Windows allows four). Parameters passed on the stack are not
+    // supported. Expressions over more variables, such as the rate laws of a
+    // large model, take a single pointer to a state vector and read the
+    // variables with Deref(state, index), which folds the index into the
+    // memory operand.
+    template <typename R, typename P1 = void, typename P2 = void, typename P3 = void, typename P4 = void, typename P5 = void, typename P6 = void>
     class Function : public FunctionBase<R>
     {
     public:
         Function(Allocators::IAllocator& allocator, FunctionBuffer& code);
 
+        ParameterNode<P1>& GetP1() const;
+        ParameterNode<P2>& GetP2() const;
+        ParameterNode<P3>& GetP3() const;
+        ParameterNode<P4>& GetP4() const;
+        ParameterNode<P5>& GetP5() const;
+        ParameterNode<P6>& GetP6() const;
+
+        typedef R (*FunctionType)(P1, P2, P3, P4, P5, P6);
+
+        FunctionType Compile(Node<R>& expression);
+
+        FunctionType GetEntryPoint() const;
+
+    private:
+        ParameterNode<P1>* m_p1;
+        ParameterNode<P2>* m_p2;
+        ParameterNode<P3>* m_p3;
+        ParameterNode<P4>* m_p4;
+        ParameterNode<P5>* m_p5;
+        ParameterNode<P6>* m_p6;
+    };
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    class Function<R, P1, P2, P3, P4, P5> : public FunctionBase<R>
+    {
+    public:
+        Function(Allocators::IAllocator& allocator, FunctionBuffer& code);
+
+        ParameterNode<P1>& GetP1() const;
+        ParameterNode<P2>& GetP2() const;
+        ParameterNode<P3>& GetP3() const;
+        ParameterNode<P4>& GetP4() const;
+        ParameterNode<P5>& GetP5() const;
+
+        typedef R (*FunctionType)(P1, P2, P3, P4, P5);
+
+        FunctionType Compile(Node<R>& expression);
+
+        FunctionType GetEntryPoint() const;
+
+    private:
+        ParameterNode<P1>* m_p1;
+        ParameterNode<P2>* m_p2;
+        ParameterNode<P3>* m_p3;
+        ParameterNode<P4>* m_p4;
+        ParameterNode<P5>* m_p5;
+    };
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4>
+    class Function<R, P1, P2, P3, P4> : public FunctionBase<R>
+    {
+    public:
+        Function(Allocators::IAllocator& allocator, FunctionBuffer& code);
+
         ParameterNode<P1>& GetP1() const;
         ParameterNode<P2>& GetP2() const;
         ParameterNode<P3>& GetP3() const;
@@ -173,6 +248,193 @@ namespace NativeJIT
     }
 
 
+    template <typename R>
+    BatchCompiler::FunctionType FunctionBase<R>::CompileBatch(Node<R>& expression,
+                                                              FunctionBuffer& batchCode)
+    {
+        return CompileBatch(expression, batchCode, BatchCompiler::GetWidestInstructionSet());
+    }
+
+
+    template <typename R>
+    BatchCompiler::FunctionType FunctionBase<R>::CompileBatch(Node<R>& expression,
+                                                              FunctionBuffer& batchCode,
+                                                              BatchInstructionSet instructionSet)
+    {
+        static_assert(std::is_same<R, double>::value,
+                      "Only functions returning double can be evaluated in batches.");
+
+        BatchCompiler compiler(m_allocator, batchCode);
+
+        return compiler.Compile(expression, instructionSet);
+    }
+
+
+    //*************************************************************************
+    //
+    // Function<R, P1, P2, P3, P4, P5, P6> template definitions.
+    //
+    //*************************************************************************
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    Function<R, P1, P2, P3, P4, P5, P6>::Function(Allocators::IAllocator& allocator,
+                                                  FunctionBuffer& code)
+        : FunctionBase<R>(allocator, code)
+    {
+        static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
+        static_assert(IsValidParameter<P2>::c_value, "P2 is an invalid type.");
+        static_assert(IsValidParameter<P3>::c_value, "P3 is an invalid type.");
+        static_assert(IsValidParameter<P4>::c_value, "P4 is an invalid type.");
+        static_assert(IsValidParameter<P5>::c_value, "P5 is an invalid type.");
+        static_assert(IsValidParameter<P6>::c_value, "P6 is an invalid type.");
+
+        ParameterSlotAllocator slotAllocator;
+        m_p1 = &this->template Parameter<P1>(slotAllocator);
+        m_p2 = &this->template Parameter<P2>(slotAllocator);
+        m_p3 = &this->template Parameter<P3>(slotAllocator);
+        m_p4 = &this->template Parameter<P4>(slotAllocator);
+        m_p5 = &this->template Parameter<P5>(slotAllocator);
+        m_p6 = &this->template Parameter<P6>(slotAllocator);
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    ParameterNode<P1>& Function<R, P1, P2, P3, P4, P5, P6>::GetP1() const
+    {
+        return *m_p1;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    ParameterNode<P2>& Function<R, P1, P2, P3, P4, P5, P6>::GetP2() const
+    {
+        return *m_p2;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    ParameterNode<P3>& Function<R, P1, P2, P3, P4, P5, P6>::GetP3() const
+    {
+        return *m_p3;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    ParameterNode<P4>& Function<R, P1, P2, P3, P4, P5, P6>::GetP4() const
+    {
+        return *m_p4;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    ParameterNode<P5>& Function<R, P1, P2, P3, P4, P5, P6>::GetP5() const
+    {
+        return *m_p5;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    ParameterNode<P6>& Function<R, P1, P2, P3, P4, P5, P6>::GetP6() const
+    {
+        return *m_p6;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    typename Function<R, P1, P2, P3, P4, P5, P6>::FunctionType
+    Function<R, P1, P2, P3, P4, P5, P6>::Compile(Node<R>& value)
+    {
+        this->template Return<R>(value);
+        ExpressionTree::Compile();
+        return GetEntryPoint();
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    typename Function<R, P1, P2, P3, P4, P5, P6>::FunctionType
+    Function<R, P1, P2, P3, P4, P5, P6>::GetEntryPoint() const
+    {
+        return reinterpret_cast<FunctionType>(const_cast<void*>(this->GetUntypedEntryPoint()));
+    }
+
+
+    //*************************************************************************
+    //
+    // Function<R, P1, P2, P3, P4, P5> template definitions.
+    //
+    //*************************************************************************
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    Function<R, P1, P2, P3, P4, P5>::Function(Allocators::IAllocator& allocator,
+                                              FunctionBuffer& code)
+        : FunctionBase<R>(allocator, code)
+    {
+        static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
+        static_assert(IsValidParameter<P2>::c_value, "P2 is an invalid type.");
+        static_assert(IsValidParameter<P3>::c_value, "P3 is an invalid type.");
+        static_assert(IsValidParameter<P4>::c_value, "P4 is an invalid type.");
+        static_assert(IsValidParameter<P5>::c_value, "P5 is an invalid type.");
+
+        ParameterSlotAllocator slotAllocator;
+        m_p1 = &this->template Parameter<P1>(slotAllocator);
+        m_p2 = &this->template Parameter<P2>(slotAllocator);
+        m_p3 = &this->template Parameter<P3>(slotAllocator);
+        m_p4 = &this->template Parameter<P4>(slotAllocator);
+        m_p5 = &this->template Parameter<P5>(slotAllocator);
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    ParameterNode<P1>& Function<R, P1, P2, P3, P4, P5>::GetP1() const
+    {
+        return *m_p1;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    ParameterNode<P2>& Function<R, P1, P2, P3, P4, P5>::GetP2() const
+    {
+        return *m_p2;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    ParameterNode<P3>& Function<R, P1, P2, P3, P4, P5>::GetP3() const
+    {
+        return *m_p3;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    ParameterNode<P4>& Function<R, P1, P2, P3, P4, P5>::GetP4() const
+    {
+        return *m_p4;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    ParameterNode<P5>& Function<R, P1, P2, P3, P4, P5>::GetP5() const
+    {
+        return *m_p5;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    typename Function<R, P1, P2, P3, P4, P5>::FunctionType
+    Function<R, P1, P2, P3, P4, P5>::Compile(Node<R>& value)
+    {
+        this->template Return<R>(value);
+        ExpressionTree::Compile();
+        return GetEntryPoint();
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    typename Function<R, P1, P2, P3, P4, P5>::FunctionType
+    Function<R, P1, P2, P3, P4, P5>::GetEntryPoint() const
+    {
+        return reinterpret_cast<FunctionType>(const_cast<void*>(this->GetUntypedEntryPoint()));
+    }
+
+
     //*************************************************************************
     //
     // Function<R, P1, P2, P3, P4> template definitions.
@@ -23,20 +23,25 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "NativeJIT/CodeGen/X64CodeGenerator.h"     // OpCode type.
 #include "NativeJIT/CodeGenHelpers.h"
+#include "NativeJIT/Nodes/FoldableNode.h"
 #include "NativeJIT/Nodes/Node.h"
 
 
 namespace NativeJIT
 {
     template <OpCode OP, typename L, typename R>
-    class BinaryNode : public Node<L>
+    class BinaryNode : public FoldableNode<L>
     {
     public:
         BinaryNode(ExpressionTree& tree, Node<L>& left, Node<R>& right);
 
         virtual ExpressionTree::Storage<L> CodeGenValue(ExpressionTree& tree) override;
+        virtual bool TryFold() override;
+        virtual bool GetLaneOperation(LaneOperation& operation) const override;
 
         virtual void Print(std::ostream& out) const override;
 
@@ -60,7 +65,7 @@ namespace NativeJIT
     BinaryNode<OP, L, R>::BinaryNode(ExpressionTree& tree,
                                      Node<L>& left,
                                      Node<R>& right)
-        : Node<L>(tree),
+        : FoldableNode<L>(tree),
           m_left(left),
           m_right(right)
     {
@@ -72,6 +77,11 @@ namespace NativeJIT
     template <OpCode OP, typename L, typename R>
     typename ExpressionTree::Storage<L> BinaryNode<OP, L, R>::CodeGenValue(ExpressionTree& tree)
     {
+        if (this->IsFolded())
+        {
+            return this->CodeGenFoldedValue(tree);
+        }
+
         Storage<L> sLeft;
         Storage<R> sRight;
 
@@ -97,6 +107,44 @@ namespace NativeJIT
     }
 
 
+    template <OpCode OP, typename L, typename R>
+    bool BinaryNode<OP, L, R>::GetLaneOperation(LaneOperation& operation) const
+    {
+        if (this->IsFolded())
+        {
+            return this->GetFoldedLaneOperation(operation);
+        }
+
+        if (std::is_same<L, double>::value
+            && std::is_same<R, double>::value
+            && LaneOperation::IsSupported(OP, 2))
+        {
+            operation = LaneOperation::Operation(OP, m_left, m_right);
+            return true;
+        }
+
+        return false;
+    }
+
+
+    template <OpCode OP, typename L, typename R>
+    bool BinaryNode<OP, L, R>::TryFold()
+    {
+        typename std::decay<L>::type value;
+
+        if (ConstantFolding::FoldBinary<OP>(m_left, m_right, value))
+        {
+            this->SetFoldedValue(value);
+            m_left.DecrementParentCount();
+            m_right.DecrementParentCount();
+
+            return true;
+        }
+
+        return false;
+    }
+
+
     template <OpCode OP, typename L, typename R>
     void BinaryNode<OP, L, R>::Print(std::ostream& out) const
     {
@@ -107,5 +155,10 @@ namespace NativeJIT
 
         out << ", left = " << m_left.GetId();
         out << ", right = " << m_right.GetId();
+
+        if (this->IsFolded())
+        {
+            out << ", folded";
+        }
     }
 }
@@ -28,6 +28,7 @@
 #include "NativeJIT/AllocatorVector.h" // Embedded member.
 #include "NativeJIT/CodeGenHelpers.h"
 #include "NativeJIT/Nodes/Node.h"      // Base class.
+#include "NativeJIT/Nodes/ParameterNode.h" // ParameterSlotAllocator embedded member.
 #include "NativeJIT/TypePredicates.h"
 
 // https://software.intel.com/en-us/articles/introduction-to-x64-assembly
@@ -148,7 +149,9 @@ namespace NativeJIT
         class ParameterChild : public TypedChild<T>
         {
         public:
-            ParameterChild(Node<T>& expression, unsigned position);
+            // Allocates the register for the parameter from slotAllocator.
+            // The children must be constructed in the order of the parameters.
+            ParameterChild(Node<T>& expression, ParameterSlotAllocator& slotAllocator);
 
             typename ExpressionTree::Storage<T>::DirectRegister GetRegister() const;
 
@@ -203,10 +206,17 @@ namespace NativeJIT
         // Pointer to function's two base classes.
         FunctionChildBase* m_functionBase;
         Child* m_functionChild;
+
+        // Maps the parameters to registers, following the same rules as the
+        // parameters of the function being compiled (see ParameterNode).
+        ParameterSlotAllocator m_parameterSlots;
     };
 
 
-    template <typename R, typename P1 = void, typename P2 = void, typename P3 = void, typename P4 = void>
+    // The parameters of the call are passed in registers only, and the
+    // per-ABI limits of c_maxIntegerRegisterParameters apply. Callees that
+    // need more values take a pointer to them, see ExpressionNodeFactory::Call.
+    template <typename R, typename P1 = void, typename P2 = void, typename P3 = void, typename P4 = void, typename P5 = void, typename P6 = void>
     class CallNode;
 
 
@@ -299,7 +309,7 @@ namespace NativeJIT
 
 
     template <typename R, typename P1, typename P2, typename P3, typename P4>
-    class CallNode : public CallNodeBase<R, 4>
+    class CallNode<R, P1, P2, P3, P4> : public CallNodeBase<R, 4>
     {
     public:
         typedef R (*FunctionPointer)(P1, P2, P3, P4);
@@ -325,6 +335,66 @@ namespace NativeJIT
     };
 
 
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    class CallNode<R, P1, P2, P3, P4, P5> : public CallNodeBase<R, 5>
+    {
+    public:
+        typedef R (*FunctionPointer)(P1, P2, P3, P4, P5);
+
+        CallNode(ExpressionTree& tree,
+                 Node<FunctionPointer>& function,
+                 Node<P1>& p1,
+                 Node<P2>& p2,
+                 Node<P3>& p3,
+                 Node<P4>& p4,
+                 Node<P5>& p5);
+
+    private:
+        // WARNING: This class is designed to be allocated by an arena allocator,
+        // so its destructor will never be called. Therefore, it should hold no
+        // resources other than memory from the arena allocator.
+        ~CallNode();
+
+        typename CallNodeBase<R, 5>::template FunctionChild<FunctionPointer> m_f;
+        typename CallNodeBase<R, 5>::template ParameterChild<P1> m_p1;
+        typename CallNodeBase<R, 5>::template ParameterChild<P2> m_p2;
+        typename CallNodeBase<R, 5>::template ParameterChild<P3> m_p3;
+        typename CallNodeBase<R, 5>::template ParameterChild<P4> m_p4;
+        typename CallNodeBase<R, 5>::template ParameterChild<P5> m_p5;
+    };
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    class CallNode : public CallNodeBase<R, 6>
+    {
+    public:
+        typedef R (*FunctionPointer)(P1, P2, P3, P4, P5, P6);
+
+        CallNode(ExpressionTree& tree,
+                 Node<FunctionPointer>& function,
+                 Node<P1>& p1,
+                 Node<P2>& p2,
+                 Node<P3>& p3,
+                 Node<P4>& p4,
+                 Node<P5>& p5,
+                 Node<P6>& p6);
+
+    private:
+        // WARNING: This class is designed to be allocated by an arena allocator,
+        // so its destructor will never be called. Therefore, it should hold no
+        // resources other than memory from the arena allocator.
+        ~CallNode();
+
+        typename CallNodeBase<R, 6>::template FunctionChild<FunctionPointer> m_f;
+        typename CallNodeBase<R, 6>::template ParameterChild<P1> m_p1;
+        typename CallNodeBase<R, 6>::template ParameterChild<P2> m_p2;
+        typename CallNodeBase<R, 6>::template ParameterChild<P3> m_p3;
+        typename CallNodeBase<R, 6>::template ParameterChild<P4> m_p4;
+        typename CallNodeBase<R, 6>::template ParameterChild<P5> m_p5;
+        typename CallNodeBase<R, 6>::template ParameterChild<P6> m_p6;
+    };
+
+
     //*************************************************************************
     //
     // Template definitions for SaveRestoreVolatilesHelper.
@@ -544,10 +614,12 @@ namespace NativeJIT
     //*************************************************************************
     template <typename R, unsigned PARAMETERCOUNT>
     template <typename T>
-    CallNodeBase<R, PARAMETERCOUNT>::ParameterChild<T>::ParameterChild(Node<T>& expression, unsigned position)
+    CallNodeBase<R, PARAMETERCOUNT>::ParameterChild<T>::ParameterChild(Node<T>& expression,
+                                                                       ParameterSlotAllocator& slotAllocator)
         : TypedChild<T>(expression)
     {
-        GetParameterRegister(position, m_destination);
+        slotAllocator.Allocate<T>();
+        GetParameterRegister(slotAllocator.GetLogicalRegister(), m_destination);
     }
 
 
@@ -620,7 +692,7 @@ namespace NativeJIT
                                   Node<P1>& p1)
         : CallNodeBase<R, 1>(tree),
           m_f(function, tree.GetResultRegister<R>()),
-          m_p1(p1, 0)
+          m_p1(p1, this->m_parameterSlots)
     {
         static_assert(IsValidParameter<R>::c_value, "R is an invalid type.");
         static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
@@ -639,8 +711,8 @@ namespace NativeJIT
                                   Node<P2>& p2)
         : CallNodeBase<R, 2>(tree),
           m_f(function, tree.GetResultRegister<R>()),
-          m_p1(p1, 0),
-          m_p2(p2, 1)
+          m_p1(p1, this->m_parameterSlots),
+          m_p2(p2, this->m_parameterSlots)
     {
         static_assert(IsValidParameter<R>::c_value, "R is an invalid type.");
         static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
@@ -662,9 +734,9 @@ namespace NativeJIT
                                       Node<P3>& p3)
         : CallNodeBase<R, 3>(tree),
           m_f(function, tree.GetResultRegister<R>()),
-          m_p1(p1, 0),
-          m_p2(p2, 1),
-          m_p3(p3, 2)
+          m_p1(p1, this->m_parameterSlots),
+          m_p2(p2, this->m_parameterSlots),
+          m_p3(p3, this->m_parameterSlots)
     {
         static_assert(IsValidParameter<R>::c_value, "R is an invalid type.");
         static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
@@ -689,16 +761,86 @@ namespace NativeJIT
                                           Node<P4>& p4)
         : CallNodeBase<R, 4>(tree),
           m_f(function, tree.GetResultRegister<R>()),
-          m_p1(p1, 0),
-          m_p2(p2, 1),
-          m_p3(p3, 2),
-          m_p4(p4, 3)
+          m_p1(p1, this->m_parameterSlots),
+          m_p2(p2, this->m_parameterSlots),
+          m_p3(p3, this->m_parameterSlots),
+          m_p4(p4, this->m_parameterSlots)
+    {
+        static_assert(IsValidParameter<R>::c_value, "R is an invalid type.");
+        static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
+        static_assert(IsValidParameter<P2>::c_value, "P2 is an invalid type.");
+        static_assert(IsValidParameter<P3>::c_value, "P3 is an invalid type.");
+        static_assert(IsValidParameter<P4>::c_value, "P4 is an invalid type.");
+
+        this->m_functionBase = &m_f;
+        this->m_functionChild = &m_f;
+        this->m_children[0] = this->m_functionChild;
+        this->m_children[1] = &m_p1;
+        this->m_children[2] = &m_p2;
+        this->m_children[3] = &m_p3;
+        this->m_children[4] = &m_p4;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5>
+    CallNode<R, P1, P2, P3, P4, P5>::CallNode(ExpressionTree& tree,
+                                              Node<FunctionPointer>& function,
+                                              Node<P1>& p1,
+                                              Node<P2>& p2,
+                                              Node<P3>& p3,
+                                              Node<P4>& p4,
+                                              Node<P5>& p5)
+        : CallNodeBase<R, 5>(tree),
+          m_f(function, tree.GetResultRegister<R>()),
+          m_p1(p1, this->m_parameterSlots),
+          m_p2(p2, this->m_parameterSlots),
+          m_p3(p3, this->m_parameterSlots),
+          m_p4(p4, this->m_parameterSlots),
+          m_p5(p5, this->m_parameterSlots)
+    {
+        static_assert(IsValidParameter<R>::c_value, "R is an invalid type.");
+        static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
+        static_assert(IsValidParameter<P2>::c_value, "P2 is an invalid type.");
+        static_assert(IsValidParameter<P3>::c_value, "P3 is an invalid type.");
+        static_assert(IsValidParameter<P4>::c_value, "P4 is an invalid type.");
+        static_assert(IsValidParameter<P5>::c_value, "P5 is an invalid type.");
+
+        this->m_functionBase = &m_f;
+        this->m_functionChild = &m_f;
+        this->m_children[0] = this->m_functionChild;
+        this->m_children[1] = &m_p1;
+        this->m_children[2] = &m_p2;
+        this->m_children[3] = &m_p3;
+        this->m_children[4] = &m_p4;
+        this->m_children[5] = &m_p5;
+    }
+
+
+    template <typename R, typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
+    CallNode<R, P1, P2, P3, P4, P5, P6>::CallNode(ExpressionTree& tree,
+                                                  Node<FunctionPointer>& function,
+                                                  Node<P1>& p1,
+                                                  Node<P2>& p2,
+                                                  Node<P3>& p3,
+                                                  Node<P4>& p4,
+                                                  Node<P5>& p5,
+                                                  Node<P6>& p6)
+        : CallNodeBase<R, 6>(tree),
+          m_f(function, tree.GetResultRegister<R>()),
+          m_p1(p1, this->m_parameterSlots),
+          m_p2(p2, this->m_parameterSlots),
+          m_p3(p3, this->m_parameterSlots),
+          m_p4(p4, this->m_parameterSlots),
+          m_p5(p5, this->m_parameterSlots),
+          m_p6(p6, this->m_parameterSlots)
     {
         static_assert(IsValidParameter<R>::c_value, "R is an invalid type.");
         static_assert(IsValidParameter<P1>::c_value, "P1 is an invalid type.");
         static_assert(IsValidParameter<P2>::c_value, "P2 is an invalid type.");
         static_assert(IsValidParameter<P3>::c_value, "P3 is an invalid type.");
         static_assert(IsValidParameter<P4>::c_value, "P4 is an invalid type.");
+        static_assert(IsValidParameter<P5>::c_value, "P5 is an invalid type.");
+        static_assert(IsValidParameter<P6>::c_value, "P6 is an invalid type.");
 
         this->m_functionBase = &m_f;
         this->m_functionChild = &m_f;
@@ -707,5 +849,7 @@ namespace NativeJIT
         this->m_children[2] = &m_p2;
         this->m_children[3] = &m_p3;
         this->m_children[4] = &m_p4;
+        this->m_children[5] = &m_p5;
+        this->m_children[6] = &m_p6;
     }
 }
@@ -0,0 +1,328 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#include "NativeJIT/BatchCompiler.h"
+#include "NativeJIT/CodeGen/X64CodeGenerator.h"     // OpCode type.
+#include "NativeJIT/Nodes/ImmediateNode.h"
+#include "NativeJIT/Nodes/Node.h"
+
+
+namespace NativeJIT
+{
+    // Base class for the arithmetic nodes which can be evaluated at compile
+    // time when all of their inputs are constants. The derived class computes
+    // the value in its TryFold() override and passes it to SetFoldedValue().
+    // If the folded node is still used once all the nodes have been folded,
+    // MaterializeFoldedValue() replaces it with an immediate node which is
+    // evaluated instead in CodeGenFoldedValue().
+    template <typename T>
+    class FoldableNode : public Node<T>
+    {
+    public:
+        FoldableNode(ExpressionTree& tree);
+
+        //
+        // Overrides of Node methods.
+        //
+        virtual bool GetConstantValue(T& value) const override;
+        virtual void MaterializeFoldedValue(ExpressionTree& tree) override;
+        virtual void ReleaseReferencesToChildren() override;
+
+    protected:
+        // WARNING: This class is designed to be allocated by an arena allocator,
+        // so its destructor will never be called. Therefore, it should hold no
+        // resources other than memory from the arena allocator.
+        ~FoldableNode() {}
+
+        bool IsFolded() const;
+        void SetFoldedValue(T value);
+        Storage<T> CodeGenFoldedValue(ExpressionTree& tree);
+
+        // Describes the folded value to BatchCompiler.
+        bool GetFoldedLaneOperation(LaneOperation& operation) const;
+
+    private:
+        // Only arithmetic values are folded. Tag dispatch ensures that
+        // ImmediateNode is not instantiated for other types.
+        void MaterializeFoldedValue(ExpressionTree& tree, std::true_type);
+        void MaterializeFoldedValue(ExpressionTree& tree, std::false_type);
+
+        bool m_isFolded;
+        typename std::decay<T>::type m_foldedValue;
+        Node<T>* m_foldedNode;
+    };
+
+
+    // Helpers computing the result of an operation at compile time for the
+    // combinations of operations and types whose result is known to match
+    // the generated code bit for bit. Each Fold() method returns false if
+    // the operation or the type is not supported.
+    namespace ConstantFolding
+    {
+        enum class Category { Integer, FloatingPoint, Other };
+
+        // Note: bool is deliberately excluded, f. ex. adding two true values
+        // in an 8-bit register does not produce a valid bool. So are the
+        // const qualified types which cannot be assigned the result to.
+        template <typename T>
+        struct CategoryOf
+        {
+            static const Category value
+                = std::is_const<T>::value
+                  ? Category::Other
+                  : (std::is_integral<T>::value && !std::is_same<T, bool>::value)
+                    ? Category::Integer
+                    : std::is_floating_point<T>::value
+                      ? Category::FloatingPoint
+                      : Category::Other;
+        };
+
+
+        template <OpCode OP, Category CATEGORY>
+        struct Binary
+        {
+            template <typename T>
+            static bool Fold(T /* left */, T /* right */, T& /* result */)
+            {
+                return false;
+            }
+        };
+
+
+        // Integer arithmetic is done in unsigned 64-bit integers to get the
+        // same wrap-around on overflow as the generated code.
+        template <OpCode OP>
+        struct Binary<OP, Category::Integer>
+        {
+            template <typename T>
+            static bool Fold(T left, T right, T& result)
+            {
+                const uint64_t l = static_cast<uint64_t>(left);
+                const uint64_t r = static_cast<uint64_t>(right);
+
+                switch (OP)
+                {
+                case OpCode::Add:
+                    result = static_cast<T>(l + r);
+                    return true;
+                case OpCode::And:
+                    result = static_cast<T>(l & r);
+                    return true;
+                case OpCode::IMul:
+                    result = static_cast<T>(l * r);
+                    return true;
+                case OpCode::Or:
+                    result = static_cast<T>(l | r);
+                    return true;
+                case OpCode::Sub:
+                    result = static_cast<T>(l - r);
+                    return true;
+                case OpCode::Xor:
+                    result = static_cast<T>(l ^ r);
+                    return true;
+                default:
+                    return false;
+                }
+            }
+        };
+
+
+        // Scalar SSE instructions round as the C++ operators do. MinSS/MinSD
+        // and MaxSS/MaxSD return the right operand unless the comparison
+        // of the left one holds, which also covers NaNs and signed zeros.
+        template <OpCode OP>
+        struct Binary<OP, Category::FloatingPoint>
+        {
+            template <typename T>
+            static bool Fold(T left, T right, T& result)
+            {
+                switch (OP)
+                {
+                case OpCode::Add:
+                    result = left + right;
+                    return true;
+                case OpCode::Div:
+                    result = left / right;
+                    return true;
+                case OpCode::IMul:
+                    result = left * right;
+                    return true;
+                case OpCode::Max:
+                    result = left > right ? left : right;
+                    return true;
+                case OpCode::Min:
+                    result = left < right ? left : right;
+                    return true;
+                case OpCode::Sub:
+                    result = left - right;
+                    return true;
+                default:
+                    return false;
+                }
+            }
+        };
+
+
+        // Returns whether both operands are constants and OP(left, right)
+        // could be computed into result.
+        template <OpCode OP, typename L, typename R>
+        bool FoldBinary(Node<L>& /* left */, Node<R>& /* right */, L& /* result */, std::false_type)
+        {
+            return false;
+        }
+
+
+        template <OpCode OP, typename L, typename R>
+        bool FoldBinary(Node<L>& left, Node<R>& right, L& result, std::true_type)
+        {
+            L leftValue;
+            L rightValue;
+
+            return left.GetConstantValue(leftValue)
+                   && right.GetConstantValue(rightValue)
+                   && Binary<OP, CategoryOf<L>::value>::Fold(leftValue, rightValue, result);
+        }
+
+
+        template <OpCode OP, typename L, typename R>
+        bool FoldBinary(Node<L>& left, Node<R>& right, L& result)
+        {
+            typedef std::integral_constant<bool,
+                                           std::is_same<L, R>::value
+                                           && CategoryOf<L>::value != Category::Other>
+                IsFoldable;
+
+            return FoldBinary<OP>(left, right, result, IsFoldable());
+        }
+    }
+
+
+    //*************************************************************************
+    //
+    // Template definitions for FoldableNode
+    //
+    //*************************************************************************
+    template <typename T>
+    FoldableNode<T>::FoldableNode(ExpressionTree& tree)
+        : Node<T>(tree),
+          m_isFolded(false),
+          m_foldedValue(),
+          m_foldedNode(nullptr)
+    {
+    }
+
+
+    template <typename T>
+    bool FoldableNode<T>::GetConstantValue(T& value) const
+    {
+        if (m_isFolded)
+        {
+            value = m_foldedValue;
+        }
+
+        return m_isFolded;
+    }
+
+
+    template <typename T>
+    void FoldableNode<T>::MaterializeFoldedValue(ExpressionTree& tree)
+    {
+        if (m_isFolded)
+        {
+            MaterializeFoldedValue(tree,
+                                   std::integral_constant<bool, std::is_arithmetic<T>::value>());
+        }
+    }
+
+
+    template <typename T>
+    void FoldableNode<T>::MaterializeFoldedValue(ExpressionTree& tree, std::true_type)
+    {
+        if (m_foldedNode == nullptr)
+        {
+            m_foldedNode = &tree.PlacementConstruct<ImmediateNode<T>>(tree, m_foldedValue);
+            m_foldedNode->IncrementParentCount();
+        }
+    }
+
+
+    template <typename T>
+    void FoldableNode<T>::MaterializeFoldedValue(ExpressionTree& /* tree */, std::false_type)
+    {
+        LogThrowAbort("Only arithmetic values can be folded");
+    }
+
+
+    template <typename T>
+    void FoldableNode<T>::ReleaseReferencesToChildren()
+    {
+        // References to the children of a folded node have already been
+        // released by TryFold() and the node is never materialized if it has
+        // no parents. Nodes that haven't been folded are never orphaned.
+        if (!m_isFolded)
+        {
+            NodeBase::ReleaseReferencesToChildren();
+        }
+    }
+
+
+    template <typename T>
+    bool FoldableNode<T>::IsFolded() const
+    {
+        return m_isFolded;
+    }
+
+
+    template <typename T>
+    void FoldableNode<T>::SetFoldedValue(T value)
+    {
+        LogThrowAssert(!m_isFolded, "Node with ID %u has already been folded", this->GetId());
+
+        m_isFolded = true;
+        m_foldedValue = value;
+    }
+
+
+    template <typename T>
+    bool FoldableNode<T>::GetFoldedLaneOperation(LaneOperation& operation) const
+    {
+        return GetConstantLaneOperation(m_foldedValue, operation);
+    }
+
+
+    template <typename T>
+    Storage<T> FoldableNode<T>::CodeGenFoldedValue(ExpressionTree& tree)
+    {
+        LogThrowAssert(m_foldedNode != nullptr,
+                       "Folded value of node with ID %u has not been materialized",
+                       this->GetId());
+
+        return m_foldedNode->CodeGen(tree);
+    }
+}
@@ -41,6 +41,10 @@ namespace NativeJIT
         : Node<T>(tree),
           m_value(value)
     {
+        if (std::is_pointer<T>::value)
+        {
+            tree.ReportAbsoluteAddress();
+        }
     }
 
 
@@ -61,6 +65,20 @@ namespace NativeJIT
     }
 
 
+    template <typename T>
+    bool ImmediateNode<T, ImmediateCategory::InlineImmediate>::GetConstantValue(T& value) const
+    {
+        value = m_value;
+        return true;
+    }
+
+
+    template <typename T>
+    void ImmediateNode<T, ImmediateCategory::InlineImmediate>::ReleaseReferencesToChildren()
+    {
+    }
+
+
     //*************************************************************************
     //
     // Template specializations for ImmediateNode for RIPRelativeImmediate types.
@@ -68,12 +86,20 @@ namespace NativeJIT
     //*************************************************************************
 
     template <typename T>
-    ImmediateNode<T, ImmediateCategory::RIPRelativeImmediate>::ImmediateNode(ExpressionTree& tree, T value)
+    ImmediateNode<T, ImmediateCategory::RIPRelativeImmediate>::ImmediateNode(ExpressionTree& tree,
+                                                                             T value,
+                                                                             bool isRelocation)
         : Node<T>(tree),
-          m_value(value)
+          m_value(value),
+          m_isRelocation(isRelocation)
     {
         tree.AddRIPRelative(*this);
 
+        if (std::is_pointer<T>::value && !isRelocation)
+        {
+            tree.ReportAbsoluteAddress();
+        }
+
         // m_offset will be initialized with the correct value during pass0
         // of compilation in the call to EmitStaticData().
         m_offset = 0;
@@ -97,6 +123,27 @@ namespace NativeJIT
     }
 
 
+    template <typename T>
+    bool ImmediateNode<T, ImmediateCategory::RIPRelativeImmediate>::GetConstantValue(T& value) const
+    {
+        value = m_value;
+        return true;
+    }
+
+
+    template <typename T>
+    void ImmediateNode<T, ImmediateCategory::RIPRelativeImmediate>::ReleaseReferencesToChildren()
+    {
+    }
+
+
+    template <typename T>
+    bool ImmediateNode<T, ImmediateCategory::RIPRelativeImmediate>::GetLaneOperation(LaneOperation& operation) const
+    {
+        return GetConstantLaneOperation(m_value, operation);
+    }
+
+
     template <typename T>
     void ImmediateNode<T, ImmediateCategory::RIPRelativeImmediate>::EmitStaticData(ExpressionTree& tree)
     {
@@ -109,5 +156,10 @@ namespace NativeJIT
         // types will be unchanged, but f. ex. function pointers will be
         // emitted as uint64_t.
         code.EmitBytes(ForcedCast<typename CanonicalRegisterStorageType<T>::Type>(m_value));
+
+        if (m_isRelocation)
+        {
+            code.AddRelocation(m_offset);
+        }
     }
 }
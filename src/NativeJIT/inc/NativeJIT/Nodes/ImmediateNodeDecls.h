@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "NativeJIT/BatchCompiler.h"
 #include "NativeJIT/Nodes/Node.h"
 #include "NativeJIT/TypePredicates.h"
 
@@ -49,6 +50,11 @@ namespace NativeJIT
         //
         virtual void Print(std::ostream& out) const override;
         virtual ExpressionTree::Storage<T> CodeGenValue(ExpressionTree& tree) override;
+        virtual bool GetConstantValue(T& value) const override;
+
+        // Immediates have no children, so there is nothing to release when
+        // the node is no longer used after its parents were folded.
+        virtual void ReleaseReferencesToChildren() override;
 
     private:
         // WARNING: This class is designed to be allocated by an arena allocator,
@@ -79,13 +85,23 @@ namespace NativeJIT
           public RIPRelativeImmediate
     {
     public:
-        ImmediateNode(ExpressionTree& tree, T value);
+        // If isRelocation is true, the value is an absolute address which is
+        // recorded as a relocation of the code, see FunctionBuffer.
+        ImmediateNode(ExpressionTree& tree, T value, bool isRelocation = false);
 
         //
         // Overrides of Node methods
         //
         virtual void Print(std::ostream& out) const override;
         virtual ExpressionTree::Storage<T> CodeGenValue(ExpressionTree& tree) override;
+        virtual bool GetConstantValue(T& value) const override;
+
+        // Immediates have no children, so there is nothing to release when
+        // the node is no longer used after its parents were folded.
+        virtual void ReleaseReferencesToChildren() override;
+
+        // Floating point immediates can be evaluated in batches.
+        virtual bool GetLaneOperation(LaneOperation& operation) const override;
 
 
         //
@@ -101,5 +117,6 @@ namespace NativeJIT
 
         T m_value;
         int32_t m_offset;
+        bool m_isRelocation;
     };
 }
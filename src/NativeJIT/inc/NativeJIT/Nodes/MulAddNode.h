@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "NativeJIT/CodeGen/X64CodeGenerator.h"     // OpCode type.
+#include "NativeJIT/Nodes/FoldableNode.h"
+#include "NativeJIT/Nodes/Node.h"
+
+
+namespace NativeJIT
+{
+    // Implements a node for the fused multiply-add, left * right + addend,
+    // which is computed with a single rounding using the FMA3 VFMAdd231SS/SD
+    // instruction. The generated code requires a CPU with FMA3 support.
+    template <typename T>
+    class MulAddNode : public FoldableNode<T>
+    {
+    public:
+        MulAddNode(ExpressionTree& tree, Node<T>& left, Node<T>& right, Node<T>& addend);
+
+        virtual Storage<T> CodeGenValue(ExpressionTree& tree) override;
+        virtual bool TryFold() override;
+        virtual bool GetLaneOperation(LaneOperation& operation) const override;
+
+        virtual void Print(std::ostream& out) const override;
+
+    private:
+        static_assert(std::is_floating_point<T>::value,
+                      "MulAddNode supports only floating point types.");
+
+        // WARNING: This class is designed to be allocated by an arena allocator,
+        // so its destructor will never be called. Therefore, it should hold no
+        // resources other than memory from the arena allocator.
+        ~MulAddNode();
+
+        Node<T>& m_left;
+        Node<T>& m_right;
+        Node<T>& m_addend;
+    };
+
+
+    //*************************************************************************
+    //
+    // Template definitions for MulAddNode
+    //
+    //*************************************************************************
+    template <typename T>
+    MulAddNode<T>::MulAddNode(ExpressionTree& tree,
+                              Node<T>& left,
+                              Node<T>& right,
+                              Node<T>& addend)
+        : FoldableNode<T>(tree),
+          m_left(left),
+          m_right(right),
+          m_addend(addend)
+    {
+        m_left.IncrementParentCount();
+        m_right.IncrementParentCount();
+        m_addend.IncrementParentCount();
+    }
+
+
+    template <typename T>
+    Storage<T> MulAddNode<T>::CodeGenValue(ExpressionTree& tree)
+    {
+        if (this->IsFolded())
+        {
+            return this->CodeGenFoldedValue(tree);
+        }
+
+        auto & code = tree.GetCodeGenerator();
+
+        Storage<T> left;
+        Storage<T> right;
+
+        this->CodeGenInOrder(tree,
+                             m_left, left,
+                             m_right, right);
+        Storage<T> addend = m_addend.CodeGen(tree);
+
+        // The result is accumulated in the addend's register, so it is the
+        // only one that gets modified. The other two are pinned to make sure
+        // they are not spilled while the remaining operands are converted.
+        {
+            auto addendReg = addend.ConvertToDirect(true);
+            ReferenceCounter addendPin = addend.GetPin();
+            auto leftReg = left.ConvertToDirect(false);
+            ReferenceCounter leftPin = left.GetPin();
+            auto rightReg = right.ConvertToDirect(false);
+
+            code.Emit<OpCode::Vfmadd231>(addendReg, leftReg, rightReg);
+        }
+
+        return addend;
+    }
+
+
+    template <typename T>
+    bool MulAddNode<T>::GetLaneOperation(LaneOperation& operation) const
+    {
+        if (this->IsFolded())
+        {
+            return this->GetFoldedLaneOperation(operation);
+        }
+
+        if (std::is_same<T, double>::value)
+        {
+            operation = LaneOperation::Operation(OpCode::Vfmadd231, m_left, m_right, m_addend);
+            return true;
+        }
+
+        return false;
+    }
+
+
+    template <typename T>
+    bool MulAddNode<T>::TryFold()
+    {
+        T left;
+        T right;
+        T addend;
+
+        // std::fma() rounds once, as VFMAdd231SS/SD do.
+        if (m_left.GetConstantValue(left)
+            && m_right.GetConstantValue(right)
+            && m_addend.GetConstantValue(addend))
+        {
+            this->SetFoldedValue(std::fma(left, right, addend));
+            m_left.DecrementParentCount();
+            m_right.DecrementParentCount();
+            m_addend.DecrementParentCount();
+
+            return true;
+        }
+
+        return false;
+    }
+
+
+    template <typename T>
+    void MulAddNode<T>::Print(std::ostream& out) const
+    {
+        this->PrintCoreProperties(out, "MulAdd");
+
+        out << ", left = " << m_left.GetId()
+            << ", right = " << m_right.GetId()
+            << ", addend = " << m_addend.GetId();
+    }
+}
@@ -40,6 +40,7 @@
 namespace NativeJIT
 {
     class ExpressionTree;
+    struct LaneOperation;
 
     // Used in NodeBase as an argument.
     template <typename T>
@@ -109,6 +110,25 @@ namespace NativeJIT
         // ReleaseReferencesToChildren().
         virtual bool GetBaseAndOffset(NodeBase*& base, int32_t& offset) const;
 
+        // Constant folding support, used by ExpressionTree before Pass0. If
+        // the value of the node can be computed at compile time from its
+        // constant children, TryFold() records the value, undoes the
+        // IncrementParentCount() calls it made for its children and returns
+        // true. Default implementation returns false.
+        virtual bool TryFold();
+
+        // Called for the nodes that still have parents once all the nodes
+        // have been folded. A folded node creates the storage for its value
+        // which it will return from its CodeGenValue(). Default implementation
+        // does nothing.
+        virtual void MaterializeFoldedValue(ExpressionTree& tree);
+
+        // Batched evaluation support, see BatchCompiler. If the node's value
+        // can be computed for several points at once from the values of its
+        // children, describes the computation and returns true. Default
+        // implementation returns false.
+        virtual bool GetLaneOperation(LaneOperation& operation) const;
+
         //
         // Pure virtual methods.
         //
@@ -170,6 +190,11 @@ namespace NativeJIT
         virtual void CodeGenCache(ExpressionTree& tree) override;
         virtual bool IsCached() const override;
 
+        // If the value of the node is known at compile time (i.e. the node is
+        // an immediate or has been folded), sets the value out parameter and
+        // returns true. Default implementation returns false.
+        virtual bool GetConstantValue(T& value) const;
+
     protected:
         // WARNING: This class is designed to be allocated by an arena allocator,
         // so its destructor will never be called. Therefore, it should hold no
@@ -266,6 +291,13 @@ namespace NativeJIT
     }
 
 
+    template <typename T>
+    bool Node<T>::GetConstantValue(T& /* value */) const
+    {
+        return false;
+    }
+
+
     template <typename T>
     void Node<T>::PrintCoreProperties(std::ostream& out, char const* nodeName) const
     {
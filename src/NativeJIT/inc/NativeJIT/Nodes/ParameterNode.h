@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "NativeJIT/BatchCompiler.h"
 #include "NativeJIT/ExpressionTree.h"
 #include "NativeJIT/Nodes/Node.h"
 #include "Temporary/Assert.h"
@@ -45,6 +46,9 @@ namespace NativeJIT
         //
         virtual void ReleaseReferencesToChildren() override;
 
+        // Double parameters can be evaluated in batches.
+        virtual bool GetLaneOperation(LaneOperation& operation) const override;
+
         //
         // Overrides of Node methods.
         //
@@ -63,6 +67,22 @@ namespace NativeJIT
     };
 
 
+    // The number of parameters of each kind that are passed in registers. On
+    // Windows, the four register slots are shared between integer and floating
+    // point parameters (see ParameterSlotAllocator), so a function can have at
+    // most four parameters. On System V, a function can have up to six integer
+    // and up to eight floating point parameters. Parameters passed on the
+    // stack are not supported; functions that need more values take a
+    // pointer to a state vector and read it with Deref(state, index).
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+    const unsigned c_maxIntegerRegisterParameters = 4;
+    const unsigned c_maxFloatRegisterParameters = 4;
+#else
+    const unsigned c_maxIntegerRegisterParameters = 6;
+    const unsigned c_maxFloatRegisterParameters = 8;
+#endif
+
+
     // ParameterSlotAllocator allocates parameter index numbers which are used to
     // map parameters to registers. In the Windows ABI, a parameter's index
     // numbers is equal to its position in the parameter list, regardless of
@@ -140,11 +160,15 @@ namespace NativeJIT
     template <unsigned SIZE>
     void GetParameterRegister(unsigned id, Register<SIZE, false>& r)
     {
-        // For now we only support the four parameters that are passed in registers.
+        // Only the parameters that are passed in registers are supported.
         // No support for memory parameters.
-        LogThrowAssert(id < 4, "Exceeded maximum number of register parameters.");
+        LogThrowAssert(id < c_maxIntegerRegisterParameters,
+                       "Exceeded maximum number of integer register parameters. "
+                       "Parameters passed on the stack are not supported, pass "
+                       "a pointer to a state vector and use Deref(state, index).");
 
-        // Integer parameters are passed in RCX, RDX, R8, and R9.
+        // Integer parameters are passed in RCX, RDX, R8, and R9 on Windows and
+        // in RDI, RSI, RDX, RCX, R8 and R9 on System V.
         // Use constants to encode registers. See #31.
 #ifdef NATIVEJIT_PLATFORM_WINDOWS
         const uint8_t idMap[] = {1, 2, 8, 9};
@@ -159,11 +183,15 @@ namespace NativeJIT
     template <unsigned SIZE>
     void GetParameterRegister(unsigned id, Register<SIZE, true>& r)
     {
-        // For now we only support the four parameters that are passed in registers.
+        // Only the parameters that are passed in registers are supported.
         // No support for memory parameters.
-        LogThrowAssert(id < 4, "Exceeded maximum number of register parameters.");
+        LogThrowAssert(id < c_maxFloatRegisterParameters,
+                       "Exceeded maximum number of floating point register parameters. "
+                       "Parameters passed on the stack are not supported, pass "
+                       "a pointer to a state vector and use Deref(state, index).");
 
-        // Floating point parameters are passed in XMM0-XMM3.
+        // Floating point parameters are passed in XMM0-XMM3 on Windows and
+        // in XMM0-XMM7 on System V.
         r = Register<SIZE, true>(id);
     }
 
@@ -198,6 +226,19 @@ namespace NativeJIT
     }
 
 
+    template <typename T>
+    bool ParameterNode<T>::GetLaneOperation(LaneOperation& operation) const
+    {
+        if (std::is_same<T, double>::value)
+        {
+            operation = LaneOperation::Parameter(m_position);
+            return true;
+        }
+
+        return false;
+    }
+
+
     template <typename T>
     typename ExpressionTree::Storage<T> ParameterNode<T>::CodeGenValue(ExpressionTree& tree)
     {
@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "NativeJIT/CodeGen/X64CodeGenerator.h"     // OpCode type.
+#include "NativeJIT/Nodes/FoldableNode.h"
+#include "NativeJIT/Nodes/Node.h"
+
+
+namespace NativeJIT
+{
+    // Implements a node for the floating point instructions which compute the
+    // result from a single operand, such as SqrtSS/SqrtSD. The operation is
+    // performed in place, in a register owned by the node.
+    template <OpCode OP, typename T>
+    class UnaryNode : public FoldableNode<T>
+    {
+    public:
+        UnaryNode(ExpressionTree& tree, Node<T>& operand);
+
+        virtual Storage<T> CodeGenValue(ExpressionTree& tree) override;
+        virtual bool TryFold() override;
+        virtual bool GetLaneOperation(LaneOperation& operation) const override;
+
+        virtual void Print(std::ostream& out) const override;
+
+    private:
+        static_assert(std::is_floating_point<T>::value,
+                      "UnaryNode supports only floating point types.");
+
+        // WARNING: This class is designed to be allocated by an arena allocator,
+        // so its destructor will never be called. Therefore, it should hold no
+        // resources other than memory from the arena allocator.
+        ~UnaryNode();
+
+        Node<T>& m_operand;
+    };
+
+
+    //*************************************************************************
+    //
+    // Template definitions for UnaryNode
+    //
+    //*************************************************************************
+    template <OpCode OP, typename T>
+    UnaryNode<OP, T>::UnaryNode(ExpressionTree& tree, Node<T>& operand)
+        : FoldableNode<T>(tree),
+          m_operand(operand)
+    {
+        m_operand.IncrementParentCount();
+    }
+
+
+    template <OpCode OP, typename T>
+    Storage<T> UnaryNode<OP, T>::CodeGenValue(ExpressionTree& tree)
+    {
+        if (this->IsFolded())
+        {
+            return this->CodeGenFoldedValue(tree);
+        }
+
+        Storage<T> operand = m_operand.CodeGen(tree);
+
+        // Using the same register as both source and destination avoids the
+        // dependency on the previous contents of the destination register.
+        auto reg = operand.ConvertToDirect(true);
+        tree.GetCodeGenerator().Emit<OP>(reg, reg);
+
+        return operand;
+    }
+
+
+    template <OpCode OP, typename T>
+    bool UnaryNode<OP, T>::GetLaneOperation(LaneOperation& operation) const
+    {
+        if (this->IsFolded())
+        {
+            return this->GetFoldedLaneOperation(operation);
+        }
+
+        if (std::is_same<T, double>::value && LaneOperation::IsSupported(OP, 1))
+        {
+            operation = LaneOperation::Operation(OP, m_operand);
+            return true;
+        }
+
+        return false;
+    }
+
+
+    template <OpCode OP, typename T>
+    bool UnaryNode<OP, T>::TryFold()
+    {
+        T value;
+
+        // SqrtSS/SqrtSD are correctly rounded, as is std::sqrt().
+        if (OP == OpCode::Sqrt && m_operand.GetConstantValue(value))
+        {
+            this->SetFoldedValue(std::sqrt(value));
+            m_operand.DecrementParentCount();
+
+            return true;
+        }
+
+        return false;
+    }
+
+
+    template <OpCode OP, typename T>
+    void UnaryNode<OP, T>::Print(std::ostream& out) const
+    {
+        const std::string name = std::string("Operation (")
+            + X64CodeGenerator::OpCodeName(OP)
+            + ") ";
+        this->PrintCoreProperties(out, name.c_str());
+
+        out << ", operand = " << m_operand.GetId();
+    }
+}
@@ -24,6 +24,7 @@
 #include <cstring>
 
 #include "NativeJIT/CodeGen/CodeBuffer.h"
+#include "NativeJIT/CodeGen/ExecutionBuffer.h"
 #include "Temporary/IAllocator.h"
 
 
@@ -32,6 +33,8 @@ namespace NativeJIT
     CodeBuffer::CodeBuffer(Allocators::IAllocator& codeAllocator, unsigned capacity)
         : m_codeAllocator(codeAllocator),
           m_capacity(capacity),
+          m_executionBuffer(dynamic_cast<ExecutionBuffer*>(&codeAllocator)),
+          m_isExecutable(false),
           m_bufferStart(nullptr)
     {
         m_bufferStart = static_cast<uint8_t*>(codeAllocator.Allocate(capacity));
@@ -42,7 +45,7 @@ namespace NativeJIT
 
     CodeBuffer::~CodeBuffer()
     {
-        m_codeAllocator.Deallocate(m_current);
+        m_codeAllocator.Deallocate(m_bufferStart);
     }
 
 
@@ -61,6 +64,7 @@ namespace NativeJIT
     void CodeBuffer::EmitBytes(uint8_t const *data, unsigned length)
     {
         VerifyNoBufferOverflow(length);
+        EnsureWritable();
 
         memcpy(m_current, data, length);
         m_current += length;
@@ -102,6 +106,7 @@ namespace NativeJIT
                        startPosition,
                        startPosition + length);
 
+        EnsureWritable();
         memmove(&m_bufferStart[startPosition], data, length);
     }
 
@@ -133,7 +138,9 @@ namespace NativeJIT
 
     uint8_t* CodeBuffer::Advance(int byteCount)
     {
+        // The caller may write to the returned position.
         VerifyNoBufferOverflow(byteCount);
+        EnsureWritable();
 
         uint8_t* start = m_current;
         m_current += byteCount;
@@ -144,16 +151,35 @@ namespace NativeJIT
     void CodeBuffer::Fill(unsigned start, unsigned length, uint8_t value)
     {
         VerifyNoBufferOverflow(length);
+        EnsureWritable();
         memset(m_bufferStart + start, value, length);
     }
 
 
     void CodeBuffer::PatchCallSites()
     {
+        EnsureWritable();
         m_localJumpTable.PatchCallSites();
     }
 
 
+    void CodeBuffer::MakeExecutable()
+    {
+        if (m_executionBuffer != nullptr && !m_isExecutable)
+        {
+            m_executionBuffer->MakeExecutable(m_bufferStart);
+            m_isExecutable = true;
+        }
+    }
+
+
+    void CodeBuffer::MakeWritable()
+    {
+        m_executionBuffer->MakeWritable(m_bufferStart);
+        m_isExecutable = false;
+    }
+
+
     void CodeBuffer::EmitCallSite(Label label, unsigned size)
     {
         m_localJumpTable.AddCallSite(label, m_current, size);
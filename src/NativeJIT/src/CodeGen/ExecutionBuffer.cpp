@@ -21,6 +21,9 @@
 // THE SOFTWARE.
 
 
+#include <algorithm>    // For std::max
+#include <cstring>      // For memset
+#include <iterator>     // For std::prev
 #include <stdexcept>
 
 #ifdef NATIVEJIT_PLATFORM_WINDOWS
@@ -31,6 +34,7 @@
 #endif
 
 #include "NativeJIT/CodeGen/ExecutionBuffer.h"
+#include "Temporary/Assert.h"
 
 
 namespace NativeJIT
@@ -48,139 +52,380 @@ namespace NativeJIT
     }
 
 
-    // http://stackoverflow.com/questions/570257/jit-compilation-and-dep
-#ifdef NATIVEJIT_PLATFORM_WINDOWS
-    ExecutionBuffer::ExecutionBuffer(size_t bufferSize)
-        : m_buffer(nullptr),
-          m_bytesAllocated(0)
+    const size_t ExecutionBuffer::c_unlimitedSize;
+
+
+    ExecutionBuffer::ExecutionBuffer(size_t chunkSize, size_t maxSize)
+        : m_maxSize(maxSize),
+          m_statistics()
     {
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
         SYSTEM_INFO systemInfo;
         GetSystemInfo(&systemInfo);
-
-        m_bufferSize = RoundUp(bufferSize, systemInfo.dwPageSize);
-
-        // Allocate m_bufferSize bytes plus one extra page that will act as
-        // a write-guard to detect buffer overruns.
-        m_buffer = (unsigned char*)VirtualAlloc(NULL, m_bufferSize + systemInfo.dwPageSize,
-                                                MEM_COMMIT, PAGE_EXECUTE_READWRITE);
-
-        if (m_buffer == NULL)
-        {
-            throw std::runtime_error("CodeBuffer: out of memory.");
-        }
-
-        // Set protection on the guard page.
-        DWORD oldProtection;
-        if (!VirtualProtect(m_buffer + m_bufferSize, systemInfo.dwPageSize,
-                            PAGE_NOACCESS, &oldProtection))
-        {
-            // TODO: Fix memory leaks by f. ex. using unique_ptr with custom deleter
-            // for m_buffer. See bug#13
-            throw std::runtime_error("CodeBuffer: failed to set protection on guard page.");
-        }
-
-        DebugInitialize();
-    }
+        m_pageSize = systemInfo.dwPageSize;
 #else
-    ExecutionBuffer::ExecutionBuffer(size_t bufferSize)
-        : m_bytesAllocated(0),
-          m_buffer(nullptr)
-    {
-        m_bufferSize = RoundUp(bufferSize, getpagesize());
-        m_buffer = static_cast<unsigned char*>(
-                       mmap(nullptr,
-                            m_bufferSize,
-                            PROT_READ | PROT_WRITE | PROT_EXEC,
-                            MAP_PRIVATE | MAP_ANON,
-                            -1,
-                            0));
-        if (m_buffer == MAP_FAILED) {
-            // TODO: Fix memory leaks by f. ex. using unique_ptr with custom deleter
-            // for m_buffer. See bug#13
-            throw std::runtime_error("CodeBuffer: failed to set protection on guard page.");
-        }
+        m_pageSize = static_cast<size_t>(getpagesize());
+#endif
 
+        m_chunkSize = RoundUp(chunkSize, m_pageSize);
+
+        // Map the first chunk up front so that running out of memory is
+        // reported by the constructor, as before chunks were introduced.
+        MapChunk(m_chunkSize);
     }
-#endif
 
 
-#ifdef NATIVEJIT_PLATFORM_WINDOWS
     ExecutionBuffer::~ExecutionBuffer()
     {
-        if (m_buffer != nullptr)
+        for (auto const & chunk : m_chunks)
         {
-            if (VirtualFree(m_buffer, 0, MEM_RELEASE) == 0)
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+            if (VirtualFree(chunk.first, 0, MEM_RELEASE) == 0)
             {
                 // TODO: Fix this See bug#13
                 // throw std::runtime_error("CodeBuffer: VirtualFree failed.");
             }
-        }
-    }
 #else
-    ExecutionBuffer::~ExecutionBuffer()
-    {
-        if (m_buffer != nullptr)
-        {
-            if (munmap(m_buffer, m_bufferSize) != 0)
+            if (munmap(chunk.first, chunk.second) != 0)
             {
                 // TODO: Fix this. See bug#13
                 // throw std::runtime_error("CodeBuffer: munmap failed.");
             }
+#endif
         }
     }
 
-#endif
-
 
     //
     // IAllocator methods
     //
 
-    // Allocates a block of a specified byte size.
+    // Allocates a writable block of a specified byte size.
     void* ExecutionBuffer::Allocate(size_t size)
     {
-        LogThrowAssert(m_bytesAllocated + size <= m_bufferSize, "Out of memory");
+        // Each block has pages of its own so that its protection can be
+        // changed independently of the other blocks.
+        const size_t blockSize = RoundUp(size == 0 ? 1 : size, m_pageSize);
+
+        uint8_t* block = TakeFreeBlock(blockSize);
+
+        if (block == nullptr)
+        {
+            if (m_statistics.m_mappedBytes + RoundUp(std::max(blockSize, m_chunkSize), m_pageSize) > m_maxSize)
+            {
+                // The unused chunks may be too small on their own.
+                ReleaseUnusedChunks();
+            }
+
+            MapChunk(blockSize);
+            block = TakeFreeBlock(blockSize);
+        }
 
-        void* result = static_cast<void*>(m_buffer + m_bytesAllocated);
-        m_bytesAllocated += size;
+        m_blocks[block] = { blockSize, false };
 
-        return result;
+        m_statistics.m_allocatedBlockCount++;
+        m_statistics.m_allocatedBytes += blockSize;
+        m_statistics.m_peakAllocatedBytes = std::max(m_statistics.m_peakAllocatedBytes,
+                                                     m_statistics.m_allocatedBytes);
+        m_statistics.m_allocationCount++;
+
+        return block;
     }
 
 
     // Frees a block.
     void ExecutionBuffer::Deallocate(void * block)
     {
-        m_bytesAllocated = static_cast<unsigned char*>(block) - m_buffer;
+        auto it = m_blocks.find(static_cast<uint8_t*>(block));
+
+        LogThrowAssert(it != m_blocks.end(),
+                       "Attempting to deallocate memory not owned by this allocator.");
+
+        const size_t size = it->second.m_size;
+
+        if (it->second.m_isExecutable)
+        {
+            Protect(it->first, size, false);
+        }
+
+        DebugInitialize(it->first, size);
+        AddFreeBlock(it->first, size);
+        m_blocks.erase(it);
+
+        m_statistics.m_allocatedBlockCount--;
+        m_statistics.m_allocatedBytes -= size;
+        m_statistics.m_freedBlockCount++;
+        m_statistics.m_freedBytes += size;
     }
 
 
     // Returns the maximum legal allocation size in bytes.
     size_t ExecutionBuffer::MaxSize() const
     {
-        return m_bufferSize;
+        return m_maxSize;
     }
 
+
     // Returns the available size in bytes.
     size_t ExecutionBuffer::Available() const
     {
-        return m_bufferSize - m_bytesAllocated;
+        const size_t freeBytes = m_statistics.m_mappedBytes - m_statistics.m_allocatedBytes;
+
+        return m_maxSize == c_unlimitedSize
+               ? c_unlimitedSize
+               : m_maxSize - m_statistics.m_mappedBytes + freeBytes;
     }
 
+
     // Frees all blocks that have been allocated since construction or the
     // last call to Reset().
     void ExecutionBuffer::Reset()
     {
-        m_bytesAllocated = 0;
-        DebugInitialize();
+        while (!m_blocks.empty())
+        {
+            Deallocate(m_blocks.begin()->first);
+        }
+
+        ReleaseUnusedChunks();
+    }
+
+
+    void ExecutionBuffer::MakeWritable(void* block)
+    {
+        auto it = m_blocks.find(static_cast<uint8_t*>(block));
+
+        LogThrowAssert(it != m_blocks.end(), "Block %p is not allocated", block);
+
+        if (it->second.m_isExecutable)
+        {
+            Protect(it->first, it->second.m_size, false);
+            it->second.m_isExecutable = false;
+        }
+    }
+
+
+    void ExecutionBuffer::MakeExecutable(void* block)
+    {
+        auto it = m_blocks.find(static_cast<uint8_t*>(block));
+
+        LogThrowAssert(it != m_blocks.end(), "Block %p is not allocated", block);
+
+        if (!it->second.m_isExecutable)
+        {
+            Protect(it->first, it->second.m_size, true);
+            it->second.m_isExecutable = true;
+        }
+    }
+
+
+    size_t ExecutionBuffer::ReleaseUnusedChunks()
+    {
+        const size_t mappedBytes = m_statistics.m_mappedBytes;
+
+        // A chunk is unused if it's a single free block. The first chunk is
+        // kept to avoid mapping it again for the next allocation.
+        auto it = m_chunks.begin();
+
+        if (it != m_chunks.end())
+        {
+            ++it;
+        }
+
+        while (it != m_chunks.end())
+        {
+            uint8_t* start = it->first;
+            auto freeBlock = m_freeBlocks.find(start);
+            ++it;
+
+            if (freeBlock != m_freeBlocks.end() && freeBlock->second == m_chunks[start])
+            {
+                m_freeBlocks.erase(freeBlock);
+                UnmapChunk(start);
+            }
+        }
+
+        return mappedBytes - m_statistics.m_mappedBytes;
+    }
+
+
+    ExecutionBuffer::Statistics const & ExecutionBuffer::GetStatistics() const
+    {
+        return m_statistics;
     }
 
 
-    void ExecutionBuffer::DebugInitialize()
+    // http://stackoverflow.com/questions/570257/jit-compilation-and-dep
+    void ExecutionBuffer::MapChunk(size_t minSize)
+    {
+        const size_t size = std::max(RoundUp(minSize, m_pageSize), m_chunkSize);
+
+        LogThrowAssert(size <= m_maxSize && m_statistics.m_mappedBytes <= m_maxSize - size,
+                       "Out of memory");
+
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+        // Allocate the chunk plus one extra page that will act as a
+        // write-guard to detect buffer overruns.
+        auto start = static_cast<uint8_t*>(VirtualAlloc(NULL, size + m_pageSize,
+                                                        MEM_COMMIT | MEM_RESERVE,
+                                                        PAGE_READWRITE));
+
+        if (start == NULL)
+        {
+            throw std::runtime_error("CodeBuffer: out of memory.");
+        }
+
+        // Set protection on the guard page.
+        DWORD oldProtection;
+        if (!VirtualProtect(start + size, m_pageSize, PAGE_NOACCESS, &oldProtection))
+        {
+            VirtualFree(start, 0, MEM_RELEASE);
+            throw std::runtime_error("CodeBuffer: failed to set protection on guard page.");
+        }
+#else
+        void* address = mmap(nullptr,
+                             size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANON,
+                             -1,
+                             0);
+
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("CodeBuffer: out of memory.");
+        }
+
+        auto start = static_cast<uint8_t*>(address);
+#endif
+
+        m_chunks[start] = size;
+        DebugInitialize(start, size);
+        AddFreeBlock(start, size);
+
+        m_statistics.m_chunkCount++;
+        m_statistics.m_mappedBytes += size;
+    }
+
+
+    void ExecutionBuffer::UnmapChunk(uint8_t* start)
+    {
+        const size_t size = m_chunks[start];
+
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+        VirtualFree(start, 0, MEM_RELEASE);
+#else
+        munmap(start, size);
+#endif
+
+        m_chunks.erase(start);
+
+        m_statistics.m_chunkCount--;
+        m_statistics.m_mappedBytes -= size;
+        m_statistics.m_releasedChunkCount++;
+        m_statistics.m_releasedBytes += size;
+    }
+
+
+    uint8_t* ExecutionBuffer::GetChunkStart(uint8_t* address) const
+    {
+        auto it = m_chunks.upper_bound(address);
+
+        LogThrowAssert(it != m_chunks.begin(), "Address %p is not in a chunk", address);
+        --it;
+
+        return it->first;
+    }
+
+
+    void ExecutionBuffer::AddFreeBlock(uint8_t* start, size_t size)
+    {
+        uint8_t* const chunk = GetChunkStart(start);
+        auto next = m_freeBlocks.lower_bound(start);
+
+        // Merge with the following block.
+        if (next != m_freeBlocks.end()
+            && next->first == start + size
+            && GetChunkStart(next->first) == chunk)
+        {
+            size += next->second;
+            next = m_freeBlocks.erase(next);
+        }
+
+        // Merge with the preceding block.
+        if (next != m_freeBlocks.begin())
+        {
+            auto previous = std::prev(next);
+
+            if (previous->first + previous->second == start
+                && GetChunkStart(previous->first) == chunk)
+            {
+                previous->second += size;
+                return;
+            }
+        }
+
+        m_freeBlocks.emplace_hint(next, start, size);
+    }
+
+
+    uint8_t* ExecutionBuffer::TakeFreeBlock(size_t size)
+    {
+        for (auto it = m_freeBlocks.begin(); it != m_freeBlocks.end(); ++it)
+        {
+            if (it->second >= size)
+            {
+                uint8_t* start = it->first;
+                const size_t remainder = it->second - size;
+
+                it = m_freeBlocks.erase(it);
+
+                if (remainder > 0)
+                {
+                    m_freeBlocks.emplace_hint(it, start + size, remainder);
+                }
+
+                return start;
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    void ExecutionBuffer::Protect(uint8_t* start, size_t size, bool isExecutable)
+    {
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+        DWORD oldProtection;
+        LogThrowAssert(VirtualProtect(start,
+                                      size,
+                                      isExecutable ? PAGE_EXECUTE_READ : PAGE_READWRITE,
+                                      &oldProtection) != 0,
+                       "Failed to change the protection of %p",
+                       start);
+
+        if (isExecutable)
+        {
+            FlushInstructionCache(GetCurrentProcess(), start, size);
+        }
+#else
+        LogThrowAssert(mprotect(start,
+                                size,
+                                isExecutable ? PROT_READ | PROT_EXEC : PROT_READ | PROT_WRITE) == 0,
+                       "Failed to change the protection of %p",
+                       start);
+#endif
+
+        m_statistics.m_protectionChangeCount++;
+    }
+
+
+    void ExecutionBuffer::DebugInitialize(uint8_t* start, size_t size)
     {
 #ifdef _DEBUG
-        // Fill the buffer with break code (i.e. INT 3 software breakpoint).
-        memset(m_buffer, 0xcc, m_bufferSize);
+        // Fill the memory with break code (i.e. INT 3 software breakpoint).
+        memset(start, 0xcc, size);
+#else
+        static_cast<void>(start);
+        static_cast<void>(size);
 #endif
     }
 }
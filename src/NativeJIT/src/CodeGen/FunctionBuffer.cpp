@@ -72,7 +72,8 @@ namespace NativeJIT
           m_unwindInfoByteLength(0),
           m_prologStartOffset(0),
           m_prologLength(0),
-          m_isCodeGenerationCompleted(false)
+          m_isCodeGenerationCompleted(false),
+          m_isRelocatable(true)
     {
         LogThrowAssert(reinterpret_cast<size_t>(&m_runtimeFunction) % sizeof(DWORD) == 0,
                        "RUNTIME_FUNCTION must be DWORD aligned");
@@ -226,6 +227,63 @@ namespace NativeJIT
         m_runtimeFunction.EndAddress = CurrentPosition();
         m_runtimeFunction.UnwindData = m_unwindInfoStartOffset;
 
+        // The function can only be called once its pages are executable.
+        MakeExecutable();
+
+        m_isCodeGenerationCompleted = true;
+    }
+
+
+    void FunctionBuffer::AddRelocation(unsigned offset)
+    {
+        LogThrowAssert(offset + sizeof(uint64_t) <= CurrentPosition(),
+                       "Relocation at offset %u is outside of the emitted code",
+                       offset);
+
+        m_relocations.push_back(offset);
+    }
+
+
+    void FunctionBuffer::MarkNotRelocatable()
+    {
+        m_isRelocatable = false;
+    }
+
+
+    std::vector<unsigned> const & FunctionBuffer::GetRelocations() const
+    {
+        return m_relocations;
+    }
+
+
+    bool FunctionBuffer::IsRelocatable() const
+    {
+        return m_isRelocatable;
+    }
+
+
+    void FunctionBuffer::LoadFunction(uint8_t const * image,
+                                      unsigned imageSize,
+                                      unsigned codeStartOffset,
+                                      unsigned unwindInfoOffset)
+    {
+        LogThrowAssert(imageSize <= GetCapacity(),
+                       "Function image of %u bytes does not fit into buffer of %u bytes",
+                       imageSize,
+                       GetCapacity());
+        LogThrowAssert(codeStartOffset < imageSize && unwindInfoOffset < imageSize,
+                       "Invalid function image offsets");
+
+        Reset();
+        EmitBytes(image, imageSize);
+
+        m_runtimeFunction.BeginAddress = codeStartOffset;
+        m_runtimeFunction.EndAddress = imageSize;
+        m_runtimeFunction.UnwindData = unwindInfoOffset;
+        m_isRelocatable = false;
+
+        MakeExecutable();
+
         m_isCodeGenerationCompleted = true;
     }
 
@@ -241,5 +299,7 @@ namespace NativeJIT
             = 0;
         m_isCodeGenerationCompleted = false;
         m_runtimeFunction = {0, 0, 0};
+        m_relocations.clear();
+        m_isRelocatable = true;
     }
 }
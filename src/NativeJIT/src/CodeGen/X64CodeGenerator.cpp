@@ -136,9 +136,12 @@ namespace NativeJIT
             "cvtfp2si",
             "cvtsi2fp",
             "dec",
+            "div",
             "imul",
             "inc",
             "lea",
+            "max",
+            "min",
             "mov",
             "movsx",
             "movzx",
@@ -155,8 +158,11 @@ namespace NativeJIT
             "shl",
             "shld",
             "shr",
+            "sqrt",
             "stosq",
             "sub",
+            "vfmadd231",
+            "vzeroupper",
             "xor",
         };
 
@@ -254,6 +260,26 @@ namespace NativeJIT
     }
 
 
+    void X64CodeGenerator::EmitVex(uint8_t map,
+                                   bool w,
+                                   unsigned vvvv,
+                                   bool l,
+                                   uint8_t pp,
+                                   bool r,
+                                   bool b)
+    {
+        // Note: unlike in the REX prefix, the R, X, B and vvvv fields of the
+        // VEX prefix are stored inverted. X is always 1 since SIB index is
+        // not used.
+        Emit8(0xc4);
+        Emit8(static_cast<uint8_t>((r ? 0 : 0x80) | 0x40 | (b ? 0 : 0x20) | map));
+        Emit8(static_cast<uint8_t>((w ? 0x80 : 0)
+                                   | ((~vvvv & 0xf) << 3)
+                                   | (l ? 0x04 : 0)
+                                   | pp));
+    }
+
+
     //*************************************************************************
     //
     // X64CodeGenerator::Helper<Op> methods.
@@ -305,6 +331,14 @@ namespace NativeJIT
     }
 
 
+    template <> void X64CodeGenerator::Helper<OpCode::Vzeroupper>::Emit(X64CodeGenerator& code)
+    {
+        code.Emit8(0xc5);
+        code.Emit8(0xf8);
+        code.Emit8(0x77);
+    }
+
+
     template <>
     template <>
     template <>
@@ -0,0 +1,892 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <algorithm>    // For std::fill
+#include <cstring>      // For memcmp
+
+#include "NativeJIT/BatchCompiler.h"
+#include "NativeJIT/CodeGen/CallingConvention.h"
+#include "NativeJIT/CodeGen/FunctionBuffer.h"
+#include "NativeJIT/CodeGen/FunctionSpecification.h"
+#include "NativeJIT/Nodes/Node.h"
+#include "NativeJIT/Nodes/ParameterNode.h"              // GetParameterRegister().
+#include "Temporary/Assert.h"
+
+#ifdef NATIVEJIT_WITH_CPU_FEATURES
+#include "cpuinfo_x86.h"
+#endif
+
+
+namespace NativeJIT
+{
+    namespace
+    {
+        // IDs of the registers holding the pointers to the parameter arrays,
+        // by parameter position. RAX and R9-R11 are volatile and don't pass
+        // arguments to a three parameter function in either calling
+        // convention. The others are non-volatile and saved when used.
+        const uint8_t c_parameterRegisterIds[] = { 0, 9, 10, 11, 3, 12, 13, 14, 15 };
+
+        // Spill slots are large enough for a YMM register.
+        const int32_t c_slotSize = 32;
+
+        // Constants are emitted four times for the widest instruction set.
+        const unsigned c_constantCopies = 4;
+
+
+        Register<8, false> GetArgumentRegister(unsigned position)
+        {
+            Register<8, false> r;
+            GetParameterRegister(position, r);
+
+            return r;
+        }
+    }
+
+
+    //*************************************************************************
+    //
+    // LaneOperation
+    //
+    //*************************************************************************
+    LaneOperation LaneOperation::Parameter(unsigned position)
+    {
+        LaneOperation operation = {};
+        operation.m_kind = Kind::Parameter;
+        operation.m_position = position;
+
+        return operation;
+    }
+
+
+    LaneOperation LaneOperation::Immediate(double value)
+    {
+        LaneOperation operation = {};
+        operation.m_kind = Kind::Immediate;
+        operation.m_value = value;
+
+        return operation;
+    }
+
+
+    LaneOperation LaneOperation::Operation(OpCode opCode, NodeBase& operand)
+    {
+        LaneOperation operation = {};
+        operation.m_kind = Kind::Operation;
+        operation.m_opCode = opCode;
+        operation.m_operandCount = 1;
+        operation.m_operands[0] = &operand;
+
+        return operation;
+    }
+
+
+    LaneOperation LaneOperation::Operation(OpCode opCode, NodeBase& left, NodeBase& right)
+    {
+        LaneOperation operation = Operation(opCode, left);
+        operation.m_operandCount = 2;
+        operation.m_operands[1] = &right;
+
+        return operation;
+    }
+
+
+    LaneOperation LaneOperation::Operation(OpCode opCode,
+                                           NodeBase& left,
+                                           NodeBase& right,
+                                           NodeBase& addend)
+    {
+        LaneOperation operation = Operation(opCode, left, right);
+        operation.m_operandCount = 3;
+        operation.m_operands[2] = &addend;
+
+        return operation;
+    }
+
+
+    bool LaneOperation::IsSupported(OpCode opCode, unsigned operandCount)
+    {
+        switch (opCode)
+        {
+        case OpCode::Sqrt:
+            return operandCount == 1;
+
+        case OpCode::Add:
+        case OpCode::Div:
+        case OpCode::IMul:
+        case OpCode::Max:
+        case OpCode::Min:
+        case OpCode::Sub:
+            return operandCount == 2;
+
+        case OpCode::Vfmadd231:
+            return operandCount == 3;
+
+        default:
+            return false;
+        }
+    }
+
+
+    //*************************************************************************
+    //
+    // BatchCompiler
+    //
+    //*************************************************************************
+    const unsigned BatchCompiler::c_maxParameters;
+    const unsigned BatchCompiler::c_registerCount;
+    const unsigned BatchCompiler::c_noValue;
+
+
+    BatchCompiler::BatchCompiler(Allocators::IAllocator& allocator, FunctionBuffer& code)
+        : m_allocator(allocator),
+          m_code(code),
+          m_values(Allocators::StlAllocator<Value>(allocator)),
+          m_valueOfNode(Allocators::StlAllocator<unsigned>(allocator)),
+          m_constants(Allocators::StlAllocator<double>(allocator)),
+          m_constantOffsets(Allocators::StlAllocator<int32_t>(allocator)),
+          m_lockedRegisters(0),
+          m_usedRegisters(0),
+          m_isSlotFree(Allocators::StlAllocator<bool>(allocator))
+    {
+        static_assert(sizeof(c_parameterRegisterIds) == c_maxParameters,
+                      "Mismatched number of parameter registers.");
+    }
+
+
+    bool BatchCompiler::CanCompile(NodeBase& root)
+    {
+        return CollectValues(root);
+    }
+
+
+    BatchCompiler::FunctionType BatchCompiler::Compile(NodeBase& root)
+    {
+        return Compile(root, GetWidestInstructionSet());
+    }
+
+
+    BatchCompiler::FunctionType BatchCompiler::Compile(NodeBase& root,
+                                                       BatchInstructionSet instructionSet)
+    {
+        LogThrowAssert(CollectValues(root),
+                       "Expression rooted at node %u cannot be evaluated in batches",
+                       root.GetId());
+
+        // Note: the call to Reset() clears all allocated labels, so the labels
+        // must be allocated after that point.
+        m_code.Reset();
+        EmitConstants();
+
+        m_code.BeginFunctionBodyGeneration();
+
+        const Register<8, false> inputs = GetArgumentRegister(0);
+        const Register<8, false> out = GetArgumentRegister(1);
+        const Register<8, false> count = GetArgumentRegister(2);
+        unsigned usedRxxRegisters = 0;
+
+        for (unsigned i = 0; i < c_maxParameters; ++i)
+        {
+            if (m_isParameterUsed[i])
+            {
+                const Register<8, false> pointer(c_parameterRegisterIds[i]);
+
+                m_code.Emit<OpCode::Mov>(pointer,
+                                         inputs,
+                                         static_cast<int32_t>(i * sizeof(double const *)));
+                usedRxxRegisters |= 1u << pointer.GetId();
+            }
+        }
+
+        m_usedRegisters = 0;
+        m_isSlotFree.clear();
+
+        const unsigned width = GetLaneCount(instructionSet);
+        const bool useFma = instructionSet == BatchInstructionSet::AVX2;
+
+        if (width > 1)
+        {
+            // Evaluate width points per iteration while there are enough.
+            const Label loop = m_code.AllocateLabel();
+            const Label remainder = m_code.AllocateLabel();
+
+            m_code.PlaceLabel(loop);
+            m_code.EmitImmediate<OpCode::Cmp>(count, static_cast<int32_t>(width));
+            m_code.EmitConditionalJump<JccType::JB>(remainder);
+
+            if (width == 2)
+            {
+                CodeGenBody<2>(out, useFma);
+            }
+            else
+            {
+                CodeGenBody<4>(out, useFma);
+            }
+
+            AdvancePointers(out, count, width);
+            m_code.Jmp(loop);
+            m_code.PlaceLabel(remainder);
+
+            if (width == 4)
+            {
+                // Avoid the penalty for mixing AVX and legacy SSE code.
+                m_code.Emit<OpCode::Vzeroupper>();
+            }
+        }
+
+        // Evaluate the remaining points one at a time.
+        const Label scalarLoop = m_code.AllocateLabel();
+        const Label done = m_code.AllocateLabel();
+
+        m_code.PlaceLabel(scalarLoop);
+        m_code.EmitImmediate<OpCode::Cmp>(count, 0);
+        m_code.EmitConditionalJump<JccType::JE>(done);
+        CodeGenBody<1>(out, useFma);
+        AdvancePointers(out, count, 1);
+        m_code.Jmp(scalarLoop);
+        m_code.PlaceLabel(done);
+
+        const unsigned stackSlotCount
+            = static_cast<unsigned>(m_isSlotFree.size() * c_slotSize / sizeof(void*));
+
+        const FunctionSpecification spec(m_allocator,
+                                         -1,
+                                         stackSlotCount,
+                                         usedRxxRegisters
+                                            & CallingConvention::c_rxxNonVolatileRegistersMask
+                                            & CallingConvention::c_rxxWritableRegistersMask,
+                                         m_usedRegisters
+                                            & CallingConvention::c_xmmNonVolatileRegistersMask
+                                            & CallingConvention::c_xmmWritableRegistersMask,
+                                         FunctionSpecification::BaseRegisterType::SetRbpToOriginalRsp,
+                                         m_code.IsDiagnosticsStreamAvailable()
+                                         ? &m_code.GetDiagnosticsStream()
+                                         : nullptr);
+
+        m_code.EndFunctionBodyGeneration(spec);
+
+        return reinterpret_cast<FunctionType>(const_cast<void*>(m_code.GetEntryPoint()));
+    }
+
+
+    BatchInstructionSet BatchCompiler::GetWidestInstructionSet()
+    {
+#ifdef NATIVEJIT_WITH_CPU_FEATURES
+        // GetX86Info() reports AVX2 only if the operating system preserves
+        // the YMM registers.
+        const cpu_features::X86Features features = cpu_features::GetX86Info().features;
+
+        if (features.avx2 && features.fma3)
+        {
+            return BatchInstructionSet::AVX2;
+        }
+#endif
+
+        // SSE2 is a part of x64.
+        return BatchInstructionSet::SSE2;
+    }
+
+
+    unsigned BatchCompiler::GetLaneCount(BatchInstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+        case BatchInstructionSet::Scalar:
+            return 1;
+
+        case BatchInstructionSet::SSE2:
+            return 2;
+
+        case BatchInstructionSet::AVX2:
+            return 4;
+
+        default:
+            LogThrowAbort("Invalid instruction set %u", static_cast<unsigned>(instructionSet));
+            // Silence the "not all paths return a value" warning.
+            return 0;
+        }
+    }
+
+
+    bool BatchCompiler::CollectValues(NodeBase& root)
+    {
+        // Nodes are constructed after their operands, so the root has the
+        // highest ID. Sizing the vectors up front avoids growing them in the
+        // arena allocator.
+        m_values.clear();
+        m_values.reserve(root.GetId() + 1);
+        m_valueOfNode.clear();
+        m_valueOfNode.resize(root.GetId() + 1, c_noValue);
+        m_constants.clear();
+        std::fill(m_isParameterUsed, m_isParameterUsed + c_maxParameters, false);
+
+        if (AddValue(root) == c_noValue)
+        {
+            return false;
+        }
+
+        // The root is stored after all values have been evaluated.
+        m_values.back().m_lastUse = static_cast<unsigned>(m_values.size());
+
+        return true;
+    }
+
+
+    unsigned BatchCompiler::AddValue(NodeBase& node)
+    {
+        const unsigned id = node.GetId();
+
+        if (id < m_valueOfNode.size() && m_valueOfNode[id] != c_noValue)
+        {
+            return m_valueOfNode[id];
+        }
+
+        Value value = {};
+        auto & operation = value.m_operation;
+
+        if (!node.GetLaneOperation(operation))
+        {
+            return c_noValue;
+        }
+
+        switch (operation.m_kind)
+        {
+        case LaneOperation::Kind::Parameter:
+            if (operation.m_position >= c_maxParameters)
+            {
+                return c_noValue;
+            }
+            m_isParameterUsed[operation.m_position] = true;
+            break;
+
+        case LaneOperation::Kind::Immediate:
+            // Constants are compared bitwise, which keeps f. ex. 0.0 and -0.0
+            // apart.
+            value.m_constant = 0;
+            while (value.m_constant < m_constants.size()
+                   && memcmp(&m_constants[value.m_constant],
+                             &operation.m_value,
+                             sizeof(double)) != 0)
+            {
+                ++value.m_constant;
+            }
+
+            if (value.m_constant == m_constants.size())
+            {
+                m_constants.push_back(operation.m_value);
+            }
+            break;
+
+        case LaneOperation::Kind::Operation:
+            if (!LaneOperation::IsSupported(operation.m_opCode, operation.m_operandCount))
+            {
+                return c_noValue;
+            }
+
+            for (unsigned i = 0; i < operation.m_operandCount; ++i)
+            {
+                value.m_operands[i] = AddValue(*operation.m_operands[i]);
+
+                if (value.m_operands[i] == c_noValue)
+                {
+                    return c_noValue;
+                }
+            }
+            break;
+        }
+
+        const unsigned index = static_cast<unsigned>(m_values.size());
+
+        // Operands are added before the values using them, so the last
+        // assignment is the last use.
+        for (unsigned i = 0; i < operation.m_operandCount; ++i)
+        {
+            m_values[value.m_operands[i]].m_lastUse = index;
+        }
+
+        m_values.push_back(value);
+
+        if (id >= m_valueOfNode.size())
+        {
+            m_valueOfNode.resize(id + 1, c_noValue);
+        }
+        m_valueOfNode[id] = index;
+
+        return index;
+    }
+
+
+    void BatchCompiler::EmitConstants()
+    {
+        m_constantOffsets.clear();
+
+        for (double value : m_constants)
+        {
+            // The SSE2 memory operands must be 16 byte aligned. Align the
+            // address rather than the offset since the buffer start need not
+            // be aligned.
+            while (reinterpret_cast<uintptr_t>(m_code.BufferStart() + m_code.CurrentPosition())
+                   % (c_constantCopies * sizeof(double)) != 0)
+            {
+                m_code.Emit8(0xaa);
+            }
+
+            m_constantOffsets.push_back(static_cast<int32_t>(m_code.CurrentPosition()));
+
+            for (unsigned i = 0; i < c_constantCopies; ++i)
+            {
+                m_code.EmitBytes(value);
+            }
+        }
+    }
+
+
+    template <unsigned WIDTH>
+    void BatchCompiler::CodeGenBody(Register<8, false> out, bool useFma)
+    {
+        std::fill(m_registerOwner, m_registerOwner + c_registerCount, -1);
+        std::fill(m_isSlotFree.begin(), m_isSlotFree.end(), true);
+
+        for (auto & value : m_values)
+        {
+            value.m_register = -1;
+            value.m_slot = -1;
+        }
+
+        const unsigned valueCount = static_cast<unsigned>(m_values.size());
+
+        for (unsigned i = 0; i < valueCount; ++i)
+        {
+            // Parameters and immediates are loaded on use.
+            if (m_values[i].m_operation.m_kind == LaneOperation::Kind::Operation)
+            {
+                CodeGenOperation<WIDTH>(i, useFma);
+            }
+        }
+
+        m_lockedRegisters = 0;
+
+        const Register<8, true> result = LoadToRegister<WIDTH>(valueCount, valueCount - 1);
+        m_code.EmitPacked<OpCode::Mov, WIDTH>(out, 0, result);
+    }
+
+
+    template <unsigned WIDTH>
+    void BatchCompiler::CodeGenOperation(unsigned current, bool useFma)
+    {
+        Value& value = m_values[current];
+        const OpCode opCode = value.m_operation.m_opCode;
+
+        m_lockedRegisters = 0;
+
+        for (unsigned i = 0; i < value.m_operation.m_operandCount; ++i)
+        {
+            const int r = m_values[value.m_operands[i]].m_register;
+
+            if (r >= 0)
+            {
+                m_lockedRegisters |= 1u << r;
+            }
+        }
+
+        if (opCode == OpCode::Sqrt)
+        {
+            const unsigned operand = value.m_operands[0];
+
+            if (m_values[operand].m_register >= 0 && m_values[operand].m_lastUse == current)
+            {
+                const Register<8, true> dest = CodeGenDestination<WIDTH>(current, operand, true);
+                m_code.EmitPacked<OpCode::Sqrt, WIDTH>(dest, dest);
+            }
+            else
+            {
+                const Register<8, true> dest = AllocateRegister<WIDTH>(current, current);
+                CodeGenOperand<OpCode::Sqrt, WIDTH>(dest, current, operand);
+            }
+        }
+        else if (opCode == OpCode::Vfmadd231)
+        {
+            const unsigned left = value.m_operands[0];
+            const unsigned right = value.m_operands[1];
+            const unsigned addend = value.m_operands[2];
+
+            if (useFma)
+            {
+                // The multiplication reads the operands before the result is
+                // written, so the addend register can be reused even if the
+                // addend is also a factor.
+                const Register<8, true> dest = CodeGenDestination<WIDTH>(current, addend, true);
+                const Register<8, true> leftRegister = LoadToRegister<WIDTH>(current, left);
+                const Register<8, true> rightRegister = LoadToRegister<WIDTH>(current, right);
+
+                m_code.EmitPacked<OpCode::Vfmadd231, WIDTH>(dest, leftRegister, rightRegister);
+            }
+            else
+            {
+                // The left register can't be reused if the addend, which is
+                // read after the multiplication, is the same value.
+                const Register<8, true> dest = CodeGenDestination<WIDTH>(current, left, left != addend);
+
+                CodeGenOperand<OpCode::IMul, WIDTH>(dest, current, right);
+                CodeGenOperand<OpCode::Add, WIDTH>(dest, current, addend);
+            }
+        }
+        else
+        {
+            unsigned left = value.m_operands[0];
+            unsigned right = value.m_operands[1];
+
+            // For commutative operations, compute in place in whichever
+            // operand register is released here. Note that Min and Max are
+            // not commutative if either operand is NaN.
+            auto isReleased = [this, current](unsigned operand)
+            {
+                return m_values[operand].m_register >= 0
+                       && m_values[operand].m_lastUse == current;
+            };
+
+            if ((opCode == OpCode::Add || opCode == OpCode::IMul)
+                && !isReleased(left)
+                && isReleased(right))
+            {
+                std::swap(left, right);
+            }
+
+            const Register<8, true> dest = CodeGenDestination<WIDTH>(current, left, true);
+
+            switch (opCode)
+            {
+            case OpCode::Add:
+                CodeGenOperand<OpCode::Add, WIDTH>(dest, current, right);
+                break;
+            case OpCode::Div:
+                CodeGenOperand<OpCode::Div, WIDTH>(dest, current, right);
+                break;
+            case OpCode::IMul:
+                CodeGenOperand<OpCode::IMul, WIDTH>(dest, current, right);
+                break;
+            case OpCode::Max:
+                CodeGenOperand<OpCode::Max, WIDTH>(dest, current, right);
+                break;
+            case OpCode::Min:
+                CodeGenOperand<OpCode::Min, WIDTH>(dest, current, right);
+                break;
+            case OpCode::Sub:
+                CodeGenOperand<OpCode::Sub, WIDTH>(dest, current, right);
+                break;
+            default:
+                LogThrowAbort("Unexpected opcode %s", X64CodeGenerator::OpCodeName(opCode));
+            }
+        }
+
+        ReleaseOperands(current);
+    }
+
+
+    template <unsigned WIDTH>
+    Register<8, true> BatchCompiler::CodeGenDestination(unsigned current,
+                                                        unsigned operand,
+                                                        bool canReuse)
+    {
+        const int operandRegister = m_values[operand].m_register;
+
+        if (canReuse
+            && operandRegister >= 0
+            && m_values[operand].m_lastUse == current)
+        {
+            // The operand keeps referring to the register until
+            // ReleaseOperands() so that it can also be used as the source.
+            m_registerOwner[operandRegister] = static_cast<int>(current);
+            m_values[current].m_register = operandRegister;
+
+            return Register<8, true>(operandRegister);
+        }
+
+        const Register<8, true> dest = AllocateRegister<WIDTH>(current, current);
+        LoadValue<WIDTH>(dest, operand);
+
+        return dest;
+    }
+
+
+    template <OpCode OP, unsigned WIDTH>
+    void BatchCompiler::CodeGenOperand(Register<8, true> dest, unsigned current, unsigned value)
+    {
+        const Value& v = m_values[value];
+
+        if (v.m_register >= 0)
+        {
+            m_code.EmitPacked<OP, WIDTH>(dest, Register<8, true>(v.m_register));
+        }
+        else if (WIDTH != 2
+                 || (v.m_slot < 0
+                     && v.m_operation.m_kind == LaneOperation::Kind::Immediate))
+        {
+            // Only the constants are known to be aligned for the SSE2 memory
+            // operands.
+            Register<8, false> base;
+            int32_t offset;
+
+            if (v.m_slot >= 0)
+            {
+                base = rbp;
+                offset = GetSlotOffset(v.m_slot);
+            }
+            else
+            {
+                GetAddress(value, base, offset);
+            }
+
+            m_code.EmitPacked<OP, WIDTH>(dest, base, offset);
+        }
+        else
+        {
+            m_code.EmitPacked<OP, WIDTH>(dest, LoadToRegister<WIDTH>(current, value));
+        }
+    }
+
+
+    template <unsigned WIDTH>
+    Register<8, true> BatchCompiler::AllocateRegister(unsigned current, unsigned owner)
+    {
+        int chosen = -1;
+        unsigned chosenNextUse = 0;
+
+        for (unsigned r = 0; r < c_registerCount; ++r)
+        {
+            if ((m_lockedRegisters & (1u << r)) != 0)
+            {
+                continue;
+            }
+
+            if (m_registerOwner[r] < 0)
+            {
+                chosen = static_cast<int>(r);
+                break;
+            }
+
+            const unsigned nextUse = GetNextUse(static_cast<unsigned>(m_registerOwner[r]), current);
+
+            if (nextUse > chosenNextUse)
+            {
+                chosen = static_cast<int>(r);
+                chosenNextUse = nextUse;
+            }
+        }
+
+        LogThrowAssert(chosen >= 0, "No XMM register available for value %u", owner);
+
+        if (m_registerOwner[chosen] >= 0)
+        {
+            // Spill the current owner, unless it is in memory already.
+            Value& spilled = m_values[m_registerOwner[chosen]];
+
+            if (!IsMemoryValue(static_cast<unsigned>(m_registerOwner[chosen]))
+                && spilled.m_slot < 0)
+            {
+                spilled.m_slot = static_cast<int>(AllocateSlot());
+                m_code.EmitPacked<OpCode::Mov, WIDTH>(rbp,
+                                                      GetSlotOffset(spilled.m_slot),
+                                                      Register<8, true>(chosen));
+            }
+
+            spilled.m_register = -1;
+        }
+
+        m_registerOwner[chosen] = static_cast<int>(owner);
+        m_values[owner].m_register = chosen;
+        m_lockedRegisters |= 1u << chosen;
+        m_usedRegisters |= 1u << chosen;
+
+        return Register<8, true>(chosen);
+    }
+
+
+    template <unsigned WIDTH>
+    Register<8, true> BatchCompiler::LoadToRegister(unsigned current, unsigned value)
+    {
+        if (m_values[value].m_register < 0)
+        {
+            LoadValue<WIDTH>(AllocateRegister<WIDTH>(current, value), value);
+        }
+
+        m_lockedRegisters |= 1u << m_values[value].m_register;
+
+        return Register<8, true>(m_values[value].m_register);
+    }
+
+
+    template <unsigned WIDTH>
+    void BatchCompiler::LoadValue(Register<8, true> dest, unsigned value)
+    {
+        const Value& v = m_values[value];
+
+        if (v.m_register >= 0 && v.m_register != static_cast<int>(dest.GetId()))
+        {
+            m_code.EmitPacked<OpCode::Mov, WIDTH>(dest, Register<8, true>(v.m_register));
+        }
+        else if (v.m_slot >= 0)
+        {
+            m_code.EmitPacked<OpCode::Mov, WIDTH>(dest, rbp, GetSlotOffset(v.m_slot));
+        }
+        else
+        {
+            LogThrowAssert(IsMemoryValue(value), "Value %u has not been evaluated", value);
+
+            Register<8, false> base;
+            int32_t offset;
+            GetAddress(value, base, offset);
+
+            m_code.EmitPacked<OpCode::Mov, WIDTH>(dest, base, offset);
+        }
+    }
+
+
+    unsigned BatchCompiler::GetNextUse(unsigned value, unsigned current) const
+    {
+        const unsigned lastUse = m_values[value].m_lastUse;
+
+        for (unsigned i = current + 1; i < lastUse; ++i)
+        {
+            const Value& v = m_values[i];
+
+            for (unsigned j = 0; j < v.m_operation.m_operandCount; ++j)
+            {
+                if (v.m_operands[j] == value)
+                {
+                    return i;
+                }
+            }
+        }
+
+        return lastUse;
+    }
+
+
+    bool BatchCompiler::IsMemoryValue(unsigned value) const
+    {
+        return m_values[value].m_operation.m_kind != LaneOperation::Kind::Operation;
+    }
+
+
+    void BatchCompiler::GetAddress(unsigned value, Register<8, false>& base, int32_t& offset) const
+    {
+        const Value& v = m_values[value];
+
+        if (v.m_operation.m_kind == LaneOperation::Kind::Parameter)
+        {
+            base = Register<8, false>(c_parameterRegisterIds[v.m_operation.m_position]);
+            offset = 0;
+        }
+        else
+        {
+            LogThrowAssert(v.m_operation.m_kind == LaneOperation::Kind::Immediate,
+                           "Value %u is not in memory",
+                           value);
+
+            base = rip;
+            offset = m_constantOffsets[v.m_constant];
+        }
+    }
+
+
+    unsigned BatchCompiler::AllocateSlot()
+    {
+        for (unsigned i = 0; i < m_isSlotFree.size(); ++i)
+        {
+            if (m_isSlotFree[i])
+            {
+                m_isSlotFree[i] = false;
+                return i;
+            }
+        }
+
+        LogThrowAssert((m_isSlotFree.size() + 1) * c_slotSize < FunctionSpecification::c_maxStackSize,
+                       "Too many spilled values");
+
+        m_isSlotFree.push_back(false);
+
+        return static_cast<unsigned>(m_isSlotFree.size() - 1);
+    }
+
+
+    int32_t BatchCompiler::GetSlotOffset(int slot)
+    {
+        // The function uses BaseRegisterType::SetRbpToOriginalRsp, so the
+        // stack variables start at [rbp - 8].
+        return -(slot + 1) * c_slotSize;
+    }
+
+
+    void BatchCompiler::ReleaseOperands(unsigned current)
+    {
+        const Value& value = m_values[current];
+
+        for (unsigned i = 0; i < value.m_operation.m_operandCount; ++i)
+        {
+            Value& operand = m_values[value.m_operands[i]];
+
+            if (operand.m_lastUse != current)
+            {
+                continue;
+            }
+
+            if (operand.m_register >= 0)
+            {
+                if (operand.m_register != value.m_register)
+                {
+                    m_registerOwner[operand.m_register] = -1;
+                }
+                operand.m_register = -1;
+            }
+
+            if (operand.m_slot >= 0)
+            {
+                m_isSlotFree[operand.m_slot] = true;
+                operand.m_slot = -1;
+            }
+        }
+
+        m_lockedRegisters = 0;
+    }
+
+
+    void BatchCompiler::AdvancePointers(Register<8, false> out,
+                                        Register<8, false> count,
+                                        unsigned pointCount)
+    {
+        const int32_t byteCount = static_cast<int32_t>(pointCount * sizeof(double));
+
+        for (unsigned i = 0; i < c_maxParameters; ++i)
+        {
+            if (m_isParameterUsed[i])
+            {
+                m_code.EmitImmediate<OpCode::Add>(Register<8, false>(c_parameterRegisterIds[i]),
+                                                  byteCount);
+            }
+        }
+
+        m_code.EmitImmediate<OpCode::Add>(out, byteCount);
+        m_code.EmitImmediate<OpCode::Sub>(count, static_cast<int32_t>(pointCount));
+    }
+}
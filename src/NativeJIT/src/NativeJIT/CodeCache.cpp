@@ -0,0 +1,437 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <cstdio>       // For FILE, std::fopen etc.
+#include <cstring>      // For memcpy
+#include <sstream>
+
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+#include <process.h>    // For _getpid
+#include <thread>
+#else
+#include <stdlib.h>     // For mkstemp
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "NativeJIT/BatchCompiler.h"
+#include "NativeJIT/CodeCache.h"
+#include "NativeJIT/CodeGen/FunctionBuffer.h"
+
+
+// Set by CMake to a hash of the NativeJIT sources.
+#ifndef NATIVEJIT_GENERATOR_ID
+#define NATIVEJIT_GENERATOR_ID __DATE__ " " __TIME__
+#endif
+
+
+namespace NativeJIT
+{
+    namespace
+    {
+        // The file starts with the magic and a header of 32 bit values
+        // followed by the key, the relocations as (offset, symbol index)
+        // pairs and the code image with the relocated addresses zeroed.
+        const char c_magic[8] = { 'N', 'J', 'I', 'T', 'C', 'O', 'D', 'E' };
+
+        enum HeaderField
+        {
+            FormatVersion,
+            Target,
+            KeySize,
+            RelocationCount,
+            ImageSize,
+            CodeStartOffset,
+            UnwindInfoOffset,
+            ChecksumLow,
+            ChecksumHigh,
+            HeaderFieldCount
+        };
+
+
+        uint64_t Fnv1a(uint64_t hash, void const * data, size_t size)
+        {
+            auto bytes = static_cast<uint8_t const *>(data);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ull;
+            }
+
+            return hash;
+        }
+
+
+        // Returns the checksum of the parts of an entry following the header.
+        uint64_t Checksum(std::string const & key,
+                          std::vector<uint32_t> const & relocations,
+                          std::vector<uint8_t> const & image)
+        {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            hash = Fnv1a(hash, key.data(), key.size());
+            hash = Fnv1a(hash, relocations.data(), relocations.size() * sizeof(uint32_t));
+            hash = Fnv1a(hash, image.data(), image.size());
+
+            return hash;
+        }
+
+
+#ifndef NATIVEJIT_PLATFORM_WINDOWS
+        // Returns whether the file or directory belongs to the effective
+        // user and can only be modified by it.
+        bool IsPrivate(struct stat const & status)
+        {
+            return status.st_uid == geteuid()
+                   && (status.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+        }
+#endif
+
+
+        // Closes the file when going out of scope.
+        class File
+        {
+        public:
+            File(FILE* file)
+                : m_file(file)
+            {
+            }
+
+            ~File()
+            {
+                if (m_file != nullptr)
+                {
+                    std::fclose(m_file);
+                }
+            }
+
+            bool IsOpen() const
+            {
+                return m_file != nullptr;
+            }
+
+            // Returns whether the open file is a regular file which can be
+            // trusted, see CodeCache.
+            bool IsPrivate() const
+            {
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+                return true;
+#else
+                struct stat status;
+
+                return fstat(fileno(m_file), &status) == 0
+                       && S_ISREG(status.st_mode)
+                       && NativeJIT::IsPrivate(status);
+#endif
+            }
+
+            bool Read(void* data, size_t size)
+            {
+                return size == 0 || std::fread(data, size, 1, m_file) == 1;
+            }
+
+            bool Write(void const * data, size_t size)
+            {
+                return size == 0 || std::fwrite(data, size, 1, m_file) == 1;
+            }
+
+            // Closes the file, returning whether all writes were flushed.
+            bool Close()
+            {
+                const bool success = std::fclose(m_file) == 0;
+                m_file = nullptr;
+
+                return success;
+            }
+
+        private:
+            FILE* m_file;
+        };
+
+
+        // Creates a new file next to fileName for writing, with a name no
+        // other thread or process uses. Sets name to its name.
+        FILE* CreateTemporaryFile(std::string const & fileName, std::string& name)
+        {
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+            std::ostringstream temporaryName;
+            temporaryName << fileName << '.' << _getpid()
+                          << '.' << std::this_thread::get_id() << ".tmp";
+            name = temporaryName.str();
+
+            // The x mode fails rather than truncating an existing file.
+            return std::fopen(name.c_str(), "wbx");
+#else
+            // mkstemp() creates the file with mode 0600.
+            std::vector<char> temporaryName(fileName.begin(), fileName.end());
+            const char suffix[] = ".XXXXXX";
+            temporaryName.insert(temporaryName.end(), suffix, suffix + sizeof(suffix));
+
+            const int fd = mkstemp(temporaryName.data());
+            if (fd < 0)
+            {
+                return nullptr;
+            }
+
+            name = temporaryName.data();
+
+            FILE* file = fdopen(fd, "wb");
+            if (file == nullptr)
+            {
+                close(fd);
+                std::remove(name.c_str());
+            }
+
+            return file;
+#endif
+        }
+    }
+
+
+    const uint32_t CodeCache::c_formatVersion;
+
+
+    CodeCache::CodeCache(std::string const & directory,
+                         std::vector<void const *> const & symbols)
+        : m_directory(directory),
+          m_symbols(symbols)
+    {
+    }
+
+
+    void const * CodeCache::Load(std::string const & key, FunctionBuffer& code) const
+    {
+        if (!IsDirectoryPrivate())
+        {
+            return nullptr;
+        }
+
+        File file(std::fopen(GetFileName(key).c_str(), "rb"));
+        if (!file.IsOpen() || !file.IsPrivate())
+        {
+            return nullptr;
+        }
+
+        const std::string storedKey = GetStoredKey(key);
+        char magic[sizeof(c_magic)];
+        uint32_t header[HeaderFieldCount];
+
+        if (!file.Read(magic, sizeof(magic))
+            || memcmp(magic, c_magic, sizeof(c_magic)) != 0
+            || !file.Read(header, sizeof(header))
+            || header[FormatVersion] != c_formatVersion
+            || header[Target] != GetTarget()
+            || header[KeySize] != storedKey.size()
+            || header[ImageSize] > code.GetCapacity()
+            || header[CodeStartOffset] >= header[ImageSize]
+            || header[UnwindInfoOffset] >= header[ImageSize])
+        {
+            return nullptr;
+        }
+
+        std::string fileKey(storedKey.size(), '\0');
+        std::vector<uint32_t> relocations(2 * header[RelocationCount]);
+        std::vector<uint8_t> image(header[ImageSize]);
+
+        if (!file.Read(&fileKey[0], fileKey.size())
+            || fileKey != storedKey
+            || !file.Read(relocations.data(), relocations.size() * sizeof(uint32_t))
+            || !file.Read(image.data(), image.size()))
+        {
+            return nullptr;
+        }
+
+        const uint64_t checksum = Checksum(fileKey, relocations, image);
+
+        if (header[ChecksumLow] != static_cast<uint32_t>(checksum)
+            || header[ChecksumHigh] != static_cast<uint32_t>(checksum >> 32))
+        {
+            return nullptr;
+        }
+
+        for (size_t i = 0; i < relocations.size(); i += 2)
+        {
+            const uint32_t offset = relocations[i];
+            const uint32_t symbol = relocations[i + 1];
+
+            if (symbol >= m_symbols.size()
+                || image.size() < sizeof(uint64_t)
+                || offset > image.size() - sizeof(uint64_t))
+            {
+                return nullptr;
+            }
+
+            memcpy(&image[offset], &m_symbols[symbol], sizeof(uint64_t));
+        }
+
+        code.LoadFunction(image.data(),
+                          header[ImageSize],
+                          header[CodeStartOffset],
+                          header[UnwindInfoOffset]);
+
+        return code.GetEntryPoint();
+    }
+
+
+    bool CodeCache::Store(std::string const & key, FunctionBuffer const & code) const
+    {
+        if (!code.IsRelocatable() || !IsDirectoryPrivate())
+        {
+            return false;
+        }
+
+        const unsigned imageSize = code.GetFunctionCodeEndOffset();
+        std::vector<uint8_t> image(code.BufferStart(), code.BufferStart() + imageSize);
+        std::vector<uint32_t> relocations;
+
+        for (unsigned offset : code.GetRelocations())
+        {
+            void const * address;
+            memcpy(&address, &image[offset], sizeof(address));
+
+            uint32_t symbol = 0;
+            while (symbol < m_symbols.size() && m_symbols[symbol] != address)
+            {
+                ++symbol;
+            }
+
+            if (symbol == m_symbols.size())
+            {
+                return false;
+            }
+
+            relocations.push_back(offset);
+            relocations.push_back(symbol);
+            memset(&image[offset], 0, sizeof(uint64_t));
+        }
+
+        const std::string storedKey = GetStoredKey(key);
+        const uint64_t checksum = Checksum(storedKey, relocations, image);
+
+        uint32_t header[HeaderFieldCount];
+        header[FormatVersion] = c_formatVersion;
+        header[Target] = GetTarget();
+        header[KeySize] = static_cast<uint32_t>(storedKey.size());
+        header[RelocationCount] = static_cast<uint32_t>(relocations.size() / 2);
+        header[ImageSize] = imageSize;
+        header[CodeStartOffset] = code.GetFunctionCodeStartOffset();
+        header[UnwindInfoOffset] = code.GetUnwindInfoStartOffset();
+        header[ChecksumLow] = static_cast<uint32_t>(checksum);
+        header[ChecksumHigh] = static_cast<uint32_t>(checksum >> 32);
+
+        // Write to a temporary file first so that concurrent readers never
+        // see a partially written entry.
+        const std::string fileName = GetFileName(key);
+        std::string temporaryName;
+
+        {
+            File file(CreateTemporaryFile(fileName, temporaryName));
+            if (!file.IsOpen())
+            {
+                return false;
+            }
+
+            if (!file.Write(c_magic, sizeof(c_magic))
+                || !file.Write(header, sizeof(header))
+                || !file.Write(storedKey.data(), storedKey.size())
+                || !file.Write(relocations.data(), relocations.size() * sizeof(uint32_t))
+                || !file.Write(image.data(), image.size())
+                || !file.Close())
+            {
+                std::remove(temporaryName.c_str());
+                return false;
+            }
+        }
+
+        // On Windows, rename() fails if the entry exists, which means another
+        // process has already stored it.
+        if (std::rename(temporaryName.c_str(), fileName.c_str()) != 0)
+        {
+            std::remove(temporaryName.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+
+    std::string CodeCache::GetFileName(std::string const & key) const
+    {
+        const uint32_t target = GetTarget();
+        const std::string storedKey = GetStoredKey(key);
+
+        uint64_t hash = 0xcbf29ce484222325ull;
+        hash = Fnv1a(hash, &target, sizeof(target));
+        hash = Fnv1a(hash, storedKey.data(), storedKey.size());
+
+        std::ostringstream name;
+        name << m_directory << '/';
+        name.width(16);
+        name.fill('0');
+        name << std::hex << hash << ".njit";
+
+        return name.str();
+    }
+
+
+    char const * CodeCache::GetGeneratorId()
+    {
+        return NATIVEJIT_GENERATOR_ID;
+    }
+
+
+    uint32_t CodeCache::GetTarget()
+    {
+        uint32_t target = static_cast<uint32_t>(BatchCompiler::GetWidestInstructionSet());
+
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+        target |= 0x100;
+#endif
+
+        return target;
+    }
+
+
+    std::string CodeCache::GetStoredKey(std::string const & key)
+    {
+        std::string storedKey(GetGeneratorId());
+        storedKey.push_back('\0');
+        storedKey.append(key);
+
+        return storedKey;
+    }
+
+
+    bool CodeCache::IsDirectoryPrivate() const
+    {
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+        return true;
+#else
+        struct stat status;
+
+        return stat(m_directory.c_str(), &status) == 0
+               && S_ISDIR(status.st_mode)
+               && IsPrivate(status);
+#endif
+    }
+}
@@ -28,7 +28,50 @@ namespace NativeJIT
 {
     ExpressionNodeFactory::ExpressionNodeFactory(Allocators::IAllocator& allocator,
                                                  FunctionBuffer& code)
-        : ExpressionTree(allocator, code)
+        : ExpressionTree(allocator, code),
+          m_isCommonSubexpressionEliminationEnabled(false),
+          m_uniqueNodes(0,
+                        NodeKeyHash(),
+                        std::equal_to<NodeKey>(),
+                        Allocators::StlAllocator<std::pair<const NodeKey, NodeBase*>>(allocator))
     {
     }
+
+
+    void ExpressionNodeFactory::EnableCommonSubexpressionElimination()
+    {
+        m_isCommonSubexpressionEliminationEnabled = true;
+    }
+
+
+    void ExpressionNodeFactory::DisableCommonSubexpressionElimination()
+    {
+        m_isCommonSubexpressionEliminationEnabled = false;
+    }
+
+
+    bool ExpressionNodeFactory::NodeKey::operator==(NodeKey const & other) const
+    {
+        return m_nodeType == other.m_nodeType
+               && m_operands[0] == other.m_operands[0]
+               && m_operands[1] == other.m_operands[1]
+               && m_operands[2] == other.m_operands[2];
+    }
+
+
+    size_t ExpressionNodeFactory::NodeKeyHash::operator()(NodeKey const & key) const
+    {
+        // Combine the fields in the same way as boost::hash_combine().
+        size_t hash = std::hash<void const *>()(key.m_nodeType);
+
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            hash ^= std::hash<uint64_t>()(key.m_operands[i])
+                    + 0x9e3779b9
+                    + (hash << 6)
+                    + (hash >> 2);
+        }
+
+        return hash;
+    }
 }
@@ -21,6 +21,8 @@
 // THE SOFTWARE.
 
 
+#include <algorithm>    // For std::rotate
+
 #include "NativeJIT/CodeGen/CallingConvention.h"
 #include "NativeJIT/CodeGen/FunctionBuffer.h"
 #include "NativeJIT/CodeGen/FunctionSpecification.h"
@@ -54,6 +56,7 @@ namespace NativeJIT
           m_temporaryCount(0),
           m_temporaries(m_stlAllocator),
           m_maxFunctionCallParameters(-1),
+          m_hasAbsoluteAddresses(false),
           m_basePointer(rbp)
           // m_startOfEpilogue intentionally left uninitialized, see Compile().
     {
@@ -210,6 +213,12 @@ namespace NativeJIT
     }
 
 
+    void ExpressionTree::ReportAbsoluteAddress()
+    {
+        m_hasAbsoluteAddresses = true;
+    }
+
+
     void ExpressionTree::Compile()
     {
         // Note: the call to Reset() clears all allocated labels, so start of
@@ -217,7 +226,13 @@ namespace NativeJIT
         m_code.Reset();
         m_startOfEpilogue = m_code.AllocateLabel();
 
-        // Generate constants.
+        if (m_hasAbsoluteAddresses)
+        {
+            m_code.MarkNotRelocatable();
+        }
+
+        // Fold constant subexpressions and generate constants.
+        FoldConstants();
         Pass0();
 
         // Generate code.
@@ -302,6 +317,48 @@ namespace NativeJIT
     }
 
 
+    void ExpressionTree::FoldConstants()
+    {
+        if (IsDiagnosticsStreamAvailable())
+        {
+            GetDiagnosticsStream() << "=== FoldConstants ===" << std::endl;
+        }
+
+        // Children are created before their parents, so walking the nodes in
+        // the order of creation folds whole constant subtrees bottom-up.
+        // Folding releases the children's references, so a folded node that
+        // still has parents afterwards is the root of a constant subtree and
+        // needs an actual value. Nodes created by materialization are
+        // appended to m_topologicalSort and are not visited by the loops.
+        // They are moved in front of the root afterwards since Pass3 expects
+        // the root to be the last node.
+        const size_t nodeCount = m_topologicalSort.size();
+        bool anyFolded = false;
+
+        for (size_t i = 0; i < nodeCount; ++i)
+        {
+            anyFolded |= m_topologicalSort[i]->TryFold();
+        }
+
+        if (anyFolded)
+        {
+            for (size_t i = 0; i < nodeCount; ++i)
+            {
+                NodeBase& node = *m_topologicalSort[i];
+
+                if (node.GetParentCount() > 0)
+                {
+                    node.MaterializeFoldedValue(*this);
+                }
+            }
+
+            std::rotate(m_topologicalSort.begin() + nodeCount - 1,
+                        m_topologicalSort.begin() + nodeCount,
+                        m_topologicalSort.end());
+        }
+    }
+
+
     void ExpressionTree::Pass0()
     {
         if (IsDiagnosticsStreamAvailable())
@@ -127,4 +127,21 @@ namespace NativeJIT
     {
         return false;
     }
+
+
+    bool NodeBase::TryFold()
+    {
+        return false;
+    }
+
+
+    void NodeBase::MaterializeFoldedValue(ExpressionTree& /* tree */)
+    {
+    }
+
+
+    bool NodeBase::GetLaneOperation(LaneOperation& /* operation */) const
+    {
+        return false;
+    }
 }
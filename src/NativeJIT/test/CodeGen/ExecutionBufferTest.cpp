@@ -0,0 +1,204 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <cstring>
+
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "NativeJIT/CodeGen/ExecutionBuffer.h"
+#include "NativeJIT/CodeGen/FunctionBuffer.h"
+#include "NativeJIT/CodeGen/FunctionSpecification.h"
+#include "Temporary/Allocator.h"
+#include "gtest/gtest.h"
+
+
+namespace NativeJIT
+{
+    namespace ExecutionBufferTest
+    {
+        static size_t GetPageSize()
+        {
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+            SYSTEM_INFO systemInfo;
+            GetSystemInfo(&systemInfo);
+            return systemInfo.dwPageSize;
+#else
+            return static_cast<size_t>(getpagesize());
+#endif
+        }
+
+
+        TEST(ExecutionBuffer, GrowsByChunks)
+        {
+            const size_t pageSize = GetPageSize();
+            ExecutionBuffer buffer(pageSize);
+
+            ASSERT_EQ(1u, buffer.GetStatistics().m_chunkCount);
+
+            uint8_t* blocks[3];
+
+            for (auto & block : blocks)
+            {
+                block = static_cast<uint8_t*>(buffer.Allocate(pageSize));
+                memset(block, 0xc3, pageSize);
+            }
+
+            auto const & statistics = buffer.GetStatistics();
+
+            ASSERT_EQ(3u, statistics.m_chunkCount);
+            ASSERT_EQ(3 * pageSize, statistics.m_mappedBytes);
+            ASSERT_EQ(3u, statistics.m_allocatedBlockCount);
+            ASSERT_EQ(3 * pageSize, statistics.m_allocatedBytes);
+            ASSERT_EQ(SIZE_MAX, buffer.Available());
+
+            // Allocations larger than a chunk get a chunk of their own.
+            buffer.Allocate(3 * pageSize + 1);
+
+            ASSERT_EQ(4u, statistics.m_chunkCount);
+            ASSERT_EQ(7 * pageSize, statistics.m_allocatedBytes);
+        }
+
+
+        TEST(ExecutionBuffer, FreeAndReuse)
+        {
+            const size_t pageSize = GetPageSize();
+            ExecutionBuffer buffer(4 * pageSize);
+
+            uint8_t* blocks[4];
+
+            for (auto & block : blocks)
+            {
+                block = static_cast<uint8_t*>(buffer.Allocate(1));
+            }
+
+            ASSERT_EQ(1u, buffer.GetStatistics().m_chunkCount);
+
+            // The two adjacent free blocks are merged into one.
+            buffer.Deallocate(blocks[1]);
+            buffer.Deallocate(blocks[2]);
+
+            auto const & statistics = buffer.GetStatistics();
+
+            ASSERT_EQ(2u, statistics.m_freedBlockCount);
+            ASSERT_EQ(2 * pageSize, statistics.m_freedBytes);
+            ASSERT_EQ(2 * pageSize, statistics.m_allocatedBytes);
+            ASSERT_EQ(4 * pageSize, statistics.m_peakAllocatedBytes);
+
+            ASSERT_EQ(blocks[1], buffer.Allocate(2 * pageSize));
+            ASSERT_EQ(1u, statistics.m_chunkCount);
+
+            ASSERT_ANY_THROW(buffer.Deallocate(blocks[2]));
+        }
+
+
+        TEST(ExecutionBuffer, MaxSize)
+        {
+            const size_t pageSize = GetPageSize();
+            ExecutionBuffer buffer(pageSize, 2 * pageSize);
+
+            void* first = buffer.Allocate(pageSize);
+            buffer.Allocate(pageSize);
+
+            ASSERT_EQ(0u, buffer.Available());
+            ASSERT_ANY_THROW(buffer.Allocate(1));
+
+            buffer.Deallocate(first);
+
+            ASSERT_EQ(pageSize, buffer.Available());
+            ASSERT_EQ(first, buffer.Allocate(1));
+        }
+
+
+        TEST(ExecutionBuffer, ReleaseUnusedChunks)
+        {
+            const size_t pageSize = GetPageSize();
+            ExecutionBuffer buffer(pageSize);
+
+            void* first = buffer.Allocate(pageSize);
+            void* second = buffer.Allocate(pageSize);
+            void* third = buffer.Allocate(pageSize);
+
+            buffer.Deallocate(second);
+
+            auto const & statistics = buffer.GetStatistics();
+
+            ASSERT_EQ(pageSize, buffer.ReleaseUnusedChunks());
+            ASSERT_EQ(2u, statistics.m_chunkCount);
+            ASSERT_EQ(1u, statistics.m_releasedChunkCount);
+
+            // The first chunk is kept even when it is unused.
+            buffer.Deallocate(first);
+            buffer.Deallocate(third);
+
+            ASSERT_EQ(pageSize, buffer.ReleaseUnusedChunks());
+            ASSERT_EQ(1u, statistics.m_chunkCount);
+            ASSERT_EQ(pageSize, statistics.m_mappedBytes);
+
+            buffer.Allocate(pageSize);
+            buffer.Allocate(pageSize);
+            buffer.Reset();
+
+            ASSERT_EQ(1u, statistics.m_chunkCount);
+            ASSERT_EQ(0u, statistics.m_allocatedBlockCount);
+        }
+
+
+        TEST(ExecutionBuffer, WriteXorExecute)
+        {
+            const size_t pageSize = GetPageSize();
+            ExecutionBuffer codeAllocator(pageSize);
+            Allocator allocator(16384);
+            FunctionBuffer code(codeAllocator, static_cast<unsigned>(pageSize));
+
+            auto const & statistics = codeAllocator.GetStatistics();
+
+            for (int32_t value = 0; value < 3; ++value)
+            {
+                // Recompiling into the buffer makes it writable again.
+                code.Reset();
+                code.BeginFunctionBodyGeneration();
+                code.EmitImmediate<OpCode::Mov>(eax, value);
+
+                FunctionSpecification spec(allocator,
+                                           0,
+                                           0,
+                                           0,
+                                           0,
+                                           FunctionSpecification::BaseRegisterType::Unused,
+                                           nullptr);
+                code.EndFunctionBodyGeneration(spec);
+
+                ASSERT_EQ(2u * value + 1, statistics.m_protectionChangeCount);
+
+                auto function = reinterpret_cast<int32_t (*)()>(
+                                    const_cast<void*>(code.GetEntryPoint()));
+                ASSERT_EQ(value, function());
+            }
+        }
+    }
+}
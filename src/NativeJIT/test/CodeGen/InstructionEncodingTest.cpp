@@ -39057,6 +39057,653 @@ namespace NativeJIT
         }
 
 
+        // Scalar floating point Div, Min, Max and Sqrt, and the FMA3 Vfmadd231.
+        // The expected encodings were produced with the GNU assembler.
+        TEST_F(InstructionEnconding, ScalarSSEArithmetic)
+        {
+            auto setup = GetSetup();
+            auto& buffer = setup->GetCode();
+
+            uint8_t const * start =  buffer.BufferStart() + buffer.CurrentPosition();
+
+            // Div
+            buffer.Emit<OpCode::Div>(xmm0s, xmm1s);
+            buffer.Emit<OpCode::Div>(xmm0, xmm1);
+            buffer.Emit<OpCode::Div>(xmm8s, xmm15s);
+            buffer.Emit<OpCode::Div>(xmm8, xmm15);
+            buffer.Emit<OpCode::Div>(xmm2s, xmm9s);
+            buffer.Emit<OpCode::Div>(xmm2, xmm9);
+            buffer.Emit<OpCode::Div>(xmm13s, xmm4s);
+            buffer.Emit<OpCode::Div>(xmm13, xmm4);
+            buffer.Emit<OpCode::Div>(xmm1s, rax, 4);
+            buffer.Emit<OpCode::Div>(xmm1, rax, 4);
+            buffer.Emit<OpCode::Div>(xmm9s, r12, -4);
+            buffer.Emit<OpCode::Div>(xmm9, r12, -4);
+            buffer.Emit<OpCode::Div>(xmm3s, r13, 256);
+            buffer.Emit<OpCode::Div>(xmm3, r13, 256);
+
+            // Min
+            buffer.Emit<OpCode::Min>(xmm0s, xmm1s);
+            buffer.Emit<OpCode::Min>(xmm0, xmm1);
+            buffer.Emit<OpCode::Min>(xmm8s, xmm15s);
+            buffer.Emit<OpCode::Min>(xmm8, xmm15);
+            buffer.Emit<OpCode::Min>(xmm2s, xmm9s);
+            buffer.Emit<OpCode::Min>(xmm2, xmm9);
+            buffer.Emit<OpCode::Min>(xmm13s, xmm4s);
+            buffer.Emit<OpCode::Min>(xmm13, xmm4);
+            buffer.Emit<OpCode::Min>(xmm1s, rax, 4);
+            buffer.Emit<OpCode::Min>(xmm1, rax, 4);
+            buffer.Emit<OpCode::Min>(xmm9s, r12, -4);
+            buffer.Emit<OpCode::Min>(xmm9, r12, -4);
+            buffer.Emit<OpCode::Min>(xmm3s, r13, 256);
+            buffer.Emit<OpCode::Min>(xmm3, r13, 256);
+
+            // Max
+            buffer.Emit<OpCode::Max>(xmm0s, xmm1s);
+            buffer.Emit<OpCode::Max>(xmm0, xmm1);
+            buffer.Emit<OpCode::Max>(xmm8s, xmm15s);
+            buffer.Emit<OpCode::Max>(xmm8, xmm15);
+            buffer.Emit<OpCode::Max>(xmm2s, xmm9s);
+            buffer.Emit<OpCode::Max>(xmm2, xmm9);
+            buffer.Emit<OpCode::Max>(xmm13s, xmm4s);
+            buffer.Emit<OpCode::Max>(xmm13, xmm4);
+            buffer.Emit<OpCode::Max>(xmm1s, rax, 4);
+            buffer.Emit<OpCode::Max>(xmm1, rax, 4);
+            buffer.Emit<OpCode::Max>(xmm9s, r12, -4);
+            buffer.Emit<OpCode::Max>(xmm9, r12, -4);
+            buffer.Emit<OpCode::Max>(xmm3s, r13, 256);
+            buffer.Emit<OpCode::Max>(xmm3, r13, 256);
+
+            // Sqrt
+            buffer.Emit<OpCode::Sqrt>(xmm0s, xmm1s);
+            buffer.Emit<OpCode::Sqrt>(xmm0, xmm1);
+            buffer.Emit<OpCode::Sqrt>(xmm8s, xmm15s);
+            buffer.Emit<OpCode::Sqrt>(xmm8, xmm15);
+            buffer.Emit<OpCode::Sqrt>(xmm2s, xmm9s);
+            buffer.Emit<OpCode::Sqrt>(xmm2, xmm9);
+            buffer.Emit<OpCode::Sqrt>(xmm13s, xmm4s);
+            buffer.Emit<OpCode::Sqrt>(xmm13, xmm4);
+            buffer.Emit<OpCode::Sqrt>(xmm1s, rax, 4);
+            buffer.Emit<OpCode::Sqrt>(xmm1, rax, 4);
+            buffer.Emit<OpCode::Sqrt>(xmm9s, r12, -4);
+            buffer.Emit<OpCode::Sqrt>(xmm9, r12, -4);
+            buffer.Emit<OpCode::Sqrt>(xmm3s, r13, 256);
+            buffer.Emit<OpCode::Sqrt>(xmm3, r13, 256);
+
+            // Vfmadd231
+            buffer.Emit<OpCode::Vfmadd231>(xmm0s, xmm1s, xmm2s);
+            buffer.Emit<OpCode::Vfmadd231>(xmm0, xmm1, xmm2);
+            buffer.Emit<OpCode::Vfmadd231>(xmm8s, xmm9s, xmm15s);
+            buffer.Emit<OpCode::Vfmadd231>(xmm8, xmm9, xmm15);
+            buffer.Emit<OpCode::Vfmadd231>(xmm1s, xmm12s, xmm3s);
+            buffer.Emit<OpCode::Vfmadd231>(xmm1, xmm12, xmm3);
+            buffer.Emit<OpCode::Vfmadd231>(xmm14s, xmm0s, xmm10s);
+            buffer.Emit<OpCode::Vfmadd231>(xmm14, xmm0, xmm10);
+
+            std::string ml64Output =
+                "                                ; Div                                                              \n"
+                " 00000000  F3 0F 5E C1           divss xmm0, xmm1                                                  \n"
+                " 00000004  F2 0F 5E C1           divsd xmm0, xmm1                                                  \n"
+                " 00000008  F3 45 0F 5E C7        divss xmm8, xmm15                                                 \n"
+                " 0000000D  F2 45 0F 5E C7        divsd xmm8, xmm15                                                 \n"
+                " 00000012  F3 41 0F 5E D1        divss xmm2, xmm9                                                  \n"
+                " 00000017  F2 41 0F 5E D1        divsd xmm2, xmm9                                                  \n"
+                " 0000001C  F3 44 0F 5E EC        divss xmm13, xmm4                                                 \n"
+                " 00000021  F2 44 0F 5E EC        divsd xmm13, xmm4                                                 \n"
+                " 00000026  F3 0F 5E 48 04        divss xmm1, dword ptr [rax + 4]                                   \n"
+                " 0000002B  F2 0F 5E 48 04        divsd xmm1, qword ptr [rax + 4]                                   \n"
+                " 00000030  F3 45 0F 5E 4C        divss xmm9, dword ptr [r12 - 4]                                   \n"
+                "           24 FC                                                                                   \n"
+                " 00000037  F2 45 0F 5E 4C        divsd xmm9, qword ptr [r12 - 4]                                   \n"
+                "           24 FC                                                                                   \n"
+                " 0000003E  F3 41 0F 5E 9D        divss xmm3, dword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000047  F2 41 0F 5E 9D        divsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                "                                                                                                   \n"
+                "                                ; Min                                                              \n"
+                " 00000050  F3 0F 5D C1           minss xmm0, xmm1                                                  \n"
+                " 00000054  F2 0F 5D C1           minsd xmm0, xmm1                                                  \n"
+                " 00000058  F3 45 0F 5D C7        minss xmm8, xmm15                                                 \n"
+                " 0000005D  F2 45 0F 5D C7        minsd xmm8, xmm15                                                 \n"
+                " 00000062  F3 41 0F 5D D1        minss xmm2, xmm9                                                  \n"
+                " 00000067  F2 41 0F 5D D1        minsd xmm2, xmm9                                                  \n"
+                " 0000006C  F3 44 0F 5D EC        minss xmm13, xmm4                                                 \n"
+                " 00000071  F2 44 0F 5D EC        minsd xmm13, xmm4                                                 \n"
+                " 00000076  F3 0F 5D 48 04        minss xmm1, dword ptr [rax + 4]                                   \n"
+                " 0000007B  F2 0F 5D 48 04        minsd xmm1, qword ptr [rax + 4]                                   \n"
+                " 00000080  F3 45 0F 5D 4C        minss xmm9, dword ptr [r12 - 4]                                   \n"
+                "           24 FC                                                                                   \n"
+                " 00000087  F2 45 0F 5D 4C        minsd xmm9, qword ptr [r12 - 4]                                   \n"
+                "           24 FC                                                                                   \n"
+                " 0000008E  F3 41 0F 5D 9D        minss xmm3, dword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000097  F2 41 0F 5D 9D        minsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                "                                                                                                   \n"
+                "                                ; Max                                                              \n"
+                " 000000A0  F3 0F 5F C1           maxss xmm0, xmm1                                                  \n"
+                " 000000A4  F2 0F 5F C1           maxsd xmm0, xmm1                                                  \n"
+                " 000000A8  F3 45 0F 5F C7        maxss xmm8, xmm15                                                 \n"
+                " 000000AD  F2 45 0F 5F C7        maxsd xmm8, xmm15                                                 \n"
+                " 000000B2  F3 41 0F 5F D1        maxss xmm2, xmm9                                                  \n"
+                " 000000B7  F2 41 0F 5F D1        maxsd xmm2, xmm9                                                  \n"
+                " 000000BC  F3 44 0F 5F EC        maxss xmm13, xmm4                                                 \n"
+                " 000000C1  F2 44 0F 5F EC        maxsd xmm13, xmm4                                                 \n"
+                " 000000C6  F3 0F 5F 48 04        maxss xmm1, dword ptr [rax + 4]                                   \n"
+                " 000000CB  F2 0F 5F 48 04        maxsd xmm1, qword ptr [rax + 4]                                   \n"
+                " 000000D0  F3 45 0F 5F 4C        maxss xmm9, dword ptr [r12 - 4]                                   \n"
+                "           24 FC                                                                                   \n"
+                " 000000D7  F2 45 0F 5F 4C        maxsd xmm9, qword ptr [r12 - 4]                                   \n"
+                "           24 FC                                                                                   \n"
+                " 000000DE  F3 41 0F 5F 9D        maxss xmm3, dword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 000000E7  F2 41 0F 5F 9D        maxsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                "                                                                                                   \n"
+                "                                ; Sqrt                                                             \n"
+                " 000000F0  F3 0F 51 C1           sqrtss xmm0, xmm1                                                 \n"
+                " 000000F4  F2 0F 51 C1           sqrtsd xmm0, xmm1                                                 \n"
+                " 000000F8  F3 45 0F 51 C7        sqrtss xmm8, xmm15                                                \n"
+                " 000000FD  F2 45 0F 51 C7        sqrtsd xmm8, xmm15                                                \n"
+                " 00000102  F3 41 0F 51 D1        sqrtss xmm2, xmm9                                                 \n"
+                " 00000107  F2 41 0F 51 D1        sqrtsd xmm2, xmm9                                                 \n"
+                " 0000010C  F3 44 0F 51 EC        sqrtss xmm13, xmm4                                                \n"
+                " 00000111  F2 44 0F 51 EC        sqrtsd xmm13, xmm4                                                \n"
+                " 00000116  F3 0F 51 48 04        sqrtss xmm1, dword ptr [rax + 4]                                  \n"
+                " 0000011B  F2 0F 51 48 04        sqrtsd xmm1, qword ptr [rax + 4]                                  \n"
+                " 00000120  F3 45 0F 51 4C        sqrtss xmm9, dword ptr [r12 - 4]                                  \n"
+                "           24 FC                                                                                   \n"
+                " 00000127  F2 45 0F 51 4C        sqrtsd xmm9, qword ptr [r12 - 4]                                  \n"
+                "           24 FC                                                                                   \n"
+                " 0000012E  F3 41 0F 51 9D        sqrtss xmm3, dword ptr [r13 + 256]                                \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000137  F2 41 0F 51 9D        sqrtsd xmm3, qword ptr [r13 + 256]                                \n"
+                "           00 01 00 00                                                                             \n"
+                "                                                                                                   \n"
+                "                                ; Vfmadd231                                                        \n"
+                " 00000140  C4 E2 71 B9 C2        vfmadd231ss xmm0, xmm1, xmm2                                      \n"
+                " 00000145  C4 E2 F1 B9 C2        vfmadd231sd xmm0, xmm1, xmm2                                      \n"
+                " 0000014A  C4 42 31 B9 C7        vfmadd231ss xmm8, xmm9, xmm15                                     \n"
+                " 0000014F  C4 42 B1 B9 C7        vfmadd231sd xmm8, xmm9, xmm15                                     \n"
+                " 00000154  C4 E2 19 B9 CB        vfmadd231ss xmm1, xmm12, xmm3                                     \n"
+                " 00000159  C4 E2 99 B9 CB        vfmadd231sd xmm1, xmm12, xmm3                                     \n"
+                " 0000015E  C4 42 79 B9 F2        vfmadd231ss xmm14, xmm0, xmm10                                    \n"
+                " 00000163  C4 42 F9 B9 F2        vfmadd231sd xmm14, xmm0, xmm10                                    \n"
+                "                                                                                                   \n"
+                "";
+
+
+            ML64Verifier v(ml64Output.c_str(), start);
+        }
+
+
+        // The scalar, 128 bit SSE and 256 bit VEX forms of EmitPacked.
+        // The expected encodings were produced with the GNU assembler.
+        TEST_F(InstructionEnconding, Packed)
+        {
+            auto setup = GetSetup();
+            auto& buffer = setup->GetCode();
+
+            uint8_t const * start =  buffer.BufferStart() + buffer.CurrentPosition();
+
+            // WIDTH 1: scalar SSE2
+            buffer.EmitPacked<OpCode::Add, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Add, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Add, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Add, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Add, 1>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Add, 1>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Add, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Div, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Div, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Div, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Div, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Div, 1>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Div, 1>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Div, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::IMul, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::IMul, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::IMul, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::IMul, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::IMul, 1>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::IMul, 1>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::IMul, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Max, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Max, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Max, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Max, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Max, 1>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Max, 1>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Max, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Min, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Min, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Min, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Min, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Min, 1>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Min, 1>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Min, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Sub, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Sub, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Sub, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Sub, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Sub, 1>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Sub, 1>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Sub, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Sqrt, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Sqrt, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Sqrt, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Sqrt, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Sqrt, 1>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Sqrt, 1>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Sqrt, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Mov, 1>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Mov, 1>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Mov, 1>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Mov, 1>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Mov, 1>(xmm1, rax, 4);
+            buffer.EmitPacked<OpCode::Mov, 1>(rax, 4, xmm1);
+            buffer.EmitPacked<OpCode::Mov, 1>(xmm9, r12, -8);
+            buffer.EmitPacked<OpCode::Mov, 1>(r12, -8, xmm9);
+            buffer.EmitPacked<OpCode::Mov, 1>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Mov, 1>(r13, 256, xmm3);
+
+            // WIDTH 2: packed SSE2
+            buffer.EmitPacked<OpCode::Add, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Add, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Add, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Add, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Add, 2>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Add, 2>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Add, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Div, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Div, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Div, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Div, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Div, 2>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Div, 2>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Div, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::IMul, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::IMul, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::IMul, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::IMul, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::IMul, 2>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::IMul, 2>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::IMul, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Max, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Max, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Max, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Max, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Max, 2>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Max, 2>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Max, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Min, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Min, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Min, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Min, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Min, 2>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Min, 2>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Min, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Sub, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Sub, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Sub, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Sub, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Sub, 2>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Sub, 2>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Sub, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Sqrt, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Sqrt, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Sqrt, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Sqrt, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Sqrt, 2>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Sqrt, 2>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Sqrt, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Mov, 2>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Mov, 2>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Mov, 2>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Mov, 2>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Mov, 2>(xmm1, rax, 4);
+            buffer.EmitPacked<OpCode::Mov, 2>(rax, 4, xmm1);
+            buffer.EmitPacked<OpCode::Mov, 2>(xmm9, r12, -8);
+            buffer.EmitPacked<OpCode::Mov, 2>(r12, -8, xmm9);
+            buffer.EmitPacked<OpCode::Mov, 2>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Mov, 2>(r13, 256, xmm3);
+
+            // WIDTH 4: VEX.256
+            buffer.EmitPacked<OpCode::Add, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Add, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Add, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Add, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Add, 4>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Add, 4>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Add, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Div, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Div, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Div, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Div, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Div, 4>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Div, 4>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Div, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::IMul, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::IMul, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::IMul, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::IMul, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::IMul, 4>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::IMul, 4>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::IMul, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Max, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Max, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Max, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Max, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Max, 4>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Max, 4>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Max, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Min, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Min, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Min, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Min, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Min, 4>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Min, 4>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Min, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Sub, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Sub, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Sub, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Sub, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Sub, 4>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Sub, 4>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Sub, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Sqrt, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Sqrt, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Sqrt, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Sqrt, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Sqrt, 4>(xmm1, rax, 16);
+            buffer.EmitPacked<OpCode::Sqrt, 4>(xmm9, r12, -32);
+            buffer.EmitPacked<OpCode::Sqrt, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Mov, 4>(xmm0, xmm1);
+            buffer.EmitPacked<OpCode::Mov, 4>(xmm8, xmm15);
+            buffer.EmitPacked<OpCode::Mov, 4>(xmm2, xmm9);
+            buffer.EmitPacked<OpCode::Mov, 4>(xmm13, xmm4);
+            buffer.EmitPacked<OpCode::Mov, 4>(xmm1, rax, 4);
+            buffer.EmitPacked<OpCode::Mov, 4>(rax, 4, xmm1);
+            buffer.EmitPacked<OpCode::Mov, 4>(xmm9, r12, -8);
+            buffer.EmitPacked<OpCode::Mov, 4>(r12, -8, xmm9);
+            buffer.EmitPacked<OpCode::Mov, 4>(xmm3, r13, 256);
+            buffer.EmitPacked<OpCode::Mov, 4>(r13, 256, xmm3);
+
+            // Vfmadd231 on 2 and 4 lanes
+            buffer.EmitPacked<OpCode::Vfmadd231, 2>(xmm0, xmm1, xmm2);
+            buffer.EmitPacked<OpCode::Vfmadd231, 2>(xmm8, xmm9, xmm15);
+            buffer.EmitPacked<OpCode::Vfmadd231, 2>(xmm1, xmm12, xmm3);
+            buffer.EmitPacked<OpCode::Vfmadd231, 2>(xmm14, xmm0, xmm10);
+            buffer.EmitPacked<OpCode::Vfmadd231, 4>(xmm0, xmm1, xmm2);
+            buffer.EmitPacked<OpCode::Vfmadd231, 4>(xmm8, xmm9, xmm15);
+            buffer.EmitPacked<OpCode::Vfmadd231, 4>(xmm1, xmm12, xmm3);
+            buffer.EmitPacked<OpCode::Vfmadd231, 4>(xmm14, xmm0, xmm10);
+
+            std::string ml64Output =
+                "                                ; WIDTH 1: scalar SSE2                                             \n"
+                " 00000000  F2 0F 58 C1           addsd xmm0, xmm1                                                  \n"
+                " 00000004  F2 45 0F 58 C7        addsd xmm8, xmm15                                                 \n"
+                " 00000009  F2 41 0F 58 D1        addsd xmm2, xmm9                                                  \n"
+                " 0000000E  F2 44 0F 58 EC        addsd xmm13, xmm4                                                 \n"
+                " 00000013  F2 0F 58 48 10        addsd xmm1, qword ptr [rax + 16]                                  \n"
+                " 00000018  F2 45 0F 58 4C        addsd xmm9, qword ptr [r12 - 32]                                  \n"
+                "           24 E0                                                                                   \n"
+                " 0000001F  F2 41 0F 58 9D        addsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000028  F2 0F 5E C1           divsd xmm0, xmm1                                                  \n"
+                " 0000002C  F2 45 0F 5E C7        divsd xmm8, xmm15                                                 \n"
+                " 00000031  F2 41 0F 5E D1        divsd xmm2, xmm9                                                  \n"
+                " 00000036  F2 44 0F 5E EC        divsd xmm13, xmm4                                                 \n"
+                " 0000003B  F2 0F 5E 48 10        divsd xmm1, qword ptr [rax + 16]                                  \n"
+                " 00000040  F2 45 0F 5E 4C        divsd xmm9, qword ptr [r12 - 32]                                  \n"
+                "           24 E0                                                                                   \n"
+                " 00000047  F2 41 0F 5E 9D        divsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000050  F2 0F 59 C1           mulsd xmm0, xmm1                                                  \n"
+                " 00000054  F2 45 0F 59 C7        mulsd xmm8, xmm15                                                 \n"
+                " 00000059  F2 41 0F 59 D1        mulsd xmm2, xmm9                                                  \n"
+                " 0000005E  F2 44 0F 59 EC        mulsd xmm13, xmm4                                                 \n"
+                " 00000063  F2 0F 59 48 10        mulsd xmm1, qword ptr [rax + 16]                                  \n"
+                " 00000068  F2 45 0F 59 4C        mulsd xmm9, qword ptr [r12 - 32]                                  \n"
+                "           24 E0                                                                                   \n"
+                " 0000006F  F2 41 0F 59 9D        mulsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000078  F2 0F 5F C1           maxsd xmm0, xmm1                                                  \n"
+                " 0000007C  F2 45 0F 5F C7        maxsd xmm8, xmm15                                                 \n"
+                " 00000081  F2 41 0F 5F D1        maxsd xmm2, xmm9                                                  \n"
+                " 00000086  F2 44 0F 5F EC        maxsd xmm13, xmm4                                                 \n"
+                " 0000008B  F2 0F 5F 48 10        maxsd xmm1, qword ptr [rax + 16]                                  \n"
+                " 00000090  F2 45 0F 5F 4C        maxsd xmm9, qword ptr [r12 - 32]                                  \n"
+                "           24 E0                                                                                   \n"
+                " 00000097  F2 41 0F 5F 9D        maxsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 000000A0  F2 0F 5D C1           minsd xmm0, xmm1                                                  \n"
+                " 000000A4  F2 45 0F 5D C7        minsd xmm8, xmm15                                                 \n"
+                " 000000A9  F2 41 0F 5D D1        minsd xmm2, xmm9                                                  \n"
+                " 000000AE  F2 44 0F 5D EC        minsd xmm13, xmm4                                                 \n"
+                " 000000B3  F2 0F 5D 48 10        minsd xmm1, qword ptr [rax + 16]                                  \n"
+                " 000000B8  F2 45 0F 5D 4C        minsd xmm9, qword ptr [r12 - 32]                                  \n"
+                "           24 E0                                                                                   \n"
+                " 000000BF  F2 41 0F 5D 9D        minsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 000000C8  F2 0F 5C C1           subsd xmm0, xmm1                                                  \n"
+                " 000000CC  F2 45 0F 5C C7        subsd xmm8, xmm15                                                 \n"
+                " 000000D1  F2 41 0F 5C D1        subsd xmm2, xmm9                                                  \n"
+                " 000000D6  F2 44 0F 5C EC        subsd xmm13, xmm4                                                 \n"
+                " 000000DB  F2 0F 5C 48 10        subsd xmm1, qword ptr [rax + 16]                                  \n"
+                " 000000E0  F2 45 0F 5C 4C        subsd xmm9, qword ptr [r12 - 32]                                  \n"
+                "           24 E0                                                                                   \n"
+                " 000000E7  F2 41 0F 5C 9D        subsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 000000F0  F2 0F 51 C1           sqrtsd xmm0, xmm1                                                 \n"
+                " 000000F4  F2 45 0F 51 C7        sqrtsd xmm8, xmm15                                                \n"
+                " 000000F9  F2 41 0F 51 D1        sqrtsd xmm2, xmm9                                                 \n"
+                " 000000FE  F2 44 0F 51 EC        sqrtsd xmm13, xmm4                                                \n"
+                " 00000103  F2 0F 51 48 10        sqrtsd xmm1, qword ptr [rax + 16]                                 \n"
+                " 00000108  F2 45 0F 51 4C        sqrtsd xmm9, qword ptr [r12 - 32]                                 \n"
+                "           24 E0                                                                                   \n"
+                " 0000010F  F2 41 0F 51 9D        sqrtsd xmm3, qword ptr [r13 + 256]                                \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000118  66 0F 28 C1           movapd xmm0, xmm1                                                 \n"
+                " 0000011C  66 45 0F 28 C7        movapd xmm8, xmm15                                                \n"
+                " 00000121  66 41 0F 28 D1        movapd xmm2, xmm9                                                 \n"
+                " 00000126  66 44 0F 28 EC        movapd xmm13, xmm4                                                \n"
+                " 0000012B  F2 0F 10 48 04        movsd xmm1, qword ptr [rax + 4]                                   \n"
+                " 00000130  F2 0F 11 48 04        movsd qword ptr [rax + 4], xmm1                                   \n"
+                " 00000135  F2 45 0F 10 4C        movsd xmm9, qword ptr [r12 - 8]                                   \n"
+                "           24 F8                                                                                   \n"
+                " 0000013C  F2 45 0F 11 4C        movsd qword ptr [r12 - 8], xmm9                                   \n"
+                "           24 F8                                                                                   \n"
+                " 00000143  F2 41 0F 10 9D        movsd xmm3, qword ptr [r13 + 256]                                 \n"
+                "           00 01 00 00                                                                             \n"
+                " 0000014C  F2 41 0F 11 9D        movsd qword ptr [r13 + 256], xmm3                                 \n"
+                "           00 01 00 00                                                                             \n"
+                "                                                                                                   \n"
+                "                                ; WIDTH 2: packed SSE2                                             \n"
+                " 00000155  66 0F 58 C1           addpd xmm0, xmm1                                                  \n"
+                " 00000159  66 45 0F 58 C7        addpd xmm8, xmm15                                                 \n"
+                " 0000015E  66 41 0F 58 D1        addpd xmm2, xmm9                                                  \n"
+                " 00000163  66 44 0F 58 EC        addpd xmm13, xmm4                                                 \n"
+                " 00000168  66 0F 58 48 10        addpd xmm1, xmmword ptr [rax + 16]                                \n"
+                " 0000016D  66 45 0F 58 4C        addpd xmm9, xmmword ptr [r12 - 32]                                \n"
+                "           24 E0                                                                                   \n"
+                " 00000174  66 41 0F 58 9D        addpd xmm3, xmmword ptr [r13 + 256]                               \n"
+                "           00 01 00 00                                                                             \n"
+                " 0000017D  66 0F 5E C1           divpd xmm0, xmm1                                                  \n"
+                " 00000181  66 45 0F 5E C7        divpd xmm8, xmm15                                                 \n"
+                " 00000186  66 41 0F 5E D1        divpd xmm2, xmm9                                                  \n"
+                " 0000018B  66 44 0F 5E EC        divpd xmm13, xmm4                                                 \n"
+                " 00000190  66 0F 5E 48 10        divpd xmm1, xmmword ptr [rax + 16]                                \n"
+                " 00000195  66 45 0F 5E 4C        divpd xmm9, xmmword ptr [r12 - 32]                                \n"
+                "           24 E0                                                                                   \n"
+                " 0000019C  66 41 0F 5E 9D        divpd xmm3, xmmword ptr [r13 + 256]                               \n"
+                "           00 01 00 00                                                                             \n"
+                " 000001A5  66 0F 59 C1           mulpd xmm0, xmm1                                                  \n"
+                " 000001A9  66 45 0F 59 C7        mulpd xmm8, xmm15                                                 \n"
+                " 000001AE  66 41 0F 59 D1        mulpd xmm2, xmm9                                                  \n"
+                " 000001B3  66 44 0F 59 EC        mulpd xmm13, xmm4                                                 \n"
+                " 000001B8  66 0F 59 48 10        mulpd xmm1, xmmword ptr [rax + 16]                                \n"
+                " 000001BD  66 45 0F 59 4C        mulpd xmm9, xmmword ptr [r12 - 32]                                \n"
+                "           24 E0                                                                                   \n"
+                " 000001C4  66 41 0F 59 9D        mulpd xmm3, xmmword ptr [r13 + 256]                               \n"
+                "           00 01 00 00                                                                             \n"
+                " 000001CD  66 0F 5F C1           maxpd xmm0, xmm1                                                  \n"
+                " 000001D1  66 45 0F 5F C7        maxpd xmm8, xmm15                                                 \n"
+                " 000001D6  66 41 0F 5F D1        maxpd xmm2, xmm9                                                  \n"
+                " 000001DB  66 44 0F 5F EC        maxpd xmm13, xmm4                                                 \n"
+                " 000001E0  66 0F 5F 48 10        maxpd xmm1, xmmword ptr [rax + 16]                                \n"
+                " 000001E5  66 45 0F 5F 4C        maxpd xmm9, xmmword ptr [r12 - 32]                                \n"
+                "           24 E0                                                                                   \n"
+                " 000001EC  66 41 0F 5F 9D        maxpd xmm3, xmmword ptr [r13 + 256]                               \n"
+                "           00 01 00 00                                                                             \n"
+                " 000001F5  66 0F 5D C1           minpd xmm0, xmm1                                                  \n"
+                " 000001F9  66 45 0F 5D C7        minpd xmm8, xmm15                                                 \n"
+                " 000001FE  66 41 0F 5D D1        minpd xmm2, xmm9                                                  \n"
+                " 00000203  66 44 0F 5D EC        minpd xmm13, xmm4                                                 \n"
+                " 00000208  66 0F 5D 48 10        minpd xmm1, xmmword ptr [rax + 16]                                \n"
+                " 0000020D  66 45 0F 5D 4C        minpd xmm9, xmmword ptr [r12 - 32]                                \n"
+                "           24 E0                                                                                   \n"
+                " 00000214  66 41 0F 5D 9D        minpd xmm3, xmmword ptr [r13 + 256]                               \n"
+                "           00 01 00 00                                                                             \n"
+                " 0000021D  66 0F 5C C1           subpd xmm0, xmm1                                                  \n"
+                " 00000221  66 45 0F 5C C7        subpd xmm8, xmm15                                                 \n"
+                " 00000226  66 41 0F 5C D1        subpd xmm2, xmm9                                                  \n"
+                " 0000022B  66 44 0F 5C EC        subpd xmm13, xmm4                                                 \n"
+                " 00000230  66 0F 5C 48 10        subpd xmm1, xmmword ptr [rax + 16]                                \n"
+                " 00000235  66 45 0F 5C 4C        subpd xmm9, xmmword ptr [r12 - 32]                                \n"
+                "           24 E0                                                                                   \n"
+                " 0000023C  66 41 0F 5C 9D        subpd xmm3, xmmword ptr [r13 + 256]                               \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000245  66 0F 51 C1           sqrtpd xmm0, xmm1                                                 \n"
+                " 00000249  66 45 0F 51 C7        sqrtpd xmm8, xmm15                                                \n"
+                " 0000024E  66 41 0F 51 D1        sqrtpd xmm2, xmm9                                                 \n"
+                " 00000253  66 44 0F 51 EC        sqrtpd xmm13, xmm4                                                \n"
+                " 00000258  66 0F 51 48 10        sqrtpd xmm1, xmmword ptr [rax + 16]                               \n"
+                " 0000025D  66 45 0F 51 4C        sqrtpd xmm9, xmmword ptr [r12 - 32]                               \n"
+                "           24 E0                                                                                   \n"
+                " 00000264  66 41 0F 51 9D        sqrtpd xmm3, xmmword ptr [r13 + 256]                              \n"
+                "           00 01 00 00                                                                             \n"
+                " 0000026D  66 0F 28 C1           movapd xmm0, xmm1                                                 \n"
+                " 00000271  66 45 0F 28 C7        movapd xmm8, xmm15                                                \n"
+                " 00000276  66 41 0F 28 D1        movapd xmm2, xmm9                                                 \n"
+                " 0000027B  66 44 0F 28 EC        movapd xmm13, xmm4                                                \n"
+                " 00000280  66 0F 10 48 04        movupd xmm1, xmmword ptr [rax + 4]                                \n"
+                " 00000285  66 0F 11 48 04        movupd xmmword ptr [rax + 4], xmm1                                \n"
+                " 0000028A  66 45 0F 10 4C        movupd xmm9, xmmword ptr [r12 - 8]                                \n"
+                "           24 F8                                                                                   \n"
+                " 00000291  66 45 0F 11 4C        movupd xmmword ptr [r12 - 8], xmm9                                \n"
+                "           24 F8                                                                                   \n"
+                " 00000298  66 41 0F 10 9D        movupd xmm3, xmmword ptr [r13 + 256]                              \n"
+                "           00 01 00 00                                                                             \n"
+                " 000002A1  66 41 0F 11 9D        movupd xmmword ptr [r13 + 256], xmm3                              \n"
+                "           00 01 00 00                                                                             \n"
+                "                                                                                                   \n"
+                "                                ; WIDTH 4: VEX.256                                                 \n"
+                " 000002AA  C4 E1 7D 58 C1        vaddpd ymm0, ymm0, ymm1                                           \n"
+                " 000002AF  C4 41 3D 58 C7        vaddpd ymm8, ymm8, ymm15                                          \n"
+                " 000002B4  C4 C1 6D 58 D1        vaddpd ymm2, ymm2, ymm9                                           \n"
+                " 000002B9  C4 61 15 58 EC        vaddpd ymm13, ymm13, ymm4                                         \n"
+                " 000002BE  C4 E1 75 58 48        vaddpd ymm1, ymm1, ymmword ptr [rax + 16]                         \n"
+                "           10                                                                                      \n"
+                " 000002C4  C4 41 35 58 4C        vaddpd ymm9, ymm9, ymmword ptr [r12 - 32]                         \n"
+                "           24 E0                                                                                   \n"
+                " 000002CB  C4 C1 65 58 9D        vaddpd ymm3, ymm3, ymmword ptr [r13 + 256]                        \n"
+                "           00 01 00 00                                                                             \n"
+                " 000002D4  C4 E1 7D 5E C1        vdivpd ymm0, ymm0, ymm1                                           \n"
+                " 000002D9  C4 41 3D 5E C7        vdivpd ymm8, ymm8, ymm15                                          \n"
+                " 000002DE  C4 C1 6D 5E D1        vdivpd ymm2, ymm2, ymm9                                           \n"
+                " 000002E3  C4 61 15 5E EC        vdivpd ymm13, ymm13, ymm4                                         \n"
+                " 000002E8  C4 E1 75 5E 48        vdivpd ymm1, ymm1, ymmword ptr [rax + 16]                         \n"
+                "           10                                                                                      \n"
+                " 000002EE  C4 41 35 5E 4C        vdivpd ymm9, ymm9, ymmword ptr [r12 - 32]                         \n"
+                "           24 E0                                                                                   \n"
+                " 000002F5  C4 C1 65 5E 9D        vdivpd ymm3, ymm3, ymmword ptr [r13 + 256]                        \n"
+                "           00 01 00 00                                                                             \n"
+                " 000002FE  C4 E1 7D 59 C1        vmulpd ymm0, ymm0, ymm1                                           \n"
+                " 00000303  C4 41 3D 59 C7        vmulpd ymm8, ymm8, ymm15                                          \n"
+                " 00000308  C4 C1 6D 59 D1        vmulpd ymm2, ymm2, ymm9                                           \n"
+                " 0000030D  C4 61 15 59 EC        vmulpd ymm13, ymm13, ymm4                                         \n"
+                " 00000312  C4 E1 75 59 48        vmulpd ymm1, ymm1, ymmword ptr [rax + 16]                         \n"
+                "           10                                                                                      \n"
+                " 00000318  C4 41 35 59 4C        vmulpd ymm9, ymm9, ymmword ptr [r12 - 32]                         \n"
+                "           24 E0                                                                                   \n"
+                " 0000031F  C4 C1 65 59 9D        vmulpd ymm3, ymm3, ymmword ptr [r13 + 256]                        \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000328  C4 E1 7D 5F C1        vmaxpd ymm0, ymm0, ymm1                                           \n"
+                " 0000032D  C4 41 3D 5F C7        vmaxpd ymm8, ymm8, ymm15                                          \n"
+                " 00000332  C4 C1 6D 5F D1        vmaxpd ymm2, ymm2, ymm9                                           \n"
+                " 00000337  C4 61 15 5F EC        vmaxpd ymm13, ymm13, ymm4                                         \n"
+                " 0000033C  C4 E1 75 5F 48        vmaxpd ymm1, ymm1, ymmword ptr [rax + 16]                         \n"
+                "           10                                                                                      \n"
+                " 00000342  C4 41 35 5F 4C        vmaxpd ymm9, ymm9, ymmword ptr [r12 - 32]                         \n"
+                "           24 E0                                                                                   \n"
+                " 00000349  C4 C1 65 5F 9D        vmaxpd ymm3, ymm3, ymmword ptr [r13 + 256]                        \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000352  C4 E1 7D 5D C1        vminpd ymm0, ymm0, ymm1                                           \n"
+                " 00000357  C4 41 3D 5D C7        vminpd ymm8, ymm8, ymm15                                          \n"
+                " 0000035C  C4 C1 6D 5D D1        vminpd ymm2, ymm2, ymm9                                           \n"
+                " 00000361  C4 61 15 5D EC        vminpd ymm13, ymm13, ymm4                                         \n"
+                " 00000366  C4 E1 75 5D 48        vminpd ymm1, ymm1, ymmword ptr [rax + 16]                         \n"
+                "           10                                                                                      \n"
+                " 0000036C  C4 41 35 5D 4C        vminpd ymm9, ymm9, ymmword ptr [r12 - 32]                         \n"
+                "           24 E0                                                                                   \n"
+                " 00000373  C4 C1 65 5D 9D        vminpd ymm3, ymm3, ymmword ptr [r13 + 256]                        \n"
+                "           00 01 00 00                                                                             \n"
+                " 0000037C  C4 E1 7D 5C C1        vsubpd ymm0, ymm0, ymm1                                           \n"
+                " 00000381  C4 41 3D 5C C7        vsubpd ymm8, ymm8, ymm15                                          \n"
+                " 00000386  C4 C1 6D 5C D1        vsubpd ymm2, ymm2, ymm9                                           \n"
+                " 0000038B  C4 61 15 5C EC        vsubpd ymm13, ymm13, ymm4                                         \n"
+                " 00000390  C4 E1 75 5C 48        vsubpd ymm1, ymm1, ymmword ptr [rax + 16]                         \n"
+                "           10                                                                                      \n"
+                " 00000396  C4 41 35 5C 4C        vsubpd ymm9, ymm9, ymmword ptr [r12 - 32]                         \n"
+                "           24 E0                                                                                   \n"
+                " 0000039D  C4 C1 65 5C 9D        vsubpd ymm3, ymm3, ymmword ptr [r13 + 256]                        \n"
+                "           00 01 00 00                                                                             \n"
+                " 000003A6  C4 E1 7D 51 C1        vsqrtpd ymm0, ymm1                                                \n"
+                " 000003AB  C4 41 7D 51 C7        vsqrtpd ymm8, ymm15                                               \n"
+                " 000003B0  C4 C1 7D 51 D1        vsqrtpd ymm2, ymm9                                                \n"
+                " 000003B5  C4 61 7D 51 EC        vsqrtpd ymm13, ymm4                                               \n"
+                " 000003BA  C4 E1 7D 51 48        vsqrtpd ymm1, ymmword ptr [rax + 16]                              \n"
+                "           10                                                                                      \n"
+                " 000003C0  C4 41 7D 51 4C        vsqrtpd ymm9, ymmword ptr [r12 - 32]                              \n"
+                "           24 E0                                                                                   \n"
+                " 000003C7  C4 C1 7D 51 9D        vsqrtpd ymm3, ymmword ptr [r13 + 256]                             \n"
+                "           00 01 00 00                                                                             \n"
+                " 000003D0  C4 E1 7D 28 C1        vmovapd ymm0, ymm1                                                \n"
+                " 000003D5  C4 41 7D 28 C7        vmovapd ymm8, ymm15                                               \n"
+                " 000003DA  C4 C1 7D 28 D1        vmovapd ymm2, ymm9                                                \n"
+                " 000003DF  C4 61 7D 28 EC        vmovapd ymm13, ymm4                                               \n"
+                " 000003E4  C4 E1 7D 10 48        vmovupd ymm1, ymmword ptr [rax + 4]                               \n"
+                "           04                                                                                      \n"
+                " 000003EA  C4 E1 7D 11 48        vmovupd ymmword ptr [rax + 4], ymm1                               \n"
+                "           04                                                                                      \n"
+                " 000003F0  C4 41 7D 10 4C        vmovupd ymm9, ymmword ptr [r12 - 8]                               \n"
+                "           24 F8                                                                                   \n"
+                " 000003F7  C4 41 7D 11 4C        vmovupd ymmword ptr [r12 - 8], ymm9                               \n"
+                "           24 F8                                                                                   \n"
+                " 000003FE  C4 C1 7D 10 9D        vmovupd ymm3, ymmword ptr [r13 + 256]                             \n"
+                "           00 01 00 00                                                                             \n"
+                " 00000407  C4 C1 7D 11 9D        vmovupd ymmword ptr [r13 + 256], ymm3                             \n"
+                "           00 01 00 00                                                                             \n"
+                "                                                                                                   \n"
+                "                                ; Vfmadd231 on 2 and 4 lanes                                       \n"
+                " 00000410  C4 E2 F1 B8 C2        vfmadd231pd xmm0, xmm1, xmm2                                      \n"
+                " 00000415  C4 42 B1 B8 C7        vfmadd231pd xmm8, xmm9, xmm15                                     \n"
+                " 0000041A  C4 E2 99 B8 CB        vfmadd231pd xmm1, xmm12, xmm3                                     \n"
+                " 0000041F  C4 42 F9 B8 F2        vfmadd231pd xmm14, xmm0, xmm10                                    \n"
+                " 00000424  C4 E2 F5 B8 C2        vfmadd231pd ymm0, ymm1, ymm2                                      \n"
+                " 00000429  C4 42 B5 B8 C7        vfmadd231pd ymm8, ymm9, ymm15                                     \n"
+                " 0000042E  C4 E2 9D B8 CB        vfmadd231pd ymm1, ymm12, ymm3                                     \n"
+                " 00000433  C4 42 FD B8 F2        vfmadd231pd ymm14, ymm0, ymm10                                    \n"
+                "                                                                                                   \n"
+                "";
+
+
+            ML64Verifier v(ml64Output.c_str(), start);
+        }
+
+
         TEST_CASES_END
     }
 }
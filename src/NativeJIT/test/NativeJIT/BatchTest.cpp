@@ -0,0 +1,363 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <cmath>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include "NativeJIT/BatchCompiler.h"
+#include "NativeJIT/CodeGen/ExecutionBuffer.h"
+#include "NativeJIT/CodeGen/FunctionBuffer.h"
+#include "NativeJIT/Function.h"
+#include "TestSetup.h"
+
+
+namespace NativeJIT
+{
+    namespace BatchUnitTest
+    {
+        // Returns true if the CPU supports AVX2 and FMA3 and the OS preserves
+        // the YMM registers. Checked directly, since NativeJIT may have been
+        // built without cpu_features.
+        static bool IsAvx2Supported()
+        {
+            const unsigned c_fma = 1u << 12;
+            const unsigned c_osxsave = 1u << 27;
+            const unsigned c_avx2 = 1u << 5;
+            unsigned ecx1;
+            unsigned ebx7;
+
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+            {
+                return false;
+            }
+            __cpuid(info, 1);
+            ecx1 = static_cast<unsigned>(info[2]);
+            __cpuidex(info, 7, 0);
+            ebx7 = static_cast<unsigned>(info[1]);
+#else
+            unsigned eax, ebx, ecx, edx;
+            if (__get_cpuid_max(0, nullptr) < 7
+                || !__get_cpuid(1, &eax, &ebx, &ecx1, &edx))
+            {
+                return false;
+            }
+            __cpuid_count(7, 0, eax, ebx7, ecx, edx);
+#endif
+
+            if ((ecx1 & c_fma) == 0 || (ecx1 & c_osxsave) == 0 || (ebx7 & c_avx2) == 0)
+            {
+                return false;
+            }
+
+#ifdef _MSC_VER
+            const unsigned long long xcr0 = _xgetbv(0);
+#else
+            unsigned xcr0Low, xcr0High;
+            __asm__ ("xgetbv" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+            const unsigned long long xcr0 = xcr0Low;
+#endif
+
+            // Both the SSE and the AVX state must be enabled.
+            return (xcr0 & 6) == 6;
+        }
+
+
+        TEST_FIXTURE_START(Batch)
+
+        public:
+            Batch()
+                : TestFixture(16 * 1024, 256 * 1024, TestFixture::c_defaultDiagnosticsStream),
+                  m_batchAllocator(c_batchCodeCapacity),
+                  m_batchCode(m_batchAllocator, c_batchCodeCapacity)
+            {
+            }
+
+        protected:
+            static const unsigned c_batchCodeCapacity = 16 * 1024;
+
+            // The most points passed to a batch function, enough to exercise
+            // the main loop and the remainder for every instruction set.
+            static const unsigned c_maxPointCount = 11;
+
+            // Returns the instruction sets supported by the CPU.
+            static std::vector<BatchInstructionSet> GetInstructionSets()
+            {
+                std::vector<BatchInstructionSet> sets = { BatchInstructionSet::Scalar,
+                                                          BatchInstructionSet::SSE2 };
+
+                if (IsAvx2Supported())
+                {
+                    sets.push_back(BatchInstructionSet::AVX2);
+                }
+
+                return sets;
+            }
+
+
+            // Fills parameterCount arrays with positive values which differ
+            // between the points and the parameters.
+            static std::vector<std::vector<double>> GetInputs(unsigned parameterCount)
+            {
+                std::vector<std::vector<double>> inputs(parameterCount);
+
+                for (unsigned k = 0; k < parameterCount; ++k)
+                {
+                    for (unsigned i = 0; i < c_maxPointCount; ++i)
+                    {
+                        inputs[k].push_back(0.5 + 0.37 * i + 1.3 * k);
+                    }
+                }
+
+                return inputs;
+            }
+
+
+            // Calls the batch function for every point count up to
+            // c_maxPointCount and compares the results to the expected ones.
+            // Checks that the function doesn't write past the last point.
+            template <typename EXPECTED>
+            static void VerifyBatches(BatchCompiler::FunctionType batch,
+                                      unsigned parameterCount,
+                                      EXPECTED expected)
+            {
+                auto inputs = GetInputs(parameterCount);
+                std::vector<double const *> pointers;
+
+                for (auto const & input : inputs)
+                {
+                    pointers.push_back(input.data());
+                }
+
+                const double c_sentinel = -12345.0;
+
+                for (unsigned n = 0; n <= c_maxPointCount; ++n)
+                {
+                    std::vector<double> out(c_maxPointCount + 1, c_sentinel);
+
+                    batch(pointers.data(), out.data(), n);
+
+                    for (unsigned i = 0; i < n; ++i)
+                    {
+                        ASSERT_EQ(expected(inputs, i), out[i]) << "n = " << n << ", i = " << i;
+                    }
+
+                    for (unsigned i = n; i < out.size(); ++i)
+                    {
+                        ASSERT_EQ(c_sentinel, out[i]) << "n = " << n << ", i = " << i;
+                    }
+                }
+            }
+
+
+            ExecutionBuffer m_batchAllocator;
+            FunctionBuffer m_batchCode;
+
+        TEST_FIXTURE_END_TEST_CASES_BEGIN
+
+
+        TEST_F(Batch, Arithmetic)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & p1 = expression.GetP1();
+                auto & p2 = expression.GetP2();
+                auto & p3 = expression.GetP3();
+
+                // max(sqrt(p1 * p2 + 1.5) / (p3 - 0.25), min(p1, p3 - 0.25)) - 2.0 * 3.0
+                auto & shifted = expression.Sub(p3, expression.Immediate(0.25));
+                auto & root = expression.Sqrt(expression.Add(expression.Mul(p1, p2),
+                                                             expression.Immediate(1.5)));
+                auto & a = expression.Sub(expression.Max(expression.Div(root, shifted),
+                                                         expression.Min(p1, shifted)),
+                                          expression.Mul(expression.Immediate(2.0),
+                                                         expression.Immediate(3.0)));
+
+                ASSERT_TRUE(BatchCompiler(setup->GetAllocator(), m_batchCode).CanCompile(a));
+
+                // The batch function must give the same results as the scalar
+                // one, bit for bit.
+                auto function = expression.Compile(a);
+
+                for (auto instructionSet : GetInstructionSets())
+                {
+                    auto batch = expression.CompileBatch(a, m_batchCode, instructionSet);
+
+                    VerifyBatches(batch, 3, [function](std::vector<std::vector<double>> const & in, unsigned i)
+                    {
+                        return function(in[0][i], in[1][i], in[2][i]);
+                    });
+                }
+            }
+        }
+
+
+        TEST_F(Batch, Parameter)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                for (auto instructionSet : GetInstructionSets())
+                {
+                    auto batch = expression.CompileBatch(expression.GetP2(), m_batchCode, instructionSet);
+
+                    VerifyBatches(batch, 2, [](std::vector<std::vector<double>> const & in, unsigned i)
+                    {
+                        return in[1][i];
+                    });
+                }
+            }
+        }
+
+
+        TEST_F(Batch, MulAdd)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                // p1 * p2 + p3 followed by (p1 * p2 + p3) * p3 + p1.
+                auto & a = expression.MulAdd(expression.GetP1(), expression.GetP2(), expression.GetP3());
+                auto & b = expression.MulAdd(a, expression.GetP3(), expression.GetP1());
+
+                for (auto instructionSet : GetInstructionSets())
+                {
+                    auto batch = expression.CompileBatch(b, m_batchCode, instructionSet);
+
+                    if (instructionSet == BatchInstructionSet::AVX2)
+                    {
+                        VerifyBatches(batch, 3, [](std::vector<std::vector<double>> const & in, unsigned i)
+                        {
+                            return std::fma(std::fma(in[0][i], in[1][i], in[2][i]), in[2][i], in[0][i]);
+                        });
+                    }
+                    else
+                    {
+                        // Computed with two roundings without FMA3. Note that
+                        // volatile prevents the compiler from contracting the
+                        // expression into an FMA.
+                        VerifyBatches(batch, 3, [](std::vector<std::vector<double>> const & in, unsigned i)
+                        {
+                            volatile double product = in[0][i] * in[1][i];
+                            volatile double sum = product + in[2][i];
+                            volatile double product2 = sum * in[2][i];
+
+                            return product2 + in[0][i];
+                        });
+                    }
+                }
+            }
+        }
+
+
+        TEST_F(Batch, RegisterPressure)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & p1 = expression.GetP1();
+                auto & p2 = expression.GetP2();
+
+                // More shared values than there are registers, all live
+                // between the computation of the sum and of the maximum.
+                const unsigned c_valueCount = 24;
+                std::vector<Node<double>*> values;
+
+                for (unsigned i = 0; i < c_valueCount; ++i)
+                {
+                    auto & scaled = expression.Mul(p1, expression.Immediate(i + 1.0));
+                    values.push_back(&expression.Div(scaled, expression.Add(p2, expression.Immediate(0.5 * i))));
+                }
+
+                Node<double>* sum = values[0];
+                Node<double>* maximum = values[c_valueCount - 1];
+
+                for (unsigned i = 1; i < c_valueCount; ++i)
+                {
+                    sum = &expression.Add(*sum, *values[i]);
+                    maximum = &expression.Max(*maximum, *values[c_valueCount - 1 - i]);
+                }
+
+                auto & a = expression.Sub(*sum, *maximum);
+                auto function = expression.Compile(a);
+
+                for (auto instructionSet : GetInstructionSets())
+                {
+                    auto batch = expression.CompileBatch(a, m_batchCode, instructionSet);
+
+                    VerifyBatches(batch, 2, [function](std::vector<std::vector<double>> const & in, unsigned i)
+                    {
+                        return function(in[0][i], in[1][i]);
+                    });
+                }
+            }
+        }
+
+
+        TEST_F(Batch, Unsupported)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, int64_t> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & a = expression.Add(expression.Cast<double>(expression.GetP1()),
+                                          expression.Immediate(1.0));
+
+                BatchCompiler compiler(setup->GetAllocator(), m_batchCode);
+
+                ASSERT_FALSE(compiler.CanCompile(a));
+                ASSERT_ANY_THROW(compiler.Compile(a));
+            }
+        }
+
+
+        TEST_F(Batch, WidestInstructionSet)
+        {
+            auto instructionSet = BatchCompiler::GetWidestInstructionSet();
+
+            ASSERT_TRUE(instructionSet == BatchInstructionSet::SSE2
+                        || (instructionSet == BatchInstructionSet::AVX2 && IsAvx2Supported()));
+            ASSERT_EQ(4u, BatchCompiler::GetLaneCount(BatchInstructionSet::AVX2));
+        }
+
+        TEST_CASES_END
+    }
+}
@@ -0,0 +1,298 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2016, Microsoft
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+#include <direct.h>     // For _mkdir
+#else
+#include <sys/stat.h>
+#endif
+
+#include "NativeJIT/CodeCache.h"
+#include "NativeJIT/CodeGen/ExecutionBuffer.h"
+#include "NativeJIT/CodeGen/FunctionBuffer.h"
+#include "NativeJIT/Function.h"
+#include "TestSetup.h"
+
+
+namespace NativeJIT
+{
+    namespace CodeCacheUnitTest
+    {
+        TEST_FIXTURE_START(CodeCacheTest)
+
+        protected:
+            typedef double (*F)(double);
+
+            static double Triple(double x)
+            {
+                return 3.0 * x;
+            }
+
+
+            static double Increment(double x)
+            {
+                return x + 1.0;
+            }
+
+
+            static void const * Symbol(F f)
+            {
+                return reinterpret_cast<void const *>(f);
+            }
+
+
+            // Compiles Triple(p1 + 2.0) - Increment(p1).
+            static void Compile(Function<double, double>& expression, bool isRelocatable)
+            {
+                auto & triple = isRelocatable
+                    ? expression.Relocatable<F>(Triple)
+                    : expression.Immediate<F>(Triple);
+                auto & increment = expression.Relocatable<F>(Increment);
+
+                auto & sum = expression.Add(expression.GetP1(), expression.Immediate(2.0));
+                auto & a = expression.Call(triple, sum);
+                auto & b = expression.Call(increment, expression.GetP1());
+                expression.Compile(expression.Sub(a, b));
+            }
+
+
+            // Returns a directory which only the user can modify, as
+            // CodeCache requires.
+            static std::string GetDirectory()
+            {
+                const std::string directory = "CodeCacheTest.dir";
+
+#ifdef NATIVEJIT_PLATFORM_WINDOWS
+                _mkdir(directory.c_str());
+#else
+                mkdir(directory.c_str(), 0700);
+                chmod(directory.c_str(), 0700);
+#endif
+
+                return directory;
+            }
+
+
+            static std::vector<char> ReadFile(std::string const & name)
+            {
+                std::vector<char> contents;
+                FILE* file = std::fopen(name.c_str(), "rb");
+
+                if (file != nullptr)
+                {
+                    char buffer[256];
+                    size_t count;
+                    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+                    {
+                        contents.insert(contents.end(), buffer, buffer + count);
+                    }
+                    std::fclose(file);
+                }
+
+                return contents;
+            }
+
+
+            static void WriteFile(std::string const & name, std::vector<char> const & contents)
+            {
+                FILE* file = std::fopen(name.c_str(), "wb");
+
+                if (file != nullptr)
+                {
+                    std::fwrite(contents.data(), 1, contents.size(), file);
+                    std::fclose(file);
+                }
+            }
+
+        TEST_FIXTURE_END_TEST_CASES_BEGIN
+
+
+        TEST_F(CodeCacheTest, StoreAndLoad)
+        {
+            auto setup = GetSetup();
+            CodeCache cache(GetDirectory(), { Symbol(Triple), Symbol(Increment) });
+            const std::string key = "CodeCacheTest.StoreAndLoad";
+
+            {
+                Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+                Compile(expression, true);
+
+                ASSERT_TRUE(cache.Store(key, setup->GetCode()));
+            }
+
+            ExecutionBuffer codeAllocator(8192);
+            FunctionBuffer code(codeAllocator, 4096);
+
+            EXPECT_EQ(nullptr, cache.Load(key + ".other", code));
+
+            auto function = reinterpret_cast<F>(const_cast<void*>(cache.Load(key, code)));
+            ASSERT_NE(nullptr, function);
+            EXPECT_EQ(Triple(4.0 + 2.0) - Increment(4.0), function(4.0));
+            EXPECT_FALSE(code.IsRelocatable());
+
+            // The relocations are resolved against the symbols of the cache
+            // loading the code.
+            CodeCache swapped(GetDirectory(), { Symbol(Increment), Symbol(Triple) });
+            FunctionBuffer swappedCode(codeAllocator, 4096);
+
+            auto swappedFunction = reinterpret_cast<F>(const_cast<void*>(swapped.Load(key, swappedCode)));
+            ASSERT_NE(nullptr, swappedFunction);
+            EXPECT_EQ(Increment(4.0 + 2.0) - Triple(4.0), swappedFunction(4.0));
+
+            std::remove(cache.GetFileName(key).c_str());
+        }
+
+
+        TEST_F(CodeCacheTest, NotRelocatable)
+        {
+            auto setup = GetSetup();
+            CodeCache cache(GetDirectory(), { Symbol(Triple), Symbol(Increment) });
+            const std::string key = "CodeCacheTest.NotRelocatable";
+
+            {
+                Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+                Compile(expression, false);
+
+                EXPECT_FALSE(setup->GetCode().IsRelocatable());
+                EXPECT_FALSE(cache.Store(key, setup->GetCode()));
+            }
+
+            ExecutionBuffer codeAllocator(8192);
+            FunctionBuffer code(codeAllocator, 4096);
+            EXPECT_EQ(nullptr, cache.Load(key, code));
+        }
+
+
+        TEST_F(CodeCacheTest, UnknownSymbol)
+        {
+            auto setup = GetSetup();
+            CodeCache cache(GetDirectory(), { Symbol(Increment) });
+
+            Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+            Compile(expression, true);
+
+            EXPECT_TRUE(setup->GetCode().IsRelocatable());
+            EXPECT_EQ(2u, setup->GetCode().GetRelocations().size());
+            EXPECT_FALSE(cache.Store("CodeCacheTest.UnknownSymbol", setup->GetCode()));
+        }
+
+
+        TEST_F(CodeCacheTest, TruncatedEntry)
+        {
+            auto setup = GetSetup();
+            CodeCache cache(GetDirectory(), { Symbol(Triple), Symbol(Increment) });
+            const std::string key = "CodeCacheTest.TruncatedEntry";
+
+            {
+                Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+                Compile(expression, true);
+
+                ASSERT_TRUE(cache.Store(key, setup->GetCode()));
+            }
+
+            // Keep only the first half of the entry.
+            std::vector<char> contents = ReadFile(cache.GetFileName(key));
+            ASSERT_FALSE(contents.empty());
+            contents.resize(contents.size() / 2);
+            WriteFile(cache.GetFileName(key), contents);
+
+            ExecutionBuffer codeAllocator(8192);
+            FunctionBuffer code(codeAllocator, 4096);
+            EXPECT_EQ(nullptr, cache.Load(key, code));
+
+            std::remove(cache.GetFileName(key).c_str());
+        }
+
+        TEST_F(CodeCacheTest, CorruptedEntry)
+        {
+            auto setup = GetSetup();
+            CodeCache cache(GetDirectory(), { Symbol(Triple), Symbol(Increment) });
+            const std::string key = "CodeCacheTest.CorruptedEntry";
+
+            {
+                Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+                Compile(expression, true);
+
+                ASSERT_TRUE(cache.Store(key, setup->GetCode()));
+            }
+
+            // Change the last byte of the code.
+            std::vector<char> contents = ReadFile(cache.GetFileName(key));
+            ASSERT_FALSE(contents.empty());
+            contents.back() ^= 1;
+            WriteFile(cache.GetFileName(key), contents);
+
+            ExecutionBuffer codeAllocator(8192);
+            FunctionBuffer code(codeAllocator, 4096);
+            EXPECT_EQ(nullptr, cache.Load(key, code));
+
+            std::remove(cache.GetFileName(key).c_str());
+        }
+
+
+#ifndef NATIVEJIT_PLATFORM_WINDOWS
+        TEST_F(CodeCacheTest, WritableByOthers)
+        {
+            auto setup = GetSetup();
+            const std::string directory = GetDirectory();
+            CodeCache cache(directory, { Symbol(Triple), Symbol(Increment) });
+            const std::string key = "CodeCacheTest.WritableByOthers";
+
+            {
+                Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+                Compile(expression, true);
+
+                ASSERT_TRUE(cache.Store(key, setup->GetCode()));
+
+                // Nothing is stored in a directory others can write to.
+                chmod(directory.c_str(), 0777);
+                EXPECT_FALSE(cache.Store(key + ".other", setup->GetCode()));
+                chmod(directory.c_str(), 0700);
+            }
+
+            ExecutionBuffer codeAllocator(8192);
+            FunctionBuffer code(codeAllocator, 4096);
+
+            // Nor is anything loaded from it, or from a file others can
+            // write to.
+            chmod(directory.c_str(), 0777);
+            EXPECT_EQ(nullptr, cache.Load(key, code));
+            chmod(directory.c_str(), 0700);
+
+            chmod(cache.GetFileName(key).c_str(), 0666);
+            EXPECT_EQ(nullptr, cache.Load(key, code));
+
+            chmod(cache.GetFileName(key).c_str(), 0600);
+            EXPECT_NE(nullptr, cache.Load(key, code));
+
+            std::remove(cache.GetFileName(key).c_str());
+        }
+#endif
+
+        TEST_CASES_END
+    }
+}
@@ -21,7 +21,10 @@
 // THE SOFTWARE.
 
 
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 
 #include "NativeJIT/CodeGen/ExecutionBuffer.h"
 #include "NativeJIT/CodeGen/FunctionBuffer.h"
@@ -476,6 +479,163 @@ namespace NativeJIT
         }
 
 
+
+        TEST_F(ExpressionTree, CommonSubexpressionElimination)
+        {
+            auto setup = GetSetup();
+            ExpressionNodeFactory e(setup->GetAllocator(), setup->GetCode());
+
+            int32_t data[2];
+            auto & pointer = e.Immediate(&data[0]);
+
+            ASSERT_NE(&e.Immediate(3.0), &e.Immediate(3.0));
+            ASSERT_NE(&e.Deref(pointer, 1), &e.Deref(pointer, 1));
+
+            e.EnableCommonSubexpressionElimination();
+
+            // Same operations on the same children share the node, in either
+            // order only for the commutative operations.
+            auto & a = e.Deref(pointer, 0);
+            auto & b = e.Deref(pointer, 1);
+
+            ASSERT_EQ(&a, &e.Deref(pointer, 0));
+            ASSERT_NE(&a, &b);
+            ASSERT_EQ(&e.Add(a, b), &e.Add(b, a));
+            ASSERT_EQ(&e.Sub(a, b), &e.Sub(a, b));
+            ASSERT_NE(&e.Sub(a, b), &e.Sub(b, a));
+            ASSERT_EQ(&e.Shl(a, 3), &e.Shl(a, 3));
+            ASSERT_NE(&e.Shl(a, 3), &e.Shl(a, 4));
+            ASSERT_EQ(&e.Cast<int64_t>(a), &e.Cast<int64_t>(a));
+            ASSERT_EQ(&e.Immediate(3.0), &e.Immediate(3.0));
+            ASSERT_NE(&e.Immediate(0.0), &e.Immediate(-0.0));
+            ASSERT_NE(static_cast<NodeBase*>(&e.Immediate(1)),
+                      static_cast<NodeBase*>(&e.Immediate(1u)));
+
+            e.DisableCommonSubexpressionElimination();
+
+            ASSERT_NE(&e.Add(a, b), &e.Add(a, b));
+        }
+
+
+        // Builds p1 * p2 + (p2 * p1 + 3.0) * (p1 * p2), which has three
+        // identical products when the operands of commutative operations are
+        // matched in either order.
+        static Node<double>& BuildRepeatedProducts(Function<double, double, double>& e)
+        {
+            auto & product1 = e.Mul(e.GetP1(), e.GetP2());
+            auto & product2 = e.Mul(e.GetP2(), e.GetP1());
+            auto & product3 = e.Mul(e.GetP1(), e.GetP2());
+            auto & sum = e.Add(product2, e.Immediate(3.0));
+
+            return e.Add(product1, e.Mul(sum, product3));
+        }
+
+
+        TEST_F(ExpressionTree, CommonSubexpressionEliminationCodeSize)
+        {
+            auto setup = GetSetup();
+
+            const double p1 = 1.5;
+            const double p2 = -4.0;
+            const double expected = p1 * p2 + (p2 * p1 + 3.0) * (p1 * p2);
+            unsigned plainCodeSize;
+
+            {
+                Function<double, double, double> e(setup->GetAllocator(), setup->GetCode());
+
+                auto function = e.Compile(BuildRepeatedProducts(e));
+                plainCodeSize = setup->GetCode().CurrentPosition();
+
+                ASSERT_EQ(function(p1, p2), expected);
+            }
+
+            {
+                Function<double, double, double> e(setup->GetAllocator(), setup->GetCode());
+                e.EnableCommonSubexpressionElimination();
+
+                auto function = e.Compile(BuildRepeatedProducts(e));
+
+                ASSERT_EQ(function(p1, p2), expected);
+                ASSERT_LT(setup->GetCode().CurrentPosition(), plainCodeSize);
+            }
+        }
+
+
+        TEST_F(ExpressionTree, ConstantFoldingFloat)
+        {
+            auto setup = GetSetup();
+            Function<double, double> e(setup->GetAllocator(), setup->GetCode());
+
+            // p1 + sqrt(2.0 * 8.0) / (1.0 - 5.0), folded to p1 + -1.0.
+            auto & product = e.Mul(e.Immediate(2.0), e.Immediate(8.0));
+            auto & quotient = e.Div(e.Sqrt(product), e.Sub(e.Immediate(1.0), e.Immediate(5.0)));
+            auto & sum = e.Add(e.GetP1(), quotient);
+            auto function = e.Compile(sum);
+
+            double value;
+            ASSERT_TRUE(product.GetConstantValue(value));
+            ASSERT_EQ(value, 16.0);
+            ASSERT_TRUE(quotient.GetConstantValue(value));
+            ASSERT_EQ(value, -1.0);
+            ASSERT_FALSE(sum.GetConstantValue(value));
+
+            ASSERT_EQ(function(0.5), -0.5);
+        }
+
+
+        // Folded Min() and Max() must return the same values as MinSD and
+        // MaxSD for signed zeros and NaNs.
+        TEST_F(ExpressionTree, ConstantFoldingMinMax)
+        {
+            auto setup = GetSetup();
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+
+            {
+                Function<double> e(setup->GetAllocator(), setup->GetCode());
+
+                auto & min = e.Min(e.Immediate(0.0), e.Immediate(-0.0));
+                auto & max = e.Max(e.Immediate(nan), e.Immediate(2.0));
+                auto function = e.Compile(e.Add(min, max));
+
+                ASSERT_EQ(function(), 2.0);
+            }
+
+            {
+                Function<double> e(setup->GetAllocator(), setup->GetCode());
+
+                auto function = e.Compile(e.Min(e.Immediate(0.0), e.Immediate(-0.0)));
+
+                ASSERT_TRUE(std::signbit(function()));
+            }
+
+            {
+                Function<double> e(setup->GetAllocator(), setup->GetCode());
+
+                auto function = e.Compile(e.Max(e.Immediate(2.0), e.Immediate(nan)));
+
+                ASSERT_TRUE(std::isnan(function()));
+            }
+        }
+
+
+        TEST_F(ExpressionTree, ConstantFoldingInteger)
+        {
+            auto setup = GetSetup();
+            Function<int32_t, int32_t> e(setup->GetAllocator(), setup->GetCode());
+
+            // Overflow wraps around as in the generated code.
+            auto & product = e.Mul(e.Immediate((std::numeric_limits<int32_t>::max)()),
+                                   e.Immediate(2));
+            auto & masked = e.And(e.Or(product, e.Immediate(1)), e.Immediate(-256));
+            auto function = e.Compile(e.Sub(masked, e.GetP1()));
+
+            int32_t value;
+            ASSERT_TRUE(masked.GetConstantValue(value));
+            ASSERT_EQ(value, -256);
+
+            ASSERT_EQ(function(4), -260);
+        }
+
         TEST_CASES_END
     }
 }
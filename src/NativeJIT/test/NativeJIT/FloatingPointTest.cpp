@@ -22,14 +22,37 @@
 
 
 
+#include <cmath>
+#include <limits>
+
 #include "NativeJIT/Function.h"
 #include "TestSetup.h"
 
+#ifdef NATIVEJIT_WITH_CPU_FEATURES
+#include "cpuinfo_x86.h"
+#endif
+
 
 namespace NativeJIT
 {
     namespace FloatingPointUnitTest
     {
+        // Returns true if the CPU supports FMA3 and the OS preserves the
+        // AVX register state, i.e. if VEX-encoded FMA instructions can run.
+        // The FMA3 tests are skipped when NativeJIT is built without
+        // cpu_features.
+        static bool IsFma3Supported()
+        {
+#ifdef NATIVEJIT_WITH_CPU_FEATURES
+            // GetX86Info() reports FMA3 only if the operating system
+            // preserves the YMM registers.
+            return cpu_features::GetX86Info().features.fma3 != 0;
+#else
+            return false;
+#endif
+        }
+
+
         TEST_FIXTURE_START(FloatingPoint)
         TEST_FIXTURE_END_TEST_CASES_BEGIN
 
@@ -165,6 +188,234 @@ namespace NativeJIT
             }
         }
 
+
+        TEST_F(FloatingPoint, DivDouble)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & a = expression.Div(expression.GetP1(), expression.GetP2());
+                auto function = expression.Compile(a);
+
+                double p1 = 12340000.0;
+                double p2 = 5678.0;
+
+                auto expected = p1 / p2;
+                auto observed = function(p1, p2);
+
+                ASSERT_EQ(observed, expected);
+            }
+        }
+
+
+        TEST_F(FloatingPoint, DivFloat)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<float, float, float> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & a = expression.Div(expression.GetP2(), expression.GetP1());
+                auto function = expression.Compile(a);
+
+                float p1 = 3.0f;
+                float p2 = 1.0f;
+
+                auto expected = p2 / p1;
+                auto observed = function(p1, p2);
+
+                ASSERT_EQ(observed, expected);
+            }
+        }
+
+
+        TEST_F(FloatingPoint, DivImmediateDouble)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                double immediate = 0.125;
+                auto & a = expression.Immediate(immediate);
+                auto & b = expression.Div(expression.GetP1(), a);
+                auto function = expression.Compile(b);
+
+                double p1 = 1234.5;
+
+                auto expected = p1 / immediate;
+                auto observed = function(p1);
+
+                ASSERT_EQ(observed, expected);
+            }
+        }
+
+
+        TEST_F(FloatingPoint, MinMaxDouble)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                // max(p1, p2) - min(p1, p2).
+                auto & max = expression.Max(expression.GetP1(), expression.GetP2());
+                auto & min = expression.Min(expression.GetP1(), expression.GetP2());
+                auto & a = expression.Sub(max, min);
+                auto function = expression.Compile(a);
+
+                ASSERT_EQ(function(1.5, -2.0), 3.5);
+                ASSERT_EQ(function(-2.0, 1.5), 3.5);
+                ASSERT_EQ(function(7.0, 7.0), 0.0);
+            }
+        }
+
+
+        TEST_F(FloatingPoint, MinMaxNaNFloat)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<float, float, float> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & a = expression.Min(expression.GetP1(), expression.GetP2());
+                auto function = expression.Compile(a);
+
+                const float nan = std::numeric_limits<float>::quiet_NaN();
+
+                // With a NaN operand, the right operand is returned.
+                ASSERT_EQ(function(nan, 2.0f), 2.0f);
+                ASSERT_TRUE(std::isnan(function(2.0f, nan)));
+                ASSERT_EQ(function(2.0f, -2.0f), -2.0f);
+            }
+        }
+
+
+        TEST_F(FloatingPoint, SqrtDouble)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & a = expression.Sqrt(expression.GetP1());
+                auto function = expression.Compile(a);
+
+                double p1 = 1234.5678;
+
+                auto expected = std::sqrt(p1);
+                auto observed = function(p1);
+
+                ASSERT_EQ(observed, expected);
+                ASSERT_TRUE(std::isnan(function(-1.0)));
+            }
+        }
+
+
+        TEST_F(FloatingPoint, SqrtFloat)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<float, float> expression(setup->GetAllocator(), setup->GetCode());
+
+                // sqrt(p1) + sqrt(p1), with a shared operand.
+                auto & a = expression.Sqrt(expression.GetP1());
+                auto & b = expression.Add(a, a);
+                auto function = expression.Compile(b);
+
+                float p1 = 2.0f;
+
+                auto expected = std::sqrt(p1) + std::sqrt(p1);
+                auto observed = function(p1);
+
+                ASSERT_EQ(observed, expected);
+            }
+        }
+
+
+        TEST_F(FloatingPoint, SqrtImmediateDouble)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double> expression(setup->GetAllocator(), setup->GetCode());
+
+                double immediate = 2.0;
+                auto & a = expression.Immediate(immediate);
+                auto & b = expression.Sqrt(a);
+                auto function = expression.Compile(b);
+
+                auto expected = std::sqrt(immediate);
+                auto observed = function();
+
+                ASSERT_EQ(observed, expected);
+            }
+        }
+
+
+        TEST_F(FloatingPoint, MulAddDouble)
+        {
+            if (!IsFma3Supported())
+            {
+                return;
+            }
+
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, double, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & a = expression.MulAdd(expression.GetP1(),
+                                             expression.GetP2(),
+                                             expression.GetP3());
+                auto function = expression.Compile(a);
+
+                // Chosen so that the result differs from the one computed with
+                // two roundings.
+                double p1 = 1.0 + std::ldexp(1.0, -30);
+                double p2 = 1.0 - std::ldexp(1.0, -30);
+                double p3 = -1.0;
+
+                auto expected = std::fma(p1, p2, p3);
+                auto observed = function(p1, p2, p3);
+
+                ASSERT_EQ(observed, expected);
+                ASSERT_EQ(observed, -std::ldexp(1.0, -60));
+            }
+        }
+
+
+        TEST_F(FloatingPoint, MulAddSharedFloat)
+        {
+            if (!IsFma3Supported())
+            {
+                return;
+            }
+
+            auto setup = GetSetup();
+
+            {
+                Function<float, float, float> expression(setup->GetAllocator(), setup->GetCode());
+
+                // p1 * p1 + p1 followed by (p1 * p1 + p1) * p2 + p2.
+                auto & p1 = expression.GetP1();
+                auto & a = expression.MulAdd(p1, p1, p1);
+                auto & b = expression.MulAdd(a, expression.GetP2(), expression.GetP2());
+                auto function = expression.Compile(b);
+
+                float x = 3.0f;
+                float y = 0.5f;
+
+                auto expected = std::fma(std::fma(x, x, x), y, y);
+                auto observed = function(x, y);
+
+                ASSERT_EQ(observed, expected);
+            }
+        }
+
         TEST_CASES_END
     }
 }
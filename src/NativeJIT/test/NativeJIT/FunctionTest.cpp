@@ -23,6 +23,7 @@
 
 #include <cmath>        // For float std::abs(float).
 #include <iostream>
+#include <vector>
 
 #include "NativeJIT/CodeGen/ExecutionBuffer.h"
 #include "NativeJIT/CodeGen/FunctionBuffer.h"
@@ -108,6 +109,26 @@ namespace NativeJIT
             }
 
 
+            static double SampleFunctionMixed4(double p1, int p2, double p3, int64_t p4)
+            {
+                ++s_sampleFunctionCalls;
+                return p1 + 10 * p2 + 100 * p3 + 1000 * p4;
+            }
+
+
+            static double SampleFunctionMixed6(int64_t p1, double p2, int p3, double p4, int64_t p5, double p6)
+            {
+                ++s_sampleFunctionCalls;
+                return p1 + 10 * p2 + 100 * p3 + 1000 * p4 + 10000 * p5 + 100000 * p6;
+            }
+
+
+            static double SampleFunctionFloat6(double p1, double p2, double p3, double p4, double p5, double p6)
+            {
+                return p1 - 10 * p2 + 100 * p3 - 1000 * p4 + 10000 * p5 - 100000 * p6;
+            }
+
+
             // These helper functions are used to overwrite the EAX/XMM0s
             // registers with a specific value, different than some special value
             // that other functions return.
@@ -599,6 +620,152 @@ namespace NativeJIT
         }
 
 
+        // On System V, integer and floating point parameters are assigned to
+        // registers independently, so the parameters of a call with mixed
+        // types need to be staged into different registers than on Windows.
+        TEST_F(FunctionTest, CallMixedParameters)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, int64_t, double, int, double> expression(setup->GetAllocator(), setup->GetCode());
+
+                typedef double (*F)(double, int, double, int64_t);
+                auto & sampleFunction = expression.Immediate<F>(SampleFunctionMixed4);
+                auto & a = expression.Call(sampleFunction,
+                                           expression.GetP4(),
+                                           expression.GetP3(),
+                                           expression.GetP2(),
+                                           expression.GetP1());
+                auto function = expression.Compile(a);
+
+                auto expected = SampleFunctionMixed4(1.0, 2, 3.0, 4);
+
+                s_sampleFunctionCalls = 0;
+                auto observed = function(4, 3.0, 2, 1.0);
+
+                EXPECT_EQ(expected, observed);
+                EXPECT_EQ(1, s_sampleFunctionCalls);
+            }
+        }
+
+
+        // Models with many state variables are passed as a single state vector
+        // whose elements are loaded with indexed memory operands.
+        TEST_F(FunctionTest, StateVector)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double*> expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & state = expression.GetP1();
+                auto & a = expression.Mul(expression.Deref(state, 0), expression.Deref(state, 7));
+                auto & b = expression.Sub(expression.Deref(state, 1000), expression.Deref(state, 3));
+                auto & c = expression.Add(a, b);
+                auto function = expression.Compile(c);
+
+                std::vector<double> values(1001);
+                for (unsigned i = 0; i < values.size(); ++i)
+                {
+                    values[i] = 0.5 * i + 1.0;
+                }
+
+                auto expected = values[0] * values[7] + (values[1000] - values[3]);
+                auto observed = function(values.data());
+
+                EXPECT_EQ(expected, observed);
+            }
+        }
+
+
+#ifndef NATIVEJIT_PLATFORM_WINDOWS
+        //
+        // The System V ABI passes up to six integer and up to eight floating
+        // point parameters in registers.
+        //
+
+        TEST_F(FunctionTest, FunctionSixIntegerParameters)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<int64_t, int64_t, int64_t, int64_t, int, int64_t, int64_t>
+                    expression(setup->GetAllocator(), setup->GetCode());
+
+                auto & a = expression.Sub(expression.GetP1(), expression.GetP2());
+                auto & b = expression.Mul(expression.GetP3(), expression.Cast<int64_t>(expression.GetP4()));
+                auto & c = expression.Sub(expression.GetP5(), expression.GetP6());
+                auto & d = expression.Add(expression.Add(a, b), c);
+                auto function = expression.Compile(d);
+
+                auto observed = function(100, 1, 7, -3, 50, 60);
+
+                EXPECT_EQ((100 - 1) + 7 * -3 + (50 - 60), observed);
+            }
+        }
+
+
+        TEST_F(FunctionTest, CallSixMixedParameters)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double, int64_t, double, int, double, int64_t>
+                    expression(setup->GetAllocator(), setup->GetCode());
+
+                typedef double (*F)(int64_t, double, int, double, int64_t, double);
+                auto & sampleFunction = expression.Immediate<F>(SampleFunctionMixed6);
+                auto & a = expression.Call(sampleFunction,
+                                           expression.GetP6(),
+                                           expression.GetP5(),
+                                           expression.GetP4(),
+                                           expression.GetP3(),
+                                           expression.GetP2(),
+                                           expression.GetP1());
+
+                // Add a value that has to be preserved across the call.
+                auto & b = expression.Add(a, expression.Mul(expression.GetP1(), expression.GetP3()));
+                auto function = expression.Compile(b);
+
+                auto expected = SampleFunctionMixed6(1, 2.0, 3, 4.0, 5, 6.0) + 6.0 * 4.0;
+
+                s_sampleFunctionCalls = 0;
+                auto observed = function(6.0, 5, 4.0, 3, 2.0, 1);
+
+                EXPECT_EQ(expected, observed);
+                EXPECT_EQ(1, s_sampleFunctionCalls);
+            }
+        }
+
+
+        TEST_F(FunctionTest, CallSixFloatingPointParameters)
+        {
+            auto setup = GetSetup();
+
+            {
+                Function<double, double*> expression(setup->GetAllocator(), setup->GetCode());
+
+                typedef double (*F)(double, double, double, double, double, double);
+                auto & state = expression.GetP1();
+                auto & a = expression.Call(expression.Immediate<F>(SampleFunctionFloat6),
+                                           expression.Deref(state, 0),
+                                           expression.Deref(state, 1),
+                                           expression.Deref(state, 2),
+                                           expression.Deref(state, 3),
+                                           expression.Deref(state, 4),
+                                           expression.Deref(state, 5));
+                auto function = expression.Compile(a);
+
+                double values[] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+                auto expected = SampleFunctionFloat6(1.0, 2.0, 3.0, 4.0, 5.0, 6.0);
+
+                EXPECT_EQ(expected, function(values));
+            }
+        }
+#endif
+
+
         // Verifies that the references to stack variables are in a sane
         // memory range.
         // The *Internal method is needed because GTest requires a void method
@@ -0,0 +1,201 @@
+/* GFLOP/s benchmark of dgetrf_batched and dgetrs_batched, comparing them
+   with a loop calling dgetrf_ and dgetrs_ for every matrix of the batch.
+   Large batches run on the number of threads set with
+   CLAPACK_NUM_THREADS, which also applies to the calls in the loop.
+
+   usage: xbatchbenchd [n batch ...]
+
+   For every order n the program factors a batch of n x n matrices and
+   solves one right hand side with each, in the strided layout with the
+   loop and with the batched routines and in the interleaved layout with
+   the batched routines.  It prints the rate of each and the speedup of
+   the batched routines over the loop.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "clapack.h"
+#include "blas_kernels.h"
+#include "lapack_batched.h"
+
+/* Every measurement is repeated until it took at least this long. */
+#define BENCH_MIN_SECONDS 0.2
+
+/* The batch size if none is given, smaller batches are used for the
+   larger orders so that the matrices fit into about 8 MB. */
+#define BENCH_BATCH 10000
+
+/* The ways the batch is factored and solved. */
+#define BENCH_LOOP 0
+#define BENCH_STRIDED 1
+#define BENCH_INTERLEAVED 2
+
+static double bench_wall_time(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, count;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+static void bench_fill(doublereal *v, integer n)
+{
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+	v[i__] = (doublereal) rand() / RAND_MAX - .5;
+    }
+}
+
+/* Factors (solve == 0) or solves the batch in the given way until
+   BENCH_MIN_SECONDS have passed and returns the GFLOP/s.  The matrices
+   are copied from a, and the right hand sides from b, before every
+   repetition, the copy is not timed. */
+static double bench_run(int how, int solve, integer n, integer batch,
+	const doublereal *a, const doublereal *b, doublereal *lu,
+	doublereal *x, integer *ipiv, integer *info)
+{
+    integer k, one = 1, len;
+    double start, seconds = 0., flops;
+    long calls = 0;
+
+/*     The solves start from the factors of one factorisation. */
+
+    len = n * n * batch;
+    if (solve) {
+	memcpy(lu, a, len * sizeof(doublereal));
+	if (how == BENCH_LOOP) {
+	    for (k = 0; k < batch; ++k) {
+		dgetrf_(&n, &n, lu + k * n * n, &n, ipiv + k * n, info +
+			k);
+	    }
+	} else {
+	    dgetrf_batched(how == BENCH_STRIDED ? LAPACK_BATCH_STRIDED :
+		    LAPACK_BATCH_INTERLEAVED, n, lu, n, n * n, ipiv, info,
+		    batch);
+	}
+    }
+    flops = solve ? 2. * n * n * batch : 2. / 3. * n * n * n * batch;
+
+    do {
+	if (solve) {
+	    memcpy(x, b, n * batch * sizeof(doublereal));
+	} else {
+	    memcpy(lu, a, len * sizeof(doublereal));
+	}
+
+	start = bench_wall_time();
+	if (how == BENCH_LOOP) {
+	    for (k = 0; k < batch; ++k) {
+		if (solve) {
+		    dgetrs_("N", &n, &one, lu + k * n * n, &n, ipiv + k * n,
+			    x + k * n, &n, info + k);
+		} else {
+		    dgetrf_(&n, &n, lu + k * n * n, &n, ipiv + k * n, info +
+			    k);
+		}
+	    }
+	} else if (solve) {
+	    dgetrs_batched(how == BENCH_STRIDED ? LAPACK_BATCH_STRIDED :
+		    LAPACK_BATCH_INTERLEAVED, "N", n, one, lu, n, n * n, ipiv,
+		    x, n, n, batch);
+	} else {
+	    dgetrf_batched(how == BENCH_STRIDED ? LAPACK_BATCH_STRIDED :
+		    LAPACK_BATCH_INTERLEAVED, n, lu, n, n * n, ipiv, info,
+		    batch);
+	}
+	seconds += bench_wall_time() - start;
+	++calls;
+    } while (seconds < BENCH_MIN_SECONDS);
+
+    return flops * calls / seconds * 1e-9;
+}
+
+static void bench_size(integer n, integer batch)
+{
+    const char *names[2] = { "dgetrf", "dgetrs" };
+    doublereal *a, *b, *lu, *x;
+    integer *ipiv, *info;
+    double gloop, gstrided, ginterleaved;
+    int solve;
+
+    if (batch <= 0) {
+	batch = min(BENCH_BATCH, 1048576 / (n * n));
+	batch = max(batch, 1);
+    }
+
+    a = (doublereal *) malloc(n * n * batch * sizeof(doublereal));
+    lu = (doublereal *) malloc(n * n * batch * sizeof(doublereal));
+    b = (doublereal *) malloc(n * batch * sizeof(doublereal));
+    x = (doublereal *) malloc(n * batch * sizeof(doublereal));
+    ipiv = (integer *) malloc(n * batch * sizeof(integer));
+    info = (integer *) malloc(batch * sizeof(integer));
+    if (a == NULL || lu == NULL || b == NULL || x == NULL || ipiv == NULL ||
+	    info == NULL) {
+	fprintf(stderr, "out of memory for n = %ld\n", (long) n);
+	exit(1);
+    }
+    bench_fill(a, n * n * batch);
+    bench_fill(b, n * batch);
+
+    for (solve = 0; solve < 2; ++solve) {
+	gloop = bench_run(BENCH_LOOP, solve, n, batch, a, b, lu, x, ipiv,
+		info);
+	gstrided = bench_run(BENCH_STRIDED, solve, n, batch, a, b, lu, x,
+		ipiv, info);
+	ginterleaved = bench_run(BENCH_INTERLEAVED, solve, n, batch, a, b,
+		lu, x, ipiv, info);
+	printf("%-8s %6ld %8ld %10.3f %10.3f %8.2fx %12.3f %8.2fx\n",
+		names[solve], (long) n, (long) batch, gloop, gstrided,
+		gstrided / gloop, ginterleaved, ginterleaved / gloop);
+    }
+
+    free(a);
+    free(lu);
+    free(b);
+    free(x);
+    free(ipiv);
+    free(info);
+}
+
+int main(int argc, char **argv)
+{
+    static const integer sizes[] = { 2, 3, 4, 5, 6, 8, 12, 16, 32, 64,
+	    100 };
+    int i__;
+
+    printf("kernel: %s, threads: %d\n", blas_kernel_name(blas_get_kernel()),
+	    blas_get_num_threads());
+    printf("%-8s %6s %8s %10s %10s %9s %12s %9s\n", "routine", "n", "batch",
+	    "loop", "strided", "speedup", "interleaved", "speedup");
+
+    if (argc > 1) {
+	for (i__ = 1; i__ < argc; i__ += 2) {
+	    bench_size(atol(argv[i__]), i__ + 1 < argc ? atol(argv[i__ + 1])
+		    : 0);
+	}
+    } else {
+	for (i__ = 0; i__ < (int) (sizeof(sizes) / sizeof(sizes[0])); ++i__) {
+	    bench_size(sizes[i__], 0);
+	}
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+/* GFLOP/s benchmark of the blocked LU and QR factorisations dgetrf_ and
+   dgeqrf_, comparing them with the unblocked dgetf2_ and dgeqr2_.  The
+   blocked routines use the block sizes of ilaenv_ and run on the number
+   of threads set with CLAPACK_NUM_THREADS, the unblocked routines always
+   run on one thread.
+
+   usage: xfactbenchd [size ...]
+
+   For every size n the program factors an n x n matrix and prints the
+   rate of each routine, the speedup and the largest difference between
+   the factors relative to the largest element of the unblocked factors.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "clapack.h"
+#include "blas_kernels.h"
+
+/* Every measurement is repeated until it took at least this long. */
+#define BENCH_MIN_SECONDS 0.2
+
+static double bench_wall_time(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, count;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+static void bench_fill(doublereal *v, integer n)
+{
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+	v[i__] = (doublereal) rand() / RAND_MAX - .5;
+    }
+}
+
+static double bench_difference(const doublereal *ref, const doublereal *v,
+	integer n)
+{
+    integer i__;
+    double diff = 0., scale = 0.;
+
+    for (i__ = 0; i__ < n; ++i__) {
+	if (fabs(ref[i__] - v[i__]) > diff) {
+	    diff = fabs(ref[i__] - v[i__]);
+	}
+	if (fabs(ref[i__]) > scale) {
+	    scale = fabs(ref[i__]);
+	}
+    }
+    return scale > 0. ? diff / scale : diff;
+}
+
+/* Factors a with the LU (qr == 0) or QR factorisation, blocked or not,
+   until BENCH_MIN_SECONDS have passed and returns the GFLOP/s.  The
+   matrix is copied from a before every repetition, the copy is not
+   timed.  The factors are left in out. */
+static double bench_run(int qr, int blocked, int threads, integer n,
+	const doublereal *a, doublereal *out, doublereal *work, integer lwork,
+	integer *ipiv)
+{
+    integer info;
+    double start, seconds = 0., flops;
+    long calls = 0;
+
+    blas_set_num_threads(blocked ? threads : 1);
+    flops = qr ? 4. / 3. * n * n * n : 2. / 3. * n * n * n;
+
+    do {
+	memcpy(out, a, n * n * sizeof(doublereal));
+	start = bench_wall_time();
+	if (qr && blocked) {
+	    dgeqrf_(&n, &n, out, &n, work, work + n, &lwork, &info);
+	} else if (qr) {
+	    dgeqr2_(&n, &n, out, &n, work, work + n, &info);
+	} else if (blocked) {
+	    dgetrf_(&n, &n, out, &n, ipiv, &info);
+	} else {
+	    dgetf2_(&n, &n, out, &n, ipiv, &info);
+	}
+	seconds += bench_wall_time() - start;
+	++calls;
+    } while (seconds < BENCH_MIN_SECONDS);
+
+    return flops * calls / seconds * 1e-9;
+}
+
+static void bench_size(integer n, int threads)
+{
+    static integer c__1 = 1, c_n1 = -1;
+    const char *names[2] = { "dgetrf", "dgeqrf" };
+    doublereal *a, *ref, *opt, *work;
+    integer *ipiv, lwork;
+    double gref, gopt;
+    int qr;
+
+    lwork = n * ilaenv_(&c__1, "DGEQRF", " ", &n, &n, &c_n1, &c_n1);
+    a = (doublereal *) malloc(n * n * sizeof(doublereal));
+    ref = (doublereal *) malloc(n * n * sizeof(doublereal));
+    opt = (doublereal *) malloc(n * n * sizeof(doublereal));
+    work = (doublereal *) malloc((n + lwork) * sizeof(doublereal));
+    ipiv = (integer *) malloc(n * sizeof(integer));
+    if (a == NULL || ref == NULL || opt == NULL || work == NULL || ipiv ==
+	    NULL) {
+	fprintf(stderr, "out of memory for n = %ld\n", (long) n);
+	exit(1);
+    }
+    bench_fill(a, n * n);
+
+    for (qr = 0; qr < 2; ++qr) {
+	gref = bench_run(qr, 0, threads, n, a, ref, work, lwork, ipiv);
+	gopt = bench_run(qr, 1, threads, n, a, opt, work, lwork, ipiv);
+	printf("%-8s %6ld %12.2f %12.2f %8.2fx %12.2e\n", names[qr], (long) n,
+		gref, gopt, gopt / gref, bench_difference(ref, opt, n * n));
+    }
+
+    free(a);
+    free(ref);
+    free(opt);
+    free(work);
+    free(ipiv);
+}
+
+int main(int argc, char **argv)
+{
+    static const integer sizes[] = { 64, 128, 256, 512, 1024 };
+    static integer c__1 = 1, c_n1 = -1, c__1024 = 1024;
+    int i__, threads;
+
+    threads = blas_get_num_threads();
+    printf("kernel: %s, threads: %d, block sizes: LU %ld, QR %ld\n",
+	    blas_kernel_name(blas_get_kernel()), threads, (long) ilaenv_(&c__1,
+	    "DGETRF", " ", &c__1024, &c__1024, &c_n1, &c_n1), (long) ilaenv_(
+	    &c__1, "DGEQRF", " ", &c__1024, &c__1024, &c_n1, &c_n1));
+    printf("%-8s %6s %12s %12s %9s %12s\n", "routine", "n", "unblocked",
+	    "blocked", "speedup", "difference");
+
+    if (argc > 1) {
+	for (i__ = 1; i__ < argc; ++i__) {
+	    bench_size(atol(argv[i__]), threads);
+	}
+    } else {
+	for (i__ = 0; i__ < (int) (sizeof(sizes) / sizeof(sizes[0])); ++i__) {
+	    bench_size(sizes[i__], threads);
+	}
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/* GFLOP/s benchmark of DGEMM and DGEMV, comparing the reference loops with
+   the blocked kernel selected for this processor.  The blocked kernel runs
+   on the number of threads set with CLAPACK_NUM_THREADS, the reference
+   loops always run on one thread.
+
+   usage: xblasbenchd [size ...]
+
+   For every size n the program times C := A*B + C with n x n matrices and
+   y := A*x + y, y := A'*x + y, and prints the rate of each kernel, the
+   speedup and the largest difference between the results relative to the
+   largest element of the reference result.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "clapack.h"
+#include "blas_kernels.h"
+
+/* Every measurement is repeated until it took at least this long. */
+#define BENCH_MIN_SECONDS 0.2
+
+static double bench_wall_time(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, count;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+static void bench_fill(doublereal *v, integer n)
+{
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+	v[i__] = (doublereal) rand() / RAND_MAX - .5;
+    }
+}
+
+static double bench_difference(const doublereal *ref, const doublereal *v,
+	integer n)
+{
+    integer i__;
+    double diff = 0., scale = 0.;
+
+    for (i__ = 0; i__ < n; ++i__) {
+	if (fabs(ref[i__] - v[i__]) > diff) {
+	    diff = fabs(ref[i__] - v[i__]);
+	}
+	if (fabs(ref[i__]) > scale) {
+	    scale = fabs(ref[i__]);
+	}
+    }
+    return scale > 0. ? diff / scale : diff;
+}
+
+/* Runs dgemm_ (trans == 0), or dgemv_ with trans, with the given kernel
+   until BENCH_MIN_SECONDS have passed and returns the GFLOP/s.  The
+   result of the first call, starting from out = 0, is left in out. */
+static double bench_run(int kernel, int threads, char *trans, integer n,
+	doublereal *a, doublereal *b, doublereal *out)
+{
+    integer i__, calls, len;
+    integer one = 1;
+    doublereal alpha = 1., beta = 1.;
+    double start, seconds, flops;
+
+    blas_set_kernel(kernel);
+    blas_set_num_threads(kernel == BLAS_KERNEL_REFERENCE ? 1 : threads);
+
+    len = trans == NULL ? n * n : n;
+    for (i__ = 0; i__ < len; ++i__) {
+	out[i__] = 0.;
+    }
+    flops = trans == NULL ? 2. * n * n * n : 2. * n * n;
+
+    calls = 0;
+    start = bench_wall_time();
+    do {
+	if (trans == NULL) {
+	    dgemm_("N", "N", &n, &n, &n, &alpha, a, &n, b, &n, &beta, out, &n);
+	} else {
+	    dgemv_(trans, &n, &n, &alpha, a, &n, b, &one, &beta, out, &one);
+	}
+	if (calls == 0) {
+
+/*           Keep the result of a single call for the comparison. */
+
+	    beta = 0.;
+	    out = out + len;
+	}
+	++calls;
+	seconds = bench_wall_time() - start;
+    } while (seconds < BENCH_MIN_SECONDS);
+
+    return flops * calls / seconds * 1e-9;
+}
+
+static void bench_size(integer n, int kernel, int threads)
+{
+    const char *names[3] = { "dgemm", "dgemv N", "dgemv T" };
+    char *trans[3] = { NULL, "N", "T" };
+    doublereal *a, *b, *ref, *opt;
+    double gref, gopt;
+    int op;
+
+    a = (doublereal *) malloc(n * n * sizeof(doublereal));
+    b = (doublereal *) malloc(n * n * sizeof(doublereal));
+    ref = (doublereal *) malloc(2 * n * n * sizeof(doublereal));
+    opt = (doublereal *) malloc(2 * n * n * sizeof(doublereal));
+    if (a == NULL || b == NULL || ref == NULL || opt == NULL) {
+	fprintf(stderr, "out of memory for n = %ld\n", (long) n);
+	exit(1);
+    }
+    bench_fill(a, n * n);
+    bench_fill(b, n * n);
+
+    for (op = 0; op < 3; ++op) {
+	gref = bench_run(BLAS_KERNEL_REFERENCE, 1, trans[op], n, a, b, ref);
+	gopt = bench_run(kernel, threads, trans[op], n, a, b, opt);
+	printf("%-8s %6ld %12.2f %12.2f %8.2fx %12.2e\n", names[op], (long) n,
+		gref, gopt, gopt / gref, bench_difference(ref, opt, trans[op]
+		== NULL ? n * n : n));
+    }
+
+    free(a);
+    free(b);
+    free(ref);
+    free(opt);
+}
+
+int main(int argc, char **argv)
+{
+    static const integer sizes[] = { 16, 32, 64, 128, 256, 512, 1024 };
+    int i__, kernel, threads;
+
+    kernel = blas_set_kernel(BLAS_KERNEL_AUTO);
+    threads = blas_get_num_threads();
+    printf("kernel: %s, threads: %d\n", blas_kernel_name(kernel), threads);
+    printf("%-8s %6s %12s %12s %9s %12s\n", "routine", "n", "reference",
+	    blas_kernel_name(kernel), "speedup", "difference");
+
+    if (argc > 1) {
+	for (i__ = 1; i__ < argc; ++i__) {
+	    bench_size(atol(argv[i__]), kernel, threads);
+	}
+    } else {
+	for (i__ = 0; i__ < (int) (sizeof(sizes) / sizeof(sizes[0])); ++i__) {
+	    bench_size(sizes[i__], kernel, threads);
+	}
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+/* Selection of the kernels used by the blocked dgemm_ and dgemv_, see
+   blas_kernels.h. */
+
+#include <stdlib.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "blas_threads.h"
+#include "dkernel.h"
+
+#if defined(CLAPACK_WITH_CPU_FEATURES) && (defined(__x86_64__) || \
+    defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define BLAS_KERNELS_X86_PROBE
+#include "cpu_dispatch.h"
+#endif
+
+/* The kernel in effect, selected by the first call unless
+   blas_set_kernel() is called before. */
+static const dkernel *blas_kernel_table = NULL;
+static int blas_kernel_id = BLAS_KERNEL_AUTO;
+static blas_once_flag blas_kernel_once = BLAS_ONCE_INIT;
+
+#ifndef CLAPACK_REFERENCE_BLAS
+
+/* The widest kernel the processor supports.  cpu_features takes operating
+   system support for the YMM and ZMM registers into account and applies
+   the CPU_FEATURES_DISPATCH limit.  Without it only SSE2, which is part of
+   x86-64, can be assumed. */
+static int blas_widest_kernel(void)
+{
+#ifdef BLAS_KERNELS_X86_PROBE
+    switch (GetCpuDispatchLevel()) {
+    case CPU_DISPATCH_AVX512:
+	return BLAS_KERNEL_AVX512;
+    case CPU_DISPATCH_AVX2:
+	return BLAS_KERNEL_AVX2;
+    case CPU_DISPATCH_SSE2:
+	return BLAS_KERNEL_SSE2;
+    default:
+	return BLAS_KERNEL_GENERIC;
+    }
+#else
+    return BLAS_KERNEL_SSE2;
+#endif
+}
+
+#endif /* CLAPACK_REFERENCE_BLAS */
+
+static const dkernel *blas_select_kernel(int kernel)
+{
+    const dkernel *table = NULL;
+
+#ifndef CLAPACK_REFERENCE_BLAS
+    const dkernel *tables[BLAS_KERNEL_AVX512 + 1];
+    int widest;
+
+    tables[BLAS_KERNEL_REFERENCE] = NULL;
+    tables[BLAS_KERNEL_GENERIC] = &dkernel_generic;
+    tables[BLAS_KERNEL_SSE2] = dkernel_sse2;
+    tables[BLAS_KERNEL_AVX2] = dkernel_avx2;
+    tables[BLAS_KERNEL_AVX512] = dkernel_avx512;
+
+/*     Fall back to narrower kernels until one is in this build. */
+
+    widest = blas_widest_kernel();
+    if (kernel == BLAS_KERNEL_AUTO || kernel > widest) {
+	kernel = widest;
+    }
+    for (; kernel > BLAS_KERNEL_REFERENCE && table == NULL; --kernel) {
+	table = tables[kernel];
+    }
+#endif
+
+    return table;
+}
+
+static void blas_set_kernel_table(const dkernel *table)
+{
+    blas_kernel_table = table;
+    blas_kernel_id = table != NULL ? table->id : BLAS_KERNEL_REFERENCE;
+}
+
+static void blas_init_kernel(void)
+{
+    blas_set_kernel_table(blas_select_kernel(BLAS_KERNEL_AUTO));
+}
+
+int blas_set_kernel(int kernel)
+{
+/*     Run the automatic selection first so that it cannot overwrite this
+       one later. */
+
+    blas_once__(&blas_kernel_once, blas_init_kernel);
+    blas_set_kernel_table(blas_select_kernel(kernel));
+    return blas_kernel_id;
+}
+
+int blas_get_kernel(void)
+{
+    blas_once__(&blas_kernel_once, blas_init_kernel);
+    return blas_kernel_id;
+}
+
+const char *blas_kernel_name(int kernel)
+{
+    switch (kernel) {
+    case BLAS_KERNEL_REFERENCE:
+	return "reference";
+    case BLAS_KERNEL_GENERIC:
+	return "generic";
+    case BLAS_KERNEL_SSE2:
+	return "sse2";
+    case BLAS_KERNEL_AVX2:
+	return "avx2";
+    case BLAS_KERNEL_AVX512:
+	return "avx512";
+    default:
+	return "auto";
+    }
+}
+
+const dkernel *dkernel_get(void)
+{
+    blas_once__(&blas_kernel_once, blas_init_kernel);
+    return blas_kernel_table;
+}
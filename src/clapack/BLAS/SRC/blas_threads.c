@@ -0,0 +1,331 @@
+/* Thread pool for the level 3 BLAS, see blas_threads.h.
+
+   The pool is created on the first parallel call and its threads live
+   until the process exits.  One call uses the pool at a time, concurrent
+   callers wait for it.  Threading is opt-in: without a call to
+   blas_set_num_threads() or the CLAPACK_NUM_THREADS environment variable
+   all routines run in the calling thread.
+*/
+
+#include <stdlib.h>
+
+#if defined(CLAPACK_WITH_THREADS) && !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "blas_threads.h"
+
+#if defined(CLAPACK_WITH_THREADS) && defined(_WIN32)
+
+static BOOL CALLBACK blas_once_call(PINIT_ONCE once, PVOID init,
+	PVOID *context)
+{
+    (*(void (**)(void)) init)();
+    return TRUE;
+}
+
+void blas_once__(blas_once_flag *flag, void (*init)(void))
+{
+    InitOnceExecuteOnce(flag, blas_once_call, (PVOID) &init, NULL);
+}
+
+#elif defined(CLAPACK_WITH_THREADS)
+
+void blas_once__(blas_once_flag *flag, void (*init)(void))
+{
+    pthread_once(flag, init);
+}
+
+#else
+
+void blas_once__(blas_once_flag *flag, void (*init)(void))
+{
+    if (! *flag) {
+	init();
+	*flag = 1;
+    }
+}
+
+#endif
+
+/* Requested number of threads, initialised from the environment by the
+   first call. */
+static int blas_num_threads = 1;
+static blas_once_flag blas_num_threads_once = BLAS_ONCE_INIT;
+
+static int blas_processor_count(void)
+{
+#if defined(CLAPACK_WITH_THREADS) && defined(_WIN32)
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return (int) info.dwNumberOfProcessors;
+#elif defined(CLAPACK_WITH_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (int) count : 1;
+#else
+    return 1;
+#endif
+}
+
+/* The number of threads used when threads are requested. */
+static int blas_usable_threads(int threads)
+{
+#ifdef CLAPACK_WITH_THREADS
+    if (threads <= 0) {
+	threads = blas_processor_count();
+    }
+    return min(threads, BLAS_MAX_THREADS);
+#else
+    return 1;
+#endif
+}
+
+static void blas_init_num_threads(void)
+{
+    const char *env = getenv("CLAPACK_NUM_THREADS");
+
+    blas_num_threads = blas_usable_threads(env != NULL && *env != '\0' ?
+	    atoi(env) : 1);
+}
+
+int blas_set_num_threads(int threads)
+{
+/*     Read the environment first so that it cannot override this setting
+       later. */
+
+    blas_once__(&blas_num_threads_once, blas_init_num_threads);
+    blas_num_threads = blas_usable_threads(threads);
+    return blas_num_threads;
+}
+
+int blas_get_num_threads(void)
+{
+    blas_once__(&blas_num_threads_once, blas_init_num_threads);
+    return blas_num_threads;
+}
+
+integer blas_block_count__(integer len)
+{
+    return (len + BLAS_PARALLEL_UNIT - 1) / BLAS_PARALLEL_UNIT;
+}
+
+integer blas_block_start__(integer len, integer parts, integer p)
+{
+    return min(len, blas_block_count__(len) * p / parts * BLAS_PARALLEL_UNIT);
+}
+
+#ifdef CLAPACK_WITH_THREADS
+
+#if defined(_MSC_VER)
+#define BLAS_THREAD_LOCAL __declspec(thread)
+#else
+#define BLAS_THREAD_LOCAL __thread
+#endif
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION blas_mutex;
+typedef CONDITION_VARIABLE blas_cond;
+#define blas_mutex_lock(m) EnterCriticalSection(m)
+#define blas_mutex_unlock(m) LeaveCriticalSection(m)
+#define blas_cond_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define blas_cond_broadcast(c) WakeAllConditionVariable(c)
+#else
+typedef pthread_mutex_t blas_mutex;
+typedef pthread_cond_t blas_cond;
+#define blas_mutex_lock(m) pthread_mutex_lock(m)
+#define blas_mutex_unlock(m) pthread_mutex_unlock(m)
+#define blas_cond_wait(c, m) pthread_cond_wait(c, m)
+#define blas_cond_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
+/* Non-zero in pool threads, and in the calling thread while it runs tasks. */
+static BLAS_THREAD_LOCAL int blas_in_task = 0;
+
+static struct {
+    blas_mutex mutex;
+    blas_cond work;	/* a new job was posted */
+    blas_cond done;	/* the last task of the job finished */
+    blas_cond idle;	/* the pool is available for the next job */
+    int workers;
+    int active;		/* workers running tasks of the current job */
+    int busy;
+    unsigned long generation;
+
+    blas_task task;
+    void *arg;
+    integer ntasks, next, finished;
+} blas_pool;
+
+static blas_once_flag blas_pool_once = BLAS_ONCE_INIT;
+
+static void blas_pool_init(void)
+{
+#ifdef _WIN32
+    InitializeCriticalSection(&blas_pool.mutex);
+    InitializeConditionVariable(&blas_pool.work);
+    InitializeConditionVariable(&blas_pool.done);
+    InitializeConditionVariable(&blas_pool.idle);
+#else
+    pthread_mutex_init(&blas_pool.mutex, NULL);
+    pthread_cond_init(&blas_pool.work, NULL);
+    pthread_cond_init(&blas_pool.done, NULL);
+    pthread_cond_init(&blas_pool.idle, NULL);
+#endif
+}
+
+/* Runs tasks of the current job until none are left.  Called with the
+   mutex held, returns with it held. */
+static void blas_pool_run_tasks(void)
+{
+    integer t;
+
+    while (blas_pool.next < blas_pool.ntasks) {
+	t = blas_pool.next++;
+	blas_mutex_unlock(&blas_pool.mutex);
+	blas_pool.task(blas_pool.arg, t);
+	blas_mutex_lock(&blas_pool.mutex);
+	if (++blas_pool.finished == blas_pool.ntasks) {
+	    blas_cond_broadcast(&blas_pool.done);
+	}
+    }
+}
+
+/* Workers are numbered from 0 in the order they are started.  Only the
+   first blas_pool.active of them run tasks, so that a job uses no more
+   threads than requested when the pool has been larger before. */
+#ifdef _WIN32
+static DWORD WINAPI blas_pool_worker(LPVOID index)
+#else
+static void *blas_pool_worker(void *index)
+#endif
+{
+    const int worker = (int) (size_t) index;
+    unsigned long seen;
+
+    blas_in_task = 1;
+    blas_mutex_lock(&blas_pool.mutex);
+
+/*     The job the worker was started for, or a later one, is current. */
+
+    seen = blas_pool.generation - 1;
+    for (;;) {
+	while (blas_pool.generation == seen) {
+	    blas_cond_wait(&blas_pool.work, &blas_pool.mutex);
+	}
+	seen = blas_pool.generation;
+	if (worker < blas_pool.active) {
+	    blas_pool_run_tasks();
+	}
+    }
+#ifndef _WIN32
+    return NULL;
+#endif
+}
+
+/* Starts workers until there are threads - 1 of them.  Called with the
+   mutex held.  If a thread cannot be created the remaining tasks run on
+   fewer threads. */
+static void blas_pool_start_workers(int threads)
+{
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t thread;
+    pthread_attr_t attr;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+#endif
+
+    while (blas_pool.workers < threads - 1) {
+#ifdef _WIN32
+	handle = CreateThread(NULL, 0, blas_pool_worker, (LPVOID) (size_t)
+		blas_pool.workers, 0, NULL);
+	if (handle == NULL) {
+	    break;
+	}
+	CloseHandle(handle);
+#else
+	if (pthread_create(&thread, &attr, blas_pool_worker, (void *) (size_t)
+		blas_pool.workers) != 0) {
+	    break;
+	}
+#endif
+	++blas_pool.workers;
+    }
+
+#ifndef _WIN32
+    pthread_attr_destroy(&attr);
+#endif
+}
+
+integer blas_parallel_threads__(void)
+{
+    return blas_in_task ? 1 : blas_get_num_threads();
+}
+
+void blas_parallel_run__(integer ntasks, blas_task task, void *arg)
+{
+    integer t;
+    int threads;
+
+    if (ntasks <= 1 || blas_in_task) {
+	for (t = 0; t < ntasks; ++t) {
+	    task(arg, t);
+	}
+	return;
+    }
+
+    blas_once__(&blas_pool_once, blas_pool_init);
+
+    blas_mutex_lock(&blas_pool.mutex);
+    while (blas_pool.busy) {
+	blas_cond_wait(&blas_pool.idle, &blas_pool.mutex);
+    }
+    blas_pool.busy = 1;
+    threads = (int) min(blas_get_num_threads(), ntasks);
+    blas_pool_start_workers(threads);
+    blas_pool.active = threads - 1;
+
+    blas_pool.task = task;
+    blas_pool.arg = arg;
+    blas_pool.ntasks = ntasks;
+    blas_pool.next = 0;
+    blas_pool.finished = 0;
+    ++blas_pool.generation;
+    blas_cond_broadcast(&blas_pool.work);
+
+    blas_in_task = 1;
+    blas_pool_run_tasks();
+    blas_in_task = 0;
+
+    while (blas_pool.finished < blas_pool.ntasks) {
+	blas_cond_wait(&blas_pool.done, &blas_pool.mutex);
+    }
+    blas_pool.busy = 0;
+    blas_cond_broadcast(&blas_pool.idle);
+    blas_mutex_unlock(&blas_pool.mutex);
+}
+
+#else
+
+integer blas_parallel_threads__(void)
+{
+    return 1;
+}
+
+void blas_parallel_run__(integer ntasks, blas_task task, void *arg)
+{
+    integer t;
+
+    for (t = 0; t < ntasks; ++t) {
+	task(arg, t);
+    }
+}
+
+#endif /* CLAPACK_WITH_THREADS */
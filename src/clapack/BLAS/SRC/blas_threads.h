@@ -0,0 +1,87 @@
+/* Internal interface of the BLAS thread pool (blas_threads.c) and the
+ * parallel level 3 drivers (dblas3_parallel.c), also used by the blocked
+ * LAPACK factorisations to update tiles of the trailing matrix in parallel.
+ */
+
+#ifndef __BLAS_THREADS_H
+#define __BLAS_THREADS_H
+
+#ifdef CLAPACK_WITH_THREADS
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+/* A flag for blas_once__(), define it as
+   static blas_once_flag flag = BLAS_ONCE_INIT; */
+#if defined(CLAPACK_WITH_THREADS) && defined(_WIN32)
+typedef INIT_ONCE blas_once_flag;
+#define BLAS_ONCE_INIT INIT_ONCE_STATIC_INIT
+#elif defined(CLAPACK_WITH_THREADS)
+typedef pthread_once_t blas_once_flag;
+#define BLAS_ONCE_INIT PTHREAD_ONCE_INIT
+#else
+typedef int blas_once_flag;
+#define BLAS_ONCE_INIT 0
+#endif
+
+/* Calls init() the first time it is called with flag.  Concurrent callers
+   wait until init() has returned, so that the values it stores are
+   visible to all of them.  Without thread support the first call must not
+   be concurrent. */
+void blas_once__(blas_once_flag *flag, void (*init)(void));
+
+/* Upper limit for the number of threads. */
+#define BLAS_MAX_THREADS 256
+
+/* Calls with fewer multiply-adds run serially. */
+#define BLAS_PARALLEL_MIN_FLOPS 1e6
+
+/* Block boundaries are multiples of this many rows or columns, a multiple
+   of the register blocks of all dgemm kernels (up to the 16 x 12 block of
+   the AVX-512 kernel), so that splitting a product does not add partial
+   tiles. */
+#define BLAS_PARALLEL_UNIT 48
+
+/* Runs task(arg, t) for t = 0 .. ntasks-1 on the pool threads and the
+   calling thread and returns when all tasks are done.  Which thread runs
+   a task is not specified, so a task must only write its own part of the
+   result.  BLAS routines called from within a task run serially. */
+typedef void (*blas_task)(void *arg, integer t);
+
+void blas_parallel_run__(integer ntasks, blas_task task, void *arg);
+
+/* The number of threads a level 3 call may be split over, 1 when called
+   from within a task. */
+integer blas_parallel_threads__(void);
+
+/* The number of BLAS_PARALLEL_UNIT blocks of len rows or columns, the
+   largest useful number of parts to split them into. */
+integer blas_block_count__(integer len);
+
+/* Start of part p of parts about equal parts of len rows or columns.  The
+   start of part parts is len. */
+integer blas_block_start__(integer len, integer parts, integer p);
+
+/* Parallel drivers called by the level 3 routines after argument
+   checking.  They return FALSE_ when the routine should run serially. */
+logical dgemm_parallel__(char *transa, char *transb, integer *m,
+	integer *n, integer *k, doublereal *alpha, doublereal *a,
+	integer *lda, doublereal *b, integer *ldb, doublereal *beta,
+	doublereal *c__, integer *ldc);
+
+logical dsyrk_parallel__(char *uplo, char *trans, integer *n, integer *k,
+	doublereal *alpha, doublereal *a, integer *lda, doublereal *beta,
+	doublereal *c__, integer *ldc);
+
+logical dtrmm_parallel__(char *side, char *uplo, char *transa, char *diag,
+	integer *m, integer *n, doublereal *alpha, doublereal *a,
+	integer *lda, doublereal *b, integer *ldb);
+
+logical dtrsm_parallel__(char *side, char *uplo, char *transa, char *diag,
+	integer *m, integer *n, doublereal *alpha, doublereal *a,
+	integer *lda, doublereal *b, integer *ldb);
+
+#endif /* __BLAS_THREADS_H */
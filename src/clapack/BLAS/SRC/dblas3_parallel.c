@@ -0,0 +1,319 @@
+/* Parallel drivers for the double precision level 3 BLAS.
+
+   A large call is split into tasks that each compute a block of the
+   output with a serial call of the same routine (dsyrk_ also uses dgemm_
+   for the off-diagonal part of its block columns).  The blocks depend only
+   on the problem size and the number of threads, never on which thread
+   runs a task, so the results are reproducible for a fixed thread count.
+*/
+
+#include <math.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_threads.h"
+
+extern logical lsame_(char *, char *);
+extern /* Subroutine */ int dgemm_(char *, char *, integer *, integer *,
+	integer *, doublereal *, doublereal *, integer *, doublereal *,
+	integer *, doublereal *, doublereal *, integer *);
+extern /* Subroutine */ int dsyrk_(char *, char *, integer *, integer *,
+	doublereal *, doublereal *, integer *, doublereal *, doublereal *,
+	integer *);
+extern /* Subroutine */ int dtrmm_(char *, char *, char *, char *,
+	integer *, integer *, doublereal *, doublereal *, integer *,
+	doublereal *, integer *);
+extern /* Subroutine */ int dtrsm_(char *, char *, char *, char *,
+	integer *, integer *, doublereal *, doublereal *, integer *,
+	doublereal *, integer *);
+
+/* All arguments of a level 3 call, shared by its tasks. */
+typedef struct {
+    char *side, *uplo, *transa, *transb, *diag;
+    integer *m, *n, *k;
+    doublereal *alpha, *a;
+    integer *lda;
+    doublereal *b;
+    integer *ldb;
+    doublereal *beta, *c__;
+    integer *ldc;
+
+/*     Number of row and column blocks, and the column block */
+/*     boundaries for dsyrk. */
+    integer pm, pn;
+    integer bounds[BLAS_MAX_THREADS + 1];
+} dblas3_call;
+
+/*     DGEMM, C is split into a grid of pm x pn blocks. */
+
+static void dgemm_task(void *arg, integer t)
+{
+    const dblas3_call *call = (const dblas3_call *) arg;
+    integer i0, i1, j0, j1, mb, nb;
+    doublereal *a, *b;
+
+    i0 = blas_block_start__(*call->m, call->pm, t % call->pm);
+    i1 = blas_block_start__(*call->m, call->pm, t % call->pm + 1);
+    j0 = blas_block_start__(*call->n, call->pn, t / call->pm);
+    j1 = blas_block_start__(*call->n, call->pn, t / call->pm + 1);
+    mb = i1 - i0;
+    nb = j1 - j0;
+    if (mb == 0 || nb == 0) {
+	return;
+    }
+
+    a = lsame_(call->transa, "N") ? call->a + i0 : call->a + i0 * *call->lda;
+    b = lsame_(call->transb, "N") ? call->b + j0 * *call->ldb : call->b + j0;
+    dgemm_(call->transa, call->transb, &mb, &nb, call->k, call->alpha, a,
+	    call->lda, b, call->ldb, call->beta, call->c__ + i0 + j0 *
+	    *call->ldc, call->ldc);
+}
+
+logical dgemm_parallel__(char *transa, char *transb, integer *m,
+	integer *n, integer *k, doublereal *alpha, doublereal *a,
+	integer *lda, doublereal *b, integer *ldb, doublereal *beta,
+	doublereal *c__, integer *ldc)
+{
+    integer i__, j, rm, rn, threads, tasks, best;
+    doublereal perimeter, bestperimeter = 0.;
+    dblas3_call call;
+
+    threads = blas_parallel_threads__();
+    if (threads <= 1 || (doublereal) *m * *n * *k < BLAS_PARALLEL_MIN_FLOPS) {
+	return FALSE_;
+    }
+
+/*     Choose the grid with the most blocks, and of those the one with */
+/*     the most square blocks, which need the least packing. */
+
+    call.pm = call.pn = 1;
+    best = 1;
+    for (i__ = 1; i__ <= threads; ++i__) {
+	j = threads / i__;
+	rm = min(i__, blas_block_count__(*m));
+	rn = min(j, blas_block_count__(*n));
+	tasks = rm * rn;
+	perimeter = (doublereal) *m / rm + (doublereal) *n / rn;
+	if (tasks > best || (tasks == best && perimeter < bestperimeter)) {
+	    call.pm = rm;
+	    call.pn = rn;
+	    best = tasks;
+	    bestperimeter = perimeter;
+	}
+    }
+    if (best <= 1) {
+	return FALSE_;
+    }
+
+    call.transa = transa;
+    call.transb = transb;
+    call.m = m;
+    call.n = n;
+    call.k = k;
+    call.alpha = alpha;
+    call.a = a;
+    call.lda = lda;
+    call.b = b;
+    call.ldb = ldb;
+    call.beta = beta;
+    call.c__ = c__;
+    call.ldc = ldc;
+    blas_parallel_run__(best, dgemm_task, &call);
+    return TRUE_;
+}
+
+/*     DSYRK, C is split into block columns of about equal work. */
+
+static void dsyrk_task(void *arg, integer t)
+{
+    const dblas3_call *call = (const dblas3_call *) arg;
+    integer j0, j1, nb, rows;
+    logical notrans;
+    doublereal *a, *c__;
+    const integer lda = *call->lda, ldc = *call->ldc;
+
+    j0 = call->bounds[t];
+    j1 = call->bounds[t + 1];
+    nb = j1 - j0;
+    if (nb == 0) {
+	return;
+    }
+
+    notrans = lsame_(call->transa, "N");
+    a = call->a;
+    c__ = call->c__;
+
+    if (lsame_(call->uplo, "U") && j0 > 0) {
+
+/*        C(0:j0-1,j0:j1-1) := alpha*A(0:j0-1,:)*A(j0:j1-1,:)' + beta*C */
+
+	if (notrans) {
+	    dgemm_("N", "T", &j0, &nb, call->k, call->alpha, a, call->lda,
+		    a + j0, call->lda, call->beta, c__ + j0 * ldc, call->ldc);
+	} else {
+	    dgemm_("T", "N", &j0, &nb, call->k, call->alpha, a, call->lda,
+		    a + j0 * lda, call->lda, call->beta, c__ + j0 * ldc,
+		    call->ldc);
+	}
+    }
+
+    dsyrk_(call->uplo, call->transa, &nb, call->k, call->alpha, notrans ?
+	    a + j0 : a + j0 * lda, call->lda, call->beta, c__ + j0 + j0 * ldc,
+	     call->ldc);
+
+    rows = *call->n - j1;
+    if (! lsame_(call->uplo, "U") && rows > 0) {
+
+/*        C(j1:n-1,j0:j1-1) := alpha*A(j1:n-1,:)*A(j0:j1-1,:)' + beta*C */
+
+	if (notrans) {
+	    dgemm_("N", "T", &rows, &nb, call->k, call->alpha, a + j1,
+		    call->lda, a + j0, call->lda, call->beta, c__ + j1 + j0 *
+		    ldc, call->ldc);
+	} else {
+	    dgemm_("T", "N", &rows, &nb, call->k, call->alpha, a + j1 * lda,
+		     call->lda, a + j0 * lda, call->lda, call->beta, c__ + j1
+		    + j0 * ldc, call->ldc);
+	}
+    }
+}
+
+logical dsyrk_parallel__(char *uplo, char *trans, integer *n, integer *k,
+	doublereal *alpha, doublereal *a, integer *lda, doublereal *beta,
+	doublereal *c__, integer *ldc)
+{
+    integer p, parts, units;
+    doublereal f;
+    logical upper;
+    dblas3_call call;
+
+    parts = min(blas_parallel_threads__(), blas_block_count__(*n));
+    if (parts <= 1 || (doublereal) *n * *n * *k * .5 <
+	    BLAS_PARALLEL_MIN_FLOPS) {
+	return FALSE_;
+    }
+
+/*     Column j of the upper triangle has j elements, of the lower */
+/*     triangle n - j, so equal work needs boundaries at n*sqrt(p/parts) */
+/*     and n*(1 - sqrt(1 - p/parts)) respectively. */
+
+    upper = lsame_(uplo, "U");
+    units = blas_block_count__(*n);
+    for (p = 0; p <= parts; ++p) {
+	f = (doublereal) p / parts;
+	f = upper ? sqrt(f) : 1. - sqrt(1. - f);
+	call.bounds[p] = min(*n, (integer) (units * f + .5) *
+		BLAS_PARALLEL_UNIT);
+    }
+    call.bounds[parts] = *n;
+
+    call.uplo = uplo;
+    call.transa = trans;
+    call.n = n;
+    call.k = k;
+    call.alpha = alpha;
+    call.a = a;
+    call.lda = lda;
+    call.beta = beta;
+    call.c__ = c__;
+    call.ldc = ldc;
+    blas_parallel_run__(parts, dsyrk_task, &call);
+    return TRUE_;
+}
+
+/*     DTRMM and DTRSM, B is split into block columns if A is applied */
+/*     from the left and into block rows if it is applied from the right. */
+
+static void dtrxm_task(void *arg, integer t, logical solve)
+{
+    const dblas3_call *call = (const dblas3_call *) arg;
+    integer i0, i1, mb, nb;
+    doublereal *b;
+
+    if (lsame_(call->side, "L")) {
+	i0 = blas_block_start__(*call->n, call->pn, t);
+	i1 = blas_block_start__(*call->n, call->pn, t + 1);
+	mb = *call->m;
+	nb = i1 - i0;
+	b = call->b + i0 * *call->ldb;
+    } else {
+	i0 = blas_block_start__(*call->m, call->pm, t);
+	i1 = blas_block_start__(*call->m, call->pm, t + 1);
+	mb = i1 - i0;
+	nb = *call->n;
+	b = call->b + i0;
+    }
+    if (mb == 0 || nb == 0) {
+	return;
+    }
+
+    if (solve) {
+	dtrsm_(call->side, call->uplo, call->transa, call->diag, &mb, &nb,
+		call->alpha, call->a, call->lda, b, call->ldb);
+    } else {
+	dtrmm_(call->side, call->uplo, call->transa, call->diag, &mb, &nb,
+		call->alpha, call->a, call->lda, b, call->ldb);
+    }
+}
+
+static void dtrmm_task(void *arg, integer t)
+{
+    dtrxm_task(arg, t, FALSE_);
+}
+
+static void dtrsm_task(void *arg, integer t)
+{
+    dtrxm_task(arg, t, TRUE_);
+}
+
+static logical dtrxm_parallel(char *side, char *uplo, char *transa,
+	char *diag, integer *m, integer *n, doublereal *alpha, doublereal *a,
+	 integer *lda, doublereal *b, integer *ldb, blas_task task)
+{
+    integer parts, threads;
+    logical lside;
+    dblas3_call call;
+
+    threads = blas_parallel_threads__();
+    lside = lsame_(side, "L");
+    if (threads <= 1 || (lside ? (doublereal) *m * *m * *n : (doublereal) *m
+	     * *n * *n) * .5 < BLAS_PARALLEL_MIN_FLOPS) {
+	return FALSE_;
+    }
+
+    parts = min(threads, blas_block_count__(lside ? *n : *m));
+    if (parts <= 1) {
+	return FALSE_;
+    }
+
+    call.side = side;
+    call.uplo = uplo;
+    call.transa = transa;
+    call.diag = diag;
+    call.m = m;
+    call.n = n;
+    call.alpha = alpha;
+    call.a = a;
+    call.lda = lda;
+    call.b = b;
+    call.ldb = ldb;
+    call.pm = call.pn = parts;
+    blas_parallel_run__(parts, task, &call);
+    return TRUE_;
+}
+
+logical dtrmm_parallel__(char *side, char *uplo, char *transa, char *diag,
+	integer *m, integer *n, doublereal *alpha, doublereal *a,
+	integer *lda, doublereal *b, integer *ldb)
+{
+    return dtrxm_parallel(side, uplo, transa, diag, m, n, alpha, a, lda, b,
+	    ldb, dtrmm_task);
+}
+
+logical dtrsm_parallel__(char *side, char *uplo, char *transa, char *diag,
+	integer *m, integer *n, doublereal *alpha, doublereal *a,
+	integer *lda, doublereal *b, integer *ldb)
+{
+    return dtrxm_parallel(side, uplo, transa, diag, m, n, alpha, a, lda, b,
+	    ldb, dtrsm_task);
+}
@@ -12,6 +12,10 @@
 
 #include "f2c.h"
 #include "blaswrap.h"
+#include "blas_threads.h"
+#ifndef CLAPACK_REFERENCE_BLAS
+#include "dkernel.h"
+#endif
 
 /* Subroutine */ int dgemm_(char *transa, char *transb, integer *m, integer *
 	n, integer *k, doublereal *alpha, doublereal *a, integer *lda, 
@@ -258,6 +262,23 @@
 	return 0;
     }
 
+/*     Split large products over the BLAS threads. */
+
+    if (dgemm_parallel__(transa, transb, m, n, k, alpha, &a[a_offset], lda,
+	    &b[b_offset], ldb, beta, &c__[c_offset], ldc)) {
+	return 0;
+    }
+
+#ifndef CLAPACK_REFERENCE_BLAS
+
+/*     Use the cache blocked kernels when they are available. */
+
+    if (dgemm_blocked__(nota, notb, *m, *n, *k, *alpha, &a[a_offset], *lda,
+	    &b[b_offset], *ldb, *beta, &c__[c_offset], *ldc)) {
+	return 0;
+    }
+#endif
+
 /*     Start the operations. */
 
     if (notb) {
@@ -0,0 +1,198 @@
+/* Cache blocked DGEMM.
+
+   C := alpha*op( A )*op( B ) + beta*C is computed in the usual GotoBLAS
+   loop order: op( B ) is packed into kc x nc panels that stay in the
+   last level cache, op( A ) into mc x kc panels that stay in the L2 cache,
+   and a register blocked micro-kernel multiplies an mr x kc sliver of A
+   with a kc x nr sliver of B.  The packed panels are stored in the order
+   the micro-kernel reads them and are padded with zeros, so the kernel
+   never sees the transposition, the leading dimensions or partial tiles.
+*/
+
+#include <stdlib.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "dkernel.h"
+
+/* Products smaller than this many multiply-adds are not worth packing. */
+#define DGEMM_BLOCKED_MIN_FLOPS 4096.
+
+/* Packs the mc x kc block of op( A ) starting at a into slivers of mr rows. */
+static void dgemm_pack_a(logical nota, integer mc, integer kc,
+	const doublereal *a, integer lda, integer mr, doublereal *ap)
+{
+    integer i__, l, r__, rows;
+    const doublereal *src;
+
+    for (i__ = 0; i__ < mc; i__ += mr) {
+	rows = min(mr, mc - i__);
+	if (nota) {
+	    for (l = 0; l < kc; ++l) {
+		src = a + i__ + l * lda;
+		for (r__ = 0; r__ < rows; ++r__) {
+		    ap[r__] = src[r__];
+		}
+		for (; r__ < mr; ++r__) {
+		    ap[r__] = 0.;
+		}
+		ap += mr;
+	    }
+	} else {
+	    for (r__ = 0; r__ < mr; ++r__) {
+		if (r__ < rows) {
+		    src = a + (i__ + r__) * lda;
+		    for (l = 0; l < kc; ++l) {
+			ap[l * mr + r__] = src[l];
+		    }
+		} else {
+		    for (l = 0; l < kc; ++l) {
+			ap[l * mr + r__] = 0.;
+		    }
+		}
+	    }
+	    ap += mr * kc;
+	}
+    }
+}
+
+/* Packs the kc x nc block of op( B ) starting at b into slivers of nr
+   columns. */
+static void dgemm_pack_b(logical notb, integer kc, integer nc,
+	const doublereal *b, integer ldb, integer nr, doublereal *bp)
+{
+    integer j, l, c__, cols;
+    const doublereal *src;
+
+    for (j = 0; j < nc; j += nr) {
+	cols = min(nr, nc - j);
+	if (notb) {
+	    for (c__ = 0; c__ < nr; ++c__) {
+		if (c__ < cols) {
+		    src = b + (j + c__) * ldb;
+		    for (l = 0; l < kc; ++l) {
+			bp[l * nr + c__] = src[l];
+		    }
+		} else {
+		    for (l = 0; l < kc; ++l) {
+			bp[l * nr + c__] = 0.;
+		    }
+		}
+	    }
+	    bp += nr * kc;
+	} else {
+	    for (l = 0; l < kc; ++l) {
+		src = b + j + l * ldb;
+		for (c__ = 0; c__ < cols; ++c__) {
+		    bp[c__] = src[c__];
+		}
+		for (; c__ < nr; ++c__) {
+		    bp[c__] = 0.;
+		}
+		bp += nr;
+	    }
+	}
+    }
+}
+
+/* Multiplies the packed panels into the mc x nc block of C at c__. */
+static void dgemm_macro_kernel(const dkernel *kernel, integer mc,
+	integer nc, integer kc, doublereal alpha, const doublereal *ap,
+	const doublereal *bp, doublereal *c__, integer ldc)
+{
+    integer i__, j, r__, s, rows, cols;
+    doublereal tile[DKERNEL_MAX_TILE];
+    doublereal *cij;
+    const integer mr = kernel->mr;
+    const integer nr = kernel->nr;
+
+    for (j = 0; j < nc; j += nr) {
+	cols = min(nr, nc - j);
+	for (i__ = 0; i__ < mc; i__ += mr) {
+	    rows = min(mr, mc - i__);
+	    cij = c__ + i__ + j * ldc;
+	    if (rows == mr && cols == nr) {
+		kernel->gemm(kc, alpha, ap + i__ * kc, bp + j * kc, cij, ldc);
+	    } else {
+
+/*              Partial tile at the bottom or right edge of C. */
+
+		for (r__ = 0; r__ < mr * nr; ++r__) {
+		    tile[r__] = 0.;
+		}
+		kernel->gemm(kc, alpha, ap + i__ * kc, bp + j * kc, tile, mr);
+		for (s = 0; s < cols; ++s) {
+		    for (r__ = 0; r__ < rows; ++r__) {
+			cij[r__ + s * ldc] += tile[r__ + s * mr];
+		    }
+		}
+	    }
+	}
+    }
+}
+
+logical dgemm_blocked__(logical nota, logical notb, integer m, integer n,
+	integer k, doublereal alpha, const doublereal *a, integer lda,
+	const doublereal *b, integer ldb, doublereal beta, doublereal *c__,
+	integer ldc)
+{
+    integer i__, j, ic, jc, pc, mc, nc, kc, mcmax, ncmax, kcmax;
+    size_t size;
+    void *buffer;
+    doublereal *ap, *bp;
+    const dkernel *kernel = dkernel_get();
+
+    if (kernel == NULL || (doublereal) m * n * k < DGEMM_BLOCKED_MIN_FLOPS) {
+	return FALSE_;
+    }
+
+/*     The panels never need to be larger than the matrices. */
+
+    kcmax = min(k, kernel->kc);
+    mcmax = min((m + kernel->mr - 1) / kernel->mr * kernel->mr, kernel->mc);
+    ncmax = min((n + kernel->nr - 1) / kernel->nr * kernel->nr, kernel->nc);
+
+    size = (size_t) (mcmax + ncmax) * kcmax * sizeof(doublereal) + 64;
+    buffer = malloc(size);
+    if (buffer == NULL) {
+	return FALSE_;
+    }
+    ap = (doublereal *) (((size_t) buffer + 63) & ~(size_t) 63);
+    bp = ap + mcmax * kcmax;
+
+/*     C := beta*C, the kernels only accumulate. */
+
+    if (beta == 0.) {
+	for (j = 0; j < n; ++j) {
+	    for (i__ = 0; i__ < m; ++i__) {
+		c__[i__ + j * ldc] = 0.;
+	    }
+	}
+    } else if (beta != 1.) {
+	for (j = 0; j < n; ++j) {
+	    for (i__ = 0; i__ < m; ++i__) {
+		c__[i__ + j * ldc] = beta * c__[i__ + j * ldc];
+	    }
+	}
+    }
+
+    for (jc = 0; jc < n; jc += ncmax) {
+	nc = min(ncmax, n - jc);
+	for (pc = 0; pc < k; pc += kcmax) {
+	    kc = min(kcmax, k - pc);
+	    dgemm_pack_b(notb, kc, nc, notb ? b + pc + jc * ldb : b + jc + pc
+		    * ldb, ldb, kernel->nr, bp);
+	    for (ic = 0; ic < m; ic += mcmax) {
+		mc = min(mcmax, m - ic);
+		dgemm_pack_a(nota, mc, kc, nota ? a + ic + pc * lda : a + pc +
+			ic * lda, lda, kernel->mr, ap);
+		dgemm_macro_kernel(kernel, mc, nc, kc, alpha, ap, bp, c__ + ic
+			+ jc * ldc, ldc);
+	    }
+	}
+    }
+
+    free(buffer);
+    return TRUE_;
+}
@@ -12,6 +12,9 @@
 
 #include "f2c.h"
 #include "blaswrap.h"
+#ifndef CLAPACK_REFERENCE_BLAS
+#include "dkernel.h"
+#endif
 
 /* Subroutine */ int dgemv_(char *trans, integer *m, integer *n, doublereal *
 	alpha, doublereal *a, integer *lda, doublereal *x, integer *incx, 
@@ -233,6 +236,15 @@
     if (*alpha == 0.) {
 	return 0;
     }
+#ifndef CLAPACK_REFERENCE_BLAS
+
+/*     Use the blocked kernels when they are available. */
+
+    if (dgemv_blocked__(lsame_(trans, "N"), *m, *n, *alpha, &a[a_offset], *
+	    lda, &x[kx], *incx, &y[ky], *incy)) {
+	return 0;
+    }
+#endif
     if (lsame_(trans, "N")) {
 
 /*        Form  y := alpha*A*x + y. */
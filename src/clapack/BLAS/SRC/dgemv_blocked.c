@@ -0,0 +1,78 @@
+/* Blocked DGEMV.
+
+   y := alpha*op( A )*x + y, with y already scaled by beta in dgemv_.
+   The rows of A are processed in blocks so that the part of y (or x)
+   the kernel updates (or reads) for every column stays in the L1 cache.
+   Non unit increments are handled by copying x, or the result for y, to
+   contiguous work space.
+*/
+
+#include <stdlib.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "dkernel.h"
+
+/* Matrices with fewer elements are left to the reference loops. */
+#define DGEMV_BLOCKED_MIN_SIZE 256.
+
+/* Rows of A per block, 16KB of x or y. */
+#define DGEMV_ROW_BLOCK 2048
+
+logical dgemv_blocked__(logical notrans, integer m, integer n,
+	doublereal alpha, const doublereal *a, integer lda,
+	const doublereal *x, integer incx, doublereal *y, integer incy)
+{
+    integer i__, ib, mb, lenx, leny;
+    doublereal *work = NULL, *xw, *yw;
+    const dkernel *kernel = dkernel_get();
+
+    if (kernel == NULL || (doublereal) m * n < DGEMV_BLOCKED_MIN_SIZE) {
+	return FALSE_;
+    }
+
+    lenx = notrans ? n : m;
+    leny = notrans ? m : n;
+
+    if (incx != 1 || incy != 1) {
+	work = (doublereal *) malloc((size_t) (lenx + leny) * sizeof(
+		doublereal));
+	if (work == NULL) {
+	    return FALSE_;
+	}
+    }
+
+    xw = (doublereal *) x;
+    if (incx != 1) {
+	xw = work;
+	for (i__ = 0; i__ < lenx; ++i__) {
+	    xw[i__] = x[i__ * incx];
+	}
+    }
+    yw = y;
+    if (incy != 1) {
+	yw = work + lenx;
+	for (i__ = 0; i__ < leny; ++i__) {
+	    yw[i__] = 0.;
+	}
+    }
+
+    for (ib = 0; ib < m; ib += DGEMV_ROW_BLOCK) {
+	mb = min(DGEMV_ROW_BLOCK, m - ib);
+	if (notrans) {
+	    kernel->gemv_n(mb, n, alpha, a + ib, lda, xw, yw + ib);
+	} else {
+	    kernel->gemv_t(mb, n, alpha, a + ib, lda, xw + ib, yw);
+	}
+    }
+
+    if (incy != 1) {
+	for (i__ = 0; i__ < leny; ++i__) {
+	    y[i__ * incy] += yw[i__];
+	}
+    }
+
+    free(work);
+    return TRUE_;
+}
@@ -0,0 +1,65 @@
+/* Internal interface between the blocked dgemm_/dgemv_ drivers
+ * (dgemm_blocked.c, dgemv_blocked.c) and the instruction set specific
+ * kernels (dkernel_generic.c, dkernel_sse2.c, dkernel_avx2.c,
+ * dkernel_avx512.c).
+ */
+
+#ifndef __DKERNEL_H
+#define __DKERNEL_H
+
+/* C(0:mr-1,0:nr-1) += alpha * A * B, where A is a packed mr x k panel
+   stored column by column and B is a packed k x nr panel stored row by
+   row. */
+typedef void (*dgemm_micro_kernel)(integer k, doublereal alpha,
+	const doublereal *a, const doublereal *b, doublereal *c__,
+	integer ldc);
+
+/* y(0:m-1) += alpha * A * x, A is m x n with leading dimension lda. */
+typedef void (*dgemv_n_kernel)(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y);
+
+/* y(0:n-1) += alpha * A' * x, A is m x n with leading dimension lda. */
+typedef void (*dgemv_t_kernel)(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y);
+
+/* Largest register block, mr * nr, of any kernel. */
+#define DKERNEL_MAX_TILE 192
+
+typedef struct {
+    int id;
+    const char *name;
+
+/*     Register block of the micro-kernel and the cache blocks of the */
+/*     packed panels.  mc is a multiple of mr and nc a multiple of nr. */
+    integer mr, nr;
+    integer mc, kc, nc;
+
+    dgemm_micro_kernel gemm;
+    dgemv_n_kernel gemv_n;
+    dgemv_t_kernel gemv_t;
+} dkernel;
+
+/* Kernel tables, NULL entries are not available in this build. */
+extern const dkernel dkernel_generic;
+extern const dkernel *const dkernel_sse2;
+extern const dkernel *const dkernel_avx2;
+extern const dkernel *const dkernel_avx512;
+
+/* The kernel selected with blas_set_kernel(), NULL for the reference
+   loops. */
+const dkernel *dkernel_get(void);
+
+/* Blocked drivers called by dgemm_ and dgemv_ after argument checking.
+   They return FALSE_ when the reference loops should be used instead. */
+logical dgemm_blocked__(logical nota, logical notb, integer m, integer n,
+	integer k, doublereal alpha, const doublereal *a, integer lda,
+	const doublereal *b, integer ldb, doublereal beta, doublereal *c__,
+	integer ldc);
+
+logical dgemv_blocked__(logical notrans, integer m, integer n,
+	doublereal alpha, const doublereal *a, integer lda,
+	const doublereal *x, integer incx, doublereal *y, integer incy);
+
+#endif /* __DKERNEL_H */
@@ -0,0 +1,203 @@
+/* AVX2/FMA kernels for the blocked DGEMM and DGEMV.  This file is
+   compiled with AVX2 and FMA code generation enabled (see CMakeLists.txt);
+   the kernels are only selected when cpu_features reports that the
+   processor and operating system support both. */
+
+#if defined(__AVX2__)
+#define DKERNEL_AVX2
+#include <immintrin.h>
+#endif
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "dkernel.h"
+
+#ifdef DKERNEL_AVX2
+
+/* 8 x 6 register block: twelve accumulators of four doubles, two
+   registers for the A sliver and one for the broadcast element of B. */
+static void dgemm_avx2_8x6(integer k, doublereal alpha,
+	const doublereal *a, const doublereal *b, doublereal *c__,
+	integer ldc)
+{
+    integer l;
+    __m256d a0, a1, bj, av;
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+    for (l = 0; l < k; ++l) {
+	a0 = _mm256_loadu_pd(a);
+	a1 = _mm256_loadu_pd(a + 4);
+	bj = _mm256_broadcast_sd(b);
+	c00 = _mm256_fmadd_pd(a0, bj, c00);
+	c01 = _mm256_fmadd_pd(a1, bj, c01);
+	bj = _mm256_broadcast_sd(b + 1);
+	c10 = _mm256_fmadd_pd(a0, bj, c10);
+	c11 = _mm256_fmadd_pd(a1, bj, c11);
+	bj = _mm256_broadcast_sd(b + 2);
+	c20 = _mm256_fmadd_pd(a0, bj, c20);
+	c21 = _mm256_fmadd_pd(a1, bj, c21);
+	bj = _mm256_broadcast_sd(b + 3);
+	c30 = _mm256_fmadd_pd(a0, bj, c30);
+	c31 = _mm256_fmadd_pd(a1, bj, c31);
+	bj = _mm256_broadcast_sd(b + 4);
+	c40 = _mm256_fmadd_pd(a0, bj, c40);
+	c41 = _mm256_fmadd_pd(a1, bj, c41);
+	bj = _mm256_broadcast_sd(b + 5);
+	c50 = _mm256_fmadd_pd(a0, bj, c50);
+	c51 = _mm256_fmadd_pd(a1, bj, c51);
+	a += 8;
+	b += 6;
+    }
+
+    av = _mm256_set1_pd(alpha);
+#define DKERNEL_UPDATE(cp, acc) \
+    _mm256_storeu_pd(cp, _mm256_fmadd_pd(av, acc, _mm256_loadu_pd(cp)))
+    DKERNEL_UPDATE(c__, c00);
+    DKERNEL_UPDATE(c__ + 4, c01);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c10);
+    DKERNEL_UPDATE(c__ + 4, c11);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c20);
+    DKERNEL_UPDATE(c__ + 4, c21);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c30);
+    DKERNEL_UPDATE(c__ + 4, c31);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c40);
+    DKERNEL_UPDATE(c__ + 4, c41);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c50);
+    DKERNEL_UPDATE(c__ + 4, c51);
+#undef DKERNEL_UPDATE
+}
+
+static void dgemv_n_avx2(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    doublereal s0, s1, s2, s3;
+    __m256d t0, t1, t2, t3, yv;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	s0 = alpha * x[j];
+	s1 = alpha * x[j + 1];
+	s2 = alpha * x[j + 2];
+	s3 = alpha * x[j + 3];
+	t0 = _mm256_set1_pd(s0);
+	t1 = _mm256_set1_pd(s1);
+	t2 = _mm256_set1_pd(s2);
+	t3 = _mm256_set1_pd(s3);
+	for (i__ = 0; i__ + 4 <= m; i__ += 4) {
+	    yv = _mm256_loadu_pd(y + i__);
+	    yv = _mm256_fmadd_pd(t0, _mm256_loadu_pd(a0 + i__), yv);
+	    yv = _mm256_fmadd_pd(t1, _mm256_loadu_pd(a1 + i__), yv);
+	    yv = _mm256_fmadd_pd(t2, _mm256_loadu_pd(a2 + i__), yv);
+	    yv = _mm256_fmadd_pd(t3, _mm256_loadu_pd(a3 + i__), yv);
+	    _mm256_storeu_pd(y + i__, yv);
+	}
+	for (; i__ < m; ++i__) {
+	    y[i__] = y[i__] + s0 * a0[i__] + s1 * a1[i__] + s2 * a2[i__] + s3 *
+		     a3[i__];
+	}
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	s0 = alpha * x[j];
+	t0 = _mm256_set1_pd(s0);
+	for (i__ = 0; i__ + 4 <= m; i__ += 4) {
+	    _mm256_storeu_pd(y + i__, _mm256_fmadd_pd(t0, _mm256_loadu_pd(a0
+		    + i__), _mm256_loadu_pd(y + i__)));
+	}
+	for (; i__ < m; ++i__) {
+	    y[i__] += s0 * a0[i__];
+	}
+    }
+}
+
+static doublereal dkernel_avx2_sum(__m256d v)
+{
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),
+	    _mm256_extractf128_pd(v, 1));
+
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+static void dgemv_t_avx2(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    doublereal r0, r1, r2, r3;
+    __m256d s0, s1, s2, s3, xv;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	s0 = s1 = s2 = s3 = _mm256_setzero_pd();
+	for (i__ = 0; i__ + 4 <= m; i__ += 4) {
+	    xv = _mm256_loadu_pd(x + i__);
+	    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i__), xv, s0);
+	    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + i__), xv, s1);
+	    s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + i__), xv, s2);
+	    s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + i__), xv, s3);
+	}
+	r0 = dkernel_avx2_sum(s0);
+	r1 = dkernel_avx2_sum(s1);
+	r2 = dkernel_avx2_sum(s2);
+	r3 = dkernel_avx2_sum(s3);
+	for (; i__ < m; ++i__) {
+	    r0 += a0[i__] * x[i__];
+	    r1 += a1[i__] * x[i__];
+	    r2 += a2[i__] * x[i__];
+	    r3 += a3[i__] * x[i__];
+	}
+	y[j] += alpha * r0;
+	y[j + 1] += alpha * r1;
+	y[j + 2] += alpha * r2;
+	y[j + 3] += alpha * r3;
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	s0 = _mm256_setzero_pd();
+	for (i__ = 0; i__ + 4 <= m; i__ += 4) {
+	    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i__), _mm256_loadu_pd(x
+		    + i__), s0);
+	}
+	r0 = dkernel_avx2_sum(s0);
+	for (; i__ < m; ++i__) {
+	    r0 += a0[i__] * x[i__];
+	}
+	y[j] += alpha * r0;
+    }
+}
+
+static const dkernel dkernel_avx2_table = {
+    BLAS_KERNEL_AVX2, "avx2",
+    8, 6,
+    96, 256, 2040,
+    dgemm_avx2_8x6, dgemv_n_avx2, dgemv_t_avx2
+};
+
+const dkernel *const dkernel_avx2 = &dkernel_avx2_table;
+
+#else
+
+const dkernel *const dkernel_avx2 = NULL;
+
+#endif /* DKERNEL_AVX2 */
@@ -0,0 +1,179 @@
+/* AVX-512 kernels for the blocked DGEMM and DGEMV.  This file is compiled
+   with AVX-512 code generation enabled (see CMakeLists.txt); the kernels
+   are only selected when cpu_features reports that the processor and
+   operating system support AVX-512 F, BW, DQ and VL. */
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__FMA__)
+#define DKERNEL_AVX512
+#include <immintrin.h>
+#endif
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "dkernel.h"
+
+#ifdef DKERNEL_AVX512
+
+/* 16 x 12 register block: twenty-four accumulators of eight doubles, two
+   registers for the A sliver and one for the broadcast element of B. */
+static void dgemm_avx512_16x12(integer k, doublereal alpha,
+	const doublereal *a, const doublereal *b, doublereal *c__,
+	integer ldc)
+{
+    integer l, j;
+    __m512d a0, a1, bj, av;
+    __m512d c0[12], c1[12];
+
+    for (j = 0; j < 12; ++j) {
+	c0[j] = _mm512_setzero_pd();
+	c1[j] = _mm512_setzero_pd();
+    }
+
+/*     The loops over j are unrolled by the compiler, which keeps the */
+/*     accumulators in registers. */
+
+    for (l = 0; l < k; ++l) {
+	a0 = _mm512_loadu_pd(a);
+	a1 = _mm512_loadu_pd(a + 8);
+	for (j = 0; j < 12; ++j) {
+	    bj = _mm512_set1_pd(b[j]);
+	    c0[j] = _mm512_fmadd_pd(a0, bj, c0[j]);
+	    c1[j] = _mm512_fmadd_pd(a1, bj, c1[j]);
+	}
+	a += 16;
+	b += 12;
+    }
+
+    av = _mm512_set1_pd(alpha);
+    for (j = 0; j < 12; ++j) {
+	_mm512_storeu_pd(c__, _mm512_fmadd_pd(av, c0[j], _mm512_loadu_pd(
+		c__)));
+	_mm512_storeu_pd(c__ + 8, _mm512_fmadd_pd(av, c1[j], _mm512_loadu_pd(
+		c__ + 8)));
+	c__ += ldc;
+    }
+}
+
+/* The rows i0 .. m-1 left over by the vector loops are handled with a
+   masked load and store. */
+static __mmask8 dkernel_avx512_tail(integer rows)
+{
+    return (__mmask8) ((1u << rows) - 1);
+}
+
+static void dgemv_n_avx512(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    __m512d t0, t1, t2, t3, yv;
+    __mmask8 tail;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    tail = dkernel_avx512_tail(m % 8);
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	t0 = _mm512_set1_pd(alpha * x[j]);
+	t1 = _mm512_set1_pd(alpha * x[j + 1]);
+	t2 = _mm512_set1_pd(alpha * x[j + 2]);
+	t3 = _mm512_set1_pd(alpha * x[j + 3]);
+	for (i__ = 0; i__ + 8 <= m; i__ += 8) {
+	    yv = _mm512_loadu_pd(y + i__);
+	    yv = _mm512_fmadd_pd(t0, _mm512_loadu_pd(a0 + i__), yv);
+	    yv = _mm512_fmadd_pd(t1, _mm512_loadu_pd(a1 + i__), yv);
+	    yv = _mm512_fmadd_pd(t2, _mm512_loadu_pd(a2 + i__), yv);
+	    yv = _mm512_fmadd_pd(t3, _mm512_loadu_pd(a3 + i__), yv);
+	    _mm512_storeu_pd(y + i__, yv);
+	}
+	if (i__ < m) {
+	    yv = _mm512_maskz_loadu_pd(tail, y + i__);
+	    yv = _mm512_fmadd_pd(t0, _mm512_maskz_loadu_pd(tail, a0 + i__), yv);
+	    yv = _mm512_fmadd_pd(t1, _mm512_maskz_loadu_pd(tail, a1 + i__), yv);
+	    yv = _mm512_fmadd_pd(t2, _mm512_maskz_loadu_pd(tail, a2 + i__), yv);
+	    yv = _mm512_fmadd_pd(t3, _mm512_maskz_loadu_pd(tail, a3 + i__), yv);
+	    _mm512_mask_storeu_pd(y + i__, tail, yv);
+	}
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	t0 = _mm512_set1_pd(alpha * x[j]);
+	for (i__ = 0; i__ + 8 <= m; i__ += 8) {
+	    _mm512_storeu_pd(y + i__, _mm512_fmadd_pd(t0, _mm512_loadu_pd(a0
+		    + i__), _mm512_loadu_pd(y + i__)));
+	}
+	if (i__ < m) {
+	    _mm512_mask_storeu_pd(y + i__, tail, _mm512_fmadd_pd(t0,
+		    _mm512_maskz_loadu_pd(tail, a0 + i__), _mm512_maskz_loadu_pd(
+		    tail, y + i__)));
+	}
+    }
+}
+
+static void dgemv_t_avx512(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    __m512d s0, s1, s2, s3, xv;
+    __mmask8 tail;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    tail = dkernel_avx512_tail(m % 8);
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	s0 = s1 = s2 = s3 = _mm512_setzero_pd();
+	for (i__ = 0; i__ + 8 <= m; i__ += 8) {
+	    xv = _mm512_loadu_pd(x + i__);
+	    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i__), xv, s0);
+	    s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + i__), xv, s1);
+	    s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + i__), xv, s2);
+	    s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + i__), xv, s3);
+	}
+	if (i__ < m) {
+	    xv = _mm512_maskz_loadu_pd(tail, x + i__);
+	    s0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a0 + i__), xv, s0);
+	    s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a1 + i__), xv, s1);
+	    s2 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a2 + i__), xv, s2);
+	    s3 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a3 + i__), xv, s3);
+	}
+	y[j] += alpha * _mm512_reduce_add_pd(s0);
+	y[j + 1] += alpha * _mm512_reduce_add_pd(s1);
+	y[j + 2] += alpha * _mm512_reduce_add_pd(s2);
+	y[j + 3] += alpha * _mm512_reduce_add_pd(s3);
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	s0 = _mm512_setzero_pd();
+	for (i__ = 0; i__ + 8 <= m; i__ += 8) {
+	    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i__), _mm512_loadu_pd(x
+		    + i__), s0);
+	}
+	if (i__ < m) {
+	    s0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a0 + i__),
+		    _mm512_maskz_loadu_pd(tail, x + i__), s0);
+	}
+	y[j] += alpha * _mm512_reduce_add_pd(s0);
+    }
+}
+
+static const dkernel dkernel_avx512_table = {
+    BLAS_KERNEL_AVX512, "avx512",
+    16, 12,
+    144, 256, 2040,
+    dgemm_avx512_16x12, dgemv_n_avx512, dgemv_t_avx512
+};
+
+const dkernel *const dkernel_avx512 = &dkernel_avx512_table;
+
+#else
+
+const dkernel *const dkernel_avx512 = NULL;
+
+#endif /* DKERNEL_AVX512 */
@@ -0,0 +1,112 @@
+/* Portable kernels for the blocked DGEMM and DGEMV, used when no SIMD
+   kernel is available.  They are written so that compilers can keep the
+   accumulators in registers and vectorise the inner loops. */
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "dkernel.h"
+
+#define MR 4
+#define NR 4
+
+static void dgemm_generic_4x4(integer k, doublereal alpha,
+	const doublereal *a, const doublereal *b, doublereal *c__,
+	integer ldc)
+{
+    integer l, r__, s;
+    doublereal ab[NR][MR];
+
+    for (s = 0; s < NR; ++s) {
+	for (r__ = 0; r__ < MR; ++r__) {
+	    ab[s][r__] = 0.;
+	}
+    }
+    for (l = 0; l < k; ++l) {
+	for (s = 0; s < NR; ++s) {
+	    for (r__ = 0; r__ < MR; ++r__) {
+		ab[s][r__] += a[r__] * b[s];
+	    }
+	}
+	a += MR;
+	b += NR;
+    }
+    for (s = 0; s < NR; ++s) {
+	for (r__ = 0; r__ < MR; ++r__) {
+	    c__[r__ + s * ldc] += alpha * ab[s][r__];
+	}
+    }
+}
+
+static void dgemv_n_generic(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    doublereal t0, t1, t2, t3;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	t0 = alpha * x[j];
+	t1 = alpha * x[j + 1];
+	t2 = alpha * x[j + 2];
+	t3 = alpha * x[j + 3];
+	for (i__ = 0; i__ < m; ++i__) {
+	    y[i__] = y[i__] + t0 * a0[i__] + t1 * a1[i__] + t2 * a2[i__] + t3 *
+		     a3[i__];
+	}
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	t0 = alpha * x[j];
+	for (i__ = 0; i__ < m; ++i__) {
+	    y[i__] += t0 * a0[i__];
+	}
+    }
+}
+
+static void dgemv_t_generic(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    doublereal s0, s1, s2, s3;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	s0 = s1 = s2 = s3 = 0.;
+	for (i__ = 0; i__ < m; ++i__) {
+	    s0 += a0[i__] * x[i__];
+	    s1 += a1[i__] * x[i__];
+	    s2 += a2[i__] * x[i__];
+	    s3 += a3[i__] * x[i__];
+	}
+	y[j] += alpha * s0;
+	y[j + 1] += alpha * s1;
+	y[j + 2] += alpha * s2;
+	y[j + 3] += alpha * s3;
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	s0 = 0.;
+	for (i__ = 0; i__ < m; ++i__) {
+	    s0 += a0[i__] * x[i__];
+	}
+	y[j] += alpha * s0;
+    }
+}
+
+const dkernel dkernel_generic = {
+    BLAS_KERNEL_GENERIC, "generic",
+    MR, NR,
+    128, 256, 2040,
+    dgemm_generic_4x4, dgemv_n_generic, dgemv_t_generic
+};
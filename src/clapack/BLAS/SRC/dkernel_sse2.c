@@ -0,0 +1,182 @@
+/* SSE2 kernels for the blocked DGEMM and DGEMV.  SSE2 is part of x86-64,
+   so this file needs no special compiler flags there. */
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DKERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_kernels.h"
+#include "dkernel.h"
+
+#ifdef DKERNEL_SSE2
+
+/* 4 x 4 register block, eight accumulators of two doubles. */
+static void dgemm_sse2_4x4(integer k, doublereal alpha,
+	const doublereal *a, const doublereal *b, doublereal *c__,
+	integer ldc)
+{
+    integer l;
+    __m128d a0, a1, bj, av;
+    __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+    __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+    __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+    __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+
+    for (l = 0; l < k; ++l) {
+	a0 = _mm_loadu_pd(a);
+	a1 = _mm_loadu_pd(a + 2);
+	bj = _mm_load1_pd(b);
+	c00 = _mm_add_pd(c00, _mm_mul_pd(a0, bj));
+	c01 = _mm_add_pd(c01, _mm_mul_pd(a1, bj));
+	bj = _mm_load1_pd(b + 1);
+	c10 = _mm_add_pd(c10, _mm_mul_pd(a0, bj));
+	c11 = _mm_add_pd(c11, _mm_mul_pd(a1, bj));
+	bj = _mm_load1_pd(b + 2);
+	c20 = _mm_add_pd(c20, _mm_mul_pd(a0, bj));
+	c21 = _mm_add_pd(c21, _mm_mul_pd(a1, bj));
+	bj = _mm_load1_pd(b + 3);
+	c30 = _mm_add_pd(c30, _mm_mul_pd(a0, bj));
+	c31 = _mm_add_pd(c31, _mm_mul_pd(a1, bj));
+	a += 4;
+	b += 4;
+    }
+
+    av = _mm_set1_pd(alpha);
+#define DKERNEL_UPDATE(cp, acc) \
+    _mm_storeu_pd(cp, _mm_add_pd(_mm_loadu_pd(cp), _mm_mul_pd(av, acc)))
+    DKERNEL_UPDATE(c__, c00);
+    DKERNEL_UPDATE(c__ + 2, c01);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c10);
+    DKERNEL_UPDATE(c__ + 2, c11);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c20);
+    DKERNEL_UPDATE(c__ + 2, c21);
+    c__ += ldc;
+    DKERNEL_UPDATE(c__, c30);
+    DKERNEL_UPDATE(c__ + 2, c31);
+#undef DKERNEL_UPDATE
+}
+
+static void dgemv_n_sse2(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    __m128d t0, t1, t2, t3, yv;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	t0 = _mm_set1_pd(alpha * x[j]);
+	t1 = _mm_set1_pd(alpha * x[j + 1]);
+	t2 = _mm_set1_pd(alpha * x[j + 2]);
+	t3 = _mm_set1_pd(alpha * x[j + 3]);
+	for (i__ = 0; i__ + 2 <= m; i__ += 2) {
+	    yv = _mm_loadu_pd(y + i__);
+	    yv = _mm_add_pd(yv, _mm_mul_pd(t0, _mm_loadu_pd(a0 + i__)));
+	    yv = _mm_add_pd(yv, _mm_mul_pd(t1, _mm_loadu_pd(a1 + i__)));
+	    yv = _mm_add_pd(yv, _mm_mul_pd(t2, _mm_loadu_pd(a2 + i__)));
+	    yv = _mm_add_pd(yv, _mm_mul_pd(t3, _mm_loadu_pd(a3 + i__)));
+	    _mm_storeu_pd(y + i__, yv);
+	}
+	for (; i__ < m; ++i__) {
+	    y[i__] = y[i__] + alpha * x[j] * a0[i__] + alpha * x[j + 1] * a1[
+		    i__] + alpha * x[j + 2] * a2[i__] + alpha * x[j + 3] * a3[
+		    i__];
+	}
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	t0 = _mm_set1_pd(alpha * x[j]);
+	for (i__ = 0; i__ + 2 <= m; i__ += 2) {
+	    _mm_storeu_pd(y + i__, _mm_add_pd(_mm_loadu_pd(y + i__),
+		    _mm_mul_pd(t0, _mm_loadu_pd(a0 + i__))));
+	}
+	for (; i__ < m; ++i__) {
+	    y[i__] += alpha * x[j] * a0[i__];
+	}
+    }
+}
+
+static doublereal dkernel_sse2_sum(__m128d v)
+{
+    doublereal s[2];
+
+    _mm_storeu_pd(s, v);
+    return s[0] + s[1];
+}
+
+static void dgemv_t_sse2(integer m, integer n, doublereal alpha,
+	const doublereal *a, integer lda, const doublereal *x,
+	doublereal *y)
+{
+    integer i__, j;
+    doublereal r0, r1, r2, r3;
+    __m128d s0, s1, s2, s3, xv;
+    const doublereal *a0, *a1, *a2, *a3;
+
+    for (j = 0; j + 4 <= n; j += 4) {
+	a0 = a + j * lda;
+	a1 = a0 + lda;
+	a2 = a1 + lda;
+	a3 = a2 + lda;
+	s0 = s1 = s2 = s3 = _mm_setzero_pd();
+	for (i__ = 0; i__ + 2 <= m; i__ += 2) {
+	    xv = _mm_loadu_pd(x + i__);
+	    s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a0 + i__), xv));
+	    s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a1 + i__), xv));
+	    s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(a2 + i__), xv));
+	    s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(a3 + i__), xv));
+	}
+	r0 = dkernel_sse2_sum(s0);
+	r1 = dkernel_sse2_sum(s1);
+	r2 = dkernel_sse2_sum(s2);
+	r3 = dkernel_sse2_sum(s3);
+	for (; i__ < m; ++i__) {
+	    r0 += a0[i__] * x[i__];
+	    r1 += a1[i__] * x[i__];
+	    r2 += a2[i__] * x[i__];
+	    r3 += a3[i__] * x[i__];
+	}
+	y[j] += alpha * r0;
+	y[j + 1] += alpha * r1;
+	y[j + 2] += alpha * r2;
+	y[j + 3] += alpha * r3;
+    }
+    for (; j < n; ++j) {
+	a0 = a + j * lda;
+	s0 = _mm_setzero_pd();
+	for (i__ = 0; i__ + 2 <= m; i__ += 2) {
+	    s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a0 + i__),
+		    _mm_loadu_pd(x + i__)));
+	}
+	r0 = dkernel_sse2_sum(s0);
+	for (; i__ < m; ++i__) {
+	    r0 += a0[i__] * x[i__];
+	}
+	y[j] += alpha * r0;
+    }
+}
+
+static const dkernel dkernel_sse2_table = {
+    BLAS_KERNEL_SSE2, "sse2",
+    4, 4,
+    128, 256, 2040,
+    dgemm_sse2_4x4, dgemv_n_sse2, dgemv_t_sse2
+};
+
+const dkernel *const dkernel_sse2 = &dkernel_sse2_table;
+
+#else
+
+const dkernel *const dkernel_sse2 = NULL;
+
+#endif /* DKERNEL_SSE2 */
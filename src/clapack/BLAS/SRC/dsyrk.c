@@ -12,6 +12,7 @@
 
 #include "f2c.h"
 #include "blaswrap.h"
+#include "blas_threads.h"
 
 /* Subroutine */ int dsyrk_(char *uplo, char *trans, integer *n, integer *k, 
 	doublereal *alpha, doublereal *a, integer *lda, doublereal *beta, 
@@ -247,6 +248,13 @@
 	return 0;
     }
 
+/*     Split large updates over the BLAS threads. */
+
+    if (dsyrk_parallel__(uplo, trans, n, k, alpha, &a[a_offset], lda, beta, &
+	    c__[c_offset], ldc)) {
+	return 0;
+    }
+
 /*     Start the operations. */
 
     if (lsame_(trans, "N")) {
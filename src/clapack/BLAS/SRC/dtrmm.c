@@ -12,6 +12,7 @@
 
 #include "f2c.h"
 #include "blaswrap.h"
+#include "blas_threads.h"
 
 /* Subroutine */ int dtrmm_(char *side, char *uplo, char *transa, char *diag, 
 	integer *m, integer *n, doublereal *alpha, doublereal *a, integer *
@@ -228,6 +229,13 @@
 	return 0;
     }
 
+/*     Split large products over the BLAS threads. */
+
+    if (dtrmm_parallel__(side, uplo, transa, diag, m, n, alpha, &a[a_offset],
+	    lda, &b[b_offset], ldb)) {
+	return 0;
+    }
+
 /*     Start the operations. */
 
     if (lside) {
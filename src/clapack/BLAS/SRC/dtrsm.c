@@ -12,6 +12,7 @@
 
 #include "f2c.h"
 #include "blaswrap.h"
+#include "blas_threads.h"
 
 /* Subroutine */ int dtrsm_(char *side, char *uplo, char *transa, char *diag, 
 	integer *m, integer *n, doublereal *alpha, doublereal *a, integer *
@@ -231,6 +232,13 @@
 	return 0;
     }
 
+/*     Split large solves over the BLAS threads. */
+
+    if (dtrsm_parallel__(side, uplo, transa, diag, m, n, alpha, &a[a_offset],
+	    lda, &b[b_offset], ldb)) {
+	return 0;
+    }
+
 /*     Start the operations. */
 
     if (lside) {
@@ -0,0 +1,61 @@
+/* Kernel selection and threading for the optimised double precision BLAS
+ * routines.
+ *
+ * Unless CLAPACK was configured with CLAPACK_REFERENCE_BLAS, dgemm_ and
+ * dgemv_ hand large enough problems to cache blocked kernels.  The widest
+ * kernel supported by the processor is selected on first use, the
+ * CPU_FEATURES_DISPATCH environment variable of cpu_features ("baseline",
+ * "sse2", "avx2" or "avx512") limits that choice.  The functions below
+ * allow a program (f. ex. a benchmark) to query or override the choice.
+ * BLAS_KERNEL_REFERENCE always runs the f2c translated reference loops.
+ *
+ * dgemm_, dsyrk_, dtrmm_ and dtrsm_ split large calls by tiles of their
+ * output over a pool of threads once more than one thread is requested,
+ * either with blas_set_num_threads() or the CLAPACK_NUM_THREADS
+ * environment variable.  The partition depends only on the problem size
+ * and the number of threads, so results are reproducible for a fixed
+ * thread count.
+ */
+
+#ifndef __BLAS_KERNELS_H
+#define __BLAS_KERNELS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BLAS_KERNEL_AUTO      -1
+#define BLAS_KERNEL_REFERENCE  0
+#define BLAS_KERNEL_GENERIC    1
+#define BLAS_KERNEL_SSE2       2
+#define BLAS_KERNEL_AVX2       3
+#define BLAS_KERNEL_AVX512     4
+
+/* Selects the kernel used by dgemm_ and dgemv_.  BLAS_KERNEL_AUTO selects
+   the widest kernel supported by the processor.  Returns the kernel that
+   is in effect afterwards, which is the widest supported kernel not wider
+   than the one requested.  Must not be called while other threads call
+   dgemm_ or dgemv_. */
+int blas_set_kernel(int kernel);
+
+/* Returns the kernel used by dgemm_ and dgemv_. */
+int blas_get_kernel(void);
+
+/* Returns a short name for the kernel, f. ex. "avx2". */
+const char *blas_kernel_name(int kernel);
+
+/* Sets the number of threads used by the level 3 routines, 0 selects
+   the number of processors.  The default is 1, or the value of
+   CLAPACK_NUM_THREADS.  Returns the number of threads in effect, which is
+   always 1 if CLAPACK was built without thread support.  Must not be
+   called while other threads call the level 3 routines. */
+int blas_set_num_threads(int threads);
+
+/* Returns the number of threads used by the level 3 routines. */
+int blas_get_num_threads(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLAS_KERNELS_H */
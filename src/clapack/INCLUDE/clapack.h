@@ -2314,6 +2314,9 @@ doublereal clantr_(char *norm, char *uplo, char *diag, integer *m, integer *n,
 /* Subroutine */ int dgetrf_(integer *m, integer *n, doublereal *a, integer *
 	lda, integer *ipiv, integer *info);
 
+/* Subroutine */ int dgetrf2_(integer *m, integer *n, doublereal *a, integer *
+	lda, integer *ipiv, integer *info);
+
 /* Subroutine */ int dgetri_(integer *n, doublereal *a, integer *lda, integer 
 	*ipiv, doublereal *work, integer *lwork, integer *info);
 
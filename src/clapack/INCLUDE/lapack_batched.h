@@ -0,0 +1,56 @@
+/* Batched LU factorisation and solve of many small square matrices.
+ *
+ * dgetrf_batched and dgetrs_batched compute the same factorisation and
+ * solution as dgetrf_ and dgetrs_ for every matrix of a batch, without
+ * the per call argument checking and ilaenv lookups.  Matrices up to
+ * order 8 use kernels specialised for their size.  Large batches are
+ * split over the threads of the level 3 BLAS (see blas_kernels.h), the
+ * split depends only on the batch size and the number of threads.
+ *
+ * Two layouts are supported:
+ *
+ * LAPACK_BATCH_STRIDED      matrix k is column major with leading
+ *                           dimension lda and starts at a + k * stride;
+ *                           its pivots start at ipiv + k * n.
+ * LAPACK_BATCH_INTERLEAVED  element (i,j) of matrix k is stored at
+ *                           a[(i + j * lda) * batch + k] and pivot i at
+ *                           ipiv[i * batch + k], so that the same element
+ *                           of all matrices is contiguous; stride is
+ *                           ignored.  This layout lets the kernels work
+ *                           on many matrices with each SIMD instruction,
+ *                           which pays off for orders up to about 8.
+ *
+ * Indices are 0-based in these formulas, the pivots are 1-based as in
+ * dgetrf_.  The header needs f2c.h for the integer and doublereal types.
+ */
+
+#ifndef __LAPACK_BATCHED_H
+#define __LAPACK_BATCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LAPACK_BATCH_STRIDED      0
+#define LAPACK_BATCH_INTERLEAVED  1
+
+/* Computes the LU factorisation with partial pivoting of batch n x n
+   matrices.  info[k] is set like the INFO argument of dgetrf_ for matrix
+   k.  Returns 0, or -i if argument i had an illegal value, which is also
+   reported through xerbla_. */
+int dgetrf_batched(integer layout, integer n, doublereal *a, integer lda,
+	integer stride, integer *ipiv, integer *info, integer batch);
+
+/* Solves A * X = B or A' * X = B for each matrix of the batch, using the
+   factorisation computed by dgetrf_batched with the same layout.  B has
+   nrhs columns, matrix k of B starts at b + k * strideb in the strided
+   layout.  Returns 0, or -i if argument i had an illegal value. */
+int dgetrs_batched(integer layout, char *trans, integer n, integer nrhs,
+	doublereal *a, integer lda, integer stridea, integer *ipiv,
+	doublereal *b, integer ldb, integer strideb, integer batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LAPACK_BATCHED_H */
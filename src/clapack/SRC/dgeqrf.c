@@ -12,6 +12,7 @@
 
 #include "f2c.h"
 #include "blaswrap.h"
+#include "blas_threads.h"
 
 /* Table of constant values */
 
@@ -20,24 +21,53 @@ static integer c_n1 = -1;
 static integer c__3 = 3;
 static integer c__2 = 2;
 
+extern /* Subroutine */ int dlarfb_(char *, char *, char *, char *,
+	integer *, integer *, integer *, doublereal *, integer *,
+	doublereal *, integer *, doublereal *, integer *, doublereal *,
+	integer *);
+
+/* The application of a block reflector to the columns right of its
+   panel, shared by the column tiles it is split into.  Each tile is
+   updated by DLARFB with its own rows of the work array, so the tiles run
+   in parallel on the BLAS threads.  The split depends only on the sizes
+   and the number of threads. */
+typedef struct {
+    integer *m, *ib, *lda, *ldwork;
+    integer n, parts;
+    doublereal *v, *t, *c__, *work;
+} dgeqrf_update;
+
+static void dgeqrf_tile(void *arg, integer t)
+{
+    const dgeqrf_update *u = (const dgeqrf_update *) arg;
+    integer c0, nc;
+
+    c0 = blas_block_start__(u->n, u->parts, t);
+    nc = blas_block_start__(u->n, u->parts, t + 1) - c0;
+    if (nc == 0) {
+	return;
+    }
+    dlarfb_("Left", "Transpose", "Forward", "Columnwise", u->m, &nc, u->ib,
+	    u->v, u->lda, u->t, u->ldwork, u->c__ + c0 * *u->lda, u->lda,
+	    u->work + c0, u->ldwork);
+}
+
 /* Subroutine */ int dgeqrf_(integer *m, integer *n, doublereal *a, integer *
 	lda, doublereal *tau, doublereal *work, integer *lwork, integer *info)
 {
     /* System generated locals */
-    integer a_dim1, a_offset, i__1, i__2, i__3, i__4;
+    integer a_dim1, a_offset, i__1, i__2, i__3, i__4, i__5;
 
     /* Local variables */
     integer i__, k, ib, nb, nx, iws, nbmin, iinfo;
     extern /* Subroutine */ int dgeqr2_(integer *, integer *, doublereal *, 
-	    integer *, doublereal *, doublereal *, integer *), dlarfb_(char *, 
-	     char *, char *, char *, integer *, integer *, integer *, 
-	    doublereal *, integer *, doublereal *, integer *, doublereal *, 
-	    integer *, doublereal *, integer *), dlarft_(char *, char *, integer *, integer *, doublereal 
+	    integer *, doublereal *, doublereal *, integer *), dlarft_(char *, char *, integer *, integer *, doublereal 
 	    *, integer *, doublereal *, doublereal *, integer *), xerbla_(char *, integer *);
     extern integer ilaenv_(integer *, char *, char *, integer *, integer *, 
 	    integer *, integer *);
     integer ldwork, lwkopt;
     logical lquery;
+    dgeqrf_update update;
 
 
 /*  -- LAPACK routine (version 3.2) -- */
@@ -112,6 +142,10 @@ static integer c__2 = 2;
 /*  v(1:i-1) = 0 and v(i) = 1; v(i+1:m) is stored on exit in A(i+1:m,i), */
 /*  and tau in TAU(i). */
 
+/*  The blocked code applies each block reflector to the trailing */
+/*  matrix by column tiles, which run in parallel when the BLAS use more */
+/*  than one thread.  The result is the same for a fixed thread count. */
+
 /*  ===================================================================== */
 
 /*     .. Local Scalars .. */
@@ -220,14 +254,28 @@ static integer c__2 = 2;
 		dlarft_("Forward", "Columnwise", &i__3, &ib, &a[i__ + i__ * 
 			a_dim1], lda, &tau[i__], &work[1], &ldwork);
 
-/*              Apply H' to A(i:m,i+ib:n) from the left */
+/*              Apply H' to A(i:m,i+ib:n) from the left, by column */
+/*              tiles */
 
 		i__3 = *m - i__ + 1;
-		i__4 = *n - i__ - ib + 1;
-		dlarfb_("Left", "Transpose", "Forward", "Columnwise", &i__3, &
-			i__4, &ib, &a[i__ + i__ * a_dim1], lda, &work[1], &
-			ldwork, &a[i__ + (i__ + ib) * a_dim1], lda, &work[ib 
-			+ 1], &ldwork);
+		update.m = &i__3;
+		update.ib = &ib;
+		update.lda = lda;
+		update.ldwork = &ldwork;
+		update.n = *n - i__ - ib + 1;
+		update.v = &a[i__ + i__ * a_dim1];
+		update.t = &work[1];
+		update.c__ = &a[i__ + (i__ + ib) * a_dim1];
+		update.work = &work[ib + 1];
+		update.parts = 1;
+		if ((doublereal) i__3 * update.n * ib * 2. >=
+			BLAS_PARALLEL_MIN_FLOPS) {
+/* Computing MIN */
+		    i__4 = blas_parallel_threads__(), i__5 = 
+			    blas_block_count__(update.n);
+		    update.parts = min(i__4,i__5);
+		}
+		blas_parallel_run__(update.parts, dgeqrf_tile, &update);
 	    }
 /* L10: */
 	}
@@ -12,6 +12,7 @@
 
 #include "f2c.h"
 #include "blaswrap.h"
+#include "blas_threads.h"
 
 /* Table of constant values */
 
@@ -20,6 +21,55 @@ static integer c_n1 = -1;
 static doublereal c_b16 = 1.;
 static doublereal c_b19 = -1.;
 
+extern /* Subroutine */ int dgemm_(char *, char *, integer *, integer *,
+	integer *, doublereal *, doublereal *, integer *, doublereal *,
+	integer *, doublereal *, doublereal *, integer *);
+extern /* Subroutine */ int dtrsm_(char *, char *, char *, char *,
+	integer *, integer *, doublereal *, doublereal *, integer *,
+	doublereal *, integer *);
+extern /* Subroutine */ int dlaswp_(integer *, doublereal *, integer *,
+	integer *, integer *, integer *, integer *);
+
+/* The update of the columns right of a factored panel, shared by the
+   column tiles it is split into.  The tiles are independent, so they run
+   in parallel on the BLAS threads; each applies the interchanges, solves
+   for its part of the block row of U and updates its part of the
+   trailing submatrix.  The split depends only on the sizes and the number
+   of threads. */
+typedef struct {
+    integer *m, *j, *jb, *lda, *ipiv;
+    integer n, parts;
+    doublereal *a;
+} dgetrf_update;
+
+static void dgetrf_tile(void *arg, integer t)
+{
+    const dgetrf_update *u = (const dgetrf_update *) arg;
+    integer c0, nc, mr, k2;
+    const integer lda = *u->lda, j = *u->j, jb = *u->jb;
+    doublereal *b;
+
+/*     A is the matrix passed to DGETRF, B the first column of the tile. */
+
+    c0 = blas_block_start__(u->n, u->parts, t);
+    nc = blas_block_start__(u->n, u->parts, t + 1) - c0;
+    if (nc == 0) {
+	return;
+    }
+    b = u->a + (j + jb - 1 + c0) * lda;
+
+    k2 = j + jb - 1;
+    dlaswp_(&nc, b, u->lda, u->j, &k2, u->ipiv, &c__1);
+    dtrsm_("Left", "Lower", "No transpose", "Unit", u->jb, &nc, &c_b16,
+	    u->a + (j - 1) + (j - 1) * lda, u->lda, b + (j - 1), u->lda);
+    mr = *u->m - j - jb + 1;
+    if (mr > 0) {
+	dgemm_("No transpose", "No transpose", &mr, &nc, u->jb, &c_b19,
+		u->a + (j + jb - 1) + (j - 1) * lda, u->lda, b + (j - 1),
+		u->lda, &c_b16, b + (j + jb - 1), u->lda);
+    }
+}
+
 /* Subroutine */ int dgetrf_(integer *m, integer *n, doublereal *a, integer *
 	lda, integer *ipiv, integer *info)
 {
@@ -28,19 +78,12 @@ static doublereal c_b19 = -1.;
 
     /* Local variables */
     integer i__, j, jb, nb;
-    extern /* Subroutine */ int dgemm_(char *, char *, integer *, integer *, 
-	    integer *, doublereal *, doublereal *, integer *, doublereal *, 
-	    integer *, doublereal *, doublereal *, integer *);
     integer iinfo;
-    extern /* Subroutine */ int dtrsm_(char *, char *, char *, char *, 
-	    integer *, integer *, doublereal *, doublereal *, integer *, 
-	    doublereal *, integer *), dgetf2_(
-	    integer *, integer *, doublereal *, integer *, integer *, integer 
-	    *), xerbla_(char *, integer *);
+    extern /* Subroutine */ int dgetrf2_(integer *, integer *, doublereal *,
+	    integer *, integer *, integer *), xerbla_(char *, integer *);
     extern integer ilaenv_(integer *, char *, char *, integer *, integer *, 
 	    integer *, integer *);
-    extern /* Subroutine */ int dlaswp_(integer *, doublereal *, integer *, 
-	    integer *, integer *, integer *, integer *);
+    dgetrf_update update;
 
 
 /*  -- LAPACK routine (version 3.2) -- */
@@ -65,6 +108,9 @@ static doublereal c_b19 = -1.;
 /*  triangular (upper trapezoidal if m < n). */
 
 /*  This is the right-looking Level 3 BLAS version of the algorithm. */
+/*  The panels are factored by the recursive DGETRF2, and the update of */
+/*  the trailing submatrix is split into column tiles that run in */
+/*  parallel when the BLAS use more than one thread. */
 
 /*  Arguments */
 /*  ========= */
@@ -145,7 +191,7 @@ static doublereal c_b19 = -1.;
 
 /*        Use unblocked code. */
 
-	dgetf2_(m, n, &a[a_offset], lda, &ipiv[1], info);
+	dgetrf2_(m, n, &a[a_offset], lda, &ipiv[1], info);
     } else {
 
 /*        Use blocked code. */
@@ -161,7 +207,7 @@ static doublereal c_b19 = -1.;
 /*           singularity. */
 
 	    i__3 = *m - j + 1;
-	    dgetf2_(&i__3, &jb, &a[j + j * a_dim1], lda, &ipiv[j], &iinfo);
+	    dgetrf2_(&i__3, &jb, &a[j + j * a_dim1], lda, &ipiv[j], &iinfo);
 
 /*           Adjust INFO and the pivot indices. */
 
@@ -184,30 +230,25 @@ static doublereal c_b19 = -1.;
 
 	    if (j + jb <= *n) {
 
-/*              Apply interchanges to columns J+JB:N. */
-
-		i__3 = *n - j - jb + 1;
-		i__4 = j + jb - 1;
-		dlaswp_(&i__3, &a[(j + jb) * a_dim1 + 1], lda, &j, &i__4, &
-			ipiv[1], &c__1);
-
-/*              Compute block row of U. */
-
-		i__3 = *n - j - jb + 1;
-		dtrsm_("Left", "Lower", "No transpose", "Unit", &jb, &i__3, &
-			c_b16, &a[j + j * a_dim1], lda, &a[j + (j + jb) * 
-			a_dim1], lda);
-		if (j + jb <= *m) {
-
-/*                 Update trailing submatrix. */
-
-		    i__3 = *m - j - jb + 1;
-		    i__4 = *n - j - jb + 1;
-		    dgemm_("No transpose", "No transpose", &i__3, &i__4, &jb, 
-			    &c_b19, &a[j + jb + j * a_dim1], lda, &a[j + (j + 
-			    jb) * a_dim1], lda, &c_b16, &a[j + jb + (j + jb) *
-			     a_dim1], lda);
+/*              Apply interchanges to columns J+JB:N, compute block row */
+/*              of U and update trailing submatrix, by column tiles. */
+
+		update.m = m;
+		update.j = &j;
+		update.jb = &jb;
+		update.lda = lda;
+		update.ipiv = &ipiv[1];
+		update.n = *n - j - jb + 1;
+		update.a = &a[a_offset];
+		update.parts = 1;
+		if ((doublereal) (*m - j + 1) * update.n * jb >=
+			BLAS_PARALLEL_MIN_FLOPS) {
+/* Computing MIN */
+		    i__3 = blas_parallel_threads__(), i__4 = 
+			    blas_block_count__(update.n);
+		    update.parts = min(i__3,i__4);
 		}
+		blas_parallel_run__(update.parts, dgetrf_tile, &update);
 	    }
 /* L20: */
 	}
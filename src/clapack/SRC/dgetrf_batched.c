@@ -0,0 +1,301 @@
+/* LU factorisation of a batch of small matrices, see lapack_batched.h.
+
+   Every matrix is factored with the unblocked right-looking algorithm of
+   dgetf2_.  In the strided layout the kernel runs matrix by matrix; it is
+   instantiated for each order up to DGETRF_BATCHED_FIXED so that the
+   compiler can unroll its loops completely, and matrices larger than
+   DGETRF_BATCHED_NMAX are handed to dgetrf_.  In the interleaved layout the
+   innermost loops run over DGETRF_BATCHED_LANES matrices at a time and
+   only the pivot search and the row interchanges are done matrix by
+   matrix.
+*/
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "lapack_batched.h"
+#include "blas_threads.h"
+
+/* Orders with a kernel of their own. */
+#define DGETRF_BATCHED_FIXED 8
+
+/* Larger strided matrices are factored by dgetrf_. */
+#define DGETRF_BATCHED_NMAX 64
+
+/* Number of interleaved matrices factored together. */
+#define DGETRF_BATCHED_LANES 64
+
+#if defined(__GNUC__)
+#define DGETRF_BATCHED_INLINE static __inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define DGETRF_BATCHED_INLINE static __forceinline
+#else
+#define DGETRF_BATCHED_INLINE static
+#endif
+
+extern doublereal dlamch_(char *);
+extern /* Subroutine */ int dgetrf_(integer *, integer *, doublereal *,
+	integer *, integer *, integer *), xerbla_(char *, integer *);
+
+/* Factors the n x n matrix a, which is column major with leading
+   dimension lda, and stores 1-based pivots in ipiv. */
+DGETRF_BATCHED_INLINE void dgetrf_kernel(const integer n, doublereal *a,
+	const integer lda, integer *ipiv, integer *info, const doublereal
+	sfmin)
+{
+    integer i__, j, jj, p;
+    doublereal amax, t, r__;
+
+    *info = 0;
+    for (j = 0; j < n; ++j) {
+
+/*        Find the pivot and test for singularity. */
+
+	p = j;
+	amax = fabs(a[j + j * lda]);
+	for (i__ = j + 1; i__ < n; ++i__) {
+	    if (fabs(a[i__ + j * lda]) > amax) {
+		p = i__;
+		amax = fabs(a[i__ + j * lda]);
+	    }
+	}
+	ipiv[j] = p + 1;
+
+	if (a[p + j * lda] != 0.) {
+	    if (p != j) {
+		for (jj = 0; jj < n; ++jj) {
+		    t = a[j + jj * lda];
+		    a[j + jj * lda] = a[p + jj * lda];
+		    a[p + jj * lda] = t;
+		}
+	    }
+
+/*           Compute the elements j+1:n-1 of column j. */
+
+	    t = a[j + j * lda];
+	    if (fabs(t) >= sfmin) {
+		r__ = 1. / t;
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    a[i__ + j * lda] *= r__;
+		}
+	    } else {
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    a[i__ + j * lda] /= t;
+		}
+	    }
+	} else if (*info == 0) {
+	    *info = j + 1;
+	}
+
+/*        Update the trailing submatrix. */
+
+	for (jj = j + 1; jj < n; ++jj) {
+	    t = a[j + jj * lda];
+	    for (i__ = j + 1; i__ < n; ++i__) {
+		a[i__ + jj * lda] -= a[i__ + j * lda] * t;
+	    }
+	}
+    }
+}
+
+typedef void (*dgetrf_fixed_kernel)(doublereal *, integer, integer *,
+	integer *, doublereal);
+
+#define DGETRF_FIXED(N) \
+static void dgetrf_fixed_##N(doublereal *a, integer lda, integer *ipiv, \
+	integer *info, doublereal sfmin) \
+{ \
+    dgetrf_kernel(N, a, lda, ipiv, info, sfmin); \
+}
+
+DGETRF_FIXED(1)
+DGETRF_FIXED(2)
+DGETRF_FIXED(3)
+DGETRF_FIXED(4)
+DGETRF_FIXED(5)
+DGETRF_FIXED(6)
+DGETRF_FIXED(7)
+DGETRF_FIXED(8)
+
+static const dgetrf_fixed_kernel dgetrf_fixed[DGETRF_BATCHED_FIXED + 1] = {
+    NULL, dgetrf_fixed_1, dgetrf_fixed_2, dgetrf_fixed_3, dgetrf_fixed_4,
+    dgetrf_fixed_5, dgetrf_fixed_6, dgetrf_fixed_7, dgetrf_fixed_8
+};
+
+static void dgetrf_general(doublereal *a, integer n, integer lda,
+	integer *ipiv, integer *info, doublereal sfmin)
+{
+    dgetrf_kernel(n, a, lda, ipiv, info, sfmin);
+}
+
+/* Factors the interleaved matrices k0 .. k1-1. */
+static void dgetrf_interleaved(integer n, doublereal *a, integer lda,
+	integer *ipiv, integer *info, integer batch, integer k0, integer k1,
+	doublereal sfmin)
+{
+    integer i__, j, jj, k, l, p, lanes;
+    doublereal amax, t, *x, *y, *u;
+    doublereal r__[DGETRF_BATCHED_LANES];
+
+/*     Element (i,j) of matrix k is at a[(i + j*lda)*batch + k]. */
+
+#define A(i, j, k) a[((i) + (j) * lda) * batch + (k)]
+
+    for (k = k0; k < k1; k += DGETRF_BATCHED_LANES) {
+	lanes = min(DGETRF_BATCHED_LANES, k1 - k);
+	for (l = 0; l < lanes; ++l) {
+	    info[k + l] = 0;
+	}
+
+	for (j = 0; j < n; ++j) {
+
+/*           Find the pivots, interchange the rows and choose the */
+/*           factors the columns are scaled with. */
+
+	    for (l = 0; l < lanes; ++l) {
+		p = j;
+		amax = fabs(A(j, j, k + l));
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    if (fabs(A(i__, j, k + l)) > amax) {
+			p = i__;
+			amax = fabs(A(i__, j, k + l));
+		    }
+		}
+		ipiv[j * batch + k + l] = p + 1;
+
+		r__[l] = 1.;
+		if (A(p, j, k + l) != 0.) {
+		    if (p != j) {
+			for (jj = 0; jj < n; ++jj) {
+			    t = A(j, jj, k + l);
+			    A(j, jj, k + l) = A(p, jj, k + l);
+			    A(p, jj, k + l) = t;
+			}
+		    }
+		    t = A(j, j, k + l);
+		    if (fabs(t) >= sfmin) {
+			r__[l] = 1. / t;
+		    } else {
+			for (i__ = j + 1; i__ < n; ++i__) {
+			    A(i__, j, k + l) /= t;
+			}
+		    }
+		} else if (info[k + l] == 0) {
+		    info[k + l] = j + 1;
+		}
+	    }
+
+/*           Compute the elements j+1:n-1 of column j. */
+
+	    for (i__ = j + 1; i__ < n; ++i__) {
+		x = &A(i__, j, k);
+		for (l = 0; l < lanes; ++l) {
+		    x[l] *= r__[l];
+		}
+	    }
+
+/*           Update the trailing submatrices. */
+
+	    for (jj = j + 1; jj < n; ++jj) {
+		u = &A(j, jj, k);
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    x = &A(i__, j, k);
+		    y = &A(i__, jj, k);
+		    for (l = 0; l < lanes; ++l) {
+			y[l] -= x[l] * u[l];
+		    }
+		}
+	    }
+	}
+    }
+
+#undef A
+}
+
+/* The arguments of a batched call, shared by the tasks it is split into. */
+typedef struct {
+    integer layout, n, lda, stride, batch, parts;
+    doublereal *a;
+    integer *ipiv, *info;
+    doublereal sfmin;
+} dgetrf_batch;
+
+static void dgetrf_batch_task(void *arg, integer t)
+{
+    const dgetrf_batch *c__ = (const dgetrf_batch *) arg;
+    integer k, k0, k1, n, lda;
+
+    k0 = blas_block_start__(c__->batch, c__->parts, t);
+    k1 = blas_block_start__(c__->batch, c__->parts, t + 1);
+    if (c__->layout == LAPACK_BATCH_INTERLEAVED) {
+	dgetrf_interleaved(c__->n, c__->a, c__->lda, c__->ipiv, c__->info,
+		c__->batch, k0, k1, c__->sfmin);
+	return;
+    }
+
+    n = c__->n;
+    lda = c__->lda;
+    for (k = k0; k < k1; ++k) {
+	if (n <= DGETRF_BATCHED_FIXED) {
+	    dgetrf_fixed[n](c__->a + k * c__->stride, lda, c__->ipiv + k * n,
+		    c__->info + k, c__->sfmin);
+	} else if (n <= DGETRF_BATCHED_NMAX) {
+	    dgetrf_general(c__->a + k * c__->stride, n, lda, c__->ipiv + k *
+		    n, c__->info + k, c__->sfmin);
+	} else {
+	    dgetrf_(&n, &n, c__->a + k * c__->stride, &lda, c__->ipiv + k *
+		    n, c__->info + k);
+	}
+    }
+}
+
+int dgetrf_batched(integer layout, integer n, doublereal *a, integer lda,
+	integer stride, integer *ipiv, integer *info, integer batch)
+{
+    integer k, err;
+    dgetrf_batch call;
+
+    err = 0;
+    if (layout != LAPACK_BATCH_STRIDED && layout !=
+	    LAPACK_BATCH_INTERLEAVED) {
+	err = 1;
+    } else if (n < 0) {
+	err = 2;
+    } else if (lda < max(1,n)) {
+	err = 4;
+    } else if (layout == LAPACK_BATCH_STRIDED && stride < lda * n) {
+	err = 5;
+    } else if (batch < 0) {
+	err = 8;
+    }
+    if (err != 0) {
+	xerbla_("DGETRF_BATCHED", &err);
+	return -err;
+    }
+
+    if (n == 0) {
+	for (k = 0; k < batch; ++k) {
+	    info[k] = 0;
+	}
+	return 0;
+    }
+
+    call.layout = layout;
+    call.n = n;
+    call.a = a;
+    call.lda = lda;
+    call.stride = stride;
+    call.ipiv = ipiv;
+    call.info = info;
+    call.batch = batch;
+    call.sfmin = dlamch_("S");
+    call.parts = 1;
+    if ((doublereal) batch * n * n * n * (2. / 3.) >=
+	    BLAS_PARALLEL_MIN_FLOPS) {
+	call.parts = min(blas_parallel_threads__(), blas_block_count__(batch));
+    }
+    blas_parallel_run__(call.parts, dgetrf_batch_task, &call);
+    return 0;
+}
@@ -0,0 +1,339 @@
+/* Solution of a batch of small systems factored by dgetrf_batched, see
+   lapack_batched.h.
+
+   Every system is solved with the interchanges and the two triangular
+   solves of dgetrs_, done column by column of the right hand sides as in
+   the reference dtrsm_.  In the strided layout the kernel runs system by
+   system and is instantiated for each order up to DGETRS_BATCHED_FIXED;
+   systems larger than DGETRS_BATCHED_NMAX are handed to dgetrs_.  In the
+   interleaved layout the innermost loops run over the systems and only the
+   interchanges are done system by system.
+*/
+
+#include <stdlib.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "lapack_batched.h"
+#include "blas_threads.h"
+
+/* Orders with a kernel of their own. */
+#define DGETRS_BATCHED_FIXED 8
+
+/* Larger strided systems are solved by dgetrs_. */
+#define DGETRS_BATCHED_NMAX 64
+
+#if defined(__GNUC__)
+#define DGETRS_BATCHED_INLINE static __inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define DGETRS_BATCHED_INLINE static __forceinline
+#else
+#define DGETRS_BATCHED_INLINE static
+#endif
+
+extern logical lsame_(char *, char *);
+extern /* Subroutine */ int dgetrs_(char *, integer *, integer *,
+	doublereal *, integer *, integer *, doublereal *, integer *,
+	integer *), xerbla_(char *, integer *);
+
+/* Solves with the factors in a and the pivots in ipiv for the nrhs
+   columns of b. */
+DGETRS_BATCHED_INLINE void dgetrs_kernel(const integer n, logical notran,
+	const doublereal *a, const integer lda, const integer *ipiv,
+	doublereal *b, const integer ldb, const integer nrhs)
+{
+    integer i__, j, c__, p;
+    doublereal t, *x;
+
+    for (c__ = 0; c__ < nrhs; ++c__) {
+	x = b + c__ * ldb;
+	if (notran) {
+
+/*           Solve L * U * x = P' * b. */
+
+	    for (i__ = 0; i__ < n; ++i__) {
+		p = ipiv[i__] - 1;
+		if (p != i__) {
+		    t = x[i__];
+		    x[i__] = x[p];
+		    x[p] = t;
+		}
+	    }
+	    for (j = 0; j < n; ++j) {
+		t = x[j];
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    x[i__] -= t * a[i__ + j * lda];
+		}
+	    }
+	    for (j = n - 1; j >= 0; --j) {
+		x[j] /= a[j + j * lda];
+		t = x[j];
+		for (i__ = 0; i__ < j; ++i__) {
+		    x[i__] -= t * a[i__ + j * lda];
+		}
+	    }
+	} else {
+
+/*           Solve U' * L' * y = b, x = P * y. */
+
+	    for (j = 0; j < n; ++j) {
+		t = x[j];
+		for (i__ = 0; i__ < j; ++i__) {
+		    t -= a[i__ + j * lda] * x[i__];
+		}
+		x[j] = t / a[j + j * lda];
+	    }
+	    for (j = n - 1; j >= 0; --j) {
+		t = x[j];
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    t -= a[i__ + j * lda] * x[i__];
+		}
+		x[j] = t;
+	    }
+	    for (i__ = n - 1; i__ >= 0; --i__) {
+		p = ipiv[i__] - 1;
+		if (p != i__) {
+		    t = x[i__];
+		    x[i__] = x[p];
+		    x[p] = t;
+		}
+	    }
+	}
+    }
+}
+
+typedef void (*dgetrs_fixed_kernel)(logical, const doublereal *, integer,
+	const integer *, doublereal *, integer, integer);
+
+#define DGETRS_FIXED(N) \
+static void dgetrs_fixed_##N(logical notran, const doublereal *a, \
+	integer lda, const integer *ipiv, doublereal *b, integer ldb, \
+	integer nrhs) \
+{ \
+    dgetrs_kernel(N, notran, a, lda, ipiv, b, ldb, nrhs); \
+}
+
+DGETRS_FIXED(1)
+DGETRS_FIXED(2)
+DGETRS_FIXED(3)
+DGETRS_FIXED(4)
+DGETRS_FIXED(5)
+DGETRS_FIXED(6)
+DGETRS_FIXED(7)
+DGETRS_FIXED(8)
+
+static const dgetrs_fixed_kernel dgetrs_fixed[DGETRS_BATCHED_FIXED + 1] = {
+    NULL, dgetrs_fixed_1, dgetrs_fixed_2, dgetrs_fixed_3, dgetrs_fixed_4,
+    dgetrs_fixed_5, dgetrs_fixed_6, dgetrs_fixed_7, dgetrs_fixed_8
+};
+
+static void dgetrs_general(integer n, logical notran, const doublereal *a,
+	integer lda, const integer *ipiv, doublereal *b, integer ldb,
+	integer nrhs)
+{
+    dgetrs_kernel(n, notran, a, lda, ipiv, b, ldb, nrhs);
+}
+
+/* Applies the interchanges of the interleaved systems k0 .. k1-1 to the
+   right hand side columns, forwards or backwards. */
+static void dgetrs_swap(integer n, const integer *ipiv, doublereal *b,
+	integer ldb, integer nrhs, integer batch, integer k0, integer k1,
+	logical forward)
+{
+    integer i__, c__, k, p, s;
+    doublereal t;
+
+    for (k = k0; k < k1; ++k) {
+	for (s = 0; s < n; ++s) {
+	    i__ = forward ? s : n - 1 - s;
+	    p = ipiv[i__ * batch + k] - 1;
+	    if (p != i__) {
+		for (c__ = 0; c__ < nrhs; ++c__) {
+		    t = b[(i__ + c__ * ldb) * batch + k];
+		    b[(i__ + c__ * ldb) * batch + k] = b[(p + c__ * ldb) * batch
+			    + k];
+		    b[(p + c__ * ldb) * batch + k] = t;
+		}
+	    }
+	}
+    }
+}
+
+/* Solves the interleaved systems k0 .. k1-1. */
+static void dgetrs_interleaved(integer n, logical notran, const doublereal
+	*a, integer lda, const integer *ipiv, doublereal *b, integer ldb,
+	integer nrhs, integer batch, integer k0, integer k1)
+{
+    integer i__, j, c__, k;
+    const doublereal *l, *u;
+    doublereal *x, *y;
+
+/*     Element (i,j) of matrix k is at a[(i + j*lda)*batch + k]. */
+
+#define A(i, j) (a + ((i) + (j) * lda) * batch)
+#define B(i, j) (b + ((i) + (j) * ldb) * batch)
+
+    if (notran) {
+	dgetrs_swap(n, ipiv, b, ldb, nrhs, batch, k0, k1, TRUE_);
+    }
+    for (c__ = 0; c__ < nrhs; ++c__) {
+	if (notran) {
+	    for (j = 0; j < n; ++j) {
+		y = B(j, c__);
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    x = B(i__, c__);
+		    l = A(i__, j);
+		    for (k = k0; k < k1; ++k) {
+			x[k] -= y[k] * l[k];
+		    }
+		}
+	    }
+	    for (j = n - 1; j >= 0; --j) {
+		y = B(j, c__);
+		u = A(j, j);
+		for (k = k0; k < k1; ++k) {
+		    y[k] /= u[k];
+		}
+		for (i__ = 0; i__ < j; ++i__) {
+		    x = B(i__, c__);
+		    u = A(i__, j);
+		    for (k = k0; k < k1; ++k) {
+			x[k] -= y[k] * u[k];
+		    }
+		}
+	    }
+	} else {
+	    for (j = 0; j < n; ++j) {
+		y = B(j, c__);
+		for (i__ = 0; i__ < j; ++i__) {
+		    x = B(i__, c__);
+		    u = A(i__, j);
+		    for (k = k0; k < k1; ++k) {
+			y[k] -= u[k] * x[k];
+		    }
+		}
+		u = A(j, j);
+		for (k = k0; k < k1; ++k) {
+		    y[k] /= u[k];
+		}
+	    }
+	    for (j = n - 1; j >= 0; --j) {
+		y = B(j, c__);
+		for (i__ = j + 1; i__ < n; ++i__) {
+		    x = B(i__, c__);
+		    l = A(i__, j);
+		    for (k = k0; k < k1; ++k) {
+			y[k] -= l[k] * x[k];
+		    }
+		}
+	    }
+	}
+    }
+    if (! notran) {
+	dgetrs_swap(n, ipiv, b, ldb, nrhs, batch, k0, k1, FALSE_);
+    }
+
+#undef A
+#undef B
+}
+
+/* The arguments of a batched call, shared by the tasks it is split into. */
+typedef struct {
+    integer layout, n, nrhs, lda, stridea, ldb, strideb, batch, parts;
+    char *trans;
+    logical notran;
+    doublereal *a, *b;
+    integer *ipiv;
+} dgetrs_batch;
+
+static void dgetrs_batch_task(void *arg, integer t)
+{
+    const dgetrs_batch *c__ = (const dgetrs_batch *) arg;
+    integer k, k0, k1, n, nrhs, lda, ldb, info;
+
+    k0 = blas_block_start__(c__->batch, c__->parts, t);
+    k1 = blas_block_start__(c__->batch, c__->parts, t + 1);
+    n = c__->n;
+    nrhs = c__->nrhs;
+    lda = c__->lda;
+    ldb = c__->ldb;
+    if (c__->layout == LAPACK_BATCH_INTERLEAVED) {
+	dgetrs_interleaved(n, c__->notran, c__->a, lda, c__->ipiv, c__->b,
+		ldb, nrhs, c__->batch, k0, k1);
+	return;
+    }
+
+    for (k = k0; k < k1; ++k) {
+	if (n <= DGETRS_BATCHED_FIXED) {
+	    dgetrs_fixed[n](c__->notran, c__->a + k * c__->stridea, lda,
+		    c__->ipiv + k * n, c__->b + k * c__->strideb, ldb, nrhs);
+	} else if (n <= DGETRS_BATCHED_NMAX) {
+	    dgetrs_general(n, c__->notran, c__->a + k * c__->stridea, lda,
+		    c__->ipiv + k * n, c__->b + k * c__->strideb, ldb, nrhs);
+	} else {
+	    dgetrs_(c__->trans, &n, &nrhs, c__->a + k * c__->stridea, &lda,
+		    c__->ipiv + k * n, c__->b + k * c__->strideb, &ldb, &info);
+	}
+    }
+}
+
+int dgetrs_batched(integer layout, char *trans, integer n, integer nrhs,
+	doublereal *a, integer lda, integer stridea, integer *ipiv,
+	doublereal *b, integer ldb, integer strideb, integer batch)
+{
+    integer err;
+    logical notran;
+    dgetrs_batch call;
+
+    err = 0;
+    notran = lsame_(trans, "N");
+    if (layout != LAPACK_BATCH_STRIDED && layout !=
+	    LAPACK_BATCH_INTERLEAVED) {
+	err = 1;
+    } else if (! notran && ! lsame_(trans, "T") && ! lsame_(
+	    trans, "C")) {
+	err = 2;
+    } else if (n < 0) {
+	err = 3;
+    } else if (nrhs < 0) {
+	err = 4;
+    } else if (lda < max(1,n)) {
+	err = 6;
+    } else if (layout == LAPACK_BATCH_STRIDED && stridea < lda * n) {
+	err = 7;
+    } else if (ldb < max(1,n)) {
+	err = 10;
+    } else if (layout == LAPACK_BATCH_STRIDED && strideb < ldb * nrhs) {
+	err = 11;
+    } else if (batch < 0) {
+	err = 12;
+    }
+    if (err != 0) {
+	xerbla_("DGETRS_BATCHED", &err);
+	return -err;
+    }
+
+    if (n == 0 || nrhs == 0) {
+	return 0;
+    }
+
+    call.layout = layout;
+    call.trans = trans;
+    call.notran = notran;
+    call.n = n;
+    call.nrhs = nrhs;
+    call.a = a;
+    call.lda = lda;
+    call.stridea = stridea;
+    call.ipiv = ipiv;
+    call.b = b;
+    call.ldb = ldb;
+    call.strideb = strideb;
+    call.batch = batch;
+    call.parts = 1;
+    if ((doublereal) batch * n * n * nrhs * 2. >= BLAS_PARALLEL_MIN_FLOPS) {
+	call.parts = min(blas_parallel_threads__(), blas_block_count__(batch));
+    }
+    blas_parallel_run__(call.parts, dgetrs_batch_task, &call);
+    return 0;
+}
@@ -0,0 +1,82 @@
+/* Block sizes of the LU and QR factorisations derived from the cache sizes
+   of the processor, used by ilaenv_ for xGETRF and the xGEQRF family.
+
+   The LU factorisation is done with Level 3 BLAS throughout, its block
+   size is chosen such that a panel of 16 nb x nb blocks, the height of a
+   mid-size matrix, stays in the level 2 cache while it is factored and
+   applied to the trailing matrix.  The QR panels are factored with Level 2
+   BLAS and carry the triangular factor of the block reflector, so their
+   block size is chosen such that three nb x nb blocks fit the level 1 data
+   cache.  Without cpu_features, or when the cache sizes are unknown, the
+   LAPACK defaults are kept.
+*/
+
+#include <math.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "blas_threads.h"
+
+#if defined(CLAPACK_WITH_CPU_FEATURES) && (defined(__x86_64__) || \
+    defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define ILAENV_X86_CACHE_PROBE
+#include "cpuinfo_x86.h"
+#endif
+
+/* Block sizes are multiples of ILAENV_NB_UNIT within these bounds. */
+#define ILAENV_NB_UNIT 16
+#define ILAENV_LU_NB_MIN 32
+#define ILAENV_LU_NB_MAX 256
+#define ILAENV_QR_NB_MIN 16
+#define ILAENV_QR_NB_MAX 64
+
+/* Sizes of the level 1 data and level 2 caches in bytes, 0 if unknown.
+   They are probed by the first call. */
+static integer ilaenv_l1_size = 0;
+static integer ilaenv_l2_size = 0;
+static blas_once_flag ilaenv_probe_once = BLAS_ONCE_INIT;
+
+static void ilaenv_probe_caches(void)
+{
+#ifdef ILAENV_X86_CACHE_PROBE
+    const CacheInfo info = GetX86CacheInfo();
+    int i__;
+
+    for (i__ = 0; i__ < info.size; ++i__) {
+	if (info.levels[i__].cache_type == CPU_FEATURE_CACHE_DATA ||
+		info.levels[i__].cache_type == CPU_FEATURE_CACHE_UNIFIED) {
+	    if (info.levels[i__].level == 1) {
+		ilaenv_l1_size = info.levels[i__].cache_size;
+	    } else if (info.levels[i__].level == 2) {
+		ilaenv_l2_size = info.levels[i__].cache_size;
+	    }
+	}
+    }
+#endif
+}
+
+/* The largest multiple of ILAENV_NB_UNIT such that the given number of
+   nb x nb blocks fit size bytes, within the bounds. */
+static integer ilaenv_fit(integer size, doublereal blocks, integer nbmin,
+	integer nbmax)
+{
+    integer nb;
+
+    nb = (integer) sqrt(size / (blocks * sizeof(doublereal)));
+    nb = nb / ILAENV_NB_UNIT * ILAENV_NB_UNIT;
+    return max(nbmin, min(nbmax, nb));
+}
+
+/* Returns the block size for an LU (qr = FALSE_) or QR (qr = TRUE_)
+   factorisation, or nb if the size of the cache it depends on is unknown. */
+integer ilaenv_cache_nb__(integer nb, logical qr)
+{
+    blas_once__(&ilaenv_probe_once, ilaenv_probe_caches);
+
+    if (qr) {
+	return ilaenv_l1_size > 0 ? ilaenv_fit(ilaenv_l1_size, 3.,
+		ILAENV_QR_NB_MIN, ILAENV_QR_NB_MAX) : nb;
+    }
+    return ilaenv_l2_size > 0 ? ilaenv_fit(ilaenv_l2_size, 16.,
+	    ILAENV_LU_NB_MIN, ILAENV_LU_NB_MAX) : nb;
+}
@@ -0,0 +1,400 @@
+/* Tests dgetrf_batched and dgetrs_batched against dgetrf_ and dgetrs_.
+
+   usage: xbatchtstd
+
+   For both layouts, every order of the fixed size kernels, orders of the
+   general kernel and orders above DGETRF_BATCHED_NMAX (which dgetrf_
+   factors in the strided layout), a batch of random matrices is factored
+   and solved with trans = 'N' and 'T'.  Every batch holds one matrix
+   whose column n/2 is zero, and the batches are factored on one and on
+   four threads; the large batches are split over the threads.
+
+   For each matrix the test checks that
+       info equals the INFO returned by dgetrf_ for the same matrix,
+       ipiv equals the pivots of dgetrf_ for the nonsingular matrices,
+       norm(P*A - L*U) / (n * norm(A) * eps) < THRESH,
+       norm(op(A)*X - B) / (n * norm(A) * norm(X) * eps) < THRESH
+   with max norms, the solve only for the nonsingular matrices.  The
+   program prints one line per order and layout and returns the number
+   of failed checks.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "clapack.h"
+#include "blas_kernels.h"
+#include "lapack_batched.h"
+
+#define THRESH 100.
+
+/* The right hand sides of the solves. */
+#define NRHS 3
+
+static void batch_fill(doublereal *v, integer n)
+{
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+	v[i__] = (doublereal) rand() / RAND_MAX - .5;
+    }
+}
+
+static double batch_norm(const doublereal *a, integer m, integer n,
+	integer lda)
+{
+    integer i__, j;
+    double norm = 0.;
+
+    for (j = 0; j < n; ++j) {
+	for (i__ = 0; i__ < m; ++i__) {
+	    if (fabs(a[i__ + j * lda]) > norm) {
+		norm = fabs(a[i__ + j * lda]);
+	    }
+	}
+    }
+    return norm;
+}
+
+/* Returns norm(P*A - L*U) / (n * norm(A) * eps) for the factors in lu. */
+static double batch_lu_ratio(integer n, const doublereal *a,
+	const doublereal *lu, integer lda, const integer *ipiv)
+{
+    integer i__, j, l;
+    doublereal *pa, t, s;
+    double diff = 0., anorm;
+
+    pa = (doublereal *) malloc(n * n * sizeof(doublereal));
+    for (j = 0; j < n; ++j) {
+	for (i__ = 0; i__ < n; ++i__) {
+	    pa[i__ + j * n] = a[i__ + j * lda];
+	}
+    }
+    for (i__ = 0; i__ < n; ++i__) {
+	if (ipiv[i__] - 1 != i__) {
+	    for (j = 0; j < n; ++j) {
+		t = pa[i__ + j * n];
+		pa[i__ + j * n] = pa[ipiv[i__] - 1 + j * n];
+		pa[ipiv[i__] - 1 + j * n] = t;
+	    }
+	}
+    }
+    for (j = 0; j < n; ++j) {
+	for (i__ = 0; i__ < n; ++i__) {
+	    s = i__ <= j ? lu[i__ + j * lda] : 0.;
+	    for (l = 0; l < min(i__, j + 1); ++l) {
+		s += lu[i__ + l * lda] * lu[l + j * lda];
+	    }
+	    if (fabs(pa[i__ + j * n] - s) > diff) {
+		diff = fabs(pa[i__ + j * n] - s);
+	    }
+	}
+    }
+    free(pa);
+
+    anorm = batch_norm(a, n, n, lda);
+    return anorm > 0. ? diff / (n * anorm * dlamch_("E")) : diff;
+}
+
+/* Returns norm(op(A)*X - B) / (n * norm(A) * norm(X) * eps). */
+static double batch_solve_ratio(const char *trans, integer n,
+	const doublereal *a, integer lda, const doublereal *x,
+	const doublereal *b, integer ldb)
+{
+    integer i__, j, l;
+    doublereal s;
+    double diff = 0., anorm, xnorm;
+
+    for (j = 0; j < NRHS; ++j) {
+	for (i__ = 0; i__ < n; ++i__) {
+	    s = -b[i__ + j * ldb];
+	    for (l = 0; l < n; ++l) {
+		s += (*trans == 'N' ? a[i__ + l * lda] : a[l + i__ * lda]) *
+			x[l + j * ldb];
+	    }
+	    if (fabs(s) > diff) {
+		diff = fabs(s);
+	    }
+	}
+    }
+
+    anorm = batch_norm(a, n, n, lda);
+    xnorm = batch_norm(x, n, NRHS, ldb);
+    return anorm * xnorm > 0. ? diff / (n * anorm * xnorm * dlamch_("E")) :
+	    diff;
+}
+
+/* Copies the strided matrices to the interleaved layout (to == 1) or back. */
+static void batch_interleave(int to, integer n, doublereal *a, integer lda,
+	integer stride, doublereal *v, integer ldv, integer batch)
+{
+    integer i__, j, k;
+
+    for (k = 0; k < batch; ++k) {
+	for (j = 0; j < n; ++j) {
+	    for (i__ = 0; i__ < n; ++i__) {
+		if (to) {
+		    v[(i__ + j * ldv) * batch + k] = a[i__ + j * lda + k *
+			    stride];
+		} else {
+		    a[i__ + j * lda + k * stride] = v[(i__ + j * ldv) * batch
+			    + k];
+		}
+	    }
+	}
+    }
+}
+
+/* Factors and solves one batch and returns the number of failed checks. */
+static int batch_check(integer layout, integer n, integer batch, int threads)
+{
+    static char *trans[2] = { "N", "T" };
+    integer lda, stride, ldb, strideb, i__, j, k, r__, ret, info, one = 1;
+    integer *ipiv, *ipivb, *infob, *ipivr, *infor;
+    doublereal *a, *lu, *ref, *b, *x, *xb, *v, *w;
+    double ratio, lumax = 0., solmax = 0.;
+    int fails = 0, singular;
+
+    lda = n + 1;
+    stride = lda * n + 3;
+    ldb = n + 2;
+    strideb = ldb * NRHS + 1;
+
+    a = (doublereal *) malloc(stride * batch * sizeof(doublereal));
+    lu = (doublereal *) malloc(stride * batch * sizeof(doublereal));
+    ref = (doublereal *) malloc(stride * batch * sizeof(doublereal));
+    b = (doublereal *) malloc(strideb * batch * sizeof(doublereal));
+    x = (doublereal *) malloc(strideb * batch * sizeof(doublereal));
+    xb = (doublereal *) malloc(strideb * batch * sizeof(doublereal));
+    ipiv = (integer *) malloc(n * batch * sizeof(integer));
+    ipivb = (integer *) malloc(n * batch * sizeof(integer));
+    ipivr = (integer *) malloc(n * batch * sizeof(integer));
+    infob = (integer *) malloc(batch * sizeof(integer));
+    infor = (integer *) malloc(batch * sizeof(integer));
+    v = (doublereal *) malloc(lda * n * batch * sizeof(doublereal));
+    w = (doublereal *) malloc(ldb * NRHS * batch * sizeof(doublereal));
+    if (a == NULL || lu == NULL || ref == NULL || b == NULL || x == NULL ||
+	    xb == NULL || ipiv == NULL || ipivb == NULL || ipivr == NULL ||
+	    infob == NULL || infor == NULL || v == NULL || w == NULL) {
+	fprintf(stderr, "out of memory for n = %ld\n", (long) n);
+	exit(1);
+    }
+
+    batch_fill(a, stride * batch);
+    batch_fill(b, strideb * batch);
+
+/*     Make the matrix in the middle of the batch singular. */
+
+    singular = batch / 2;
+    for (i__ = 0; i__ < n; ++i__) {
+	a[i__ + n / 2 * lda + singular * stride] = 0.;
+    }
+
+/*     The reference factors. */
+
+    for (k = 0; k < stride * batch; ++k) {
+	ref[k] = a[k];
+    }
+    for (k = 0; k < batch; ++k) {
+	dgetrf_(&n, &n, ref + k * stride, &lda, ipivr + k * n, infor + k);
+    }
+
+/*     The batched factors, copied back to the strided layout. */
+
+    blas_set_num_threads(threads);
+    for (k = 0; k < stride * batch; ++k) {
+	lu[k] = a[k];
+    }
+    if (layout == LAPACK_BATCH_STRIDED) {
+	ret = dgetrf_batched(layout, n, lu, lda, stride, ipivb, infob,
+		batch);
+	for (k = 0; k < n * batch; ++k) {
+	    ipiv[k] = ipivb[k];
+	}
+    } else {
+	batch_interleave(1, n, a, lda, stride, v, lda, batch);
+	ret = dgetrf_batched(layout, n, v, lda, 0, ipivb, infob, batch);
+	batch_interleave(0, n, lu, lda, stride, v, lda, batch);
+	for (k = 0; k < batch; ++k) {
+	    for (i__ = 0; i__ < n; ++i__) {
+		ipiv[i__ + k * n] = ipivb[i__ * batch + k];
+	    }
+	}
+    }
+    if (ret != 0) {
+	printf("dgetrf_batched returned %ld for n = %ld\n", (long) ret,
+		(long) n);
+	++fails;
+    }
+
+    for (k = 0; k < batch; ++k) {
+	if (infob[k] != infor[k]) {
+	    printf("n = %ld matrix %ld: info = %ld, dgetrf_ returned %ld\n",
+		    (long) n, (long) k, (long) infob[k], (long) infor[k]);
+	    ++fails;
+	}
+	if (infor[k] == 0) {
+	    for (i__ = 0; i__ < n; ++i__) {
+		if (ipiv[i__ + k * n] != ipivr[i__ + k * n]) {
+		    printf("n = %ld matrix %ld: ipiv(%ld) = %ld, dgetrf_ "
+			    "chose %ld\n", (long) n, (long) k, (long) i__ +
+			    1, (long) ipiv[i__ + k * n], (long) ipivr[i__ +
+			    k * n]);
+		    ++fails;
+		    break;
+		}
+	    }
+	}
+	ratio = batch_lu_ratio(n, a + k * stride, lu + k * stride, lda, ipiv
+		+ k * n);
+	if (ratio > lumax) {
+	    lumax = ratio;
+	}
+	if (!(ratio < THRESH)) {
+	    printf("n = %ld matrix %ld: LU residual ratio %g\n", (long) n,
+		    (long) k, ratio);
+	    ++fails;
+	}
+    }
+
+/*     Solve with both transposes using the factors of dgetrf_batched. */
+
+    for (j = 0; j < 2; ++j) {
+	for (k = 0; k < strideb * batch; ++k) {
+	    x[k] = b[k];
+	}
+	if (layout == LAPACK_BATCH_STRIDED) {
+	    ret = dgetrs_batched(layout, trans[j], n, NRHS, lu, lda, stride,
+		    ipiv, x, ldb, strideb, batch);
+	} else {
+
+/*           v still holds the interleaved factors. */
+
+	    for (k = 0; k < batch; ++k) {
+		for (r__ = 0; r__ < NRHS; ++r__) {
+		    for (i__ = 0; i__ < n; ++i__) {
+			w[(i__ + r__ * ldb) * batch + k] = x[i__ + r__ * ldb +
+				k * strideb];
+		    }
+		}
+	    }
+	    ret = dgetrs_batched(layout, trans[j], n, NRHS, v, lda, 0, ipivb,
+		    w, ldb, 0, batch);
+	    for (k = 0; k < batch; ++k) {
+		for (r__ = 0; r__ < NRHS; ++r__) {
+		    for (i__ = 0; i__ < n; ++i__) {
+			x[i__ + r__ * ldb + k * strideb] = w[(i__ + r__ *
+				ldb) * batch + k];
+		    }
+		}
+	    }
+	}
+	if (ret != 0) {
+	    printf("dgetrs_batched returned %ld for n = %ld\n", (long) ret,
+		    (long) n);
+	    ++fails;
+	}
+
+	for (k = 0; k < batch; ++k) {
+	    if (infor[k] != 0) {
+		continue;
+	    }
+	    ratio = batch_solve_ratio(trans[j], n, a + k * stride, lda, x + k
+		    * strideb, b + k * strideb, ldb);
+	    if (ratio > solmax) {
+		solmax = ratio;
+	    }
+	    if (!(ratio < THRESH)) {
+		printf("n = %ld matrix %ld trans = %s: solve residual ratio "
+			"%g\n", (long) n, (long) k, trans[j], ratio);
+		++fails;
+	    }
+
+/*           The first solution agrees with dgetrs_ on the factors of */
+/*           dgetrf_. */
+
+	    for (i__ = 0; i__ < n; ++i__) {
+		xb[i__] = b[i__ + k * strideb];
+	    }
+	    dgetrs_(trans[j], &n, &one, ref + k * stride, &lda, ipivr + k *
+		    n, xb, &n, &info);
+	    for (i__ = 0; i__ < n; ++i__) {
+		if (fabs(xb[i__] - x[i__ + k * strideb]) > 1e-8 * (1. +
+			fabs(xb[i__]))) {
+		    printf("n = %ld matrix %ld trans = %s: x(%ld) = %g, "
+			    "dgetrs_ returned %g\n", (long) n, (long) k,
+			    trans[j], (long) i__ + 1, x[i__ + k * strideb],
+			    xb[i__]);
+		    ++fails;
+		    break;
+		}
+	    }
+	}
+    }
+
+    printf("%-12s %4ld %6ld %8d %12.2f %12.2f %s\n", layout ==
+	    LAPACK_BATCH_STRIDED ? "strided" : "interleaved", (long) n,
+	    (long) batch, threads, lumax, solmax, fails == 0 ? "passed" :
+	    "FAILED");
+
+    free(a);
+    free(lu);
+    free(ref);
+    free(b);
+    free(x);
+    free(xb);
+    free(ipiv);
+    free(ipivb);
+    free(ipivr);
+    free(infob);
+    free(infor);
+    free(v);
+    free(w);
+    return fails;
+}
+
+int main(void)
+{
+/*     1 .. 8 use the fixed size kernels, up to 64 the general kernel */
+/*     and above dgetrf_. */
+
+    static const integer orders[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 17,
+	    33, 64, 65, 70 };
+
+/*     7 is less than one group of interleaved lanes, 150 is split over */
+/*     the threads for the larger orders. */
+
+    static const integer batches[] = { 7, 150 };
+    static const int threads[] = { 1, 4 };
+    integer layout;
+    int i__, j, t, fails = 0;
+
+    srand(1);
+    printf("%-12s %4s %6s %8s %12s %12s\n", "layout", "n", "batch",
+	    "threads", "LU ratio", "solve ratio");
+    for (layout = LAPACK_BATCH_STRIDED; layout <= LAPACK_BATCH_INTERLEAVED;
+	     ++layout) {
+	for (i__ = 0; i__ < (int) (sizeof(orders) / sizeof(orders[0]));
+		++i__) {
+	    for (j = 0; j < (int) (sizeof(batches) / sizeof(batches[0]));
+		    ++j) {
+		for (t = 0; t < (int) (sizeof(threads) / sizeof(threads[0]));
+			++t) {
+		    fails += batch_check(layout, orders[i__], batches[j],
+			    threads[t]);
+		}
+	    }
+	}
+    }
+    blas_set_num_threads(1);
+
+    if (fails != 0) {
+	printf("%d checks failed\n", fails);
+    } else {
+	printf("all checks passed\n");
+    }
+    return fails != 0;
+}
@@ -0,0 +1,481 @@
+/* Tests the blocked LU and QR factorisations dgetrf_ and dgeqrf_ against
+   the unblocked dgetf2_ and dgeqr2_.
+
+   usage: xfacttstd
+          xfacttstd_nb
+
+   For square and rectangular matrices whose orders are not multiples of
+   the block sizes or of the column tiles of the trailing updates, the
+   program factors random matrices, matrices with a zero column and
+   matrices of half rank, on one and on four threads, and checks with max
+   norms that
+       norm(P*A - L*U) / (max(m,n) * norm(A) * eps) < THRESH,
+       norm(A - Q*R) / (max(m,n) * norm(A) * eps) < THRESH,
+       norm(I - Q'*Q) / (m * eps) < THRESH,
+   for the blocked and the unblocked routines, that info of dgetrf_
+   equals info of dgetf2_ (the index of the zero column for the matrices
+   that have one), that the trailing block of U and R of the matrices of
+   half rank is below RANK_THRESH * max(m,n) * eps * norm(A), and that a factorisation
+   on four threads gives the same result when it is repeated.
+
+   xfacttstd uses the ilaenv_ of the library and also checks that it
+   returns the block sizes derived from the cache sizes.  xfacttstd_nb is
+   built with DCHKFACT_ILAENV and replaces ilaenv_, it runs the tests for
+   several block sizes with the blocked code used for all orders, and
+   checks that dgetrf_ and dgeqrf_ asked for them.
+
+   The program prints one line per shape and returns the number of failed
+   checks.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "f2c.h"
+#include "blaswrap.h"
+#include "clapack.h"
+#include "blas_kernels.h"
+
+#define THRESH 30.
+
+/* The trailing block of the factors of a matrix of half rank is only as
+   small as the conditioning of its leading columns allows, this bound is
+   still far below the size of the elements of the leading block. */
+#define RANK_THRESH 1e4
+
+/* The kinds of matrices. */
+#define FACT_RANDOM 0
+#define FACT_ZERO_COLUMN 1
+#define FACT_HALF_RANK 2
+
+extern integer ilaenv_cache_nb__(integer nb, logical qr);
+
+#ifdef DCHKFACT_ILAENV
+
+/* The block size returned by ilaenv_, and the number of times dgetrf_ and
+   dgeqrf_ asked for it. */
+static integer fact_nb = 1;
+static integer fact_queries[2];
+
+/* Returns fact_nb as block size for every routine, a minimum block size
+   of 2 and a crossover point of 0, so that the blocked code is used
+   whenever the block size is smaller than the matrix. */
+integer ilaenv_(integer *ispec, char *name__, char *opts, integer *n1,
+	integer *n2, integer *n3, integer *n4)
+{
+    if (*ispec == 1) {
+	if (strncmp(name__, "DGETRF", 6) == 0) {
+	    ++fact_queries[0];
+	} else if (strncmp(name__, "DGEQRF", 6) == 0) {
+	    ++fact_queries[1];
+	}
+	return fact_nb;
+    } else if (*ispec == 2) {
+	return 2;
+    } else if (*ispec == 3) {
+	return 0;
+    }
+    return 1;
+}
+
+#endif
+
+static void fact_fill(doublereal *v, integer n)
+{
+    integer i__;
+
+    for (i__ = 0; i__ < n; ++i__) {
+	v[i__] = (doublereal) rand() / RAND_MAX - .5;
+    }
+}
+
+static double fact_norm(const doublereal *a, integer m, integer n,
+	integer lda)
+{
+    integer i__, j;
+    double norm = 0.;
+
+    for (j = 0; j < n; ++j) {
+	for (i__ = 0; i__ < m; ++i__) {
+	    if (fabs(a[i__ + j * lda]) > norm) {
+		norm = fabs(a[i__ + j * lda]);
+	    }
+	}
+    }
+    return norm;
+}
+
+/* Fills the m x n matrix a with a matrix of the given kind. */
+static void fact_matrix(int kind, integer m, integer n, doublereal *a,
+	integer lda)
+{
+    integer i__, j, l, r__;
+    doublereal *x, *y;
+
+    fact_fill(a, lda * n);
+    if (kind == FACT_ZERO_COLUMN) {
+	for (i__ = 0; i__ < m; ++i__) {
+	    a[i__ + min(m,n) / 2 * lda] = 0.;
+	}
+    } else if (kind == FACT_HALF_RANK) {
+
+/*        A = X * Y' with X m x r and Y n x r. */
+
+	r__ = max(min(m,n) / 2, 1);
+	x = (doublereal *) malloc(m * r__ * sizeof(doublereal));
+	y = (doublereal *) malloc(n * r__ * sizeof(doublereal));
+	fact_fill(x, m * r__);
+	fact_fill(y, n * r__);
+	for (j = 0; j < n; ++j) {
+	    for (i__ = 0; i__ < m; ++i__) {
+		a[i__ + j * lda] = 0.;
+		for (l = 0; l < r__; ++l) {
+		    a[i__ + j * lda] += x[i__ + l * m] * y[j + l * n];
+		}
+	    }
+	}
+	free(x);
+	free(y);
+    }
+}
+
+/* Returns norm(P*A - L*U) / (max(m,n) * norm(A) * eps) for the factors
+   in lu. */
+static double fact_lu_ratio(integer m, integer n, const doublereal *a,
+	const doublereal *lu, integer lda, const integer *ipiv)
+{
+    integer i__, j, l, k;
+    doublereal *pa, t, s;
+    double diff = 0., anorm;
+
+    k = min(m,n);
+    pa = (doublereal *) malloc(m * n * sizeof(doublereal));
+    for (j = 0; j < n; ++j) {
+	for (i__ = 0; i__ < m; ++i__) {
+	    pa[i__ + j * m] = a[i__ + j * lda];
+	}
+    }
+    for (i__ = 0; i__ < k; ++i__) {
+	if (ipiv[i__] - 1 != i__) {
+	    for (j = 0; j < n; ++j) {
+		t = pa[i__ + j * m];
+		pa[i__ + j * m] = pa[ipiv[i__] - 1 + j * m];
+		pa[ipiv[i__] - 1 + j * m] = t;
+	    }
+	}
+    }
+    for (j = 0; j < n; ++j) {
+	for (i__ = 0; i__ < m; ++i__) {
+	    s = i__ <= j ? lu[i__ + j * lda] : 0.;
+	    for (l = 0; l < min(i__, j + 1); ++l) {
+		s += lu[i__ + l * lda] * lu[l + j * lda];
+	    }
+	    if (fabs(pa[i__ + j * m] - s) > diff) {
+		diff = fabs(pa[i__ + j * m] - s);
+	    }
+	}
+    }
+    free(pa);
+
+    anorm = fact_norm(a, m, n, lda);
+    return anorm > 0. ? diff / (max(m,n) * anorm * dlamch_("E")) : diff;
+}
+
+/* Returns norm(A - Q*R) / (max(m,n) * norm(A) * eps) in ratio[0] and
+   norm(I - Q'*Q) / (m * eps) in ratio[1] for the factors in qr. */
+static void fact_qr_ratio(integer m, integer n, const doublereal *a,
+	const doublereal *qr, integer lda, doublereal *tau, double *ratio)
+{
+    integer i__, j, l, k, lwork, info;
+    doublereal *q, *work, s, wsize;
+    double diff = 0., anorm;
+
+    k = min(m,n);
+    q = (doublereal *) malloc(m * k * sizeof(doublereal));
+    for (j = 0; j < k; ++j) {
+	for (i__ = 0; i__ < m; ++i__) {
+	    q[i__ + j * m] = qr[i__ + j * lda];
+	}
+    }
+    lwork = -1;
+    dorgqr_(&m, &k, &k, q, &m, tau, &wsize, &lwork, &info);
+    lwork = (integer) wsize;
+    work = (doublereal *) malloc(max(lwork, 1) * sizeof(doublereal));
+    dorgqr_(&m, &k, &k, q, &m, tau, work, &lwork, &info);
+    free(work);
+
+    for (j = 0; j < n; ++j) {
+	for (i__ = 0; i__ < m; ++i__) {
+	    s = -a[i__ + j * lda];
+	    for (l = 0; l <= min(j, k - 1); ++l) {
+		s += q[i__ + l * m] * qr[l + j * lda];
+	    }
+	    if (fabs(s) > diff) {
+		diff = fabs(s);
+	    }
+	}
+    }
+    anorm = fact_norm(a, m, n, lda);
+    ratio[0] = anorm > 0. ? diff / (max(m,n) * anorm * dlamch_("E")) : diff;
+
+    diff = 0.;
+    for (j = 0; j < k; ++j) {
+	for (i__ = 0; i__ < k; ++i__) {
+	    s = i__ == j ? -1. : 0.;
+	    for (l = 0; l < m; ++l) {
+		s += q[l + i__ * m] * q[l + j * m];
+	    }
+	    if (fabs(s) > diff) {
+		diff = fabs(s);
+	    }
+	}
+    }
+    ratio[1] = diff / (m * dlamch_("E"));
+    free(q);
+}
+
+/* Returns the largest element of the trailing block of U or R of a matrix
+   of half rank relative to max(m,n) * norm(A) * eps. */
+static double fact_rank_ratio(integer m, integer n, const doublereal *a,
+	const doublereal *f, integer lda)
+{
+    integer i__, j, k;
+    double diff = 0., anorm;
+
+    k = min(m,n);
+    for (j = max(k / 2, 1); j < n; ++j) {
+	for (i__ = max(k / 2, 1); i__ <= min(j, k - 1); ++i__) {
+	    if (fabs(f[i__ + j * lda]) > diff) {
+		diff = fabs(f[i__ + j * lda]);
+	    }
+	}
+    }
+    anorm = fact_norm(a, m, n, lda);
+    return diff / (max(m,n) * anorm * dlamch_("E"));
+}
+
+static int fact_fail(const char *what, integer m, integer n, int kind,
+	int threads, double ratio)
+{
+    printf("m = %ld n = %ld kind = %d threads = %d: %s %g\n", (long) m,
+	    (long) n, kind, threads, what, ratio);
+    return 1;
+}
+
+/* Factors one matrix with the blocked and the unblocked routines and
+   returns the number of failed checks. */
+static int fact_check(integer m, integer n, int kind, int threads)
+{
+    integer lda, k, info, infor, lwork, i__;
+    integer *ipiv, *ipivr;
+    doublereal *a, *f, *g, *tau, *taur, *work, wsize;
+    double lu, qr[2], lur, qrr[2], ratio, worst = 0.;
+    int fails = 0;
+
+    lda = m + 3;
+    k = min(m,n);
+    a = (doublereal *) malloc(lda * n * sizeof(doublereal));
+    f = (doublereal *) malloc(lda * n * sizeof(doublereal));
+    g = (doublereal *) malloc(lda * n * sizeof(doublereal));
+    tau = (doublereal *) malloc(k * sizeof(doublereal));
+    taur = (doublereal *) malloc(k * sizeof(doublereal));
+    ipiv = (integer *) malloc(k * sizeof(integer));
+    ipivr = (integer *) malloc(k * sizeof(integer));
+    work = (doublereal *) malloc(n * sizeof(doublereal));
+    if (a == NULL || f == NULL || g == NULL || tau == NULL || taur == NULL
+	    || ipiv == NULL || ipivr == NULL || work == NULL) {
+	fprintf(stderr, "out of memory for m = %ld n = %ld\n", (long) m,
+		(long) n);
+	exit(1);
+    }
+    fact_matrix(kind, m, n, a, lda);
+    blas_set_num_threads(threads);
+
+/*     LU */
+
+    memcpy(f, a, lda * n * sizeof(doublereal));
+    dgetrf_(&m, &n, f, &lda, ipiv, &info);
+    memcpy(g, a, lda * n * sizeof(doublereal));
+    dgetf2_(&m, &n, g, &lda, ipivr, &infor);
+
+    lu = fact_lu_ratio(m, n, a, f, lda, ipiv);
+    lur = fact_lu_ratio(m, n, a, g, lda, ipivr);
+    if (!(lu < THRESH)) {
+	fails += fact_fail("dgetrf_ residual", m, n, kind, threads, lu);
+    }
+    if (!(lur < THRESH)) {
+	fails += fact_fail("dgetf2_ residual", m, n, kind, threads, lur);
+    }
+    if (kind == FACT_ZERO_COLUMN && info != k / 2 + 1) {
+	fails += fact_fail("dgetrf_ info", m, n, kind, threads, (double)
+		info);
+    }
+    if (kind != FACT_HALF_RANK ? info != infor : info < 0) {
+	fails += fact_fail("dgetrf_ info differs from dgetf2_, info", m, n,
+		kind, threads, (double) info);
+    }
+    if (kind == FACT_HALF_RANK) {
+	ratio = fact_rank_ratio(m, n, a, f, lda);
+	worst = max(worst, ratio);
+	if (!(ratio < RANK_THRESH)) {
+	    fails += fact_fail("trailing block of U", m, n, kind, threads,
+		    ratio);
+	}
+    }
+    if (threads > 1) {
+	memcpy(g, a, lda * n * sizeof(doublereal));
+	dgetrf_(&m, &n, g, &lda, ipivr, &infor);
+	for (i__ = 0; i__ < lda * n; ++i__) {
+	    if (f[i__] != g[i__]) {
+		fails += fact_fail("repeated dgetrf_ differs at", m, n, kind,
+			threads, (double) i__);
+		break;
+	    }
+	}
+    }
+
+/*     QR */
+
+    memcpy(f, a, lda * n * sizeof(doublereal));
+    lwork = -1;
+    dgeqrf_(&m, &n, f, &lda, tau, &wsize, &lwork, &info);
+    lwork = (integer) wsize;
+    free(work);
+    work = (doublereal *) malloc(max(lwork, n) * sizeof(doublereal));
+    dgeqrf_(&m, &n, f, &lda, tau, work, &lwork, &info);
+    memcpy(g, a, lda * n * sizeof(doublereal));
+    dgeqr2_(&m, &n, g, &lda, taur, work, &infor);
+
+    fact_qr_ratio(m, n, a, f, lda, tau, qr);
+    fact_qr_ratio(m, n, a, g, lda, taur, qrr);
+    if (info != 0 || infor != 0) {
+	fails += fact_fail("dgeqrf_ info", m, n, kind, threads, (double)
+		info);
+    }
+    if (!(qr[0] < THRESH) || !(qr[1] < THRESH)) {
+	fails += fact_fail("dgeqrf_ residual", m, n, kind, threads, max(
+		qr[0], qr[1]));
+    }
+    if (!(qrr[0] < THRESH) || !(qrr[1] < THRESH)) {
+	fails += fact_fail("dgeqr2_ residual", m, n, kind, threads, max(
+		qrr[0], qrr[1]));
+    }
+    if (kind == FACT_HALF_RANK) {
+	ratio = fact_rank_ratio(m, n, a, f, lda);
+	worst = max(worst, ratio);
+	if (!(ratio < RANK_THRESH)) {
+	    fails += fact_fail("trailing block of R", m, n, kind, threads,
+		    ratio);
+	}
+    }
+    if (threads > 1) {
+	memcpy(g, a, lda * n * sizeof(doublereal));
+	dgeqrf_(&m, &n, g, &lda, taur, work, &lwork, &infor);
+	for (i__ = 0; i__ < lda * n; ++i__) {
+	    if (f[i__] != g[i__]) {
+		fails += fact_fail("repeated dgeqrf_ differs at", m, n, kind,
+			threads, (double) i__);
+		break;
+	    }
+	}
+    }
+
+    printf("%5ld %5ld %5d %8d %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f "
+	    "%s\n", (long) m, (long) n, kind, threads, lu, lur, qr[0], qr[1],
+	    qrr[0], worst, fails == 0 ? "passed" : "FAILED");
+
+    free(a);
+    free(f);
+    free(g);
+    free(tau);
+    free(taur);
+    free(ipiv);
+    free(ipivr);
+    free(work);
+    return fails;
+}
+
+/* Runs all shapes, kinds and thread counts. */
+static int fact_run(void)
+{
+/*     The column tiles of the trailing updates are multiples of 48, the */
+/*     block sizes of 16. */
+
+    static const integer shapes[][2] = { { 1, 1 }, { 13, 13 }, { 63, 63 },
+	    { 97, 97 }, { 150, 150 }, { 301, 301 }, { 200, 77 }, { 77, 200 },
+	    { 301, 131 }, { 1, 40 }, { 40, 1 } };
+    static const int threads[] = { 1, 4 };
+    int i__, kind, t, fails = 0;
+
+    printf("%5s %5s %5s %8s %10s %10s %10s %10s %10s %10s\n", "m", "n",
+	    "kind", "threads", "dgetrf", "dgetf2", "dgeqrf", "Q'Q", "dgeqr2",
+	    "rank");
+    for (i__ = 0; i__ < (int) (sizeof(shapes) / sizeof(shapes[0])); ++i__) {
+	for (kind = FACT_RANDOM; kind <= FACT_HALF_RANK; ++kind) {
+	    for (t = 0; t < (int) (sizeof(threads) / sizeof(threads[0]));
+		    ++t) {
+		fails += fact_check(shapes[i__][0], shapes[i__][1], kind,
+			threads[t]);
+	    }
+	}
+    }
+    blas_set_num_threads(1);
+    return fails;
+}
+
+int main(void)
+{
+    int fails = 0;
+#ifdef DCHKFACT_ILAENV
+    static const integer nbs[] = { 1, 2, 5, 16, 40 };
+    int i__;
+#else
+    static integer c__1 = 1, c_n1 = -1, c__301 = 301;
+    integer nb;
+#endif
+
+    srand(1);
+#ifdef DCHKFACT_ILAENV
+    for (i__ = 0; i__ < (int) (sizeof(nbs) / sizeof(nbs[0])); ++i__) {
+	fact_nb = nbs[i__];
+	fact_queries[0] = fact_queries[1] = 0;
+	printf("block size %ld\n", (long) fact_nb);
+	fails += fact_run();
+	if (fact_queries[0] == 0 || fact_queries[1] == 0) {
+	    printf("dgetrf_ asked %ld times and dgeqrf_ %ld times for the "
+		    "block size\n", (long) fact_queries[0], (long)
+		    fact_queries[1]);
+	    ++fails;
+	}
+    }
+#else
+
+/*     ilaenv_ returns the block sizes derived from the cache sizes, or */
+/*     the LAPACK defaults if they are unknown. */
+
+    nb = ilaenv_(&c__1, "DGETRF", " ", &c__301, &c__301, &c_n1, &c_n1);
+    printf("DGETRF block size %ld\n", (long) nb);
+    if (nb != ilaenv_cache_nb__(64, FALSE_) || nb < 32 || nb > 256) {
+	printf("ilaenv_ returned %ld for DGETRF, the caches give %ld\n",
+		(long) nb, (long) ilaenv_cache_nb__(64, FALSE_));
+	++fails;
+    }
+    nb = ilaenv_(&c__1, "DGEQRF", " ", &c__301, &c__301, &c_n1, &c_n1);
+    printf("DGEQRF block size %ld\n", (long) nb);
+    if (nb != ilaenv_cache_nb__(32, TRUE_) || nb < 16 || nb > 64) {
+	printf("ilaenv_ returned %ld for DGEQRF, the caches give %ld\n",
+		(long) nb, (long) ilaenv_cache_nb__(32, TRUE_));
+	++fails;
+    }
+    fails += fact_run();
+#endif
+
+    if (fails != 0) {
+	printf("%d checks failed\n", fails);
+    } else {
+	printf("all checks passed\n");
+    }
+    return fails != 0;
+}
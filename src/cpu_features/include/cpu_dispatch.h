@@ -0,0 +1,71 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CPU_FEATURES_INCLUDE_CPU_DISPATCH_H_
+#define CPU_FEATURES_INCLUDE_CPU_DISPATCH_H_
+
+#include "cpu_features_macros.h"
+
+CPU_FEATURES_START_CPP_NAMESPACE
+
+// Runtime selection between instruction set specific implementations of a
+// kernel, so that one binary can use the widest vector instructions of the
+// processor it runs on.
+//
+// The processor is probed the first time the level is needed, and the
+// functions below may be called from any thread. The environment variable
+// CPU_FEATURES_DISPATCH set to the name of a level ("baseline", "sse2",
+// "avx2" or "avx512") caps the level, which allows testing the narrower
+// implementations on a wide machine. Levels the processor does not support
+// can not be forced.
+//
+// A kernel family keeps its implementations in a table indexed by
+// CpuDispatchLevel, with NULL for levels it has no code for:
+//
+//   static const CpuDispatchFunction kSumTable[CPU_DISPATCH_LEVEL_COUNT] = {
+//       (CpuDispatchFunction)SumC, (CpuDispatchFunction)SumSse2,
+//       (CpuDispatchFunction)SumAvx2, NULL};
+//   SumFunction sum = (SumFunction)SelectCpuDispatchFunction(kSumTable);
+
+typedef enum {
+  CPU_DISPATCH_BASELINE,  // Portable C, the only level off x86.
+  CPU_DISPATCH_SSE2,
+  CPU_DISPATCH_AVX2,    // AVX2 and FMA3.
+  CPU_DISPATCH_AVX512,  // AVX-512 F, CD, BW, DQ and VL.
+  CPU_DISPATCH_LEVEL_COUNT,
+} CpuDispatchLevel;
+
+typedef void (*CpuDispatchFunction)(void);
+
+// Returns the widest level supported by the processor and the operating
+// system, ignoring CPU_FEATURES_DISPATCH.
+CpuDispatchLevel GetCpuDispatchSupportedLevel(void);
+
+// Returns the level implementations should be selected for: the supported
+// level, capped by CPU_FEATURES_DISPATCH.
+CpuDispatchLevel GetCpuDispatchLevel(void);
+
+// Returns the name of the level, e.g. "avx2", or NULL for an invalid level.
+const char* GetCpuDispatchLevelName(CpuDispatchLevel level);
+
+// Returns the level with the given name, CPU_DISPATCH_LEVEL_COUNT if the
+// name is unknown. Names are not case sensitive.
+CpuDispatchLevel ParseCpuDispatchLevel(const char* name);
+
+// Returns the entry of the widest level not above GetCpuDispatchLevel()
+// that is not NULL, or NULL if there is none.
+CpuDispatchFunction SelectCpuDispatchFunction(
+    const CpuDispatchFunction table[CPU_DISPATCH_LEVEL_COUNT]);
+
+CPU_FEATURES_END_CPP_NAMESPACE
+
+#endif  // CPU_FEATURES_INCLUDE_CPU_DISPATCH_H_
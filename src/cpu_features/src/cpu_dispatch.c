@@ -0,0 +1,117 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_dispatch.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+
+#if defined(CPU_FEATURES_ARCH_X86)
+#include "cpuinfo_x86.h"
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define LOAD_LEVEL(level) _InterlockedOr(&(level), 0)
+#define STORE_LEVEL(level, value) _InterlockedExchange(&(level), (value))
+#else
+#define LOAD_LEVEL(level) __atomic_load_n(&(level), __ATOMIC_ACQUIRE)
+#define STORE_LEVEL(level, value) \
+  __atomic_store_n(&(level), (value), __ATOMIC_RELEASE)
+#endif
+
+static const char* const kLevelNames[CPU_DISPATCH_LEVEL_COUNT] = {
+    "baseline", "sse2", "avx2", "avx512"};
+
+// Both levels are computed by the first call and are -1 until then. They
+// are only accessed atomically.
+static volatile long g_supported_level = -1;
+static volatile long g_level = -1;
+
+static CpuDispatchLevel ProbeSupportedLevel(void) {
+#if defined(CPU_FEATURES_ARCH_X86)
+  // GetX86Info() takes operating system support for the YMM and ZMM
+  // registers into account.
+  const X86Features features = GetX86Info().features;
+  if (features.avx512f && features.avx512cd && features.avx512bw &&
+      features.avx512dq && features.avx512vl && features.avx2 &&
+      features.fma3) {
+    return CPU_DISPATCH_AVX512;
+  }
+  if (features.avx2 && features.fma3) {
+    return CPU_DISPATCH_AVX2;
+  }
+  if (features.sse2) {
+    return CPU_DISPATCH_SSE2;
+  }
+#endif
+  return CPU_DISPATCH_BASELINE;
+}
+
+CpuDispatchLevel GetCpuDispatchSupportedLevel(void) {
+  long level = LOAD_LEVEL(g_supported_level);
+  if (level < 0) {
+    level = ProbeSupportedLevel();
+    STORE_LEVEL(g_supported_level, level);
+  }
+  return (CpuDispatchLevel)level;
+}
+
+CpuDispatchLevel GetCpuDispatchLevel(void) {
+  long level = LOAD_LEVEL(g_level);
+  if (level < 0) {
+    const char* const name = getenv("CPU_FEATURES_DISPATCH");
+    level = GetCpuDispatchSupportedLevel();
+    if (name != NULL) {
+      const CpuDispatchLevel requested = ParseCpuDispatchLevel(name);
+      if (requested < level) {
+        level = requested;
+      }
+    }
+    STORE_LEVEL(g_level, level);
+  }
+  return (CpuDispatchLevel)level;
+}
+
+const char* GetCpuDispatchLevelName(CpuDispatchLevel level) {
+  if (level < CPU_DISPATCH_BASELINE || level >= CPU_DISPATCH_LEVEL_COUNT) {
+    return NULL;
+  }
+  return kLevelNames[level];
+}
+
+CpuDispatchLevel ParseCpuDispatchLevel(const char* name) {
+  int level;
+  for (level = 0; level < CPU_DISPATCH_LEVEL_COUNT; ++level) {
+    const char* a = name;
+    const char* b = kLevelNames[level];
+    while (*a && tolower((unsigned char)*a) == *b) {
+      ++a;
+      ++b;
+    }
+    if (*a == '\0' && *b == '\0') {
+      return (CpuDispatchLevel)level;
+    }
+  }
+  return CPU_DISPATCH_LEVEL_COUNT;
+}
+
+CpuDispatchFunction SelectCpuDispatchFunction(
+    const CpuDispatchFunction table[CPU_DISPATCH_LEVEL_COUNT]) {
+  int level;
+  for (level = GetCpuDispatchLevel(); level >= 0; --level) {
+    if (table[level] != NULL) {
+      return table[level];
+    }
+  }
+  return NULL;
+}
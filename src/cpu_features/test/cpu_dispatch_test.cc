@@ -0,0 +1,72 @@
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_dispatch.h"
+
+#include "gtest/gtest.h"
+
+namespace cpu_features {
+namespace {
+
+void Baseline() {}
+void Sse2() {}
+void Avx2() {}
+void Avx512() {}
+
+TEST(CpuDispatchTest, LevelNames) {
+  for (int i = 0; i < CPU_DISPATCH_LEVEL_COUNT; ++i) {
+    const CpuDispatchLevel level = static_cast<CpuDispatchLevel>(i);
+    ASSERT_NE(GetCpuDispatchLevelName(level), nullptr);
+    EXPECT_EQ(ParseCpuDispatchLevel(GetCpuDispatchLevelName(level)), level);
+  }
+  EXPECT_STREQ(GetCpuDispatchLevelName(CPU_DISPATCH_AVX2), "avx2");
+  EXPECT_EQ(GetCpuDispatchLevelName(CPU_DISPATCH_LEVEL_COUNT), nullptr);
+}
+
+TEST(CpuDispatchTest, ParseLevel) {
+  EXPECT_EQ(ParseCpuDispatchLevel("SSE2"), CPU_DISPATCH_SSE2);
+  EXPECT_EQ(ParseCpuDispatchLevel("Avx512"), CPU_DISPATCH_AVX512);
+  EXPECT_EQ(ParseCpuDispatchLevel("avx"), CPU_DISPATCH_LEVEL_COUNT);
+  EXPECT_EQ(ParseCpuDispatchLevel("avx2x"), CPU_DISPATCH_LEVEL_COUNT);
+  EXPECT_EQ(ParseCpuDispatchLevel(""), CPU_DISPATCH_LEVEL_COUNT);
+}
+
+TEST(CpuDispatchTest, LevelIsSupported) {
+  EXPECT_LE(GetCpuDispatchLevel(), GetCpuDispatchSupportedLevel());
+  EXPECT_LT(GetCpuDispatchSupportedLevel(), CPU_DISPATCH_LEVEL_COUNT);
+  // The probe runs once, later calls return the same level.
+  EXPECT_EQ(GetCpuDispatchLevel(), GetCpuDispatchLevel());
+}
+
+TEST(CpuDispatchTest, SelectWidest) {
+  const CpuDispatchFunction table[CPU_DISPATCH_LEVEL_COUNT] = {
+      Baseline, Sse2, Avx2, Avx512};
+  EXPECT_EQ(SelectCpuDispatchFunction(table), table[GetCpuDispatchLevel()]);
+}
+
+TEST(CpuDispatchTest, SelectSkipsMissingLevels) {
+  const CpuDispatchFunction baseline_only[CPU_DISPATCH_LEVEL_COUNT] = {
+      Baseline, nullptr, nullptr, nullptr};
+  EXPECT_EQ(SelectCpuDispatchFunction(baseline_only), Baseline);
+
+  const CpuDispatchFunction no_sse2[CPU_DISPATCH_LEVEL_COUNT] = {
+      Baseline, nullptr, Avx2, nullptr};
+  EXPECT_EQ(SelectCpuDispatchFunction(no_sse2),
+            GetCpuDispatchLevel() >= CPU_DISPATCH_AVX2 ? Avx2 : Baseline);
+
+  const CpuDispatchFunction none[CPU_DISPATCH_LEVEL_COUNT] = {
+      nullptr, nullptr, nullptr, nullptr};
+  EXPECT_EQ(SelectCpuDispatchFunction(none), nullptr);
+}
+
+}  // namespace
+}  // namespace cpu_features
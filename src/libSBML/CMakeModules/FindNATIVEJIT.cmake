@@ -0,0 +1,81 @@
+string(TOUPPER ${PROJECT_NAME} _UPPER_PROJECT_NAME)
+set(_PROJECT_DEPENDENCY_DIR ${_UPPER_PROJECT_NAME}_DEPENDENCY_DIR)
+
+if (NOT NATIVEJIT_LIBRARY)
+find_library(NATIVEJIT_LIBRARY
+    NAMES NativeJIT libNativeJIT.lib
+    PATHS /usr/lib /usr/local/lib
+          ${${_PROJECT_DEPENDENCY_DIR}}/lib
+          ${${_PROJECT_DEPENDENCY_DIR}}/lib64
+    DOC "The file name of the NativeJIT library."
+)
+endif()
+
+if (NOT NATIVEJIT_CODEGEN_LIBRARY)
+find_library(NATIVEJIT_CODEGEN_LIBRARY
+    NAMES CodeGen libCodeGen.lib
+    PATHS /usr/lib /usr/local/lib
+          ${${_PROJECT_DEPENDENCY_DIR}}/lib
+          ${${_PROJECT_DEPENDENCY_DIR}}/lib64
+    DOC "The file name of the code generator library of NativeJIT."
+)
+endif()
+
+if (NOT NATIVEJIT_INCLUDE_DIR)
+find_path(NATIVEJIT_INCLUDE_DIR
+    NAMES NativeJIT/Function.h
+    PATHS /usr/include /usr/local/include
+          ${${_PROJECT_DEPENDENCY_DIR}}/include
+    DOC "The directory containing the NativeJIT include files."
+)
+endif()
+
+# NativeJIT links cpu_features when it was available at build time.
+if (NOT NATIVEJIT_CPU_FEATURES_LIBRARY)
+find_library(NATIVEJIT_CPU_FEATURES_LIBRARY
+    NAMES cpu_features libcpu_features.lib
+    PATHS /usr/lib /usr/local/lib
+          ${${_PROJECT_DEPENDENCY_DIR}}/lib
+          ${${_PROJECT_DEPENDENCY_DIR}}/lib64
+    DOC "The file name of the cpu_features library used by NativeJIT (optional)."
+)
+endif()
+
+if(NATIVEJIT_INCLUDE_DIR AND NOT EXISTS "${NATIVEJIT_INCLUDE_DIR}/NativeJIT/Function.h")
+    message(FATAL_ERROR
+"The include directory specified for NativeJIT does not appear to be
+valid.  It should contain the file NativeJIT/Function.h, but it does
+not.")
+endif()
+
+if(NOT TARGET NATIVEJIT::CODEGEN AND NATIVEJIT_CODEGEN_LIBRARY)
+  add_library(NATIVEJIT::CODEGEN UNKNOWN IMPORTED)
+  set_target_properties(NATIVEJIT::CODEGEN PROPERTIES
+    IMPORTED_LINK_INTERFACE_LANGUAGES "CXX"
+    IMPORTED_LOCATION "${NATIVEJIT_CODEGEN_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${NATIVEJIT_INCLUDE_DIR}")
+endif()
+
+set(_NATIVEJIT_LINK_LIBRARIES NATIVEJIT::CODEGEN)
+if (NATIVEJIT_CPU_FEATURES_LIBRARY)
+  set(_NATIVEJIT_LINK_LIBRARIES ${_NATIVEJIT_LINK_LIBRARIES} ${NATIVEJIT_CPU_FEATURES_LIBRARY})
+endif()
+
+if(NOT TARGET NATIVEJIT::NATIVEJIT AND NATIVEJIT_LIBRARY)
+  add_library(NATIVEJIT::NATIVEJIT UNKNOWN IMPORTED)
+  set_target_properties(NATIVEJIT::NATIVEJIT PROPERTIES
+    IMPORTED_LINK_INTERFACE_LANGUAGES "CXX"
+    IMPORTED_LOCATION "${NATIVEJIT_LIBRARY}"
+    INTERFACE_INCLUDE_DIRECTORIES "${NATIVEJIT_INCLUDE_DIR}"
+    INTERFACE_LINK_LIBRARIES "${_NATIVEJIT_LINK_LIBRARIES}")
+endif()
+
+
+include(FindPackageHandleStandardArgs)
+
+find_package_handle_standard_args(
+    NATIVEJIT
+    REQUIRED_VARS NATIVEJIT_LIBRARY NATIVEJIT_CODEGEN_LIBRARY NATIVEJIT_INCLUDE_DIR
+)
+
+mark_as_advanced(NATIVEJIT_LIBRARY NATIVEJIT_CODEGEN_LIBRARY NATIVEJIT_CPU_FEATURES_LIBRARY NATIVEJIT_INCLUDE_DIR)
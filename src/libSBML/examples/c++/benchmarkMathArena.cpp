@@ -0,0 +1,119 @@
+/**
+ * @file    benchmarkMathArena.cpp
+ * @brief   Compares the time needed to read and to delete a model with and
+ *          without allocating its math from an arena
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/common/extern.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+int
+main (int argc, char* argv[])
+{
+  if (argc != 2 && argc != 3)
+  {
+    cout << endl << "Usage: benchmarkMathArena filename [repeats]"
+         << endl << endl;
+    return 1;
+  }
+
+  const char* filename = argv[1];
+  int         repeats  = (argc == 3) ? atoi(argv[2]) : 10;
+
+  if (repeats < 1) repeats = 1;
+
+#ifdef __BORLANDC__
+  unsigned long start, loaded, stop;
+  unsigned long loadTime[2] = { 0, 0 }, freeTime[2] = { 0, 0 };
+#else
+  unsigned long long start, loaded, stop;
+  unsigned long long loadTime[2] = { 0, 0 }, freeTime[2] = { 0, 0 };
+#endif
+
+  unsigned int errors = 0;
+
+  /* alternate between the two allocators so that both see a warm cache */
+  for (int n = 0; n < repeats; ++n)
+  {
+    for (int useArena = 0; useArena < 2; ++useArena)
+    {
+      SBMLReader reader;
+      reader.setUseMathArena(useArena != 0);
+
+      start  = getCurrentMillis();
+      SBMLDocument* document = reader.readSBML(filename);
+      loaded = getCurrentMillis();
+      errors = document->getNumErrors(LIBSBML_SEV_ERROR)
+             + document->getNumErrors(LIBSBML_SEV_FATAL);
+      delete document;
+      stop   = getCurrentMillis();
+
+      loadTime[useArena] += loaded - start;
+      freeTime[useArena] += stop - loaded;
+    }
+  }
+
+  cout << endl;
+  cout << "           filename: " << filename              << endl;
+  cout << "          file size: " << getFileSize(filename) << endl;
+  cout << "            repeats: " << repeats               << endl;
+  cout << "           error(s): " << errors                << endl;
+  cout << endl;
+  cout << "                           heap     arena"   << endl;
+  cout << "     read time (ms): "
+       << setw(10) << loadTime[0] / repeats
+       << setw(10) << loadTime[1] / repeats << endl;
+  cout << "   delete time (ms): "
+       << setw(10) << freeTime[0] / repeats
+       << setw(10) << freeTime[1] / repeats << endl;
+  cout << endl;
+
+  return errors > 0 ? 1 : 0;
+}
+
+END_C_DECLS
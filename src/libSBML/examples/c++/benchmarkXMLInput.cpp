@@ -0,0 +1,181 @@
+/**
+ * @file    benchmarkXMLInput.cpp
+ * @brief   Compares the throughput of reading a file through a stream and
+ *          from a memory mapping, with different chunk sizes
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/common/extern.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLParser.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+struct InputConfig
+{
+  const char*  name;
+  bool         mapped;
+  unsigned int chunkSize;
+};
+
+/* the first entry is the way files were read before mapping was added */
+static const InputConfig configs[] =
+{
+  { "stream   8 KiB", false,     8192 },
+  { "stream  64 KiB", false,    65536 },
+  { "mapped   8 KiB", true,      8192 },
+  { "mapped  64 KiB", true,     65536 },
+  { "mapped 256 KiB", true,    262144 },
+  { "mapped   1 MiB", true,   1048576 },
+  { "mapped  16 MiB", true,  16777216 }
+};
+
+static const int numConfigs = sizeof(configs) / sizeof(configs[0]);
+
+
+/*
+ * Reads all tokens of the given file and returns their number.
+ */
+static unsigned long
+tokenize (const char* filename)
+{
+  XMLInputStream stream(filename, true);
+  unsigned long  tokens = 0;
+
+  while (stream.isGood() && !stream.isEOF())
+  {
+    stream.next();
+    ++tokens;
+  }
+
+  return tokens;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc != 2 && argc != 3)
+  {
+    cout << endl << "Usage: benchmarkXMLInput filename [repeats]"
+         << endl << endl;
+    return 1;
+  }
+
+  const char* filename = argv[1];
+  int         repeats  = (argc == 3) ? atoi(argv[2]) : 5;
+
+  if (repeats < 1) repeats = 1;
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+  unsigned long tokenTime[numConfigs] = { 0 }, readTime[numConfigs] = { 0 };
+#else
+  unsigned long long start, stop;
+  unsigned long long tokenTime[numConfigs] = { 0 }, readTime[numConfigs] = { 0 };
+#endif
+
+  unsigned long tokens = 0;
+  unsigned int  errors = 0;
+
+  /* cycle through the configurations so that all of them see a warm cache */
+  for (int n = 0; n < repeats; ++n)
+  {
+    for (int c = 0; c < numConfigs; ++c)
+    {
+      XMLParser::setUseMappedFiles(configs[c].mapped);
+      XMLParser::setChunkSize(configs[c].chunkSize);
+
+      start  = getCurrentMillis();
+      tokens = tokenize(filename);
+      stop   = getCurrentMillis();
+      tokenTime[c] += stop - start;
+
+      start = getCurrentMillis();
+      SBMLDocument* document = readSBML(filename);
+      stop  = getCurrentMillis();
+      readTime[c] += stop - start;
+
+      errors = document->getNumErrors(LIBSBML_SEV_ERROR)
+             + document->getNumErrors(LIBSBML_SEV_FATAL);
+      delete document;
+    }
+  }
+
+  XMLParser::setUseMappedFiles(true);
+  XMLParser::setChunkSize(0);
+
+  const double megabytes = getFileSize(filename) / (1024.0 * 1024.0);
+
+  cout << endl;
+  cout << "           filename: " << filename              << endl;
+  cout << "          file size: " << getFileSize(filename) << endl;
+  cout << "             tokens: " << tokens                << endl;
+  cout << "            repeats: " << repeats               << endl;
+  cout << "           error(s): " << errors                << endl;
+  cout << endl;
+  cout << "                       tokenize          readSBML"  << endl;
+  cout << "                      ms     MB/s      ms     MB/s" << endl;
+
+  for (int c = 0; c < numConfigs; ++c)
+  {
+    const double tokenMs = (double) tokenTime[c] / repeats;
+    const double readMs  = (double) readTime[c]  / repeats;
+
+    cout << "     " << configs[c].name << fixed << setprecision(1)
+         << setw(8) << tokenMs
+         << setw(9) << ((tokenMs > 0) ? 1000 * megabytes / tokenMs : 0.0)
+         << setw(8) << readMs
+         << setw(9) << ((readMs > 0) ? 1000 * megabytes / readMs : 0.0)
+         << endl;
+  }
+
+  cout << endl;
+
+  return errors > 0 ? 1 : 0;
+}
+
+END_C_DECLS
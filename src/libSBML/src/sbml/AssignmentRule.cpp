@@ -138,6 +138,21 @@ AssignmentRule::renameSIdRefs(const std::string& oldid, const std::string& newid
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+AssignmentRule::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  Rule::renameSIdRefs(renamed);
+  if (isSetVariable()) {
+    const std::string* newid = getRenamedId(renamed, getVariable());
+    if (newid != NULL) {
+      setVariable(*newid);
+    }
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 
 /*
@@ -485,6 +485,7 @@ Compartment::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -508,6 +509,7 @@ Compartment::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -686,6 +688,19 @@ Compartment::renameSIdRefs(const std::string& oldid, const std::string& newid)
   if (mOutside==oldid) mOutside= newid; //You know, just in case.
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Compartment::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  const std::string* newid = getRenamedId(renamed, mCompartmentType);
+  if (newid != NULL) mCompartmentType = *newid;
+  newid = getRenamedId(renamed, mOutside);
+  if (newid != NULL) mOutside = *newid;
+}
+/** @endcond */
+
 void 
 Compartment::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -693,6 +708,17 @@ Compartment::renameUnitSIdRefs(const std::string& oldid, const std::string& newi
   if (mUnits==oldid) mUnits = newid;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Compartment::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  const std::string* newid = getRenamedId(renamed, mUnits);
+  if (newid != NULL) mUnits = *newid;
+}
+/** @endcond */
+
 /*
  * Unsets the name of this SBML object.
  */
@@ -702,6 +728,7 @@ Compartment::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -1961,7 +1988,7 @@ ListOfCompartments::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <Compartment*> (item);
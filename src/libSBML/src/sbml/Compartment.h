@@ -1100,6 +1100,12 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /**
    * Unsets the value of the "name" attribute of this Compartment object.
    *
@@ -184,6 +184,7 @@ CompartmentType::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -207,6 +208,7 @@ CompartmentType::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -227,6 +229,7 @@ CompartmentType::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -769,7 +772,7 @@ ListOfCompartmentTypes::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <CompartmentType*> (item);
@@ -443,6 +443,18 @@ Constraint::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Constraint::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 void 
 Constraint::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -452,6 +464,18 @@ Constraint::renameUnitSIdRefs(const std::string& oldid, const std::string& newid
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Constraint::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Constraint::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
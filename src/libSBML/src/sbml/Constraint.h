@@ -370,6 +370,12 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Replace all nodes with the name 'id' from the child 'math' object with the provided function. 
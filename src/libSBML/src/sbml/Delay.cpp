@@ -425,6 +425,18 @@ Delay::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Delay::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 void 
 Delay::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -434,6 +446,18 @@ Delay::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Delay::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Delay::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
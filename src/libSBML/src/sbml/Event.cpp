@@ -518,6 +518,7 @@ Event::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -541,6 +542,7 @@ Event::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -719,6 +721,7 @@ int
 Event::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -740,6 +743,7 @@ Event::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -2255,7 +2259,7 @@ ListOfEvents::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <Event*> (item);
@@ -739,6 +739,22 @@ EventAssignment::renameSIdRefs(const std::string& oldid, const std::string& newi
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+EventAssignment::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  const std::string* newid = getRenamedId(renamed, mVariable);
+  if (newid != NULL) {
+    setVariable(*newid);
+  }
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 void 
 EventAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -748,6 +764,18 @@ EventAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string&
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+EventAssignment::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 EventAssignment::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -1160,7 +1188,7 @@ ListOfEventAssignments::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <EventAssignment*> (item);
@@ -231,6 +231,7 @@ FunctionDefinition::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -254,6 +255,7 @@ FunctionDefinition::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -304,6 +306,7 @@ FunctionDefinition::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -624,6 +627,18 @@ FunctionDefinition::renameUnitSIdRefs(const std::string& oldid, const std::strin
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+FunctionDefinition::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 
 /*
@@ -1254,7 +1269,7 @@ ListOfFunctionDefinitions::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <FunctionDefinition*> (item);
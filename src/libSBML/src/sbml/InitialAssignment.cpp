@@ -718,6 +718,22 @@ InitialAssignment::renameSIdRefs(const std::string& oldid, const std::string& ne
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+InitialAssignment::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  const std::string* newid = getRenamedId(renamed, mSymbol);
+  if (newid != NULL) {
+    setSymbol(*newid);
+  }
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 void 
 InitialAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -727,6 +743,18 @@ InitialAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+InitialAssignment::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 InitialAssignment::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -1142,7 +1170,7 @@ ListOfInitialAssignments::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <InitialAssignment*> (item);
@@ -1552,6 +1552,38 @@ KineticLaw::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+KineticLaw::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (!isSetMath()) return;
+
+  //If a renamed id is actually a local parameter, we should not rename it.
+  std::vector<std::string> local;
+  for (unsigned int n = 0; n < mParameters.size(); ++n) {
+    const std::string& id = mParameters.get(n)->getId();
+    if (renamed.find(id) != renamed.end()) local.push_back(id);
+  }
+  for (unsigned int n = 0; n < mLocalParameters.size(); ++n) {
+    const std::string& id = mLocalParameters.get(n)->getId();
+    if (renamed.find(id) != renamed.end()) local.push_back(id);
+  }
+
+  if (local.empty()) {
+    mMath->renameSIdRefs(renamed);
+    return;
+  }
+
+  std::map<std::string, std::string> global(renamed);
+  for (size_t n = 0; n < local.size(); ++n) {
+    global.erase(local[n]);
+  }
+  mMath->renameSIdRefs(global);
+}
+/** @endcond */
+
 void 
 KineticLaw::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -1563,6 +1595,22 @@ KineticLaw::renameUnitSIdRefs(const std::string& oldid, const std::string& newid
   if (mSubstanceUnits == oldid) mSubstanceUnits = newid;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+KineticLaw::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+  const std::string* newid = getRenamedId(renamed, mTimeUnits);
+  if (newid != NULL) mTimeUnits = *newid;
+  newid = getRenamedId(renamed, mSubstanceUnits);
+  if (newid != NULL) mSubstanceUnits = *newid;
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 KineticLaw::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
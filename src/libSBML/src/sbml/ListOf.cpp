@@ -47,6 +47,7 @@
 #include <sbml/SBO.h>
 #include <sbml/common/common.h>
 #include <sbml/util/ElementFilter.h>
+#include <sbml/util/ElementIdIndex.h>
 #include <sbml/extension/SBasePlugin.h>
 
 /** @cond doxygenIgnored */
@@ -340,6 +341,8 @@ ListOf::getAllElements(ElementFilter *filter)
 void
 ListOf::clear (bool doDelete)
 {
+  if (!mItems.empty())
+    mItems.front()->invalidateElementIdIndex();
   if (doDelete)
     for_each( mItems.begin(), mItems.end(), Delete() );
   mItems.clear();
@@ -368,7 +371,16 @@ SBase*
 ListOf::remove (unsigned int n)
 {
   SBase* item = get(n);
-  if (item != NULL) mItems.erase( mItems.begin() + n );
+  if (item != NULL)
+  {
+    mItems.erase( mItems.begin() + n );
+
+    std::shared_ptr<ElementIdIndex> index = item->mElementIdIndex.lock();
+    if (index)
+    {
+      index->elementRemoved(this, n, item);
+    }
+  }
   return item;
 }
 
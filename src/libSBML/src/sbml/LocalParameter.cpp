@@ -712,7 +712,7 @@ ListOfLocalParameters::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <LocalParameter*> (item);
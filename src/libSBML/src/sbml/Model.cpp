@@ -66,6 +66,7 @@
 #include <sbml/util/ElementFilter.h>
 #include <sbml/util/IdFilter.h>
 #include <sbml/util/MetaIdFilter.h>
+#include <sbml/util/ElementIdIndex.h>
 
 #include <sbml/extension/SBMLExtensionRegistry.h>
 #include <sbml/extension/SBasePlugin.h>
@@ -104,6 +105,7 @@ Model::Model (unsigned int level, unsigned int version) :
  , mIdList (  )
  , mMetaidList ( )
  , mUnitsDataMap ()
+ , mIdIndex ( new ElementIdIndex(this) )
 {
   if (!hasValidLevelVersionNamespaceCombination())
     throw SBMLConstructorException();
@@ -137,6 +139,7 @@ Model::Model (SBMLNamespaces * sbmlns) :
  , mIdList (  )
  , mMetaidList ( )
  , mUnitsDataMap ()
+ , mIdIndex ( new ElementIdIndex(this) )
 {
   if (!hasValidLevelVersionNamespaceCombination())
   {
@@ -154,6 +157,9 @@ Model::Model (SBMLNamespaces * sbmlns) :
  */
 Model::~Model ()
 {
+  // the elements do not need to report their destruction to the index
+  mIdIndex.reset();
+
   if (mFormulaUnitsData != NULL)
   {  
     unsigned int size = mFormulaUnitsData->getSize();
@@ -197,6 +203,7 @@ Model::Model(const Model& orig)
   , mIdList              (orig.mIdList)
   , mMetaidList          (orig.mMetaidList)
   , mUnitsDataMap        ()
+  , mIdIndex             (new ElementIdIndex(this))
 {
 
   if (orig.mFormulaUnitsData != NULL)
@@ -247,6 +254,7 @@ Model& Model::operator=(const Model& rhs)
     mConstraints          = rhs.mConstraints;
     mReactions            = rhs.mReactions;
     mEvents               = rhs.mEvents;
+    mIdIndex->invalidate();
 
 
     if (this->mFormulaUnitsData  != NULL)
@@ -330,32 +338,7 @@ SBase*
 Model::getElementBySId(const std::string& id)
 {
   if (id.empty()) return NULL;
-  SBase* obj = mFunctionDefinitions.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mUnitDefinitions.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mCompartmentTypes.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mSpeciesTypes.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mCompartments.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mSpecies.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mParameters.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mReactions.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mInitialAssignments.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mRules.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mConstraints.getElementBySId(id);
-  if (obj != NULL) return obj;
-  obj = mEvents.getElementBySId(id);
-  if (obj != NULL) return obj;
-
-  return getElementFromPluginsBySId(id);
+  return mIdIndex->getElementBySId(id);
 }
 
 
@@ -363,48 +346,32 @@ SBase*
 Model::getElementByMetaId(const std::string& metaid)
 {
   if (metaid.empty()) return NULL;
-  if (mFunctionDefinitions.getMetaId()==metaid) return &mFunctionDefinitions;
-  if (mUnitDefinitions.getMetaId()==metaid) return &mUnitDefinitions;
-  if (mCompartmentTypes.getMetaId()==metaid) return &mCompartmentTypes;
-  if (mSpeciesTypes.getMetaId()==metaid) return &mSpeciesTypes;
-  if (mCompartments.getMetaId()==metaid) return &mCompartments;
-  if (mSpecies.getMetaId()==metaid) return &mSpecies;
-  if (mParameters.getMetaId()==metaid) return &mParameters;
-  if (mInitialAssignments.getMetaId()==metaid) return &mInitialAssignments;
-  if (mRules.getMetaId()==metaid) return &mRules;
-  if (mConstraints.getMetaId()==metaid) return &mConstraints;
-  if (mReactions.getMetaId()==metaid) return &mReactions;
-  if (mEvents.getMetaId()==metaid) return &mEvents;
-
-  SBase* obj = mFunctionDefinitions.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mUnitDefinitions.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mCompartmentTypes.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mSpeciesTypes.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mCompartments.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mSpecies.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mParameters.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mInitialAssignments.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mRules.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mConstraints.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mReactions.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-  obj = mEvents.getElementByMetaId(metaid);
-  if (obj != NULL) return obj;
-
-  return getElementFromPluginsByMetaId(metaid);
+  return mIdIndex->getElementByMetaId(metaid);
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+SBase*
+Model::getElementFromIdIndex(const ListOf& list, const std::string& sid) const
+{
+  bool unique = true;
+  SBase* obj = sid.empty() ? NULL : mIdIndex->getElementBySId(sid, &unique);
+
+  // an element of another list with the same id may come first
+  if (sid.empty() || !unique)
+  {
+    for (unsigned int n = 0; n < list.size(); ++n)
+    {
+      if (list.get(n)->getId() == sid) return const_cast<SBase*>(list.get(n));
+    }
+    return NULL;
+  }
+
+  return (obj != NULL && obj->getParentSBMLObject() == &list) ? obj : NULL;
+}
+/** @endcond */
+
+
 List*
 Model::getAllElements(ElementFilter *filter)
 {
@@ -457,14 +424,13 @@ Model::renameIDs(List* elements, IdentifierTransformer* idTransformer)
   if (elements == NULL || elements->getSize() == 0 || idTransformer == NULL)
     return;
 
-  vector<pair<string, string> > renamedSIds;
-  vector<pair<string, string> > renamedUnitSIds;
-  vector<pair<string, string> > renamedMetaIds;
-  vector<pair<string, string> >::iterator it;
+  map<string, string> renamedSIds;
+  map<string, string> renamedUnitSIds;
+  map<string, string> renamedMetaIds;
 
-  for (unsigned long el=0; el < elements->getSize(); ++el) 
+  for (ListIterator iter = elements->begin(); iter != elements->end(); ++iter)
   {
-    SBase* element = static_cast<SBase*>(elements->get((unsigned int)el));
+    SBase* element = static_cast<SBase*>(*iter);
     string id = element->getId();
     string metaid = element->getMetaId();
     element->transformIdentifiers(idTransformer);
@@ -480,38 +446,39 @@ Model::renameIDs(List* elements, IdentifierTransformer* idTransformer)
       int type = element->getTypeCode();
       if (type==SBML_UNIT_DEFINITION) 
       {
-        renamedUnitSIds.push_back(make_pair(id, newid));
+        renamedUnitSIds.insert(make_pair(id, newid));
       }
       else 
       {
         //This is a little dangerous, but hey!  What's a little danger between friends!
         //(What we are assuming is that any attribute you can get with 'getId' is of the type 'SId')
-        renamedSIds.push_back(make_pair(id, newid));
+        renamedSIds.insert(make_pair(id, newid));
       }
     }
     if (metaid != newmetaid) 
   {
-      renamedMetaIds.push_back(make_pair(metaid, newmetaid));
+      renamedMetaIds.insert(make_pair(metaid, newmetaid));
     }
   }
 
-  for (unsigned long el = 0; el< elements->getSize(); ++el) 
+  // rename all references in a single pass over each element
+  for (ListIterator iter = elements->begin(); iter != elements->end(); ++iter)
   {
-    SBase* element = static_cast<SBase*>(elements->get((unsigned int)el));
-  
-    for (it = renamedSIds.begin(); it != renamedSIds.end(); ++it) 
-  {
-      element->renameSIdRefs((*it).first, (*it).second);
+    SBase* element = static_cast<SBase*>(*iter);
+
+    if (!renamedSIds.empty())
+    {
+      element->renameSIdRefs(renamedSIds);
     }
-  
-    for (it = renamedUnitSIds.begin(); it != renamedUnitSIds.end(); ++it) 
-  {
-      element->renameUnitSIdRefs((*it).first, (*it).second);
+
+    if (!renamedUnitSIds.empty())
+    {
+      element->renameUnitSIdRefs(renamedUnitSIds);
     }
-  
-    for (it = renamedMetaIds.begin(); it != renamedMetaIds.end(); ++it) 
-  {
-      element->renameMetaIdRefs((*it).first, (*it).second);
+
+    if (!renamedMetaIds.empty())
+    {
+      element->renameMetaIdRefs(renamedMetaIds);
     }
   }
 }
@@ -2374,7 +2341,7 @@ Model::getFunctionDefinition (unsigned int n)
 const FunctionDefinition*
 Model::getFunctionDefinition (const std::string& sid) const
 {
-  return static_cast<const FunctionDefinition*>(mFunctionDefinitions.get(sid));
+  return static_cast<const FunctionDefinition*>( getElementFromIdIndex(mFunctionDefinitions, sid) );
 }
 
 
@@ -2385,7 +2352,7 @@ Model::getFunctionDefinition (const std::string& sid) const
 FunctionDefinition*
 Model::getFunctionDefinition (const std::string& sid)
 {
-  return static_cast<FunctionDefinition*>( mFunctionDefinitions.get(sid) );
+  return static_cast<FunctionDefinition*>( getElementFromIdIndex(mFunctionDefinitions, sid) );
 }
 
 
@@ -2458,7 +2425,7 @@ Model::getCompartmentType (unsigned int n)
 const CompartmentType*
 Model::getCompartmentType (const std::string& sid) const
 {
-  return static_cast<const CompartmentType*>( mCompartmentTypes.get(sid) );
+  return static_cast<const CompartmentType*>( getElementFromIdIndex(mCompartmentTypes, sid) );
 }
 
 
@@ -2469,7 +2436,7 @@ Model::getCompartmentType (const std::string& sid) const
 CompartmentType*
 Model::getCompartmentType (const std::string& sid)
 {
-  return static_cast<CompartmentType*>( mCompartmentTypes.get(sid) );
+  return static_cast<CompartmentType*>( getElementFromIdIndex(mCompartmentTypes, sid) );
 }
 
 
@@ -2500,7 +2467,7 @@ Model::getSpeciesType (unsigned int n)
 const SpeciesType*
 Model::getSpeciesType (const std::string& sid) const
 {
-  return static_cast<const SpeciesType*>( mSpeciesTypes.get(sid) );
+  return static_cast<const SpeciesType*>( getElementFromIdIndex(mSpeciesTypes, sid) );
 }
 
 
@@ -2511,7 +2478,7 @@ Model::getSpeciesType (const std::string& sid) const
 SpeciesType*
 Model::getSpeciesType (const std::string& sid)
 {
-  return static_cast<SpeciesType*>( mSpeciesTypes.get(sid) );
+  return static_cast<SpeciesType*>( getElementFromIdIndex(mSpeciesTypes, sid) );
 }
 
 
@@ -2542,7 +2509,7 @@ Model::getCompartment (unsigned int n)
 const Compartment*
 Model::getCompartment (const std::string& sid) const
 {
-  return static_cast<const Compartment*>( mCompartments.get(sid) );
+  return static_cast<const Compartment*>( getElementFromIdIndex(mCompartments, sid) );
 }
 
 
@@ -2553,7 +2520,7 @@ Model::getCompartment (const std::string& sid) const
 Compartment*
 Model::getCompartment (const std::string& sid)
 {
-  return static_cast<Compartment*>( mCompartments.get(sid) );
+  return static_cast<Compartment*>( getElementFromIdIndex(mCompartments, sid) );
 }
 
 
@@ -2584,7 +2551,7 @@ Model::getSpecies (unsigned int n)
 const Species*
 Model::getSpecies (const std::string& sid) const
 {
-  return static_cast<const Species*>( mSpecies.get(sid) );
+  return static_cast<const Species*>( getElementFromIdIndex(mSpecies, sid) );
 }
 
 
@@ -2595,7 +2562,7 @@ Model::getSpecies (const std::string& sid) const
 Species*
 Model::getSpecies (const std::string& sid)
 {
-  return static_cast<Species*>( mSpecies.get(sid) );
+  return static_cast<Species*>( getElementFromIdIndex(mSpecies, sid) );
 }
 
 
@@ -2626,7 +2593,7 @@ Model::getParameter (unsigned int n)
 const Parameter*
 Model::getParameter (const std::string& sid) const
 {
-  return static_cast<const Parameter*>( mParameters.get(sid) );
+  return static_cast<const Parameter*>( getElementFromIdIndex(mParameters, sid) );
 }
 
 
@@ -2637,7 +2604,7 @@ Model::getParameter (const std::string& sid) const
 Parameter*
 Model::getParameter (const std::string& sid)
 {
-  return static_cast<Parameter*>( mParameters.get(sid) );
+  return static_cast<Parameter*>( getElementFromIdIndex(mParameters, sid) );
 }
 
 
@@ -2945,7 +2912,7 @@ Model::getReaction (unsigned int n)
 const Reaction*
 Model::getReaction (const std::string& sid) const
 {
-  return static_cast<const Reaction*>( mReactions.get(sid) );
+  return static_cast<const Reaction*>( getElementFromIdIndex(mReactions, sid) );
 }
 
 
@@ -2956,7 +2923,7 @@ Model::getReaction (const std::string& sid) const
 Reaction*
 Model::getReaction (const std::string& sid)
 {
-  return static_cast<Reaction*>( mReactions.get(sid) );
+  return static_cast<Reaction*>( getElementFromIdIndex(mReactions, sid) );
 }
 
 
@@ -3051,7 +3018,7 @@ Model::getEvent (unsigned int n)
 const Event*
 Model::getEvent (const std::string& sid) const
 {
-  return static_cast<const Event*>( mEvents.get(sid) );
+  return static_cast<const Event*>( getElementFromIdIndex(mEvents, sid) );
 }
 
 
@@ -3062,7 +3029,7 @@ Model::getEvent (const std::string& sid) const
 Event*
 Model::getEvent (const std::string& sid)
 {
-  return static_cast<Event*>( mEvents.get(sid) );
+  return static_cast<Event*>( getElementFromIdIndex(mEvents, sid) );
 }
 
 
@@ -4519,6 +4486,21 @@ Model::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Model::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetConversionFactor()) {
+    const std::string* newid = getRenamedId(renamed, getConversionFactor());
+    if (newid != NULL) {
+      setConversionFactor(*newid);
+    }
+  }
+}
+/** @endcond */
+
 void 
 Model::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -4531,6 +4513,21 @@ Model::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   if (mExtentUnits == oldid)    mExtentUnits = newid;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Model::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  std::string* units[] = { &mSubstanceUnits, &mTimeUnits, &mVolumeUnits,
+                           &mAreaUnits, &mLengthUnits, &mExtentUnits };
+  for (unsigned int n = 0; n < sizeof(units) / sizeof(units[0]); ++n) {
+    const std::string* newid = getRenamedId(renamed, *units[n]);
+    if (newid != NULL) *units[n] = *newid;
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Subclasses should override this method to read (and store) XHTML,
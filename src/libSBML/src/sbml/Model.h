@@ -2860,6 +2860,12 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Predicate returning @c true if the
@@ -4221,6 +4227,10 @@ protected:
   IdList                     mMetaidList;
   UnitsValueMap              mUnitsDataMap;
 
+  /* hash index used by getElementBySId and getElementByMetaId */
+  std::shared_ptr<ElementIdIndex> mIdIndex;
+  friend class ElementIdIndex;
+
 
   /* the validator classes need to be friends to access the 
    * protected constructor that takes no arguments
@@ -4246,6 +4256,12 @@ protected:
   private:
 
   /** @cond doxygenLibsbmlInternal */
+  /**
+   * Returns the item of the given @p list with the given @p sid, looking
+   * it up in the id index unless other elements share the @p sid.
+   */
+  SBase* getElementFromIdIndex(const ListOf& list, const std::string& sid) const;
+
   /**
    * Internal function used in populateListFormulaUnitsData
    */
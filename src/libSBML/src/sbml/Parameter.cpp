@@ -341,6 +341,7 @@ Parameter::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -364,6 +365,7 @@ Parameter::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -435,6 +437,7 @@ Parameter::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -538,8 +541,14 @@ Parameter::getDerivedUnitDefinition()
    * function - but assuming that it is not calculating the units
    * thus unless we unset the flag immediately 
    * this may cause an infinite loop
+   *
+   * the flag is only written when set, since the unit validators call
+   * this concurrently when validating in parallel
    */
-  this->setCalculatingUnits(false);
+  if (calculate)
+  {
+    this->setCalculatingUnits(false);
+  }
 
   UnitDefinition * derivedUD = NULL;
   /* if we have the whole model but it is not in a document
@@ -984,6 +993,17 @@ Parameter::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   if (mUnits == oldid) mUnits= newid;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Parameter::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  const std::string* newid = getRenamedId(renamed, mUnits);
+  if (newid != NULL) mUnits = *newid;
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 /**
  * Subclasses should override this method to get the list of
@@ -1878,7 +1898,7 @@ ListOfParameters::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <Parameter*> (item);
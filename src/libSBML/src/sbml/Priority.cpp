@@ -284,6 +284,18 @@ Priority::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Priority::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 void 
 Priority::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -293,6 +305,18 @@ Priority::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Priority::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Priority::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -433,6 +433,21 @@ RateRule::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+RateRule::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  Rule::renameSIdRefs(renamed);
+  if (isSetVariable()) {
+    const std::string* newid = getRenamedId(renamed, getVariable());
+    if (newid != NULL) {
+      setVariable(*newid);
+    }
+  }
+}
+/** @endcond */
+
 #endif /* __cplusplus */
 
 
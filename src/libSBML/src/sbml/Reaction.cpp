@@ -333,6 +333,19 @@ Reaction::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Reaction::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  const std::string* newid = getRenamedId(renamed, mCompartment);
+  if (newid != NULL) {
+    setCompartment(*newid);
+  }
+}
+/** @endcond */
+
 /*
  * Initializes the fields of this Reaction to their defaults:
  *
@@ -523,6 +536,7 @@ Reaction::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -546,6 +560,7 @@ Reaction::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -660,6 +675,7 @@ Reaction::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -2561,7 +2577,7 @@ ListOfReactions::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
 
@@ -339,6 +339,11 @@ public:
   virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /**
    * Initializes the fields of this Reaction object to "typical" default
    * values.
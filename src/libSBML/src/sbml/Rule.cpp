@@ -858,6 +858,27 @@ Rule::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Rule::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+  else if (isSetFormula()) {
+    ASTNode* math = SBML_parseFormula(mFormula.c_str());
+    if (math==NULL) return;
+    math->renameSIdRefs(renamed);
+    char* formula = SBML_formulaToString(math);
+    setFormula(formula);
+    delete math;
+    delete formula;
+  }
+}
+/** @endcond */
+
 void 
 Rule::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -876,6 +897,27 @@ Rule::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Rule::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+  else if (isSetFormula()) {
+    ASTNode* math = SBML_parseFormula(mFormula.c_str());
+    if (math==NULL) return;
+    math->renameUnitSIdRefs(renamed);
+    char* formula = SBML_formulaToString(math);
+    setFormula(formula);
+    delete math;
+    delete formula;
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Rule::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -1703,7 +1745,7 @@ ListOfRules::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <Rule*> (item);
@@ -59,6 +59,7 @@
 #include <sbml/SBMLVisitor.h>
 #include <sbml/SBMLError.h>
 #include <sbml/SBMLDocument.h>
+#include <sbml/math/ASTNodeArena.h>
 #include <sbml/SBMLReader.h>
 #include <sbml/SBMLWriter.h>
 
@@ -127,6 +128,7 @@ SBMLDocument::SBMLDocument (unsigned int level, unsigned int version) :
  , mLocationURI     ("")
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
+ , mMathArena ( NULL )
 {
   if (mLevel   == 0 && mVersion == 0)  
   {
@@ -161,6 +163,7 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
  , mLocationURI ("")
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
+ , mMathArena ( NULL )
 {
   if (!hasValidLevelVersionNamespaceCombination())
   {
@@ -241,6 +244,8 @@ SBMLDocument::~SBMLDocument ()
     delete mModel;
   }
   clearValidators();
+  if (mMathArena != NULL)
+    mMathArena->release();
 }
 
 
@@ -259,6 +264,7 @@ SBMLDocument::SBMLDocument (const SBMLDocument& orig)
  , mRequiredAttrOfUnknownPkg(orig.mRequiredAttrOfUnknownPkg)
  , mRequiredAttrOfUnknownDisabledPkg(orig.mRequiredAttrOfUnknownDisabledPkg)
  , mPkgUseDefaultNSMap()
+ , mMathArena ( NULL )
 {
   
   
@@ -267,6 +273,8 @@ SBMLDocument::SBMLDocument (const SBMLDocument& orig)
   mInternalValidator->setDocument(this);
   mInternalValidator->setApplicableValidators(orig.getApplicableValidators());
   mInternalValidator->setConversionValidators(orig.getConversionValidators());
+  mInternalValidator->setParallelValidation(orig.getParallelValidation());
+  mInternalValidator->setSinglePassValidation(orig.getSinglePassValidation());
   
   if (orig.mModel != NULL) 
   {
@@ -689,6 +697,47 @@ SBMLDocument::setConsistencyChecksForConversion(SBMLErrorCategory_t category,
 }
 
 
+/*
+ * Controls whether checkConsistency() runs its validators in parallel.
+ */
+void
+SBMLDocument::setParallelValidation(bool parallel)
+{
+  mInternalValidator->setParallelValidation(parallel);
+}
+
+
+/*
+ * @return true if checkConsistency() runs its validators in parallel.
+ */
+bool
+SBMLDocument::getParallelValidation() const
+{
+  return mInternalValidator->getParallelValidation();
+}
+
+
+/*
+ * Controls whether checkConsistency() runs its validators in a single
+ * traversal of the document.
+ */
+void
+SBMLDocument::setSinglePassValidation(bool singlePass)
+{
+  mInternalValidator->setSinglePassValidation(singlePass);
+}
+
+
+/*
+ * @return true if checkConsistency() runs its validators in a single pass.
+ */
+bool
+SBMLDocument::getSinglePassValidation() const
+{
+  return mInternalValidator->getSinglePassValidation();
+}
+
+
 /*
  * Performs a set of semantic consistency checks on the document.  Query
  * the results by calling getNumErrors() and getError().
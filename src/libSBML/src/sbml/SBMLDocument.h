@@ -322,6 +322,7 @@ class SBMLVisitor;
 class SBMLValidator;
 class SBMLInternalValidator;
 class SBMLLevelVersionConverter;
+class ASTNodeArena;
 
 /** @cond doxygenLibsbmlInternal */
 /* Internal constants for setting/unsetting particular consistency checks. */
@@ -980,6 +981,68 @@ public:
                                          bool apply);
 
 
+  /**
+   * Controls whether SBMLDocument::checkConsistency() runs its validators
+   * in parallel.
+   *
+   * Parallel validation is off by default.  When it is on, the enabled
+   * validators are run concurrently; their results are merged in the same
+   * order, and with the same early exits, as the sequential run, so the
+   * reported errors are identical.  No validator is started once an
+   * earlier one has stopped the validation, but those already running by
+   * then are run to completion and their results discarded.
+   *
+   * @param parallel a boolean indicating whether the validators should be
+   * run in parallel.
+   *
+   * @see getParallelValidation()
+   */
+  void setParallelValidation(bool parallel);
+
+
+  /**
+   * Returns whether SBMLDocument::checkConsistency() runs its validators
+   * in parallel.
+   *
+   * @return @c true if parallel validation is enabled, @c false otherwise.
+   *
+   * @see setParallelValidation(bool parallel)
+   */
+  bool getParallelValidation() const;
+
+
+  /**
+   * Controls whether SBMLDocument::checkConsistency() runs its validators
+   * in a single traversal of the document.
+   *
+   * Single-pass validation is off by default, in which case every
+   * validator traverses the whole document on its own.  When it is on,
+   * each object is visited once and checked against the constraints of
+   * all enabled validators; the reported errors are identical.
+   * Validators whose results would have been discarded may still be run,
+   * however.  If both are enabled, parallel validation takes precedence.
+   *
+   * @param singlePass a boolean indicating whether the validators should
+   * be run in a single pass.
+   *
+   * @see getSinglePassValidation()
+   * @see setParallelValidation(bool parallel)
+   */
+  void setSinglePassValidation(bool singlePass);
+
+
+  /**
+   * Returns whether SBMLDocument::checkConsistency() runs its validators
+   * in a single traversal of the document.
+   *
+   * @return @c true if single-pass validation is enabled, @c false
+   * otherwise.
+   *
+   * @see setSinglePassValidation(bool singlePass)
+   */
+  bool getSinglePassValidation() const;
+
+
   /**
    * Performs consistency checking and validation on this SBML document.
    *
@@ -1758,6 +1821,9 @@ protected:
 
   PkgUseDefaultNSMap       mPkgUseDefaultNSMap;
 
+  /* Holds the math read by SBMLReader when it is using an arena. */
+  ASTNodeArena*            mMathArena;
+
   friend class SBase;
   friend class SBMLReader;
   friend class SBMLLevelVersionConverter;
@@ -49,6 +49,7 @@
 #include <sbml/SBMLError.h>
 #include <sbml/Model.h>
 #include <sbml/SBMLReader.h>
+#include <sbml/math/ASTNodeArena.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/InputDecompressor.h>
@@ -64,6 +65,7 @@ LIBSBML_CPP_NAMESPACE_BEGIN
  * Creates a new SBMLReader and returns it. 
  */
 SBMLReader::SBMLReader ()
+  : mUseMathArena(false)
 {
 }
 
@@ -185,6 +187,28 @@ SBMLReader::hasBzip2()
 }
 
 
+/*
+ * Controls whether the math of documents read by this SBMLReader is
+ * allocated from a per-document arena.
+ */
+void
+SBMLReader::setUseMathArena (bool useArena)
+{
+  mUseMathArena = useArena;
+}
+
+
+/*
+ * @return whether the math of documents read by this SBMLReader is
+ * allocated from a per-document arena.
+ */
+bool
+SBMLReader::getUseMathArena () const
+{
+  return mUseMathArena;
+}
+
+
 /** @cond doxygenLibsbmlInternal */
 static bool
 isCriticalError(const unsigned int errorId)
@@ -269,106 +293,149 @@ SBMLReader::readInternal (const char* content, bool isFile)
   {
     XMLInputStream stream(content, isFile, "", d->getErrorLog());
 
-    if (stream.peek().isStart())
+    if (!checkRootElement(d, stream))
     {
-      // so we have got an xml based document
-      //check that it is an sbml element
-      if (stream.peek().getName() != "sbml")
-      {
-        // the root element ought to be an sbml element. 
-        d->getErrorLog()->logError(NotSchemaConformant);
+      return d;
+    }
 
-        d->setInvalidLevel();
+    if (mUseMathArena)
+    {
+      d->mMathArena = new ASTNodeArena();
+    }
 
-        return d;
-      }
+    {
+      ASTNodeArena::Scope scope(d->mMathArena);
+      d->read(stream);
     }
-    else
+
+    checkDocument(d, stream);
+  }
+  return d;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+bool
+SBMLReader::checkRootElement (SBMLDocument* d, XMLInputStream& stream)
+{
+  if (stream.peek().isStart())
+  {
+    // so we have got an xml based document
+    //check that it is an sbml element
+    if (stream.peek().getName() != "sbml")
     {
-      if (stream.isError())
-      {
-        sortReportedErrors(d);    
-      }
+      // the root element ought to be an sbml element. 
+      d->getErrorLog()->logError(NotSchemaConformant);
+
       d->setInvalidLevel();
 
-      return d;
+      return false;
+    }
+  }
+  else
+  {
+    if (stream.isError())
+    {
+      sortReportedErrors(d);    
     }
+    d->setInvalidLevel();
+
+    return false;
+  }
+
+  return true;
+}
+/** @endcond */
 
-    d->read(stream);
 
-    if (stream.isError())
+/** @cond doxygenLibsbmlInternal */
+void
+SBMLReader::checkDocument (SBMLDocument* d, XMLInputStream& stream,
+                           unsigned int numCompartmentsTaken,
+                           unsigned int numSpeciesTaken,
+                           unsigned int numReactionsTaken)
+{
+  if (stream.isError())
+  {
+    // If we encountered an error, some parsers will report it sooner
+    // than others.  Unfortunately, those that fail sooner do it in an
+    // opaque call, so we can't change the behavior.  Since we don't want
+    // different parsers to report different validation errors, we bring
+    // all parsers back to the same point.
+
+    sortReportedErrors(d);    
+  }
+  else
+  {
+    // Low-level XML errors will have been caught in the first read,
+    // before we even attempt to interpret the content as SBML.  Here
+    // we want to start checking some basic SBML-level errors.
+
+    if (stream.getEncoding() == "")
     {
-      // If we encountered an error, some parsers will report it sooner
-      // than others.  Unfortunately, those that fail sooner do it in an
-      // opaque call, so we can't change the behavior.  Since we don't want
-      // different parsers to report different validation errors, we bring
-      // all parsers back to the same point.
+      d->getErrorLog()->logError(MissingXMLEncoding);
+    }
+    else if (strcmp_insensitive(stream.getEncoding().c_str(), "UTF-8") != 0)
+    {
+      d->getErrorLog()->logError(NotUTF8);
+    }
 
-      sortReportedErrors(d);    
+    if (stream.getVersion() == "")
+    {
+      d->getErrorLog()->logError(BadXMLDecl);
     }
-    else
+    else if (strcmp_insensitive(stream.getVersion().c_str(), "1.0") != 0)
     {
-      // Low-level XML errors will have been caught in the first read,
-      // before we even attempt to interpret the content as SBML.  Here
-      // we want to start checking some basic SBML-level errors.
+      d->getErrorLog()->logError(BadXMLDecl);
+    }
 
-      if (stream.getEncoding() == "")
-      {
-        d->getErrorLog()->logError(MissingXMLEncoding);
-      }
-      else if (strcmp_insensitive(stream.getEncoding().c_str(), "UTF-8") != 0)
-      {
-        d->getErrorLog()->logError(NotUTF8);
-      }
+    checkModel(d, d->getErrorLog(), numCompartmentsTaken, numSpeciesTaken,
+               numReactionsTaken);
+  }
+}
+/** @endcond */
 
-      if (stream.getVersion() == "")
-      {
-        d->getErrorLog()->logError(BadXMLDecl);
-      }
-      else if (strcmp_insensitive(stream.getVersion().c_str(), "1.0") != 0)
-      {
-        d->getErrorLog()->logError(BadXMLDecl);
-      }
 
-      if (d->getModel() == NULL)
+/** @cond doxygenLibsbmlInternal */
+void
+SBMLReader::checkModel (const SBMLDocument* d, SBMLErrorLog* log,
+                        unsigned int numCompartmentsTaken,
+                        unsigned int numSpeciesTaken,
+                        unsigned int numReactionsTaken)
+{
+  if (d->getModel() == NULL)
+  {
+    // L3V2 removed the restriction that a model was necessary
+    if (d->getLevel() < 3 ||(d->getLevel() == 3 && d->getVersion() == 1))
+    {
+      log->logError(MissingModel, d->getLevel(), d->getVersion());
+    }
+  }
+  else if (d->getLevel() == 1)
+  {
+    // In Level 1, some listOfElements were required.
+
+    if (d->getModel()->getNumCompartments() + numCompartmentsTaken == 0)
+    {
+      log->logError(NotSchemaConformant, d->getLevel(), d->getVersion(), 
+        "An SBML Level 1 model must contain at least one <compartment>.");
+    }
+
+    if (d->getVersion() == 1)
+    {
+      if (d->getModel()->getNumSpecies() + numSpeciesTaken == 0)
       {
-        // L3V2 removed the restriction that a model was necessary
-        if (d->getLevel() < 3 ||(d->getLevel() == 3 && d->getVersion() == 1))
-        {
-          d->getErrorLog()->logError(MissingModel, 
-                                     d->getLevel(), d->getVersion());
-        }
+        log->logError(NotSchemaConformant, d->getLevel(), d->getVersion(), 
+        "An SBML Level 1 Version 1 model must contain at least one <species>.");
       }
-      else if (d->getLevel() == 1)
+      if (d->getModel()->getNumReactions() + numReactionsTaken == 0)
       {
-	// In Level 1, some listOfElements were required.
-
-        if (d->getModel()->getNumCompartments() == 0)
-        {
-          d->getErrorLog()->logError(NotSchemaConformant,
-				     d->getLevel(), d->getVersion(), 
-            "An SBML Level 1 model must contain at least one <compartment>.");
-        }
-
-        if (d->getVersion() == 1)
-        {
-          if (d->getModel()->getNumSpecies() == 0)
-          {
-            d->getErrorLog()->logError(NotSchemaConformant,
-				       d->getLevel(), d->getVersion(), 
-            "An SBML Level 1 Version 1 model must contain at least one <species>.");
-          }
-          if (d->getModel()->getNumReactions() == 0)
-          {
-            d->getErrorLog()->logError(NotSchemaConformant,
-				       d->getLevel(), d->getVersion(), 
-            "An SBML Level 1 Version 1 model must contain at least one <reaction>.");
-          }
-        }
+        log->logError(NotSchemaConformant, d->getLevel(), d->getVersion(), 
+        "An SBML Level 1 Version 1 model must contain at least one <reaction>.");
       }
     }
   }
-  return d;
 }
 /** @endcond */
 
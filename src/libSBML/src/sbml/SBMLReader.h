@@ -337,6 +337,8 @@ if (doc.getNumErrors() > 0)
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 class SBMLDocument;
+class SBMLErrorLog;
+class XMLInputStream;
 
 
 class LIBSBML_EXTERN SBMLReader
@@ -441,6 +443,37 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Controls whether the math of documents read by this SBMLReader is
+   * allocated from a per-document arena.
+   *
+   * When the arena is in use, the ASTNode objects created while reading
+   * MathML are carved out of a few large blocks of memory owned by the
+   * SBMLDocument instead of being allocated one by one, and the blocks
+   * are released in bulk once the document and all nodes taken from it
+   * have been deleted.  This makes reading and deleting models with a lot
+   * of math faster, at the price of memory that is not returned to the
+   * system while any node of the document is still alive.  The arena is
+   * not used by default.
+   *
+   * @param useArena a boolean indicating whether to use an arena.
+   *
+   * @see getUseMathArena()
+   */
+  void setUseMathArena(bool useArena);
+
+
+  /**
+   * Returns whether the math of documents read by this SBMLReader is
+   * allocated from a per-document arena.
+   *
+   * @return @c true if the arena is used, @c false otherwise.
+   *
+   * @see setUseMathArena(bool useArena)
+   */
+  bool getUseMathArena() const;
+
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   /**
@@ -450,6 +483,43 @@ protected:
    */
   SBMLDocument* readInternal (const char* content, bool isFile = true);
 
+
+  /**
+   * Checks that the document in @p stream starts with an sbml element.
+   * Otherwise the errors are logged in @p d, its level is set to invalid
+   * and @c false is returned.
+   */
+  static bool checkRootElement (SBMLDocument* d, XMLInputStream& stream);
+
+
+  /**
+   * Logs the errors that can only be checked once the whole of @p stream
+   * has been read into @p d: the XML declaration, a missing model and the
+   * lists a Level 1 model must not leave empty.  The components the
+   * caller has already taken out of the model are passed in, so that they
+   * count towards the lists.
+   */
+  static void checkDocument (SBMLDocument* d, XMLInputStream& stream,
+                             unsigned int numCompartmentsTaken = 0,
+                             unsigned int numSpeciesTaken = 0,
+                             unsigned int numReactionsTaken = 0);
+
+
+  /**
+   * Logs in @p log the errors of checkDocument() that concern the model
+   * of @p d: a missing model and the lists a Level 1 model must not leave
+   * empty.
+   */
+  static void checkModel (const SBMLDocument* d, SBMLErrorLog* log,
+                          unsigned int numCompartmentsTaken = 0,
+                          unsigned int numSpeciesTaken = 0,
+                          unsigned int numReactionsTaken = 0);
+
+  bool mUseMathArena;
+
+  friend class SBMLStreamReader;
+  friend class ReadTimeConsistencyValidator;
+
   /** @endcond */
 };
 
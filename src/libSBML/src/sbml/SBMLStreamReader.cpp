@@ -0,0 +1,354 @@
+/**
+ * @file    SBMLStreamReader.cpp
+ * @brief   Reads the components of an SBML Document one at a time
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/xml/XMLError.h>
+#include <sbml/xml/XMLErrorLog.h>
+#include <sbml/xml/XMLInputStream.h>
+
+#include <sbml/SBMLDocument.h>
+#include <sbml/SBMLError.h>
+#include <sbml/ListOf.h>
+#include <sbml/SBMLReader.h>
+#include <sbml/SBMLStreamReader.h>
+
+#include <sbml/util/util.h>
+
+#include <cstring>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+#ifdef __cplusplus
+
+/*
+ * Creates a new SBMLStreamReader that is not reading anything yet.
+ */
+SBMLStreamReader::SBMLStreamReader ()
+  : mDocument(NULL)
+  , mStream(NULL)
+  , mNumCompartmentsTaken(0)
+  , mNumSpeciesTaken(0)
+  , mNumReactionsTaken(0)
+{
+}
+
+
+/*
+ * Destroys this SBMLStreamReader and its document.
+ */
+SBMLStreamReader::~SBMLStreamReader ()
+{
+  close();
+}
+
+
+/*
+ * Starts reading the SBML file filename.
+ */
+bool
+SBMLStreamReader::open (const std::string& filename)
+{
+  return openInternal(filename.c_str(), true);
+}
+
+
+/*
+ * Starts reading the SBML content of the string xml.
+ */
+bool
+SBMLStreamReader::openFromString (const std::string& xml)
+{
+  const static string dummy_xml ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+
+  if (!strncmp(xml.c_str(), dummy_xml.c_str(), 14))
+  {
+    return openInternal(xml.c_str(), false);
+  }
+  else
+  {
+    const std::string temp = (dummy_xml + xml);
+    return openInternal(temp.c_str(), false);
+  }
+}
+
+
+/*
+ * Reads and returns the next component.
+ *
+ * This is SBase::read() turned inside out: the elements of the document,
+ * the model and the ListOf objects are read one child at a time, keeping
+ * the elements the reader is inside of in mElements, and every other
+ * object is read as a whole.
+ */
+SBase*
+SBMLStreamReader::next ()
+{
+  while (!mElements.empty())
+  {
+    Element& current = mElements.back();
+    SBase*   object  = NULL;
+
+    if (!current.mObject->readNextChild(*mStream, current.mElement,
+                                        current.mPosition, object))
+    {
+      endElement();
+      continue;
+    }
+
+    if (object == NULL) continue;
+
+    if (object->getTypeCode() == SBML_LIST_OF
+        || (object->getTypeCode() == SBML_MODEL
+            && object->getPackageName() == "core"))
+    {
+      const XMLToken element = mStream->next();
+      object->readStartElement(*mStream, element);
+
+      if (element.isEnd())
+      {
+        if (mStream->isGood())
+        {
+          current.mObject->finishReadingChild(object);
+        }
+      }
+      else
+      {
+        mElements.push_back(Element(object, element));
+      }
+      continue;
+    }
+
+    object->read(*mStream);
+
+    if (!mStream->isGood()) continue;
+
+    current.mObject->finishReadingChild(object);
+
+    if (current.mObject->getTypeCode() != SBML_LIST_OF) continue;
+
+    // the ListOf has just appended the object, search from the back
+    ListOf* list = static_cast<ListOf*>(current.mObject);
+    for (unsigned int n = list->size(); n > 0; --n)
+    {
+      if (list->get(n - 1) == object)
+      {
+        list->remove(n - 1);
+        break;
+      }
+    }
+    if (current.mStandIn == NULL)
+    {
+      current.mStandIn = object->clone();
+    }
+    object->connectToParent(NULL);
+
+    if (object->getPackageName() == "core")
+    {
+      switch (object->getTypeCode())
+      {
+      case SBML_COMPARTMENT:
+        ++mNumCompartmentsTaken;
+        break;
+      case SBML_SPECIES:
+        ++mNumSpeciesTaken;
+        break;
+      case SBML_REACTION:
+        ++mNumReactionsTaken;
+        break;
+      default:
+        break;
+      }
+    }
+
+    return object;
+  }
+
+  return NULL;
+}
+
+
+/*
+ * Returns the document read so far.
+ */
+SBMLDocument*
+SBMLStreamReader::getDocument () const
+{
+  return mDocument;
+}
+
+
+/*
+ * Stops reading and deletes the document.
+ */
+void
+SBMLStreamReader::close ()
+{
+  // stand-ins that are in a ListOf go with the document
+  for (size_t i = 0; i < mElements.size(); ++i)
+  {
+    delete mElements[i].mStandIn;
+  }
+  mElements.clear();
+
+  delete mStream;
+  mStream = NULL;
+
+  delete mDocument;
+  mDocument = NULL;
+
+  mNumCompartmentsTaken = 0;
+  mNumSpeciesTaken      = 0;
+  mNumReactionsTaken    = 0;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * Used by open() and openFromString().
+ */
+bool
+SBMLStreamReader::openInternal (const char* content, bool isFile)
+{
+  close();
+
+  mDocument = new SBMLDocument();
+  if (isFile) {
+    mDocument->setLocationURI(string("file:") + content);
+  }
+
+  if (isFile && content != NULL && (util_file_exists(content) == false))
+  {
+    mDocument->getErrorLog()->logError(XMLFileUnreadable);
+    return false;
+  }
+
+  mStream = new XMLInputStream(content, isFile, "", mDocument->getErrorLog());
+
+  if (!SBMLReader::checkRootElement(mDocument, *mStream))
+  {
+    delete mStream;
+    mStream = NULL;
+    return false;
+  }
+
+  const XMLToken element = mStream->next();
+  mDocument->readStartElement(*mStream, element);
+  mElements.push_back(Element(mDocument, element));
+
+  if (element.isEnd())
+  {
+    endElement();
+  }
+
+  return true;
+}
+
+
+/*
+ * Finishes the innermost element being read.
+ */
+void
+SBMLStreamReader::endElement ()
+{
+  const Element ended = mElements.back();
+  mElements.pop_back();
+
+  for (size_t i = 0; i < ended.mChildStandIns.size(); ++i)
+  {
+    SBase*  standIn = ended.mChildStandIns[i];
+    ListOf* list    = static_cast<ListOf*>(standIn->getParentSBMLObject());
+    for (unsigned int n = 0; n < list->size(); ++n)
+    {
+      if (list->get(n) == standIn)
+      {
+        delete list->remove(n);
+        break;
+      }
+    }
+  }
+
+  if (mElements.empty())
+  {
+    SBMLReader::checkDocument(mDocument, *mStream, mNumCompartmentsTaken,
+                              mNumSpeciesTaken, mNumReactionsTaken);
+
+    delete mStream;
+    mStream = NULL;
+    return;
+  }
+
+  Element& parent = mElements.back();
+
+  if (ended.mStandIn != NULL)
+  {
+    ListOf* list = static_cast<ListOf*>(ended.mObject);
+    if (list->appendAndOwn(ended.mStandIn) == LIBSBML_OPERATION_SUCCESS)
+    {
+      parent.mChildStandIns.push_back(ended.mStandIn);
+    }
+    else
+    {
+      delete ended.mStandIn;
+    }
+  }
+
+  if (mStream->isGood())
+  {
+    parent.mObject->finishReadingChild(ended.mObject);
+  }
+}
+
+
+SBMLStreamReader::Element::Element (SBase* object, const XMLToken& element)
+  : mObject(object)
+  , mElement(element)
+  , mPosition(0)
+  , mStandIn(NULL)
+{
+}
+
+/** @endcond */
+
+
+#endif /* __cplusplus */
+LIBSBML_CPP_NAMESPACE_END
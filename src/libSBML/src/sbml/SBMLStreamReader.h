@@ -0,0 +1,224 @@
+/**
+ * @file    SBMLStreamReader.h
+ * @brief   Reads the components of an SBML Document one at a time
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SBMLStreamReader
+ * @sbmlbrief{core} Reads the components of a model one at a time.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SBMLReader builds the whole SBMLDocument before the caller sees any of
+ * it.  SBMLStreamReader instead hands out the components of the model as
+ * they are read, so that very large models can be indexed or converted
+ * while holding only one component in memory:
+ *
+ * @code{.cpp}
+ * SBMLStreamReader reader;
+ * reader.open("model.xml");
+ * while (SBase* component = reader.next())
+ * {
+ *   // ... use component, e.g. a Species or a Reaction ...
+ *   delete component;
+ * }
+ * if (reader.getDocument()->getNumErrors(LIBSBML_SEV_ERROR) > 0) ...
+ * @endcode
+ *
+ * The components are the elements of the ListOf objects of the model,
+ * such as species, reactions, parameters and rules, and of the ListOf
+ * objects that packages add to the model or the document, such as the
+ * model definitions of the hierarchical model composition package.  Each
+ * is read completely, with its math, notes, annotation and children, and
+ * is returned removed from its ListOf and disconnected from the document;
+ * the caller owns it.  Everything else is kept in the document returned
+ * by getDocument(): the sbml element, the model with its attributes,
+ * notes and annotation, and the (emptied) ListOf objects with theirs.
+ *
+ * The errors are logged in the error log of that document, as they are
+ * by SBMLReader::readSBML(), and the checks that need the whole document
+ * are done once next() has returned @c NULL.  A fatal XML error ends the
+ * reading; components returned before that may not be valid.  The math
+ * arena of SBMLReader is not used.
+ */
+
+#ifndef SBMLStreamReader_h
+#define SBMLStreamReader_h
+
+
+#include <sbml/common/extern.h>
+#include <sbml/common/sbmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+#include <sbml/xml/XMLToken.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class SBase;
+class SBMLDocument;
+class XMLInputStream;
+
+
+class LIBSBML_EXTERN SBMLStreamReader
+{
+public:
+
+  /**
+   * Creates a new SBMLStreamReader that is not reading anything yet.
+   */
+  SBMLStreamReader ();
+
+
+  /**
+   * Destroys this SBMLStreamReader and its document.
+   */
+  virtual ~SBMLStreamReader ();
+
+
+  /**
+   * Starts reading the SBML file @p filename, which may be compressed as
+   * for SBMLReader::readSBML().  Reading stops at the first component.
+   *
+   * @param filename the name or full pathname of the file to be read.
+   *
+   * @return @c true if the file has an sbml element to read from, @c false
+   * otherwise, in which case the errors are logged in getDocument().
+   */
+  bool open (const std::string& filename);
+
+
+  /**
+   * Starts reading the SBML content of the string @p xml.  An XML
+   * declaration is prepended if @p xml does not start with one.
+   *
+   * @param xml a string containing a full SBML model.
+   *
+   * @return @c true if @p xml has an sbml element to read from, @c false
+   * otherwise, in which case the errors are logged in getDocument().
+   */
+  bool openFromString (const std::string& xml);
+
+
+  /**
+   * Reads and returns the next component.
+   *
+   * @return the component, owned by the caller, or @c NULL once the end of
+   * the document has been reached or reading has stopped because of an
+   * error.
+   */
+  SBase* next ();
+
+
+  /**
+   * Returns the document read so far, without the components that have
+   * been returned by next().  The document belongs to this reader and is
+   * valid until close() or open() is called.
+   *
+   * @return the document, or @c NULL if nothing has been opened.
+   */
+  SBMLDocument* getDocument () const;
+
+
+  /**
+   * Stops reading and deletes the document.
+   */
+  void close ();
+
+
+protected:
+  /** @cond doxygenLibsbmlInternal */
+
+  /**
+   * Used by open() and openFromString().
+   */
+  bool openInternal (const char* content, bool isFile);
+
+
+  /**
+   * Finishes the innermost element being read, once its end has been
+   * read from the stream.
+   */
+  void endElement ();
+
+
+  /**
+   * An element the reader is inside of: the document, the model or a
+   * ListOf.
+   *
+   * Parents look at the size of a ListOf to tell whether it has been read
+   * before, e.g. Model::createObject() to log a repeated listOfSpecies.  A
+   * ListOf that components have been taken from is therefore left with a
+   * copy of the first of them, its stand-in, until its parent has been
+   * read.
+   */
+  struct Element
+  {
+    Element (SBase* object, const XMLToken& element);
+
+    SBase*              mObject;
+    XMLToken            mElement;
+    int                 mPosition;
+    SBase*              mStandIn;
+    std::vector<SBase*> mChildStandIns;
+  };
+
+  SBMLDocument*        mDocument;
+  XMLInputStream*      mStream;
+  std::vector<Element> mElements;
+
+  unsigned int mNumCompartmentsTaken;
+  unsigned int mNumSpeciesTaken;
+  unsigned int mNumReactionsTaken;
+
+
+private:
+  SBMLStreamReader (const SBMLStreamReader&);
+  SBMLStreamReader& operator= (const SBMLStreamReader&);
+
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SBMLStreamReader_h */
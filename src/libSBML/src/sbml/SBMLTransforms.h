@@ -177,6 +177,8 @@ public:
    * @param m the model to evaluate the AST node for
    * 
    * @return the result of the evaluation
+   *
+   * @see CompiledMath for evaluating the same node many times
    */
   static double evaluateASTNode(const ASTNode * node, const IdValueMap& values, const Model * m = NULL);
 
@@ -91,6 +91,7 @@
 #include <sbml/Priority.h>
 
 #include <sbml/SBMLReader.h>
+#include <sbml/SBMLStreamReader.h>
 #include <sbml/SBMLWriter.h>
 
 #include <sbml/math/FormulaParser.h>
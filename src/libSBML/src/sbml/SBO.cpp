@@ -42,6 +42,7 @@
 #include <iomanip>
 #include <sstream>
 #include <iterator>
+#include <mutex>
 
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLOutputStream.h>
@@ -207,10 +208,9 @@ bool
 SBO::isChildOf(unsigned int term, unsigned int parent)
 {
   bool        result = false;
-  if (mParent.empty())
-  {
-    populateSBOTree();
-  }
+  // validators may be run on several threads at once
+  static std::once_flag populated;
+  std::call_once(populated, &SBO::populateSBOTree);
   ParentRange range  = mParent.equal_range((int)term);
   deque<unsigned int>  nodes;
 
@@ -63,6 +63,7 @@
 
 #include <sbml/util/IdList.h>
 #include <sbml/util/IdentifierTransformer.h>
+#include <sbml/util/ElementIdIndex.h>
 #include <sbml/extension/SBasePlugin.h>
 #include <sbml/extension/ISBMLExtensionNamespaces.h>
 #include <sbml/extension/SBMLExtensionRegistry.h>
@@ -181,6 +182,83 @@ SBase::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Returns true for the packages whose classes override the batch
+ * renameXRefs functions wherever they override the single-identifier ones.
+ */
+static bool
+renamesRefsInOnePass(const std::string& package)
+{
+  return package == "core" || package == "comp" || package == "fbc" ||
+         package == "layout" || package == "qual";
+}
+
+/*
+ * The classes of the other packages only know about the single-identifier
+ * version, so for them the batch version has to go through it once per
+ * renamed identifier.  The classes of core, comp, fbc, layout and qual
+ * override the batch version wherever they override the single one, so
+ * for them only the plugins remain.
+ */
+void
+SBase::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (!renamesRefsInOnePass(getPackageName()))
+  {
+    std::map<std::string, std::string>::const_iterator it;
+    for (it = renamed.begin(); it != renamed.end(); ++it)
+    {
+      renameSIdRefs(it->first, it->second);
+    }
+    return;
+  }
+
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameSIdRefs(renamed);
+  }
+}
+
+void
+SBase::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (!renamesRefsInOnePass(getPackageName()))
+  {
+    std::map<std::string, std::string>::const_iterator it;
+    for (it = renamed.begin(); it != renamed.end(); ++it)
+    {
+      renameMetaIdRefs(it->first, it->second);
+    }
+    return;
+  }
+
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameMetaIdRefs(renamed);
+  }
+}
+
+void
+SBase::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (!renamesRefsInOnePass(getPackageName()))
+  {
+    std::map<std::string, std::string>::const_iterator it;
+    for (it = renamed.begin(); it != renamed.end(); ++it)
+    {
+      renameUnitSIdRefs(it->first, it->second);
+    }
+    return;
+  }
+
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 SBase*
 SBase::getElementFromPluginsBySId(const std::string& id)
@@ -481,6 +559,9 @@ SBase::SBase(const SBase& orig)
  */
 SBase::~SBase ()
 {
+  std::shared_ptr<ElementIdIndex> index = mElementIdIndex.lock();
+  if (index) index->forgetElement(this);
+
   if (mNotes != NULL)       delete mNotes;
   if (mAnnotation != NULL)  delete mAnnotation;
   if (mSBMLNamespaces != NULL)  delete mSBMLNamespaces;
@@ -587,6 +668,8 @@ SBase& SBase::operator=(const SBase& rhs)
     mPlugins.resize( rhs.mPlugins.size() );
     transform( rhs.mPlugins.begin(), rhs.mPlugins.end(),
                mPlugins.begin(), ClonePluginEntity() );
+
+    updateElementIdIndex();
   }
 
   return *this;
@@ -1216,6 +1299,7 @@ SBase::setMetaId (const std::string& metaid)
   else if (metaid.empty())
   {
     mMetaId.erase();
+    updateElementIdIndex();
     // force any annotation to synchronize
     if (isSetAnnotation())
     {
@@ -1230,6 +1314,7 @@ SBase::setMetaId (const std::string& metaid)
   else
   {
     mMetaId = metaid;
+    updateElementIdIndex();
     // force any annotation to synchronize
     if (isSetAnnotation())
     {
@@ -1263,6 +1348,7 @@ SBase::setId (const std::string& sid)
     else
     {
       mId = sid;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -1298,6 +1384,7 @@ SBase::setIdAttribute (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -2450,6 +2537,19 @@ SBase::connectToParent (SBase* parent)
   for (unsigned int p=0; p<mPlugins.size(); p++) {
     mPlugins[p]->connectToParent(this);
   }
+
+  // keep the id index of the model up to date, when moving this element
+  std::shared_ptr<ElementIdIndex> current = mElementIdIndex.lock();
+  std::shared_ptr<ElementIdIndex> index =
+    ElementIdIndex::findIndex(mParentSBMLObject);
+  if (current && current != index)
+  {
+    current->elementMoved(this);
+  }
+  if (index)
+  {
+    index->elementAdded(this, mParentSBMLObject);
+  }
 }
 
 
@@ -2597,6 +2697,7 @@ SBase::unsetMetaId ()
   }
 
   mMetaId.erase();
+  updateElementIdIndex();
 
   if (mMetaId.empty())
   {
@@ -2618,6 +2719,7 @@ SBase::unsetId ()
   if (getLevel() == 3 && getVersion() > 1)
   {
     mId.erase();
+    updateElementIdIndex();
     // HACK to make a rule in l3v2 not able to use this function
     int tc = getTypeCode();
     if (tc == SBML_ALGEBRAIC_RULE || tc == SBML_ASSIGNMENT_RULE ||
@@ -2648,6 +2750,7 @@ int
 SBase::unsetIdAttribute ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -4481,12 +4584,38 @@ SBase::read (XMLInputStream& stream)
   const XMLToken  element  = stream.next();
   int             position =  0;
 
+  readStartElement( stream, element );
+
+  if ( element.isEnd() ) return;
+
+  SBase* object = NULL;
+  while ( readNextChild(stream, element, position, object) )
+  {
+    if (object == NULL) continue;
+
+    object->read(stream);
+
+    if ( !stream.isGood() ) break;
+
+    finishReadingChild(object);
+  }
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+SBase::readStartElement (XMLInputStream& stream, const XMLToken& element)
+{
   setSBaseFields( element );
 
   ExpectedAttributes expectedAttributes;
   addExpectedAttributes(expectedAttributes);
   readAttributes( element.getAttributes(), expectedAttributes );
 
+  // readAttributes sets the id and metaid without telling the id index
+  updateElementIdIndex();
+
   /* if we are reading a document pass the
    * SBML Namespace information to the input stream object
    * thus the MathML reader can find out what level/version
@@ -4564,93 +4693,104 @@ SBase::read (XMLInputStream& stream)
       delete prefixedNS;
     }
   }
+}
+/** @endcond */
 
-  if ( element.isEnd() ) return;
 
-  while ( stream.isGood() )
+/** @cond doxygenLibsbmlInternal */
+bool
+SBase::readNextChild (XMLInputStream& stream, const XMLToken& element,
+                      int& position, SBase*& object)
+{
+  object = NULL;
+  if ( !stream.isGood() ) return false;
+
+  if (CallbackRegistry::invokeCallbacks(getSBMLDocument()) != LIBSBML_OPERATION_SUCCESS)
   {
-    if (CallbackRegistry::invokeCallbacks(getSBMLDocument()) != LIBSBML_OPERATION_SUCCESS)
-    {
-      if (getErrorLog() != NULL && !getErrorLog()->contains(OperationInterrupted))
-        logError(OperationInterrupted, getLevel(), getVersion());
-      break;
-    }
+    if (getErrorLog() != NULL && !getErrorLog()->contains(OperationInterrupted))
+      logError(OperationInterrupted, getLevel(), getVersion());
+    return false;
+  }
 
-    // read text and store in variable
-    std::string text;
-    while(stream.isGood() && stream.peek().isText())
-    {
-      text += stream.next().getCharacters();
-    }
-    setElementText(text);
+  // read text and store in variable
+  std::string text;
+  while(stream.isGood() && stream.peek().isText())
+  {
+    text += stream.next().getCharacters();
+  }
+  setElementText(text);
 
-    const XMLToken& next = stream.peek();
+  const XMLToken& next = stream.peek();
 
-    // Re-check stream.isGood() because stream.peek() could hit something.
-    if ( !stream.isGood() ) break;
+  // Re-check stream.isGood() because stream.peek() could hit something.
+  if ( !stream.isGood() ) return false;
 
-    if ( next.isEndFor(element) )
-    {
-      stream.next();
-      break;
-    }
-    else if ( next.isStart() )
-    {
-      const std::string nextName = next.getName();
-      const std::string nextURI = next.getURI();
+  if ( next.isEndFor(element) )
+  {
+    stream.next();
+    return false;
+  }
+  else if ( next.isStart() )
+  {
+    // the name parts are shared with the token, not copied
+    const XMLTriple nextTriple = next.getTriple();
 #if 0
-      cout << "[DEBUG] SBase::read " << nextName << " uri "
-           << stream.peek().getURI() << endl;
+    cout << "[DEBUG] SBase::read " << nextTriple.getName() << " uri "
+         << stream.peek().getURI() << endl;
 #endif
 
-      SBase * object = NULL;
-      try
-      {
-        object = createObject(stream);
-      }
-      catch (const SBMLExtensionException&)
-      {
-        object = NULL;
-      }
-
-      if (!object)
-      {
-        object = createExtensionObject(stream);
-      }
-
-      if (object != NULL)
-      {
-        checkOrderAndLogError(object, position);
-        position = object->getElementPosition();
-
-        object->connectToParent(static_cast <SBase*>(this));
+    try
+    {
+      object = createObject(stream);
+    }
+    catch (const SBMLExtensionException&)
+    {
+      object = NULL;
+    }
 
-        object->read(stream);
+    if (!object)
+    {
+      object = createExtensionObject(stream);
+    }
 
-        if ( !stream.isGood() ) break;
+    if (object != NULL)
+    {
+      checkOrderAndLogError(object, position);
+      position = object->getElementPosition();
 
-        if (object->getPackageName() == "core"
-            && object->getTypeCode() == SBML_SPECIES_REFERENCE
-            && object->getLevel() > 1)
-        {
-          static_cast <SpeciesReference *> (object)->sortMath();
-        }
-        checkListOfPopulated(object);
-      }
-      else if ( !( storeUnknownExtElement(stream)
-                   || readOtherXML(stream)
-                   || readAnnotation(stream)
-                   || readNotes(stream) ))
-      {
-        logUnknownElement(nextName, getLevel(), getVersion(), nextURI);
-        stream.skipPastEnd( stream.next() );
-      }
+      object->connectToParent(static_cast <SBase*>(this));
     }
-    else
+    else if ( !( storeUnknownExtElement(stream)
+                 || readOtherXML(stream)
+                 || readAnnotation(stream)
+                 || readNotes(stream) ))
     {
+      logUnknownElement(nextTriple.getName(), getLevel(), getVersion(),
+                        nextTriple.getURI());
       stream.skipPastEnd( stream.next() );
     }
   }
+  else
+  {
+    stream.skipPastEnd( stream.next() );
+  }
+
+  return true;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+SBase::finishReadingChild (SBase* object)
+{
+  if (object->getPackageName() == "core"
+      && object->getTypeCode() == SBML_SPECIES_REFERENCE
+      && object->getLevel() > 1)
+  {
+    static_cast <SpeciesReference *> (object)->sortMath();
+  }
+  checkListOfPopulated(object);
 }
 /** @endcond */
 
@@ -5053,6 +5193,37 @@ SBase::getHasBeenDeleted() const
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+SBase::updateElementIdIndex()
+{
+  std::shared_ptr<ElementIdIndex> index = mElementIdIndex.lock();
+  if (index) index->elementChanged(this);
+}
+
+
+void
+SBase::invalidateElementIdIndex()
+{
+  std::shared_ptr<ElementIdIndex> index = mElementIdIndex.lock();
+  if (index) index->invalidate();
+}
+
+
+const std::string*
+SBase::getRenamedId(const std::map<std::string, std::string>& renamed,
+                    const std::string& id)
+{
+  if (id.empty()) return NULL;
+
+  std::map<std::string, std::string>::const_iterator it = renamed.find(id);
+  if (it == renamed.end()) return NULL;
+
+  return &it->second;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * @return the ordinal position of the element with respect to its siblings
@@ -165,8 +165,10 @@
 
 
 #include <string>
+#include <map>
 #include <stdexcept>
 #include <algorithm>
+#include <memory>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -186,6 +188,7 @@ class XMLToken;
 class SBasePlugin;
 class IdentifierTransformer;
 class ElementFilter;
+class ElementIdIndex;
 
 class LIBSBML_EXTERN SBase
 {
@@ -306,6 +309,41 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Replaces, in a single pass over this object, every SIdRef that is a key
+   * of @p renamed with the corresponding value.
+   *
+   * The result is the same as calling renameSIdRefs(oldid, newid) once per
+   * entry, as long as no new identifier is also an old one.  Objects from
+   * packages other than comp, fbc, layout and qual, whose classes may only
+   * override the single-identifier version, get exactly that; the classes
+   * of core and of those packages override both versions.
+   *
+   * @param renamed a map from old to new identifiers.
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * Replaces, in a single pass over this object, every metaid reference
+   * that is a key of @p renamed with the corresponding value.
+   *
+   * @copydetails renameSIdRefs(const std::map<std::string, std::string>& renamed)
+   */
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * Replaces, in a single pass over this object, every UnitSIdRef that is a
+   * key of @p renamed with the corresponding value.
+   *
+   * @copydetails renameSIdRefs(const std::map<std::string, std::string>& renamed)
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * If this object has a child 'math' object (or anything with ASTNodes in
@@ -3971,11 +4009,37 @@ SBase.readExtensionAttributes(attributes, expectedAttributes);
 
   
   bool getHasBeenDeleted() const;
-  
+
+  /*
+   * Tells the id index of the model (if this element is indexed) that the
+   * id or metaid of this element changed.
+   */
+  void updateElementIdIndex();
+
+  /*
+   * Drops the id index of the model this element belongs to (if it is
+   * indexed), it will be rebuilt on the next lookup.
+   */
+  void invalidateElementIdIndex();
+
+  /*
+   * Returns the new identifier for @p id in @p renamed, or NULL if @p id
+   * was not renamed.  Used by the batch renameXRefs functions.
+   */
+  static const std::string* getRenamedId(
+    const std::map<std::string, std::string>& renamed, const std::string& id);
+
   /** @endcond */
 
 private:
   /** @cond doxygenLibsbmlInternal */
+
+  /* the id index of the model this element was indexed in (if any) */
+  std::weak_ptr<ElementIdIndex> mElementIdIndex;
+
+  friend class ElementIdIndex;
+  friend class ListOf;
+  friend class SBMLStreamReader;
   /**
    * Stores the location (line and column) and any XML namespaces (for
    * roundtripping) declared on this SBML (XML) element.
@@ -4009,6 +4073,37 @@ private:
   bool readNotes (XMLInputStream& stream);
 
 
+  /**
+   * Initializes this SBML object from its start element, which has
+   * already been taken from the stream: the SBase fields, the attributes
+   * and the namespace checks.
+   */
+  void readStartElement (XMLInputStream& stream, const XMLToken& element);
+
+
+  /**
+   * Reads the next child of @p element, the start element of this SBML
+   * object, from the stream.
+   *
+   * Text, annotations, notes and unknown elements are consumed.  For a
+   * child SBML object, the object is created, connected to this object
+   * and returned in @p object, but not read.  @p position is the element
+   * position of the last child object, used to check the order.
+   *
+   * @return @c false once the end of @p element has been read or reading
+   * has to stop, @c true otherwise.
+   */
+  bool readNextChild (XMLInputStream& stream, const XMLToken& element,
+                      int& position, SBase*& object);
+
+
+  /**
+   * Checks a child SBML object returned by readNextChild() once it has
+   * been read.
+   */
+  void finishReadingChild (SBase* object);
+
+
   /** @endcond */
 };
 
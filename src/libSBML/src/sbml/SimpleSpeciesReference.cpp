@@ -248,6 +248,7 @@ SimpleSpeciesReference::setId (const std::string& sid)
     if (enabledLayoutL2)
     {
       mId = sid;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
     else
@@ -262,6 +263,7 @@ SimpleSpeciesReference::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -284,7 +286,11 @@ SimpleSpeciesReference::setName (const std::string& name)
   }
   else
   {
-    if (getLevel() == 1) mId = name;
+    if (getLevel() == 1)
+    {
+      mId = name;
+      updateElementIdIndex();
+    }
     else mName = name;
     return LIBSBML_OPERATION_SUCCESS;
   }
@@ -297,6 +303,7 @@ int
 SimpleSpeciesReference::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -318,6 +325,7 @@ SimpleSpeciesReference::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -376,6 +384,19 @@ SimpleSpeciesReference::renameSIdRefs(const std::string& oldid, const std::strin
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+SimpleSpeciesReference::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetSpecies()) {
+    const std::string* newid = getRenamedId(renamed, mSpecies);
+    if (newid != NULL) setSpecies(*newid);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 bool 
 SimpleSpeciesReference::hasRequiredAttributes() const
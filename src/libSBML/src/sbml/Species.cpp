@@ -597,6 +597,7 @@ Species::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -620,6 +621,7 @@ Species::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -865,6 +867,7 @@ Species::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -1734,6 +1737,27 @@ Species::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Species::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetSpeciesType()) {
+    const std::string* newid = getRenamedId(renamed, mSpeciesType);
+    if (newid != NULL) setSpeciesType(*newid);
+  }
+  if (isSetCompartment()) {
+    const std::string* newid = getRenamedId(renamed, mCompartment);
+    if (newid != NULL) setCompartment(*newid);
+  }
+  if (isSetConversionFactor()) {
+    const std::string* newid = getRenamedId(renamed, mConversionFactor);
+    if (newid != NULL) setConversionFactor(*newid);
+  }
+}
+/** @endcond */
+
 void 
 Species::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -1746,6 +1770,23 @@ Species::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Species::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetSubstanceUnits()) {
+    const std::string* newid = getRenamedId(renamed, mSubstanceUnits);
+    if (newid != NULL) setSubstanceUnits(*newid);
+  }
+  if (isSetSpatialSizeUnits()) {
+    const std::string* newid = getRenamedId(renamed, mSpatialSizeUnits);
+    if (newid != NULL) setSpatialSizeUnits(*newid);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 /**
  * Subclasses should override this method to get the list of
@@ -2507,7 +2548,7 @@ ListOfSpecies::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <Species*> (item);
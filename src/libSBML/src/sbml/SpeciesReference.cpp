@@ -1651,7 +1651,7 @@ ListOfSpeciesReferences::remove (const std::string& sid)
   if (result != mItems.end())
   {
     item = *result;
-    mItems.erase(result);
+    ListOf::remove((unsigned int)(result - mItems.begin()));
   }
 
   return static_cast <SimpleSpeciesReference*> (item);
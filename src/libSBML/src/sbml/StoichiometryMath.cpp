@@ -278,6 +278,18 @@ StoichiometryMath::renameSIdRefs(const std::string& oldid, const std::string& ne
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+StoichiometryMath::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 void 
 StoichiometryMath::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -287,6 +299,18 @@ StoichiometryMath::renameUnitSIdRefs(const std::string& oldid, const std::string
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+StoichiometryMath::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void 
 StoichiometryMath::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
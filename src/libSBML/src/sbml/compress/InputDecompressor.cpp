@@ -49,6 +49,7 @@
 #include <iostream>
 #include <new>
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 
 #include <sbml/compress/InputDecompressor.h>
@@ -66,6 +67,48 @@ using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+#if defined(USE_ZLIB) || defined(USE_BZ2)
+/*
+ * Reads the rest of the given stream in blocks into a string allocated
+ * with malloc(), growing it as needed, so that the content is copied once
+ * instead of character by character through an ostringstream.
+ *
+ * @return the string, or NULL if it could not be allocated.
+ */
+static char*
+readString (std::istream& in)
+{
+  size_t capacity = 65536;
+  size_t size     = 0;
+  char*  buffer   = static_cast<char*>(malloc(capacity + 1));
+
+  while (buffer != NULL && in.good())
+  {
+    in.read(buffer + size, (std::streamsize)(capacity - size));
+    size += (size_t) in.gcount();
+
+    if (size == capacity)
+    {
+      char* larger = static_cast<char*>(realloc(buffer, 2 * capacity + 1));
+
+      if (larger == NULL)
+      {
+        free(buffer);
+        return NULL;
+      }
+
+      buffer    = larger;
+      capacity *= 2;
+    }
+  }
+
+  if (buffer != NULL) buffer[size] = '\0';
+
+  return buffer;
+}
+#endif
+
+
 /**
  * Opens the given gzip file as a gzifstream (subclass of std::ifstream class) object
  * for read access and returned the stream object.
@@ -136,14 +179,9 @@ char*
 InputDecompressor::getStringFromGzip (const std::string& filename) 
 {
 #ifdef USE_ZLIB
-  std::ostringstream oss;
   gzifstream in(filename.c_str(), ios_base::in | ios_base::binary);
-  istreambuf_iterator<char> in_itr(in);
-  ostreambuf_iterator<char> out_itr(oss);
-
-  std::copy(in_itr, istreambuf_iterator<char>(), out_itr);
 
-  return strdup(oss.str().c_str());
+  return readString(in);
 #else
   throw ZlibNotLinked();
   return NULL; // never reached
@@ -161,14 +199,9 @@ char*
 InputDecompressor::getStringFromBzip2 (const std::string& filename) 
 {
 #ifdef USE_BZ2
-  std::ostringstream oss;
   bzifstream in(filename.c_str(), ios_base::in | ios_base::binary);
-  istreambuf_iterator<char> in_itr(in);
-  ostreambuf_iterator<char> out_itr(oss);
 
-  std::copy(in_itr, istreambuf_iterator<char>(), out_itr);
-
-  return strdup(oss.str().c_str());
+  return readString(in);
 #else
   throw Bzip2NotLinked();
   return NULL; // never reached
@@ -189,14 +222,9 @@ char*
 InputDecompressor::getStringFromZip (const std::string& filename) 
 {
 #ifdef USE_ZLIB
-  std::ostringstream oss;
   zipifstream in(filename.c_str(), ios_base::in | ios_base::binary);
-  istreambuf_iterator<char> in_itr(in);
-  ostreambuf_iterator<char> out_itr(oss);
-
-  std::copy(in_itr, istreambuf_iterator<char>(), out_itr);
 
-  return strdup(oss.str().c_str());
+  return readString(in);
 #else
   throw ZlibNotLinked();
   return NULL; // never reached
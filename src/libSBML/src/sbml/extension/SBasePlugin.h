@@ -606,6 +606,22 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Batch versions of the functions above, see
+   * SBase::renameSIdRefs(const std::map<std::string, std::string>& renamed).
+   * By default they call the single-identifier version once per entry of
+   * @p renamed; plugins that know they hold no references can override
+   * them to do nothing.
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   virtual int transformIdentifiers(IdentifierTransformer* sidTransformer);
   /** @endcond */
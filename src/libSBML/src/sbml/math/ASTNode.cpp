@@ -48,6 +48,7 @@
 #include <sbml/util/List.h>
 
 #include <sbml/math/ASTNode.h>
+#include <sbml/math/ASTNodeArena.h>
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLNode.h>
 #include <sbml/Model.h>
@@ -236,6 +237,74 @@ static const char *AST_OPERATOR_STRINGS[] =
 
 #ifdef __cplusplus
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * The attributes of an ASTNode that are only set on few nodes; they are
+ * kept out of the node itself to keep it small.
+ */
+struct ASTNodeAttributes
+{
+  std::string units;
+
+  // additional MathML attributes
+  std::string id;
+  std::string className;
+  std::string style;
+
+  std::vector<XMLNode*> semanticsAnnotations;
+};
+
+
+ASTNodeAttributes&
+ASTNode::createAttributes ()
+{
+  if (mAttributes == NULL)
+  {
+    mAttributes = new ASTNodeAttributes();
+  }
+
+  return *mAttributes;
+}
+
+
+void
+ASTNode::copyAttributes (const ASTNode& orig)
+{
+  if (orig.mAttributes == NULL)
+  {
+    return;
+  }
+
+  mAttributes = new ASTNodeAttributes(*orig.mAttributes);
+
+  std::vector<XMLNode*>& annotations = mAttributes->semanticsAnnotations;
+  for (size_t n = 0; n < annotations.size(); ++n)
+  {
+    annotations[n] = annotations[n]->clone();
+  }
+}
+
+
+void
+ASTNode::deleteAttributes ()
+{
+  if (mAttributes == NULL)
+  {
+    return;
+  }
+
+  std::vector<XMLNode*>& annotations = mAttributes->semanticsAnnotations;
+  for (size_t n = 0; n < annotations.size(); ++n)
+  {
+    delete annotations[n];
+  }
+
+  delete mAttributes;
+  mAttributes = NULL;
+}
+/** @endcond */
+
+
 /*
  * Creates a new ASTNode.
  *
@@ -255,10 +324,7 @@ ASTNode::ASTNode (ASTNodeType_t type)
   mInteger       = 0;
   mDenominator   = 1;
   mParentSBMLObject = NULL;
-  mUnits         = "";
-  mId			 = "";
-  mClass		 = "";
-  mStyle		 = "";
+  mAttributes    = NULL;
   mIsBvar = false;
   mUserData      = NULL;
   mNamespaces = NULL;
@@ -266,8 +332,6 @@ ASTNode::ASTNode (ASTNodeType_t type)
   // move to after we have loaded plugins
   //setType(type);
 
-  mChildren             = new List;
-  mSemanticsAnnotations = new List;
   // only load plugins when we need to
   //if (type > AST_END_OF_CORE && type < AST_UNKNOWN)
   //{
@@ -302,17 +366,11 @@ ASTNode::ASTNode (Token_t* token)
   mInteger       = 0;
   mDenominator   = 1;
   mParentSBMLObject = NULL;
-  mUnits         = "";
-  mId			 = "";
-  mClass		 = "";
-  mStyle		 = "";
+  mAttributes    = NULL;
   mIsBvar = false;
   mUserData      = NULL;
   mNamespaces = NULL;
 
-  mChildren             = new List;
-  mSemanticsAnnotations = new List;
-
   if (token != NULL)
   {
     if (token->type == TT_NAME)
@@ -371,13 +429,9 @@ ASTNode::ASTNode (const ASTNode& orig) :
  ,mExponent             ( orig.mExponent )
  ,mDefinitionURL        ( orig.mDefinitionURL->clone() )	
  ,hasSemantics          ( orig.hasSemantics )
- ,mChildren             ( new List() )
- ,mSemanticsAnnotations ( new List() )
+ ,mChildren             ()
+ ,mAttributes           ( NULL )
  ,mParentSBMLObject     ( orig.mParentSBMLObject )
- ,mUnits                ( orig.mUnits)
- ,mId                   ( orig.mId)
- ,mClass                ( orig.mClass)
- ,mStyle                ( orig.mStyle)
  ,mIsBvar               ( orig.mIsBvar)
  ,mUserData             ( orig.mUserData )
  , mNamespaces          (NULL)
@@ -387,15 +441,14 @@ ASTNode::ASTNode (const ASTNode& orig) :
     mName = safe_strdup(orig.mName);
   }
 
+  mChildren.reserve(orig.getNumChildren());
   for (unsigned int c = 0; c < orig.getNumChildren(); ++c)
   {
     addChild( orig.getChild(c)->deepCopy() );
   }
 
-  for (unsigned int c = 0; c < orig.getNumSemanticsAnnotations(); ++c)
-  {
-    addSemanticsAnnotation( orig.getSemanticsAnnotation(c)->clone() );
-  }
+  copyAttributes(orig);
+
   if (orig.mNamespaces != NULL)
     this->mNamespaces =
     new XMLNamespaces(*const_cast<XMLNamespaces*>(orig.mNamespaces));
@@ -426,10 +479,6 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
     mExponent             = rhs.mExponent;
     hasSemantics          = rhs.hasSemantics;
     mParentSBMLObject     = rhs.mParentSBMLObject;
-    mUnits                = rhs.mUnits;
-    mId                   = rhs.mId;
-    mClass                = rhs.mClass;
-    mStyle                = rhs.mStyle;
     mIsBvar               = rhs.mIsBvar;
     mUserData             = rhs.mUserData;
 
@@ -443,25 +492,19 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
       mName = NULL;
     }
 
-    unsigned int size = mChildren->getSize();
-    while (size--) delete static_cast<ASTNode*>( mChildren->remove(0) );
-    delete mChildren;
-    mChildren = new List();
+    for (unsigned int c = 0; c < mChildren.size(); ++c)
+    {
+      delete mChildren[c];
+    }
+    mChildren.clear();
 
     for (unsigned int c = 0; c < rhs.getNumChildren(); ++c)
     {
       addChild( rhs.getChild(c)->deepCopy() );
     }
 
-    size = mSemanticsAnnotations->getSize();
-    while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
-    delete mSemanticsAnnotations;
-    mSemanticsAnnotations = new List();
-
-    for (unsigned int c = 0; c < rhs.getNumSemanticsAnnotations(); ++c)
-    {
-      addSemanticsAnnotation( rhs.getSemanticsAnnotation(c)->clone() );
-    }
+    deleteAttributes();
+    copyAttributes(rhs);
     
     delete mDefinitionURL;
     mDefinitionURL        = rhs.mDefinitionURL->clone();	
@@ -484,15 +527,12 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
 LIBSBML_EXTERN
 ASTNode::~ASTNode ()
 {
-  unsigned int size = getNumChildren();
-
-
-  while (size--) delete static_cast<ASTNode*>( mChildren->remove(0) );
-  delete mChildren;
+  for (unsigned int c = 0; c < mChildren.size(); ++c)
+  {
+    delete mChildren[c];
+  }
 
-  size = mSemanticsAnnotations->getSize();
-  while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
-  delete mSemanticsAnnotations;
+  deleteAttributes();
 
   delete mDefinitionURL;
 
@@ -504,6 +544,43 @@ ASTNode::~ASTNode ()
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void*
+ASTNode::operator new (size_t size)
+{
+  return ASTNodeArena::allocate(size);
+}
+
+
+void*
+ASTNode::operator new (size_t size, const std::nothrow_t&) throw()
+{
+  try
+  {
+    return ASTNodeArena::allocate(size);
+  }
+  catch (...)
+  {
+    return NULL;
+  }
+}
+
+
+void
+ASTNode::operator delete (void* ptr)
+{
+  ASTNodeArena::deallocate(ptr);
+}
+
+
+void
+ASTNode::operator delete (void* ptr, const std::nothrow_t&) throw()
+{
+  ASTNodeArena::deallocate(ptr);
+}
+/** @endcond */
+
+
 /*
  * Frees the name of this ASTNode and sets it to NULL.
  * 
@@ -847,7 +924,7 @@ ASTNode::addChild (ASTNode* child, bool inRead)
 {
 
   unsigned int numBefore = getNumChildren();
-  mChildren->add(child);
+  mChildren.push_back(child);
 
   /* HACK to allow representsBVar function to be correct */
   if (inRead == false && this->getType() == AST_LAMBDA
@@ -885,7 +962,7 @@ ASTNode::prependChild (ASTNode* child)
   if (child == NULL) return LIBSBML_INVALID_OBJECT;
 
   unsigned int numBefore = getNumChildren();
-  mChildren->prepend(child);
+  mChildren.insert(0, child);
 
   if (getNumChildren() == numBefore + 1)
   {
@@ -906,7 +983,7 @@ ASTNode::removeChild(unsigned int n, bool delremoved)
   unsigned int size = getNumChildren();
   if (n < size)
   {
-    ASTNode* child = (ASTNode*)(mChildren->remove(n));
+    ASTNode* child = mChildren.erase(n);
     if (getNumChildren() == size-1)
     {
       removed = LIBSBML_OPERATION_SUCCESS;
@@ -931,7 +1008,7 @@ ASTNode::replaceChild(unsigned int n, ASTNode *newChild, bool delreplaced)
   unsigned int size = getNumChildren();
   if (n < size)
   {
-    ASTNode* rep = static_cast<ASTNode*>(mChildren->remove(n));
+    ASTNode* rep = mChildren.erase(n);
     if (delreplaced) 
     {
       delete rep;
@@ -951,7 +1028,7 @@ ASTNode::insertChild(unsigned int n, ASTNode *newChild)
 
   int inserted = LIBSBML_INDEX_EXCEEDS_SIZE;
 
-  unsigned int i, size = getNumChildren();
+  unsigned int size = getNumChildren();
   if (n == 0)
   {
     prependChild(newChild);
@@ -959,26 +1036,7 @@ ASTNode::insertChild(unsigned int n, ASTNode *newChild)
   }
   else if (n <= size) 
   {
-    /* starting at the end take each child in the list and prepend it
-    * then remove it from the end
-    * at the insertion point prepend the newChild
-    * eg list: a, b, c 
-    * inserting d at position 2
-    * list goes: c, a, b :  d, c, a, b : b, d, c, a : a, b, d, c
-    */
-    for (i = size-1; i >= n; i--)
-    {
-      prependChild(getChild(size-1));
-      mChildren->remove(size);
-    }
-
-    prependChild(newChild);
-
-    for (i = 0; i < n; i++)
-    {
-      prependChild(getChild(size));
-      mChildren->remove(size+1);
-    }
+    mChildren.insert(n, newChild);
 
     if (getNumChildren() == size + 1)
       inserted = LIBSBML_OPERATION_SUCCESS;
@@ -1018,7 +1076,7 @@ LIBSBML_EXTERN
 ASTNode*
 ASTNode::getChild (unsigned int n) const
 {
-  return static_cast<ASTNode*>( mChildren->get(n) );
+  return (n < mChildren.size()) ? mChildren[n] : NULL;
 }
 
 
@@ -1030,7 +1088,7 @@ LIBSBML_EXTERN
 ASTNode*
 ASTNode::getLeftChild () const
 {
-  return static_cast<ASTNode*>( mChildren->get(0) );
+  return mChildren.empty() ? NULL : mChildren[0];
 }
 
 
@@ -1047,7 +1105,7 @@ ASTNode::getRightChild () const
   unsigned int nc = getNumChildren();
 
 
-  return (nc > 1) ? static_cast<ASTNode*>( mChildren->get(nc - 1) ): NULL;
+  return (nc > 1) ? mChildren[nc - 1] : NULL;
 }
 
 
@@ -1059,7 +1117,7 @@ LIBSBML_EXTERN
 unsigned int
 ASTNode::getNumChildren () const
 {
-  return mChildren->getSize();
+  return mChildren.size();
 }
 
 
@@ -1074,7 +1132,7 @@ ASTNode::addSemanticsAnnotation (XMLNode* sAnnotation)
   {
     return LIBSBML_OPERATION_FAILED;
   }
-  mSemanticsAnnotations->add(sAnnotation);
+  createAttributes().semanticsAnnotations.push_back(sAnnotation);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -1086,7 +1144,8 @@ LIBSBML_EXTERN
 unsigned int 
 ASTNode::getNumSemanticsAnnotations () const
 {
-  return mSemanticsAnnotations->getSize();
+  return (mAttributes != NULL) ? 
+    (unsigned int)mAttributes->semanticsAnnotations.size() : 0;
 }
 
 
@@ -1098,7 +1157,8 @@ LIBSBML_EXTERN
 XMLNode* 
 ASTNode::getSemanticsAnnotation (unsigned int n) const
 {
-  return static_cast<XMLNode*>( mSemanticsAnnotations->get(n) );
+  return (n < getNumSemanticsAnnotations()) ?
+    mAttributes->semanticsAnnotations[n] : NULL;
 }
 
 /*
@@ -1509,28 +1569,28 @@ LIBSBML_EXTERN
 std::string
 ASTNode::getId() const
 {
-  return mId;
+  return (mAttributes != NULL) ? mAttributes->id : std::string();
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getClass() const
 {
-  return mClass;
+  return (mAttributes != NULL) ? mAttributes->className : std::string();
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getStyle() const
 {
-  return mStyle;
+  return (mAttributes != NULL) ? mAttributes->style : std::string();
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getUnits() const
 {
-  return mUnits;
+  return (mAttributes != NULL) ? mAttributes->units : std::string();
 }
 
 /** @cond doxygenLibsbmlInternal */
@@ -2057,28 +2117,28 @@ LIBSBML_EXTERN
 bool 
 ASTNode::isSetId() const
 {
-  return (mId.empty() == false);
+  return (mAttributes != NULL && mAttributes->id.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetClass() const
 {
-  return (mClass.empty() == false);
+  return (mAttributes != NULL && mAttributes->className.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetStyle() const
 {
-  return (mStyle.empty() == false);
+  return (mAttributes != NULL && mAttributes->style.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetUnits() const
 {
-  return (mUnits.empty() == false);
+  return (mAttributes != NULL && mAttributes->units.empty() == false);
 }
   
 
@@ -2356,7 +2416,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setId (const std::string& id)
 {
-  mId     = id;
+  createAttributes().id = id;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2364,7 +2424,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setClass (const std::string& className)
 {
-  mClass   = className;
+  createAttributes().className = className;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2372,7 +2432,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setStyle (const std::string& style)
 {
-  mStyle     = style;
+  createAttributes().style = style;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2388,7 +2448,7 @@ ASTNode::setUnits (const std::string& units)
   if (!SyntaxChecker::isValidInternalUnitSId(units))
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
 
-  mUnits     = units;
+  createAttributes().units = units;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2403,9 +2463,7 @@ ASTNode::swapChildren (ASTNode *that)
   if (that == NULL)
     return LIBSBML_OPERATION_FAILED;
 
-  List *temp      = this->mChildren;
-  this->mChildren = that->mChildren;
-  that->mChildren = temp;
+  mChildren.swap(that->mChildren);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2440,6 +2498,45 @@ ASTNode::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+LIBSBML_EXTERN
+void 
+ASTNode::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (getType() == AST_NAME ||
+      getType() == AST_FUNCTION ||
+      getType() == AST_UNKNOWN) {
+    if (getName() != NULL) {
+      std::map<std::string, std::string>::const_iterator it = 
+        renamed.find(getName());
+      if (it != renamed.end()) {
+        setName(it->second.c_str());
+      }
+    }
+  }
+  for (unsigned int n = 0; n < mChildren.size(); ++n) {
+    mChildren[n]->renameSIdRefs(renamed);
+  }
+}
+
+LIBSBML_EXTERN
+void 
+ASTNode::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (isSetUnits()) {
+    std::map<std::string, std::string>::const_iterator it = 
+      renamed.find(getUnits());
+    if (it != renamed.end()) {
+      setUnits(it->second);
+    }
+  }
+  for (unsigned int n = 0; n < mChildren.size(); ++n) {
+    mChildren[n]->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 LIBSBML_EXTERN
 void 
@@ -2479,16 +2576,12 @@ LIBSBML_EXTERN
 int
 ASTNode::unsetId ()
 {
-  mId.erase();
-
-  if (mId.empty())
-  {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->id.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 
@@ -2496,32 +2589,24 @@ LIBSBML_EXTERN
 int
 ASTNode::unsetClass ()
 {
-  mClass.erase();
-
-  if (mClass.empty())
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
-  {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->className.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 LIBSBML_EXTERN
 int
 ASTNode::unsetStyle ()
 {
-  mStyle.erase();
-
-  if (mStyle.empty())
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
-  {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->style.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 LIBSBML_EXTERN
@@ -2531,16 +2616,12 @@ ASTNode::unsetUnits ()
   if (!isNumber())
     return LIBSBML_UNEXPECTED_ATTRIBUTE;
 
-  mUnits.erase();
-
-  if (mUnits.empty())
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
-  {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->units.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 
@@ -3871,7 +3952,7 @@ ASTNode::createNonBinaryTree()
   }
   for (unsigned int i = origNumChildren; i > 0; --i)
   {
-    ASTNode* rep = static_cast<ASTNode*>(mChildren->remove(i - 1));
+    ASTNode* rep = mChildren.erase(i - 1);
     delete rep;
   }
 }
@@ -4051,7 +4132,7 @@ ASTNode::reorderArguments(unsigned int level)
     }
     for (unsigned int i = origNumChildren; i > 0; --i)
     {
-      ASTNode* rep = static_cast<ASTNode*>(mChildren->remove(i - 1));
+      ASTNode* rep = mChildren.erase(i - 1);
       delete rep;
     }
 
@@ -4213,11 +4294,11 @@ ASTNode::decompose()
     ASTNode* minusOne = new ASTNode(AST_REAL);
     minusOne->setValue((double)(-1.0));
     
-    ASTNode* distrib = (ASTNode*)(mChildren->remove(childNo));
+    ASTNode* distrib = mChildren.erase(childNo);
     std::vector<ASTNode*> otherChildren;
     for (unsigned int i = getNumChildren(); i > 0; --i)
     {
-      otherChildren.push_back((ASTNode*)(mChildren->remove(i-1)));
+      otherChildren.push_back(mChildren.erase(i-1));
     }
     std::vector<ASTNode*>::iterator it = otherChildren.begin();
     this->setType(AST_PLUS);
@@ -210,6 +210,11 @@ typedef int (*ASTNodePredicate) (const ASTNode_t *node);
 LIBSBML_CPP_NAMESPACE_END
 
 #ifdef __cplusplus
+#include <map>
+#include <new>
+
+#include <sbml/util/SmallVector.h>
+
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 #ifndef SWIG
@@ -223,6 +228,7 @@ typedef ASTNodeLevels::iterator ASTNodeLevelsIterator;
 class List;
 class ASTBasePlugin;
 class ExtendedMathList;
+struct ASTNodeAttributes;
 
 class ASTNode
 {
@@ -283,6 +289,27 @@ public:
   virtual ~ASTNode ();
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /*
+   * ASTNode objects are allocated from the ASTNodeArena current on the
+   * calling thread, if there is one.
+   */
+  LIBSBML_EXTERN
+  static void* operator new (size_t size);
+
+  LIBSBML_EXTERN
+  static void* operator new (size_t size, const std::nothrow_t&) throw();
+
+  LIBSBML_EXTERN
+  static void operator delete (void* ptr);
+
+  LIBSBML_EXTERN
+  static void operator delete (void* ptr, const std::nothrow_t&) throw();
+  /** @endcond */
+#endif
+
+
   /**
    * Frees the name of this ASTNode and sets it to @c NULL.
    * 
@@ -1649,6 +1676,28 @@ setValue(value, 0);
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Renames, in a single walk over this node and its children, every
+   * SIdRef that is a key of @p renamed to the corresponding value.
+   *
+   * @param renamed a map from old to new identifiers.
+   */
+  LIBSBML_EXTERN
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * Renames, in a single walk over this node and its children, every
+   * UnitSIdRef that is a key of @p renamed to the corresponding value.
+   *
+   * @param renamed a map from old to new identifiers.
+   */
+  LIBSBML_EXTERN
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Replace any nodes of type AST_NAME with the name 'id' from the child 'math' object with the provided ASTNode. 
@@ -2507,6 +2556,23 @@ setValue(value, 0);
   bool canonicalizeLogical    ();
   bool canonicalizeRelational ();
 
+  /**
+   * Returns the rarely set attributes of this node, allocating them
+   * if necessary.
+   */
+  ASTNodeAttributes& createAttributes ();
+
+  /**
+   * Sets the rarely set attributes of this node (which must have none) to
+   * a deep copy of those of the given node.
+   */
+  void copyAttributes (const ASTNode& orig);
+
+  /**
+   * Deletes the rarely set attributes of this node.
+   */
+  void deleteAttributes ();
+
 
   ASTNodeType_t mType;
 
@@ -2520,22 +2586,17 @@ setValue(value, 0);
   XMLAttributes* mDefinitionURL;
   bool hasSemantics;
 
-  List *mChildren;
+  // most nodes have no more than two children
+  SmallVector<ASTNode*, 2> mChildren;
 
-  List *mSemanticsAnnotations;
+  // units, additional MathML attributes and semantics annotations,
+  // allocated when the first of them is set
+  ASTNodeAttributes* mAttributes;
 
   SBase *mParentSBMLObject;
 
-  std::string mUnits;
-
-  // additional MathML attributes
-  std::string mId;
-  std::string mClass;
-  std::string mStyle;
-
   bool mIsBvar;
   void *mUserData;
-  std::string mPackageName;
 
 
   XMLNamespaces* mNamespaces;
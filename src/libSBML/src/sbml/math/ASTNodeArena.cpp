@@ -0,0 +1,180 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ASTNodeArena.cpp
+ * @brief   Bump allocator for the ASTNode trees of a document.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <cstdlib>
+#include <new>
+
+#include <sbml/math/ASTNodeArena.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Every block handed out by allocate() is preceded by a header recording
+ * the arena it came from (NULL for the heap), padded so that the block
+ * itself stays suitably aligned for any type.
+ */
+static const size_t HeaderSize = 16;
+
+/*
+ * Size of the chunks reserved from the system, and the largest request
+ * that is served from a chunk rather than from the heap.
+ */
+static const size_t ChunkSize     = 64 * 1024;
+static const size_t MaxArenaBlock = 4 * 1024;
+
+static thread_local ASTNodeArena* sCurrentArena = NULL;
+
+
+ASTNodeArena::Scope::Scope (ASTNodeArena* arena)
+  : mPrevious(sCurrentArena)
+{
+  sCurrentArena = arena;
+}
+
+
+ASTNodeArena::Scope::~Scope ()
+{
+  sCurrentArena = mPrevious;
+}
+
+
+/*
+ * The owner holds one reference; every live block holds another.
+ */
+ASTNodeArena::ASTNodeArena ()
+  : mChunks()
+  , mNext(NULL)
+  , mEnd(NULL)
+  , mCapacity(0)
+  , mReferences(1)
+{
+}
+
+
+ASTNodeArena::~ASTNodeArena ()
+{
+  for (size_t n = 0; n < mChunks.size(); ++n)
+  {
+    free(mChunks[n]);
+  }
+}
+
+
+void
+ASTNodeArena::release ()
+{
+  unref();
+}
+
+
+size_t
+ASTNodeArena::getCapacity () const
+{
+  return mCapacity;
+}
+
+
+ASTNodeArena*
+ASTNodeArena::getCurrent ()
+{
+  return sCurrentArena;
+}
+
+
+void*
+ASTNodeArena::allocate (size_t size)
+{
+  ASTNodeArena* arena = sCurrentArena;
+  size_t        total = HeaderSize + ((size + HeaderSize - 1) & ~(HeaderSize - 1));
+  char*         block;
+
+  if (arena != NULL && total <= MaxArenaBlock)
+  {
+    block = static_cast<char*>(arena->allocateFromChunk(total));
+    arena->mReferences.fetch_add(1, memory_order_relaxed);
+  }
+  else
+  {
+    block = static_cast<char*>(malloc(total));
+    if (block == NULL) throw bad_alloc();
+    arena = NULL;
+  }
+
+  *reinterpret_cast<ASTNodeArena**>(block) = arena;
+  return block + HeaderSize;
+}
+
+
+void
+ASTNodeArena::deallocate (void* ptr)
+{
+  if (ptr == NULL) return;
+
+  char*         block = static_cast<char*>(ptr) - HeaderSize;
+  ASTNodeArena* arena = *reinterpret_cast<ASTNodeArena**>(block);
+
+  if (arena == NULL)
+  {
+    free(block);
+  }
+  else
+  {
+    arena->unref();
+  }
+}
+
+
+void*
+ASTNodeArena::allocateFromChunk (size_t size)
+{
+  if (mNext == NULL || size > static_cast<size_t>(mEnd - mNext))
+  {
+    char* chunk = static_cast<char*>(malloc(ChunkSize));
+    if (chunk == NULL) throw bad_alloc();
+
+    mChunks.push_back(chunk);
+    mCapacity += ChunkSize;
+    mNext      = chunk;
+    mEnd       = chunk + ChunkSize;
+  }
+
+  void* block = mNext;
+  mNext += size;
+  return block;
+}
+
+
+void
+ASTNodeArena::unref ()
+{
+  if (mReferences.fetch_sub(1, memory_order_acq_rel) == 1)
+  {
+    delete this;
+  }
+}
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
@@ -0,0 +1,139 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ASTNodeArena.h
+ * @brief   Bump allocator for the ASTNode trees of a document.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class ASTNodeArena
+ * @sbmlbrief{core} Allocates ASTNode objects from large chunks of memory.
+ *
+ * While an ASTNodeArena is made current on a thread (see
+ * ASTNodeArena::Scope), every ASTNode created on that thread, whether by
+ * readMathML(), SBML_parseL3Formula() or directly, is carved out of the
+ * arena's chunks instead of being allocated individually.  Deleting such a
+ * node runs its destructor as usual but does not return the memory; the
+ * chunks are released in bulk once the owner has called release() and the
+ * last node allocated from the arena has been deleted.  Nodes may therefore
+ * safely outlive the document that owns the arena.
+ *
+ * An arena may only be current on one thread at a time; nodes allocated
+ * from it may be deleted on any thread.
+ */
+
+#ifndef ASTNodeArena_h
+#define ASTNodeArena_h
+
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <sbml/common/extern.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBSBML_EXTERN ASTNodeArena
+{
+public:
+
+  /**
+   * Makes an arena current on the calling thread for the lifetime of the
+   * Scope object, restoring the previously current arena afterwards.
+   * Passing @c NULL makes the heap current again.
+   */
+  class LIBSBML_EXTERN Scope
+  {
+  public:
+
+    explicit Scope (ASTNodeArena* arena);
+
+    ~Scope ();
+
+  private:
+
+    Scope (const Scope&);
+    Scope& operator= (const Scope&);
+
+    ASTNodeArena* mPrevious;
+  };
+
+
+  /**
+   * Creates a new, empty ASTNodeArena owned by the caller.
+   */
+  ASTNodeArena ();
+
+
+  /**
+   * Drops the owner's reference.  The arena deletes itself, together with
+   * all its chunks, as soon as no node allocated from it is alive.
+   */
+  void release ();
+
+
+  /**
+   * @return the number of bytes reserved from the system by this arena.
+   */
+  size_t getCapacity () const;
+
+
+  /**
+   * @return the arena current on the calling thread, or @c NULL.
+   */
+  static ASTNodeArena* getCurrent ();
+
+
+  /**
+   * Allocates @p size bytes from the current arena, or from the heap if
+   * there is none.  Used by ASTNode::operator new.
+   */
+  static void* allocate (size_t size);
+
+
+  /**
+   * Frees memory returned by allocate().  Used by ASTNode::operator delete.
+   */
+  static void deallocate (void* ptr);
+
+
+private:
+
+  ~ASTNodeArena ();
+
+  ASTNodeArena (const ASTNodeArena&);
+  ASTNodeArena& operator= (const ASTNodeArena&);
+
+  void* allocateFromChunk (size_t size);
+
+  void unref ();
+
+  std::vector<char*> mChunks;
+  char*              mNext;
+  char*              mEnd;
+  size_t             mCapacity;
+  std::atomic<long>  mReferences;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ASTNodeArena_h */
+/** @endcond */
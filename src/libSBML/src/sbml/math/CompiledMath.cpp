@@ -0,0 +1,831 @@
+/**
+ * @file    CompiledMath.cpp
+ * @brief   Flat, reusable program evaluating an ASTNode over a value array.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <cmath>
+#include <limits>
+
+#include <sbml/math/CompiledMath.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/Model.h>
+#include <sbml/FunctionDefinition.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * The unary functions.  Those without a counterpart in <cmath> use the
+ * same formulas as SBMLTransforms::evaluateASTNode(), so that both give
+ * identical results.
+ */
+static double mathAbs     (double x) { return fabs(x);  }
+static double mathAcos    (double x) { return acos(x);  }
+static double mathAsin    (double x) { return asin(x);  }
+static double mathAtan    (double x) { return atan(x);  }
+static double mathCeil    (double x) { return ceil(x);  }
+static double mathCos     (double x) { return cos(x);   }
+static double mathCosh    (double x) { return cosh(x);  }
+static double mathExp     (double x) { return exp(x);   }
+static double mathFloor   (double x) { return floor(x); }
+static double mathLn      (double x) { return log(x);   }
+static double mathLog10   (double x) { return log10(x); }
+static double mathSin     (double x) { return sin(x);   }
+static double mathSinh    (double x) { return sinh(x);  }
+static double mathTan     (double x) { return tan(x);   }
+static double mathTanh    (double x) { return tanh(x);  }
+static double mathNot     (double x) { return (double)(!x); }
+
+static double mathArccosh (double x)
+{
+  return log(x + pow((x - 1), 0.5) * pow((x + 1), 0.5));
+}
+
+static double mathArccot  (double x) { return atan(1.0 / x); }
+
+static double mathArccoth (double x)
+{
+  return ((1.0 / 2.0) * log((x + 1.0) / (x - 1.0)));
+}
+
+static double mathArccsc  (double x) { return asin(1.0 / x); }
+
+static double mathArccsch (double x)
+{
+  return log((1.0 + pow(1.0 + pow(x, 2), 0.5)) / x);
+}
+
+static double mathArcsec  (double x) { return acos(1.0 / x); }
+
+static double mathArcsech (double x)
+{
+  return log((1.0 + pow((1.0 - pow(x, 2)), 0.5)) / x);
+}
+
+static double mathArcsinh (double x)
+{
+  return log(x + pow((1.0 + pow(x, 2)), 0.5));
+}
+
+static double mathArctanh (double x)
+{
+  return 0.5 * log((1.0 + x) / (1.0 - x));
+}
+
+static double mathCot     (double x) { return (1.0 / tan(x)); }
+static double mathCoth    (double x) { return cosh(x) / sinh(x); }
+static double mathCsc     (double x) { return (1.0 / sin(x)); }
+static double mathCsch    (double x) { return (1.0 / sinh(x)); }
+static double mathSec     (double x) { return 1.0 / cos(x); }
+static double mathSech    (double x) { return 1.0 / cosh(x); }
+
+static double mathFactorial (double x)
+{
+  int    i      = (int)(floor(x));
+  double result = 1;
+  for (; i > 1; --i)
+  {
+    result *= i;
+  }
+  return result;
+}
+
+
+static double
+evaluatePiecewise (const double* args, unsigned int numArgs)
+{
+  double result   = 0;
+  bool   assigned = false;
+  unsigned int numPieces = (numArgs % 2 == 0) ? numArgs : numArgs - 1;
+
+  for (unsigned int j = 0; j < numPieces; j += 2)
+  {
+    if (args[j + 1] == 1.0)
+    {
+      // we might have two true piece statements
+      // if the values are the same - fine
+      // if not then the result is undefined
+      if (assigned == true)
+      {
+        if (args[j] != result)
+        {
+          result = numeric_limits<double>::quiet_NaN();
+        }
+      }
+      else
+      {
+        result   = args[j];
+        assigned = true;
+      }
+    }
+  }
+
+  if (!assigned)
+  {
+    result = (numPieces == numArgs) ? numeric_limits<double>::quiet_NaN()
+                                    : args[numArgs - 1];
+  }
+
+  return result;
+}
+
+/** @endcond */
+
+
+CompiledMath::CompiledMath ()
+  : mProgram()
+  , mSlotIds()
+  , mSlotIndex()
+  , mFixedSlots(false)
+  , mNumLocals(0)
+  , mDepth(0)
+  , mMaxDepth(0)
+  , mScratch()
+  , mModel(NULL)
+  , mBindings()
+  , mFrame(0)
+  , mInlining()
+{
+}
+
+
+CompiledMath::CompiledMath (const CompiledMath& orig)
+  : mProgram(orig.mProgram)
+  , mSlotIds(orig.mSlotIds)
+  , mSlotIndex(orig.mSlotIndex)
+  , mFixedSlots(orig.mFixedSlots)
+  , mNumLocals(orig.mNumLocals)
+  , mDepth(0)
+  , mMaxDepth(orig.mMaxDepth)
+  , mScratch(orig.mScratch.size())
+  , mModel(NULL)
+  , mBindings()
+  , mFrame(0)
+  , mInlining()
+{
+}
+
+
+CompiledMath&
+CompiledMath::operator= (const CompiledMath& rhs)
+{
+  if (&rhs != this)
+  {
+    mProgram    = rhs.mProgram;
+    mSlotIds    = rhs.mSlotIds;
+    mSlotIndex  = rhs.mSlotIndex;
+    mFixedSlots = rhs.mFixedSlots;
+    mNumLocals  = rhs.mNumLocals;
+    mMaxDepth   = rhs.mMaxDepth;
+    mScratch.assign(rhs.mScratch.size(), 0.0);
+  }
+  return *this;
+}
+
+
+CompiledMath::~CompiledMath ()
+{
+}
+
+
+int
+CompiledMath::compile (const ASTNode* math, const Model* m)
+{
+  clear();
+  if (math == NULL) return LIBSBML_INVALID_OBJECT;
+
+  mModel = m;
+  bool success = compileNode(math);
+  mModel = NULL;
+  mBindings.clear();
+  mInlining.clear();
+
+  if (!success)
+  {
+    clear();
+    return LIBSBML_OPERATION_FAILED;
+  }
+
+  mScratch.assign(mNumLocals + mMaxDepth, 0.0);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+int
+CompiledMath::compile (const ASTNode* math, const IdList& slotIds,
+                       const Model* m)
+{
+  clear();
+  if (math == NULL) return LIBSBML_INVALID_OBJECT;
+
+  for (vector<string>::const_iterator it = slotIds.begin();
+       it != slotIds.end(); ++it)
+  {
+    mSlotIndex.insert(make_pair(*it, (unsigned int)mSlotIds.size()));
+    mSlotIds.push_back(*it);
+  }
+  mFixedSlots = true;
+
+  mModel = m;
+  bool success = compileNode(math);
+  mModel = NULL;
+  mBindings.clear();
+  mInlining.clear();
+
+  if (!success)
+  {
+    clear();
+    return LIBSBML_OPERATION_FAILED;
+  }
+
+  mScratch.assign(mNumLocals + mMaxDepth, 0.0);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+bool
+CompiledMath::isCompiled () const
+{
+  return !mProgram.empty();
+}
+
+
+unsigned int
+CompiledMath::getNumSlots () const
+{
+  return (unsigned int)mSlotIds.size();
+}
+
+
+std::string
+CompiledMath::getSlotId (unsigned int n) const
+{
+  return (n < mSlotIds.size()) ? mSlotIds[n] : std::string();
+}
+
+
+int
+CompiledMath::getSlotIndex (const std::string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mSlotIndex.find(id);
+  return (it != mSlotIndex.end()) ? (int)it->second : -1;
+}
+
+
+double
+CompiledMath::evaluate (const double* values) const
+{
+  if (mProgram.empty())
+  {
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+  double* locals = &mScratch[0];
+  double* top    = locals + mNumLocals - 1;
+
+  const Instruction* pc  = &mProgram[0];
+  const Instruction* end = pc + mProgram.size();
+
+  for (; pc != end; ++pc)
+  {
+    switch (pc->op)
+    {
+    case OpConstant:
+      *++top = pc->value;
+      break;
+
+    case OpLoad:
+      *++top = values[pc->arg];
+      break;
+
+    case OpLoadLocal:
+      *++top = locals[pc->arg];
+      break;
+
+    case OpStoreLocal:
+      locals[pc->arg] = *top--;
+      break;
+
+    case OpAdd:
+      --top;
+      top[0] = top[0] + top[1];
+      break;
+
+    case OpSubtract:
+      --top;
+      top[0] = top[0] - top[1];
+      break;
+
+    case OpMultiply:
+      --top;
+      top[0] = top[0] * top[1];
+      break;
+
+    case OpDivide:
+      --top;
+      top[0] = top[0] / top[1];
+      break;
+
+    case OpPower:
+      --top;
+      top[0] = pow(top[0], top[1]);
+      break;
+
+    case OpRoot:
+      --top;
+      top[0] = pow(top[1], (1.0 / top[0]));
+      break;
+
+    case OpNegate:
+      top[0] = -top[0];
+      break;
+
+    case OpFunction:
+      top[0] = pc->function(top[0]);
+      break;
+
+    case OpAnd:
+      --top;
+      top[0] = (double)(top[0] && top[1]);
+      break;
+
+    case OpOr:
+      --top;
+      top[0] = (double)(top[0] || top[1]);
+      break;
+
+    case OpXor:
+      --top;
+      top[0] = (double)((!top[0] && top[1]) || (top[0] && !top[1]));
+      break;
+
+    case OpEq:
+    case OpGeq:
+    case OpGt:
+    case OpLeq:
+    case OpLt:
+    case OpNeq:
+    {
+      top -= pc->arg - 1;
+      double result = 1.0;
+      for (unsigned int j = 1; j < pc->arg; ++j)
+      {
+        double a = top[j - 1], b = top[j];
+        switch (pc->op)
+        {
+        case OpEq:  result *= (double)(a == b); break;
+        case OpGeq: result *= (double)(a >= b); break;
+        case OpGt:  result *= (double)(a >  b); break;
+        case OpLeq: result *= (double)(a <= b); break;
+        case OpLt:  result *= (double)(a <  b); break;
+        default:    result *= (double)(a != b); break;
+        }
+      }
+      top[0] = result;
+      break;
+    }
+
+    case OpPiecewise:
+      if (pc->arg == 0)
+      {
+        *++top = numeric_limits<double>::quiet_NaN();
+      }
+      else
+      {
+        top -= pc->arg - 1;
+        top[0] = evaluatePiecewise(top, pc->arg);
+      }
+      break;
+    }
+  }
+
+  return *top;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+
+void
+CompiledMath::clear ()
+{
+  mProgram.clear();
+  mSlotIds.clear();
+  mSlotIndex.clear();
+  mFixedSlots = false;
+  mNumLocals  = 0;
+  mDepth      = 0;
+  mMaxDepth   = 0;
+  mScratch.clear();
+  mBindings.clear();
+  mFrame      = 0;
+  mInlining.clear();
+}
+
+
+void
+CompiledMath::emit (int op, unsigned int arg, double value,
+                    double (*function)(double))
+{
+  Instruction instruction;
+  instruction.op       = op;
+  instruction.arg      = arg;
+  instruction.value    = value;
+  instruction.function = function;
+  mProgram.push_back(instruction);
+}
+
+
+void
+CompiledMath::push (unsigned int count)
+{
+  mDepth += count;
+  if (mDepth > mMaxDepth) mMaxDepth = mDepth;
+}
+
+
+void
+CompiledMath::pop (unsigned int count)
+{
+  mDepth -= count;
+}
+
+
+const vector<double (*)(double)>&
+CompiledMath::getFunctions ()
+{
+  static double (* const functions[])(double) = {
+    mathAbs, mathAcos, mathAsin, mathAtan, mathCeil, mathCos, mathCosh,
+    mathExp, mathFloor, mathLn, mathLog10, mathSin, mathSinh, mathTan,
+    mathTanh, mathNot, mathArccosh, mathArccot, mathArccoth, mathArccsc,
+    mathArccsch, mathArcsec, mathArcsech, mathArcsinh, mathArctanh,
+    mathCot, mathCoth, mathCsc, mathCsch, mathSec, mathSech,
+    mathFactorial
+  };
+  static const vector<double (*)(double)> table(functions,
+    functions + sizeof(functions) / sizeof(functions[0]));
+
+  return table;
+}
+
+
+/*
+ * Compiles the n-th child of the given node; a missing child evaluates to
+ * NaN, as it does in SBMLTransforms::evaluateASTNode().
+ */
+bool
+CompiledMath::compileChild (const ASTNode* node, unsigned int n)
+{
+  if (n >= node->getNumChildren())
+  {
+    emit(OpConstant, 0, numeric_limits<double>::quiet_NaN());
+    push();
+    return true;
+  }
+
+  return compileNode(node->getChild(n));
+}
+
+
+bool
+CompiledMath::compileNode (const ASTNode* node)
+{
+  unsigned int numChildren = node->getNumChildren();
+  double (*function)(double) = NULL;
+  int op = OpConstant;
+
+  switch (node->getType())
+  {
+  case AST_INTEGER:
+    emit(OpConstant, 0, (double)(node->getInteger()));
+    push();
+    return true;
+
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+    emit(OpConstant, 0, node->getReal());
+    push();
+    return true;
+
+  case AST_NAME:
+  case AST_NAME_AVOGADRO:
+  case AST_NAME_TIME:
+    return compileName(node);
+
+  case AST_CONSTANT_E:
+    /* exp(1) is used to adjust exponentiale to machine precision */
+    emit(OpConstant, 0, exp(1.0));
+    push();
+    return true;
+
+  case AST_CONSTANT_FALSE:
+    emit(OpConstant, 0, 0.0);
+    push();
+    return true;
+
+  case AST_CONSTANT_PI:
+    /* pi = 4 * atan 1  is used to adjust Pi to machine precision */
+    emit(OpConstant, 0, 4.0*atan(1.0));
+    push();
+    return true;
+
+  case AST_CONSTANT_TRUE:
+    emit(OpConstant, 0, 1.0);
+    push();
+    return true;
+
+  case AST_LAMBDA:
+  case AST_FUNCTION_DELAY:
+    emit(OpConstant, 0, numeric_limits<double>::quiet_NaN());
+    push();
+    return true;
+
+  case AST_FUNCTION:
+    return compileFunction(node);
+
+  case AST_PLUS:
+  case AST_TIMES:
+    if (numChildren == 0)
+    {
+      emit(OpConstant, 0, (node->getType() == AST_PLUS) ? 0.0 : 1.0);
+      push();
+      return true;
+    }
+    if (!compileNode(node->getChild(0))) return false;
+    for (unsigned int j = 1; j < numChildren; ++j)
+    {
+      if (!compileNode(node->getChild(j))) return false;
+      emit(node->getType() == AST_PLUS ? OpAdd : OpMultiply);
+      pop();
+    }
+    return true;
+
+  case AST_MINUS:
+    if (numChildren == 1)
+    {
+      if (!compileNode(node->getChild(0))) return false;
+      emit(OpNegate);
+      return true;
+    }
+    op = OpSubtract;
+    break;
+
+  case AST_DIVIDE:
+    op = OpDivide;
+    break;
+
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+    op = OpPower;
+    break;
+
+  case AST_FUNCTION_ROOT:
+    op = OpRoot;
+    break;
+
+  case AST_LOGICAL_AND:
+  case AST_LOGICAL_OR:
+  case AST_LOGICAL_XOR:
+    /* only the first two arguments are considered */
+    if (numChildren == 0)
+    {
+      emit(OpConstant, 0, (node->getType() == AST_LOGICAL_AND) ? 1.0 : 0.0);
+      push();
+      return true;
+    }
+    if (numChildren == 1)
+    {
+      return compileNode(node->getChild(0));
+    }
+    op = (node->getType() == AST_LOGICAL_AND) ? OpAnd
+       : (node->getType() == AST_LOGICAL_OR)  ? OpOr : OpXor;
+    break;
+
+  case AST_RELATIONAL_EQ:  op = OpEq;  break;
+  case AST_RELATIONAL_GEQ: op = OpGeq; break;
+  case AST_RELATIONAL_GT:  op = OpGt;  break;
+  case AST_RELATIONAL_LEQ: op = OpLeq; break;
+  case AST_RELATIONAL_LT:  op = OpLt;  break;
+  case AST_RELATIONAL_NEQ: op = OpNeq; break;
+
+  case AST_FUNCTION_PIECEWISE:
+    for (unsigned int j = 0; j < numChildren; ++j)
+    {
+      if (!compileNode(node->getChild(j))) return false;
+    }
+    emit(OpPiecewise, numChildren);
+    if (numChildren == 0) push(); else pop(numChildren - 1);
+    return true;
+
+  case AST_FUNCTION_LOG:
+    /* the base is ignored */
+    if (!compileChild(node, 1)) return false;
+    emit(OpFunction, 0, 0.0, mathLog10);
+    return true;
+
+  case AST_FUNCTION_ABS:       function = mathAbs;       break;
+  case AST_FUNCTION_ARCCOS:    function = mathAcos;      break;
+  case AST_FUNCTION_ARCCOSH:   function = mathArccosh;   break;
+  case AST_FUNCTION_ARCCOT:    function = mathArccot;    break;
+  case AST_FUNCTION_ARCCOTH:   function = mathArccoth;   break;
+  case AST_FUNCTION_ARCCSC:    function = mathArccsc;    break;
+  case AST_FUNCTION_ARCCSCH:   function = mathArccsch;   break;
+  case AST_FUNCTION_ARCSEC:    function = mathArcsec;    break;
+  case AST_FUNCTION_ARCSECH:   function = mathArcsech;   break;
+  case AST_FUNCTION_ARCSIN:    function = mathAsin;      break;
+  case AST_FUNCTION_ARCSINH:   function = mathArcsinh;   break;
+  case AST_FUNCTION_ARCTAN:    function = mathAtan;      break;
+  case AST_FUNCTION_ARCTANH:   function = mathArctanh;   break;
+  case AST_FUNCTION_CEILING:   function = mathCeil;      break;
+  case AST_FUNCTION_COS:       function = mathCos;       break;
+  case AST_FUNCTION_COSH:      function = mathCosh;      break;
+  case AST_FUNCTION_COT:       function = mathCot;       break;
+  case AST_FUNCTION_COTH:      function = mathCoth;      break;
+  case AST_FUNCTION_CSC:       function = mathCsc;       break;
+  case AST_FUNCTION_CSCH:      function = mathCsch;      break;
+  case AST_FUNCTION_EXP:       function = mathExp;       break;
+  case AST_FUNCTION_FACTORIAL: function = mathFactorial; break;
+  case AST_FUNCTION_FLOOR:     function = mathFloor;     break;
+  case AST_FUNCTION_LN:        function = mathLn;        break;
+  case AST_FUNCTION_SEC:       function = mathSec;       break;
+  case AST_FUNCTION_SECH:      function = mathSech;      break;
+  case AST_FUNCTION_SIN:       function = mathSin;       break;
+  case AST_FUNCTION_SINH:      function = mathSinh;      break;
+  case AST_FUNCTION_TAN:       function = mathTan;       break;
+  case AST_FUNCTION_TANH:      function = mathTanh;      break;
+  case AST_LOGICAL_NOT:        function = mathNot;       break;
+
+  default:
+    /* constructs defined by packages are left to the interpreter */
+    return false;
+  }
+
+  if (function != NULL)
+  {
+    if (!compileChild(node, 0)) return false;
+    emit(OpFunction, 0, 0.0, function);
+    return true;
+  }
+
+  if (op >= OpEq && op <= OpNeq)
+  {
+    if (numChildren < 2)
+    {
+      emit(OpConstant, 0, 0.0);
+      push();
+      return true;
+    }
+    for (unsigned int j = 0; j < numChildren; ++j)
+    {
+      if (!compileNode(node->getChild(j))) return false;
+    }
+    emit(op, numChildren);
+    pop(numChildren - 1);
+    return true;
+  }
+
+  /* binary operators use the first two children */
+  if (!compileChild(node, 0) || !compileChild(node, 1)) return false;
+  emit(op);
+  pop();
+  return true;
+}
+
+
+bool
+CompiledMath::compileName (const ASTNode* node)
+{
+  const char* name = node->getName();
+
+  /* arguments of the function definition being inlined */
+  if (name != NULL)
+  {
+    for (size_t n = mBindings.size(); n > mFrame; --n)
+    {
+      if (mBindings[n - 1].name == name)
+      {
+        emit(OpLoadLocal, mBindings[n - 1].local);
+        push();
+        return true;
+      }
+    }
+  }
+
+  if (node->getType() == AST_NAME_TIME)
+  {
+    emit(OpConstant, 0, 0.0);
+    push();
+    return true;
+  }
+
+  if (node->getType() == AST_NAME_AVOGADRO)
+  {
+    emit(OpConstant, 0, node->getReal());
+    push();
+    return true;
+  }
+
+  string id = (name != NULL) ? name : "";
+  map<string, unsigned int>::const_iterator it = mSlotIndex.find(id);
+
+  if (it != mSlotIndex.end())
+  {
+    emit(OpLoad, it->second);
+  }
+  else if (mFixedSlots)
+  {
+    emit(OpConstant, 0, numeric_limits<double>::quiet_NaN());
+  }
+  else
+  {
+    unsigned int slot = (unsigned int)mSlotIds.size();
+    mSlotIndex.insert(make_pair(id, slot));
+    mSlotIds.push_back(id);
+    emit(OpLoad, slot);
+  }
+
+  push();
+  return true;
+}
+
+
+/*
+ * Inlines a call to a function definition: the arguments are evaluated
+ * once into locals, which the body then reads wherever it refers to the
+ * corresponding bound variable.
+ */
+bool
+CompiledMath::compileFunction (const ASTNode* node)
+{
+  const FunctionDefinition* fd = NULL;
+  if (mModel != NULL && node->getName() != NULL)
+  {
+    fd = mModel->getFunctionDefinition(node->getName());
+  }
+
+  if (fd == NULL || !fd->isSetMath() || fd->getBody() == NULL)
+  {
+    emit(OpConstant, 0, numeric_limits<double>::quiet_NaN());
+    push();
+    return true;
+  }
+
+  for (size_t n = 0; n < mInlining.size(); ++n)
+  {
+    if (mInlining[n] == fd) return false;
+  }
+
+  unsigned int numBvars = fd->getNumArguments();
+  vector<Binding> bindings;
+
+  for (unsigned int i = 0; i < numBvars; ++i)
+  {
+    if (!compileChild(node, i)) return false;
+
+    Binding binding;
+    binding.name  = (fd->getArgument(i)->getName() != NULL)
+                  ? fd->getArgument(i)->getName() : "";
+    binding.local = mNumLocals++;
+    bindings.push_back(binding);
+
+    emit(OpStoreLocal, binding.local);
+    pop();
+  }
+
+  size_t frame = mFrame;
+  mFrame = mBindings.size();
+  mBindings.insert(mBindings.end(), bindings.begin(), bindings.end());
+  mInlining.push_back(fd);
+
+  bool success = compileNode(fd->getBody());
+
+  mInlining.pop_back();
+  mBindings.resize(mFrame);
+  mFrame = frame;
+
+  return success;
+}
+
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_END
@@ -0,0 +1,298 @@
+/**
+ * @file    CompiledMath.h
+ * @brief   Flat, reusable program evaluating an ASTNode over a value array.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class CompiledMath
+ * @sbmlbrief{core} A mathematical expression compiled for repeated
+ * evaluation.
+ *
+ * @htmlinclude libsbml-facility-only-warning.html
+ *
+ * SBMLTransforms::evaluateASTNode() walks the ASTNode tree on every call,
+ * looking up each identifier by name and expanding calls to function
+ * definitions as it goes.  When the same expression has to be evaluated
+ * many times with different values, for instance in a parameter scan, a
+ * CompiledMath object can be used instead.  CompiledMath::compile()
+ * translates the expression once into a flat program in which
+ *
+ * @li every identifier is replaced by the index of a @em slot, that is,
+ * of an entry in an array of doubles supplied by the caller, and
+ * @li every call to a FunctionDefinition of the model is inlined.
+ *
+ * CompiledMath::evaluate() then runs this program over an array of slot
+ * values without allocating memory or comparing strings.  The results are
+ * identical to those of SBMLTransforms::evaluateASTNode(), except that the
+ * value of an identifier is always taken from its slot: values determined
+ * by rules or initial assignments are not computed on the fly.
+ *
+ * By default, each distinct identifier used by the expression is given a
+ * slot of its own, in order of first appearance; the assignment can be
+ * queried with getNumSlots(), getSlotId() and getSlotIndex().
+ * Alternatively, a list of slot identifiers may be passed to compile(), so
+ * that a single value array can be shared by many compiled expressions;
+ * identifiers missing from that list evaluate to NaN, just as identifiers
+ * missing from the value map of SBMLTransforms::evaluateASTNode() do.
+ *
+ * A CompiledMath object keeps a small scratch area for its evaluation
+ * stack, so one object must not be evaluated by several threads at the
+ * same time; copies of it may.
+ *
+ * @see NativeMath
+ */
+
+#ifndef CompiledMath_h
+#define CompiledMath_h
+
+
+#include <sbml/common/extern.h>
+#include <sbml/common/operationReturnValues.h>
+#include <sbml/util/IdList.h>
+
+
+#ifdef __cplusplus
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class ASTNode;
+class Model;
+class FunctionDefinition;
+
+class LIBSBML_EXTERN CompiledMath
+{
+public:
+
+  /**
+   * Creates a new, empty CompiledMath object.  Evaluating it yields NaN.
+   */
+  CompiledMath ();
+
+
+  /**
+   * Copy constructor; creates a copy of this CompiledMath object.
+   *
+   * @param orig the object to copy.
+   */
+  CompiledMath (const CompiledMath& orig);
+
+
+  /**
+   * Assignment operator for CompiledMath.
+   *
+   * @param rhs the object whose values are used as the basis of the
+   * assignment.
+   */
+  CompiledMath& operator= (const CompiledMath& rhs);
+
+
+  /**
+   * Destroys this CompiledMath object.
+   */
+  virtual ~CompiledMath ();
+
+
+  /**
+   * Compiles the given expression, giving each identifier it uses a slot
+   * of its own.
+   *
+   * @param math the expression to compile.
+   * @param m the Model whose function definitions are to be inlined, or
+   * @c NULL.  Calls to functions not defined in @p m evaluate to NaN.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_OPERATION_FAILED, OperationReturnValues_t}
+   *
+   * The compilation fails if @p math is @c NULL, uses a construct
+   * provided by a package, or calls function definitions recursively; the
+   * expression must then be evaluated with
+   * SBMLTransforms::evaluateASTNode().
+   */
+  virtual int compile (const ASTNode* math, const Model* m = NULL);
+
+
+  /**
+   * Compiles the given expression for the given slots.
+   *
+   * @param math the expression to compile.
+   * @param slotIds the identifiers whose values are passed to evaluate(),
+   * in order.  Identifiers used by @p math but missing from this list
+   * evaluate to NaN.
+   * @param m the Model whose function definitions are to be inlined, or
+   * @c NULL.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  virtual int compile (const ASTNode* math, const IdList& slotIds,
+                       const Model* m = NULL);
+
+
+  /**
+   * Predicate returning @c true if this object holds a compiled
+   * expression.
+   *
+   * @return @c true if compile() succeeded, @c false otherwise.
+   */
+  virtual bool isCompiled () const;
+
+
+  /**
+   * @return the number of values evaluate() reads.
+   */
+  unsigned int getNumSlots () const;
+
+
+  /**
+   * @param n the index of the slot.
+   *
+   * @return the identifier whose value is read from slot @p n, or an
+   * empty string if @p n is out of range.
+   */
+  std::string getSlotId (unsigned int n) const;
+
+
+  /**
+   * @param id the identifier to look for.
+   *
+   * @return the index of the slot holding the value of @p id, or @c -1 if
+   * there is no such slot.
+   */
+  int getSlotIndex (const std::string& id) const;
+
+
+  /**
+   * Evaluates the compiled expression.
+   *
+   * @param values an array of getNumSlots() values, the n-th of which is
+   * the value of the identifier getSlotId(n).  May be @c NULL if there
+   * are no slots.
+   *
+   * @return the value of the expression, or NaN if nothing has been
+   * compiled.
+   */
+  virtual double evaluate (const double* values) const;
+
+
+protected:
+  /** @cond doxygenLibsbmlInternal */
+
+  /*
+   * The program runs on a stack of doubles.  The locals holding the
+   * arguments of inlined function definitions come first in the scratch
+   * area, followed by the stack itself.
+   */
+  enum Operation
+  {
+      OpConstant      /* push value                                       */
+    , OpLoad          /* push values[arg]                                 */
+    , OpLoadLocal     /* push local arg                                   */
+    , OpStoreLocal    /* pop into local arg                               */
+    , OpAdd
+    , OpSubtract
+    , OpMultiply
+    , OpDivide
+    , OpPower
+    , OpRoot          /* pop x, pop n, push pow(x, 1/n)                   */
+    , OpNegate
+    , OpFunction      /* apply function to the top of the stack          */
+    , OpAnd
+    , OpOr
+    , OpXor
+    , OpEq            /* pop arg values, push 1 if the relation holds    */
+    , OpGeq           /* for each pair of neighbours, 0 otherwise        */
+    , OpGt
+    , OpLeq
+    , OpLt
+    , OpNeq
+    , OpPiecewise     /* pop arg values, push the result of the          */
+                      /* piecewise                                       */
+  };
+
+
+  /* A single step of the program. */
+  struct Instruction
+  {
+    int          op;
+    unsigned int arg;
+    double       value;
+    double     (*function)(double);
+  };
+
+
+  /* Binding of an argument of a function definition being inlined. */
+  struct Binding
+  {
+    std::string  name;
+    unsigned int local;
+  };
+
+
+  void clear ();
+
+  bool compileNode (const ASTNode* node);
+
+  bool compileChild (const ASTNode* node, unsigned int n);
+
+  bool compileName (const ASTNode* node);
+
+  bool compileFunction (const ASTNode* node);
+
+  void emit (int op, unsigned int arg = 0, double value = 0.0,
+             double (*function)(double) = NULL);
+
+  void push (unsigned int count = 1);
+
+  void pop (unsigned int count = 1);
+
+  /*
+   * The functions OpFunction applies, in a fixed order which identifies
+   * them also across processes.  New functions are appended.
+   */
+  static const std::vector<double (*)(double)>& getFunctions ();
+
+
+  std::vector<Instruction>                mProgram;
+  std::vector<std::string>                mSlotIds;
+  std::map<std::string, unsigned int>     mSlotIndex;
+  bool                                    mFixedSlots;
+  unsigned int                            mNumLocals;
+  unsigned int                            mDepth;
+  unsigned int                            mMaxDepth;
+  mutable std::vector<double>             mScratch;
+
+  /* state used while compiling */
+  const Model*                            mModel;
+  std::vector<Binding>                    mBindings;
+  size_t                                  mFrame;
+  std::vector<const FunctionDefinition*>  mInlining;
+
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* CompiledMath_h */
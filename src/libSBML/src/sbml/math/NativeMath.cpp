@@ -0,0 +1,792 @@
+/**
+ * @file    NativeMath.cpp
+ * @brief   Machine code evaluating an ASTNode over a value array.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef USE_NATIVEJIT
+#include <exception>
+
+#include <NativeJIT/CodeCache.h>
+#include <NativeJIT/CodeGen/ExecutionBuffer.h>
+#include <NativeJIT/CodeGen/FunctionBuffer.h>
+#include <NativeJIT/Function.h>
+#endif
+
+#include <sbml/common/libsbml-version.h>
+#include <sbml/math/NativeMath.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/SBMLTransforms.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygenLibsbmlInternal */
+
+#ifdef USE_NATIVEJIT
+
+typedef NativeJIT::Node<double>               Value;
+typedef NativeJIT::Function<double, double*>  Expression;
+
+typedef double (*UnaryFunction)  (double);
+typedef double (*BinaryFunction) (double, double);
+
+
+/*
+ * Size of the code buffer tried first, and the largest one tried before
+ * giving up.  The expression tree gets a buffer TreeSizeFactor times as
+ * large.
+ */
+static const unsigned int InitialCodeSize = 4 * 1024;
+static const unsigned int MaxCodeSize     = 1024 * 1024;
+static const unsigned int TreeSizeFactor  = 4;
+
+
+/*
+ * The operations without an x64 instruction are called.
+ */
+static double nativePower  (double x, double y) { return pow(x, y); }
+static double nativeRoot   (double n, double x) { return pow(x, (1.0 / n)); }
+
+
+/*
+ * Identifies the translation, so that code cached by builds translating
+ * differently is not used.  CMake sets it to a hash of NativeMath.cpp and
+ * NativeMath.h.  NativeJIT adds the build of its code generator to the key.
+ */
+#ifndef NATIVEMATH_TRANSLATION_ID
+#define NATIVEMATH_TRANSLATION_ID LIBSBML_DOTTED_VERSION " " __DATE__ " " __TIME__
+#endif
+
+
+/*
+ * Returns then if comparing left with right sets the flags tested by JCC,
+ * otherwise otherwise.  comisd reports unordered operands as both below and
+ * equal, so that only JA and JAE are false if either operand is NaN, as
+ * the C++ relational operators are.
+ */
+template <NativeJIT::JccType JCC>
+static Value&
+select (Expression& e, Value& left, Value& right, Value& then,
+        Value& otherwise)
+{
+  return e.Conditional(e.Compare<JCC>(left, right), then, otherwise);
+}
+
+
+/*
+ * Returns then if left == right, otherwise otherwise.
+ */
+static Value&
+selectEqual (Expression& e, Value& left, Value& right, Value& then,
+             Value& otherwise)
+{
+  return select<NativeJIT::JccType::JAE>(e, left, right,
+           select<NativeJIT::JccType::JAE>(e, right, left, then, otherwise),
+           otherwise);
+}
+
+
+/*
+ * The program of a CompiledMath is first run symbolically, turning it
+ * into a graph of Terms in which locals and repeated loads of a slot are
+ * shared.  NativeJIT insists on every node it is given being used, so its
+ * nodes are only created afterwards, for the Terms the result depends on.
+ */
+struct Term
+{
+  int                  op;
+  unsigned int         arg;
+  double               value;
+  UnaryFunction        function;
+  vector<size_t>       args;
+};
+
+
+struct NativeMath::NativeCode
+{
+  NativeCode (unsigned int capacity)
+    : mBuffer(capacity)
+    , mCode(mBuffer, capacity)
+  {
+  }
+
+  NativeFunction generate (const vector<Instruction>& program,
+                           unsigned int numSlots, unsigned int numLocals,
+                           unsigned int treeSize);
+
+  NativeFunction load (const string& key);
+
+  void store (const string& key);
+
+  /* the addresses the generated code calls, in a fixed order */
+  static const vector<const void*>& getSymbols ();
+
+  Value& emit (Expression& e, size_t term);
+
+  NativeJIT::ExecutionBuffer  mBuffer;
+  NativeJIT::FunctionBuffer   mCode;
+
+  /* state used while generating code */
+  vector<Term>                mTerms;
+  vector<Value*>              mValues;
+};
+
+
+NativeMath::NativeFunction
+NativeMath::NativeCode::generate (const vector<Instruction>& program,
+                                  unsigned int numSlots,
+                                  unsigned int numLocals,
+                                  unsigned int treeSize)
+{
+  vector<size_t> stack;
+  vector<size_t> locals(numLocals, 0);
+  vector<size_t> slots(numSlots, program.size());
+
+  mTerms.clear();
+  mTerms.reserve(program.size());
+
+  for (size_t n = 0; n < program.size(); ++n)
+  {
+    const Instruction& instruction = program[n];
+    unsigned int numArgs = 0;
+
+    switch (instruction.op)
+    {
+    case OpLoadLocal:
+      stack.push_back(locals[instruction.arg]);
+      continue;
+
+    case OpStoreLocal:
+      locals[instruction.arg] = stack.back();
+      stack.pop_back();
+      continue;
+
+    case OpLoad:
+      if (slots[instruction.arg] != program.size())
+      {
+        stack.push_back(slots[instruction.arg]);
+        continue;
+      }
+      slots[instruction.arg] = mTerms.size();
+      break;
+
+    case OpConstant:
+      break;
+
+    case OpNegate:
+    case OpFunction:
+      numArgs = 1;
+      break;
+
+    case OpEq:
+    case OpGeq:
+    case OpGt:
+    case OpLeq:
+    case OpLt:
+    case OpNeq:
+    case OpPiecewise:
+      numArgs = instruction.arg;
+      break;
+
+    default:
+      numArgs = 2;
+      break;
+    }
+
+    Term term;
+    term.op       = instruction.op;
+    term.arg      = instruction.arg;
+    term.value    = instruction.value;
+    term.function = instruction.function;
+    term.args.assign(stack.end() - numArgs, stack.end());
+
+    stack.resize(stack.size() - numArgs);
+    stack.push_back(mTerms.size());
+    mTerms.push_back(term);
+  }
+
+  NativeJIT::Allocator allocator(treeSize);
+  Expression e(allocator, mCode);
+
+  /*
+   * kinetic laws repeat subterms such as k1 * S1 or constant products,
+   * which are then computed only once
+   */
+  e.EnableCommonSubexpressionElimination();
+
+  mValues.assign(mTerms.size(), NULL);
+  Value& result = emit(e, stack.back());
+
+  NativeFunction function = e.Compile(result);
+
+  mTerms.clear();
+  mValues.clear();
+
+  return function;
+}
+
+
+NativeMath::NativeFunction
+NativeMath::NativeCode::load (const string& key)
+{
+  NativeJIT::CodeCache cache(getCodeCacheDirectory(), getSymbols());
+
+  return reinterpret_cast<NativeFunction>(
+           const_cast<void*>(cache.Load(key, mCode)));
+}
+
+
+void
+NativeMath::NativeCode::store (const string& key)
+{
+  NativeJIT::CodeCache cache(getCodeCacheDirectory(), getSymbols());
+
+  /* failing to store only costs the next process the translation */
+  cache.Store(key, mCode);
+}
+
+
+static vector<const void*>
+collectSymbols (const vector<UnaryFunction>& functions)
+{
+  vector<const void*> symbols;
+  symbols.push_back(reinterpret_cast<const void*>(nativePower));
+  symbols.push_back(reinterpret_cast<const void*>(nativeRoot));
+
+  for (size_t n = 0; n < functions.size(); ++n)
+  {
+    symbols.push_back(reinterpret_cast<const void*>(functions[n]));
+  }
+
+  return symbols;
+}
+
+
+const vector<const void*>&
+NativeMath::NativeCode::getSymbols ()
+{
+  static const vector<const void*> symbols = collectSymbols(getFunctions());
+
+  return symbols;
+}
+
+
+Value&
+NativeMath::NativeCode::emit (Expression& e, size_t index)
+{
+  if (mValues[index] != NULL)
+  {
+    return *mValues[index];
+  }
+
+  const Term& term = mTerms[index];
+  vector<Value*> args(term.args.size(), NULL);
+
+  for (size_t n = 0; n < term.args.size(); ++n)
+  {
+    args[n] = &emit(e, term.args[n]);
+  }
+
+  Value* value = NULL;
+
+  switch (term.op)
+  {
+  case OpConstant:
+    value = &e.Immediate(term.value);
+    break;
+
+  case OpLoad:
+    value = &e.Deref(e.GetP1(), static_cast<int32_t>(term.arg));
+    break;
+
+  case OpAdd:
+    value = &e.Add(*args[0], *args[1]);
+    break;
+
+  case OpSubtract:
+    value = &e.Sub(*args[0], *args[1]);
+    break;
+
+  case OpMultiply:
+    value = &e.Mul(*args[0], *args[1]);
+    break;
+
+  case OpNegate:
+    /* unlike 0 - x, this gets the sign of zero right */
+    value = &e.Mul(*args[0], e.Immediate(-1.0));
+    break;
+
+  case OpDivide:
+    value = &e.Div(*args[0], *args[1]);
+    break;
+
+  case OpPower:
+    value = &e.Call(e.Relocatable<BinaryFunction>(nativePower),
+                    *args[0], *args[1]);
+    break;
+
+  case OpRoot:
+    value = &e.Call(e.Relocatable<BinaryFunction>(nativeRoot),
+                    *args[0], *args[1]);
+    break;
+
+  case OpFunction:
+    /* called through relocated addresses so that the code can be cached */
+    value = &e.Call(e.Relocatable<UnaryFunction>(term.function), *args[0]);
+    break;
+
+  case OpAnd:
+    value = &selectEqual(e, *args[0], e.Immediate(0.0), e.Immediate(0.0),
+               selectEqual(e, *args[1], e.Immediate(0.0), e.Immediate(0.0),
+                           e.Immediate(1.0)));
+    break;
+
+  case OpOr:
+    value = &selectEqual(e, *args[0], e.Immediate(0.0),
+               selectEqual(e, *args[1], e.Immediate(0.0), e.Immediate(0.0),
+                           e.Immediate(1.0)),
+               e.Immediate(1.0));
+    break;
+
+  case OpXor:
+    value = &selectEqual(e, *args[0], e.Immediate(0.0),
+               selectEqual(e, *args[1], e.Immediate(0.0), e.Immediate(0.0),
+                           e.Immediate(1.0)),
+               selectEqual(e, *args[1], e.Immediate(0.0), e.Immediate(1.0),
+                           e.Immediate(0.0)));
+    break;
+
+  case OpEq:
+  case OpGeq:
+  case OpGt:
+  case OpLeq:
+  case OpLt:
+  case OpNeq:
+    /* the relation has to hold for each pair of neighbours */
+    value = &e.Immediate(1.0);
+    for (size_t n = args.size() - 1; n > 0; --n)
+    {
+      Value& a = *args[n - 1];
+      Value& b = *args[n];
+      Value& zero = e.Immediate(0.0);
+
+      switch (term.op)
+      {
+      case OpEq:
+        value = &selectEqual(e, a, b, *value, zero);
+        break;
+      case OpNeq:
+        value = &selectEqual(e, a, b, zero, *value);
+        break;
+      case OpGeq:
+        value = &select<NativeJIT::JccType::JAE>(e, a, b, *value, zero);
+        break;
+      case OpGt:
+        value = &select<NativeJIT::JccType::JA>(e, a, b, *value, zero);
+        break;
+      case OpLeq:
+        value = &select<NativeJIT::JccType::JAE>(e, b, a, *value, zero);
+        break;
+      default:
+        value = &select<NativeJIT::JccType::JA>(e, b, a, *value, zero);
+        break;
+      }
+    }
+    break;
+
+  case OpPiecewise:
+  {
+    if (args.empty())
+    {
+      value = &e.Immediate(numeric_limits<double>::quiet_NaN());
+      break;
+    }
+
+    /* the value of the first piece whose condition is 1 */
+    size_t numPieces = args.size() / 2;
+    Value* first = (args.size() % 2 == 0)
+                 ? &e.Immediate(numeric_limits<double>::quiet_NaN())
+                 : args.back();
+
+    for (size_t n = numPieces; n > 0; --n)
+    {
+      first = &selectEqual(e, *args[2 * n - 1], e.Immediate(1.0),
+                           *args[2 * n - 2], *first);
+    }
+
+    /* NaN if any other piece whose condition is 1 has a different value */
+    value = first;
+    for (size_t n = 0; numPieces > 1 && n < numPieces; ++n)
+    {
+      value = &selectEqual(e, *args[2 * n + 1], e.Immediate(1.0),
+                selectEqual(e, *args[2 * n], *first, *value,
+                            e.Immediate(numeric_limits<double>::quiet_NaN())),
+                *value);
+    }
+    break;
+  }
+  }
+
+  mValues[index] = value;
+  return *value;
+}
+
+#else
+
+struct NativeMath::NativeCode
+{
+};
+
+#endif  /* USE_NATIVEJIT */
+
+/** @endcond */
+
+
+NativeMath::NativeMath ()
+  : CompiledMath()
+  , mNative(NULL)
+  , mFunction(NULL)
+  , mInterpreted(NULL)
+  , mInterpretedModel(NULL)
+{
+}
+
+
+NativeMath::NativeMath (const NativeMath& orig)
+  : CompiledMath(orig)
+  , mNative(NULL)
+  , mFunction(NULL)
+  , mInterpreted(NULL)
+  , mInterpretedModel(orig.mInterpretedModel)
+{
+  if (orig.mInterpreted != NULL)
+  {
+    mInterpreted = orig.mInterpreted->deepCopy();
+  }
+  else if (orig.mNative != NULL)
+  {
+    generateCode();
+  }
+}
+
+
+NativeMath&
+NativeMath::operator= (const NativeMath& rhs)
+{
+  if (&rhs != this)
+  {
+    clearNative();
+    CompiledMath::operator=(rhs);
+
+    mInterpretedModel = rhs.mInterpretedModel;
+    if (rhs.mInterpreted != NULL)
+    {
+      mInterpreted = rhs.mInterpreted->deepCopy();
+    }
+    else if (rhs.mNative != NULL)
+    {
+      generateCode();
+    }
+  }
+  return *this;
+}
+
+
+NativeMath::~NativeMath ()
+{
+  clearNative();
+}
+
+
+int
+NativeMath::compile (const ASTNode* math, const Model* m)
+{
+  clearNative();
+
+  int result = CompiledMath::compile(math, m);
+  if (result == LIBSBML_OPERATION_SUCCESS)
+  {
+    generateCode();
+  }
+  else if (math != NULL)
+  {
+    collectSlots(math);
+    mInterpreted      = math->deepCopy();
+    mInterpretedModel = m;
+    result            = LIBSBML_OPERATION_SUCCESS;
+  }
+
+  return result;
+}
+
+
+int
+NativeMath::compile (const ASTNode* math, const IdList& slotIds,
+                     const Model* m)
+{
+  clearNative();
+
+  int result = CompiledMath::compile(math, slotIds, m);
+  if (result == LIBSBML_OPERATION_SUCCESS)
+  {
+    generateCode();
+  }
+  else if (math != NULL)
+  {
+    for (vector<string>::const_iterator it = slotIds.begin();
+         it != slotIds.end(); ++it)
+    {
+      mSlotIndex.insert(make_pair(*it, (unsigned int)mSlotIds.size()));
+      mSlotIds.push_back(*it);
+    }
+    mFixedSlots       = true;
+    mInterpreted      = math->deepCopy();
+    mInterpretedModel = m;
+    result            = LIBSBML_OPERATION_SUCCESS;
+  }
+
+  return result;
+}
+
+
+bool
+NativeMath::isCompiled () const
+{
+  return mInterpreted != NULL || CompiledMath::isCompiled();
+}
+
+
+bool
+NativeMath::isNative () const
+{
+  return mFunction != NULL;
+}
+
+
+double
+NativeMath::evaluate (const double* values) const
+{
+  if (mFunction != NULL)
+  {
+    /* the generated code only ever reads the values */
+    return mFunction(const_cast<double*>(values));
+  }
+
+  if (mInterpreted != NULL)
+  {
+    map<string, double> named;
+    for (size_t n = 0; n < mSlotIds.size(); ++n)
+    {
+      named[mSlotIds[n]] = values[n];
+    }
+    return SBMLTransforms::evaluateASTNode(mInterpreted, named,
+                                           mInterpretedModel);
+  }
+
+  return CompiledMath::evaluate(values);
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+
+void
+NativeMath::clearNative ()
+{
+  delete mNative;
+  mNative   = NULL;
+  mFunction = NULL;
+
+  delete mInterpreted;
+  mInterpreted      = NULL;
+  mInterpretedModel = NULL;
+}
+
+
+/*
+ * Translates the program of the CompiledMath into machine code, retrying
+ * with larger buffers if the expression does not fit.  Any failure of the
+ * code generator leaves the program to the interpreter.  With a code
+ * cache, code translated before is loaded instead.
+ */
+bool
+NativeMath::generateCode ()
+{
+#ifdef USE_NATIVEJIT
+  if (mProgram.empty())
+  {
+    return false;
+  }
+
+  string key;
+  bool cached = !getCodeCacheDirectory().empty() && getCacheKey(key);
+
+  for (unsigned int size = InitialCodeSize; size <= MaxCodeSize; size *= 4)
+  {
+    NativeCode* native = NULL;
+    try
+    {
+      native    = new NativeCode(size);
+      mFunction = cached ? native->load(key) : NULL;
+      if (mFunction == NULL)
+      {
+        mFunction = native->generate(mProgram, getNumSlots(), mNumLocals,
+                                     TreeSizeFactor * size);
+        if (cached)
+        {
+          native->store(key);
+        }
+      }
+      mNative   = native;
+      return true;
+    }
+    catch (std::exception&)
+    {
+      delete native;
+      mFunction = NULL;
+    }
+  }
+#endif
+
+  return false;
+}
+
+
+/*
+ * Describes the program completely, with the functions it calls given by
+ * their position in getFunctions(), so that equal keys yield the same
+ * machine code in any process.  Returns false if a function is unknown.
+ */
+bool
+NativeMath::getCacheKey (string& key) const
+{
+#ifdef USE_NATIVEJIT
+  unsigned int header[] = { getNumSlots(), mNumLocals };
+
+  key.assign("NativeMath ");
+  key.append(NATIVEMATH_TRANSLATION_ID);
+  key.push_back('\0');
+  key.append(reinterpret_cast<const char*>(header), sizeof(header));
+
+  const vector<double (*)(double)>& functions = getFunctions();
+
+  for (size_t n = 0; n < mProgram.size(); ++n)
+  {
+    const Instruction& instruction = mProgram[n];
+
+    int function = -1;
+    if (instruction.function != NULL)
+    {
+      for (size_t i = 0; i < functions.size() && function < 0; ++i)
+      {
+        if (functions[i] == instruction.function)
+        {
+          function = (int)i;
+        }
+      }
+      if (function < 0)
+      {
+        return false;
+      }
+    }
+
+    /* the instruction is copied field by field to skip its padding */
+    char bytes[2 * sizeof(int) + sizeof(unsigned int) + sizeof(double)];
+    char* p = bytes;
+    memcpy(p, &instruction.op, sizeof(int));             p += sizeof(int);
+    memcpy(p, &instruction.arg, sizeof(unsigned int));   p += sizeof(unsigned int);
+    memcpy(p, &instruction.value, sizeof(double));       p += sizeof(double);
+    memcpy(p, &function, sizeof(int));
+    key.append(bytes, sizeof(bytes));
+  }
+
+  return true;
+#else
+  (void)key;
+  return false;
+#endif
+}
+
+
+static string&
+codeCacheDirectory ()
+{
+  static const char* env       = getenv("LIBSBML_NATIVE_CODE_CACHE");
+  static string      directory = (env != NULL) ? env : "";
+
+  return directory;
+}
+
+/** @endcond */
+
+
+void
+NativeMath::setCodeCacheDirectory (const string& directory)
+{
+  codeCacheDirectory() = directory;
+}
+
+
+string
+NativeMath::getCodeCacheDirectory ()
+{
+  return codeCacheDirectory();
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * Gives each identifier used outside of lambda expressions a slot, in
+ * order of first appearance, like CompiledMath::compile() does.
+ */
+void
+NativeMath::collectSlots (const ASTNode* node)
+{
+  if (node->getType() == AST_LAMBDA)
+  {
+    return;
+  }
+
+  if (node->getType() == AST_NAME && node->getName() != NULL
+    && mSlotIndex.find(node->getName()) == mSlotIndex.end())
+  {
+    mSlotIndex.insert(make_pair(string(node->getName()),
+                                (unsigned int)mSlotIds.size()));
+    mSlotIds.push_back(node->getName());
+  }
+
+  for (unsigned int n = 0; n < node->getNumChildren(); ++n)
+  {
+    collectSlots(node->getChild(n));
+  }
+}
+
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_END
@@ -0,0 +1,229 @@
+/**
+ * @file    NativeMath.h
+ * @brief   Machine code evaluating an ASTNode over a value array.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class NativeMath
+ * @sbmlbrief{core} A mathematical expression compiled to machine code.
+ *
+ * @htmlinclude libsbml-facility-only-warning.html
+ *
+ * NativeMath is a CompiledMath whose program is in turn translated into
+ * x64 machine code with NativeJIT.  Arithmetic, relational and logical
+ * operators as well as piecewise functions become inline instructions;
+ * the remaining functions, such as exp(), ln() or power(), are called
+ * through their C library implementation.  Evaluating the expression then
+ * is a single call of a native function over the array of slot values,
+ * which is what the inner loop of an ODE integrator wants for its rate
+ * laws.  The results are identical to those of CompiledMath::evaluate().
+ *
+ * Whatever cannot be translated falls back to the interpreter:
+ *
+ * @li when libSBML was built without NativeJIT (see isNative()), or the
+ * code generator gives up on an expression, the program of the
+ * CompiledMath is run instead;
+ * @li expressions CompiledMath cannot compile at all, namely those using
+ * constructs provided by packages, are evaluated with
+ * SBMLTransforms::evaluateASTNode(), using the slot values as the values
+ * of the identifiers.  In this case the Model passed to compile() must
+ * outlive the NativeMath object.
+ *
+ * Unlike a CompiledMath object, a NativeMath object running machine code
+ * may be evaluated by several threads at the same time.
+ *
+ * The machine code can be cached on disk (see setCodeCacheDirectory()),
+ * so that expressions compiled before, also by earlier processes, are
+ * loaded instead of being translated again.
+ */
+
+#ifndef NativeMath_h
+#define NativeMath_h
+
+
+#include <sbml/common/extern.h>
+#include <sbml/math/CompiledMath.h>
+
+
+#ifdef __cplusplus
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBSBML_EXTERN NativeMath : public CompiledMath
+{
+public:
+
+  /**
+   * Creates a new, empty NativeMath object.  Evaluating it yields NaN.
+   */
+  NativeMath ();
+
+
+  /**
+   * Copy constructor; creates a copy of this NativeMath object.
+   *
+   * @param orig the object to copy.
+   */
+  NativeMath (const NativeMath& orig);
+
+
+  /**
+   * Assignment operator for NativeMath.
+   *
+   * @param rhs the object whose values are used as the basis of the
+   * assignment.
+   */
+  NativeMath& operator= (const NativeMath& rhs);
+
+
+  /**
+   * Destroys this NativeMath object, releasing its machine code.
+   */
+  virtual ~NativeMath ();
+
+
+  /**
+   * Compiles the given expression, giving each identifier it uses a slot
+   * of its own.
+   *
+   * @param math the expression to compile.
+   * @param m the Model whose function definitions are to be inlined, or
+   * @c NULL.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   *
+   * Unlike CompiledMath::compile(), this only fails if @p math is
+   * @c NULL.
+   */
+  virtual int compile (const ASTNode* math, const Model* m = NULL);
+
+
+  /**
+   * Compiles the given expression for the given slots.
+   *
+   * @param math the expression to compile.
+   * @param slotIds the identifiers whose values are passed to evaluate(),
+   * in order.  Identifiers used by @p math but missing from this list
+   * evaluate to NaN.
+   * @param m the Model whose function definitions are to be inlined, or
+   * @c NULL.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  virtual int compile (const ASTNode* math, const IdList& slotIds,
+                       const Model* m = NULL);
+
+
+  /**
+   * Predicate returning @c true if this object holds a compiled
+   * expression.
+   *
+   * @return @c true if compile() succeeded, @c false otherwise.
+   */
+  virtual bool isCompiled () const;
+
+
+  /**
+   * Predicate returning @c true if the compiled expression is evaluated
+   * by machine code, rather than by one of the interpreters.
+   *
+   * @return @c true if native code was generated for the expression,
+   * @c false otherwise.  This is always @c false if libSBML was built
+   * without NativeJIT.
+   */
+  bool isNative () const;
+
+
+  /**
+   * Evaluates the compiled expression.
+   *
+   * @param values an array of getNumSlots() values, the n-th of which is
+   * the value of the identifier getSlotId(n).  May be @c NULL if there
+   * are no slots.
+   *
+   * @return the value of the expression, or NaN if nothing has been
+   * compiled.
+   */
+  virtual double evaluate (const double* values) const;
+
+
+  /**
+   * Sets the directory in which the machine code of compiled expressions
+   * is cached.  An expression whose code is found there is loaded instead
+   * of being translated, and the code of expressions that are translated
+   * is stored there for later use.
+   *
+   * The initial directory is taken from the environment variable
+   * @c LIBSBML_NATIVE_CODE_CACHE.  The setting applies to all NativeMath
+   * objects, and should not be changed while other threads compile
+   * expressions.
+   *
+   * The cached code is executed, so on POSIX systems the directory and
+   * its files are only used if they belong to the user and cannot be
+   * written by others; create it with mode 0700.
+   *
+   * @param directory an existing directory, or the empty string to
+   * disable the cache.
+   */
+  static void setCodeCacheDirectory (const std::string& directory);
+
+
+  /**
+   * Returns the directory in which the machine code of compiled
+   * expressions is cached.
+   *
+   * @return the directory, or the empty string if the cache is disabled.
+   */
+  static std::string getCodeCacheDirectory ();
+
+
+protected:
+  /** @cond doxygenLibsbmlInternal */
+
+  /* The buffers holding the machine code; see NativeMath.cpp. */
+  struct NativeCode;
+
+  typedef double (*NativeFunction)(double*);
+
+
+  void clearNative ();
+
+  bool generateCode ();
+
+  bool getCacheKey (std::string& key) const;
+
+  void collectSlots (const ASTNode* node);
+
+
+  NativeCode*     mNative;
+  NativeFunction  mFunction;
+
+  /* expression left to SBMLTransforms::evaluateASTNode() */
+  ASTNode*        mInterpreted;
+  const Model*    mInterpretedModel;
+
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* NativeMath_h */
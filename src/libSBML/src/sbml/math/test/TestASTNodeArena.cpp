@@ -0,0 +1,181 @@
+/**
+ * \file    TestASTNodeArena.cpp
+ * \brief   Test the allocation of ASTNode objects from an ASTNodeArena
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <string>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/math/ASTNodeArena.h>
+#include <sbml/math/L3Parser.h>
+#include <sbml/math/MathML.h>
+#include <sbml/SBMLTypes.h>
+
+#include <check.h>
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+/** @endcond */
+
+CK_CPPSTART
+
+
+static const char* ArenaModel =
+  "<?xml version='1.0' encoding='UTF-8'?>"
+  "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core'"
+  "      level='3' version='1'>"
+  "  <model>"
+  "    <listOfParameters>"
+  "      <parameter id='k' value='2' constant='false'/>"
+  "      <parameter id='x' value='1' constant='false'/>"
+  "    </listOfParameters>"
+  "    <listOfRules>"
+  "      <assignmentRule variable='x'>"
+  "        <math xmlns='http://www.w3.org/1998/Math/MathML'>"
+  "          <apply> <times/> <ci> k </ci>"
+  "            <apply> <sin/> <csymbol encoding='text'"
+  "              definitionURL='http://www.sbml.org/sbml/symbols/time'>"
+  "              t </csymbol> </apply>"
+  "          </apply>"
+  "        </math>"
+  "      </assignmentRule>"
+  "    </listOfRules>"
+  "  </model>"
+  "</sbml>";
+
+
+START_TEST (test_ASTNodeArena_scope)
+{
+  ASTNodeArena* arena = new ASTNodeArena();
+
+  fail_unless( ASTNodeArena::getCurrent() == NULL );
+  fail_unless( arena->getCapacity() == 0 );
+
+  ASTNode* n;
+  {
+    ASTNodeArena::Scope scope(arena);
+    fail_unless( ASTNodeArena::getCurrent() == arena );
+
+    n = new ASTNode(AST_PLUS);
+    n->addChild(new ASTNode(AST_NAME));
+    n->addChild(new(std::nothrow) ASTNode(AST_INTEGER));
+
+    {
+      ASTNodeArena::Scope heap(NULL);
+      fail_unless( ASTNodeArena::getCurrent() == NULL );
+    }
+
+    fail_unless( ASTNodeArena::getCurrent() == arena );
+  }
+
+  fail_unless( ASTNodeArena::getCurrent() == NULL );
+  fail_unless( arena->getCapacity() > 0 );
+
+  /* the nodes keep the arena alive after its owner has released it */
+  arena->release();
+
+  n->getChild(0)->setName("a");
+  n->getChild(1)->setValue(3);
+
+  ASTNode* copy = n->deepCopy();
+  delete n;
+
+  char* formula = SBML_formulaToL3String(copy);
+  fail_unless( !strcmp(formula, "a + 3") );
+  safe_free(formula);
+
+  delete copy;
+}
+END_TEST
+
+
+START_TEST (test_ASTNodeArena_parseL3Formula)
+{
+  ASTNodeArena* arena = new ASTNodeArena();
+  ASTNode* n;
+  {
+    ASTNodeArena::Scope scope(arena);
+    n = SBML_parseL3Formula("piecewise(a * sin(b), a > 2, -c^2)");
+  }
+
+  fail_unless( n != NULL );
+  fail_unless( arena->getCapacity() > 0 );
+
+  char* formula = SBML_formulaToL3String(n);
+  fail_unless( !strcmp(formula, "piecewise(a * sin(b), a > 2, -c^2)") );
+  safe_free(formula);
+
+  delete n;
+  arena->release();
+}
+END_TEST
+
+
+START_TEST (test_ASTNodeArena_readSBML)
+{
+  SBMLReader reader;
+  fail_unless( reader.getUseMathArena() == false );
+
+  SBMLDocument* heap = reader.readSBMLFromString(ArenaModel);
+
+  reader.setUseMathArena(true);
+  fail_unless( reader.getUseMathArena() == true );
+
+  SBMLDocument* arena = reader.readSBMLFromString(ArenaModel);
+
+  fail_unless( arena->getNumErrors() == heap->getNumErrors() );
+
+  ASTNode* math = arena->getModel()->getRule(0)->getMath()->deepCopy();
+  fail_unless( math->exactlyEqual(*heap->getModel()->getRule(0)->getMath()) );
+  delete math;
+  fail_unless( writeSBMLToStdString(arena) == writeSBMLToStdString(heap) );
+
+  /* math removed from the document outlives it */
+  Rule* rule = arena->getModel()->removeRule(0);
+  delete arena;
+
+  char* formula = SBML_formulaToL3String(rule->getMath());
+  fail_unless( !strcmp(formula, "k * sin(time)") );
+  safe_free(formula);
+
+  delete rule;
+  delete heap;
+}
+END_TEST
+
+
+Suite *
+create_suite_TestASTNodeArena ()
+{
+  Suite *suite = suite_create("TestASTNodeArena");
+  TCase *tcase = tcase_create("TestASTNodeArena");
+
+  tcase_add_test( tcase, test_ASTNodeArena_scope           );
+  tcase_add_test( tcase, test_ASTNodeArena_parseL3Formula  );
+  tcase_add_test( tcase, test_ASTNodeArena_readSBML        );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+CK_CPPEND
@@ -2633,6 +2633,73 @@ START_TEST (test_ChildFunctions_insertIntoRoot_3)
 END_TEST
 
 
+START_TEST (test_ChildFunctions_manyChildren)
+{
+  N = new ASTNode(AST_PLUS);
+
+  /* grow past the children stored in the node itself */
+  for (int n = 0; n < 20; ++n)
+  {
+    ASTNode * c = new ASTNode(AST_INTEGER);
+    c->setValue(2 * n);
+    fail_unless( N->addChild(c) == LIBSBML_OPERATION_SUCCESS );
+  }
+
+  ASTNode * c = new ASTNode(AST_INTEGER);
+  c->setValue(5);
+  fail_unless( N->insertChild(3, c) == LIBSBML_OPERATION_SUCCESS );
+
+  c = new ASTNode(AST_INTEGER);
+  c->setValue(-1);
+  fail_unless( N->prependChild(c) == LIBSBML_OPERATION_SUCCESS );
+
+  fail_unless( N->removeChild(10) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( N->getNumChildren() == 21 );
+
+  fail_unless( N->getChild(0)->getInteger() == -1 );
+  fail_unless( N->getChild(1)->getInteger() ==  0 );
+  fail_unless( N->getChild(4)->getInteger() ==  5 );
+  fail_unless( N->getChild(5)->getInteger() ==  6 );
+  fail_unless( N->getChild(10)->getInteger() == 18 );
+  fail_unless( N->getRightChild()->getInteger() == 38 );
+  fail_unless( N->getChild(21) == NULL );
+
+  /* the rarely used attributes are copied along with the children */
+  N->getChild(2)->setUnits("mole");
+  N->setId("sum");
+  N->setStyle("bold");
+  N->addSemanticsAnnotation(new XMLNode(XMLTriple("annotation", "", ""), 
+                                        XMLAttributes()));
+
+  ASTNode * copy = N->deepCopy();
+
+  fail_unless( copy->getNumChildren() == 21 );
+  fail_unless( copy->getChild(10)->getInteger() == 18 );
+  fail_unless( copy->getChild(2)->getUnits() == "mole" );
+  fail_unless( copy->getChild(3)->isSetUnits() == false );
+  fail_unless( copy->getId() == "sum" );
+  fail_unless( copy->getStyle() == "bold" );
+  fail_unless( copy->isSetClass() == false );
+  fail_unless( copy->getNumSemanticsAnnotations() == 1 );
+  fail_unless( copy->getSemanticsAnnotation(0) != 
+               N->getSemanticsAnnotation(0) );
+  fail_unless( copy->getSemanticsAnnotation(1) == NULL );
+
+  ASTNode other(AST_TIMES);
+  fail_unless( other.swapChildren(copy) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( other.getNumChildren() == 21 );
+  fail_unless( copy->getNumChildren() == 0 );
+  fail_unless( copy->getLeftChild() == NULL );
+
+  N->unsetId();
+  fail_unless( N->isSetId() == false );
+  fail_unless( copy->getId() == "sum" );
+
+  delete copy;
+}
+END_TEST
+
+
 Suite *
 create_suite_TestChildFunctions ()
 {
@@ -2695,6 +2762,7 @@ create_suite_TestChildFunctions ()
   tcase_add_test( tcase, test_ChildFunctions_insertIntoRoot_1               );
   tcase_add_test( tcase, test_ChildFunctions_insertIntoRoot_2               );
   tcase_add_test( tcase, test_ChildFunctions_insertIntoRoot_3               );
+  tcase_add_test( tcase, test_ChildFunctions_manyChildren               );
 
   suite_add_tcase(suite, tcase);
 
@@ -88,6 +88,8 @@ Suite* create_suite_TestLevelNodeFunction(void);
 
 Suite* create_suite_TestRefactoringFunctions(void);
 
+Suite *create_suite_TestASTNodeArena      (void);
+
 
 /**
  * Global.
@@ -160,6 +162,7 @@ main (void)
 
   srunner_add_suite(runner, create_suite_TestLevelNodeFunction());
   srunner_add_suite(runner, create_suite_TestRefactoringFunctions());
+  srunner_add_suite(runner, create_suite_TestASTNodeArena());
   /* srunner_set_fork_status(runner, CK_NOFORK); */
 
   srunner_run_all(runner, CK_NORMAL);
@@ -38,6 +38,7 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <map>
 
 #include <sbml/common/libsbml-version.h>
 #include <sbml/packages/comp/common/compfwd.h>
@@ -1124,9 +1125,9 @@ void CompModelPlugin::findUniqueSubmodPrefixes(vector<string>& submodids, List*
 void CompModelPlugin::renameIDs(List* allElements, const string& prefix)
 {
   if (prefix=="") return; //Nothing to prepend.
-  vector<pair<string, string> > renamedSIds;
-  vector<pair<string, string> > renamedUnitSIds;
-  vector<pair<string, string> > renamedMetaIds;
+  map<string, string> renamedSIds;
+  map<string, string> renamedUnitSIds;
+  map<string, string> renamedMetaIds;
   
   // if a custom prefix transformer was specified, then set the 
   // current prefix
@@ -1154,7 +1155,7 @@ void CompModelPlugin::renameIDs(List* allElements, const string& prefix)
     if (id != newid) {
       int type = element->getTypeCode();
       if (type==SBML_UNIT_DEFINITION) {
-        renamedUnitSIds.push_back(make_pair(id, newid));
+        renamedUnitSIds.insert(make_pair(id, newid));
       }
       else if (type==SBML_COMP_PORT) {
         //Do nothing--these can only be referenced from outside the Model, so they need to be handled specially.
@@ -1163,31 +1164,31 @@ void CompModelPlugin::renameIDs(List* allElements, const string& prefix)
       else {
         //This is a little dangerous, but hey!  What's a little danger between friends!
         //(What we are assuming is that any attribute you can get with 'getId' is of the type 'SId')
-        renamedSIds.push_back(make_pair(id, newid));
+        renamedSIds.insert(make_pair(id, newid));
       }
     }
     if (metaid != newmetaid) {
-      renamedMetaIds.push_back(make_pair(metaid, newmetaid));
+      renamedMetaIds.insert(make_pair(metaid, newmetaid));
     }
   }
 
-  //for (unsigned long el=0; el<allElements->getSize(); el++) {
-  //  SBase* element = static_cast<SBase*>(allElements->get((unsigned int)el));
-  // Using ListIterator is faster
+  //Rename all references in a single pass over each element (instead of
+  //once per renamed identifier).  The prefix is unique, so no new id is
+  //also an old one and the order of the renaming does not matter.
   for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
   {
     SBase* element = static_cast<SBase*>(*iter);
-    for (size_t id=0; id<renamedSIds.size(); id++)
+    if (!renamedSIds.empty())
     {
-      element->renameSIdRefs(renamedSIds[id].first, renamedSIds[id].second);
+      element->renameSIdRefs(renamedSIds);
     }
-    for (size_t uid=0; uid<renamedUnitSIds.size(); uid++) 
+    if (!renamedUnitSIds.empty())
     {
-      element->renameUnitSIdRefs(renamedUnitSIds[uid].first, renamedUnitSIds[uid].second);
+      element->renameUnitSIdRefs(renamedUnitSIds);
     }
-    for (size_t mid=0; mid<renamedMetaIds.size(); mid++) 
+    if (!renamedMetaIds.empty())
     {
-      element->renameMetaIdRefs(renamedMetaIds[mid].first, renamedMetaIds[mid].second);
+      element->renameMetaIdRefs(renamedMetaIds);
     }
   }
 }
@@ -271,6 +271,26 @@ CompSBasePlugin::writeAttributes (XMLOutputStream& stream) const
 }
 /** @endcond */
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+CompSBasePlugin::renameSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+CompSBasePlugin::renameMetaIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+CompSBasePlugin::renameUnitSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+/** @endcond */
+
 const ListOfReplacedElements*
 CompSBasePlugin::getListOfReplacedElements () const
 {
@@ -226,6 +226,24 @@ public:
   /** @endcond */
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * The comp plugins hold no references themselves (their replacedElement
+   * and replacedBy children are renamed on their own), so these do nothing
+   * instead of looping over @p renamed.
+   */
+  using SBasePlugin::renameSIdRefs;
+  using SBasePlugin::renameMetaIdRefs;
+  using SBasePlugin::renameUnitSIdRefs;
+
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
 #endif //SWIG
  
 
@@ -34,6 +34,7 @@
 
 #include <sbml/common/common.h>
 
+#include <sbml/packages/comp/common/CompExtensionTypes.h>
 #include <sbml/packages/comp/extension/CompSBMLDocumentPlugin.h>
 #include <sbml/conversion/SBMLConverterRegistry.h>
 
@@ -118,6 +119,25 @@ START_TEST (test_comp_fail_whenflat)
 }
 END_TEST
 
+START_TEST (test_comp_internal_read_time)
+{
+  SBMLNamespaces sbmlns(3, 1, "comp", 1);
+  SBMLDocument doc(&sbmlns);
+  doc.setPackageRequired("comp", true);
+
+  Model* model = doc.createModel();
+  CompModelPlugin* mplugin = static_cast<CompModelPlugin*>(model->getPlugin("comp"));
+  Submodel* submodel = mplugin->createSubmodel();
+  submodel->setId("sub");
+
+  // the missing modelRef is only reported when the submodel is read
+  unsigned int nerrors = doc.checkInternalConsistency();
+
+  fail_unless (nerrors == 1);
+  fail_unless (doc.getError(0)->getErrorId() == CompSubmodelAllowedAttributes);
+}
+END_TEST
+
 Suite *
 create_suite_TestCheckConsistency(void)
 { 
@@ -128,6 +148,7 @@ create_suite_TestCheckConsistency(void)
   tcase_add_test(tcase, test_comp_fail_20212);
   tcase_add_test(tcase, test_comp_fail_90104);
   tcase_add_test(tcase, test_comp_fail_whenflat);
+  tcase_add_test(tcase, test_comp_internal_read_time);
 
   suite_add_tcase(suite, tcase);
 
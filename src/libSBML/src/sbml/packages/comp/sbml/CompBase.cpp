@@ -160,6 +160,39 @@ CompBase::getParentModel(SBase* child)
   return NULL;
 }
 
+/** @cond doxygenLibsbmlInternal */
+void
+CompBase::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
+/** @cond doxygenLibsbmlInternal */
+void
+CompBase::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameMetaIdRefs(renamed);
+  }
+}
+/** @endcond */
+
+/** @cond doxygenLibsbmlInternal */
+void
+CompBase::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
 void
 CompBase::readAttributes (const XMLAttributes& attributes,
                           const ExpectedAttributes& expectedAttributes,
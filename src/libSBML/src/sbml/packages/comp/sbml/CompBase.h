@@ -139,6 +139,24 @@ public:
   unsigned int getPackageVersion() const;
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Every subclass that overrides one of the single-identifier renameXRefs
+   * functions also overrides its batch version, so (unlike SBase does for
+   * package elements) these only need to pass the map on to the plugins.
+   */
+  using SBase::renameSIdRefs;
+  using SBase::renameMetaIdRefs;
+  using SBase::renameUnitSIdRefs;
+
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /**
    * Returns the Model object to which the referenced child object belongs.
    */
@@ -244,7 +244,10 @@ ModelDefinition::writeAttributes(XMLOutputStream& stream) const
   // the id and name attribute on a ModelDefinition come from the parent model
   // BUT if the document is an L3V2 doc and we are using comp l3v1v1 we need to write
   // the id and name here but still in the sbml ns
-  if (getSBMLDocument()->getVersion() > 1 && this->getPackageCoreVersion() == 1)
+  // (a model definition taken out of its document has the version of the document)
+  const SBMLDocument* doc = getSBMLDocument();
+  const unsigned int version = (doc != NULL) ? doc->getVersion() : getVersion();
+  if (version > 1 && this->getPackageCoreVersion() == 1)
   {
     if (isSetId()) {
       stream.writeAttribute("id", getSBMLPrefix(), mId);
@@ -108,6 +108,7 @@ Port::setId (const std::string& id)
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
   mId = id;
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -130,6 +131,7 @@ int
 Port::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -329,6 +331,17 @@ Port::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+Port::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mIdRef);
+  if (newid != NULL) mIdRef = *newid;
+  SBaseRef::renameSIdRefs(renamed);
+}
+/** @endcond */
+
+
 void
 Port::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -337,6 +350,17 @@ Port::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+Port::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mUnitRef);
+  if (newid != NULL) mUnitRef = *newid;
+  SBaseRef::renameUnitSIdRefs(renamed);
+}
+/** @endcond */
+
+
 void
 Port::renameMetaIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -345,6 +369,17 @@ Port::renameMetaIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+Port::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mMetaIdRef);
+  if (newid != NULL) mMetaIdRef = *newid;
+  SBaseRef::renameMetaIdRefs(renamed);
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 bool
 Port::accept (SBMLVisitor& v) const
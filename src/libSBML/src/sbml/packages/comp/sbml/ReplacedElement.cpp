@@ -336,6 +336,17 @@ ReplacedElement::renameSIdRefs(const std::string& oldid, const std::string& newi
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+ReplacedElement::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mDeletion);
+  if (newid != NULL) mDeletion = *newid;
+  Replacing::renameSIdRefs(renamed);
+}
+/** @endcond */
+
+
 int ReplacedElement::performReplacementAndCollect(set<SBase*>* removed, set<SBase*>* toremove)
 {
   SBMLDocument* doc = getSBMLDocument();
@@ -330,6 +330,11 @@ public:
   virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /**
    * Finds the SBase object this ReplacedElement object points to, if any.
    *
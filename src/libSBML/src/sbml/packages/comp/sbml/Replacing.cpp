@@ -240,6 +240,19 @@ Replacing::renameSIdRefs(const std::string& oldid, const std::string& newid)
   SBaseRef::renameSIdRefs(oldid, newid);
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+Replacing::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mSubmodelRef);
+  if (newid != NULL) mSubmodelRef = *newid;
+  newid = getRenamedId(renamed, mConversionFactor);
+  if (newid != NULL) mConversionFactor = *newid;
+  SBaseRef::renameSIdRefs(renamed);
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 void
 Replacing::addExpectedAttributes(ExpectedAttributes& attributes)
@@ -538,6 +538,23 @@ SBaseRef::renameSIdRefs(const std::string& oldid, const std::string& newid)
   SBase::renameSIdRefs(oldid, newid);
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+SBaseRef::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mPortRef);
+  if (newid != NULL) mPortRef = *newid;
+  newid = getRenamedId(renamed, mIdRef);
+  if (newid != NULL) mIdRef = *newid;
+  newid = getRenamedId(renamed, mUnitRef);
+  if (newid != NULL) mUnitRef = *newid;
+  newid = getRenamedId(renamed, mMetaIdRef);
+  if (newid != NULL) mMetaIdRef = *newid;
+  CompBase::renameSIdRefs(renamed);
+}
+/** @endcond */
+
 /*
  * Creates a new SBaseRef, adds it to this SBaseRef
  * and returns it.
@@ -182,6 +182,7 @@ Submodel::setId (const std::string& id)
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
   mId = id;
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -204,6 +205,7 @@ int
 Submodel::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -717,6 +719,19 @@ Submodel::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+Submodel::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mTimeConversionFactor);
+  if (newid != NULL) mTimeConversionFactor = *newid;
+  newid = getRenamedId(renamed, mExtentConversionFactor);
+  if (newid != NULL) mExtentConversionFactor = *newid;
+  CompBase::renameSIdRefs(renamed);
+}
+/** @endcond */
+
+
 int
 Submodel::getTypeCode () const
 {
@@ -238,7 +238,9 @@ DynElement::setIdRef(const std::string& idRef)
 int
 DynElement::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -294,6 +296,7 @@ int
 DynElement::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -262,7 +262,9 @@ SpatialComponent::setVariable(const std::string& variable)
 int
 SpatialComponent::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -314,6 +316,7 @@ int
 SpatialComponent::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
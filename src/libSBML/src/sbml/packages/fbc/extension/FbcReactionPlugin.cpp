@@ -335,6 +335,26 @@ FbcReactionPlugin::renameSIdRefs(const std::string& oldid, const std::string& ne
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+FbcReactionPlugin::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  FbcSBasePlugin::renameSIdRefs(renamed);
+  std::map<std::string, std::string>::const_iterator it;
+  if (isSetLowerFluxBound())
+  {
+    it = renamed.find(mLowerFluxBound);
+    if (it != renamed.end()) mLowerFluxBound = it->second;
+  }
+  if (isSetUpperFluxBound())
+  {
+    it = renamed.find(mUpperFluxBound);
+    if (it != renamed.end()) mUpperFluxBound = it->second;
+  }
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Write values of XMLAttributes to the output stream.
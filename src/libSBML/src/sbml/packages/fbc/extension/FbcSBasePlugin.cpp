@@ -401,6 +401,27 @@ FbcSBasePlugin::updateSBMLNamespace(const std::string& package,
 
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+FbcSBasePlugin::renameSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+FbcSBasePlugin::renameMetaIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+FbcSBasePlugin::renameUnitSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+/** @endcond */
+
+
+
 /** @cond doxygenLibsbmlInternal */
 
 /*
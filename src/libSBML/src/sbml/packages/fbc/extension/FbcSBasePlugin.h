@@ -428,6 +428,27 @@ public:
 
 
 
+  /** @cond doxygenLibsbmlInternal */
+
+  /**
+   * The key-value pairs are renamed on their own and this plugin holds no
+   * references, so these do nothing instead of looping over @p renamed.
+   * FbcReactionPlugin overrides the SIdRef version.
+   */
+  using SBasePlugin::renameSIdRefs;
+  using SBasePlugin::renameMetaIdRefs;
+  using SBasePlugin::renameUnitSIdRefs;
+
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  /** @endcond */
+
+
+
 
   #ifndef SWIG
 
@@ -15,9 +15,11 @@
 #include <sbml/packages/fbc/extension/FbcExtension.h>
 #include <sbml/packages/fbc/extension/FbcModelPlugin.h>
 #include <sbml/packages/fbc/sbml/Association.h>
+#include <sbml/packages/fbc/common/FbcExtensionTypes.h>
 #include <sbml/extension/SBMLExtensionRegistry.h>
 #include <sbml/SBMLTypeCodes.h>
 #include <sbml/SBMLReader.h>
+#include <sbml/SBMLTypes.h>
 #include <string>
 
 /** @cond doxygenIgnored */
@@ -369,6 +371,107 @@ START_TEST(test_FbcExtension_parseGeneAssociation)
 }
 END_TEST
 
+static SBMLDocument*
+createRenameDocument()
+{
+  FbcPkgNamespaces ns(3, 1, 3);
+  SBMLDocument* doc = new SBMLDocument(&ns);
+  Model* model = doc->createModel();
+  FbcModelPlugin* mplugin = static_cast<FbcModelPlugin*>(model->getPlugin("fbc"));
+
+  model->createSpecies()->setId("s");
+  model->createParameter()->setId("lb");
+  model->createParameter()->setId("ub");
+
+  Reaction* r = model->createReaction();
+  r->setId("r");
+  FbcReactionPlugin* rplugin = static_cast<FbcReactionPlugin*>(r->getPlugin("fbc"));
+  rplugin->setLowerFluxBound("lb");
+  rplugin->setUpperFluxBound("ub");
+  rplugin->createGeneProductAssociation()->createGeneProductRef()->setGeneProduct("g");
+
+  GeneProduct* gp = mplugin->createGeneProduct();
+  gp->setId("g");
+  gp->setAssociatedSpecies("s");
+
+  mplugin->createFluxBound()->setReaction("r");
+
+  Objective* o = mplugin->createObjective();
+  o->setId("o");
+  FluxObjective* fo = o->createFluxObjective();
+  fo->setReaction("r");
+  fo->setReaction2("r");
+  mplugin->setActiveObjectiveId("o");
+
+  UserDefinedConstraint* udc = mplugin->createUserDefinedConstraint();
+  udc->setLowerBound("lb");
+  udc->setUpperBound("ub");
+  UserDefinedConstraintComponent* udcc = udc->createUserDefinedConstraintComponent();
+  udcc->setCoefficient("lb");
+  udcc->setVariable("r");
+  udcc->setVariable2("r");
+
+  return doc;
+}
+
+
+START_TEST (test_FbcExtension_renameSIdRefs_map)
+{
+  std::map<std::string, std::string> renamed;
+  renamed["s"] = "s_new";
+  renamed["lb"] = "lb_new";
+  renamed["ub"] = "ub_new";
+  renamed["r"] = "r_new";
+  renamed["g"] = "g_new";
+  renamed["o"] = "o_new";
+
+  SBMLDocument* batch = createRenameDocument();
+  SBMLDocument* single = createRenameDocument();
+
+  List* elements = batch->getAllElements();
+  for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+  {
+    static_cast<SBase*>(*it)->renameSIdRefs(renamed);
+  }
+  delete elements;
+
+  elements = single->getAllElements();
+  for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+  {
+    std::map<std::string, std::string>::const_iterator entry;
+    for (entry = renamed.begin(); entry != renamed.end(); ++entry)
+    {
+      static_cast<SBase*>(*it)->renameSIdRefs(entry->first, entry->second);
+    }
+  }
+  delete elements;
+
+  Model* model = batch->getModel();
+  FbcModelPlugin* mplugin = static_cast<FbcModelPlugin*>(model->getPlugin("fbc"));
+  FbcReactionPlugin* rplugin = static_cast<FbcReactionPlugin*>(model->getReaction(0)->getPlugin("fbc"));
+
+  fail_unless(rplugin->getLowerFluxBound() == "lb_new");
+  fail_unless(rplugin->getUpperFluxBound() == "ub_new");
+  fail_unless(static_cast<GeneProductRef*>(rplugin->getGeneProductAssociation()->getAssociation())->getGeneProduct() == "g_new");
+  fail_unless(mplugin->getGeneProduct(0)->getAssociatedSpecies() == "s_new");
+  fail_unless(mplugin->getFluxBound(0)->getReaction() == "r_new");
+  fail_unless(mplugin->getObjective(0)->getFluxObjective(0)->getReaction() == "r_new");
+  fail_unless(mplugin->getObjective(0)->getFluxObjective(0)->getReaction2() == "r_new");
+  fail_unless(mplugin->getActiveObjectiveId() == "o_new");
+  fail_unless(mplugin->getUserDefinedConstraint(0)->getLowerBound() == "lb_new");
+  fail_unless(mplugin->getUserDefinedConstraint(0)->getUpperBound() == "ub_new");
+  fail_unless(mplugin->getUserDefinedConstraint(0)->getUserDefinedConstraintComponent(0)->getCoefficient() == "lb_new");
+  fail_unless(mplugin->getUserDefinedConstraint(0)->getUserDefinedConstraintComponent(0)->getVariable() == "r_new");
+  fail_unless(mplugin->getUserDefinedConstraint(0)->getUserDefinedConstraintComponent(0)->getVariable2() == "r_new");
+
+  fail_unless(writeSBMLToStdString(batch) == writeSBMLToStdString(single));
+
+  delete batch;
+  delete single;
+}
+END_TEST
+
+
 Suite *
 create_suite_FbcExtension (void)
 {
@@ -388,6 +491,7 @@ create_suite_FbcExtension (void)
   tcase_add_test( tcase, test_FbcExtension_registry        );
   tcase_add_test( tcase, test_FbcExtension_typecode        );
   tcase_add_test( tcase, test_FbcExtension_SBMLtypecode    );
+  tcase_add_test( tcase, test_FbcExtension_renameSIdRefs_map);
 
   suite_add_tcase(suite, tcase);
 
@@ -172,7 +172,9 @@ FluxBound::isSetId () const
 int 
 FluxBound::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -183,6 +185,7 @@ int
 FluxBound::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -434,6 +437,19 @@ FluxBound::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+FluxBound::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetReaction()) {
+    const std::string* newid = getRenamedId(renamed, mReaction);
+    if (newid != NULL) setReaction(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of
  * this SBML object.
@@ -290,7 +290,9 @@ FluxObjective::isSetVariableType() const
 int
 FluxObjective::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -398,6 +400,7 @@ int
 FluxObjective::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -517,6 +520,23 @@ FluxObjective::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+FluxObjective::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetReaction()) {
+    const std::string* newid = getRenamedId(renamed, mReaction);
+    if (newid != NULL) setReaction(*newid);
+  }
+  if (isSetReaction2()) {
+    const std::string* newid = getRenamedId(renamed, mReaction2);
+    if (newid != NULL) setReaction2(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this object
  */
@@ -470,6 +470,11 @@ public:
    virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+   /** @cond doxygenLibsbmlInternal */
+   virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+   /** @endcond */
+
+
   /**
    * Returns the XML element name of this object.
    *
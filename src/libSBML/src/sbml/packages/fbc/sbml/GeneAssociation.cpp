@@ -247,7 +247,9 @@ GeneAssociation::isSetId () const
 int 
 GeneAssociation::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id ,mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -258,6 +260,7 @@ int
 GeneAssociation::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
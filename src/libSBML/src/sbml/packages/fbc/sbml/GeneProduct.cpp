@@ -222,7 +222,9 @@ GeneProduct::isSetAssociatedSpecies() const
 int
 GeneProduct::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -277,6 +279,7 @@ int
 GeneProduct::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -361,6 +364,19 @@ GeneProduct::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+GeneProduct::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetAssociatedSpecies()) {
+    const std::string* newid = getRenamedId(renamed, mAssociatedSpecies);
+    if (newid != NULL) setAssociatedSpecies(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this object
  */
@@ -224,7 +224,9 @@ GeneProductRef::isSetName() const
 int
 GeneProductRef::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -266,6 +268,7 @@ int
 GeneProductRef::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -331,6 +334,19 @@ GeneProductRef::renameSIdRefs(const std::string& oldid, const std::string& newid
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+GeneProductRef::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  FbcAssociation::renameSIdRefs(renamed);
+  if (isSetGeneProduct()) {
+    const std::string* newid = getRenamedId(renamed, mGeneProduct);
+    if (newid != NULL) setGeneProduct(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this object
  */
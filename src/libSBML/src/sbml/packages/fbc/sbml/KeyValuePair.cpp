@@ -239,7 +239,9 @@ KeyValuePair::setId(const std::string& id)
 
   if (pkgVersion >= 3)
   {
-    return SyntaxChecker::checkAndSetSId(id, mId);
+    int result = SyntaxChecker::checkAndSetSId(id, mId);
+    updateElementIdIndex();
+    return result;
   }
   else
   {
@@ -335,6 +337,7 @@ int
 KeyValuePair::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
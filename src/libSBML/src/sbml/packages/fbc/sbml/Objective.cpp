@@ -233,7 +233,9 @@ Objective::isSetType() const
 int
 Objective::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -286,6 +288,7 @@ int
 Objective::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -1540,6 +1543,17 @@ ListOfObjectives::renameSIdRefs(const std::string& oldid, const std::string& new
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+ListOfObjectives::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  const std::string* newid = getRenamedId(renamed, mActiveObjective);
+  if (newid != NULL) mActiveObjective = *newid;
+  ListOf::renameSIdRefs(renamed);
+}
+/** @endcond */
+
+
 /*
  * Creates a new Objective in this ListOfObjectives
  */
@@ -230,7 +230,9 @@ UserDefinedConstraint::setId(const std::string& id)
 
   if (pkgVersion >= 3)
   {
-    return SyntaxChecker::checkAndSetSId(id, mId);
+    int result = SyntaxChecker::checkAndSetSId(id, mId);
+    updateElementIdIndex();
+    return result;
   }
   else
   {
@@ -320,6 +322,7 @@ int
 UserDefinedConstraint::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -601,6 +604,22 @@ UserDefinedConstraint::renameSIdRefs(const std::string& oldid,
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+UserDefinedConstraint::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (isSetLowerBound()) {
+    const std::string* newid = getRenamedId(renamed, mLowerBound);
+    if (newid != NULL) setLowerBound(*newid);
+  }
+  if (isSetUpperBound()) {
+    const std::string* newid = getRenamedId(renamed, mUpperBound);
+    if (newid != NULL) setUpperBound(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this UserDefinedConstraint object.
  */
@@ -622,6 +622,11 @@ public:
                              const std::string& newid);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /**
    * Returns the XML element name of this UserDefinedConstraint object.
    *
@@ -296,7 +296,9 @@ UserDefinedConstraintComponent::setId(const std::string& id)
 
   if (pkgVersion >= 3)
   {
-    return SyntaxChecker::checkAndSetSId(id, mId);
+    int result = SyntaxChecker::checkAndSetSId(id, mId);
+    updateElementIdIndex();
+    return result;
   }
   else
   {
@@ -476,6 +478,7 @@ int
 UserDefinedConstraintComponent::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -604,6 +607,26 @@ UserDefinedConstraintComponent::renameSIdRefs(const std::string& oldid,
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+UserDefinedConstraintComponent::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (isSetCoefficient()) {
+    const std::string* newid = getRenamedId(renamed, mCoefficient);
+    if (newid != NULL) setCoefficient(*newid);
+  }
+  if (isSetVariable()) {
+    const std::string* newid = getRenamedId(renamed, mVariable);
+    if (newid != NULL) setVariable(*newid);
+  }
+  if (isSetVariable2()) {
+    const std::string* newid = getRenamedId(renamed, mVariable2);
+    if (newid != NULL) setVariable2(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this UserDefinedConstraintComponent object.
  */
@@ -166,7 +166,9 @@ ListOfMembers::isSetName() const
 int
 ListOfMembers::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -188,6 +190,7 @@ int
 ListOfMembers::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
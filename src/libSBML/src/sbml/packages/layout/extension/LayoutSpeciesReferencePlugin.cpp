@@ -228,6 +228,25 @@ LayoutSpeciesReferencePlugin::accept (SBMLVisitor&) const
 }
 /** @endcond */
 
+/** @cond doxygenLibsbmlInternal */
+void
+LayoutSpeciesReferencePlugin::renameSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+LayoutSpeciesReferencePlugin::renameMetaIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+LayoutSpeciesReferencePlugin::renameUnitSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+/** @endcond */
+
 
 LIBSBML_CPP_NAMESPACE_END
 
@@ -154,6 +154,23 @@ public:
   virtual void writeAttributes (XMLOutputStream& stream) const;
   /** @endcond */
 
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * This plugin holds no references, so these do nothing instead of
+   * looping over @p renamed.
+   */
+  using SBasePlugin::renameSIdRefs;
+  using SBasePlugin::renameMetaIdRefs;
+  using SBasePlugin::renameUnitSIdRefs;
+
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
 #endif //SWIG
 };
 
@@ -66,6 +66,19 @@ CompartmentGlyph::renameSIdRefs(const std::string& oldid, const std::string& new
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+CompartmentGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  GraphicalObject::renameSIdRefs(renamed);
+  if (isSetCompartmentId()) {
+    const std::string* newid = getRenamedId(renamed, mCompartment);
+    if (newid != NULL) setCompartmentId(*newid);
+  }
+}
+/** @endcond */
+
 /*
  * Default Constructor which creates a new CompartmentGlyph.  Id and
  * associated compartment id are unset.
@@ -83,6 +83,19 @@ GeneralGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+GeneralGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  GraphicalObject::renameSIdRefs(renamed);
+  if (isSetReferenceId()) {
+    const std::string* newid = getRenamedId(renamed, mReference);
+    if (newid != NULL) setReferenceId(*newid);
+  }
+}
+/** @endcond */
+
 /*
  * Creates a new GeneralGlyph.  The list of reference and sub glyph is
  * empty and the id of the associated element is set to the empty string.
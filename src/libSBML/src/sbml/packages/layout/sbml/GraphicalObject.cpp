@@ -82,6 +82,19 @@ GraphicalObject::renameMetaIdRefs(const std::string& oldid, const std::string& n
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+GraphicalObject::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameMetaIdRefs(renamed);
+  if (isSetMetaIdRef()) {
+    const std::string* newid = getRenamedId(renamed, mMetaIdRef);
+    if (newid != NULL) mMetaIdRef = *newid;
+  }
+}
+/** @endcond */
+
 /*
  * Creates a new GraphicalObject.
  */
@@ -391,7 +404,9 @@ int GraphicalObject::setId(const std::string& id)
 {
   if (id.empty())
     return unsetId();
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -401,6 +416,7 @@ int GraphicalObject::setId(const std::string& id)
 int GraphicalObject::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -218,6 +218,11 @@ public:
    */
   virtual void renameMetaIdRefs(const std::string& oldid, const std::string& newid);
 
+
+  /** @cond doxygenLibsbmlInternal */
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
   /**
    * Returns the value of the "id" attribute of this GraphicalObject.
    *
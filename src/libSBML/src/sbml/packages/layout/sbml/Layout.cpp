@@ -453,7 +453,9 @@ bool Layout::isSetName () const
   */
 int Layout::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 int Layout::setName (const std::string& name)
@@ -471,6 +473,7 @@ int Layout::setName (const std::string& name)
 int Layout::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -80,6 +80,19 @@ ReactionGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+ReactionGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  GraphicalObject::renameSIdRefs(renamed);
+  if (isSetReactionId()) {
+    const std::string* newid = getRenamedId(renamed, mReaction);
+    if (newid != NULL) mReaction = *newid;
+  }
+}
+/** @endcond */
+
+
 /*
  * Creates a new ReactionGlyph.  The list of species reference glyph is
  * empty and the id of the associated reaction is set to the empty string.
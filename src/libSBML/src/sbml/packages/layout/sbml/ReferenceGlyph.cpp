@@ -79,6 +79,23 @@ ReferenceGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+ReferenceGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  GraphicalObject::renameSIdRefs(renamed);
+  if (isSetReferenceId()) {
+    const std::string* newid = getRenamedId(renamed, mReference);
+    if (newid != NULL) mReference = *newid;
+  }
+  if (isSetGlyphId()) {
+    const std::string* newid = getRenamedId(renamed, mGlyph);
+    if (newid != NULL) mGlyph = *newid;
+  }
+}
+/** @endcond */
+
 /*
  * Creates a new ReferenceGlyph.  The id if the associated 
  * reference and the id of the associated glyph are set to the
@@ -60,6 +60,19 @@ SpeciesGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+SpeciesGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  GraphicalObject::renameSIdRefs(renamed);
+  if (isSetSpeciesId()) {
+    const std::string* newid = getRenamedId(renamed, mSpecies);
+    if (newid != NULL) mSpecies = *newid;
+  }
+}
+/** @endcond */
+
 /*
  * Creates a new SpeciesGlyph with the given SBML level, version, and package version
  * and the id of the associated species set to the empty string.
@@ -93,6 +93,23 @@ SpeciesReferenceGlyph::renameSIdRefs(const std::string& oldid, const std::string
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+SpeciesReferenceGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  GraphicalObject::renameSIdRefs(renamed);
+  if (isSetSpeciesReferenceId()) {
+    const std::string* newid = getRenamedId(renamed, mSpeciesReference);
+    if (newid != NULL) mSpeciesReference = *newid;
+  }
+  if (isSetSpeciesGlyphId()) {
+    const std::string* newid = getRenamedId(renamed, mSpeciesGlyph);
+    if (newid != NULL) mSpeciesGlyph = *newid;
+  }
+}
+/** @endcond */
+
 /*
  * Creates a new SpeciesReferenceGlyph.  The id if the associated species
  * reference and the id of the associated species glyph are set to the
@@ -65,6 +65,23 @@ TextGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+void
+TextGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  GraphicalObject::renameSIdRefs(renamed);
+  if (isSetGraphicalObjectId()) {
+    const std::string* newid = getRenamedId(renamed, mGraphicalObject);
+    if (newid != NULL) mGraphicalObject = *newid;
+  }
+  if (isSetOriginOfTextId()) {
+    const std::string* newid = getRenamedId(renamed, mOriginOfText);
+    if (newid != NULL) mOriginOfText = *newid;
+  }
+}
+/** @endcond */
+
 /*
  * Creates a new TextGlyph the ids of the associated GraphicalObject and
  * the originOfText are set to the empty string. The actual text is set to
@@ -584,6 +584,85 @@ START_TEST ( test_Layout_assignmentOperator )
 END_TEST
 
 
+static void
+checkRenamedGlyphs (Layout* l)
+{
+  fail_unless( l->getCompartmentGlyph(0)->getCompartmentId() == "c_new" );
+  fail_unless( l->getSpeciesGlyph(0)->getSpeciesId() == "s_new" );
+  fail_unless( l->getReactionGlyph(0)->getReactionId() == "r_new" );
+  fail_unless( l->getReactionGlyph(0)->getSpeciesReferenceGlyph(0)->getSpeciesReferenceId() == "sr_new" );
+  fail_unless( l->getReactionGlyph(0)->getSpeciesReferenceGlyph(0)->getSpeciesGlyphId() == "sg_new" );
+  fail_unless( l->getGeneralGlyph(0)->getReferenceId() == "r_new" );
+  fail_unless( l->getGeneralGlyph(0)->getReferenceGlyph(0)->getReferenceId() == "s_new" );
+  fail_unless( l->getGeneralGlyph(0)->getReferenceGlyph(0)->getGlyphId() == "sg_new" );
+  fail_unless( l->getTextGlyph(0)->getGraphicalObjectId() == "sg_new" );
+  fail_unless( l->getTextGlyph(0)->getOriginOfTextId() == "s_new" );
+  fail_unless( l->getAdditionalGraphicalObject("go")->getMetaIdRef() == "m_new" );
+}
+
+START_TEST ( test_Layout_renameSIdRefs_map )
+{
+  L->createCompartmentGlyph()->setCompartmentId("c");
+  SpeciesGlyph* sg = L->createSpeciesGlyph();
+  sg->setId("sg");
+  sg->setSpeciesId("s");
+  ReactionGlyph* rg = L->createReactionGlyph();
+  rg->setReactionId("r");
+  SpeciesReferenceGlyph* srg = rg->createSpeciesReferenceGlyph();
+  srg->setSpeciesReferenceId("sr");
+  srg->setSpeciesGlyphId("sg");
+  GeneralGlyph* gg = L->createGeneralGlyph();
+  gg->setReferenceId("r");
+  ReferenceGlyph* rfg = gg->createReferenceGlyph();
+  rfg->setReferenceId("s");
+  rfg->setGlyphId("sg");
+  TextGlyph* tg = L->createTextGlyph();
+  tg->setGraphicalObjectId("sg");
+  tg->setOriginOfTextId("s");
+  GraphicalObject* go = L->createAdditionalGraphicalObject();
+  go->setId("go");
+  go->setMetaIdRef("m");
+
+  Layout* single = L->clone();
+
+  std::map<std::string, std::string> sids;
+  sids["c"] = "c_new";
+  sids["s"] = "s_new";
+  sids["r"] = "r_new";
+  sids["sr"] = "sr_new";
+  sids["sg"] = "sg_new";
+
+  std::map<std::string, std::string> metaids;
+  metaids["m"] = "m_new";
+
+  // Every element once with the whole map ...
+  List* elements = L->getAllElements();
+  for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+  {
+    static_cast<SBase*>(*it)->renameSIdRefs(sids);
+    static_cast<SBase*>(*it)->renameMetaIdRefs(metaids);
+  }
+  delete elements;
+  checkRenamedGlyphs(L);
+
+  // ... must do the same as every element once per renamed identifier.
+  elements = single->getAllElements();
+  for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+  {
+    std::map<std::string, std::string>::const_iterator entry;
+    for (entry = sids.begin(); entry != sids.end(); ++entry)
+    {
+      static_cast<SBase*>(*it)->renameSIdRefs(entry->first, entry->second);
+    }
+    static_cast<SBase*>(*it)->renameMetaIdRefs("m", "m_new");
+  }
+  delete elements;
+  checkRenamedGlyphs(single);
+
+  delete single;
+}
+END_TEST
+
 Suite *
 create_suite_Layout (void)
 {
@@ -621,6 +700,7 @@ create_suite_Layout (void)
   tcase_add_test ( tcase , test_Layout_getNumAdditionalGraphicalObjects );
   tcase_add_test(  tcase , test_Layout_copyConstructor                  );
   tcase_add_test(  tcase , test_Layout_assignmentOperator               );
+  tcase_add_test(  tcase , test_Layout_renameSIdRefs_map                );
   
   suite_add_tcase(suite, tcase);
   
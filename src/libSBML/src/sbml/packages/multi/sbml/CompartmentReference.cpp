@@ -188,7 +188,9 @@ CompartmentReference::isSetCompartment() const
 int
 CompartmentReference::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -228,6 +230,7 @@ int
 CompartmentReference::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
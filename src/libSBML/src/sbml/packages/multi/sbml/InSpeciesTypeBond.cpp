@@ -212,7 +212,9 @@ InSpeciesTypeBond::isSetBindingSite2() const
 int
 InSpeciesTypeBond::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -270,6 +272,7 @@ int
 InSpeciesTypeBond::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -222,7 +222,9 @@ MultiSpeciesType::isSetCompartment() const
 int
 MultiSpeciesType::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -264,6 +266,7 @@ int
 MultiSpeciesType::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -204,7 +204,9 @@ OutwardBindingSite::isSetComponent() const
 int
 OutwardBindingSite::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -289,6 +291,7 @@ int
 OutwardBindingSite::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
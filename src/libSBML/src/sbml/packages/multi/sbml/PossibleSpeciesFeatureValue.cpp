@@ -188,7 +188,9 @@ PossibleSpeciesFeatureValue::isSetNumericValue() const
 int
 PossibleSpeciesFeatureValue::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -228,6 +230,7 @@ int
 PossibleSpeciesFeatureValue::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
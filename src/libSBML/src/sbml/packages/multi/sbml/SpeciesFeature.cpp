@@ -252,7 +252,9 @@ SpeciesFeature::isSetComponent() const
 int
 SpeciesFeature::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -322,6 +324,7 @@ int
 SpeciesFeature::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
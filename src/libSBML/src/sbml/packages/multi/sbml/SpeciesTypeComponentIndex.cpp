@@ -209,7 +209,9 @@ SpeciesTypeComponentIndex::isSetIdentifyingParent() const
 int
 SpeciesTypeComponentIndex::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -267,6 +269,7 @@ int
 SpeciesTypeComponentIndex::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
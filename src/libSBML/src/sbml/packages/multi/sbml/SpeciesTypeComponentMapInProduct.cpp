@@ -230,7 +230,9 @@ SpeciesTypeComponentMapInProduct::isSetProductComponent() const
 int
 SpeciesTypeComponentMapInProduct::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -306,6 +308,7 @@ int
 SpeciesTypeComponentMapInProduct::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
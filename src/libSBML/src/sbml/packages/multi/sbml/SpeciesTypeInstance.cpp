@@ -212,7 +212,9 @@ SpeciesTypeInstance::isSetCompartmentReference() const
 int
 SpeciesTypeInstance::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -270,6 +272,7 @@ int
 SpeciesTypeInstance::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
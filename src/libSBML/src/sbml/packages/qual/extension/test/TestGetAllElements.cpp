@@ -105,6 +105,47 @@ START_TEST (test_getAllElements_transition)
 END_TEST
 
 
+START_TEST (test_getAllElements_renameSIdRefs_map)
+{
+  string filename = string(TestDataDirectory) + "qual-example1.xml";
+  SBMLDocument *batch = readSBMLFromFile(filename.c_str());
+  SBMLDocument *single = readSBMLFromFile(filename.c_str());
+
+  std::map<std::string, std::string> renamed;
+  renamed["c"] = "c_new";
+  renamed["s1"] = "s1_new";
+
+  List * allElems = batch->getAllElements();
+  for (ListIterator it = allElems->begin(); it != allElems->end(); ++it)
+  {
+    static_cast<SBase*>(*it)->renameSIdRefs(renamed);
+  }
+  delete allElems;
+
+  allElems = single->getAllElements();
+  for (ListIterator it = allElems->begin(); it != allElems->end(); ++it)
+  {
+    static_cast<SBase*>(*it)->renameSIdRefs("c", "c_new");
+    static_cast<SBase*>(*it)->renameSIdRefs("s1", "s1_new");
+  }
+  delete allElems;
+
+  QualModelPlugin* mplugin = static_cast<QualModelPlugin*>(batch->getModel()->getPlugin("qual"));
+  Transition* t = mplugin->getTransition(0);
+
+  fail_unless(mplugin->getQualitativeSpecies(0)->getCompartment() == "c_new");
+  fail_unless(t->getInput(0)->getQualitativeSpecies() == "s1_new");
+  fail_unless(t->getOutput(0)->getQualitativeSpecies() == "s1_new");
+  fail_unless(strcmp(t->getFunctionTerm(0)->getMath()->getChild(0)->getName(), "s1_new") == 0);
+
+  fail_unless(writeSBMLToStdString(batch) == writeSBMLToStdString(single));
+
+  delete batch;
+  delete single;
+}
+END_TEST
+
+
 Suite *
 create_suite_GetAllElements (void)
 {
@@ -112,6 +153,7 @@ create_suite_GetAllElements (void)
   TCase *tcase = tcase_create("GetAllElements");
 
   tcase_add_test( tcase, test_getAllElements_transition);
+  tcase_add_test( tcase, test_getAllElements_renameSIdRefs_map);
   suite_add_tcase(suite, tcase);
 
   return suite;
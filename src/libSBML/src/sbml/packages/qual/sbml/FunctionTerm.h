@@ -240,6 +240,11 @@ public:
    virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+   /** @cond doxygenLibsbmlInternal */
+   virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+   /** @endcond */
+
+
   /**
    * Returns the XML name of this object.
    *
@@ -272,7 +272,9 @@ Input::isSetThresholdLevel() const
 int
 Input::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -362,6 +364,7 @@ int
 Input::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -469,6 +472,19 @@ Input::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+Input::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetQualitativeSpecies()) {
+    const std::string* newid = getRenamedId(renamed, mQualitativeSpecies);
+    if (newid != NULL) setQualitativeSpecies(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this object
  */
@@ -248,7 +248,9 @@ Output::isSetOutputLevel() const
 int
 Output::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -321,6 +323,7 @@ int
 Output::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -417,6 +420,19 @@ Output::renameSIdRefs(const std::string& oldid, const std::string& newid)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+Output::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetQualitativeSpecies()) {
+    const std::string* newid = getRenamedId(renamed, mQualitativeSpecies);
+    if (newid != NULL) setQualitativeSpecies(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this object
  */
@@ -280,7 +280,9 @@ QualitativeSpecies::isSetMaxLevel() const
 int
 QualitativeSpecies::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -357,6 +359,7 @@ int
 QualitativeSpecies::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -474,6 +477,19 @@ QualitativeSpecies::renameSIdRefs(const std::string& oldid, const std::string& n
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+QualitativeSpecies::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  SBase::renameSIdRefs(renamed);
+  if (isSetCompartment()) {
+    const std::string* newid = getRenamedId(renamed, mCompartment);
+    if (newid != NULL) setCompartment(*newid);
+  }
+}
+/** @endcond */
+
+
 /*
  * Returns the XML element name of this object
  */
@@ -377,7 +377,9 @@ bool GraphicalPrimitive1D::isSetDashArray() const
 int
 GraphicalPrimitive1D::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -529,6 +531,7 @@ int
 GraphicalPrimitive1D::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
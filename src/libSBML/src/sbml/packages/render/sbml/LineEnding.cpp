@@ -345,7 +345,9 @@ LineEnding::isSetEnableRotationalMapping() const
 int
 LineEnding::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -369,6 +371,7 @@ int
 LineEnding::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
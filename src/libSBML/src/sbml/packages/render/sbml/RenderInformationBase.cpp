@@ -412,7 +412,9 @@ RenderInformationBase::isSetBackgroundColor() const
 int
 RenderInformationBase::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -503,6 +505,7 @@ int
 RenderInformationBase::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
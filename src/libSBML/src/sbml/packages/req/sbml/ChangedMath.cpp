@@ -223,7 +223,9 @@ ChangedMath::isSetViableWithoutChange() const
 int
 ChangedMath::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -268,6 +270,7 @@ int
 ChangedMath::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -220,7 +220,9 @@ AdjacentDomains::isSetDomain2() const
 int
 AdjacentDomains::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -278,6 +280,7 @@ int
 AdjacentDomains::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
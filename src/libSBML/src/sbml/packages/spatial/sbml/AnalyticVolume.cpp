@@ -284,7 +284,9 @@ AnalyticVolume::isSetDomainType() const
 int
 AnalyticVolume::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -374,6 +376,7 @@ int
 AnalyticVolume::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
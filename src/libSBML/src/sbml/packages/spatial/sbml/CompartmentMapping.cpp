@@ -225,7 +225,9 @@ CompartmentMapping::isSetUnitSize() const
 int
 CompartmentMapping::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -277,6 +279,7 @@ int
 CompartmentMapping::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -430,7 +430,9 @@ SpatialPoints::isSetDataType() const
 int
 SpatialPoints::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -683,6 +685,7 @@ int
 SpatialPoints::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -45,12 +45,65 @@
 #include <sbml/SBMLWriter.h>
 #include <sbml/SBMLTypes.h>
 
+#include <sbml/validator/Validator.h>
+#include <sbml/validator/VConstraint.h>
+
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <check.h>
 
 LIBSBML_CPP_NAMESPACE_USE
 
+
+/*
+ * A validator with a single constraint, on objects of type T, that records
+ * the objects it is checked against.
+ */
+template <typename T>
+class VisitRecorder : public Validator
+{
+public:
+
+  VisitRecorder (const std::string& name, std::vector<std::string>& visits)
+    : mName(name)
+    , mVisits(visits)
+  {
+  }
+
+  virtual void init ()
+  {
+    addConstraint(new Record(*this));
+  }
+
+private:
+
+  class Record : public TConstraint<T>
+  {
+  public:
+
+    Record (VisitRecorder& recorder)
+      : TConstraint<T>(0, recorder)
+      , mRecorder(recorder)
+    {
+    }
+
+  protected:
+
+    virtual void check_ (const Model&, const T& object)
+    {
+      mRecorder.mVisits.push_back(mRecorder.mName + ":" + object.getId());
+    }
+
+    VisitRecorder& mRecorder;
+  };
+
+  std::string               mName;
+  std::vector<std::string>& mVisits;
+};
+
+
 BEGIN_C_DECLS
 
 
@@ -200,6 +253,296 @@ START_TEST (test_check_consistency_settings)
 }
 END_TEST
 
+
+START_TEST (test_parallel_consistency_checks)
+{
+  SBMLReader        reader;
+  SBMLDocument*     d;
+  unsigned int errors;
+  std::string filename(TestDataDirectory);
+  filename += "inconsistent.xml";
+
+
+  d = reader.readSBML(filename);
+
+  if (d == NULL)
+  {
+    fail("readSBML(\"inconsistent.xml\") returned a NULL pointer.");
+  }
+
+  fail_unless(d->getParallelValidation() == false);
+  d->setParallelValidation(true);
+  fail_unless(d->getParallelValidation() == true);
+
+  // the same errors are reported as by test_consistency_checks
+  errors = d->checkConsistency();
+
+  fail_unless(errors == 1);
+  fail_unless(d->getError(0)->getErrorId() == 10301);
+
+  d->getErrorLog()->clearLog();
+  d->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+  errors = d->checkConsistency();
+
+  fail_unless(errors == 2);
+  fail_unless(d->getError(0)->getErrorId() == 10214);
+  fail_unless(d->getError(1)->getErrorId() == 20612);
+
+  d->getErrorLog()->clearLog();
+  d->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, false);
+  errors = d->checkConsistency();
+
+  fail_unless(errors == 1);
+  fail_unless(d->getError(0)->getErrorId() == 10701);
+
+  d->getErrorLog()->clearLog();
+  d->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+  errors = d->checkConsistency();
+
+  fail_unless(errors == 1);
+  fail_unless(d->getError(0)->getErrorId() == 10214);
+
+  d->getErrorLog()->clearLog();
+  d->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+  errors = d->checkConsistency();
+
+  fail_unless(errors == 4);
+  fail_unless(d->getError(0)->getErrorId() == 99505);
+  fail_unless(d->getError(1)->getErrorId() == 99505);
+  fail_unless(d->getError(2)->getErrorId() == 99505);
+  fail_unless(d->getError(3)->getErrorId() == 80701);
+
+  // the setting is kept by copies of the document
+  SBMLDocument copy(*d);
+  fail_unless(copy.getParallelValidation() == true);
+
+  delete d;
+}
+END_TEST
+
+
+/*
+ * Checks the given test document sequentially and either in parallel or
+ * in a single pass, first with the default checks and then turning them
+ * off one by one, and fails unless both report the same errors in the
+ * same order.
+ */
+static void
+compareWithSequential (const char* file, bool singlePass,
+                       XMLErrorSeverityOverride_t severityOverride)
+{
+  static const SBMLErrorCategory_t categories[] =
+  {
+      LIBSBML_CAT_IDENTIFIER_CONSISTENCY
+    , LIBSBML_CAT_GENERAL_CONSISTENCY
+    , LIBSBML_CAT_SBO_CONSISTENCY
+    , LIBSBML_CAT_MATHML_CONSISTENCY
+    , LIBSBML_CAT_UNITS_CONSISTENCY
+    , LIBSBML_CAT_OVERDETERMINED_MODEL
+  };
+  const unsigned int numCategories = 
+    sizeof(categories) / sizeof(categories[0]);
+
+  std::string filename(TestDataDirectory);
+  filename += file;
+
+  SBMLDocument* sequential = readSBMLFromFile(filename.c_str());
+  SBMLDocument* parallel   = readSBMLFromFile(filename.c_str());
+  if (singlePass)
+  {
+    parallel->setSinglePassValidation(true);
+  }
+  else
+  {
+    parallel->setParallelValidation(true);
+  }
+
+  for (unsigned int off = 0; off <= numCategories; ++off)
+  {
+    sequential->getErrorLog()->clearLog();
+    parallel->getErrorLog()->clearLog();
+    sequential->getErrorLog()->setSeverityOverride(severityOverride);
+    parallel->getErrorLog()->setSeverityOverride(severityOverride);
+
+    if (off > 0)
+    {
+      sequential->setConsistencyChecks(categories[off - 1], false);
+      parallel->setConsistencyChecks(categories[off - 1], false);
+    }
+    else
+    {
+      sequential->setConsistencyChecks(LIBSBML_CAT_STRICT_UNITS_CONSISTENCY, true);
+      parallel->setConsistencyChecks(LIBSBML_CAT_STRICT_UNITS_CONSISTENCY, true);
+    }
+
+    unsigned int errors = sequential->checkConsistency();
+    fail_unless(parallel->checkConsistency() == errors);
+    fail_unless(parallel->getNumErrors() == sequential->getNumErrors());
+
+    for (unsigned int n = 0; n < sequential->getNumErrors() && 
+                             n < parallel->getNumErrors(); ++n)
+    {
+      const SBMLError* expected = sequential->getError(n);
+      const SBMLError* error    = parallel->getError(n);
+      fail_unless(error->getErrorId() == expected->getErrorId());
+      fail_unless(error->getSeverity() == expected->getSeverity());
+      fail_unless(error->getLine() == expected->getLine());
+      fail_unless(error->getMessage() == expected->getMessage());
+    }
+  }
+
+  delete sequential;
+  delete parallel;
+}
+
+
+static const char* comparedFiles[] =
+{
+    "inconsistent.xml"
+  , "inconsistent-l2v1-units.xml"
+  , "inconsistent-l2v1-units-2.xml"
+  , "l3v1-new-invalid.xml"
+  , "multiple-ids.xml"
+  , "l2v4-new.xml"
+  , "l3v1-units.xml"
+  , "l2v5-all.xml"
+};
+
+
+START_TEST (test_parallel_matches_sequential)
+{
+  for (unsigned int n = 0; n < sizeof(comparedFiles) / sizeof(comparedFiles[0]); ++n)
+  {
+    compareWithSequential(comparedFiles[n], false, LIBSBML_OVERRIDE_DISABLED);
+    // errors logged as warnings do not stop the validation
+    compareWithSequential(comparedFiles[n], false, LIBSBML_OVERRIDE_WARNING);
+  }
+}
+END_TEST
+
+
+/*
+ * The unit validators both ask for the derived units of the same
+ * parameters; those without declared units must not make them write to
+ * the parameters (see Parameter::getDerivedUnitDefinition).
+ */
+START_TEST (test_parallel_undeclared_parameter_units)
+{
+  SBMLDocument sequential(2, 4);
+  Model* m = sequential.createModel();
+
+  Compartment* c = m->createCompartment();
+  c->setId("c");
+  c->setSize(1.0);
+
+  Species* s = m->createSpecies();
+  s->setId("s");
+  s->setCompartment("c");
+  s->setInitialConcentration(1.0);
+
+  for (unsigned int n = 0; n < 4; ++n)
+  {
+    std::ostringstream id;
+    id << "k" << n;
+    Parameter* p = m->createParameter();
+    p->setId(id.str());
+    p->setValue(1.0);
+  }
+
+  Reaction* r = m->createReaction();
+  r->setId("r");
+  r->createReactant()->setSpecies("s");
+  r->createKineticLaw()->setMath(SBML_parseFormula("k0 * k1 * s * c"));
+
+  m->getParameter("k2")->setConstant(false);
+  AssignmentRule* rule = m->createAssignmentRule();
+  rule->setVariable("k2");
+  rule->setMath(SBML_parseFormula("k3 * s"));
+
+  sequential.setConsistencyChecks(LIBSBML_CAT_STRICT_UNITS_CONSISTENCY, true);
+
+  SBMLDocument parallel(sequential);
+  parallel.setParallelValidation(true);
+
+  unsigned int errors = sequential.checkConsistency();
+  fail_unless( errors > 0 );
+  fail_unless( sequential.getErrorLog()->contains(UndeclaredUnits) );
+  fail_unless( sequential.getErrorLog()->contains(ParameterShouldHaveUnits) );
+
+  fail_unless( parallel.checkConsistency() == errors );
+  fail_unless( parallel.getNumErrors() == sequential.getNumErrors() );
+  for (unsigned int n = 0; n < sequential.getNumErrors() && 
+                           n < parallel.getNumErrors(); ++n)
+  {
+    fail_unless( parallel.getError(n)->getErrorId() == 
+                 sequential.getError(n)->getErrorId() );
+    fail_unless( parallel.getError(n)->getMessage() == 
+                 sequential.getError(n)->getMessage() );
+  }
+}
+END_TEST
+
+
+START_TEST (test_single_pass_traversal)
+{
+  SBMLDocument d(3, 1);
+  Model* m = d.createModel();
+  m->createSpecies()->setId("s1");
+  m->createSpecies()->setId("s2");
+  m->createParameter()->setId("p");
+
+  std::vector<std::string> visits;
+  VisitRecorder<Species>   a("a", visits);
+  VisitRecorder<Species>   b("b", visits);
+  VisitRecorder<Parameter> c("c", visits);
+  a.init();
+  b.init();
+  c.init();
+
+  // on their own, the validators each walk the whole model
+  a.validate(d);
+  b.validate(d);
+  c.validate(d);
+
+  const char* sequential[] = { "a:s1", "a:s2", "b:s1", "b:s2", "c:p" };
+  fail_unless(visits == std::vector<std::string>(sequential, sequential + 5));
+
+  // fused, every object is visited once, and only by the validators
+  // having constraints for it
+  FusedValidator fused;
+  fail_unless(fused.addValidator(&a) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(fused.addValidator(&b) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(fused.addValidator(&c) == LIBSBML_OPERATION_SUCCESS);
+  fused.init();
+
+  visits.clear();
+  fused.validate(d);
+
+  const char* singlePass[] = { "a:s1", "b:s1", "a:s2", "b:s2", "c:p" };
+  fail_unless(visits == std::vector<std::string>(singlePass, singlePass + 5));
+}
+END_TEST
+
+
+START_TEST (test_single_pass_matches_sequential)
+{
+  SBMLDocument d;
+  fail_unless(d.getSinglePassValidation() == false);
+  d.setSinglePassValidation(true);
+
+  // the setting is kept by copies of the document
+  SBMLDocument copy(d);
+  fail_unless(copy.getSinglePassValidation() == true);
+
+  for (unsigned int n = 0; n < sizeof(comparedFiles) / sizeof(comparedFiles[0]); ++n)
+  {
+    compareWithSequential(comparedFiles[n], true, LIBSBML_OVERRIDE_DISABLED);
+    compareWithSequential(comparedFiles[n], true, LIBSBML_OVERRIDE_WARNING);
+  }
+}
+END_TEST
+
+
 Suite *
 create_suite_TestConsistencyChecks (void)
 { 
@@ -210,6 +553,11 @@ create_suite_TestConsistencyChecks (void)
   tcase_add_test(tcase, test_consistency_checks);
   tcase_add_test(tcase, test_strict_unit_consistency_checks);
   tcase_add_test(tcase, test_check_consistency_settings);
+  tcase_add_test(tcase, test_parallel_consistency_checks);
+  tcase_add_test(tcase, test_parallel_matches_sequential);
+  tcase_add_test(tcase, test_parallel_undeclared_parameter_units);
+  tcase_add_test(tcase, test_single_pass_traversal);
+  tcase_add_test(tcase, test_single_pass_matches_sequential);
 
   suite_add_tcase(suite, tcase);
 
@@ -499,6 +499,130 @@ START_TEST (test_GetMultipleObjects_withFilter)
 }
 END_TEST
 
+START_TEST (test_GetMultipleObjects_indexFollowsChanges)
+{
+  SBMLDocument d(3, 2);
+  Model* m = d.createModel();
+
+  Species* s1 = m->createSpecies();
+  s1->setId("s1");
+  Species* s2 = m->createSpecies();
+  s2->setId("s2");
+  Parameter* p = m->createParameter();
+  p->setId("p");
+  p->setMetaId("_p");
+
+  fail_unless(m->getElementBySId("s1") == s1);
+  fail_unless(m->getElementByMetaId("_p") == p);
+
+  // appended after the index was built
+  Species* s3 = m->createSpecies();
+  s3->setId("s3");
+  fail_unless(m->getElementBySId("s3") == s3);
+  fail_unless(m->getSpecies("s3") == s3);
+
+  // renamed
+  s1->setId("renamed");
+  fail_unless(m->getElementBySId("s1") == NULL);
+  fail_unless(m->getElementBySId("renamed") == s1);
+  p->setMetaId("_q");
+  fail_unless(m->getElementByMetaId("_p") == NULL);
+  fail_unless(m->getElementByMetaId("_q") == p);
+
+  // removed by position and by id
+  Species* removed = m->removeSpecies(0);
+  fail_unless(removed == s1);
+  fail_unless(m->getElementBySId("renamed") == NULL);
+  fail_unless(m->getElementBySId("s2") == s2);
+  fail_unless(m->getSpecies("s3") == s3);
+  delete removed;
+
+  removed = m->removeSpecies("s2");
+  fail_unless(removed == s2);
+  fail_unless(m->getElementBySId("s2") == NULL);
+  fail_unless(m->getSpecies("s3") == s3);
+  delete removed;
+
+  // deleted with its parent
+  Reaction* r = m->createReaction();
+  r->setId("r");
+  LocalParameter* lp = r->createKineticLaw()->createLocalParameter();
+  lp->setId("lp");
+  lp->setMetaId("_lp");
+  fail_unless(m->getElementByMetaId("_lp") == lp);
+  // local parameters are not in the SId namespace
+  fail_unless(m->getElementBySId("lp") == NULL);
+  r->unsetKineticLaw();
+  fail_unless(m->getElementByMetaId("_lp") == NULL);
+  fail_unless(m->getElementBySId("r") == r);
+
+  // not in the species list
+  fail_unless(m->getSpecies("p") == NULL);
+  fail_unless(m->getParameter("p") == p);
+}
+END_TEST
+
+
+START_TEST (test_GetMultipleObjects_indexWithoutRebuild)
+{
+  SBMLDocument d(3, 1);
+  Model* m = d.createModel();
+
+  Compartment* c = m->createCompartment();
+  c->setId("c");
+  Species* s1 = m->createSpecies();
+  s1->setId("s1");
+  Species* s2 = m->createSpecies();
+  s2->setId("s2");
+
+  fail_unless(m->getElementBySId("absent") == NULL);
+
+  // inserted in front of the species already indexed
+  Species* s0 = new Species(3, 1);
+  s0->setId("s0");
+  m->getListOfSpecies()->insertAndOwn(0, s0);
+  fail_unless(m->getSpecies("s0") == s0);
+  fail_unless(m->getSpecies("s1") == s1);
+  fail_unless(m->removeSpecies(1) == s1);
+  fail_unless(m->getElementBySId("s1") == NULL);
+  fail_unless(m->getElementBySId("s2") == s2);
+  delete s1;
+
+  // children of a reaction added after the index was built, in lists that
+  // were empty when the reaction was added
+  Reaction* r = m->createReaction();
+  r->setId("r");
+  SpeciesReference* sr = r->createReactant();
+  sr->setSpecies("s2");
+  sr->setId("sr");
+  fail_unless(m->getElementBySId("sr") == sr);
+
+  // SimpleSpeciesReference overrides setId
+  sr->setId("sr2");
+  fail_unless(m->getElementBySId("sr") == NULL);
+  fail_unless(m->getElementBySId("sr2") == sr);
+
+  // moved to another model
+  Model other(3, 1);
+  other.getElementBySId("r");
+  Reaction* moved = m->removeReaction(0);
+  other.getListOfReactions()->appendAndOwn(moved);
+  fail_unless(m->getElementBySId("sr2") == NULL);
+  fail_unless(other.getElementBySId("sr2") == sr);
+
+  // the first of two elements with the same id wins, as in a linear search
+  Parameter* p = m->createParameter();
+  p->setId("c");
+  fail_unless(m->getElementBySId("c") == c);
+  fail_unless(m->getParameter("c") == p);
+  fail_unless(m->getCompartment("c") == c);
+  delete m->removeCompartment(0);
+  fail_unless(m->getElementBySId("c") == p);
+  fail_unless(m->getCompartment("c") == NULL);
+}
+END_TEST
+
+
 Suite *
 create_suite_GetMultipleObjects (void)
 {
@@ -513,6 +637,8 @@ create_suite_GetMultipleObjects (void)
   tcase_add_test(tcase, test_GetMultipleObjects_noAssignments);
   tcase_add_test(tcase, test_GetMultipleObjects_allElements);
   tcase_add_test(tcase, test_GetMultipleObjects_withFilter);
+  tcase_add_test(tcase, test_GetMultipleObjects_indexFollowsChanges);
+  tcase_add_test(tcase, test_GetMultipleObjects_indexWithoutRebuild);
 
 
   suite_add_tcase(suite, tcase);
@@ -45,7 +45,10 @@
 #include <sbml/SBMLWriter.h>
 #include <sbml/SBMLTypes.h>
 
+#include <sbml/validator/SBMLInternalValidator.h>
+
 #include <string>
+#include <vector>
 
 #include <check.h>
 
@@ -2900,6 +2903,46 @@ START_TEST (test_internal_consistency_check_21231)
 END_TEST
 
 
+START_TEST (test_internal_consistency_check_read_time)
+{
+  SBMLDocument*     d = new SBMLDocument(3, 1);
+  Model *m = d->createModel();
+  Species *s = m->createSpecies();
+  s->setId("s");
+  UnitDefinition *ud = m->createUnitDefinition();
+  ud->setId("u");
+  Unit *u = ud->createUnit();
+  u->setKind(UNIT_KIND_METRE);
+  Reaction *r = m->createReaction();
+  r->setId("r");
+  r->createReactant();
+
+  /* the errors found in memory are the ones the reader would report */
+  SBMLInternalValidator validator;
+  validator.setDocument(d);
+
+  unsigned int errors = validator.checkInternalConsistency(true);
+  std::vector<SBMLError> written;
+  for (unsigned int i = 0; i < errors; i++)
+  {
+    written.push_back(*(d->getError(i)));
+  }
+
+  d->getErrorLog()->clearLog();
+  fail_unless(validator.checkInternalConsistency() == errors);
+  fail_unless(errors == 11);
+
+  for (unsigned int i = 0; i < errors; i++)
+  {
+    fail_unless(d->getError(i)->getErrorId() == written[i].getErrorId());
+    fail_unless(d->getError(i)->getMessage() == written[i].getMessage());
+  }
+
+  delete d;
+}
+END_TEST
+
+
 Suite *
 create_suite_TestInternalConsistencyChecks (void)
 { 
@@ -2997,6 +3040,7 @@ create_suite_TestInternalConsistencyChecks (void)
   tcase_add_test(tcase, test_internal_consistency_check_21225);
   tcase_add_test(tcase, test_internal_consistency_check_21226);
   tcase_add_test(tcase, test_internal_consistency_check_21231);
+  tcase_add_test(tcase, test_internal_consistency_check_read_time);
 
   suite_add_tcase(suite, tcase);
 
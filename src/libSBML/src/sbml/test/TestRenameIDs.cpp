@@ -57,45 +57,11 @@ extern char *TestDataDirectory;
 
 
 
-START_TEST (test_RenameIDs)
+static void
+checkRenamedIDs(SBMLDocument* d)
 {
-  SBMLReader        reader;
-  SBMLDocument*     d;
-
-  std::string filename(TestDataDirectory);
-  filename += "multiple-ids.xml";
-
-
-  d = reader.readSBML(filename);
-
-  if (d == NULL || d->getModel() == NULL)
-  {
-    fail("readSBML(\"multiple-ids.xml\") returned a NULL pointer.");
-  }
   SBase* obj;
 
-  //Loop through every element in the model and rename everything.
-  List* allElements = d->getAllElements();
-  for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
-  {
-    SBase* obj = static_cast<SBase*>(*iter);
-    fail_unless(obj != NULL);
-    obj->renameSIdRefs("comp", "comp_new");
-    obj->renameSIdRefs("C", "C_new");
-    obj->renameSIdRefs("conv", "conv_new");
-    obj->renameSIdRefs("b", "b_new");
-    obj->renameSIdRefs("b2", "b2_new");
-    obj->renameSIdRefs("x", "x_new");
-    obj->renameSIdRefs("y", "y_new"); //The 'y' here in the function definition not actually an SId, so this should have no effect.
-    obj->renameUnitSIdRefs("volume", "volume_new");
-    obj->renameUnitSIdRefs("substance", "substance_new");
-    obj->renameUnitSIdRefs("item", "item_new");
-    obj->renameUnitSIdRefs("second", "second_new");
-    obj->renameUnitSIdRefs("litre", "litre_new");
-    obj->renameUnitSIdRefs("candela", "candela_new");
-    obj->renameUnitSIdRefs("farad", "farad_new");
-    obj->renameUnitSIdRefs("coulomb", "coulomb_new");
-  }
   //Function definition
   obj = d->getElementByMetaId("meta21");
   fail_unless(obj != NULL);
@@ -243,6 +209,103 @@ START_TEST (test_RenameIDs)
   fail_unless(mod->getLengthUnits() == "farad_new");
   fail_unless(mod->getExtentUnits() == "coulomb_new");
 
+}
+
+
+START_TEST (test_RenameIDs)
+{
+  SBMLReader        reader;
+  SBMLDocument*     d;
+
+  std::string filename(TestDataDirectory);
+  filename += "multiple-ids.xml";
+
+
+  d = reader.readSBML(filename);
+
+  if (d == NULL || d->getModel() == NULL)
+  {
+    fail("readSBML(\"multiple-ids.xml\") returned a NULL pointer.");
+  }
+  SBase* obj;
+
+  //Loop through every element in the model and rename everything.
+  List* allElements = d->getAllElements();
+  for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
+  {
+    SBase* obj = static_cast<SBase*>(*iter);
+    fail_unless(obj != NULL);
+    obj->renameSIdRefs("comp", "comp_new");
+    obj->renameSIdRefs("C", "C_new");
+    obj->renameSIdRefs("conv", "conv_new");
+    obj->renameSIdRefs("b", "b_new");
+    obj->renameSIdRefs("b2", "b2_new");
+    obj->renameSIdRefs("x", "x_new");
+    obj->renameSIdRefs("y", "y_new"); //The 'y' here in the function definition not actually an SId, so this should have no effect.
+    obj->renameUnitSIdRefs("volume", "volume_new");
+    obj->renameUnitSIdRefs("substance", "substance_new");
+    obj->renameUnitSIdRefs("item", "item_new");
+    obj->renameUnitSIdRefs("second", "second_new");
+    obj->renameUnitSIdRefs("litre", "litre_new");
+    obj->renameUnitSIdRefs("candela", "candela_new");
+    obj->renameUnitSIdRefs("farad", "farad_new");
+    obj->renameUnitSIdRefs("coulomb", "coulomb_new");
+  }
+  checkRenamedIDs(d);
+
+  delete d;
+  delete allElements;
+}
+END_TEST
+
+
+START_TEST (test_RenameIDs_map)
+{
+  SBMLReader        reader;
+  SBMLDocument*     d;
+
+  std::string filename(TestDataDirectory);
+  filename += "multiple-ids.xml";
+
+
+  d = reader.readSBML(filename);
+
+  if (d == NULL || d->getModel() == NULL)
+  {
+    fail("readSBML(\"multiple-ids.xml\") returned a NULL pointer.");
+  }
+
+  std::map<std::string, std::string> sids;
+  sids["comp"] = "comp_new";
+  sids["C"] = "C_new";
+  sids["conv"] = "conv_new";
+  sids["b"] = "b_new";
+  sids["b2"] = "b2_new";
+  sids["x"] = "x_new";
+  sids["y"] = "y_new";
+
+  std::map<std::string, std::string> unitsids;
+  unitsids["volume"] = "volume_new";
+  unitsids["substance"] = "substance_new";
+  unitsids["item"] = "item_new";
+  unitsids["second"] = "second_new";
+  unitsids["litre"] = "litre_new";
+  unitsids["candela"] = "candela_new";
+  unitsids["farad"] = "farad_new";
+  unitsids["coulomb"] = "coulomb_new";
+
+  //Same as above, but every element is only visited once.
+  List* allElements = d->getAllElements();
+  for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
+  {
+    SBase* obj = static_cast<SBase*>(*iter);
+    fail_unless(obj != NULL);
+    obj->renameSIdRefs(sids);
+    obj->renameUnitSIdRefs(unitsids);
+  }
+
+  checkRenamedIDs(d);
+
   delete d;
   delete allElements;
 }
@@ -259,6 +322,7 @@ create_suite_RenameIDs (void)
 
 
   tcase_add_test(tcase, test_RenameIDs);
+  tcase_add_test(tcase, test_RenameIDs_map);
 
 
   suite_add_tcase(suite, tcase);
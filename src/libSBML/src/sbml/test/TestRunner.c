@@ -65,6 +65,7 @@ BEGIN_C_DECLS
 
 
 Suite *create_suite_ReadSBML                      (void);
+Suite *create_suite_SBMLStreamReader              (void);
 Suite *create_suite_WriteSBML                     (void);
 Suite *create_suite_WriteL3SBML                   (void);
 Suite *create_suite_WriteL3V2SBML                 (void);
@@ -227,6 +228,7 @@ main (int argc, char* argv[])
   //SRunner *runner = srunner_create(create_suite_SBMLErrorLog());
 
   SRunner *runner = srunner_create( create_suite_ReadSBML               () );
+  srunner_add_suite( runner, create_suite_SBMLStreamReader              () );
   srunner_add_suite( runner, create_suite_SBMLValidatorAPI              () );
   srunner_add_suite( runner, create_suite_RenameIDs                     () );
   srunner_add_suite( runner, create_suite_RemoveFromParent              () );
@@ -0,0 +1,342 @@
+/**
+ * @file    TestSBMLStreamReader.cpp
+ * @brief   SBMLStreamReader unit tests
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/common.h>
+#include <sbml/common/extern.h>
+#include <sbml/SBMLTypes.h>
+#include <sbml/SBMLStreamReader.h>
+
+#include <check.h>
+
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+extern char *TestDataDirectory;
+
+
+/*
+ * Returns the error ids logged in d, in order.
+ */
+static std::vector<unsigned int>
+getErrorIds (SBMLDocument* d)
+{
+  std::vector<unsigned int> ids;
+  for (unsigned int i = 0; i < d->getNumErrors(); ++i)
+  {
+    ids.push_back(d->getError(i)->getErrorId());
+  }
+  return ids;
+}
+
+
+START_TEST (test_SBMLStreamReader_components)
+{
+  std::string filename(TestDataDirectory);
+  filename += "l3v2-all.xml";
+
+  SBMLDocument* d = readSBML(filename.c_str());
+  Model*        m = d->getModel();
+
+  fail_unless(m != NULL);
+
+  SBMLStreamReader reader;
+  fail_unless(reader.open(filename) == true);
+
+  std::vector<SBase*> expected;
+  for (unsigned int n = 0; n < m->getNumFunctionDefinitions(); ++n)
+    expected.push_back(m->getFunctionDefinition(n));
+  for (unsigned int n = 0; n < m->getNumUnitDefinitions(); ++n)
+    expected.push_back(m->getUnitDefinition(n));
+  for (unsigned int n = 0; n < m->getNumCompartments(); ++n)
+    expected.push_back(m->getCompartment(n));
+  for (unsigned int n = 0; n < m->getNumSpecies(); ++n)
+    expected.push_back(m->getSpecies(n));
+  for (unsigned int n = 0; n < m->getNumParameters(); ++n)
+    expected.push_back(m->getParameter(n));
+  for (unsigned int n = 0; n < m->getNumInitialAssignments(); ++n)
+    expected.push_back(m->getInitialAssignment(n));
+  for (unsigned int n = 0; n < m->getNumRules(); ++n)
+    expected.push_back(m->getRule(n));
+  for (unsigned int n = 0; n < m->getNumConstraints(); ++n)
+    expected.push_back(m->getConstraint(n));
+  for (unsigned int n = 0; n < m->getNumReactions(); ++n)
+    expected.push_back(m->getReaction(n));
+  for (unsigned int n = 0; n < m->getNumEvents(); ++n)
+    expected.push_back(m->getEvent(n));
+
+  unsigned int count = 0;
+  while (SBase* component = reader.next())
+  {
+    fail_unless(count < expected.size());
+    fail_unless(component->getTypeCode() == expected[count]->getTypeCode());
+    fail_unless(component->getId() == expected[count]->getId());
+    fail_unless(component->getParentSBMLObject() == NULL);
+    fail_unless(component->getSBMLDocument() == NULL);
+
+    char* actual = component->toSBML();
+    char* full   = expected[count]->toSBML();
+    fail_unless(!strcmp(actual, full));
+    safe_free(actual);
+    safe_free(full);
+
+    delete component;
+    ++count;
+  }
+
+  fail_unless(count == expected.size());
+  fail_unless(reader.next() == NULL);
+
+  SBMLDocument* shell = reader.getDocument();
+  fail_unless(shell->getModel() != NULL);
+  fail_unless(shell->getModel()->getConversionFactor() == "p");
+  fail_unless(shell->getModel()->getNumSpecies() == 0);
+  fail_unless(shell->getModel()->getNumReactions() == 0);
+  fail_unless(getErrorIds(shell) == getErrorIds(d));
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_SBMLStreamReader_math)
+{
+  const char* s =
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "  <model id='m'>"
+    "    <listOfReactions>"
+    "      <reaction id='r' reversible='false' fast='false'>"
+    "        <annotation><x xmlns='http://example.org'/></annotation>"
+    "        <kineticLaw>"
+    "          <math xmlns='http://www.w3.org/1998/Math/MathML'>"
+    "            <apply><times/><ci> k </ci><ci> S </ci></apply>"
+    "          </math>"
+    "        </kineticLaw>"
+    "      </reaction>"
+    "    </listOfReactions>"
+    "  </model>"
+    "</sbml>";
+
+  SBMLStreamReader reader;
+  fail_unless(reader.openFromString(s) == true);
+
+  SBase* component = reader.next();
+  fail_unless(component != NULL);
+  fail_unless(component->getTypeCode() == SBML_REACTION);
+  fail_unless(component->isSetAnnotation());
+
+  Reaction* r = static_cast<Reaction*>(component);
+  fail_unless(r->isSetKineticLaw());
+  fail_unless(r->getKineticLaw()->getMath() != NULL);
+  fail_unless(r->getKineticLaw()->getFormula() == "k * S");
+
+  delete component;
+
+  fail_unless(reader.next() == NULL);
+  fail_unless(reader.getDocument()->getModel()->getId() == "m");
+  fail_unless(reader.getDocument()->getNumErrors() == 0);
+}
+END_TEST
+
+
+START_TEST (test_SBMLStreamReader_repeatedListOf)
+{
+  const char* s =
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    "  <model>"
+    "    <listOfParameters><parameter id='a' constant='true'/></listOfParameters>"
+    "    <listOfParameters><parameter id='b' constant='true'/></listOfParameters>"
+    "  </model>"
+    "</sbml>";
+
+  SBMLDocument* d = readSBMLFromString(s);
+
+  SBMLStreamReader reader;
+  fail_unless(reader.openFromString(s) == true);
+
+  SBase* a = reader.next();
+  SBase* b = reader.next();
+  fail_unless(a != NULL && a->getId() == "a");
+  fail_unless(b != NULL && b->getId() == "b");
+  fail_unless(reader.next() == NULL);
+  delete a;
+  delete b;
+
+  fail_unless(reader.getDocument()->getErrorLog()->contains(OneOfEachListOf));
+  fail_unless(reader.getDocument()->getModel()->getNumParameters() == 0);
+  fail_unless(getErrorIds(reader.getDocument()) == getErrorIds(d));
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_SBMLStreamReader_emptyListOf)
+{
+  const char* s =
+    "<sbml xmlns='http://www.sbml.org/sbml/level2/version4' level='2' version='4'>"
+    "  <model>"
+    "    <listOfCompartments><compartment id='c'/></listOfCompartments>"
+    "    <listOfSpecies/>"
+    "  </model>"
+    "</sbml>";
+
+  SBMLDocument* d = readSBMLFromString(s);
+
+  SBMLStreamReader reader;
+  fail_unless(reader.openFromString(s) == true);
+
+  SBase* c = reader.next();
+  fail_unless(c != NULL && c->getId() == "c");
+  fail_unless(reader.next() == NULL);
+  delete c;
+
+  fail_unless(reader.getDocument()->getErrorLog()->contains(EmptyListElement));
+  fail_unless(getErrorIds(reader.getDocument()) == getErrorIds(d));
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_SBMLStreamReader_L1)
+{
+  std::string filename(TestDataDirectory);
+  filename += "l1v1-branch.xml";
+
+  SBMLDocument* d = readSBML(filename.c_str());
+
+  SBMLStreamReader reader;
+  fail_unless(reader.open(filename) == true);
+
+  unsigned int count = 0;
+  while (SBase* component = reader.next())
+  {
+    delete component;
+    ++count;
+  }
+
+  fail_unless(count == 1 + 4 + 3);
+  fail_unless(getErrorIds(reader.getDocument()) == getErrorIds(d));
+  fail_unless(reader.getDocument()->getModel()->isSetNotes());
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_SBMLStreamReader_notSBML)
+{
+  std::string filename(TestDataDirectory);
+  filename += "not-sbml.xml";
+
+  SBMLStreamReader reader;
+  fail_unless(reader.getDocument() == NULL);
+  fail_unless(reader.next() == NULL);
+
+  fail_unless(reader.open(filename) == false);
+  fail_unless(reader.next() == NULL);
+  fail_unless(reader.getDocument()->getErrorLog()->contains(NotSchemaConformant));
+
+  filename = TestDataDirectory;
+  filename += "does-not-exist.xml";
+
+  fail_unless(reader.open(filename) == false);
+  fail_unless(reader.next() == NULL);
+  fail_unless(reader.getDocument()->getErrorLog()->contains(XMLFileUnreadable));
+
+  reader.close();
+  fail_unless(reader.getDocument() == NULL);
+}
+END_TEST
+
+
+START_TEST (test_SBMLStreamReader_close)
+{
+  std::string filename(TestDataDirectory);
+  filename += "l3v2-all.xml";
+
+  SBMLStreamReader reader;
+  fail_unless(reader.open(filename) == true);
+
+  SBase* component = reader.next();
+  fail_unless(component != NULL);
+  delete component;
+
+  // stop in the middle of the model, and start again
+  reader.close();
+  fail_unless(reader.getDocument() == NULL);
+  fail_unless(reader.next() == NULL);
+
+  fail_unless(reader.open(filename) == true);
+  component = reader.next();
+  fail_unless(component != NULL);
+  fail_unless(component->getTypeCode() == SBML_FUNCTION_DEFINITION);
+  delete component;
+}
+END_TEST
+
+
+Suite *
+create_suite_SBMLStreamReader (void)
+{
+  Suite *suite = suite_create("SBMLStreamReader");
+  TCase *tcase = tcase_create("SBMLStreamReader");
+
+
+  tcase_add_test(tcase, test_SBMLStreamReader_components);
+  tcase_add_test(tcase, test_SBMLStreamReader_math);
+  tcase_add_test(tcase, test_SBMLStreamReader_repeatedListOf);
+  tcase_add_test(tcase, test_SBMLStreamReader_emptyListOf);
+  tcase_add_test(tcase, test_SBMLStreamReader_L1);
+  tcase_add_test(tcase, test_SBMLStreamReader_notSBML);
+  tcase_add_test(tcase, test_SBMLStreamReader_close);
+
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
@@ -45,6 +45,8 @@
 #include <sbml/SBMLTypes.h>
 
 #include <sbml/SBMLTransforms.h>
+#include <sbml/math/CompiledMath.h>
+#include <sbml/math/NativeMath.h>
 #include <sbml/conversion/ConversionProperties.h>
 
 #include <check.h>
@@ -1031,6 +1033,270 @@ START_TEST(test_SBMLTransforms_multipleMaps)
 }
 END_TEST
 
+START_TEST(test_SBMLTransforms_compileMath)
+{
+  const char* formulas[] = {
+    "2 + x * 3.5 - y / 4", "-x", "x^y", "pow(y, 3)", "root(3, y)",
+    "abs(-x)", "arccos(x)", "arccosh(y)", "arccot(x)", "arccoth(y)",
+    "arccsc(y)", "arccsch(x)", "arcsec(y)", "arcsech(x)", "arcsin(x)",
+    "arcsinh(x)", "arctan(x)", "arctanh(x)", "ceil(y)", "cos(x)",
+    "cosh(x)", "cot(x)", "coth(x)", "csc(x)", "csch(x)", "exp(x)",
+    "factorial(y + 2)", "floor(y)", "ln(y)", "log(y)", "log(2, y)",
+    "sec(x)", "sech(x)", "sin(x)", "sinh(x)", "tan(x)", "tanh(x)",
+    "x && y", "x || 0", "xor(x, y)", "!x", "x == y", "x >= y",
+    "x < y < 3", "x <= y", "x > y", "x != y", "exponentiale * pi",
+    "true + false", "time + avogadro", "delay(x, 2)", "undefined(x)",
+    "piecewise(x, x < y, y)", "piecewise(x, x > y, y, x < y)",
+    "piecewise(x, x > y, y, x > 5)", "piecewise(x, x < y, y, x < 3)",
+    "x + z"
+  };
+
+  std::map<std::string, double> values;
+  values["x"] = 0.7;
+  values["y"] = 2.5;
+
+  CompiledMath compiled;
+  fail_unless(compiled.isCompiled() == false);
+  fail_unless(util_isNaN(compiled.evaluate(NULL)));
+  fail_unless(compiled.compile(NULL) == LIBSBML_INVALID_OBJECT);
+
+  for (size_t n = 0; n < sizeof(formulas) / sizeof(formulas[0]); ++n)
+  {
+    ASTNode* node = SBML_parseL3Formula(formulas[n]);
+    fail_unless(node != NULL);
+
+    IdList slots;
+    slots.append("y");
+    slots.append("x");
+    double array[] = { 2.5, 0.7 };
+
+    fail_unless(compiled.compile(node, slots) == LIBSBML_OPERATION_SUCCESS);
+    fail_unless(compiled.isCompiled() == true);
+
+    double expected = SBMLTransforms::evaluateASTNode(node, values);
+    double actual   = compiled.evaluate(array);
+
+    fail_unless(actual == expected
+                || (util_isNaN(actual) && util_isNaN(expected)));
+
+    delete node;
+  }
+
+  /* slots are assigned in order of first appearance */
+  ASTNode* node = SBML_parseL3Formula("b * sin(a) + b");
+  fail_unless(compiled.compile(node) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(compiled.getNumSlots() == 2);
+  fail_unless(compiled.getSlotId(0) == "b");
+  fail_unless(compiled.getSlotId(1) == "a");
+  fail_unless(compiled.getSlotId(2) == "");
+  fail_unless(compiled.getSlotIndex("a") == 1);
+  fail_unless(compiled.getSlotIndex("c") == -1);
+
+  CompiledMath copy(compiled);
+  double array[] = { 2, 0 };
+  for (int i = 0; i < 10; ++i)
+  {
+    array[1] = 0.1 * i;
+    fail_unless(copy.evaluate(array) == 2 * sin(0.1 * i) + 2);
+  }
+  delete node;
+}
+END_TEST
+
+
+START_TEST(test_SBMLTransforms_compileMathWithFunctions)
+{
+  SBMLReader reader;
+  std::string filename(TestDataDirectory);
+  filename += "multiple-functions.xml";
+
+  SBMLDocument* d = reader.readSBML(filename);
+  Model* m = d->getModel();
+
+  std::map<std::string, double> values;
+  values["S1"] = 2;
+  values["p"] = 3;
+  values["compartmentOne"] = 5;
+  values["t"] = 7;
+
+  IdList slots;
+  for (std::map<std::string, double>::iterator it = values.begin();
+       it != values.end(); ++it)
+  {
+    slots.append(it->first);
+  }
+
+  CompiledMath compiled;
+  for (unsigned int n = 0; n <= m->getNumReactions(); ++n)
+  {
+    const ASTNode* math = (n < m->getNumReactions())
+                        ? m->getReaction(n)->getKineticLaw()->getMath()
+                        : m->getInitialAssignment(0)->getMath();
+
+    fail_unless(compiled.compile(math, slots, m) == LIBSBML_OPERATION_SUCCESS);
+
+    double array[4];
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      array[i] = values[compiled.getSlotId(i)];
+    }
+
+    fail_unless(compiled.evaluate(array)
+                == SBMLTransforms::evaluateASTNode(math, values, m));
+
+    NativeMath native;
+    fail_unless(native.compile(math, slots, m) == LIBSBML_OPERATION_SUCCESS);
+    fail_unless(native.evaluate(array) == compiled.evaluate(array));
+  }
+
+  /* without the model the function definitions are unknown */
+  fail_unless(compiled.compile(m->getReaction(0)->getKineticLaw()->getMath(),
+                               slots) == LIBSBML_OPERATION_SUCCESS);
+  double array[4] = { 1, 1, 1, 1 };
+  fail_unless(util_isNaN(compiled.evaluate(array)));
+
+  /* recursive function definitions cannot be inlined */
+  FunctionDefinition* fd = m->createFunctionDefinition();
+  fd->setId("h");
+  ASTNode* lambda = SBML_parseL3Formula("lambda(x, h(x) + 1)");
+  fd->setMath(lambda);
+  delete lambda;
+
+  ASTNode* node = SBML_parseL3Formula("h(2)");
+  fail_unless(compiled.compile(node, m) == LIBSBML_OPERATION_FAILED);
+  fail_unless(compiled.isCompiled() == false);
+  delete node;
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST(test_SBMLTransforms_nativeMath)
+{
+  const char* formulas[] = {
+    "2 + x * 3.5 - y / 4", "-x", "-(x - x)", "x^y", "root(3, y)",
+    "exp(x) + ln(y) + log(2, y)", "factorial(y + 2)", "cos(x) * sech(y)",
+    "x && y", "x || 0", "xor(x, y)", "!x", "x == y", "x >= y",
+    "x < y < 3", "x <= y", "x > y", "x != y", "x == y == x",
+    "piecewise(x, x < y, y)", "piecewise(x, x > y, y, x < y)",
+    "piecewise(x, x > y, y, x > 5)", "piecewise(x, x < y, y, x < 3)",
+    "piecewise(x, x < y, x, y < 3, 1)", "piecewise(x)",
+    "time + avogadro", "x + z", "max(2, 3) + x"
+  };
+
+  /* includes signed zeros, NaN and equal values */
+  double arrays[][2] = {
+    { 2.5, 0.7 }, { 0, 0 }, { -0.0, 1 }, { 1, 0 }, { 3, 3 },
+    { util_NaN(), 1 }, { 1, util_NaN() }, { -2, 4 }
+  };
+
+  NativeMath native;
+  CompiledMath compiled;
+  fail_unless(native.isCompiled() == false);
+  fail_unless(native.isNative() == false);
+  fail_unless(util_isNaN(native.evaluate(NULL)));
+  fail_unless(native.compile(NULL) == LIBSBML_INVALID_OBJECT);
+
+  IdList slots;
+  slots.append("y");
+  slots.append("x");
+
+  for (size_t n = 0; n < sizeof(formulas) / sizeof(formulas[0]); ++n)
+  {
+    ASTNode* node = SBML_parseL3Formula(formulas[n]);
+    fail_unless(node != NULL);
+
+    fail_unless(native.compile(node, slots) == LIBSBML_OPERATION_SUCCESS);
+    fail_unless(native.isCompiled() == true);
+    fail_unless(native.getNumSlots() == 2);
+
+    /* constructs of packages are left to the interpreter */
+    bool interpreted =
+      (compiled.compile(node, slots) != LIBSBML_OPERATION_SUCCESS);
+    fail_unless(!interpreted || !native.isNative());
+
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); ++i)
+    {
+      std::map<std::string, double> values;
+      values["y"] = arrays[i][0];
+      values["x"] = arrays[i][1];
+
+      double expected = interpreted
+                      ? SBMLTransforms::evaluateASTNode(node, values)
+                      : compiled.evaluate(arrays[i]);
+      double actual   = native.evaluate(arrays[i]);
+
+      fail_unless((actual == expected
+                   && util_isNegZero(actual) == util_isNegZero(expected))
+                  || (util_isNaN(actual) && util_isNaN(expected)));
+    }
+
+    delete node;
+  }
+
+  /* slots are assigned in order of first appearance, also when the
+   * expression is interpreted */
+  ASTNode* node = SBML_parseL3Formula("max(b * sin(a), b)");
+  fail_unless(native.compile(node) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(native.isNative() == false);
+  fail_unless(native.getNumSlots() == 2);
+  fail_unless(native.getSlotId(0) == "b");
+  fail_unless(native.getSlotIndex("a") == 1);
+  delete node;
+
+  node = SBML_parseL3Formula("b * sin(a) + b");
+  fail_unless(native.compile(node) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(native.getSlotId(0) == "b");
+  fail_unless(native.getSlotIndex("a") == 1);
+
+  NativeMath copy(native);
+  fail_unless(copy.isNative() == native.isNative());
+  double array[] = { 2, 0 };
+  for (int i = 0; i < 10; ++i)
+  {
+    array[1] = 0.1 * i;
+    fail_unless(copy.evaluate(array) == 2 * sin(0.1 * i) + 2);
+  }
+  delete node;
+}
+END_TEST
+
+
+START_TEST(test_SBMLTransforms_nativeMathCache)
+{
+  std::string previous = NativeMath::getCodeCacheDirectory();
+  NativeMath::setCodeCacheDirectory(".");
+  fail_unless(NativeMath::getCodeCacheDirectory() == ".");
+
+  ASTNode* node = SBML_parseL3Formula("x^y + 2 * sin(x) - root(3, y)");
+  IdList slots;
+  slots.append("x");
+  slots.append("y");
+
+  /* the second object loads the code the first one stored */
+  NativeMath first;
+  fail_unless(first.compile(node, slots) == LIBSBML_OPERATION_SUCCESS);
+  NativeMath second;
+  fail_unless(second.compile(node, slots) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(second.isNative() == first.isNative());
+
+  CompiledMath compiled;
+  fail_unless(compiled.compile(node, slots) == LIBSBML_OPERATION_SUCCESS);
+
+  for (int i = 1; i < 10; ++i)
+  {
+    double array[] = { 0.3 * i, 0.7 * i };
+    fail_unless(first.evaluate(array) == compiled.evaluate(array));
+    fail_unless(second.evaluate(array) == compiled.evaluate(array));
+  }
+
+  NativeMath::setCodeCacheDirectory(previous);
+  delete node;
+}
+END_TEST
+
+
 Suite *
 create_suite_SBMLTransforms (void)
 {
@@ -1050,6 +1316,10 @@ create_suite_SBMLTransforms (void)
   tcase_add_test(tcase, test_SBMLTransforms_L3V2AssignmentNoMath);
   tcase_add_test(tcase, test_SBMLTransforms_StoichiometryMath);
 	tcase_add_test(tcase, test_SBMLTransforms_multipleMaps);
+  tcase_add_test(tcase, test_SBMLTransforms_compileMath);
+  tcase_add_test(tcase, test_SBMLTransforms_compileMathWithFunctions);
+  tcase_add_test(tcase, test_SBMLTransforms_nativeMath);
+  tcase_add_test(tcase, test_SBMLTransforms_nativeMathCache);
 
 
   suite_add_tcase(suite, tcase);
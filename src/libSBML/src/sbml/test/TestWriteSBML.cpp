@@ -39,6 +39,7 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -3107,6 +3108,60 @@ START_TEST (test_WriteSBML_zip)
 END_TEST
 #endif
 
+
+#if defined(USE_ZLIB) || defined(USE_BZ2)
+/*
+ * Writes the first model of the spec examples to the given compressed
+ * file, cuts the file in half and checks that reading it reports the file
+ * as unreadable rather than parsing what could be decompressed.
+ */
+static void
+checkTruncatedFile (const char* filename)
+{
+  SBMLDocument* d = readSBML("../../../examples/sample-models/from-spec/level-2/algebraicrules.xml");
+  fail_unless( d != NULL );
+  fail_unless( writeSBML(d, filename) );
+  delete d;
+
+  std::string content;
+  {
+    std::ifstream in(filename, std::ios::binary);
+    std::ostringstream oss;
+    oss << in.rdbuf();
+    content = oss.str();
+  }
+  fail_unless( content.size() > 100 );
+
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), (std::streamsize) content.size() / 2);
+  }
+
+  d = readSBML(filename);
+  fail_unless( d != NULL );
+  fail_unless( d->getErrorLog()->contains(XMLFileUnreadable) );
+  delete d;
+}
+#endif
+
+
+#ifdef USE_ZLIB
+START_TEST (test_WriteSBML_gzip_truncated)
+{
+  checkTruncatedFile("test-truncated.xml.gz");
+}
+END_TEST
+#endif
+
+
+#ifdef USE_BZ2
+START_TEST (test_WriteSBML_bzip2_truncated)
+{
+  checkTruncatedFile("test-truncated.xml.bz2");
+}
+END_TEST
+#endif
+
 START_TEST (test_WriteSBML_elements_L1v2)
 {
   D->setLevelAndVersion(1, 2, false);
@@ -3450,12 +3505,14 @@ create_suite_WriteSBML ()
 #ifdef USE_ZLIB 
 #ifndef LIBSBML_USE_VLD
   tcase_add_test( tcase, test_WriteSBML_gzip  );
+  tcase_add_test( tcase, test_WriteSBML_gzip_truncated  );
   tcase_add_test( tcase, test_WriteSBML_zip  );
 #endif
 #endif
 #ifdef USE_BZ2
 #ifndef LIBSBML_USE_VLD
   tcase_add_test( tcase, test_WriteSBML_bzip2  );
+  tcase_add_test( tcase, test_WriteSBML_bzip2_truncated  );
 #endif
 #endif
 
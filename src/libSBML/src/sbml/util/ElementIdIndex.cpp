@@ -0,0 +1,557 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ElementIdIndex.cpp
+ * @brief   Hash index from SIds and metaids to the elements of a Model.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/util/ElementIdIndex.h>
+#include <sbml/util/List.h>
+#include <sbml/Model.h>
+#include <sbml/ListOf.h>
+#include <sbml/SBase.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * The linear search does not match the ids of these elements, since they
+ * are not in the SId namespace (see for example
+ * ListOfUnitDefinitions::getElementBySId); they are only indexed by metaid.
+ */
+static bool
+isInSIdNamespace(const SBase* element)
+{
+  const string& pkg = element->getPackageName();
+
+  if (pkg == "core")
+  {
+    switch (element->getTypeCode())
+    {
+    case SBML_UNIT_DEFINITION:
+    case SBML_INITIAL_ASSIGNMENT:
+    case SBML_ALGEBRAIC_RULE:
+    case SBML_ASSIGNMENT_RULE:
+    case SBML_RATE_RULE:
+    case SBML_EVENT_ASSIGNMENT:
+    case SBML_LOCAL_PARAMETER:
+      return false;
+    default:
+      return true;
+    }
+  }
+
+  if (pkg == "comp" && element->getElementName() == "port")
+  {
+    return false;
+  }
+
+  return true;
+}
+
+
+ElementIdIndex::ElementIdIndex(Model* model)
+  : mModel (model)
+  , mValid (false)
+  , mBuilding (false)
+{
+}
+
+
+SBase*
+ElementIdIndex::getElementBySId(const std::string& id, bool* unique)
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+  if (!mValid)
+  {
+    build();
+  }
+
+  IdMap::const_iterator it = mIds.find(id);
+  if (it != mIds.end() && !(it->second->getId() == id && isReachable(it->second)))
+  {
+    // an element left the model behind our back
+    build();
+    it = mIds.find(id);
+  }
+
+  if (unique != NULL)
+  {
+    *unique = (mDuplicateIds.find(id) == mDuplicateIds.end());
+  }
+
+  return (it != mIds.end()) ? it->second : NULL;
+}
+
+
+SBase*
+ElementIdIndex::getElementByMetaId(const std::string& metaid)
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+  if (!mValid)
+  {
+    build();
+  }
+
+  IdMap::const_iterator it = mMetaIds.find(metaid);
+  if (it != mMetaIds.end() &&
+      !(it->second->getMetaId() == metaid && isReachable(it->second)))
+  {
+    build();
+    it = mMetaIds.find(metaid);
+  }
+
+  return (it != mMetaIds.end()) ? it->second : NULL;
+}
+
+
+void
+ElementIdIndex::invalidate()
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+  clear();
+}
+
+
+void
+ElementIdIndex::elementChanged(SBase* element)
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+  if (!mValid)
+  {
+    return;
+  }
+
+  if (mEntries.find(element) == mEntries.end())
+  {
+    return;
+  }
+
+  addElement(element, isInSIdNamespace(element), true);
+}
+
+
+void
+ElementIdIndex::elementAdded(SBase* element, SBase* parent)
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+  if (!mValid)
+  {
+    return;
+  }
+
+  ListOf* list = dynamic_cast<ListOf*>(parent);
+
+  EntryMap::const_iterator entry = mEntries.find(element);
+  if (entry != mEntries.end() &&
+      (list == NULL || list->get(entry->second.position) == element))
+  {
+    // connected again, e.g. by connectToChild of its parent
+    return;
+  }
+
+  if (list != NULL)
+  {
+    const unsigned int size = list->size();
+    if (size > 0 && list->get(size - 1) == element)
+    {
+      mEntries[element].position = size - 1;
+    }
+    else
+    {
+      // inserted, the following siblings moved down by one
+      recordPositions(list, 0);
+    }
+  }
+
+  addSubtree(element);
+}
+
+
+void
+ElementIdIndex::elementRemoved(ListOf* list, unsigned int n, SBase* element)
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+  if (!mValid)
+  {
+    return;
+  }
+
+  eraseSubtree(element);
+
+  // the following siblings moved up by one
+  if (mValid)
+  {
+    recordPositions(list, n);
+  }
+}
+
+
+void
+ElementIdIndex::elementMoved(SBase* element)
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+  if (!mValid)
+  {
+    return;
+  }
+
+  eraseSubtree(element);
+}
+
+
+void
+ElementIdIndex::forgetElement(const SBase* element)
+{
+  std::lock_guard<std::recursive_mutex> lock(mMutex);
+  if (!mValid)
+  {
+    return;
+  }
+
+  eraseElement(element);
+}
+
+
+/*
+ * Empty ListOf objects are not indexed (getAllElements leaves them out), so
+ * this walks up until it finds an indexed element or the model itself.  The
+ * walk ends at the document, which is its own parent.
+ */
+std::shared_ptr<ElementIdIndex>
+ElementIdIndex::findIndex(SBase* parent)
+{
+  SBase* element = parent;
+  while (element != NULL)
+  {
+    std::shared_ptr<ElementIdIndex> index = element->mElementIdIndex.lock();
+    if (index)
+    {
+      return index;
+    }
+
+    Model* model = dynamic_cast<Model*>(element);
+    if (model != NULL)
+    {
+      return model->mIdIndex;
+    }
+
+    SBase* next = element->getParentSBMLObject();
+    element = (next != element) ? next : NULL;
+  }
+
+  return std::shared_ptr<ElementIdIndex>();
+}
+
+
+/*
+ * Walks the model in the order used by Model::getElementBySId and
+ * Model::getElementByMetaId, so that the first element wins just like it
+ * does in the linear search.
+ */
+void
+ElementIdIndex::build()
+{
+  clear();
+  mBuilding = true;
+
+  ListOf* lists[] = {
+    mModel->getListOfFunctionDefinitions(),
+    mModel->getListOfUnitDefinitions(),
+    mModel->getListOfCompartmentTypes(),
+    mModel->getListOfSpeciesTypes(),
+    mModel->getListOfCompartments(),
+    mModel->getListOfSpecies(),
+    mModel->getListOfParameters(),
+    mModel->getListOfReactions(),
+    mModel->getListOfInitialAssignments(),
+    mModel->getListOfRules(),
+    mModel->getListOfConstraints(),
+    mModel->getListOfEvents()
+  };
+  const unsigned int numLists = sizeof(lists) / sizeof(lists[0]);
+
+  // getElementByMetaId looks at the reactions after the constraints
+  const unsigned int metaIdOrder[] = { 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 7, 11 };
+
+  List* elements[numLists];
+  for (unsigned int i = 0; i < numLists; ++i)
+  {
+    elements[i] = lists[i]->getAllElements();
+  }
+  List* pluginElements = mModel->getAllElementsFromPlugins();
+
+  for (unsigned int i = 0; i < numLists; ++i)
+  {
+    addElement(lists[i], false, false);
+    addIds(elements[i]);
+  }
+  addIds(pluginElements);
+
+  for (unsigned int i = 0; i < numLists; ++i)
+  {
+    addMetaId(lists[metaIdOrder[i]]);
+  }
+  for (unsigned int i = 0; i < numLists; ++i)
+  {
+    addMetaIds(elements[metaIdOrder[i]]);
+  }
+  addMetaIds(pluginElements);
+
+  for (unsigned int i = 0; i < numLists; ++i)
+  {
+    delete elements[i];
+  }
+  delete pluginElements;
+
+  mBuilding = false;
+  mValid = true;
+}
+
+
+void
+ElementIdIndex::clear()
+{
+  mIds.clear();
+  mMetaIds.clear();
+  mDuplicateIds.clear();
+  mDuplicateMetaIds.clear();
+  mEntries.clear();
+  mValid = false;
+}
+
+
+/*
+ * Both maps only ever point to an element under the key recorded in its
+ * entry, so that forgetElement can remove it without looking at the
+ * (possibly already destroyed) element itself.
+ *
+ * While the index is built, the first element with a key wins, as in the
+ * linear search.  Afterwards only the linear search can tell which of two
+ * elements with the same key comes first, so a second one drops the index.
+ */
+void
+ElementIdIndex::addKey(IdMap& ids, IdSet& duplicates, std::string& key,
+                       const std::string& newKey, SBase* element)
+{
+  if (key == newKey) return;
+
+  eraseKey(ids, duplicates, key, element);
+  if (!mValid && !mBuilding) return;
+
+  key = newKey;
+  if (newKey.empty()) return;
+
+  if (!ids.insert(make_pair(newKey, element)).second)
+  {
+    if (!mBuilding)
+    {
+      clear();
+      return;
+    }
+    duplicates.insert(newKey);
+  }
+}
+
+
+void
+ElementIdIndex::eraseKey(IdMap& ids, const IdSet& duplicates,
+                         const std::string& key, const SBase* element)
+{
+  if (key.empty()) return;
+
+  IdMap::iterator it = ids.find(key);
+  if (it == ids.end() || it->second != element) return;
+
+  if (duplicates.find(key) != duplicates.end())
+  {
+    // another element with the key takes over, see addKey
+    clear();
+    return;
+  }
+  ids.erase(it);
+}
+
+
+void
+ElementIdIndex::addId(SBase* element)
+{
+  const string id = element->isSetId() ? element->getId() : string();
+  addKey(mIds, mDuplicateIds, mEntries[element].id, id, element);
+}
+
+
+void
+ElementIdIndex::addMetaId(SBase* element)
+{
+  addKey(mMetaIds, mDuplicateMetaIds, mEntries[element].metaid,
+         element->getMetaId(), element);
+}
+
+
+void
+ElementIdIndex::addElement(SBase* element, bool withId, bool withMetaId)
+{
+  element->mElementIdIndex = shared_from_this();
+
+  EntryMap::iterator entry = mEntries.find(element);
+  if (entry == mEntries.end() || entry->second.position == NO_POSITION)
+  {
+    ListOf* list = dynamic_cast<ListOf*>(element->getParentSBMLObject());
+    if (list != NULL)
+    {
+      recordPositions(list, 0);
+    }
+  }
+
+  if (withId)     addId(element);
+  if (withMetaId) addMetaId(element);
+}
+
+
+void
+ElementIdIndex::addSubtree(SBase* element)
+{
+  addElement(element, isInSIdNamespace(element), true);
+
+  List* elements = element->getAllElements();
+  for (ListIterator it = elements->begin(); it != elements->end() && mValid; ++it)
+  {
+    SBase* child = static_cast<SBase*>(*it);
+    addElement(child, isInSIdNamespace(child), true);
+  }
+  delete elements;
+}
+
+
+void
+ElementIdIndex::eraseSubtree(SBase* element)
+{
+  eraseElement(element);
+  element->mElementIdIndex.reset();
+
+  List* elements = element->getAllElements();
+  for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+  {
+    SBase* child = static_cast<SBase*>(*it);
+    eraseElement(child);
+    child->mElementIdIndex.reset();
+  }
+  delete elements;
+}
+
+
+/*
+ * List::get is linear, so the element lists are always walked with an
+ * iterator.
+ */
+void
+ElementIdIndex::addIds(List* elements)
+{
+  for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+  {
+    SBase* element = static_cast<SBase*>(*it);
+    addElement(element, isInSIdNamespace(element), false);
+  }
+}
+
+
+void
+ElementIdIndex::addMetaIds(List* elements)
+{
+  for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+  {
+    addMetaId(static_cast<SBase*>(*it));
+  }
+}
+
+
+void
+ElementIdIndex::recordPositions(ListOf* list, unsigned int start)
+{
+  for (unsigned int n = start; n < list->size(); ++n)
+  {
+    mEntries[list->get(n)].position = n;
+  }
+}
+
+
+/*
+ * An element is still part of the model, if the chain of parents leads
+ * to the model and every ListOf on the way still holds the child at the
+ * recorded position.  Elements removed from a ListOf without telling us
+ * fail this test.
+ */
+bool
+ElementIdIndex::isReachable(const SBase* element) const
+{
+  const SBase* child = element;
+  while (child != mModel)
+  {
+    const SBase* parent = child->getParentSBMLObject();
+    if (parent == NULL || parent == child)
+    {
+      return false;
+    }
+
+    const ListOf* list = dynamic_cast<const ListOf*>(parent);
+    if (list != NULL)
+    {
+      EntryMap::const_iterator entry = mEntries.find(child);
+      if (entry == mEntries.end() || entry->second.position == NO_POSITION ||
+          list->get(entry->second.position) != child)
+      {
+        return false;
+      }
+    }
+
+    child = parent;
+  }
+
+  return true;
+}
+
+
+void
+ElementIdIndex::eraseElement(const SBase* element)
+{
+  if (!mValid)
+  {
+    return;
+  }
+
+  EntryMap::iterator entry = mEntries.find(element);
+  if (entry == mEntries.end())
+  {
+    return;
+  }
+
+  eraseKey(mIds, mDuplicateIds, entry->second.id, element);
+  if (!mValid) return;
+  eraseKey(mMetaIds, mDuplicateMetaIds, entry->second.metaid, element);
+  if (!mValid) return;
+
+  mEntries.erase(entry);
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,189 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ElementIdIndex.h
+ * @brief   Hash index from SIds and metaids to the elements of a Model.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class ElementIdIndex
+ * @sbmlbrief{core} Hash index used by Model::getElementBySId and
+ * Model::getElementByMetaId.
+ *
+ * The index is built lazily on the first lookup by walking the model in the
+ * same order as the linear search it replaces.  Every indexed element keeps
+ * a weak reference to the index, so that the setId and setMetaId methods,
+ * SBase::connectToParent, ListOf::remove and the SBase destructor keep it
+ * up to date, and a miss is final.
+ *
+ * Elements that leave a ListOf without going through ListOf::remove (some
+ * package classes erase from mItems directly) are caught when they are
+ * looked up: every hit must still carry the identifier and still be
+ * reachable from the model, each ListOf on the way up holding it at the
+ * recorded position.  A stale hit rebuilds the index.
+ *
+ * Identifiers carried by more than one element (in invalid models, or in
+ * packages with their own identifier scopes) are looked up in the order of
+ * the linear search only when the index is built; adding, renaming or
+ * removing such an element drops the index instead.
+ */
+
+#ifndef ElementIdIndex_h
+#define ElementIdIndex_h
+
+
+#ifdef __cplusplus
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <sbml/common/extern.h>
+#include <sbml/common/libsbml-namespace.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class SBase;
+class ListOf;
+class Model;
+class List;
+
+class LIBSBML_EXTERN ElementIdIndex
+  : public std::enable_shared_from_this<ElementIdIndex>
+{
+public:
+
+  /**
+   * Creates a new (empty, not yet built) index for the given model.
+   */
+  ElementIdIndex(Model* model);
+
+
+  /**
+   * Returns the first element of the model with the given SId, or @c NULL
+   * if there is none.  If @p unique is given, it is set to whether no other
+   * element has the same SId.
+   */
+  SBase* getElementBySId(const std::string& id, bool* unique = NULL);
+
+
+  /**
+   * Returns the first element of the model with the given metaid, or
+   * @c NULL if there is none.
+   */
+  SBase* getElementByMetaId(const std::string& metaid);
+
+
+  /**
+   * Marks the index as out of date; it will be rebuilt on the next lookup.
+   */
+  void invalidate();
+
+
+  /**
+   * Called when the given (indexed) element changed its id or metaid.
+   */
+  void elementChanged(SBase* element);
+
+
+  /**
+   * Called when the given element was connected to @p parent; adds the
+   * element and its descendants to the index.
+   */
+  void elementAdded(SBase* element, SBase* parent);
+
+
+  /**
+   * Called when the element at position @p n was removed from @p list;
+   * removes the element and its descendants from the index.
+   */
+  void elementRemoved(ListOf* list, unsigned int n, SBase* element);
+
+
+  /**
+   * Called when the given element moves to another model; removes the
+   * element and its descendants from the index.
+   */
+  void elementMoved(SBase* element);
+
+
+  /**
+   * Called when the given element is destroyed.
+   */
+  void forgetElement(const SBase* element);
+
+
+  /**
+   * Returns the index of the model that @p parent is part of, or an empty
+   * pointer if it is not part of a model.
+   */
+  static std::shared_ptr<ElementIdIndex> findIndex(SBase* parent);
+
+
+private:
+
+  struct Entry
+  {
+    Entry() : position(NO_POSITION) {}
+
+    unsigned int position;
+    std::string  id;
+    std::string  metaid;
+  };
+
+  static const unsigned int NO_POSITION = (unsigned int)-1;
+
+  typedef std::unordered_map<std::string, SBase*>   IdMap;
+  typedef std::unordered_map<const SBase*, Entry>   EntryMap;
+  typedef std::unordered_set<std::string>           IdSet;
+
+  void build();
+  void clear();
+  void addKey(IdMap& ids, IdSet& duplicates, std::string& key,
+              const std::string& newKey, SBase* element);
+  void eraseKey(IdMap& ids, const IdSet& duplicates, const std::string& key,
+                const SBase* element);
+  void addId(SBase* element);
+  void addMetaId(SBase* element);
+  void addElement(SBase* element, bool withId, bool withMetaId);
+  void addSubtree(SBase* element);
+  void eraseSubtree(SBase* element);
+  void addIds(List* elements);
+  void addMetaIds(List* elements);
+  void recordPositions(ListOf* list, unsigned int start);
+  bool isReachable(const SBase* element) const;
+  void eraseElement(const SBase* element);
+
+  Model*     mModel;
+  bool       mValid;
+  bool       mBuilding;
+  IdMap      mIds;
+  IdMap      mMetaIds;
+  IdSet      mDuplicateIds;
+  IdSet      mDuplicateMetaIds;
+  EntryMap   mEntries;
+  std::recursive_mutex mMutex;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ElementIdIndex_h */
+
+/** @endcond */
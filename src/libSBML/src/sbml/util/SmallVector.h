@@ -0,0 +1,191 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    SmallVector.h
+ * @brief   Contiguous sequence with room for a few elements inline.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SmallVector
+ * @sbmlbrief{core} Contiguous sequence with room for N elements inline.
+ *
+ * A SmallVector stores up to N elements inside the object itself and only
+ * allocates (and from then on grows geometrically) when more are added.
+ * It is meant for the children of ASTNode objects, most of which have no
+ * more than two, and therefore only supports trivially copyable element
+ * types such as pointers: elements are moved with memmove and are never
+ * constructed or destroyed.
+ */
+
+#ifndef SmallVector_h
+#define SmallVector_h
+
+
+#ifdef __cplusplus
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <sbml/common/libsbml-namespace.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+template <typename T, unsigned int N>
+class SmallVector
+{
+public:
+
+  SmallVector () : mData(mInline), mSize(0), mCapacity(N) { }
+
+
+  SmallVector (const SmallVector& orig)
+    : mData(mInline), mSize(0), mCapacity(N)
+  {
+    *this = orig;
+  }
+
+
+  ~SmallVector ()
+  {
+    if (mData != mInline) free(mData);
+  }
+
+
+  SmallVector& operator= (const SmallVector& rhs)
+  {
+    if (&rhs != this)
+    {
+      mSize = 0;
+      reserve(rhs.mSize);
+      if (rhs.mSize > 0) memcpy(mData, rhs.mData, rhs.mSize * sizeof(T));
+      mSize = rhs.mSize;
+    }
+    return *this;
+  }
+
+
+  unsigned int size () const { return mSize; }
+
+  bool empty () const { return mSize == 0; }
+
+  T&       operator[] (unsigned int n)       { return mData[n]; }
+  const T& operator[] (unsigned int n) const { return mData[n]; }
+
+  T*       begin ()       { return mData; }
+  const T* begin () const { return mData; }
+  T*       end   ()       { return mData + mSize; }
+  const T* end   () const { return mData + mSize; }
+
+
+  /*
+   * Appends the item, which may be an element of this SmallVector: it is
+   * copied before the storage is reallocated.
+   */
+  void push_back (const T& item)
+  {
+    const T copy = item;
+    if (mSize == mCapacity) reserve(2 * mCapacity);
+    mData[mSize++] = copy;
+  }
+
+
+  /*
+   * Inserts the item before position n (n <= size()).  As for push_back(),
+   * the item may be an element of this SmallVector.
+   */
+  void insert (unsigned int n, const T& item)
+  {
+    const T copy = item;
+    if (mSize == mCapacity) reserve(2 * mCapacity);
+    memmove(mData + n + 1, mData + n, (mSize - n) * sizeof(T));
+    mData[n] = copy;
+    ++mSize;
+  }
+
+
+  /*
+   * Removes and returns the item at position n (n < size()).
+   */
+  T erase (unsigned int n)
+  {
+    T item = mData[n];
+    memmove(mData + n, mData + n + 1, (mSize - n - 1) * sizeof(T));
+    --mSize;
+    return item;
+  }
+
+
+  void clear () { mSize = 0; }
+
+
+  /*
+   * Exchanges the contents of this SmallVector with the given one.  The
+   * storage itself is exchanged when neither uses the inline elements.
+   */
+  void swap (SmallVector& other)
+  {
+    if (mData != mInline && other.mData != other.mInline)
+    {
+      T* data = mData;
+      mData = other.mData;
+      other.mData = data;
+
+      unsigned int size = mSize;
+      mSize = other.mSize;
+      other.mSize = size;
+
+      unsigned int capacity = mCapacity;
+      mCapacity = other.mCapacity;
+      other.mCapacity = capacity;
+      return;
+    }
+
+    SmallVector tmp(other);
+    other = *this;
+    *this = tmp;
+  }
+
+
+  void reserve (unsigned int capacity)
+  {
+    if (capacity <= mCapacity) return;
+
+    T* data = static_cast<T*>(malloc(capacity * sizeof(T)));
+    if (data == NULL) throw std::bad_alloc();
+
+    if (mSize > 0) memcpy(data, mData, mSize * sizeof(T));
+    if (mData != mInline) free(mData);
+
+    mData     = data;
+    mCapacity = capacity;
+  }
+
+
+private:
+
+  T*           mData;
+  unsigned int mSize;
+  unsigned int mCapacity;
+  T            mInline[N];
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SmallVector_h */
+/** @endcond */
@@ -0,0 +1,632 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ReadTimeConsistencyValidator.cpp
+ * @brief   Applies the checks of the SBML reader to a model in memory
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef doxygen_ignore
+
+#include <sstream>
+
+#include <sbml/validator/ReadTimeConsistencyValidator.h>
+
+#include <sbml/SBMLDocument.h>
+#include <sbml/SBMLErrorLog.h>
+#include <sbml/SBMLReader.h>
+#include <sbml/Model.h>
+#include <sbml/ListOf.h>
+#include <sbml/Compartment.h>
+#include <sbml/Species.h>
+#include <sbml/Parameter.h>
+#include <sbml/UnitDefinition.h>
+#include <sbml/Unit.h>
+#include <sbml/InitialAssignment.h>
+#include <sbml/Rule.h>
+#include <sbml/Reaction.h>
+#include <sbml/SpeciesReference.h>
+#include <sbml/ModifierSpeciesReference.h>
+#include <sbml/KineticLaw.h>
+#include <sbml/Event.h>
+#include <sbml/Trigger.h>
+#include <sbml/EventAssignment.h>
+#include <sbml/util/List.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Returns the element name used in the messages of the reader, together
+ * with the id of the element if it has one.
+ */
+static string
+describe (const SBase& object)
+{
+  string elplusid = "<" + object.getElementName() + ">";
+  if (!object.getId().empty())
+  {
+    elplusid += " with the id '" + object.getId() + "'";
+  }
+  return elplusid;
+}
+
+
+/*
+ * Initializes this Validator; the checks are hard-coded in validate().
+ */
+void
+ReadTimeConsistencyValidator::init ()
+{
+}
+
+
+/*
+ * Walks the document in the order in which the reader would encounter
+ * the elements.  The checks on the document structure are the ones the
+ * reader performs once the whole document has been parsed.
+ */
+unsigned int
+ReadTimeConsistencyValidator::validate (const SBMLDocument& d)
+{
+  const Model* m = d.getModel();
+
+  if (m != NULL)
+  {
+    List* elements = const_cast<Model*>(m)->getAllElements();
+
+    // a ListOf the reader will find empty; the error is logged once all of
+    // its children have been seen
+    const ListOf* emptied = NULL;
+
+    for (ListIterator it = elements->begin(); it != elements->end(); ++it)
+    {
+      const SBase* object = static_cast<const SBase*>(*it);
+
+      if (emptied != NULL && object->getParentSBMLObject() != emptied)
+      {
+        logFailure(SBMLError(EmptyListElement, emptied->getLevel(),
+          emptied->getVersion(), "", emptied->getLine(), emptied->getColumn()));
+        emptied = NULL;
+      }
+
+      // only the core elements are checked by the reader of this validator
+      if (object->getPackageName() != "core")
+      {
+        continue;
+      }
+
+      if (object->getTypeCode() == SBML_LIST_OF)
+      {
+        const ListOf* list = static_cast<const ListOf*>(object);
+        if (isEmptiedByWriter(*list))
+        {
+          emptied = list;
+        }
+      }
+      else
+      {
+        checkElement(*object);
+      }
+    }
+
+    if (emptied != NULL)
+    {
+      logFailure(SBMLError(EmptyListElement, emptied->getLevel(),
+        emptied->getVersion(), "", emptied->getLine(), emptied->getColumn()));
+    }
+
+    delete elements;
+  }
+
+  checkModel(d);
+
+  return (unsigned int)getFailures().size();
+}
+
+
+/*
+ * The checks of SBMLReader::readInternal on the model as a whole.
+ */
+void
+ReadTimeConsistencyValidator::checkModel (const SBMLDocument& d)
+{
+  SBMLErrorLog log;
+  SBMLReader::checkModel(&d, &log);
+
+  for (unsigned int n = 0; n < log.getNumErrors(); ++n)
+  {
+    logFailure(*log.getError(n));
+  }
+}
+
+
+void
+ReadTimeConsistencyValidator::checkElement (const SBase& object)
+{
+  if (isDroppedByWriter(object))
+  {
+    ostringstream msg;
+    msg << "Element '" << object.getElementName()
+        << "' is not part of the definition of SBML Level "
+        << object.getLevel() << " Version " << object.getVersion() << ".";
+    logFailure(SBMLError(UnrecognizedElement, object.getLevel(),
+      object.getVersion(), msg.str(), object.getLine(), object.getColumn()));
+    return;
+  }
+
+  switch (object.getLevel())
+  {
+  case 1:
+    checkL1Element(object);
+    break;
+  case 2:
+    checkL2Element(object);
+    break;
+  default:
+    checkL3Element(object);
+    break;
+  }
+
+  // the reader checks the kinetic law once it has read all of it;
+  // L3V2 allows it to be empty
+  if (object.getTypeCode() == SBML_KINETIC_LAW &&
+      (object.getLevel() < 3 || object.getVersion() == 1))
+  {
+    const KineticLaw& kl = static_cast<const KineticLaw&>(object);
+
+    if (kl.isSetMath()           == false &&
+        kl.isSetFormula()        == false &&
+        kl.isSetTimeUnits()      == false &&
+        kl.isSetSubstanceUnits() == false &&
+        kl.isSetSBOTerm()        == false &&
+        kl.getNumParameters()    == 0)
+    {
+      logFailure(SBMLError(EmptyListInReaction, kl.getLevel(), kl.getVersion(),
+        "", kl.getLine(), kl.getColumn()));
+    }
+  }
+}
+
+
+/*
+ * In Level 1 the required attributes are checked by XMLAttributes::readInto.
+ */
+void
+ReadTimeConsistencyValidator::checkL1Element (const SBase& object)
+{
+  switch (object.getTypeCode())
+  {
+  case SBML_COMPARTMENT:
+  case SBML_UNIT_DEFINITION:
+  case SBML_PARAMETER:
+  case SBML_REACTION:
+    if (!object.isSetId()) logRequiredAttribute(object, "name");
+    break;
+
+  case SBML_SPECIES:
+    if (!object.isSetId()) logRequiredAttribute(object, "name");
+    if (!static_cast<const Species&>(object).isSetCompartment())
+    {
+      logRequiredAttribute(object, "compartment");
+    }
+    break;
+
+  case SBML_SPECIES_REFERENCE:
+    if (!static_cast<const SimpleSpeciesReference&>(object).isSetSpecies())
+    {
+      logRequiredAttribute(object,
+        (object.getVersion() == 1) ? "specie" : "species");
+    }
+    break;
+
+  case SBML_KINETIC_LAW:
+    if (!static_cast<const KineticLaw&>(object).isSetFormula())
+    {
+      logRequiredAttribute(object, "formula");
+    }
+    break;
+
+  case SBML_ALGEBRAIC_RULE:
+  case SBML_ASSIGNMENT_RULE:
+  case SBML_RATE_RULE:
+    if (!static_cast<const Rule&>(object).isSetFormula())
+    {
+      logRequiredAttribute(object, "formula");
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * In Level 2 the required attributes are checked by XMLAttributes::readInto.
+ */
+void
+ReadTimeConsistencyValidator::checkL2Element (const SBase& object)
+{
+  switch (object.getTypeCode())
+  {
+  case SBML_FUNCTION_DEFINITION:
+  case SBML_UNIT_DEFINITION:
+  case SBML_COMPARTMENT_TYPE:
+  case SBML_SPECIES_TYPE:
+  case SBML_COMPARTMENT:
+  case SBML_PARAMETER:
+  case SBML_REACTION:
+    if (!object.isSetId()) logRequiredAttribute(object, "id");
+    break;
+
+  case SBML_SPECIES:
+    if (!object.isSetId()) logRequiredAttribute(object, "id");
+    if (!static_cast<const Species&>(object).isSetCompartment())
+    {
+      logRequiredAttribute(object, "compartment");
+    }
+    break;
+
+  case SBML_INITIAL_ASSIGNMENT:
+    if (!static_cast<const InitialAssignment&>(object).isSetSymbol())
+    {
+      logRequiredAttribute(object, "symbol");
+    }
+    break;
+
+  case SBML_ASSIGNMENT_RULE:
+  case SBML_RATE_RULE:
+    if (!static_cast<const Rule&>(object).isSetVariable())
+    {
+      logRequiredAttribute(object, "variable");
+    }
+    break;
+
+  case SBML_SPECIES_REFERENCE:
+  case SBML_MODIFIER_SPECIES_REFERENCE:
+    if (!static_cast<const SimpleSpeciesReference&>(object).isSetSpecies())
+    {
+      logRequiredAttribute(object, "species");
+    }
+    break;
+
+  case SBML_EVENT_ASSIGNMENT:
+    if (!static_cast<const EventAssignment&>(object).isSetVariable())
+    {
+      logRequiredAttribute(object, "variable");
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * In Level 3 each element logs its own error for a missing required
+ * attribute.  The messages and the order follow the readL3Attributes
+ * functions.
+ */
+void
+ReadTimeConsistencyValidator::checkL3Element (const SBase& object)
+{
+  const string missingId = "The required attribute 'id' is missing.";
+
+  switch (object.getTypeCode())
+  {
+  case SBML_FUNCTION_DEFINITION:
+    if (!object.isSetId())
+    {
+      logMissingAttribute(object, AllowedAttributesOnFunc, missingId);
+    }
+    break;
+
+  case SBML_UNIT_DEFINITION:
+    if (!object.isSetId())
+    {
+      logMissingAttribute(object, AllowedAttributesOnUnitDefinition, missingId);
+    }
+    break;
+
+  case SBML_UNIT:
+  {
+    const Unit& u = static_cast<const Unit&>(object);
+    if (!u.isSetKind())
+    {
+      logMissingAttribute(object, AllowedAttributesOnUnit,
+        "The required attribute 'kind' is missing.");
+    }
+    if (!u.isSetExponent())
+    {
+      logMissingAttribute(object, AllowedAttributesOnUnit,
+        "The required attribute 'exponent' is missing.");
+    }
+    if (!u.isSetScale())
+    {
+      logMissingAttribute(object, AllowedAttributesOnUnit,
+        "The required attribute 'scale' is missing.");
+    }
+    if (!u.isSetMultiplier())
+    {
+      logMissingAttribute(object, AllowedAttributesOnUnit,
+        "The required attribute 'multiplier' is missing.");
+    }
+    break;
+  }
+
+  case SBML_COMPARTMENT:
+    if (!object.isSetId())
+    {
+      logMissingAttribute(object, AllowedAttributesOnCompartment, missingId);
+    }
+    if (!static_cast<const Compartment&>(object).isSetConstant())
+    {
+      logMissingAttribute(object, AllowedAttributesOnCompartment,
+        "The required attribute 'constant' is missing from the "
+        + describe(object) + ".");
+    }
+    break;
+
+  case SBML_SPECIES:
+  {
+    const Species& s = static_cast<const Species&>(object);
+    const string spplusid = describe(object);
+    if (!s.isSetId())
+    {
+      logMissingAttribute(object, AllowedAttributesOnSpecies, missingId);
+    }
+    if (!s.isSetCompartment())
+    {
+      logMissingAttribute(object, MissingSpeciesCompartment,
+        "The " + spplusid + " is missing the 'compartment' attribute.");
+    }
+    if (!s.isSetBoundaryCondition())
+    {
+      logMissingAttribute(object, AllowedAttributesOnSpecies,
+        "The required attribute 'boundaryCondition' is missing from the "
+        + spplusid + ".");
+    }
+    if (!s.isSetHasOnlySubstanceUnits())
+    {
+      logMissingAttribute(object, AllowedAttributesOnSpecies,
+        "The required attribute 'hasOnlySubstanceUnits' is missing from the "
+        + spplusid + ".");
+    }
+    if (!s.isSetConstant())
+    {
+      logMissingAttribute(object, AllowedAttributesOnSpecies,
+        "The required attribute 'constant' is missing from the "
+        + spplusid + ".");
+    }
+    break;
+  }
+
+  case SBML_PARAMETER:
+    if (!object.isSetId())
+    {
+      logMissingAttribute(object, AllowedAttributesOnParameter, missingId);
+    }
+    if (!static_cast<const Parameter&>(object).isSetConstant())
+    {
+      logMissingAttribute(object, AllowedAttributesOnParameter,
+        "The required attribute 'constant' is missing from the "
+        + describe(object) + ".");
+    }
+    break;
+
+  case SBML_LOCAL_PARAMETER:
+    if (!object.isSetId())
+    {
+      logMissingAttribute(object, AllowedAttributesOnLocalParameter, missingId);
+    }
+    break;
+
+  case SBML_INITIAL_ASSIGNMENT:
+    if (!static_cast<const InitialAssignment&>(object).isSetSymbol())
+    {
+      logMissingAttribute(object, AllowedAttributesOnInitialAssign,
+        "The required attribute 'symbol' is missing.");
+    }
+    break;
+
+  case SBML_ASSIGNMENT_RULE:
+    if (!static_cast<const Rule&>(object).isSetVariable())
+    {
+      logMissingAttribute(object, AllowedAttributesOnAssignRule,
+        "The required attribute 'variable' is missing.");
+    }
+    break;
+
+  case SBML_RATE_RULE:
+    if (!static_cast<const Rule&>(object).isSetVariable())
+    {
+      logMissingAttribute(object, AllowedAttributesOnRateRule,
+        "The required attribute 'variable' is missing.");
+    }
+    break;
+
+  case SBML_REACTION:
+  {
+    const Reaction& r = static_cast<const Reaction&>(object);
+    if (!r.isSetId())
+    {
+      logMissingAttribute(object, AllowedAttributesOnReaction, missingId);
+    }
+    if (!r.isSetReversible())
+    {
+      logMissingAttribute(object, AllowedAttributesOnReaction,
+        "The required attribute 'reversible' is missing from the "
+        + describe(object) + ".");
+    }
+    if (r.getVersion() == 1 && !r.isSetFast())
+    {
+      logMissingAttribute(object, AllowedAttributesOnReaction,
+        "The required attribute 'fast' is missing from the "
+        + describe(object) + ".");
+    }
+    break;
+  }
+
+  case SBML_SPECIES_REFERENCE:
+  case SBML_MODIFIER_SPECIES_REFERENCE:
+  {
+    string elplusid = describe(object);
+    const SBase* rxn = object.getAncestorOfType(SBML_REACTION);
+    if (rxn != NULL && rxn->isSetId())
+    {
+      elplusid += " from the <reaction> with the id '" + rxn->getId() + "'";
+    }
+
+    const bool modifier = (object.getTypeCode() == SBML_MODIFIER_SPECIES_REFERENCE);
+    const unsigned int id = modifier ? AllowedAttributesOnModifier
+                                     : AllowedAttributesOnSpeciesReference;
+
+    if (!static_cast<const SimpleSpeciesReference&>(object).isSetSpecies())
+    {
+      logMissingAttribute(object, id,
+        "The required attribute 'species' is missing from the "
+        + elplusid + ".");
+    }
+    if (!modifier && !static_cast<const SpeciesReference&>(object).isSetConstant())
+    {
+      logMissingAttribute(object, id,
+        "The required attribute 'constant' is missing from the "
+        + elplusid + ".");
+    }
+    break;
+  }
+
+  case SBML_EVENT:
+    if (!static_cast<const Event&>(object).isSetUseValuesFromTriggerTime())
+    {
+      logMissingAttribute(object, AllowedAttributesOnEvent,
+        "The required attribute 'useValuesfromTriggerTime' is missing.");
+    }
+    break;
+
+  case SBML_TRIGGER:
+  {
+    const Trigger& t = static_cast<const Trigger&>(object);
+    if (!t.isSetInitialValue())
+    {
+      logMissingAttribute(object, AllowedAttributesOnTrigger,
+        "The required attribute 'initialValue' is missing.");
+    }
+    if (!t.isSetPersistent())
+    {
+      logMissingAttribute(object, AllowedAttributesOnTrigger,
+        "The required attribute 'persistent' is missing.");
+    }
+    break;
+  }
+
+  case SBML_EVENT_ASSIGNMENT:
+    if (!static_cast<const EventAssignment&>(object).isSetVariable())
+    {
+      logMissingAttribute(object, AllowedAttributesOnEventAssignment,
+        "The required attribute 'variable' is missing.");
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * A Level 1 rule whose variable is not (yet) a compartment, species or
+ * parameter of the model is written as an 'unknownRule', which the
+ * reader does not recognise.
+ */
+bool
+ReadTimeConsistencyValidator::isDroppedByWriter (const SBase& object) const
+{
+  if (object.getLevel() != 1)
+  {
+    return false;
+  }
+
+  switch (object.getTypeCode())
+  {
+  case SBML_ASSIGNMENT_RULE:
+  case SBML_RATE_RULE:
+  {
+    const Rule& r = static_cast<const Rule&>(object);
+    return !r.isSpeciesConcentration() && !r.isCompartmentVolume()
+      && !r.isParameter();
+  }
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * The writer skips empty lists, so a list can only be empty on reading
+ * if the writer drops all of its children.
+ */
+bool
+ReadTimeConsistencyValidator::isEmptiedByWriter (const ListOf& list) const
+{
+  if (list.size() == 0)
+  {
+    return false;
+  }
+
+  for (unsigned int n = 0; n < list.size(); ++n)
+  {
+    if (!isDroppedByWriter(*list.get(n)))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+void
+ReadTimeConsistencyValidator::logMissingAttribute (const SBase& object,
+                                                   unsigned int id,
+                                                   const std::string& details)
+{
+  logFailure(SBMLError(id, object.getLevel(), object.getVersion(), details,
+                       object.getLine(), object.getColumn()));
+}
+
+
+/*
+ * The error XMLAttributes::readInto logs for a missing required attribute.
+ */
+void
+ReadTimeConsistencyValidator::logRequiredAttribute (const SBase& object,
+                                                    const std::string& name)
+{
+  logMissingAttribute(object, MissingXMLRequiredAttribute,
+                      "The attribute '" + name + "' is required.");
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif
+/** @endcond */
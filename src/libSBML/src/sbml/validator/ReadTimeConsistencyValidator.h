@@ -0,0 +1,107 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ReadTimeConsistencyValidator.h
+ * @brief   Applies the checks of the SBML reader to a model in memory
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class ReadTimeConsistencyValidator
+ * @sbmlbrief{core} Reports the errors that reading the document back in
+ * would report.
+ *
+ * Some problems with a model built in memory (most notably missing required
+ * attributes) are only detected by the attribute and structure checks of
+ * the reader.  Rather than writing the document to a string and parsing it
+ * again, this validator walks the SBML core elements in document order and
+ * logs the same errors, in the same order, as SBMLReader would.  It does
+ * not know the read-time checks of the packages, so documents using
+ * packages are still written and read back.
+ *
+ * The checks are not expressed as constraints, since the reader may log
+ * several errors with the same id for a single element.
+ */
+
+#ifndef ReadTimeConsistencyValidator_h
+#define ReadTimeConsistencyValidator_h
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+#include <sbml/validator/Validator.h>
+#include <sbml/SBMLError.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class ListOf;
+class SBase;
+
+class ReadTimeConsistencyValidator: public Validator
+{
+public:
+
+  ReadTimeConsistencyValidator () : Validator( LIBSBML_CAT_SBML ) { }
+
+  virtual ~ReadTimeConsistencyValidator () { }
+
+  /**
+   * Initializes this Validator; there are no Constraints to add.
+   */
+  virtual void init ();
+
+
+  using Validator::validate;
+
+  /**
+   * Validates the given SBMLDocument.  Failures logged during
+   * validation may be retrieved via getFailures().
+   *
+   * @return the number of validation failures that occurred.
+   */
+  virtual unsigned int validate (const SBMLDocument& d);
+
+
+protected:
+
+  void checkModel (const SBMLDocument& d);
+
+  void checkElement (const SBase& object);
+
+  void checkL1Element (const SBase& object);
+
+  void checkL2Element (const SBase& object);
+
+  void checkL3Element (const SBase& object);
+
+  bool isDroppedByWriter (const SBase& object) const;
+
+  bool isEmptiedByWriter (const ListOf& list) const;
+
+  void logMissingAttribute (const SBase& object, unsigned int id,
+                            const std::string& details);
+
+  void logRequiredAttribute (const SBase& object, const std::string& name);
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ReadTimeConsistencyValidator_h */
+/** @endcond */
@@ -45,7 +45,11 @@
 #ifdef __cplusplus
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <map>
 
@@ -65,9 +69,12 @@
 #include <sbml/validator/L3v1CompatibilityValidator.h>
 #include <sbml/validator/L3v2CompatibilityValidator.h>
 #include <sbml/validator/InternalConsistencyValidator.h>
+#include <sbml/validator/ReadTimeConsistencyValidator.h>
 #include <sbml/SBMLDocument.h>
 #include <sbml/SBMLWriter.h>
 #include <sbml/SBMLReader.h>
+#include <sbml/Model.h>
+#include <sbml/KineticLaw.h>
 #include <sbml/AlgebraicRule.h>
 #include <sbml/AssignmentRule.h>
 #include <sbml/RateRule.h>
@@ -83,6 +90,8 @@ SBMLInternalValidator::SBMLInternalValidator()
   : SBMLValidator()
   , mApplicableValidators(0)
   , mApplicableValidatorsForConversion(0)
+  , mParallelValidation(false)
+  , mSinglePassValidation(false)
 {
 
 }
@@ -92,6 +101,8 @@ SBMLInternalValidator::SBMLInternalValidator(const SBMLInternalValidator& orig)
   : SBMLValidator(orig)
   , mApplicableValidators(orig.mApplicableValidators)
   , mApplicableValidatorsForConversion(orig.mApplicableValidatorsForConversion)
+  , mParallelValidation(orig.mParallelValidation)
+  , mSinglePassValidation(orig.mSinglePassValidation)
 {
 }
 
@@ -329,6 +340,319 @@ SBMLInternalValidator::setConsistencyChecksForConversion(SBMLErrorCategory_t cat
   }
 
 }
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * The validators run by checkConsistency, in the order in which their
+ * results are merged.
+ */
+enum ConsistencyCheck
+{
+    IdCheck
+  , SBMLCheck
+  , SBOCheck
+  , MathCheck
+  , UnitsCheck
+  , StrictUnitsCheck
+  , OverdeterminedCheck
+  , PracticeCheck
+  , NumConsistencyChecks
+};
+
+
+static Validator*
+createConsistencyValidator(int check)
+{
+  switch (check)
+  {
+  case IdCheck:             return new IdentifierConsistencyValidator();
+  case SBMLCheck:           return new ConsistencyValidator();
+  case SBOCheck:            return new SBOConsistencyValidator();
+  case MathCheck:           return new MathMLConsistencyValidator();
+  case UnitsCheck:          return new UnitConsistencyValidator();
+  case StrictUnitsCheck:    return new StrictUnitConsistencyValidator();
+  case OverdeterminedCheck: return new OverdeterminedValidator();
+  default:                  return new ModelingPracticeValidator();
+  }
+}
+
+
+/*
+ * Owns the validators of one checkConsistency run; each one is created
+ * and run the first time its results are asked for, unless it has been
+ * run beforehand (in parallel or in a single pass with the others).
+ */
+class ConsistencyValidators
+{
+public:
+
+  /*
+   * errorsStop tells whether errors logged by a validator stop the
+   * validation, i.e. whether the log keeps their severity.
+   */
+  ConsistencyValidators (const SBMLDocument& d, bool errorsStop)
+    : mDocument(d)
+    , mErrorsStop(errorsStop)
+  {
+    std::fill(mValidators, mValidators + NumConsistencyChecks, (Validator*)NULL);
+    std::fill(mValidated, mValidated + NumConsistencyChecks, false);
+  }
+
+  ~ConsistencyValidators ()
+  {
+    for (int check = 0; check < NumConsistencyChecks; ++check)
+    {
+      delete mValidators[check];
+    }
+  }
+
+  Validator& get (int check)
+  {
+    if (mValidators[check] == NULL)
+    {
+      mValidators[check] = createConsistencyValidator(check);
+      mValidators[check]->init();
+    }
+    if (!mValidated[check])
+    {
+      mValidators[check]->validate(mDocument);
+      mValidated[check] = true;
+    }
+    return *mValidators[check];
+  }
+
+  void validateInParallel (const bool enabled[], int first, int last);
+
+  void validateInOnePass (const bool enabled[], int first, int last);
+
+private:
+
+  std::vector<int> createValidators (const bool enabled[], int first, int last);
+
+  bool stopsValidation (int check) const;
+
+  ConsistencyValidators (const ConsistencyValidators&);
+  ConsistencyValidators& operator= (const ConsistencyValidators&);
+
+  const SBMLDocument& mDocument;
+  bool                mErrorsStop;
+  Validator*          mValidators[NumConsistencyChecks];
+  bool                mValidated[NumConsistencyChecks];
+};
+
+
+/*
+ * Some values are computed lazily on first use, by the unit checks but
+ * also by any constraint asking for derived units; computing them here,
+ * before any thread starts, leaves the validators with read-only access to
+ * the document.  (Parameter::getDerivedUnitDefinition, which several
+ * validators call on the same parameter, only writes its calculating-units
+ * flag when the flag is set, i.e. never while validating.)
+ */
+static void
+prepareForParallelValidation(const SBMLDocument& d)
+{
+  Model* m = const_cast<SBMLDocument&>(d).getModel();
+  if (m == NULL)
+  {
+    return;
+  }
+
+  if (!m->isPopulatedListFormulaUnitsData())
+  {
+    m->populateListFormulaUnitsData();
+  }
+
+  for (unsigned int n = 0; n < m->getNumRules(); ++n)
+  {
+    const Rule* r = m->getRule(n);
+    r->getMath();
+    r->getFormula();
+  }
+
+  for (unsigned int n = 0; n < m->getNumReactions(); ++n)
+  {
+    const KineticLaw* kl = m->getReaction(n)->getKineticLaw();
+    if (kl != NULL)
+    {
+      kl->getMath();
+      kl->getFormula();
+    }
+  }
+}
+
+
+/*
+ * Creates and initializes the enabled validators from first to last
+ * (inclusive).
+ *
+ * @return the checks performed by the validators created.
+ */
+std::vector<int>
+ConsistencyValidators::createValidators (const bool enabled[],
+                                         int first, int last)
+{
+  std::vector<int> checks;
+  for (int check = first; check <= last; ++check)
+  {
+    if (enabled[check])
+    {
+      mValidators[check] = createConsistencyValidator(check);
+      mValidators[check]->init();
+      checks.push_back(check);
+    }
+  }
+
+  return checks;
+}
+
+
+/*
+ * @return true if the failures of the given (validated) check make
+ * checkConsistency stop there whatever the other checks found.  This
+ * errs on the side of false: checkConsistency may still stop when it
+ * returns false.
+ */
+bool
+ConsistencyValidators::stopsValidation (int check) const
+{
+  const std::list<SBMLError>& failures = mValidators[check]->getFailures();
+  std::list<SBMLError>::const_iterator it;
+
+  switch (check)
+  {
+  case IdCheck:
+    /* only dangling unit references let the validation go on */
+    for (it = failures.begin(); it != failures.end(); ++it)
+    {
+      if (it->getErrorId() != DanglingUnitSIdRef) return true;
+    }
+    return false;
+
+  case MathCheck:
+    return !failures.empty();
+
+  case PracticeCheck:
+    return false;
+
+  default:
+    if (!mErrorsStop) return false;
+    for (it = failures.begin(); it != failures.end(); ++it)
+    {
+      if (it->getSeverity() == LIBSBML_SEV_ERROR) return true;
+    }
+    return false;
+  }
+}
+
+
+/*
+ * Runs the enabled validators from first to last (inclusive) in a single
+ * traversal of the document.
+ */
+void
+ConsistencyValidators::validateInOnePass (const bool enabled[],
+                                          int first, int last)
+{
+  std::vector<int> checks = createValidators(enabled, first, last);
+
+  FusedValidator fused;
+  for (size_t n = 0; n < checks.size(); ++n)
+  {
+    fused.addValidator(mValidators[checks[n]]);
+  }
+
+  fused.init();
+  fused.validate(mDocument);
+
+  for (size_t n = 0; n < checks.size(); ++n)
+  {
+    mValidated[checks[n]] = true;
+  }
+}
+
+
+/*
+ * Runs the enabled validators from first to last (inclusive) on a pool of
+ * threads.  Every validator collects its own failures, so nothing is
+ * shared between the threads but the (read-only) document.
+ *
+ * The validators are started in order, and none is started once an
+ * earlier one has failed in a way that stops checkConsistency, as the
+ * sequential path would not run it either.
+ */
+void
+ConsistencyValidators::validateInParallel (const bool enabled[],
+                                           int first, int last)
+{
+  std::vector<int> checks = createValidators(enabled, first, last);
+
+  if (checks.empty())
+  {
+    return;
+  }
+
+  unsigned int numThreads = std::thread::hardware_concurrency();
+  numThreads = std::max(1u, std::min(numThreads, (unsigned int)checks.size()));
+
+  std::atomic<size_t> next(0);
+  std::atomic<int> stopAt(last + 1);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto work = [&]()
+  {
+    size_t n;
+    while ((n = next++) < checks.size())
+    {
+      const int check = checks[n];
+      if (check > stopAt)
+      {
+        continue;
+      }
+
+      try
+      {
+        mValidators[check]->validate(mDocument);
+        mValidated[check] = true;
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) error = std::current_exception();
+      }
+
+      if (mValidated[check] && stopsValidation(check))
+      {
+        int current = stopAt;
+        while (check < current && !stopAt.compare_exchange_weak(current, check))
+        {
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < numThreads; ++i)
+  {
+    threads.push_back(std::thread(work));
+  }
+  work();
+
+  for (size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i].join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+/** @endcond */
+
+
 /*
  * Performs a set of semantic consistency checks on the document.  Query
  * the results by calling getNumErrors() and getError().
@@ -397,12 +721,30 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
     return 0;
   }
 
+  ConsistencyValidators validators(*doc,
+    log->getSeverityOverride() == LIBSBML_OVERRIDE_DISABLED);
+
+  /* the unit checks may crash if there have been math errors, so when
+   * running in parallel or in a single pass the validators are run in two
+   * batches, the second one only if the results of the first do not stop
+   * us */
+  const bool enabled[NumConsistencyChecks] = 
+    { id, sbml, sbo, math, units, strictUnits, over, practice };
+
+  if (mParallelValidation)
+  {
+    prepareForParallelValidation(*doc);
+    validators.validateInParallel(enabled, IdCheck, MathCheck);
+  }
+  else if (mSinglePassValidation)
+  {
+    validators.validateInOnePass(enabled, IdCheck, MathCheck);
+  }
 
   if (id)
   {
-    IdentifierConsistencyValidator id_validator;
-    id_validator.init();
-    nerrors = id_validator.validate(*doc);
+    Validator& id_validator = validators.get(IdCheck);
+    nerrors = (unsigned int)id_validator.getFailures().size();
     if (nerrors > 0) 
     {
       unsigned int origNum = log->getNumErrors();
@@ -457,9 +799,8 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
 
   if (sbml)
   {
-    ConsistencyValidator validator;
-    validator.init();
-    nerrors = validator.validate(*doc);
+    Validator& validator = validators.get(SBMLCheck);
+    nerrors = (unsigned int)validator.getFailures().size();
     total_errors += nerrors;
     if (nerrors > 0) 
     {
@@ -476,9 +817,8 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
 
   if (sbo)
   {
-    SBOConsistencyValidator sbo_validator;
-    sbo_validator.init();
-    nerrors = sbo_validator.validate(*doc);
+    Validator& sbo_validator = validators.get(SBOCheck);
+    nerrors = (unsigned int)sbo_validator.getFailures().size();
     total_errors += nerrors;
     if (nerrors > 0) 
     {
@@ -495,9 +835,8 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
 
   if (math)
   {
-    MathMLConsistencyValidator math_validator;
-    math_validator.init();
-    nerrors = math_validator.validate(*doc);
+    Validator& math_validator = validators.get(MathCheck);
+    nerrors = (unsigned int)math_validator.getFailures().size();
     total_errors += nerrors;
     if (nerrors > 0) 
     {
@@ -511,12 +850,19 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
     }
   }
 
+  if (mParallelValidation)
+  {
+    validators.validateInParallel(enabled, UnitsCheck, PracticeCheck);
+  }
+  else if (mSinglePassValidation)
+  {
+    validators.validateInOnePass(enabled, UnitsCheck, PracticeCheck);
+  }
 
   if (units)
   {
-    UnitConsistencyValidator unit_validator;
-    unit_validator.init();
-    nerrors = unit_validator.validate(*doc);
+    Validator& unit_validator = validators.get(UnitsCheck);
+    nerrors = (unsigned int)unit_validator.getFailures().size();
     total_errors += nerrors;
     if (nerrors > 0) 
     {
@@ -533,9 +879,8 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
 
   if (strictUnits)
   {
-    StrictUnitConsistencyValidator unit_validator;
-    unit_validator.init();
-    nerrors = unit_validator.validate(*doc);
+    Validator& unit_validator = validators.get(StrictUnitsCheck);
+    nerrors = (unsigned int)unit_validator.getFailures().size();
     total_errors += nerrors;
     if (nerrors > 0) 
     {
@@ -554,9 +899,8 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
    * changed this as would have bailed */
   if (over)
   {
-    OverdeterminedValidator over_validator;
-    over_validator.init();
-    nerrors = over_validator.validate(*doc);
+    Validator& over_validator = validators.get(OverdeterminedCheck);
+    nerrors = (unsigned int)over_validator.getFailures().size();
     total_errors += nerrors;
     if (nerrors > 0) 
     {
@@ -573,9 +917,8 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
 
   if (practice)
   {
-    ModelingPracticeValidator practice_validator;
-    practice_validator.init();
-    nerrors = practice_validator.validate(*doc);
+    Validator& practice_validator = validators.get(PracticeCheck);
+    nerrors = (unsigned int)practice_validator.getFailures().size();
     if (nerrors > 0) 
     {
       unsigned int errorsAdded = 0;
@@ -618,7 +961,7 @@ SBMLInternalValidator::checkConsistency (bool writeDocument)
  * @return the number of failed checks (errors) encountered.
  */
 unsigned int
-SBMLInternalValidator::checkInternalConsistency()
+SBMLInternalValidator::checkInternalConsistency(bool writeDocument)
 {
   unsigned int nerrors = 0;
   unsigned int totalerrors = 0;
@@ -633,17 +976,32 @@ SBMLInternalValidator::checkInternalConsistency()
   }
   totalerrors += nerrors;
   
-  /* hack to catch errors normally caught at read time */
-  char* doc = writeSBMLToString(getDocument());
-  SBMLDocument *d = readSBMLFromString(doc);
-  util_free(doc);
-  nerrors = d->getNumErrors();
+  /* catch errors normally caught at read time; only the reader knows the
+   * read-time checks of the packages */
+  if (writeDocument || getDocument()->getNumPlugins() > 0)
+  {
+    char* doc = writeSBMLToString(getDocument());
+    SBMLDocument *d = readSBMLFromString(doc);
+    util_free(doc);
+    nerrors = d->getNumErrors();
 
-  for (unsigned int i = 0; i < nerrors; i++)
+    for (unsigned int i = 0; i < nerrors; i++)
+    {
+      getErrorLog()->add(*(d->getError(i)));
+    }
+    delete d;
+  }
+  else
   {
-    getErrorLog()->add(*(d->getError(i)));
+    ReadTimeConsistencyValidator read_validator;
+
+    read_validator.init();
+    nerrors = read_validator.validate(*getDocument());
+    if (nerrors > 0) 
+    {
+      getErrorLog()->add( read_validator.getFailures() );
+    }
   }
-  delete d;
   totalerrors += nerrors;
 
 
@@ -855,6 +1213,34 @@ SBMLInternalValidator::setConversionValidators(unsigned char appl)
   mApplicableValidatorsForConversion = appl;
 }
 
+
+bool
+SBMLInternalValidator::getParallelValidation() const
+{
+  return mParallelValidation;
+}
+
+
+void
+SBMLInternalValidator::setParallelValidation(bool parallel)
+{
+  mParallelValidation = parallel;
+}
+
+
+bool
+SBMLInternalValidator::getSinglePassValidation() const
+{
+  return mSinglePassValidation;
+}
+
+
+void
+SBMLInternalValidator::setSinglePassValidation(bool singlePass)
+{
+  mSinglePassValidation = singlePass;
+}
+
 unsigned int 
   SBMLInternalValidator::validate()
 {
@@ -318,6 +318,14 @@ public:
    * Callers should query the results of the consistency check by calling
    * SBMLDocument::getError(@if java long@endif).
    *
+   * @param writeDocument by default the errors the reader would report for
+   *                      this document are determined on the model in
+   *                      memory.  Setting this parameter to true writes the
+   *                      document to a string and reads it back instead,
+   *                      which doubles the time and memory needed.  A
+   *                      document that uses packages is always written
+   *                      and read back.
+   *
    * @return the number of failed checks (errors) encountered.
    *
    * The distinction between this method and
@@ -330,7 +338,7 @@ public:
    * 
    * @see SBMLDocument::checkConsistency()
    */
-  unsigned int checkInternalConsistency ();
+  unsigned int checkInternalConsistency (bool writeDocument=false);
 
 
   /**
@@ -465,6 +473,52 @@ public:
   void setConversionValidators(unsigned char appl);
 
 
+  /**
+   * @return @c true if checkConsistency() runs the selected validators
+   * concurrently, @c false otherwise.
+   */
+  bool getParallelValidation() const;
+
+
+  /**
+   * Sets whether checkConsistency() runs the selected validators
+   * concurrently on a pool of threads.
+   *
+   * Each validator collects its own failures; they are merged in the same
+   * order, and with the same early exits, as in the sequential mode, so
+   * the results do not depend on this setting.  The unit, overdetermined
+   * and modeling practice validators are only started once the others
+   * have passed; within each batch, no validator is started once an
+   * earlier one has stopped the validation.  This only pays off when more
+   * than one core is available.
+   *
+   * @param parallel @c true to run the validators in parallel.
+   */
+  void setParallelValidation(bool parallel);
+
+
+  /**
+   * @return @c true if checkConsistency() runs the selected validators in
+   * a single traversal of the document, @c false otherwise.
+   */
+  bool getSinglePassValidation() const;
+
+
+  /**
+   * Sets whether checkConsistency() runs the selected validators in a
+   * single traversal of the document (see FusedValidator), rather than
+   * one traversal per validator.
+   *
+   * The results do not depend on this setting, but validators whose
+   * results end up being discarded are run nevertheless; this pays off
+   * when most documents validated are valid.
+   * Parallel validation takes precedence if both are enabled.
+   *
+   * @param singlePass @c true to run the validators in a single pass.
+   */
+  void setSinglePassValidation(bool singlePass);
+
+
   /**
    * Constructor.
    */
@@ -509,6 +563,8 @@ protected:
   /** @cond doxygenLibsbmlInternal */
   unsigned char mApplicableValidators;
   unsigned char mApplicableValidatorsForConversion;
+  bool mParallelValidation;
+  bool mSinglePassValidation;
 
   /** @endcond */
 
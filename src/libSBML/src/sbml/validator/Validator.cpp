@@ -194,6 +194,7 @@ struct ValidatorConstraints
 
   ~ValidatorConstraints ();
   void add (VConstraint* c);
+  bool appliesTo (int type) const;
 };
 
 /*
@@ -420,6 +421,79 @@ ValidatorConstraints::add (VConstraint* c)
 
 }
 
+
+/*
+ * Returns true if visiting an object of the given core type with a
+ * ValidatingVisitor can apply constraints to it, or to the objects of
+ * the same type following it in its ListOf.  This is also the value the
+ * ValidatingVisitor returns for the types whose visit() controls whether
+ * further objects are visited.
+ */
+bool
+ValidatorConstraints::appliesTo (int type) const
+{
+  switch (type)
+  {
+  case SBML_DOCUMENT:
+    return !mSBMLDocument.empty();
+  case SBML_MODEL:
+    return !mModel.empty();
+  case SBML_KINETIC_LAW:
+    return !mKineticLaw.empty();
+  case SBML_PRIORITY:
+    return !mPriority.empty();
+  case SBML_FUNCTION_DEFINITION:
+    return !mFunctionDefinition.empty();
+  case SBML_UNIT_DEFINITION:
+    return !mUnitDefinition.empty() || !mUnit.empty();
+  case SBML_UNIT:
+    return !mUnit.empty();
+  case SBML_COMPARTMENT:
+    return !mCompartment.empty();
+  case SBML_SPECIES:
+    return !mSpecies.empty();
+  case SBML_PARAMETER:
+    return !mParameter.empty();
+  case SBML_LOCAL_PARAMETER:
+    return !mLocalParameter.empty();
+  case SBML_RULE:
+    return !mRule.empty();
+  case SBML_ALGEBRAIC_RULE:
+    return !mRule.empty() || !mAlgebraicRule.empty();
+  case SBML_ASSIGNMENT_RULE:
+    return !mRule.empty() || !mAssignmentRule.empty();
+  case SBML_RATE_RULE:
+    return !mRule.empty() || !mRateRule.empty();
+  case SBML_REACTION:
+    return !mReaction.empty();
+  case SBML_SPECIES_REFERENCE:
+    return !mSimpleSpeciesReference.empty() || !mSpeciesReference.empty();
+  case SBML_MODIFIER_SPECIES_REFERENCE:
+    return !mSimpleSpeciesReference.empty() ||
+           !mModifierSpeciesReference.empty();
+  case SBML_STOICHIOMETRY_MATH:
+    return !mStoichiometryMath.empty();
+  case SBML_EVENT:
+    return !mEvent.empty() || !mEventAssignment.empty();
+  case SBML_EVENT_ASSIGNMENT:
+    return !mEventAssignment.empty();
+  case SBML_INITIAL_ASSIGNMENT:
+    return !mInitialAssignment.empty();
+  case SBML_CONSTRAINT:
+    return !mConstraint.empty();
+  case SBML_TRIGGER:
+    return !mTrigger.empty();
+  case SBML_DELAY:
+    return !mDelay.empty();
+  case SBML_COMPARTMENT_TYPE:
+    return !mCompartmentType.empty();
+  case SBML_SPECIES_TYPE:
+    return !mSpeciesType.empty();
+  default:
+    return false;
+  }
+}
+
 // ----------------------------------------------------------------------
 
 
@@ -688,6 +762,279 @@ protected:
 
 
 
+// ----------------------------------------------------------------------
+// FusedVisitor
+// ----------------------------------------------------------------------
+
+
+/*
+ * A FusedVisitor drives one ValidatingVisitor per fused Validator through
+ * a single traversal of the document.
+ *
+ * A ValidatingVisitor stops visiting the remaining objects of a ListOf as
+ * soon as one of its visit methods returns false.  The FusedVisitor keeps
+ * track of this separately for each Validator (as a bit mask of the
+ * Validators still "active"), so that every Validator sees exactly the
+ * objects it would have seen on its own.
+ */
+class FusedVisitor: public SBMLVisitor
+{
+public:
+
+  FusedVisitor (const std::vector<Validator*>&   validators,
+                const std::vector<unsigned int>& dispatch,
+                const Model&                     model)
+    : mDispatch(dispatch)
+  {
+    for (size_t n = 0; n < validators.size(); ++n)
+    {
+      mVisitors.push_back( ValidatingVisitor(*validators[n], model) );
+    }
+
+    unsigned int all = (validators.size() < 32) ?
+      (1u << validators.size()) - 1 : ~0u;
+    mFrames.push_back( Frame(NULL, all) );
+  }
+
+  using SBMLVisitor::visit;
+  using SBMLVisitor::leave;
+
+  void visit (const ListOf& x, int)
+  {
+    mFrames.push_back( Frame(&x, mFrames.back().itemActive) );
+  }
+
+  void leave (const ListOf&, int)
+  {
+    mFrames.pop_back();
+  }
+
+  void visit (const SBMLDocument& x) { dispatch(x, SBML_DOCUMENT, false);    }
+  void visit (const Model& x)        { dispatch(x, SBML_MODEL, false);       }
+  void visit (const KineticLaw& x)   { dispatch(x, SBML_KINETIC_LAW, false); }
+  void visit (const Priority& x)     { dispatch(x, SBML_PRIORITY, false);    }
+
+  bool visit (const FunctionDefinition& x)
+  {
+    return dispatch(x, SBML_FUNCTION_DEFINITION);
+  }
+
+  bool visit (const UnitDefinition& x)
+  {
+    return dispatch(x, SBML_UNIT_DEFINITION);
+  }
+
+  bool visit (const Unit& x)
+  {
+    return dispatch(x, SBML_UNIT);
+  }
+
+  bool visit (const Compartment& x)
+  {
+    return dispatch(x, SBML_COMPARTMENT);
+  }
+
+  bool visit (const Species& x)
+  {
+    return dispatch(x, SBML_SPECIES);
+  }
+
+  bool visit (const Parameter& x)
+  {
+    if (x.getTypeCode() == SBML_LOCAL_PARAMETER)
+    {
+      return dispatch(x, SBML_LOCAL_PARAMETER);
+    }
+    else
+    {
+      return dispatch(x, SBML_PARAMETER);
+    }
+  }
+
+  bool visit (const Rule& x)
+  {
+    return dispatch(x, SBML_RULE, false);
+  }
+
+  bool visit (const AlgebraicRule& x)
+  {
+    return dispatch(x, SBML_ALGEBRAIC_RULE, false);
+  }
+
+  bool visit (const AssignmentRule& x)
+  {
+    return dispatch(x, SBML_ASSIGNMENT_RULE, false);
+  }
+
+  bool visit (const RateRule& x)
+  {
+    return dispatch(x, SBML_RATE_RULE, false);
+  }
+
+  bool visit (const Reaction& x)
+  {
+    return dispatch(x, SBML_REACTION, false);
+  }
+
+  bool visit (const SimpleSpeciesReference& x)
+  {
+    return dispatch(x, SBML_SPECIES_REFERENCE, false);
+  }
+
+  bool visit (const SpeciesReference& x)
+  {
+    return dispatch(x, SBML_SPECIES_REFERENCE);
+  }
+
+  bool visit (const ModifierSpeciesReference& x)
+  {
+    return dispatch(x, SBML_MODIFIER_SPECIES_REFERENCE);
+  }
+
+  bool visit (const StoichiometryMath& x)
+  {
+    return dispatch(x, SBML_STOICHIOMETRY_MATH);
+  }
+
+  bool visit (const Event& x)
+  {
+    return dispatch(x, SBML_EVENT);
+  }
+
+  bool visit (const EventAssignment& x)
+  {
+    return dispatch(x, SBML_EVENT_ASSIGNMENT);
+  }
+
+  bool visit (const InitialAssignment& x)
+  {
+    return dispatch(x, SBML_INITIAL_ASSIGNMENT);
+  }
+
+  bool visit (const Constraint& x)
+  {
+    return dispatch(x, SBML_CONSTRAINT);
+  }
+
+  bool visit (const Trigger& x)
+  {
+    return dispatch(x, SBML_TRIGGER);
+  }
+
+  bool visit (const Delay& x)
+  {
+    return dispatch(x, SBML_DELAY);
+  }
+
+  bool visit (const CompartmentType& x)
+  {
+    return dispatch(x, SBML_COMPARTMENT_TYPE);
+  }
+
+  bool visit (const SpeciesType& x)
+  {
+    return dispatch(x, SBML_SPECIES_TYPE);
+  }
+
+protected:
+
+  /** @cond doxygenLibsbmlInternal */
+
+  /*
+   * The Validators active for the items of the ListOf being visited, and
+   * for the descendants of the current item.
+   */
+  struct Frame
+  {
+    Frame (const ListOf* l, unsigned int a) 
+      : list(l), active(a), itemActive(a) { }
+
+    const ListOf* list;
+    unsigned int  active;
+    unsigned int  itemActive;
+  };
+
+
+  /*
+   * Hands the object to the ValidatingVisitors of the active Validators
+   * with constraints for the given type.  If the object is an item of a
+   * ListOf, the Validators whose visit returns false (either explicitly
+   * or, when @p prunes is true, because they have no constraints for the
+   * type) are not active for the items that follow.
+   */
+  template <typename T>
+  bool dispatch (const T& x, int type, bool prunes = true)
+  {
+    Frame& frame = mFrames.back();
+    bool   item  = frame.list != NULL && x.getParentSBMLObject() == frame.list;
+
+    if (item)
+    {
+      frame.itemActive = frame.active;
+    }
+
+    unsigned int relevant = frame.itemActive & mDispatch[type];
+
+    for (unsigned int n = 0; relevant != 0; ++n, relevant >>= 1)
+    {
+      if ((relevant & 1) && !visitOne(n, x) && item)
+      {
+        frame.active &= ~(1u << n);
+      }
+    }
+
+    if (item && prunes)
+    {
+      frame.active &= mDispatch[type];
+    }
+
+    return frame.active != 0;
+  }
+
+  template <typename T>
+  bool visitOne (unsigned int n, const T& x)
+  {
+    return mVisitors[n].visit(x);
+  }
+
+  /* the visit methods that do not return a value */
+  bool visitOne (unsigned int n, const SBMLDocument& x)
+  {
+    mVisitors[n].visit(x);
+    return true;
+  }
+
+  bool visitOne (unsigned int n, const Model& x)
+  {
+    mVisitors[n].visit(x);
+    return true;
+  }
+
+  bool visitOne (unsigned int n, const KineticLaw& x)
+  {
+    mVisitors[n].visit(x);
+    return true;
+  }
+
+  bool visitOne (unsigned int n, const Priority& x)
+  {
+    mVisitors[n].visit(x);
+    return true;
+  }
+
+  std::vector<ValidatingVisitor>   mVisitors;
+  const std::vector<unsigned int>& mDispatch;
+  std::vector<Frame>               mFrames;
+
+  /** @endcond */
+};
+
+
+// ----------------------------------------------------------------------
+
+
+
+
 // ----------------------------------------------------------------------
 // Validator
 // ----------------------------------------------------------------------
@@ -877,6 +1224,19 @@ Validator::validate (const SBMLDocument& d)
     d.accept(vv);
   }
 
+  filterFailures();
+
+  return (unsigned int)mFailures.size();
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Post-processes the failures logged by a validation run.
+ */
+void
+Validator::filterFailures ()
+{
   if (this->getCategory() == LIBSBML_CAT_SBO_CONSISTENCY
       && mFailures.size() > 1)
   {
@@ -906,9 +1266,8 @@ Validator::validate (const SBMLDocument& d)
       //remove_if(mFailures.begin(), mFailures.end(), DontMatchId(99701));
     }
   }
-
-  return (unsigned int)mFailures.size();
 }
+/** @endcond */
 
 
 /*
@@ -937,6 +1296,103 @@ Validator::validate (const std::string& filename)
   return ret;
 }
 
+
+
+// ----------------------------------------------------------------------
+// FusedValidator
+// ----------------------------------------------------------------------
+
+
+/** @cond doxygenLibsbmlInternal */
+FusedValidator::FusedValidator ()
+{
+}
+
+
+FusedValidator::~FusedValidator ()
+{
+}
+
+
+/*
+ * Adds the given (initialized) Validator to this FusedValidator.
+ */
+int
+FusedValidator::addValidator (Validator* validator)
+{
+  if (validator == NULL || mValidators.size() >= 32)
+  {
+    return LIBSBML_OPERATION_FAILED;
+  }
+
+  mValidators.push_back(validator);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Builds the dispatch tables.
+ */
+void
+FusedValidator::init ()
+{
+  mDispatch.assign(SBML_PRIORITY + 1, 0);
+
+  for (int type = 0; type <= SBML_PRIORITY; ++type)
+  {
+    for (size_t n = 0; n < mValidators.size(); ++n)
+    {
+      if (mValidators[n]->mConstraints->appliesTo(type))
+      {
+        mDispatch[type] |= (1u << n);
+      }
+    }
+  }
+}
+
+
+/*
+ * Validates the given SBMLDocument with all Validators in a single
+ * traversal.
+ *
+ * @return the total number of validation failures.
+ */
+unsigned int
+FusedValidator::validate (const SBMLDocument& d)
+{
+  Model* m = const_cast<SBMLDocument&>(d).getModel();
+
+  if (m != NULL)
+  {
+    for (size_t n = 0; n < mValidators.size(); ++n)
+    {
+      if (mValidators[n]->getCategory() == LIBSBML_CAT_UNITS_CONSISTENCY ||
+          mValidators[n]->getCategory() == LIBSBML_CAT_STRICT_UNITS_CONSISTENCY)
+      {
+        /* create list of formula units for validation */
+        if (!m->isPopulatedListFormulaUnitsData())
+        {
+          m->populateListFormulaUnitsData();
+        }
+      }
+    }
+
+    FusedVisitor fv(mValidators, mDispatch, *m);
+    d.accept(fv);
+  }
+
+  unsigned int total = 0;
+
+  for (size_t n = 0; n < mValidators.size(); ++n)
+  {
+    mValidators[n]->filterFailures();
+    total += (unsigned int)mValidators[n]->getFailures().size();
+  }
+
+  return total;
+}
+/** @endcond */
+
 #endif /* __cplusplus */
 
 
@@ -75,6 +75,7 @@
 /** @cond doxygenLibsbmlInternal */
 #include <list>
 #include <string>
+#include <vector>
 /** @endcond */
 
 
@@ -202,6 +203,12 @@ public:
 
 protected:
   /** @cond doxygenLibsbmlInternal */
+
+  /*
+   * Post-processes the failures logged by a validation run.
+   */
+  void filterFailures ();
+
   ValidatorConstraints* mConstraints;
   std::list<SBMLError>  mFailures;
   unsigned int          mCategory;
@@ -210,10 +217,70 @@ protected:
 
 
   friend class ValidatingVisitor;
+  friend class FusedValidator;
 
   /** @endcond */
 };
 
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * A FusedValidator runs several Validators in a single traversal of the
+ * document.  Each object visited is handed to the constraints of every
+ * Validator that has constraints for its type; the tables recording which
+ * ones do are built once, by init().
+ *
+ * The failures are logged to the individual Validators, exactly as if
+ * each had validated the document on its own.  Validators that override
+ * validate() cannot be fused.
+ */
+class LIBSBML_EXTERN FusedValidator
+{
+public:
+
+  FusedValidator ();
+
+  ~FusedValidator ();
+
+
+  /*
+   * Adds the given (initialized) Validator to this FusedValidator, which
+   * does not take ownership of it.  At most 32 Validators can be fused.
+   *
+   * @return integer value indicating success/failure of the
+   * operation. The possible return values are:
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_OPERATION_FAILED, OperationReturnValues_t}
+   */
+  int addValidator (Validator* validator);
+
+
+  /*
+   * Builds the dispatch tables; call this after all Validators have been
+   * added.
+   */
+  void init ();
+
+
+  /*
+   * Validates the given SBMLDocument with all Validators.  Failures are
+   * logged to, and may be retrieved from, the individual Validators.
+   *
+   * @return the total number of validation failures.
+   */
+  unsigned int validate (const SBMLDocument& d);
+
+
+private:
+
+  std::vector<Validator*>   mValidators;
+
+  /* for each core type code, the Validators that have constraints
+   * for objects of that type (one bit per Validator) */
+  std::vector<unsigned int> mDispatch;
+};
+/** @endcond */
+
 LIBSBML_CPP_NAMESPACE_END
 
 #endif  /* __cplusplus */
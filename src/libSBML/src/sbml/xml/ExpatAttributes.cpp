@@ -72,6 +72,31 @@ ExpatAttributes::ExpatAttributes (const XML_Char** attrs,
 }
 
 
+/**
+ * Creates a new XMLAttributes set from the given "raw" Expat attributes,
+ * taking the attribute names from the given XMLSymbolTable.
+ */
+ExpatAttributes::ExpatAttributes (const XML_Char** attrs,
+				  const XML_Char* elementName,
+				  XMLSymbolTable& symbols,
+				  const XML_Char sep)
+{
+  unsigned int size = 0;
+  while (attrs[2 * size]) ++size;
+
+  mNames .reserve(size);
+  mValues.reserve(size);
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    mNames .push_back( symbols.getTriple( attrs[2 * n], sep ) );
+    mValues.push_back( string( attrs[2 * n + 1] ) );
+  }
+
+  mElementName = elementName;
+}
+
+
 /**
  * Destroys this Attribute set.
  */
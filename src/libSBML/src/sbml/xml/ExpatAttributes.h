@@ -50,6 +50,7 @@
 #include <expat.h>
 
 #include <sbml/xml/XMLAttributes.h>
+#include <sbml/xml/XMLSymbolTable.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -69,6 +70,18 @@ public:
 		   const XML_Char sepchar = ' ');
 
 
+  /**
+   * Creates a new XMLAttributes set from the given "raw" Expat attributes,
+   * taking the attribute names from the given XMLSymbolTable.
+   *
+   * @ifnot hasDefaultArgs @htmlinclude warn-default-args-in-docs.html @endif@~
+   */
+  ExpatAttributes (const XML_Char** attrs,
+		   const XML_Char* elementName,
+		   XMLSymbolTable& symbols,
+		   const XML_Char sepchar = ' ');
+
+
   /**
    * Destroys this ExpatAttributes set.
    */
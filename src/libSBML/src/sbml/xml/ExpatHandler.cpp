@@ -41,6 +41,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <utility>
+
 #include <expat.h>
 
 #include <sbml/xml/XMLHandler.h>
@@ -142,6 +144,7 @@ ExpatHandler::ExpatHandler (const ExpatHandler& other)
   : mParser  (other.mParser)
   , mHandler (other.mHandler)
   , mNamespaces (other.mNamespaces)
+  , mSymbols (other.mSymbols)
   , mHandlerError(NULL)
 {
 }
@@ -157,6 +160,7 @@ ExpatHandler& ExpatHandler::operator=(const ExpatHandler& other)
   mParser = other.mParser;
   mHandler = other.mHandler; 
   mNamespaces = other.mNamespaces;
+  mSymbols = other.mSymbols;
   mHandlerError = NULL;
 
   return *this;
@@ -219,12 +223,16 @@ ExpatHandler::XML (const XML_Char* version, const XML_Char* encoding)
 void
 ExpatHandler::startElement (const XML_Char* name, const XML_Char** attrs)
 {
-  const XMLTriple       triple    ( name  );
-  const ExpatAttributes attributes( attrs, name );
-  const XMLToken        element   ( triple, attributes, mNamespaces,
-			            getLine(), getColumn() );
-
-  mHandler.startElement(element);
+  // The pieces of the token are only needed by the handler, so they are
+  // moved into it rather than copied.  As with the other parsers, the
+  // attributes are given the local name of the element for their error
+  // messages.
+  XMLTriple       triple    ( mSymbols.getTriple(name, ' ') );
+  ExpatAttributes attributes( attrs, triple.getName().c_str(), mSymbols );
+  XMLToken        element   ( std::move(triple), std::move(attributes),
+                              std::move(mNamespaces), getLine(), getColumn() );
+
+  mHandler.startElement( std::move(element) );
   mNamespaces.clear();
 }
 
@@ -277,10 +285,10 @@ ExpatHandler::endDocument ()
 void
 ExpatHandler::endElement (const XML_Char* name)
 {
-  const XMLTriple  triple ( name );
-  const XMLToken   element( triple, getLine(), getColumn() );
+  XMLToken element( XMLTriple(mSymbols.getTriple(name, ' ')),
+                    getLine(), getColumn() );
 
-  mHandler.endElement(element);
+  mHandler.endElement( std::move(element) );
 }
 
 
@@ -294,7 +302,7 @@ void
 ExpatHandler::characters (const XML_Char* chars, int length)
 {
   XMLToken data( string(chars, length) );
-  mHandler.characters(data);
+  mHandler.characters( std::move(data) );
 }
 
 
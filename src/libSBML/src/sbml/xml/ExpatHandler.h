@@ -51,6 +51,7 @@
 #include <expat.h>
 #include <sbml/xml/XMLHandler.h>
 #include <sbml/xml/XMLNamespaces.h>
+#include <sbml/xml/XMLSymbolTable.h>
 #include <sbml/xml/XMLError.h>
 
 
@@ -175,6 +176,9 @@ protected:
   XMLHandler&   mHandler;
   XMLNamespaces mNamespaces;
 
+  /* The element and attribute names seen so far. */
+  XMLSymbolTable mSymbols;
+
   XMLError*     mHandlerError;
 
 };
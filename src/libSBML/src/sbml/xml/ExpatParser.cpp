@@ -47,7 +47,6 @@
 #include <sstream>
 #include <cstring>
 
-#include <sbml/xml/XMLFileBuffer.h>
 #include <sbml/xml/XMLMemoryBuffer.h>
 #include <sbml/xml/XMLErrorLog.h>
 
@@ -60,8 +59,6 @@ using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-static const int BUFFER_SIZE = 8192;
-
 /*
  * Expat's error messages are conveniently defined as a consecutive
  * sequence starting from 0.  This makes a translation table easy to
@@ -168,8 +165,9 @@ ExpatParser::ExpatParser (XMLHandler& handler) :
  , mHandler( mParser, handler )
  , mBuffer ( NULL )
  , mSource ( NULL )
+ , mChunkSize( XMLParser::getChunkSize() )
 {
-  if (mParser != NULL) mBuffer = XML_GetBuffer(mParser, BUFFER_SIZE);
+  if (mParser != NULL) mBuffer = XML_GetBuffer(mParser, mChunkSize);
 }
 
 
@@ -276,7 +274,7 @@ ExpatParser::parseFirst (const char* content, bool isFile)
   {
     try
     {
-      mSource = new XMLFileBuffer(content);
+      mSource = createFileBuffer(content);
     }
     catch ( ZlibNotLinked& )
     {
@@ -334,7 +332,19 @@ ExpatParser::parseNext ()
 {
   if ( error() ) return false;
 
-  mBuffer = XML_GetBuffer(mParser, BUFFER_SIZE);
+  // Buffers that hold their content in memory hand it to expat directly.
+  // XML_Parse only copies it when expat keeps context bytes around the
+  // parse position (XML_CONTEXT_BYTES, the expat default).
+
+  unsigned int bytes = mChunkSize;
+  const char*  chunk = mSource->getChunk(bytes);
+
+  if ( chunk != NULL )
+  {
+    return parseChunk(chunk, bytes);
+  }
+
+  mBuffer = XML_GetBuffer(mParser, mChunkSize);
 
   if ( mBuffer == NULL )
   {
@@ -357,12 +367,42 @@ ExpatParser::parseNext ()
     return false;
   }
 
-  int bytes = mSource->copyTo(mBuffer, BUFFER_SIZE);
-  int done  = (bytes == 0);
+  bytes = mSource->copyTo(mBuffer, mChunkSize);
+
+  // A file that cannot be read (or decompressed) to its end must not be
+  // parsed as if it ended there.
+  if ( mSource->error() )
+  {
+    reportError(XMLFileUnreadable,
+                "The file could not be read to its end; it may be damaged.",
+                XML_GetCurrentLineNumber(mParser),
+                XML_GetCurrentColumnNumber(mParser));
+    return false;
+  }
+
+  return parseChunk(NULL, bytes);
+}
+
+
+/*
+ * Parses the given bytes, or if chunk is NULL the bytes placed in the
+ * buffer returned by XML_GetBuffer.  No bytes mean the end of the content.
+ *
+ * @return @c true if there is more content to parse, @c false at the end
+ * or on an error.
+ */
+bool
+ExpatParser::parseChunk (const char* chunk, unsigned int bytes)
+{
+  const int done = (bytes == 0);
 
   // Attempt to parse the content, checking for the Expat return status.
 
-  if ( XML_ParseBuffer(mParser, bytes, done) == XML_STATUS_ERROR )
+  const XML_Status status = (chunk != NULL)
+                          ? XML_Parse(mParser, chunk, (int) bytes, done)
+                          : XML_ParseBuffer(mParser, (int) bytes, done);
+
+  if ( status == XML_STATUS_ERROR )
   {
     reportError(translateError(XML_GetErrorCode(mParser)), "",
 		XML_GetCurrentLineNumber(mParser),
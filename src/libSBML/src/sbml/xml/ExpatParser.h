@@ -153,10 +153,18 @@ protected:
   ExpatHandler  mHandler;
   void*         mBuffer;
   XMLBuffer*    mSource;
+  unsigned int  mChunkSize;
 
 
 private:
 
+  /**
+   * Parses the given bytes, or if chunk is NULL the bytes placed in the
+   * buffer returned by XML_GetBuffer.
+   */
+  bool parseChunk (const char* chunk, unsigned int bytes);
+
+
   /**
    * Log or otherwise report the given error.
    *
@@ -41,6 +41,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <utility>
+
 #include <sbml/xml/XMLHandler.h>
 #include <sbml/xml/XMLTriple.h>
 #include <sbml/xml/XMLToken.h>
@@ -182,6 +184,7 @@ LibXMLHandler::LibXMLHandler (const LibXMLHandler& other)
   : mHandler (other.mHandler)
   , mContext (other.mContext)
   , mLocator (other.mLocator)
+  , mSymbols (other.mSymbols)
 {
 }
 
@@ -196,6 +199,7 @@ LibXMLHandler& LibXMLHandler::operator=(const LibXMLHandler& other)
   mHandler = other.mHandler;
   mContext = other.mContext; 
   mLocator = other.mLocator;
+  mSymbols = other.mSymbols;
 
   return *this;
 }
@@ -243,11 +247,12 @@ LibXMLHandler::startElement (  const xmlChar*           localname
   const string name     = LibXMLTranscode( localname );
   const string nsprefix = LibXMLTranscode( prefix    );
 
-  const XMLTriple  triple ( name, nsuri, nsprefix );
-  const XMLToken   element( triple, attributes, namespaces,
+  const XMLTriple  triple ( mSymbols.intern(name), mSymbols.intern(nsuri),
+                            mSymbols.intern(nsprefix) );
+  XMLToken         element( triple, attributes, namespaces,
                             getLine(), getColumn() );
 
-  mHandler.startElement(element);
+  mHandler.startElement( std::move(element) );
 }
 
 
@@ -267,10 +272,11 @@ LibXMLHandler::endElement (  const xmlChar*   localname
   const string name     = LibXMLTranscode( localname );
   const string nsprefix = LibXMLTranscode( prefix    );
 
-  const XMLTriple  triple ( name, nsuri, nsprefix );
-  const XMLToken   element( triple, getLine(), getColumn() );
+  XMLToken element( XMLTriple(mSymbols.intern(name), mSymbols.intern(nsuri),
+                              mSymbols.intern(nsprefix)),
+                    getLine(), getColumn() );
 
-  mHandler.endElement(element);
+  mHandler.endElement( std::move(element) );
 }
 
 
@@ -294,7 +300,7 @@ void
 LibXMLHandler::characters (const xmlChar* chars, int length)
 {
   XMLToken data( LibXMLTranscode(chars, length) );
-  mHandler.characters(data);
+  mHandler.characters( std::move(data) );
 }
 
 
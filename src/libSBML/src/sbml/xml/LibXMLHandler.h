@@ -47,6 +47,7 @@
 #include <libxml/parser.h>
 
 #include <sbml/xml/XMLHandler.h>
+#include <sbml/xml/XMLSymbolTable.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -183,6 +184,9 @@ protected:
   XMLHandler&          mHandler;
   xmlParserCtxt*       mContext;
   const xmlSAXLocator* mLocator;
+
+  /* The element names seen so far. */
+  XMLSymbolTable       mSymbols;
 };
 
 LIBSBML_CPP_NAMESPACE_END
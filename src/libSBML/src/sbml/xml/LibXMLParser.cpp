@@ -46,7 +46,6 @@
 
 #include <libxml/xmlerror.h>
 
-#include <sbml/xml/XMLFileBuffer.h>
 #include <sbml/xml/XMLMemoryBuffer.h>
 
 #include <sbml/xml/LibXMLHandler.h>
@@ -59,8 +58,6 @@ using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-static const int BUFFER_SIZE = 8192;
-
 /*
  * Table mapping libXML error codes to ours.  The error code numbers are not
  * contiguous, hence the table has to map pairs of numbers rather than
@@ -243,10 +240,11 @@ LibXMLParser::reportError (const XMLErrorCode_t code,
  * of parse events and errors.
  */
 LibXMLParser::LibXMLParser (XMLHandler& handler) :
-   mParser ( NULL                  )
- , mHandler( handler               )
- , mBuffer ( new char[BUFFER_SIZE] )
- , mSource ( NULL                  )
+   mParser   ( NULL                          )
+ , mHandler  ( handler                       )
+ , mChunkSize( XMLParser::getChunkSize()     )
+ , mBuffer   ( new char[mChunkSize]          )
+ , mSource   ( NULL                          )
 {
   xmlSAXHandler* sax  = LibXMLHandler::getInternalHandler();
   void*          data = static_cast<void*>(&mHandler);
@@ -353,7 +351,7 @@ LibXMLParser::parseFirst (const char* content, bool isFile)
   {
     try
     {
-      mSource = new XMLFileBuffer(content);
+      mSource = createFileBuffer(content);
     }
     catch ( ZlibNotLinked& )
     {
@@ -412,17 +410,29 @@ LibXMLParser::parseNext ()
 {
   if ( error() ) return false;
 
-  int bytes = (int)mSource->copyTo(mBuffer, BUFFER_SIZE);
+  // Buffers that hold their content in memory hand it over directly.
+  unsigned int bytes = mChunkSize;
+  const char*  chunk = mSource->getChunk(bytes);
+
+  if (chunk == NULL)
+  {
+    bytes = mSource->copyTo(mBuffer, mChunkSize);
+    chunk = mBuffer;
+  }
+
   int done  = (bytes == 0);
 
+  // A file that cannot be read (or decompressed) to its end must not be
+  // parsed as if it ended there.
   if ( mSource->error() )
   {
-    reportError(InternalXMLParserError,
-		"error: Could not read from source buffer.");
+    reportError(XMLFileUnreadable,
+                "The file could not be read to its end; it may be damaged.",
+                getLine(), getColumn());
     return false;
   }
 
-  if ( xmlParseChunk(mParser, mBuffer, bytes, done) )
+  if ( xmlParseChunk(mParser, chunk, (int)bytes, done) )
   {
     const xmlError* libxmlError = xmlGetLastError();
 
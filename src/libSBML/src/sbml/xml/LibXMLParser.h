@@ -147,6 +147,7 @@ protected:
 
   xmlParserCtxt*  mParser;
   LibXMLHandler   mHandler;
+  unsigned int    mChunkSize;
   char*           mBuffer;
   XMLBuffer*      mSource;
 
@@ -44,10 +44,12 @@
 #include <cstdlib>
 #include <limits>
 #include <sstream>
+#include <utility>
 
 #include <sbml/xml/XMLErrorLog.h>
 #include <sbml/xml/XMLConstructorException.h>
 #include <sbml/xml/XMLAttributes.h>
+#include <sbml/xml/XMLSymbolTable.h>
 /** @cond doxygenLibsbmlInternal */
 #include <sbml/xml/XMLOutputStream.h>
 #include <sbml/util/util.h>
@@ -118,6 +120,38 @@ XMLAttributes::operator=(const XMLAttributes& rhs)
   return *this;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Move constructor.
+ */
+XMLAttributes::XMLAttributes(XMLAttributes&& orig)
+ : mNames(std::move(orig.mNames))
+ , mValues(std::move(orig.mValues))
+ , mElementName(std::move(orig.mElementName))
+ , mLog(orig.mLog)
+{
+}
+
+
+/*
+ * Move assignment operator.
+ */
+XMLAttributes&
+XMLAttributes::operator=(XMLAttributes&& rhs)
+{
+  if(&rhs!=this)
+  {
+    this->mNames = std::move(rhs.mNames);
+    this->mValues = std::move(rhs.mValues);
+    this->mElementName = std::move(rhs.mElementName);
+    this->mLog = rhs.mLog;
+  }
+
+  return *this;
+}
+/** @endcond */
+
 /*
  * Creates and returns a deep copy of this XMLAttributes set.
  * 
@@ -268,9 +302,10 @@ XMLAttributes::clear()
 int
 XMLAttributes::getIndex (const std::string& name) const
 {
-  for (int index = 0; index < getLength(); ++index)
+  for (size_t index = 0; index < mNames.size(); ++index)
   {
-    if (getName(index) == name) return index;
+    if (XMLSymbolTable::equal(mNames[index].getName(), name))
+      return (int)index;
   }
   
   return -1;
@@ -286,9 +321,11 @@ XMLAttributes::getIndex (const std::string& name) const
 int
 XMLAttributes::getIndex (const std::string& name, const std::string& uri) const
 {
-  for (int index = 0; index < getLength(); ++index)
+  for (size_t index = 0; index < mNames.size(); ++index)
   {
-    if ( (getName(index) == name) && (getURI(index) == uri) ) return index;
+    if ( XMLSymbolTable::equal(mNames[index].getName(), name) &&
+         XMLSymbolTable::equal(mNames[index].getURI(), uri) )
+      return (int)index;
   }
   
   return -1;
@@ -286,6 +286,27 @@ public:
   XMLAttributes& operator=(const XMLAttributes& rhs);
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Move constructor; takes over the contents of @p orig, which is left
+   * empty.
+   *
+   * @param orig the XMLAttributes object to move from.
+   */
+  XMLAttributes(XMLAttributes&& orig);
+
+
+  /**
+   * Move assignment operator for XMLAttributes.
+   *
+   * @param rhs the XMLAttributes object whose contents are moved into this one.
+   */
+  XMLAttributes& operator=(XMLAttributes&& rhs);
+  /** @endcond */
+#endif  /* !SWIG */
+
+
   /**
    * Creates and returns a deep copy of this XMLAttributes object.
    *
@@ -41,6 +41,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstddef>
+
 #include <sbml/xml/XMLBuffer.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -60,5 +62,16 @@ XMLBuffer::~XMLBuffer ()
 {
 }
 
+
+/*
+ * @return a pointer to at most bytes of the content, or NULL if this
+ * XMLBuffer can not hand out its content in place.
+ */
+const char*
+XMLBuffer::getChunk (unsigned int& /* bytes */)
+{
+  return NULL;
+}
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
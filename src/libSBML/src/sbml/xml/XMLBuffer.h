@@ -67,6 +67,21 @@ public:
   virtual unsigned int copyTo (void* destination, unsigned int bytes) = 0;
 
 
+  /**
+   * Returns a pointer to at most bytes of the content that follows what
+   * was read before, without copying it, and sets bytes to the number of
+   * bytes available there (0 at the end).  The content is consumed as if
+   * it had been copied, and stays valid as long as this XMLBuffer.
+   *
+   * Buffers that have no content in memory return NULL and consume
+   * nothing; the caller then reads with copyTo().  This default
+   * implementation always returns NULL.
+   *
+   * @return a pointer to the content or NULL.
+   */
+  virtual const char* getChunk (unsigned int& bytes);
+
+
   /**
    * Returns @c true if there was an error reading from the underlying buffer,
    * @c false otherwise.
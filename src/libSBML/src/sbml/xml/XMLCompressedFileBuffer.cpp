@@ -0,0 +1,244 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLCompressedFileBuffer.cpp
+ * @brief   XMLCompressedFileBuffer implements the XMLBuffer interface for compressed files
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ */
+
+#include <climits>
+
+#include <sbml/xml/XMLCompressedFileBuffer.h>
+#include <sbml/compress/CompressCommon.h>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#include <sbml/compress/zipfstream.h>
+#endif //USE_ZLIB
+
+#ifdef USE_BZ2
+#include <bzlib.h>
+#endif //USE_BZ2
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * @return true if the name ends with the given extension.
+ */
+static bool
+endsWith (const string& filename, const char* extension, size_t length)
+{
+  return filename.length() >= length
+      && filename.compare(filename.length() - length, length, extension) == 0;
+}
+
+
+/*
+ * Creates a XMLCompressedFileBuffer for the given file.
+ */
+XMLCompressedFileBuffer::XMLCompressedFileBuffer (const string& filename) :
+   mFormat( GZIP  )
+ , mFile  ( NULL  )
+ , mError ( false )
+{
+  if ( endsWith(filename, ".bz2", 4) )
+  {
+    mFormat = BZIP2;
+#ifdef USE_BZ2
+    mFile = BZ2_bzopen(filename.c_str(), "rb");
+#else
+    throw Bzip2NotLinked();
+#endif
+  }
+  else
+  {
+    mFormat = endsWith(filename, ".zip", 4) ? ZIP : GZIP;
+#ifdef USE_ZLIB
+    if (mFormat == ZIP)
+    {
+      mFile = unzipopen(filename.c_str());
+    }
+    else
+    {
+      gzFile file = gzopen(filename.c_str(), "rb");
+#if ZLIB_VERNUM >= 0x1240
+      // a larger read buffer than the default of 8 KiB, so that a chunk of
+      // the parser is filled with few reads
+      if (file != NULL) gzbuffer(file, 131072);
+#endif
+      mFile = file;
+    }
+#else
+    throw ZlibNotLinked();
+#endif
+  }
+
+  mError = (mFile == NULL);
+}
+
+
+/*
+ * Destroys this XMLCompressedFileBuffer and closes the underlying file.
+ */
+XMLCompressedFileBuffer::~XMLCompressedFileBuffer ()
+{
+  if (mFile == NULL) return;
+
+  switch (mFormat)
+  {
+#ifdef USE_ZLIB
+  case GZIP:
+    gzclose(static_cast<gzFile>(mFile));
+    break;
+
+  case ZIP:
+    unzipclose(static_cast<unzFile>(mFile));
+    break;
+#endif
+
+#ifdef USE_BZ2
+  case BZIP2:
+    BZ2_bzclose(static_cast<BZFILE*>(mFile));
+    break;
+#endif
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Decompresses at most bytes; returns the number of bytes or a negative
+ * number on an error.
+ */
+int
+XMLCompressedFileBuffer::read (char* destination, unsigned int bytes)
+{
+  if (bytes > INT_MAX) bytes = INT_MAX;
+
+  switch (mFormat)
+  {
+#ifdef USE_ZLIB
+  case GZIP:
+  {
+    // gzread reports a stream cut short, or a bad check value at its end,
+    // as the end of the file; gzerror tells them apart
+    const int n = gzread(static_cast<gzFile>(mFile), destination, bytes);
+    int err = Z_OK;
+    if (n == 0) gzerror(static_cast<gzFile>(mFile), &err);
+    return (err == Z_OK) ? n : -1;
+  }
+
+  case ZIP:
+    return unzipread(static_cast<unzFile>(mFile), destination, bytes);
+#endif
+
+#ifdef USE_BZ2
+  case BZIP2:
+    return BZ2_bzread(static_cast<BZFILE*>(mFile), destination, (int) bytes);
+#endif
+
+  default:
+    return -1;
+  }
+}
+
+
+/*
+ * Decompresses at most nbytes from this XMLCompressedFileBuffer to the
+ * memory pointed to by destination.
+ *
+ * @return the number of bytes actually copied (may be 0).
+ */
+unsigned int
+XMLCompressedFileBuffer::copyTo (void* destination, unsigned int bytes)
+{
+  if (mError) return 0;
+
+  // The decompressors may return less than asked for before the end, e.g.
+  // at the end of a bzip2 block, so fill the destination as far as possible.
+
+  char*        buffer = static_cast<char*>(destination);
+  unsigned int copied = 0;
+
+  while (copied < bytes)
+  {
+    const int n = read(buffer + copied, bytes - copied);
+
+    if (n < 0)
+    {
+      mError = true;
+      break;
+    }
+
+    if (n == 0) break;
+
+    copied += (unsigned int) n;
+  }
+
+  return copied;
+}
+
+
+/*
+ * @return @c true if there was an error reading from the underlying file,
+ * @c false otherwise.
+ */
+bool
+XMLCompressedFileBuffer::error ()
+{
+  return mError;
+}
+
+
+/*
+ * @return true if the given file name ends with .gz, .bz2 or .zip.
+ */
+bool
+XMLCompressedFileBuffer::isCompressed (const string& filename)
+{
+  return endsWith(filename, ".gz",  3)
+      || endsWith(filename, ".bz2", 4)
+      || endsWith(filename, ".zip", 4);
+}
+
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
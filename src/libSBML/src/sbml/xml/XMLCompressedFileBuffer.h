@@ -0,0 +1,135 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLCompressedFileBuffer.h
+ * @brief   XMLCompressedFileBuffer implements the XMLBuffer interface for compressed files
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ *
+ * @class XMLCompressedFileBuffer
+ * @sbmlbrief{core} Decompressing input for an XML parser.
+ *
+ * @ifnot clike @internal @endif@~
+ *
+ * An XMLCompressedFileBuffer decompresses a gzip, bzip2 or zip file while
+ * the parser reads it: each call of copyTo() inflates the next bytes
+ * straight into the parser's buffer, so the decompressed document is never
+ * held in memory as a whole.  Zip archives are read from their first
+ * entry.
+ */
+
+#ifndef XMLCompressedFileBuffer_h
+#define XMLCompressedFileBuffer_h
+
+#ifdef __cplusplus
+
+#include <string>
+
+#include <sbml/xml/XMLBuffer.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class XMLCompressedFileBuffer : public XMLBuffer
+{
+public:
+
+  /**
+   * Creates a XMLCompressedFileBuffer for the given file.  The format is
+   * chosen by the extension of the file name (see isCompressed()).
+   *
+   * @note ZlibNotLinked or Bzip2NotLinked is thrown if libSBML is not
+   * linked with the library needed for the format.
+   */
+  XMLCompressedFileBuffer (const std::string& filename);
+
+
+  /**
+   * Destroys this XMLCompressedFileBuffer and closes the underlying file.
+   */
+  virtual ~XMLCompressedFileBuffer ();
+
+
+  /**
+   * Decompresses at most nbytes from this XMLCompressedFileBuffer to the
+   * memory pointed to by destination.
+   *
+   * @return the number of bytes actually copied; 0 at the end, or after an
+   * error, which error() tells apart.
+   */
+  virtual unsigned int copyTo (void* destination, unsigned int bytes);
+
+
+  /**
+   * Returns @c true if the file could not be opened or its content could
+   * not be decompressed, @c false otherwise.
+   *
+   * @return @c true if there was an error reading from the underlying
+   * file, @c false otherwise.
+   */
+  virtual bool error ();
+
+
+  /**
+   * Returns @c true if the given file name ends with .gz, .bz2 or .zip,
+   * i.e. if the file is read by an XMLCompressedFileBuffer.
+   */
+  static bool isCompressed (const std::string& filename);
+
+
+private:
+
+  XMLCompressedFileBuffer ();
+  XMLCompressedFileBuffer (const XMLCompressedFileBuffer&);
+  XMLCompressedFileBuffer& operator= (const XMLCompressedFileBuffer&);
+
+  /**
+   * Decompresses at most bytes; returns the number of bytes or a
+   * negative number on an error.
+   */
+  int read (char* destination, unsigned int bytes);
+
+  enum Format { GZIP, BZIP2, ZIP };
+
+  Format  mFormat;
+  void*   mFile;
+  bool    mError;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* XMLCompressedFileBuffer_h */
+/** @endcond */
@@ -154,5 +154,43 @@ XMLHandler::characters (const XMLToken& )
 {
 }
 
+
+/*
+ * Receive notification of the start of an element the handler may take
+ * over.
+ *
+ * By default, calls startElement(const XMLToken&).
+ */
+void
+XMLHandler::startElement (XMLToken&& element)
+{
+  startElement(static_cast<const XMLToken&>(element));
+}
+
+
+/*
+ * Receive notification of the end of an element the handler may take
+ * over.
+ *
+ * By default, calls endElement(const XMLToken&).
+ */
+void
+XMLHandler::endElement (XMLToken&& element)
+{
+  endElement(static_cast<const XMLToken&>(element));
+}
+
+
+/*
+ * Receive notification of character data the handler may take over.
+ *
+ * By default, calls characters(const XMLToken&).
+ */
+void
+XMLHandler::characters (XMLToken&& data)
+{
+  characters(static_cast<const XMLToken&>(data));
+}
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
@@ -145,6 +145,35 @@ public:
    * to take specific actions for each chunk of character data.
    */
   virtual void characters (const XMLToken& data);
+
+
+#ifndef SWIG
+  /**
+   * Receive notification of the start of an element the handler may take
+   * over, since the parser does not use it afterwards.
+   *
+   * By default, calls startElement(const XMLToken&).  Handlers that keep
+   * the tokens override this method to move them instead of copying.
+   */
+  virtual void startElement (XMLToken&& element);
+
+
+  /**
+   * Receive notification of the end of an element the handler may take
+   * over.
+   *
+   * By default, calls endElement(const XMLToken&).
+   */
+  virtual void endElement (XMLToken&& element);
+
+
+  /**
+   * Receive notification of character data the handler may take over.
+   *
+   * By default, calls characters(const XMLToken&).
+   */
+  virtual void characters (XMLToken&& data);
+#endif  /* !SWIG */
 };
 
 LIBSBML_CPP_NAMESPACE_END
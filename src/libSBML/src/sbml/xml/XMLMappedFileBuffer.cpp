@@ -0,0 +1,236 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLMappedFileBuffer.cpp
+ * @brief   XMLMappedFileBuffer implements the XMLBuffer interface for mapped files
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ */
+
+#include <cstring>
+
+#if defined (WIN32) && !defined (CYGWIN)
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <windows.h>
+
+#else
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#endif
+
+#include <sbml/xml/XMLMappedFileBuffer.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+#if defined (WIN32) && !defined (CYGWIN)
+
+/*
+ * Creates a XMLMappedFileBuffer for the given file and maps the whole file
+ * into memory for reading.
+ */
+XMLMappedFileBuffer::XMLMappedFileBuffer (const string& filename) :
+   mData   ( NULL  )
+ , mLength ( 0     )
+ , mOffset ( 0     )
+ , mError  ( true  )
+ , mFile   ( INVALID_HANDLE_VALUE )
+ , mMapping( NULL  )
+{
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                            NULL);
+  if (file == INVALID_HANDLE_VALUE) return;
+
+  mFile = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || GetFileType(file) != FILE_TYPE_DISK)
+  {
+    return;
+  }
+
+  // an empty file can not be mapped, but there is nothing to read either
+  mLength = (size_t) size.QuadPart;
+  if (mLength == 0)
+  {
+    mError = false;
+    return;
+  }
+
+  mMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mMapping == NULL) return;
+
+  mData  = (const char*) MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+  mError = (mData == NULL);
+}
+
+
+/*
+ * Destroys this XMLMappedFileBuffer and unmaps the file.
+ */
+XMLMappedFileBuffer::~XMLMappedFileBuffer ()
+{
+  if (mData    != NULL) UnmapViewOfFile(mData);
+  if (mMapping != NULL) CloseHandle(mMapping);
+  if (mFile    != INVALID_HANDLE_VALUE) CloseHandle(mFile);
+}
+
+#else
+
+/*
+ * Creates a XMLMappedFileBuffer for the given file and maps the whole file
+ * into memory for reading.
+ */
+XMLMappedFileBuffer::XMLMappedFileBuffer (const string& filename) :
+   mData   ( NULL  )
+ , mLength ( 0     )
+ , mOffset ( 0     )
+ , mError  ( true  )
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat info;
+  if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+  {
+    mLength = (size_t) info.st_size;
+
+    // an empty file can not be mapped, but there is nothing to read either
+    if (mLength == 0)
+    {
+      mError = false;
+    }
+    else
+    {
+      void* data = mmap(NULL, mLength, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (data != MAP_FAILED)
+      {
+#ifdef MADV_SEQUENTIAL
+        madvise(data, mLength, MADV_SEQUENTIAL);
+#endif
+        mData  = static_cast<const char*>(data);
+        mError = false;
+      }
+    }
+  }
+
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+}
+
+
+/*
+ * Destroys this XMLMappedFileBuffer and unmaps the file.
+ */
+XMLMappedFileBuffer::~XMLMappedFileBuffer ()
+{
+  if (mData != NULL) munmap(const_cast<char*>(mData), mLength);
+}
+
+#endif
+
+
+/*
+ * Copies at most nbytes from this XMLMappedFileBuffer to the memory pointed
+ * to by destination.
+ *
+ * @return the number of bytes actually copied (may be 0).
+ */
+unsigned int
+XMLMappedFileBuffer::copyTo (void* destination, unsigned int bytes)
+{
+  const char* chunk = getChunk(bytes);
+
+  if (bytes > 0) memcpy(destination, chunk, bytes);
+
+  return bytes;
+}
+
+
+/*
+ * @return a pointer to at most bytes of the mapped file.
+ */
+const char*
+XMLMappedFileBuffer::getChunk (unsigned int& bytes)
+{
+  if (mError || mOffset >= mLength)
+  {
+    bytes = 0;
+    return (mData != NULL) ? mData + mLength : "";
+  }
+
+  if (bytes > mLength - mOffset) bytes = (unsigned int)(mLength - mOffset);
+
+  const char* chunk = mData + mOffset;
+  mOffset += bytes;
+
+  return chunk;
+}
+
+
+/*
+ * @return @c true if the file could not be mapped, @c false otherwise.
+ */
+bool
+XMLMappedFileBuffer::error ()
+{
+  return mError;
+}
+
+
+/*
+ * @return the size of the mapped file in bytes.
+ */
+size_t
+XMLMappedFileBuffer::getLength () const
+{
+  return mLength;
+}
+
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
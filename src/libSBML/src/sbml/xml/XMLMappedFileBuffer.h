@@ -0,0 +1,136 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLMappedFileBuffer.h
+ * @brief   XMLMappedFileBuffer implements the XMLBuffer interface for mapped files
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ *
+ * @class XMLMappedFileBuffer
+ * @sbmlbrief{core} Memory-mapped input for an XML parser.
+ *
+ * @ifnot clike @internal @endif@~
+ *
+ * An XMLMappedFileBuffer maps an uncompressed file into memory and hands
+ * the parser pointers into the mapping (see XMLBuffer::getChunk()), so the
+ * content is neither read through a stream nor copied to a buffer of its
+ * own.  Files that can not be mapped, e.g. pipes, set error(); the caller
+ * then falls back to an XMLFileBuffer.
+ */
+
+#ifndef XMLMappedFileBuffer_h
+#define XMLMappedFileBuffer_h
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <string>
+
+#include <sbml/xml/XMLBuffer.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class XMLMappedFileBuffer : public XMLBuffer
+{
+public:
+
+  /**
+   * Creates a XMLMappedFileBuffer for the given file and maps the whole
+   * file into memory for reading.
+   */
+  XMLMappedFileBuffer (const std::string& filename);
+
+
+  /**
+   * Destroys this XMLMappedFileBuffer and unmaps the file.
+   */
+  virtual ~XMLMappedFileBuffer ();
+
+
+  /**
+   * Copies at most nbytes from this XMLMappedFileBuffer to the memory
+   * pointed to by destination.
+   *
+   * @return the number of bytes actually copied (may be 0).
+   */
+  virtual unsigned int copyTo (void* destination, unsigned int bytes);
+
+
+  /**
+   * Returns a pointer to at most bytes of the mapped file, without copying
+   * them, and sets bytes to the number of bytes available.
+   *
+   * @return a pointer into the mapping.
+   */
+  virtual const char* getChunk (unsigned int& bytes);
+
+
+  /**
+   * Returns @c true if the file could not be mapped, @c false otherwise.
+   *
+   * @return @c true if the file could not be mapped, @c false otherwise.
+   */
+  virtual bool error ();
+
+
+  /**
+   * Returns the size of the mapped file in bytes.
+   */
+  size_t getLength () const;
+
+
+private:
+
+  XMLMappedFileBuffer ();
+  XMLMappedFileBuffer (const XMLMappedFileBuffer&);
+  XMLMappedFileBuffer& operator= (const XMLMappedFileBuffer&);
+
+  const char*  mData;
+  size_t       mLength;
+  size_t       mOffset;
+  bool         mError;
+
+#if defined (WIN32) && !defined (CYGWIN)
+  void*        mFile;
+  void*        mMapping;
+#endif
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* XMLMappedFileBuffer_h */
+/** @endcond */
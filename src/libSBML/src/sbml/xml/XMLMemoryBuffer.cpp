@@ -97,6 +97,27 @@ XMLMemoryBuffer::copyTo (void* destination, unsigned int bytes)
 }
 
 
+/*
+ * @return a pointer to at most bytes of the buffer.
+ */
+const char*
+XMLMemoryBuffer::getChunk (unsigned int& bytes)
+{
+  if (mBuffer == NULL || mOffset >= mLength)
+  {
+    bytes = 0;
+    return mBuffer;
+  }
+
+  if (bytes > mLength - mOffset) bytes = mLength - mOffset;
+
+  const char* chunk = mBuffer + mOffset;
+  mOffset += bytes;
+
+  return chunk;
+}
+
+
 /*
  * @return @c true if there was an error reading from the underlying buffer
  * (i.e. it's null), false otherwise.
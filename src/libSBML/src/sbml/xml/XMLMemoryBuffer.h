@@ -76,6 +76,15 @@ public:
   virtual unsigned int copyTo (void* destination, unsigned int bytes);
 
 
+  /**
+   * Returns a pointer to at most bytes of the buffer, without copying
+   * them, and sets bytes to the number of bytes available.
+   *
+   * @return a pointer into the buffer.
+   */
+  virtual const char* getChunk (unsigned int& bytes);
+
+
   /**
    * Returns @c true if there was an error reading from the underlying buffer
    * (i.e. it's null), @c false otherwise.
@@ -39,6 +39,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <utility>
+
 /** @cond doxygenLibsbmlInternal */
 #include <sbml/xml/XMLOutputStream.h>
 #include <sbml/util/util.h>
@@ -98,6 +100,32 @@ XMLNamespaces::operator=(const XMLNamespaces& rhs)
   return *this;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Move constructor.
+ */
+XMLNamespaces::XMLNamespaces(XMLNamespaces&& orig)
+ : mNamespaces(std::move(orig.mNamespaces))
+{
+}
+
+
+/*
+ * Move assignment operator.
+ */
+XMLNamespaces&
+XMLNamespaces::operator=(XMLNamespaces&& rhs)
+{
+  if(&rhs!=this)
+  {
+    mNamespaces = std::move(rhs.mNamespaces);
+  }
+  
+  return *this;
+}
+/** @endcond */
+
 /*
  * Creates and returns a deep copy of this XMLNamespaces set.
  * 
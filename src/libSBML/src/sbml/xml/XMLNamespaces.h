@@ -119,6 +119,27 @@ public:
   XMLNamespaces& operator=(const XMLNamespaces& rhs);
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Move constructor; takes over the contents of @p orig, which is left
+   * empty.
+   *
+   * @param orig the XMLNamespaces list to move from.
+   */
+  XMLNamespaces(XMLNamespaces&& orig);
+
+
+  /**
+   * Move assignment operator for XMLNamespaces.
+   *
+   * @param rhs the XMLNamespaces list whose contents are moved into this one.
+   */
+  XMLNamespaces& operator=(XMLNamespaces&& rhs);
+  /** @endcond */
+#endif  /* !SWIG */
+
+
   /**
    * Creates and returns a deep copy of this XMLNamespaces object.
    *
@@ -56,13 +56,21 @@
 #include <sbml/xml/XercesParser.h>
 #endif
 
+#include <sbml/xml/XMLCompressedFileBuffer.h>
 #include <sbml/xml/XMLErrorLog.h>
+#include <sbml/xml/XMLFileBuffer.h>
+#include <sbml/xml/XMLMappedFileBuffer.h>
 #include <sbml/xml/XMLParser.h>
 
 using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+static const unsigned int DEFAULT_CHUNK_SIZE = 65536;
+
+static unsigned int sChunkSize      = DEFAULT_CHUNK_SIZE;
+static bool         sUseMappedFiles = true;
+
 /*
  * Creates a new XMLParser.  The parser will notify the given XMLHandler
  * of parse events and errors.
@@ -140,5 +148,73 @@ XMLParser::setErrorLog (XMLErrorLog* log)
 }
 
 
+/*
+ * Creates the XMLBuffer a progressive parse reads the given file from.
+ */
+XMLBuffer*
+XMLParser::createFileBuffer (const string& filename)
+{
+  if (XMLCompressedFileBuffer::isCompressed(filename))
+  {
+    return new XMLCompressedFileBuffer(filename);
+  }
+
+  // Mapped files reach the parser without being read through a stream
+  // first.  Files that can not be mapped, e.g. pipes, are read as before.
+  if (sUseMappedFiles)
+  {
+    XMLBuffer* mapped = new XMLMappedFileBuffer(filename);
+
+    if (!mapped->error()) return mapped;
+
+    delete mapped;
+  }
+
+  return new XMLFileBuffer(filename);
+}
+
+
+/*
+ * Sets the number of bytes a progressive parse hands to the underlying
+ * XML library at a time; 0 restores the default.
+ */
+void
+XMLParser::setChunkSize (unsigned int bytes)
+{
+  sChunkSize = (bytes == 0) ? DEFAULT_CHUNK_SIZE : bytes;
+}
+
+
+/*
+ * @return the number of bytes a progressive parse hands to the underlying
+ * XML library at a time.
+ */
+unsigned int
+XMLParser::getChunkSize ()
+{
+  return sChunkSize;
+}
+
+
+/*
+ * Sets whether uncompressed files are mapped into memory.
+ */
+void
+XMLParser::setUseMappedFiles (bool useMappedFiles)
+{
+  sUseMappedFiles = useMappedFiles;
+}
+
+
+/*
+ * @return whether uncompressed files are mapped into memory.
+ */
+bool
+XMLParser::getUseMappedFiles ()
+{
+  return sUseMappedFiles;
+}
+
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
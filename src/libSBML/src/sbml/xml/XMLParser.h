@@ -60,6 +60,7 @@
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+class XMLBuffer;
 class XMLErrorLog;
 class XMLHandler;
 
@@ -179,6 +180,47 @@ public:
   int setErrorLog (XMLErrorLog* log);
 
 
+  /**
+   * Sets the number of bytes a progressive parse hands to the underlying
+   * XML library with each call of parseNext(), for the parsers created
+   * afterwards.  Larger chunks mean fewer calls and fewer reads, but more
+   * tokens waiting between the calls, which costs memory.  A value of 0
+   * restores the default of 64 KiB.
+   *
+   * Currently used by the Expat and libXML parsers.
+   */
+  static void setChunkSize (unsigned int bytes);
+
+
+  /**
+   * Returns the number of bytes a progressive parse hands to the
+   * underlying XML library with each call of parseNext().
+   */
+  static unsigned int getChunkSize ();
+
+
+  /**
+   * Sets whether uncompressed files are mapped into memory and parsed in
+   * place (the default) rather than read through a stream, for the
+   * parses started afterwards.  Files that can not be mapped are always
+   * read through a stream.
+   *
+   * A mapped file must not be truncated while it is being parsed: reading
+   * the pages past its new end raises SIGBUS on POSIX systems (an
+   * in-page error exception on Windows), which terminates the program.
+   * Switch mapping off when files may be rewritten while they are read.
+   *
+   * Currently used by the Expat and libXML parsers.
+   */
+  static void setUseMappedFiles (bool useMappedFiles);
+
+
+  /**
+   * Returns whether uncompressed files are mapped into memory.
+   */
+  static bool getUseMappedFiles ();
+
+
 protected:
   /**
    * Creates a new XMLParser.  The parser will notify the given XMLHandler
@@ -189,6 +231,22 @@ protected:
    */
   XMLParser ();
 
+
+  /**
+   * Creates the XMLBuffer a progressive parse reads the given file from.
+   * Gzip, bzip2 and zip files are decompressed while they are read (see
+   * XMLCompressedFileBuffer), other files are mapped into memory if
+   * getUseMappedFiles() is @c true and they can be mapped, and read
+   * through a stream otherwise.
+   *
+   * The caller checks XMLBuffer::error() and owns the buffer.
+   *
+   * @note ZlibNotLinked or Bzip2NotLinked is thrown if libSBML is not
+   * linked with the library needed to decompress the file.
+   */
+  static XMLBuffer* createFileBuffer (const std::string& filename);
+
+
   XMLErrorLog* mErrorLog;
 };
 
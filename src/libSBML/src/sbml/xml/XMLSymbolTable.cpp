@@ -0,0 +1,272 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLSymbolTable.cpp
+ * @brief   Interned element and attribute names for an XML parser
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ */
+
+#include <cstring>
+#include <memory>
+
+#include <sbml/xml/XMLSymbolTable.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates a new, empty XMLSymbolTable.
+ */
+XMLSymbolTable::XMLSymbolTable ()
+{
+}
+
+
+/*
+ * Destroys this XMLSymbolTable.
+ */
+XMLSymbolTable::~XMLSymbolTable ()
+{
+}
+
+
+/*
+ * @return the symbol for the given characters, adding it to the table the
+ * first time it is seen.
+ */
+XMLTriple::Symbol
+XMLSymbolTable::intern (const char* chars, size_t length)
+{
+  if (length == 0) return XMLTriple::Symbol();
+
+  const size_t h = hash(chars, length);
+  XMLTriple::Symbol* symbol = mSymbols.find(chars, length, h);
+
+  if (symbol != NULL) return *symbol;
+
+  return mSymbols.insert(chars, length, h,
+                         std::make_shared<const string>(chars, length));
+}
+
+
+/*
+ * @return the symbol for the given string.
+ */
+XMLTriple::Symbol
+XMLSymbolTable::intern (const std::string& str)
+{
+  return intern(str.data(), str.size());
+}
+
+
+/*
+ * @return the XMLTriple for the given triplet, splitting it and interning
+ * its parts the first time it is seen.
+ */
+const XMLTriple&
+XMLSymbolTable::getTriple (const char* triplet, const char sepchar)
+{
+  const size_t length = strlen(triplet);
+  const size_t h      = hash(triplet, length);
+  XMLTriple*   triple = mTriples.find(triplet, length, h);
+
+  if (triple != NULL) return *triple;
+
+  //
+  // Split as XMLTriple(const std::string&, const char) does.
+  //
+  const char* end   = triplet + length;
+  const char* name  = triplet;
+  const char* pos   = (const char*) memchr(name, sepchar, length);
+
+  XMLTriple::Symbol uri;
+  XMLTriple::Symbol prefix;
+
+  if (pos != NULL)
+  {
+    uri  = intern(triplet, (size_t)(pos - triplet));
+    name = pos + 1;
+    pos  = (const char*) memchr(name, sepchar, (size_t)(end - name));
+
+    if (pos != NULL)
+    {
+      prefix = intern(pos + 1, (size_t)(end - pos - 1));
+      end    = pos;
+    }
+  }
+
+  return mTriples.insert(triplet, length, h,
+                         XMLTriple(intern(name, (size_t)(end - name)),
+                                   uri, prefix));
+}
+
+
+/*
+ * @return the number of distinct strings interned so far.
+ */
+unsigned int
+XMLSymbolTable::getNumSymbols () const
+{
+  return (unsigned int) mSymbols.size();
+}
+
+
+/*
+ * Removes all entries from the table.
+ */
+void
+XMLSymbolTable::clear ()
+{
+  mSymbols.clear();
+  mTriples.clear();
+}
+
+
+/*
+ * FNV-1a hash of the given characters.
+ */
+size_t
+XMLSymbolTable::hash (const char* chars, size_t length)
+{
+  size_t h = (size_t) 2166136261u;
+
+  for (size_t n = 0; n < length; ++n)
+  {
+    h ^= (unsigned char) chars[n];
+    h *= (size_t) 16777619u;
+  }
+
+  return h;
+}
+
+
+template <typename T>
+XMLSymbolTable::Map<T>::Map () :
+  mSize( 0 )
+{
+}
+
+
+/*
+ * Linear probing; the table is kept at most half full, so the search ends
+ * at an unused slot.
+ */
+template <typename T>
+T*
+XMLSymbolTable::Map<T>::find (const char* key, size_t length, size_t hash)
+{
+  if (mSlots.empty()) return NULL;
+
+  const size_t mask = mSlots.size() - 1;
+
+  for (size_t n = hash & mask; mSlots[n].used; n = (n + 1) & mask)
+  {
+    const Slot& slot = mSlots[n];
+
+    if (slot.hash == hash && slot.key.size() == length
+        && memcmp(slot.key.data(), key, length) == 0)
+    {
+      return &mSlots[n].value;
+    }
+  }
+
+  return NULL;
+}
+
+
+template <typename T>
+T&
+XMLSymbolTable::Map<T>::insert (const char* key, size_t length, size_t hash,
+                                const T& value)
+{
+  if (2 * (mSize + 1) > mSlots.size()) grow();
+
+  const size_t mask = mSlots.size() - 1;
+  size_t n = hash & mask;
+
+  while (mSlots[n].used) n = (n + 1) & mask;
+
+  Slot& slot = mSlots[n];
+  slot.key.assign(key, length);
+  slot.hash  = hash;
+  slot.used  = true;
+  slot.value = value;
+  ++mSize;
+
+  return slot.value;
+}
+
+
+/*
+ * Doubles the number of slots (a power of two) and rehashes.
+ */
+template <typename T>
+void
+XMLSymbolTable::Map<T>::grow ()
+{
+  std::vector<Slot> slots( mSlots.empty() ? 64 : 2 * mSlots.size() );
+  const size_t mask = slots.size() - 1;
+
+  for (size_t m = 0; m < mSlots.size(); ++m)
+  {
+    if (!mSlots[m].used) continue;
+
+    size_t n = mSlots[m].hash & mask;
+    while (slots[n].used) n = (n + 1) & mask;
+
+    slots[n].key.swap(mSlots[m].key);
+    slots[n].hash  = mSlots[m].hash;
+    slots[n].used  = true;
+    slots[n].value = mSlots[m].value;
+  }
+
+  mSlots.swap(slots);
+}
+
+
+template <typename T>
+void
+XMLSymbolTable::Map<T>::clear ()
+{
+  mSlots.clear();
+  mSize = 0;
+}
+
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
@@ -0,0 +1,183 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLSymbolTable.h
+ * @brief   Interned element and attribute names for an XML parser
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ *
+ * @class XMLSymbolTable
+ * @sbmlbrief{core} Interned element and attribute names for an XML parser.
+ *
+ * @ifnot clike @internal @endif@~
+ *
+ * A document uses a small vocabulary of names, prefixes and namespace
+ * URIs over and over.  Each parser handler keeps an XMLSymbolTable which
+ * stores every distinct string once, as an XMLTriple::Symbol, and hands out
+ * triples made of these shared symbols.  Making a token thus allocates no
+ * strings, copying a triple only copies pointers, and two triples from the
+ * same parser compare their parts by address (see
+ * XMLSymbolTable::equal()).  The symbols are reference counted, so the
+ * triples stay valid after the table is gone.
+ */
+
+#ifndef XMLSymbolTable_h
+#define XMLSymbolTable_h
+
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <sbml/xml/XMLExtern.h>
+#include <sbml/xml/XMLTriple.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBLAX_EXTERN XMLSymbolTable
+{
+public:
+
+  /**
+   * Creates a new, empty XMLSymbolTable.
+   */
+  XMLSymbolTable ();
+
+
+  /**
+   * Destroys this XMLSymbolTable.  The symbols it handed out remain valid.
+   */
+  ~XMLSymbolTable ();
+
+
+  /**
+   * Returns the symbol for the given characters, adding it to the table
+   * the first time it is seen.  The symbol of the empty string is NULL.
+   */
+  XMLTriple::Symbol intern (const char* chars, size_t length);
+
+
+  /**
+   * Returns the symbol for the given string.
+   */
+  XMLTriple::Symbol intern (const std::string& str);
+
+
+  /**
+   * Returns the XMLTriple for a NUL-terminated name in one of the forms
+   * accepted by XMLTriple(const std::string&, const char), i.e. name,
+   * uri sepchar name or uri sepchar name sepchar prefix.  The name is
+   * split and its parts are interned the first time it is seen.
+   *
+   * The reference is valid until the next call of a non-const method.
+   */
+  const XMLTriple& getTriple (const char* triplet, const char sepchar);
+
+
+  /**
+   * Returns the number of distinct strings interned so far.
+   */
+  unsigned int getNumSymbols () const;
+
+
+  /**
+   * Removes all entries from the table.  Symbols and triples handed out
+   * before remain valid.
+   */
+  void clear ();
+
+
+  /**
+   * Returns @c true if the two strings are equal.  Strings that belong to
+   * the same symbol are recognised by their address, without looking at
+   * the characters.
+   */
+  static bool equal (const std::string& lhs, const std::string& rhs)
+  {
+    return (&lhs == &rhs) || (lhs == rhs);
+  }
+
+
+private:
+
+  /*
+   * An open addressing hash table from strings to values, looked up
+   * without building a std::string for the key.
+   */
+  template <typename T>
+  class Map
+  {
+  public:
+    Map ();
+
+    /* Returns the value for the key, or NULL if there is none. */
+    T* find (const char* key, size_t length, size_t hash);
+
+    /* Adds a value for a key that is not in the map yet. */
+    T& insert (const char* key, size_t length, size_t hash, const T& value);
+
+    size_t size () const { return mSize; }
+    void clear ();
+
+  private:
+    struct Slot
+    {
+      Slot () : hash( 0 ), used( false ) { }
+
+      std::string key;
+      size_t      hash;
+      bool        used;
+      T           value;
+    };
+
+    void grow ();
+
+    std::vector<Slot> mSlots;
+    size_t            mSize;
+  };
+
+  static size_t hash (const char* chars, size_t length);
+
+  Map<XMLTriple::Symbol> mSymbols;
+  Map<XMLTriple>         mTriples;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* XMLSymbolTable_h */
+/** @endcond */
@@ -40,6 +40,7 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <sstream>
+#include <utility>
 
 /** @cond doxygenLibsbmlInternal */
 #include <sbml/xml/XMLOutputStream.h>
@@ -47,6 +48,7 @@
 #include <sbml/xml/XMLConstructorException.h>
 /** @endcond */
 #include <sbml/xml/XMLToken.h>
+#include <sbml/xml/XMLSymbolTable.h>
 
 /** @cond doxygenIgnored */
 using namespace std;
@@ -210,6 +212,103 @@ XMLToken::operator=(const XMLToken& rhs)
   return *this;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Move constructor.
+ */
+XMLToken::XMLToken(XMLToken&& orig)
+ : mTriple (std::move(orig.mTriple))
+ , mAttributes (std::move(orig.mAttributes))
+ , mNamespaces (std::move(orig.mNamespaces))
+ , mChars (std::move(orig.mChars))
+ , mIsStart (orig.mIsStart)
+ , mIsEnd (orig.mIsEnd)
+ , mIsText (orig.mIsText)
+ , mLine (orig.mLine)
+ , mColumn (orig.mColumn)
+{
+}
+
+
+/*
+ * Move assignment operator.
+ */
+XMLToken&
+XMLToken::operator=(XMLToken&& rhs)
+{
+  if(&rhs!=this)
+  {
+    mTriple = std::move(rhs.mTriple);
+    mAttributes = std::move(rhs.mAttributes);
+    mNamespaces = std::move(rhs.mNamespaces);
+    mChars = std::move(rhs.mChars);
+
+    mIsStart = rhs.mIsStart;
+    mIsEnd = rhs.mIsEnd;
+    mIsText = rhs.mIsText;
+
+    mLine = rhs.mLine;
+    mColumn = rhs.mColumn;
+  }
+
+  return *this;
+}
+
+
+/*
+ * Creates a start element XMLToken, taking over the given triple,
+ * attributes and namespace declarations.
+ */
+XMLToken::XMLToken (  XMLTriple&&           triple
+                    , XMLAttributes&&       attributes
+                    , XMLNamespaces&&       namespaces
+                    , const unsigned int    line
+                    , const unsigned int    column ) :
+   mTriple    ( std::move(triple)     )
+ , mAttributes( std::move(attributes) )
+ , mNamespaces( std::move(namespaces) )
+ , mIsStart   ( true       )
+ , mIsEnd     ( false      )
+ , mIsText    ( false      )
+ , mLine      ( line       )
+ , mColumn    ( column     )
+{
+}
+
+
+/*
+ * Creates an end element XMLToken, taking over the given triple.
+ */
+XMLToken::XMLToken (  XMLTriple&&         triple
+                    , const unsigned int  line
+                    , const unsigned int  column ) :
+   mTriple    ( std::move(triple) )
+ , mIsStart   ( false  )
+ , mIsEnd     ( true   )
+ , mIsText    ( false  )
+ , mLine      ( line   )
+ , mColumn    ( column )
+{
+}
+
+
+/*
+ * Creates a text XMLToken, taking over the given characters.
+ */
+XMLToken::XMLToken (  std::string&&       chars
+                    , const unsigned int  line
+                    , const unsigned int  column )
+ : mChars     ( std::move(chars) )
+ , mIsStart   ( false  )
+ , mIsEnd     ( false  )
+ , mIsText    ( true   )
+ , mLine      ( line   )
+ , mColumn    ( column )
+{
+}
+/** @endcond */
+
 /*
  * Creates and returns a deep copy of this XMLToken.
  * 
@@ -1068,6 +1167,18 @@ XMLToken::setTriple(const XMLTriple& triple)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * @return the XMLTriple of this token.
+ */
+const XMLTriple&
+XMLToken::getTriple () const
+{
+  return mTriple;
+}
+/** @endcond */
+
+
 /*
  * @return the (unqualified) name of this XML element.
  */
@@ -1132,8 +1243,8 @@ XMLToken::isEndFor (const XMLToken& element) const
     isEnd()                        &&
     !isStart()                     &&
     element.isStart()              &&
-    element.getName() == getName() &&
-    element.getURI () == getURI ();
+    XMLSymbolTable::equal(element.getName(), getName()) &&
+    XMLSymbolTable::equal(element.getURI (), getURI ());
 }
 
 
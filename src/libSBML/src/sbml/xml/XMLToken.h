@@ -264,6 +264,55 @@ public:
   XMLToken& operator=(const XMLToken& rhs);
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Move constructor; takes over the contents of @p orig, which is left
+   * empty.
+   *
+   * @param orig the XMLToken object to move from.
+   */
+  XMLToken(XMLToken&& orig);
+
+
+  /**
+   * Move assignment operator for XMLToken.
+   *
+   * @param rhs the XMLToken object whose contents are moved into this one.
+   */
+  XMLToken& operator=(XMLToken&& rhs);
+
+
+  /**
+   * Creates an XML start element, taking over the given triple,
+   * attributes and namespace declarations instead of copying them.  Used
+   * by the parser handlers, which build these for each element.
+   */
+  XMLToken (  XMLTriple&&           triple
+            , XMLAttributes&&       attributes
+            , XMLNamespaces&&       namespaces
+            , const unsigned int    line   = 0
+            , const unsigned int    column = 0 );
+
+
+  /**
+   * Creates an XML end element, taking over the given triple.
+   */
+  XMLToken (  XMLTriple&&         triple
+            , const unsigned int  line   = 0
+            , const unsigned int  column = 0 );
+
+
+  /**
+   * Creates a text object, taking over the given characters.
+   */
+  XMLToken (  std::string&&       chars
+            , const unsigned int  line   = 0
+            , const unsigned int  column = 0 );
+  /** @endcond */
+#endif  /* !SWIG */
+
+
   /**
    * Creates and returns a deep copy of this XMLToken object.
    *
@@ -917,6 +966,21 @@ public:
   int setTriple(const XMLTriple& triple);
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Returns the name, namespace prefix and namespace URI of this token.
+   *
+   * Copying the triple is cheaper than copying its strings, see
+   * XMLSymbolTable.
+   *
+   * @return the XMLTriple of this token.
+   */
+  const XMLTriple& getTriple () const;
+  /** @endcond */
+#endif  /* !SWIG */
+
+
   /**
    * Returns the (unqualified) name of token.
    *
@@ -42,6 +42,8 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <sstream>
+#include <stdexcept>
+#include <utility>
 
 #include <sbml/xml/XMLToken.h>
 #include <sbml/xml/XMLTokenizer.h>
@@ -158,7 +160,7 @@ XMLTokenizer::isEOF () const
 XMLToken
 XMLTokenizer::next ()
 {
-  XMLToken token( peek() );
+  XMLToken token( std::move(mTokens.front()) );
   mTokens.pop_front();
 
   return token;
@@ -290,6 +292,73 @@ XMLTokenizer::characters (const XMLToken& data)
   }
 }
 
+
+/*
+ * Receive notification of the start of an element, taking it over.
+ */
+void
+XMLTokenizer::startElement (XMLToken&& element)
+{
+  if (mInChars || mInStart)
+  {
+    mInChars = false;
+    mTokens.push_back( std::move(mCurrent) );
+  }
+
+  mInStart = true;
+  mCurrent = std::move(element);
+}
+
+
+/*
+ * Receive notification of the end of an element, taking it over.
+ */
+void
+XMLTokenizer::endElement (XMLToken&& element)
+{
+  if (mInChars)
+  {
+    mInChars = false;
+    mTokens.push_back( std::move(mCurrent) );
+  }
+
+  if (mInStart)
+  {
+    mInStart = false;
+    mCurrent.setEnd();
+    mTokens.push_back( std::move(mCurrent) );
+  }
+  else
+  {
+    mTokens.push_back( std::move(element) );
+  }
+}
+
+
+/*
+ * Receive notification of character data inside an element, taking it
+ * over.
+ */
+void
+XMLTokenizer::characters (XMLToken&& data)
+{
+  if (mInStart)
+  {
+    mInStart = false;
+    mTokens.push_back( std::move(mCurrent) );
+  }
+
+  if (mInChars)
+  {
+    mCurrent.append( data.getCharacters() );
+  }
+  else
+  {
+    mInChars = true;
+    mCurrent = std::move(data);
+  }
+}
+
 unsigned int
 XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
 {
@@ -317,12 +386,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   // need to count the number of starts
 
   unsigned int index = 0;
-  XMLToken firstUnread = mTokens.at(index);
-  while (firstUnread.isText() && index < size - 1)
+  const XMLToken* firstUnread = &mTokens.at(index);
+  while (firstUnread->isText() && index < size - 1)
   {
     // skip any text
     index++;
-    firstUnread = mTokens.at(index);
+    firstUnread = &mTokens.at(index);
   }
 
 
@@ -336,12 +405,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   // and the error gets logged elsewhere
   if (closingTag == "apply")
   {
-    std::string firstName = firstUnread.getName();
+    std::string firstName = firstUnread->getName();
 
     if (firstName != "ci" && firstName != "csymbol")
     {
-      if (firstUnread.isStart() != true 
-        || (firstUnread.isStart() == true &&  firstUnread.isEnd() != true))
+      if (firstUnread->isStart() != true 
+        || (firstUnread->isStart() == true &&  firstUnread->isEnd() != true))
       {
         valid = true;
         return numChildren;
@@ -358,25 +427,25 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   unsigned int depth = 0;
   std::string name;
   bool cleanBreak = false;
-  XMLToken next = mTokens.at(index);
+  const XMLToken* next = &mTokens.at(index);
   while (index < size-2)
   {
     // skip any text elements
-    while(next.isText() == true && index < size-1)
+    while(next->isText() == true && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
-    if (next.isEnd() == true && next.getName() == closingTag)
+    if (next->isEnd() == true && next->getName() == closingTag)
     {
       valid = true;
       break;
     }
     // iterate to first start element
-    while (next.isStart() == false && index < size-1)
+    while (next->isStart() == false && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
     // check we have not reached the end
@@ -388,7 +457,7 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
     }
 
     // record the name of the start element
-    name = next.getName();
+    name = next->getName();
     numChildren++;
 
  //   index++;
@@ -398,12 +467,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
       numChildren = 0;
       break;
     }
-    else if (next.isEnd() == false)
+    else if (next->isEnd() == false)
     {
       index++;
       if (index < size)
       {
-        next = mTokens.at(index);
+        next = &mTokens.at(index);
       }
       else
       {
@@ -416,12 +485,12 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
     cleanBreak = false;
     while (index < size-1)
     {
-      if (next.isStart() == true && next.isEnd() == false && next.getName() == name)
+      if (next->isStart() == true && next->isEnd() == false && next->getName() == name)
       {
         depth++;
       }
 
-      if (next.isEnd() == true && next.getName() == name)
+      if (next->isEnd() == true && next->getName() == name)
       {
         if (depth == 0)
         {
@@ -435,13 +504,13 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
       }
 
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
     index++;
     if (index < size)
     {
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
   } 
 
@@ -449,7 +518,7 @@ XMLTokenizer::determineNumberChildren(bool & valid, const std::string element)
   // but the loop hits before it can record that it was valid
   if (valid == false && cleanBreak == true)
   {
-  if (index >= size-2 && next.isEnd() == true && next.getName() == closingTag)
+  if (index >= size-2 && next->isEnd() == true && next->getName() == closingTag)
   {
       valid = true;
   }
@@ -478,48 +547,48 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
   std::string prevName = "";
   std::string rogueTag = "";
   
-  XMLToken next = mTokens.at(index);
-  name = next.getName();
-  if (next.isStart() == true && next.isEnd() == true && 
+  const XMLToken* next = &mTokens.at(index);
+  name = next->getName();
+  if (next->isStart() == true && next->isEnd() == true && 
     name == qualifier && index < size)
   {
     numQualifiers++;
     index++;
-    next = mTokens.at(index);
+    next = &mTokens.at(index);
   }
   bool cleanBreak = false;
 
   while (index < size-2)
   {
     // skip any text elements
-    while(next.isText() == true && index < size-1)
+    while(next->isText() == true && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
-    if (next.isEnd() == true)
+    if (next->isEnd() == true)
     {
-      if (next.getName() == container)
+      if (next->getName() == container)
       {
         valid = true;
         break;
       }
-      //else if (!rogueTag.empty() && next.getName() == rogueTag)
+      //else if (!rogueTag.empty() && next->getName() == rogueTag)
       //{
       //  index++;
-      //  next = mTokens.at(index);
+      //  next = &mTokens.at(index);
       //  break;
       //}
     }
     // iterate to first start element
-    while (next.isStart() == false && index < size-1)
+    while (next->isStart() == false && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
-    if (next.isStart() == true && next.isEnd() == true)
+    if (next->isStart() == true && next->isEnd() == true)
     {
       if (qualifier.empty() == true)
       {
@@ -531,7 +600,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
       index++;
       if (index < size)
       {
-        next = mTokens.at(index);
+        next = &mTokens.at(index);
         continue;
       }
     }
@@ -544,7 +613,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     }
 
     // record the name of the start element
-    name = next.getName();
+    name = next->getName();
 
     // need to deal with the weird situation where someone has used a tag
     // after the piece but before the next correct element
@@ -556,7 +625,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     //    {
     //      rogueTag = name;
     //      index++;
-    //      next = mTokens.at(index);
+    //      next = &mTokens.at(index);
     //      continue;
     //    }
     //  }
@@ -576,7 +645,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     else
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
     // iterate to the end of </name>
@@ -584,12 +653,12 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     cleanBreak = false;
     while (index < size-1)
     {
-      if (next.isStart() == true && next.getName() == name)
+      if (next->isStart() == true && next->getName() == name)
       {
         depth++;
       }
 
-      if (next.isEnd() == true && next.getName() == name)
+      if (next->isEnd() == true && next->getName() == name)
       {
         if (depth == 0)
         {
@@ -605,7 +674,7 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
       index++;
       if (index < size)
       {
-        next = mTokens.at(index);
+        next = &mTokens.at(index);
       }
     }
 
@@ -613,14 +682,14 @@ XMLTokenizer::determineNumSpecificChildren(bool & valid,
     index++;
     if (index < size)
     {
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
   }  
 
   // we might have hit the end of the loop and the end of the correct tag
   if (valid == false && cleanBreak == true)
   {
-    if (index >= size-2 && next.isEnd() == true && next.getName() == container)
+    if (index >= size-2 && next->isEnd() == true && next->getName() == container)
     {
         valid = true;
     }
@@ -648,19 +717,19 @@ XMLTokenizer::containsChild(bool & valid,
   //unsigned int depth = 0;
   std::string name;
   
-  XMLToken next = mTokens.at(index);
-  name = next.getName();
+  const XMLToken* next = &mTokens.at(index);
+  name = next->getName();
 
   while (index < size-2)
   {
     // skip any text elements
-    while(next.isText() == true && index < size-1)
+    while(next->isText() == true && index < size-1)
     {
       index++;
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
 
-    if (next.getName() == qualifier)
+    if (next->getName() == qualifier)
     {
       valid = true;
       return true;
@@ -669,7 +738,7 @@ XMLTokenizer::containsChild(bool & valid,
     index++;
     if (index < size)
     {
-      next = mTokens.at(index);
+      next = &mTokens.at(index);
     }
   }  
 
@@ -684,6 +753,96 @@ XMLTokenizer::containsChild(bool & valid,
 
 
 
+/*
+ * Creates an empty TokenQueue; the ring is allocated by the first push.
+ */
+XMLTokenizer::TokenQueue::TokenQueue () :
+   mHead( 0 )
+ , mSize( 0 )
+{
+}
+
+
+/*
+ * @return the position in mSlots of the token at the given index.
+ */
+size_t
+XMLTokenizer::TokenQueue::slot (size_t index) const
+{
+  size_t pos = mHead + index;
+  return (pos < mSlots.size()) ? pos : pos - mSlots.size();
+}
+
+
+/*
+ * Doubles the ring, moving the queued tokens to the start of the new one.
+ */
+void
+XMLTokenizer::TokenQueue::grow ()
+{
+  std::vector<XMLToken> slots( mSlots.empty() ? 64 : 2 * mSlots.size() );
+
+  for (size_t n = 0; n < mSize; ++n)
+  {
+    slots[n] = std::move( mSlots[slot(n)] );
+  }
+
+  mSlots.swap(slots);
+  mHead = 0;
+}
+
+
+const XMLToken&
+XMLTokenizer::TokenQueue::operator[] (size_t index) const
+{
+  return mSlots[slot(index)];
+}
+
+
+const XMLToken&
+XMLTokenizer::TokenQueue::at (size_t index) const
+{
+  if (index >= mSize)
+  {
+    throw std::out_of_range("XMLTokenizer::TokenQueue::at");
+  }
+
+  return mSlots[slot(index)];
+}
+
+
+void
+XMLTokenizer::TokenQueue::push_back (const XMLToken& token)
+{
+  if (mSize == mSlots.size()) grow();
+
+  mSlots[slot(mSize)] = token;
+  ++mSize;
+}
+
+
+void
+XMLTokenizer::TokenQueue::push_back (XMLToken&& token)
+{
+  if (mSize == mSlots.size()) grow();
+
+  mSlots[slot(mSize)] = std::move(token);
+  ++mSize;
+}
+
+
+/*
+ * Removes the first token, leaving its slot empty for reuse.
+ */
+void
+XMLTokenizer::TokenQueue::pop_front ()
+{
+  mSlots[mHead] = XMLToken();
+  mHead = slot(1);
+  --mSize;
+}
+
+
 LIBSBML_CPP_NAMESPACE_END
 
 /** @endcond */
@@ -52,10 +52,11 @@
 
 #ifdef __cplusplus
 
-#include <deque>
+#include <vector>
 
 #include <sbml/xml/XMLExtern.h>
 #include <sbml/xml/XMLHandler.h>
+#include <sbml/xml/XMLToken.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -186,8 +187,66 @@ public:
   virtual void characters (const XMLToken& data);
 
 
+#ifndef SWIG
+  /**
+   * Receive notification of the start of an element, taking it over.
+   */
+  virtual void startElement (XMLToken&& element);
+
+
+  /**
+   * Receive notification of the end of an element, taking it over.
+   */
+  virtual void endElement (XMLToken&& element);
+
+
+  /**
+   * Receive notification of character data inside an element, taking it
+   * over.
+   */
+  virtual void characters (XMLToken&& data);
+#endif  /* !SWIG */
+
+
 protected:
 
+  /**
+   * The queue of tokens waiting to be consumed: a ring of slots that grows
+   * by doubling when full and is otherwise reused, so that a steady stream
+   * of tokens does not allocate.  Tokens are moved in by the handler
+   * methods and moved out by next().
+   */
+  class TokenQueue
+  {
+  public:
+    TokenQueue ();
+
+    size_t size () const { return mSize; }
+    bool empty () const { return mSize == 0; }
+
+    XMLToken& front () { return mSlots[mHead]; }
+    const XMLToken& front () const { return mSlots[mHead]; }
+
+    XMLToken& operator[] (size_t index) { return mSlots[slot(index)]; }
+    const XMLToken& operator[] (size_t index) const;
+
+    /* Like operator[], but throws std::out_of_range for a bad index. */
+    const XMLToken& at (size_t index) const;
+
+    void push_back (const XMLToken& token);
+    void push_back (XMLToken&& token);
+    void pop_front ();
+
+  private:
+    size_t slot (size_t index) const;
+    void grow ();
+
+    std::vector<XMLToken> mSlots;
+    size_t mHead;
+    size_t mSize;
+  };
+
+
   unsigned int determineNumberChildren(bool & valid, 
                                        const std::string element = "");
 
@@ -204,8 +263,8 @@ protected:
   std::string mEncoding;
   std::string mVersion;
 
-  XMLToken             mCurrent;
-  std::deque<XMLToken> mTokens;
+  XMLToken   mCurrent;
+  TokenQueue mTokens;
 
   friend class XMLInputStream;
 
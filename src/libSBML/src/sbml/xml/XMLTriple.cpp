@@ -39,7 +39,11 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstring>
+#include <utility>
+
 #include <sbml/xml/XMLTriple.h>
+#include <sbml/xml/XMLSymbolTable.h>
 #include <sbml/util/util.h>
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLConstructorException.h>
@@ -51,6 +55,37 @@ using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * @return a symbol of its own for the given string, NULL if it is empty.
+ */
+static XMLTriple::Symbol
+makeSymbol (const char* chars, size_t length)
+{
+  if (length == 0) return XMLTriple::Symbol();
+  return std::make_shared<const std::string>(chars, length);
+}
+
+
+static XMLTriple::Symbol
+makeSymbol (const std::string& str)
+{
+  return makeSymbol(str.data(), str.size());
+}
+
+
+/*
+ * @return the string a symbol stands for.
+ */
+static const std::string&
+getString (const XMLTriple::Symbol& symbol)
+{
+  static const std::string empty;
+  return symbol ? *symbol : empty;
+}
+/** @endcond */
+
+
 /*
  * Creates a new empty XMLTriple.
  */
@@ -65,9 +100,9 @@ XMLTriple::XMLTriple ()
 XMLTriple::XMLTriple (  const std::string&  name
                       , const std::string&  uri
                       , const std::string&  prefix ) 
- : mName   ( name )
- , mURI    ( uri  )
- , mPrefix ( prefix )
+ : mName   ( makeSymbol(name)   )
+ , mURI    ( makeSymbol(uri)    )
+ , mPrefix ( makeSymbol(prefix) )
 {
 }
 
@@ -89,28 +124,75 @@ XMLTriple::XMLTriple (const std::string& triplet, const char sepchar)
 
   if (pos != string::npos)
   {
-    mURI = triplet.substr(start, pos);
+    mURI = makeSymbol(triplet.data(), pos);
 
     start = pos + 1;
     pos   = triplet.find(sepchar, start);
 
     if (pos != string::npos)
     {
-      mName   = triplet.substr(start, pos - start);
-      mPrefix = triplet.substr(pos + 1);
+      mName   = makeSymbol(triplet.data() + start, pos - start);
+      mPrefix = makeSymbol(triplet.data() + pos + 1, triplet.size() - pos - 1);
     }
     else
     {
-      mName = triplet.substr(start);
+      mName = makeSymbol(triplet.data() + start, triplet.size() - start);
     }
   }
   else
   {
-    mName = triplet;
+    mName = makeSymbol(triplet);
   }
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Creates a new XMLTriple by splitting the NUL-terminated triplet on
+ * sepchar.
+ */
+XMLTriple::XMLTriple (const char* triplet, const char sepchar)
+{
+  const char* start = triplet;
+  const char* pos   = strchr(start, sepchar);
+
+  if (pos != NULL)
+  {
+    mURI = makeSymbol(start, (size_t)(pos - start));
+
+    start = pos + 1;
+    pos   = strchr(start, sepchar);
+
+    if (pos != NULL)
+    {
+      mName   = makeSymbol(start, (size_t)(pos - start));
+      mPrefix = makeSymbol(pos + 1, strlen(pos + 1));
+    }
+    else
+    {
+      mName = makeSymbol(start, strlen(start));
+    }
+  }
+  else
+  {
+    mName = makeSymbol(start, strlen(start));
+  }
+}
+
+
+/*
+ * Creates a new XMLTriple from shared symbols.
+ */
+XMLTriple::XMLTriple (const Symbol& name, const Symbol& uri,
+                      const Symbol& prefix)
+  : mName   ( name )
+  , mURI    ( uri )
+  , mPrefix ( prefix )
+{
+}
+/** @endcond */
+
+
 /*
  * Copy constructor; creates a copy of this XMLTriple set.
  */
@@ -139,6 +221,36 @@ XMLTriple::operator=(const XMLTriple& rhs)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Move constructor.
+ */
+XMLTriple::XMLTriple(XMLTriple&& orig)
+  : mName   ( std::move(orig.mName) )
+  , mURI    ( std::move(orig.mURI) )
+  , mPrefix ( std::move(orig.mPrefix) )
+{
+}
+
+
+/*
+ * Move assignment operator.
+ */
+XMLTriple&
+XMLTriple::operator=(XMLTriple&& rhs)
+{
+  if(&rhs!=this)
+  {
+    mName   = std::move(rhs.mName);
+    mURI    = std::move(rhs.mURI);
+    mPrefix = std::move(rhs.mPrefix);
+  }
+
+  return *this;
+}
+/** @endcond */
+
+
 XMLTriple::~XMLTriple()
 {
 }
@@ -161,7 +273,7 @@ XMLTriple::clone () const
 const std::string&
 XMLTriple::getName () const
 {
-  return mName;
+  return getString(mName);
 }
 
 
@@ -171,7 +283,7 @@ XMLTriple::getName () const
 const std::string& 
 XMLTriple::getPrefix () const
 {
-  return mPrefix;
+  return getString(mPrefix);
 }
 
 
@@ -181,7 +293,7 @@ XMLTriple::getPrefix () const
 const std::string&
 XMLTriple::getURI () const
 {
-  return mURI;
+  return getString(mURI);
 }
 
 
@@ -191,7 +303,8 @@ XMLTriple::getURI () const
 const std::string 
 XMLTriple::getPrefixedName () const
 {
-  return mPrefix + ((mPrefix != "") ? ":" : "") + mName;
+  const std::string& prefix = getPrefix();
+  return prefix + ((prefix != "") ? ":" : "") + getName();
 }
 
 
@@ -215,9 +328,9 @@ XMLTriple::isEmpty () const
  */
 bool operator==(const XMLTriple& lhs, const XMLTriple& rhs)
 {
-  if (lhs.getName()   != rhs.getName()  ) return false;
-  if (lhs.getURI()    != rhs.getURI()   ) return false;
-  if (lhs.getPrefix() != rhs.getPrefix()) return false;
+  if (!XMLSymbolTable::equal(lhs.getName(),   rhs.getName()  )) return false;
+  if (!XMLSymbolTable::equal(lhs.getURI(),    rhs.getURI()   )) return false;
+  if (!XMLSymbolTable::equal(lhs.getPrefix(), rhs.getPrefix())) return false;
 
   return true;
 }
@@ -86,6 +86,7 @@
 
 #ifdef __cplusplus
 
+#include <memory>
 #include <string>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -136,6 +137,39 @@ public:
   XMLTriple (const std::string& triplet, const char sepchar = ' ');
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Creates an XMLTriple object by splitting a NUL-terminated triplet at
+   * @p sepchar, as the constructor taking a string does.  The parsers use
+   * this to split the names they receive without copying them first.
+   *
+   * @param triplet the triplet, which may not be NULL.
+   * @param sepchar a character, the sepchar used in the triplet.
+   */
+  XMLTriple (const char* triplet, const char sepchar);
+
+
+  /**
+   * An immutable string shared by all XMLTriple objects that use it.  A
+   * NULL symbol stands for the empty string.
+   */
+  typedef std::shared_ptr<const std::string> Symbol;
+
+
+  /**
+   * Creates an XMLTriple object from shared symbols, such as those of an
+   * XMLSymbolTable.  The strings are shared, not copied.
+   *
+   * @param name the symbol of the name.
+   * @param uri the symbol of the namespace URI.
+   * @param prefix the symbol of the namespace prefix.
+   */
+  XMLTriple (const Symbol& name, const Symbol& uri, const Symbol& prefix);
+  /** @endcond */
+#endif  /* !SWIG */
+
+
   /**
    * Copy constructor; creates a copy of this XMLTriple object.
    *
@@ -153,6 +187,27 @@ public:
   XMLTriple& operator=(const XMLTriple& rhs);
 
 
+#ifndef SWIG
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Move constructor; takes over the contents of @p orig, which is left
+   * empty.
+   *
+   * @param orig the XMLTriple object to move from.
+   */
+  XMLTriple(XMLTriple&& orig);
+
+
+  /**
+   * Move assignment operator for XMLTriple.
+   *
+   * @param rhs the XMLTriple object whose contents are moved into this one.
+   */
+  XMLTriple& operator=(XMLTriple&& rhs);
+  /** @endcond */
+#endif  /* !SWIG */
+
+
   /**
   * Destructor.
   */
@@ -211,9 +266,13 @@ public:
 
 private:
   /** @cond doxygenLibsbmlInternal */
-  std::string  mName;
-  std::string  mURI;
-  std::string  mPrefix;
+  /*
+   * The parts are never modified once set, so copies of a triple share
+   * them.
+   */
+  Symbol  mName;
+  Symbol  mURI;
+  Symbol  mPrefix;
 
   /** @endcond */
 };
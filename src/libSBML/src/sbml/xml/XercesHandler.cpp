@@ -41,6 +41,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <utility>
+
 #include <xercesc/sax/Locator.hpp>
 #include <xercesc/internal/ReaderMgr.hpp>
 
@@ -87,6 +89,7 @@ XercesHandler::XercesHandler (XMLHandler& handler) :
 XercesHandler::XercesHandler (const XercesHandler& other)
   : mHandler(other.mHandler)
   , mLocator(other.mLocator)
+  , mSymbols(other.mSymbols)
 {
 }
 
@@ -100,6 +103,7 @@ XercesHandler& XercesHandler::operator=(const XercesHandler& other)
 
   mHandler = other.mHandler;
   mLocator = other.mLocator;
+  mSymbols = other.mSymbols;
 
   return *this;
 }
@@ -141,13 +145,15 @@ XercesHandler::startElement (  const XMLCh* const  uri
   const string name   = XercesTranscode( localname );
   const string prefix = getPrefix( XercesTranscode(qname) );
 
-  const XMLTriple         triple    ( name, nsuri, prefix );
+  const XMLTriple         triple    ( mSymbols.intern(name),
+                                      mSymbols.intern(nsuri),
+                                      mSymbols.intern(prefix) );
   const XercesAttributes  attributes( attrs, name );
   const XercesNamespaces  namespaces( attrs );
-  const XMLToken          element   ( triple, attributes, namespaces,
+  XMLToken                element   ( triple, attributes, namespaces,
                                       getLine(), getColumn() );
 
-  mHandler.startElement(element);
+  mHandler.startElement( std::move(element) );
 }
 
 
@@ -177,10 +183,11 @@ XercesHandler::endElement (  const XMLCh* const  uri
   const string name   = XercesTranscode( localname );
   const string prefix = getPrefix( XercesTranscode(qname) );
 
-  const XMLTriple  triple ( name, nsuri, prefix );
-  const XMLToken   element( triple, getLine(), getColumn() );
+  XMLToken element( XMLTriple(mSymbols.intern(name), mSymbols.intern(nsuri),
+                              mSymbols.intern(prefix)),
+                    getLine(), getColumn() );
 
-  mHandler.endElement(element);
+  mHandler.endElement( std::move(element) );
 }
 
 
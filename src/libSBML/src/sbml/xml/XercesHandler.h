@@ -49,6 +49,7 @@
 #include <string>
 
 #include <sbml/xml/XMLHandler.h>
+#include <sbml/xml/XMLSymbolTable.h>
 #include <sbml/xml/XercesTranscode.h>
 #include <xercesc/sax2/DefaultHandler.hpp>
 
@@ -158,6 +159,9 @@ protected:
 
   XMLHandler&              mHandler;
   const xercesc::Locator*  mLocator;
+
+  /* The element names seen so far. */
+  XMLSymbolTable           mSymbols;
 };
 
 
@@ -45,6 +45,7 @@
 #include <sbml/xml/XMLToken.h>
 #include <sbml/xml/XMLNode.h>
 
+#include <utility>
 
 #include <check.h>
 using namespace std;
@@ -267,6 +268,48 @@ START_TEST (test_Token_clone)
 }
 END_TEST
 
+START_TEST (test_Token_moveConstructor)
+{
+  XMLAttributes attr;
+  attr.add("id", "s1");
+  XMLNamespaces ns;
+  ns.add("http://foo.org/", "bar");
+
+  XMLToken token(XMLTriple("sarah", "http://foo.org/", "bar"), attr, ns, 3, 4);
+  XMLToken token2(std::move(token));
+
+  fail_unless(token2.getName() == "sarah");
+  fail_unless(token2.getURI() == "http://foo.org/");
+  fail_unless(token2.getPrefix() == "bar");
+  fail_unless(token2.isStart() == 1);
+  fail_unless(token2.getAttributesLength() == 1);
+  fail_unless(token2.getAttrValue("id") == "s1");
+  fail_unless(token2.getNamespacesLength() == 1);
+  fail_unless(token2.getNamespaceURI("bar") == "http://foo.org/");
+  fail_unless(token2.getLine() == 3);
+  fail_unless(token2.getColumn() == 4);
+
+  fail_unless(token.getAttributesLength() == 0);
+  fail_unless(token.getNamespacesLength() == 0);
+}
+END_TEST
+
+START_TEST (test_Token_moveAssignmentOperator)
+{
+  XMLToken token(std::string("some text"), 5, 6);
+  XMLToken token2(XMLTriple("sarah", "http://foo.org/", "bar"), 3, 4);
+
+  token2 = std::move(token);
+
+  fail_unless(token2.isText() == 1);
+  fail_unless(token2.isEnd() == 0);
+  fail_unless(token2.getCharacters() == "some text");
+  fail_unless(token2.getName().empty());
+  fail_unless(token2.getLine() == 5);
+  fail_unless(token2.getColumn() == 6);
+}
+END_TEST
+
 START_TEST (test_Node_copyConstructor)
 {
   XMLAttributes *att = new XMLAttributes();
@@ -398,6 +441,8 @@ create_suite_CopyAndClone (void)
   tcase_add_test( tcase, test_Token_copyConstructor );
   tcase_add_test( tcase, test_Token_assignmentOperator );
   tcase_add_test( tcase, test_Token_clone );
+  tcase_add_test( tcase, test_Token_moveConstructor );
+  tcase_add_test( tcase, test_Token_moveAssignmentOperator );
   tcase_add_test( tcase, test_Node_copyConstructor );
   tcase_add_test( tcase, test_Node_assignmentOperator );
   tcase_add_test( tcase, test_Node_clone );
@@ -44,6 +44,7 @@
 #include <iostream>
 #include <check.h>
 #include <XMLAttributes.h>
+#include <XMLSymbolTable.h>
 #include <string>
 
 
@@ -366,6 +367,47 @@ START_TEST(test_XMLAttributes_add_removeResource)
 END_TEST
 
 
+START_TEST(test_XMLAttributes_symbolTable)
+{
+  XMLSymbolTable symbols;
+  XMLAttributes  attrs;
+
+  const XMLTriple id  ( symbols.getTriple("id", ' ') );
+  const XMLTriple name( symbols.getTriple("http://foo.org/ name foo", ' ') );
+
+  fail_unless( id.getName()     == "id"              );
+  fail_unless( id.getURI()      == ""                );
+  fail_unless( id.getPrefix()   == ""                );
+  fail_unless( name.getName()   == "name"            );
+  fail_unless( name.getURI()    == "http://foo.org/" );
+  fail_unless( name.getPrefix() == "foo"             );
+  fail_unless( symbols.getNumSymbols() == 4 );
+
+  // the parts of a triple seen before are shared, not copied
+  const XMLTriple again( symbols.getTriple("http://foo.org/ name foo", ' ') );
+  fail_unless( &again.getName() == &name.getName() );
+  fail_unless( &again.getURI()  == &name.getURI()  );
+  fail_unless( symbols.intern("name").get() == &name.getName() );
+  fail_unless( again == name );
+  fail_unless( symbols.getNumSymbols() == 4 );
+
+  attrs.add(id, "x");
+  attrs.add(name, "y");
+
+  fail_unless( attrs.getIndex("id")                      ==  0 );
+  fail_unless( attrs.getIndex("name")                    ==  1 );
+  fail_unless( attrs.getIndex("name", "http://foo.org/") ==  1 );
+  fail_unless( attrs.getIndex("name", "http://bar.org/") == -1 );
+  fail_unless( attrs.getValue(name) == "y" );
+
+  // triples outlive the table
+  symbols.clear();
+  fail_unless( symbols.getNumSymbols() == 0 );
+  fail_unless( attrs.getPrefix(1) == "foo" );
+}
+END_TEST
+
+
 Suite *
 create_suite_XMLAttributes (void)
 {
@@ -381,6 +423,7 @@ create_suite_XMLAttributes (void)
   tcase_add_test( tcase, test_XMLAttributes_assignment      );
   tcase_add_test( tcase, test_XMLAttributes_clone           );
   tcase_add_test( tcase, test_XMLAttributes_add_removeResource);
+  tcase_add_test( tcase, test_XMLAttributes_symbolTable     );
 
   suite_add_tcase(suite, tcase);
 
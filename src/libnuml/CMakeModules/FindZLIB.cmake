@@ -101,6 +101,18 @@ ${LIBSBML_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log")
 
 endif () # Check for cached values
 
+# zlib links cpu_features when it was available at build time.
+if (NOT ZLIB_CPU_FEATURES_LIBRARY)
+    find_library(ZLIB_CPU_FEATURES_LIBRARY
+        NAMES cpu_features libcpu_features.lib
+        PATHS $ENV{ZLIB_DIR}/lib
+              ${${_PROJECT_DEPENDENCY_DIR}}/${CMAKE_INSTALL_LIBDIR}
+              ${${_PROJECT_DEPENDENCY_DIR}}/lib
+        DOC "The file name of the cpu_features library used by zlib (optional)."
+        NO_DEFAULT_PATH)
+    mark_as_advanced(ZLIB_CPU_FEATURES_LIBRARY)
+endif ()
+
 # create an zlib target to link against
 if(NOT TARGET ZLIB::ZLIB)
   add_library(ZLIB::ZLIB UNKNOWN IMPORTED)
@@ -108,6 +120,10 @@ if(NOT TARGET ZLIB::ZLIB)
     IMPORTED_LINK_INTERFACE_LANGUAGES "C"
     IMPORTED_LOCATION "${ZLIB_LIBRARY}"
     INTERFACE_INCLUDE_DIRECTORIES "${ZLIB_INCLUDE_DIR}")
+  if (ZLIB_CPU_FEATURES_LIBRARY)
+    set_property(TARGET ZLIB::ZLIB APPEND PROPERTY
+      INTERFACE_LINK_LIBRARIES "${ZLIB_CPU_FEATURES_LIBRARY}")
+  endif()
 endif()
 
 
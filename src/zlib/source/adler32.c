@@ -6,7 +6,12 @@
 /* @(#) $Id$ */
 
 #define ZLIB_INTERNAL
-#include "zlib.h"
+#include "zutil.h"
+
+#ifdef ADLER32_DISPATCH
+#  include "cpu_dispatch.h"
+#  include "adler32_simd.h"
+#endif
 
 #define BASE 65521UL    /* largest prime smaller than 65536 */
 #define NMAX 5552
@@ -54,7 +59,7 @@
 #endif
 
 /* ========================================================================= */
-uLong ZEXPORT adler32(adler, buf, len)
+local uLong adler32_generic(adler, buf, len)
     uLong adler;
     const Bytef *buf;
     uInt len;
@@ -124,6 +129,64 @@ uLong ZEXPORT adler32(adler, buf, len)
     return adler | (sum2 << 16);
 }
 
+#ifdef ADLER32_DISPATCH
+
+/* The implementation used for long buffers, selected by the first call.
+   It is only accessed atomically. */
+local adler32_func volatile adler32_long = Z_NULL;
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#  define ADLER32_LOAD(p) \
+    (adler32_func)_InterlockedCompareExchangePointer((void *volatile *)&(p), \
+                                                     Z_NULL, Z_NULL)
+#  define ADLER32_STORE(p, f) \
+    _InterlockedExchangePointer((void *volatile *)&(p), (void *)(f))
+#else
+#  define ADLER32_LOAD(p) __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#  define ADLER32_STORE(p, f) __atomic_store_n(&(p), (f), __ATOMIC_RELEASE)
+#endif
+
+local adler32_func adler32_select()
+{
+    CpuDispatchFunction table[CPU_DISPATCH_LEVEL_COUNT];
+
+    table[CPU_DISPATCH_BASELINE] = (CpuDispatchFunction)adler32_generic;
+    table[CPU_DISPATCH_SSE2] = (CpuDispatchFunction)adler32_sse2;
+#ifdef ADLER32_HAVE_AVX2
+    table[CPU_DISPATCH_AVX2] = (CpuDispatchFunction)adler32_avx2;
+#else
+    table[CPU_DISPATCH_AVX2] = Z_NULL;
+#endif
+#ifdef ADLER32_HAVE_AVX512
+    table[CPU_DISPATCH_AVX512] = (CpuDispatchFunction)adler32_avx512;
+#else
+    table[CPU_DISPATCH_AVX512] = Z_NULL;
+#endif
+    return (adler32_func)SelectCpuDispatchFunction(table);
+}
+
+#endif /* ADLER32_DISPATCH */
+
+/* ========================================================================= */
+uLong ZEXPORT adler32(adler, buf, len)
+    uLong adler;
+    const Bytef *buf;
+    uInt len;
+{
+#ifdef ADLER32_DISPATCH
+    if (len >= ADLER32_SIMD_MIN && buf != Z_NULL) {
+        adler32_func func = ADLER32_LOAD(adler32_long);
+        if (func == Z_NULL) {
+            func = adler32_select();
+            ADLER32_STORE(adler32_long, func);
+        }
+        return func(adler, buf, len);
+    }
+#endif
+    return adler32_generic(adler, buf, len);
+}
+
 /* ========================================================================= */
 uLong ZEXPORT adler32_combine(adler1, adler2, len2)
     uLong adler1;
@@ -0,0 +1,90 @@
+/* adler32_avx2.c -- compute the Adler-32 checksum with AVX2
+ * Copyright (C) 1995-2004 Mark Adler
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* @(#) $Id$ */
+
+/* This file is compiled with AVX2 code generation enabled (see
+   CMakeLists.txt), adler32() only calls it when the processor supports
+   AVX2. */
+
+#if defined(__AVX2__)
+#  define ADLER32_AVX2
+#  include <immintrin.h>
+#endif
+
+#define ZLIB_INTERNAL
+#include "zutil.h"
+#include "adler32_simd.h"
+
+#ifdef ADLER32_AVX2
+
+/* As adler32_sse2(), with blocks of 32 bytes.  The weighted sum of a
+   block is formed with _mm256_maddubs_epi16, whose pairs of products are
+   at most 255 * (32 + 31) and do not saturate. */
+local uLong adler32_avx2_impl(adler, buf, len)
+    uLong adler;
+    const Bytef *buf;
+    uInt len;
+{
+    unsigned long sum2;
+    unsigned n, blocks;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    const __m256i w = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                       24, 23, 22, 21, 20, 19, 18, 17,
+                                       16, 15, 14, 13, 12, 11, 10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+    __m256i b, ps, s1, s2;
+    __m128i t1, t2;
+
+    sum2 = (adler >> 16) & 0xffff;
+    adler &= 0xffff;
+
+    blocks = len / 32;
+    len -= blocks * 32;
+    while (blocks) {
+        n = NMAX / 32;
+        if (n > blocks)
+            n = blocks;
+        blocks -= n;
+
+        ps = _mm256_zextsi128_si256(_mm_cvtsi32_si128((int)(adler * n)));
+        s1 = zero;
+        s2 = _mm256_zextsi128_si256(_mm_cvtsi32_si128((int)sum2));
+        do {
+            b = _mm256_loadu_si256((const __m256i *)buf);
+            ps = _mm256_add_epi32(ps, s1);
+            s1 = _mm256_add_epi32(s1, _mm256_sad_epu8(b, zero));
+            s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(
+                     _mm256_maddubs_epi16(b, w), ones));
+            buf += 32;
+        } while (--n);
+        s2 = _mm256_add_epi32(s2, _mm256_slli_epi32(ps, 5));
+
+        /* sum the lanes */
+        t1 = _mm_add_epi32(_mm256_castsi256_si128(s1),
+                           _mm256_extracti128_si256(s1, 1));
+        t2 = _mm_add_epi32(_mm256_castsi256_si128(s2),
+                           _mm256_extracti128_si256(s2, 1));
+        t1 = _mm_add_epi32(t1, _mm_shuffle_epi32(t1, _MM_SHUFFLE(1, 0, 3, 2)));
+        t2 = _mm_add_epi32(t2, _mm_shuffle_epi32(t2, _MM_SHUFFLE(1, 0, 3, 2)));
+        t2 = _mm_add_epi32(t2, _mm_shuffle_epi32(t2, _MM_SHUFFLE(2, 3, 0, 1)));
+        adler += (unsigned long)(unsigned)_mm_cvtsi128_si32(t1);
+        sum2 = (unsigned long)(unsigned)_mm_cvtsi128_si32(t2);
+        adler %= BASE;
+        sum2 %= BASE;
+    }
+
+    ADLER32_SIMD_TAIL(adler, sum2, buf, len);
+    return adler | (sum2 << 16);
+}
+
+const adler32_func adler32_avx2 = adler32_avx2_impl;
+
+#else
+
+const adler32_func adler32_avx2 = Z_NULL;
+
+#endif /* ADLER32_AVX2 */
@@ -0,0 +1,85 @@
+/* adler32_avx512.c -- compute the Adler-32 checksum with AVX-512
+ * Copyright (C) 1995-2004 Mark Adler
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* @(#) $Id$ */
+
+/* This file is compiled with AVX-512 code generation enabled (see
+   CMakeLists.txt), adler32() only calls it when the processor supports
+   AVX-512 F and BW. */
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#  define ADLER32_AVX512
+#  include <immintrin.h>
+#endif
+
+#define ZLIB_INTERNAL
+#include "zutil.h"
+#include "adler32_simd.h"
+
+#ifdef ADLER32_AVX512
+
+/* As adler32_sse2(), with blocks of 64 bytes.  The pairs of products of
+   _mm512_maddubs_epi16 are at most 255 * (64 + 63) = 32385 and do not
+   saturate. */
+local uLong adler32_avx512_impl(adler, buf, len)
+    uLong adler;
+    const Bytef *buf;
+    uInt len;
+{
+    unsigned long sum2;
+    unsigned n, blocks;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i ones = _mm512_set1_epi16(1);
+    const __m512i w = _mm512_set_epi8(1, 2, 3, 4, 5, 6, 7, 8,
+                                      9, 10, 11, 12, 13, 14, 15, 16,
+                                      17, 18, 19, 20, 21, 22, 23, 24,
+                                      25, 26, 27, 28, 29, 30, 31, 32,
+                                      33, 34, 35, 36, 37, 38, 39, 40,
+                                      41, 42, 43, 44, 45, 46, 47, 48,
+                                      49, 50, 51, 52, 53, 54, 55, 56,
+                                      57, 58, 59, 60, 61, 62, 63, 64);
+    __m512i b, ps, s1, s2;
+
+    sum2 = (adler >> 16) & 0xffff;
+    adler &= 0xffff;
+
+    blocks = len / 64;
+    len -= blocks * 64;
+    while (blocks) {
+        n = NMAX / 64;
+        if (n > blocks)
+            n = blocks;
+        blocks -= n;
+
+        ps = _mm512_zextsi128_si512(_mm_cvtsi32_si128((int)(adler * n)));
+        s1 = zero;
+        s2 = _mm512_zextsi128_si512(_mm_cvtsi32_si128((int)sum2));
+        do {
+            b = _mm512_loadu_si512((const void *)buf);
+            ps = _mm512_add_epi32(ps, s1);
+            s1 = _mm512_add_epi32(s1, _mm512_sad_epu8(b, zero));
+            s2 = _mm512_add_epi32(s2, _mm512_madd_epi16(
+                     _mm512_maddubs_epi16(b, w), ones));
+            buf += 64;
+        } while (--n);
+        s2 = _mm512_add_epi32(s2, _mm512_slli_epi32(ps, 6));
+
+        adler += (unsigned long)(unsigned)_mm512_reduce_add_epi32(s1);
+        sum2 = (unsigned long)(unsigned)_mm512_reduce_add_epi32(s2);
+        adler %= BASE;
+        sum2 %= BASE;
+    }
+
+    ADLER32_SIMD_TAIL(adler, sum2, buf, len);
+    return adler | (sum2 << 16);
+}
+
+const adler32_func adler32_avx512 = adler32_avx512_impl;
+
+#else
+
+const adler32_func adler32_avx512 = Z_NULL;
+
+#endif /* ADLER32_AVX512 */
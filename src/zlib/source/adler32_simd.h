@@ -0,0 +1,43 @@
+/* adler32_simd.h -- vectorised Adler-32 checksums
+ * Copyright (C) 1995-2004 Mark Adler
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* WARNING: this file should *not* be used by applications. It is
+   part of the implementation of the compression library and is
+   subject to change. Applications should only use zlib.h.
+ */
+
+/* adler32() hands buffers of at least ADLER32_SIMD_MIN bytes to the widest
+   of these implementations that cpu_features allows (see cpu_dispatch.h).
+   Each one is compiled with the code generation for its instruction set
+   and is NULL when the compiler could not provide it.  The AVX2 and
+   AVX-512 files are only built when the compiler accepts their flags,
+   which ADLER32_HAVE_AVX2 and ADLER32_HAVE_AVX512 tell. */
+
+#define ADLER32_SIMD_MIN 64
+
+#define BASE 65521UL    /* largest prime smaller than 65536 */
+#define NMAX 5552
+/* NMAX is the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 */
+
+typedef uLong (*adler32_func) OF((uLong adler, const Bytef *buf, uInt len));
+
+extern const adler32_func adler32_sse2;
+#ifdef ADLER32_HAVE_AVX2
+extern const adler32_func adler32_avx2;
+#endif
+#ifdef ADLER32_HAVE_AVX512
+extern const adler32_func adler32_avx512;
+#endif
+
+/* Adds the bytes left over by the vector loop and reduces the sums. */
+#define ADLER32_SIMD_TAIL(adler, sum2, buf, len) \
+    do { \
+        while (len--) { \
+            adler += *buf++; \
+            sum2 += adler; \
+        } \
+        adler %= BASE; \
+        sum2 %= BASE; \
+    } while (0)
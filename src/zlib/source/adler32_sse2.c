@@ -0,0 +1,85 @@
+/* adler32_sse2.c -- compute the Adler-32 checksum with SSE2
+ * Copyright (C) 1995-2004 Mark Adler
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* @(#) $Id$ */
+
+/* SSE2 is part of x86-64, so this file needs no special compiler flags
+   there. */
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define ADLER32_SSE2
+#  include <emmintrin.h>
+#endif
+
+#define ZLIB_INTERNAL
+#include "zutil.h"
+#include "adler32_simd.h"
+
+#ifdef ADLER32_SSE2
+
+/* Blocks of 16 bytes are summed into four 32 bit lanes.  Byte i of a
+   block is added to sum2 16 - i times by the block itself, once for each
+   byte from i on, and 16 times by every later block of the NMAX run; the
+   latter is counted in ps, the sum of adler before each block. */
+local uLong adler32_sse2_impl(adler, buf, len)
+    uLong adler;
+    const Bytef *buf;
+    uInt len;
+{
+    unsigned long sum2;
+    unsigned n, blocks;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w_lo = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+    const __m128i w_hi = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+    __m128i b, ps, s1, s2;
+
+    sum2 = (adler >> 16) & 0xffff;
+    adler &= 0xffff;
+
+    blocks = len / 16;
+    len -= blocks * 16;
+    while (blocks) {
+        n = NMAX / 16;
+        if (n > blocks)
+            n = blocks;
+        blocks -= n;
+
+        ps = _mm_cvtsi32_si128((int)(adler * n));
+        s1 = zero;
+        s2 = _mm_cvtsi32_si128((int)sum2);
+        do {
+            b = _mm_loadu_si128((const __m128i *)buf);
+            ps = _mm_add_epi32(ps, s1);
+            s1 = _mm_add_epi32(s1, _mm_sad_epu8(b, zero));
+            s2 = _mm_add_epi32(s2, _mm_madd_epi16(_mm_unpacklo_epi8(b, zero),
+                                                  w_lo));
+            s2 = _mm_add_epi32(s2, _mm_madd_epi16(_mm_unpackhi_epi8(b, zero),
+                                                  w_hi));
+            buf += 16;
+        } while (--n);
+        s2 = _mm_add_epi32(s2, _mm_slli_epi32(ps, 4));
+
+        /* sum the lanes, _mm_sad_epu8 leaves s1 in lanes 0 and 2 */
+        s1 = _mm_add_epi32(s1, _mm_shuffle_epi32(s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = _mm_add_epi32(s2, _mm_shuffle_epi32(s2, _MM_SHUFFLE(1, 0, 3, 2)));
+        s2 = _mm_add_epi32(s2, _mm_shuffle_epi32(s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        adler += (unsigned long)(unsigned)_mm_cvtsi128_si32(s1);
+        sum2 = (unsigned long)(unsigned)_mm_cvtsi128_si32(s2);
+        adler %= BASE;
+        sum2 %= BASE;
+    }
+
+    ADLER32_SIMD_TAIL(adler, sum2, buf, len);
+    return adler | (sum2 << 16);
+}
+
+const adler32_func adler32_sse2 = adler32_sse2_impl;
+
+#else
+
+const adler32_func adler32_sse2 = Z_NULL;
+
+#endif /* ADLER32_SSE2 */
@@ -0,0 +1,169 @@
+/* adler32test.c -- check adler32() against a byte at a time Adler-32
+ * Copyright (C) 1995-2004 Mark Adler
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* @(#) $Id$ */
+
+/* Usage: adler32test [level]
+
+   Checks adler32() for every length up to a few hundred bytes and for
+   lengths around multiples of the vector widths and of NMAX, at every
+   start offset within 64 bytes, for random bytes and for bytes of 255
+   and with small and large initial sums.  adler32() uses the
+   implementation of the dispatch level of cpu_features, which the
+   environment variable CPU_FEATURES_DISPATCH caps.  When the level is
+   given and the processor does not support it, the test is skipped with
+   exit code 77. */
+
+#include <stdio.h>
+#include "zlib.h"
+
+#ifdef STDC
+#  include <string.h>
+#  include <stdlib.h>
+#endif
+
+#ifdef ADLER32_DISPATCH
+#  include "cpu_dispatch.h"
+#endif
+
+#define BASE 65521UL
+#define NMAX 5552
+
+#define MAX_OFFSET 64
+#define MAX_LEN (3 * NMAX + 256)
+
+#define SKIP_RETURN_CODE 77
+
+static const uInt lengths[] = {
+    511, 512, 513, 1023, 1024, 1025, 4095, 4096, 4097,
+    NMAX - 1, NMAX, NMAX + 1, NMAX + 31, NMAX + 32, NMAX + 33,
+    NMAX + 63, NMAX + 64, NMAX + 65, 2 * NMAX - 1, 2 * NMAX, 2 * NMAX + 1,
+    3 * NMAX + 17, 3 * NMAX + 127, MAX_LEN
+};
+
+static const uLong starts[] = { 1UL, 0xfff0fff0UL, 0x0001fff0UL };
+
+static Byte buf[MAX_LEN + MAX_OFFSET];
+static long failures = 0;
+
+uLong adler32_reference OF((uLong adler, const Bytef *p, uInt len));
+void  check_length      OF((const char *name, uInt len));
+void  check_buffer      OF((const char *name));
+int   main              OF((int argc, char *argv[]));
+
+/* ===========================================================================
+ * The definition of the checksum, one byte at a time.
+ */
+uLong adler32_reference(adler, p, len)
+    uLong adler;
+    const Bytef *p;
+    uInt len;
+{
+    uLong s1 = adler & 0xffff;
+    uLong s2 = (adler >> 16) & 0xffff;
+
+    while (len--) {
+        s1 = (s1 + *p++) % BASE;
+        s2 = (s2 + s1) % BASE;
+    }
+    return s1 | (s2 << 16);
+}
+
+/* ===========================================================================
+ * Checks len bytes at every offset, in one call and split in two calls.
+ */
+void check_length(name, len)
+    const char *name;
+    uInt len;
+{
+    uInt offset, i;
+    uLong expected, got;
+
+    for (offset = 0; offset < MAX_OFFSET; offset++) {
+        for (i = 0; i < sizeof(starts) / sizeof(starts[0]); i++) {
+            expected = adler32_reference(starts[i], buf + offset, len);
+            got = adler32(starts[i], buf + offset, len);
+            if (got == expected) {
+                got = adler32(adler32(starts[i], buf + offset, len / 3),
+                              buf + offset + len / 3, len - len / 3);
+            }
+            if (got != expected) {
+                if (failures++ < 10) {
+                    fprintf(stderr, "%s: adler32(%08lx, buf + %u, %u) is "
+                            "%08lx instead of %08lx\n", name, starts[i],
+                            offset, len, got, expected);
+                }
+            }
+        }
+    }
+}
+
+/* ===========================================================================
+ * Checks all lengths on the contents of buf.
+ */
+void check_buffer(name)
+    const char *name;
+{
+    uInt len, i;
+
+    for (len = 0; len <= 256; len++)
+        check_length(name, len);
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+        check_length(name, lengths[i]);
+}
+
+/* ===========================================================================
+ * Usage: adler32test [level]
+ */
+int main(argc, argv)
+    int argc;
+    char *argv[];
+{
+    unsigned long seed = 12345;
+    uInt i;
+
+#ifdef ADLER32_DISPATCH
+    if (argc > 1) {
+        CpuDispatchLevel level = ParseCpuDispatchLevel(argv[1]);
+
+        if (level == CPU_DISPATCH_LEVEL_COUNT) {
+            fprintf(stderr, "unknown dispatch level %s\n", argv[1]);
+            return 1;
+        }
+        if (GetCpuDispatchLevel() != level) {
+            printf("dispatch level %s is not available, using %s: skipped\n",
+                   argv[1], GetCpuDispatchLevelName(GetCpuDispatchLevel()));
+            return SKIP_RETURN_CODE;
+        }
+    }
+    printf("dispatch level: %s\n",
+           GetCpuDispatchLevelName(GetCpuDispatchLevel()));
+#else
+    (void)argc;
+    (void)argv;
+    printf("dispatch level: none\n");
+#endif
+
+    if (adler32(0L, Z_NULL, 0) != 1L) {
+        fprintf(stderr, "adler32(0, Z_NULL, 0) is not 1\n");
+        failures++;
+    }
+
+    for (i = 0; i < sizeof(buf); i++) {
+        seed = (seed * 1103515245UL + 12345UL) & 0xffffffffUL;
+        buf[i] = (Byte)(seed >> 24);
+    }
+    check_buffer("random bytes");
+
+    memset(buf, 255, sizeof(buf));
+    check_buffer("bytes of 255");
+
+    if (failures) {
+        fprintf(stderr, "%ld adler32 mismatches\n", failures);
+        return 1;
+    }
+    printf("adler32(): ok\n");
+    return 0;
+}